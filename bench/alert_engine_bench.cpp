@@ -0,0 +1,62 @@
+#include <cstdint>
+#include <string>
+
+#include "bench.hpp"
+#include "helper/alert_engine.hpp"
+#include "helper/snapshot_tree.hpp"
+
+namespace {
+
+constexpr int kCores = 64;
+constexpr int kRules = 500;
+
+// Per-core gauges, members in sorted key order.
+void BuildSnapshot(json::SnapshotTree &tree, int tick) {
+  tree.Reset();
+  tree.BeginObject();
+  tree.Key("cpu_usage");
+  tree.BeginObject();
+  tree.Key("cores");
+  tree.BeginArray();
+  for (int i = 0; i < kCores; ++i) {
+    tree.BeginObject();
+    tree.Field("frequency", 3000.0 + (i * 31 + tick) % 1500);
+    tree.Field("temperature", 40.0 + (i * 7 + tick) % 50);
+    tree.Field("usage_percent", static_cast<double>((i * 13 + tick * 5) % 100));
+    tree.EndObject();
+  }
+  tree.EndArray();
+  tree.EndObject();
+  tree.EndObject();
+}
+
+}  // namespace
+
+BENCHMARK(AlertEvaluate500Rules) {
+  static const char *const kFields[] = {"frequency", "temperature", "usage_percent"};
+  alert::AlertEngine engine;
+  for (int i = 0; i < kRules; ++i) {
+    const auto condition = static_cast<alert::AlertCondition>(i % 4);
+    const std::string path = "/cpu_usage/cores/" + std::to_string(i % kCores) + "/" + kFields[(i / kCores) % 3];
+    const alert::AlertRule rule{"rule" + std::to_string(i), path, condition, 50.0 + i % 40, 2.0, (i % 3) * 1000};
+    if (engine.AddRule(rule) != alert::AlertError::Success) {
+      return;
+    }
+  }
+
+  json::SnapshotTree trees[16];
+  for (int tick = 0; tick < 16; ++tick) {
+    BuildSnapshot(trees[tick], tick);
+  }
+
+  int64_t timestamp = 0;
+  size_t events = 0;
+  const double ns = bench::MeasureNs([&] {
+    timestamp += 1000;
+    events += engine.Evaluate(trees[(timestamp / 1000) % 16], timestamp).size();
+    bench::Consume(events);
+  });
+
+  bench::Report("alert evaluation, 500 rules", ns / 1000.0, "us/tick");
+  bench::Report("  per rule", ns / kRules, "ns");
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef NYSYS_BENCH_HPP
+#define NYSYS_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace bench {
+
+struct Benchmark {
+  std::string_view name;
+  void (*run)();
+};
+
+[[nodiscard]] std::vector<Benchmark> &Registry();
+void Report(std::string_view name, double value, std::string_view unit);
+
+struct Registrar {
+  Registrar(std::string_view name, void (*run)()) { Registry().push_back({name, run}); }
+};
+
+namespace detail {
+
+constexpr auto kMinDuration = std::chrono::milliseconds{200};
+
+inline const void *volatile consumed = nullptr;
+}  // namespace detail
+
+// Keeps a result observable so the optimizer cannot drop the work that produced it.
+template <typename T>
+void Consume(const T &value) noexcept { detail::consumed = &value; }
+
+// Repeats operation in doubling rounds until one round lasts at least kMinDuration and returns nanoseconds per call.
+template <typename Operation>
+[[nodiscard]] double MeasureNs(Operation &&operation) {
+  using Clock = std::chrono::steady_clock;
+  for (uint64_t iterations = 1;; iterations *= 2) {
+    const auto start = Clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+      operation();
+    }
+    const auto elapsed = Clock::now() - start;
+    if (elapsed >= detail::kMinDuration) {
+      return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+             static_cast<double>(iterations);
+    }
+  }
+}
+
+}  // namespace bench
+
+#define BENCHMARK(name)                                        \
+  static void name();                                          \
+  static const bench::Registrar name##Registrar{#name, &name}; \
+  static void name()
+
+#endif
\ No newline at end of file
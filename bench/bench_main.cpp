@@ -0,0 +1,29 @@
+#include <cstdio>
+#include <string_view>
+
+#include "bench.hpp"
+
+namespace bench {
+
+std::vector<Benchmark> &Registry() {
+  static std::vector<Benchmark> registry;
+  return registry;
+}
+
+void Report(std::string_view name, double value, std::string_view unit) {
+  std::printf("%-48.*s %14.2f %.*s\n", static_cast<int>(name.size()), name.data(), value, static_cast<int>(unit.size()),
+              unit.data());
+}
+
+}  // namespace bench
+
+// Runs every registered benchmark, or only those whose name contains the first argument.
+int main(int argc, char **argv) {
+  const std::string_view filter = argc > 1 ? argv[1] : "";
+  for (const auto &benchmark : bench::Registry()) {
+    if (benchmark.name.find(filter) != std::string_view::npos) {
+      benchmark.run();
+    }
+  }
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include <cstdint>
+#include <string>
+
+#include "bench.hpp"
+#include "helper/binary_writer.hpp"
+#include "helper/json_writer.hpp"
+#include "helper/snapshot_tree.hpp"
+
+namespace {
+
+// A desktop-sized sample: 16 logical cores, two GPUs and four volumes, members in sorted key order.
+void BuildSnapshot(json::SnapshotTree &tree) {
+  tree.Reset();
+  tree.BeginObject();
+  tree.Key("cpu");
+  tree.BeginObject();
+  tree.Key("cores");
+  tree.BeginArray();
+  for (int i = 0; i < 16; ++i) {
+    tree.Value(3.25 + i * 4.5);
+  }
+  tree.EndArray();
+  tree.Field("load", 37.8125);
+  tree.Field("name", "AMD Ryzen 9 7950X 16-Core Processor");
+  tree.EndObject();
+  tree.Key("disks");
+  tree.BeginArray();
+  for (uint64_t i = 0; i < 4; ++i) {
+    tree.BeginObject();
+    tree.Field("free", 512000000000ULL - i * 73000000000ULL);
+    tree.Field("mount", std::string{static_cast<char>('C' + i)} + ":\\");
+    tree.Field("total", 1024000000000ULL);
+    tree.EndObject();
+  }
+  tree.EndArray();
+  tree.Key("gpus");
+  tree.BeginArray();
+  for (int i = 0; i < 2; ++i) {
+    tree.BeginObject();
+    tree.Field("clock", uint64_t{2520});
+    tree.Field("load", 12.5 * (i + 1));
+    tree.Field("name", "NVIDIA GeForce RTX 4080");
+    tree.Field("temperature", int64_t{54 + i});
+    tree.Field("vramUsed", uint64_t{3221225472});
+    tree.EndObject();
+  }
+  tree.EndArray();
+  tree.Key("memory");
+  tree.BeginObject();
+  tree.Field("available", uint64_t{41234567168});
+  tree.Field("load", 38.4);
+  tree.Field("total", uint64_t{68719476736});
+  tree.EndObject();
+  tree.Field("uptime", uint64_t{1234567});
+  tree.EndObject();
+}
+
+}  // namespace
+
+BENCHMARK(SnapshotEncoding) {
+  json::SnapshotTree tree;
+  BuildSnapshot(tree);
+
+  json::JsonWriter jsonWriter;
+  const double jsonNs = bench::MeasureNs([&] {
+    jsonWriter.Reset(false, 0);
+    json::WriteSnapshotTree(jsonWriter, tree);
+    bench::Consume(jsonWriter.GetOutput());
+  });
+  bench::Report("snapshot encoding, compact JSON", jsonNs, "ns");
+  bench::Report("  size", static_cast<double>(jsonWriter.GetOutput().size()), "bytes");
+
+  json::BinaryWriter binaryWriter;
+  for (const auto format : {json::BinaryFormat::Cbor, json::BinaryFormat::MessagePack}) {
+    const double ns = bench::MeasureNs([&] {
+      binaryWriter.Reset(format);
+      json::WriteSnapshotTree(binaryWriter, tree);
+      bench::Consume(binaryWriter.GetBuffer());
+    });
+    bench::Report(format == json::BinaryFormat::Cbor ? "snapshot encoding, CBOR" : "snapshot encoding, MessagePack",
+                  ns, "ns");
+    bench::Report("  size", static_cast<double>(binaryWriter.GetBuffer().size()), "bytes");
+  }
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#include <cstdint>
+
+#include "bench.hpp"
+#include "helper/cpu_time.hpp"
+
+BENCHMARK(CpuTimeShares512Cores) {
+  constexpr size_t kCores = 512;
+  cputime::CounterColumns previous;
+  cputime::CounterColumns current;
+  cputime::ShareColumns shares;
+  previous.Resize(kCores);
+  current.Resize(kCores);
+  shares.Resize(kCores);
+
+  uint64_t seed = 0x9E3779B97F4A7C15ull;
+  for (size_t core = 0; core < kCores; ++core) {
+    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    const uint64_t idle = (seed >> 40) % 10000;
+    current.idle[core] = previous.idle[core] + idle;
+    current.kernel[core] = previous.kernel[core] + idle + (seed >> 20) % 3000;
+    current.user[core] = previous.user[core] + (seed >> 8) % 7000;
+    current.dpc[core] = previous.dpc[core] + (seed >> 4) % 50;
+    current.interrupt[core] = previous.interrupt[core] + seed % 50;
+  }
+
+  cputime::Breakdown total;
+  const double ns = bench::MeasureNs([&] {
+    cputime::ComputeShares(current, previous, kCores, shares, total);
+    bench::Consume(total);
+  });
+  bench::Report("cpu_time shares, 512 cores", ns, "ns/tick");
+}
\ No newline at end of file
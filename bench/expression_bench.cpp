@@ -0,0 +1,66 @@
+#include <cstdint>
+#include <string>
+
+#include "bench.hpp"
+#include "helper/expression.hpp"
+#include "helper/snapshot_tree.hpp"
+
+namespace {
+
+constexpr size_t kCores = 64;
+constexpr size_t kExpressions = 1000;
+
+void BuildSnapshot(json::SnapshotTree &tree) {
+  tree.BeginObject();
+  tree.Key("cpu_usage");
+  tree.BeginObject();
+  tree.Key("cores");
+  tree.BeginArray();
+  for (size_t core = 0; core < kCores; ++core) {
+    tree.BeginObject();
+    tree.Field("usage_percent", static_cast<double>(core % 100));
+    tree.EndObject();
+  }
+  tree.EndArray();
+  tree.EndObject();
+  tree.Key("memory");
+  tree.BeginObject();
+  tree.Field("total", uint64_t{16} << 30);
+  tree.Field("used", uint64_t{5} << 30);
+  tree.EndObject();
+  tree.EndObject();
+}
+
+}  // namespace
+
+// A thousand expressions mixing scalar loads, per-core lookups and shared wildcard aggregates, evaluated per tick.
+BENCHMARK(ExpressionThousandPerTick) {
+  expr::ExpressionEngine engine;
+  for (size_t i = 0; i < kExpressions; ++i) {
+    const std::string core = std::to_string(i % kCores);
+    std::string source;
+    switch (i % 3) {
+      case 0:
+        source = "{/memory/used} / {/memory/total} * " + std::to_string(i + 1);
+        break;
+      case 1:
+        source = "abs({/cpu_usage/cores/" + core + "/usage_percent} - avg({/cpu_usage/cores/*/usage_percent}))";
+        break;
+      default:
+        source = "max({/cpu_usage/cores/*/usage_percent}) - min({/cpu_usage/cores/" + core + "/usage_percent}, 50)";
+        break;
+    }
+    if (engine.AddExpression("metric_" + std::to_string(i), source) != expr::ExpressionError::Success) {
+      return;
+    }
+  }
+
+  json::SnapshotTree tree;
+  BuildSnapshot(tree);
+  const double ns = bench::MeasureNs([&] {
+    engine.Evaluate(tree);
+    bench::Consume(engine);
+  });
+  bench::Report("expressions, 1000 per tick", ns / 1000.0, "us/tick");
+  bench::Report("  per expression", ns / kExpressions, "ns");
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "helper/gzip.hpp"
+
+namespace {
+
+// The uploader's default batch: 60 one-second samples framed as a JSON array.
+std::string MakeBatch() {
+  std::string text = "[";
+  for (int i = 0; i < 60; ++i) {
+    text += i > 0 ? "," : "";
+    text += "{\"data\":{\"cpu\":{\"load\":" + std::to_string(30 + (i * 7) % 40) +
+            ",\"cores\":[12.5,3.25,40.0,7.75],\"name\":\"core\"},\"memory\":{\"used\":" +
+            std::to_string(8123456789ull + static_cast<uint64_t>(i) * 4096) + "}},\"sequence\":" +
+            std::to_string(i) + ",\"timestamp\":" + std::to_string(1700000000000 + i * 1000) + "}";
+  }
+  return text + "]";
+}
+
+}  // namespace
+
+BENCHMARK(GzipUploadBatch) {
+  const auto batch = MakeBatch();
+  const auto *data = reinterpret_cast<const uint8_t *>(batch.data());
+  codec::GzipEncoder encoder;
+  std::vector<uint8_t> compressed;
+  const double ns = bench::MeasureNs([&] {
+    (void)encoder.Compress(data, batch.size(), compressed);
+    bench::Consume(compressed);
+  });
+
+  bench::Report("gzip, 60-sample JSON batch", static_cast<double>(batch.size()) / compressed.size(), "x smaller");
+  bench::Report("  compress", static_cast<double>(batch.size()) * 1000.0 / ns, "MB/s");
+}
\ No newline at end of file
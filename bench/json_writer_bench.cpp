@@ -0,0 +1,137 @@
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "helper/json_writer.hpp"
+
+#ifdef NYSYS_BENCH_NLOHMANN
+#include <nlohmann/json.hpp>
+#endif
+
+namespace {
+
+struct Core {
+  double usage = 0.0;
+  uint64_t frequency = 0;
+};
+
+struct Volume {
+  std::string mount;
+  std::string label;
+  uint64_t free = 0;
+  uint64_t total = 0;
+};
+
+// The shape of one system info tick: per-core gauges, a few volumes with escaped paths and some nulls.
+struct Sample {
+  std::vector<Core> cores;
+  std::vector<Volume> volumes;
+  std::string cpuName = "AMD Ryzen 9 7950X 16-Core Processor";
+  double memoryLoad = 38.4;
+  uint64_t memoryTotal = 68719476736;
+  uint64_t uptime = 1234567;
+};
+
+Sample MakeSample() {
+  Sample sample;
+  for (int i = 0; i < 32; ++i) {
+    sample.cores.push_back({3.25 + (i * 37 % 97) * 0.75, 4500 + static_cast<uint64_t>(i) * 25});
+  }
+  for (int i = 0; i < 4; ++i) {
+    const char letter = static_cast<char>('C' + i);
+    sample.volumes.push_back({std::string{letter} + ":\\", "Volume \"" + std::string{letter} + "\" \xE2\x80\x94 data",
+                              512000000000ULL - static_cast<uint64_t>(i) * 73000000000ULL, 1024000000000ULL});
+  }
+  return sample;
+}
+
+void Write(json::JsonWriter &writer, const Sample &sample) {
+  writer.BeginObject();
+  writer.Key("cpu");
+  writer.BeginObject();
+  writer.Key("cores");
+  writer.BeginArray();
+  for (const auto &core : sample.cores) {
+    writer.BeginObject();
+    writer.Field("frequency", core.frequency);
+    writer.Field("usage", core.usage);
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.Field("name", sample.cpuName);
+  writer.Key("temperature");
+  writer.Null();
+  writer.EndObject();
+  writer.Key("memory");
+  writer.BeginObject();
+  writer.Field("load", sample.memoryLoad);
+  writer.Field("total", sample.memoryTotal);
+  writer.EndObject();
+  writer.Field("uptime", sample.uptime);
+  writer.Key("volumes");
+  writer.BeginArray();
+  for (const auto &volume : sample.volumes) {
+    writer.BeginObject();
+    writer.Field("free", volume.free);
+    writer.Field("label", volume.label);
+    writer.Field("mount", volume.mount);
+    writer.Field("total", volume.total);
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+}
+
+#ifdef NYSYS_BENCH_NLOHMANN
+// What GenerateSystemInfo did before the streaming writer: build a DOM every tick, then dump it.
+std::string Dump(const Sample &sample, int indent) {
+  nlohmann::json root;
+  auto &cpu = root["cpu"];
+  auto &cores = cpu["cores"] = nlohmann::json::array();
+  for (const auto &core : sample.cores) {
+    cores.push_back({{"frequency", core.frequency}, {"usage", core.usage}});
+  }
+  cpu["name"] = sample.cpuName;
+  cpu["temperature"] = nullptr;
+  root["memory"] = {{"load", sample.memoryLoad}, {"total", sample.memoryTotal}};
+  root["uptime"] = sample.uptime;
+  auto &volumes = root["volumes"] = nlohmann::json::array();
+  for (const auto &volume : sample.volumes) {
+    volumes.push_back(
+        {{"free", volume.free}, {"label", volume.label}, {"mount", volume.mount}, {"total", volume.total}});
+  }
+  return root.dump(indent);
+}
+#endif
+
+void Run(const char *name, bool prettyPrint) {
+  const auto sample = MakeSample();
+  json::JsonWriter writer;
+  const double ns = bench::MeasureNs([&] {
+    writer.Reset(prettyPrint, 2);
+    Write(writer, sample);
+    bench::Consume(writer.GetOutput());
+  });
+  bench::Report(name, static_cast<double>(writer.GetOutput().size()), "bytes");
+  bench::Report("  JsonWriter", ns, "ns");
+
+#ifdef NYSYS_BENCH_NLOHMANN
+  std::string dumped;
+  const double nlohmannNs = bench::MeasureNs([&] {
+    dumped = Dump(sample, prettyPrint ? 2 : -1);
+    bench::Consume(dumped);
+  });
+  bench::Report("  nlohmann DOM + dump", nlohmannNs, "ns");
+  if (dumped != writer.GetOutput()) {
+    std::printf("  output differs from nlohmann::json::dump\n");
+  }
+#endif
+}
+
+}  // namespace
+
+BENCHMARK(JsonWriterCompact) { Run("system info, compact", false); }
+
+BENCHMARK(JsonWriterPretty) { Run("system info, pretty", true); }
\ No newline at end of file
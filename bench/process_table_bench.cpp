@@ -0,0 +1,43 @@
+#include <cstdint>
+#include <vector>
+
+#include "bench.hpp"
+#include "fixtures/process_fixture.hpp"
+#include "helper/process_table.hpp"
+
+// One collector tick minus the snapshot query: sort by id, match against the previous tick, pick three top-N lists.
+BENCHMARK(ProcessTopN5000Processes) {
+  constexpr size_t kProcesses = 5000;
+  constexpr size_t kTop = 5;
+  constexpr size_t kTicks = 64;
+
+  fixture::ProcessFixture fixture(kProcesses, 11);
+  std::vector<std::vector<proc::ProcessSample>> ticks(kTicks);
+  for (auto &tick : ticks) {
+    fixture.Advance(tick);
+  }
+
+  std::vector<proc::ProcessSample> previous = ticks[0];
+  proc::SortByProcessId(previous);
+  std::vector<proc::ProcessSample> current;
+  current.reserve(kProcesses);
+  std::vector<uint32_t> heap;
+  heap.reserve(kTop + 1);
+
+  size_t next = 1;
+  const double ns = bench::MeasureNs([&] {
+    current = ticks[next];
+    next = next + 1 < kTicks ? next + 1 : 1;
+
+    proc::SortByProcessId(current);
+    proc::ComputeRates(current, previous, 1.0e-5, 1.0);
+    proc::SelectTop(current, kTop, [](const proc::ProcessSample &s) { return s.cpuPercent; }, heap);
+    bench::Consume(heap);
+    proc::SelectTop(current, kTop, [](const proc::ProcessSample &s) { return s.workingSet; }, heap);
+    bench::Consume(heap);
+    proc::SelectTop(current, kTop, [](const proc::ProcessSample &s) { return s.ioReadRate + s.ioWriteRate; }, heap);
+    bench::Consume(heap);
+    current.swap(previous);
+  });
+  bench::Report("process top-5 x3, 5000 processes", ns / 1000.0, "us/tick");
+}
\ No newline at end of file
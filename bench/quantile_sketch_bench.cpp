@@ -0,0 +1,75 @@
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "bench.hpp"
+#include "helper/json_pointer.hpp"
+#include "helper/quantile_sketch.hpp"
+
+namespace {
+
+// Heavy-tailed values over several decades, the worst case for bucket spread.
+std::vector<double> MakeValues(size_t count) {
+  std::vector<double> values;
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i < count; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    values.push_back(std::exp(static_cast<double>(state >> 11) / static_cast<double>(1ULL << 53) * 12.0 - 4.0));
+  }
+  return values;
+}
+
+}  // namespace
+
+BENCHMARK(QuantileSketch) {
+  const auto values = MakeValues(4096);
+
+  history::QuantileSketch sketch;
+  size_t next = 0;
+  const double addNs = bench::MeasureNs([&] {
+    sketch.Add(values[next++ % values.size()]);
+    bench::Consume(sketch);
+  });
+
+  double sum = 0.0;
+  const double quantileNs = bench::MeasureNs([&] {
+    sum += sketch.Quantile(0.99);
+    bench::Consume(sum);
+  });
+
+  history::QuantileSketch merged;
+  const double mergeNs = bench::MeasureNs([&] {
+    merged.Clear();
+    merged.Merge(sketch);
+    bench::Consume(merged);
+  });
+
+  bench::Report("quantile sketch, 12-decade values", static_cast<double>(sketch.GetMemoryUsage()), "bytes");
+  bench::Report("  add", addNs, "ns/value");
+  bench::Report("  p99 query", quantileNs, "ns");
+  bench::Report("  merge", mergeNs, "ns");
+}
+
+BENCHMARK(QuantileSketchSummary) {
+  // The default 60 s window in 12 slices with one sample per second: what every snapshot pays per metric.
+  history::MetricSketch metric{"/cpu/load", *json::ParsePointer("/cpu/load"), 60000, 12};
+  const auto values = MakeValues(600);
+  for (size_t i = 0; i < values.size(); ++i) {
+    metric.Add(static_cast<int64_t>(i) * 1000, values[i]);
+  }
+
+  history::QuantileSketch scratch;
+  history::SketchSummary summary;
+  const int64_t now = static_cast<int64_t>(values.size()) * 1000;
+  for (const auto window :
+       {history::SketchWindow::Sliding, history::SketchWindow::Tumbling, history::SketchWindow::Run}) {
+    const double ns = bench::MeasureNs([&] {
+      metric.Summarize(window, now, scratch, summary);
+      bench::Consume(summary);
+    });
+    bench::Report(window == history::SketchWindow::Sliding    ? "percentile summary, sliding window"
+                  : window == history::SketchWindow::Tumbling ? "percentile summary, tumbling window"
+                                                              : "percentile summary, whole run",
+                  ns, "ns");
+  }
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include <cmath>
+#include <cstdint>
+
+#include "bench.hpp"
+#include "helper/series_codec.hpp"
+#include "helper/time_series.hpp"
+
+namespace {
+
+// One block of a typical gauge: 1 s ticks with a few ms of jitter and a slowly moving percentage.
+void FillBlock(history::SeriesBlock &block, bool integers) {
+  block.Clear();
+  for (uint32_t i = 0; i < history::detail::kSamplesPerBlock; ++i) {
+    const double value = 40.13 + std::sin(i * 0.05) * 10.0;
+    const double sample = integers ? std::round(value) : std::round(value * 100) / 100;
+    if (!block.Accepts(sample)) {
+      return;
+    }
+    block.Append(1700000000000 + i * 1000 + (i * 7) % 5, sample);
+  }
+}
+
+void Run(const char *name, bool integers) {
+  history::SeriesBlock block;
+  const double encodeNs = bench::MeasureNs([&] {
+    FillBlock(block, integers);
+    bench::Consume(block);
+  });
+
+  double sum = 0.0;
+  const double decodeNs = bench::MeasureNs([&] {
+    block.Decode([&sum](int64_t, double value) { sum += value; });
+    bench::Consume(sum);
+  });
+
+  const double samples = block.GetCount();
+  bench::Report(name, static_cast<double>(block.GetSize()) / samples, "bytes/sample");
+  bench::Report("  encode", encodeNs / samples, "ns/sample");
+  bench::Report("  decode", decodeNs / samples, "ns/sample");
+}
+
+}  // namespace
+
+BENCHMARK(SeriesCodecFloats) { Run("series codec, 2-decimal gauge", false); }
+
+BENCHMARK(SeriesCodecIntegers) { Run("series codec, integer gauge", true); }
\ No newline at end of file
@@ -0,0 +1,32 @@
+#include <cstdint>
+#include <vector>
+
+#include "bench.hpp"
+#include "helper/time_series.hpp"
+
+BENCHMARK(HistoryAppend) {
+  history::MetricSeries series{{"cpu", "usage"}, history::detail::kDefaultHistoryCapacities};
+  int64_t tick = 0;
+  const double ns = bench::MeasureNs([&] {
+    series.Append(tick * 1000, static_cast<double>(tick % 100) + (tick % 7 == 0 ? 0.5 : 0.0));
+    ++tick;
+  });
+  bench::Report("history append, default capacities", ns, "ns/sample");
+  bench::Report("history memory after run", static_cast<double>(series.GetMemoryUsage()), "bytes");
+}
+
+BENCHMARK(HistoryRawQuery) {
+  history::MetricSeries series{{"cpu", "usage"}, history::detail::kDefaultHistoryCapacities};
+  for (int64_t i = 0; i < 100000; ++i) {
+    series.Append(i * 1000, static_cast<double>(i % 100));
+  }
+
+  std::vector<history::Point> points;
+  points.reserve(history::detail::kDefaultHistoryCapacities[0]);
+  const double ns = bench::MeasureNs([&] {
+    points.clear();
+    series.Query(0, INT64_MAX, history::Resolution::Raw, points);
+    bench::Consume(points);
+  });
+  bench::Report("history raw query, 3600 samples", ns, "ns/query");
+}
\ No newline at end of file
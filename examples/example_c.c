@@ -1,53 +1,62 @@
 #include <windows.h>
 
-#include <direct.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <string.h>
 #include <time.h>
 
 #include "nysys.h"
 
-static int g_updateCount = 0;
-static clock_t g_startTime = 0;
+typedef struct {
+  int updateCount;
+  clock_t startTime;
+} ExampleState;
 
-void callbackFunction(const char *jsonData) {
-  if (jsonData == NULL) {
+void callbackFunction(const uint8_t *data, size_t size, uint64_t sequence, void *userData) {
+  ExampleState *state = (ExampleState *)userData;
+  if (data == NULL || state == NULL) {
     printf("\nError: Received NULL data in callback\n");
     return;
   }
 
-  g_updateCount++;
+  state->updateCount++;
 
-  double elapsed = (double)(clock() - g_startTime) / CLOCKS_PER_SEC;
+  double elapsed = (double)(clock() - state->startTime) / CLOCKS_PER_SEC;
 
-  printf("\rUpdate #%d (%.1fs) - %zu bytes", g_updateCount, elapsed, strlen(jsonData));
-
-  _mkdir("output");
-
-  char filename[100];
-  sprintf(filename, "output/system_info_%d.json", g_updateCount);
+  printf("\rUpdate #%llu (%.1fs) - %zu bytes", (unsigned long long)sequence, elapsed, size);
+  fflush(stdout);
+}
 
-  FILE *file = fopen(filename, "w");
-  if (file != NULL) {
-    fputs(jsonData, file);
-    fclose(file);
-    printf(" - Saved to %s", filename);
-    fflush(stdout);
-  } else {
-    printf(" - Error saving to %s", filename);
-  }
+BOOL storedRecordFunction(const uint8_t *data, size_t size, uint64_t sequence, int64_t timestampMs, void *userData) {
+  size_t *storedBytes = (size_t *)userData;
+  (void)data;
+  (void)sequence;
+  (void)timestampMs;
+  *storedBytes += size;
+  return TRUE;
 }
 
 int main(void) {
   printf("NySys C Example - System Info Collector\n");
   printf("API Version: NySys v0.5.0beta\n\n");
 
-  g_startTime = clock();
+  ExampleState state = {0, clock()};
 
-  set_callback(callbackFunction);
+  set_data_callback(callbackFunction, &state);
   printf("Callback registered successfully.\n");
 
+  if (!open_segment_store("output/history", NYSYS_DEFAULT_SEGMENT_SIZE_KB, NYSYS_DEFAULT_RETENTION_MB,
+                          NYSYS_DEFAULT_STORE_FLUSH_INTERVAL_MS)) {
+    printf("Failed to open the segment store in 'output/history'!\n");
+    return 1;
+  }
+
+  uint64_t firstSequence = 0;
+  uint64_t nextSequence = 0;
+  uint64_t recovered = 0;
+  uint64_t dropped = 0;
+  get_segment_store_stats(&firstSequence, &nextSequence, &recovered, &dropped);
+  printf("Segment store opened - %llu records recovered.\n", (unsigned long long)recovered);
+
   int32_t updateInterval = NYSYS_DEFAULT_UPDATE_INTERVAL_MS;
   printf("Using update interval: %d ms\n", updateInterval);
 
@@ -65,15 +74,20 @@ int main(void) {
   printf("\nStopping monitoring...\n");
   stop_monitoring();
 
-  double totalTime = (double)(clock() - g_startTime) / CLOCKS_PER_SEC;
+  double totalTime = (double)(clock() - state.startTime) / CLOCKS_PER_SEC;
 
   printf("Monitoring Summary:\n");
-  printf("- Total updates received: %d\n", g_updateCount);
+  printf("- Total updates received: %d\n", state.updateCount);
   printf("- Total runtime: %.1f seconds\n", totalTime);
-  if (g_updateCount > 0) {
-    printf("- Average update rate: %.1f updates/sec\n", g_updateCount / totalTime);
+  if (state.updateCount > 0) {
+    printf("- Average update rate: %.1f updates/sec\n", state.updateCount / totalTime);
   }
-  printf("- JSON files saved in 'output' directory\n");
+  size_t storedBytes = 0;
+  get_segment_store_stats(&firstSequence, &nextSequence, &recovered, &dropped);
+  int32_t stored = read_segment_store(firstSequence, INT32_MAX, storedRecordFunction, &storedBytes);
+  close_segment_store();
+  printf("- Stored records: %d (%zu bytes, %llu dropped) in 'output/history'\n", stored, storedBytes,
+         (unsigned long long)dropped);
   printf("\nMonitoring completed successfully.\n");
 
   return 0;
@@ -1,12 +1,12 @@
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <exception>
-#include <filesystem>
-#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
 
 #include "nysys.hpp"
@@ -59,10 +59,11 @@ int main() {
   auto startTime = std::chrono::steady_clock::now();
 
   try {
-    std::filesystem::create_directories("output");
-    std::cout << "Output directory created/verified.\n";
+    nysys::OpenSegmentStore("output/history");
+    std::cout << "Segment store opened - " << nysys::GetSegmentStoreStats().recoveredCount
+              << " records recovered.\n";
 
-    nysys::SetCallback([&updateCount, startTime](const std::string &jsonData) {
+    nysys::SetDataCallback([&updateCount, startTime](std::string_view jsonData, uint64_t) {
       if (jsonData.empty()) {
         std::cerr << "\nWarning: Received empty JSON data\n";
         return;
@@ -74,21 +75,6 @@ int main() {
 
       std::cout << "\rUpdate #" << currentCount << " (" << formatDuration(elapsed) << ") - " << jsonData.size()
                 << " bytes";
-
-      try {
-        std::string filename = "output/system_info_" + std::to_string(currentCount) + ".json";
-        std::ofstream file(filename);
-        if (file.is_open()) {
-          file << jsonData;
-          file.close();
-          std::cout << " - Saved to " << filename;
-        } else {
-          std::cout << " - Error: Could not save to " << filename;
-        }
-      } catch (const std::exception &e) {
-        std::cout << " - File error: " << e.what();
-      }
-
       std::cout.flush();
     });
 
@@ -134,7 +120,16 @@ int main() {
     }
 
     std::cout << "- Final status: " << getErrorDescription(lastError) << "\n";
-    std::cout << "- JSON files saved in 'output' directory\n";
+    const auto storeStats = nysys::GetSegmentStoreStats();
+    size_t storedBytes = 0;
+    const size_t storedRecords = nysys::ReadSegmentStore(
+        storeStats.firstSequence, SIZE_MAX, [&storedBytes](std::string_view record, uint64_t, int64_t) {
+          storedBytes += record.size();
+          return true;
+        });
+    nysys::CloseSegmentStore();
+    std::cout << "- Stored records: " << storedRecords << " (" << storedBytes << " bytes, " << storeStats.droppedCount
+              << " dropped) in 'output/history'\n";
     std::cout << "\nMonitoring completed successfully.\n";
   } catch (const nysys::MonitoringException &e) {
     std::cerr << "\nMonitoring Exception: " << e.what() << "\n";
@@ -0,0 +1,136 @@
+#ifndef ALERT_ENGINE_HPP
+#define ALERT_ENGINE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "helper/snapshot_tree.hpp"
+
+namespace alert {
+
+enum class AlertCondition : uint8_t { Above = 0, Below, RateAbove, RateBelow };
+
+enum class AlertState : uint8_t { Raised = 0, Cleared };
+
+enum class AlertError {
+  Success = 0,
+  InvalidName,
+  InvalidPath,
+  InvalidCondition,
+  InvalidThreshold,
+  DuplicateRule,
+  TooManyRules,
+  MemoryAllocationFailed
+};
+
+[[nodiscard]] constexpr std::string_view ToString(AlertError error) noexcept {
+  switch (error) {
+    case AlertError::Success:
+      return "Success";
+    case AlertError::InvalidName:
+      return "Invalid alert name";
+    case AlertError::InvalidPath:
+      return "Invalid JSON pointer path";
+    case AlertError::InvalidCondition:
+      return "Invalid alert condition";
+    case AlertError::InvalidThreshold:
+      return "Invalid alert threshold";
+    case AlertError::DuplicateRule:
+      return "Duplicate alert name";
+    case AlertError::TooManyRules:
+      return "Too many alert rules";
+    case AlertError::MemoryAllocationFailed:
+      return "Memory allocation failed";
+    default:
+      return "Unknown error";
+  }
+}
+
+namespace detail {
+
+constexpr size_t kMaxAlertRules = 1024;
+constexpr size_t kMaxAlertNameLength = 128;
+constexpr int64_t kMaxAlertDurationMs = 24 * 60 * 60 * 1000;
+constexpr int64_t kNotPending = std::numeric_limits<int64_t>::min();
+}  // namespace detail
+
+struct AlertRule {
+  std::string name;
+  std::string path;
+  AlertCondition condition = AlertCondition::Above;
+  double threshold = 0.0;
+  double hysteresis = 0.0;
+  int64_t durationMs = 0;
+};
+
+struct AlertEvent {
+  size_t rule = 0;
+  AlertState state = AlertState::Raised;
+  double value = 0.0;
+  int64_t timestamp = 0;
+};
+
+struct AlertStats {
+  size_t ruleCount = 0;
+  size_t activeCount = 0;
+  uint64_t evaluations = 0;
+  uint64_t raisedCount = 0;
+  uint64_t clearedCount = 0;
+  int64_t lastEvaluationNs = 0;
+  int64_t maxEvaluationNs = 0;
+  int64_t totalEvaluationNs = 0;
+};
+
+// Rules compile into one pointer walk that fills a value table plus a flat instruction array; evaluation touches
+// only those two arrays and the per-rule state, and never allocates.
+class AlertEngine {
+public:
+  AlertEngine() = default;
+
+  AlertEngine(const AlertEngine &) = delete;
+  AlertEngine &operator=(const AlertEngine &) = delete;
+
+  [[nodiscard]] AlertError AddRule(const AlertRule &rule) noexcept;
+  void ClearRules() noexcept;
+
+  [[nodiscard]] bool IsEnabled() const noexcept;
+  const std::vector<AlertEvent> &Evaluate(const json::SnapshotTree &tree, int64_t timestamp) noexcept;
+
+  [[nodiscard]] const AlertRule &GetRule(size_t index) const noexcept;
+  [[nodiscard]] AlertStats GetStats() const noexcept;
+
+private:
+  struct Instruction {
+    size_t slot = 0;
+    AlertCondition condition = AlertCondition::Above;
+    double raiseLevel = 0.0;
+    double clearLevel = 0.0;
+    int64_t durationMs = 0;
+  };
+
+  struct RuleState {
+    bool active = false;
+    bool hasPrevious = false;
+    int64_t pendingSince = detail::kNotPending;
+    double previousValue = 0.0;
+    int64_t previousTimestamp = 0;
+  };
+
+  std::vector<AlertRule> m_rules;
+  json::PointerResolver m_resolver;
+  std::vector<double> m_values;
+  std::vector<Instruction> m_program;
+  std::vector<RuleState> m_states;
+  std::vector<AlertEvent> m_events;
+  AlertStats m_stats;
+
+  void Compile(std::vector<AlertRule> rules);
+};
+
+}  // namespace alert
+
+#endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+#ifndef BATCH_BUFFER_HPP
+#define BATCH_BUFFER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "helper/binary_writer.hpp"
+
+namespace json {
+
+enum class BatchFraming { JsonArray = 0, Ndjson };
+
+namespace detail {
+
+constexpr size_t kInitialBatchCapacity = 64 * 1024;
+constexpr size_t kMaxBatchBytes = 64 * 1024 * 1024;
+}  // namespace detail
+
+struct BatchLimits {
+  size_t maxSamples = 0;
+  size_t maxBytes = 0;
+  std::chrono::milliseconds maxAge{0};
+};
+
+class BatchBuffer {
+public:
+  BatchBuffer();
+
+  BatchBuffer(const BatchBuffer &) = delete;
+  BatchBuffer &operator=(const BatchBuffer &) = delete;
+
+  void Configure(BatchFraming framing, const BatchLimits &limits) noexcept;
+  void Clear() noexcept;
+
+  [[nodiscard]] bool Append(std::string_view sample, uint64_t sequence, uint64_t timestamp,
+                            std::chrono::steady_clock::time_point now) noexcept;
+  [[nodiscard]] bool Append(const std::vector<uint8_t> &sample, BinaryFormat format, uint64_t sequence,
+                            uint64_t timestamp, std::chrono::steady_clock::time_point now) noexcept;
+  [[nodiscard]] bool Finish() noexcept;
+
+  [[nodiscard]] bool Matches(std::optional<BinaryFormat> format) const noexcept;
+  [[nodiscard]] bool ShouldFlush(std::chrono::steady_clock::time_point now) const noexcept;
+  [[nodiscard]] bool IsEmpty() const noexcept;
+  [[nodiscard]] bool IsBinary() const noexcept;
+  [[nodiscard]] size_t GetSampleCount() const noexcept;
+  [[nodiscard]] size_t GetSize() const noexcept;
+
+  [[nodiscard]] const std::string &GetText() const noexcept;
+  [[nodiscard]] const std::vector<uint8_t> &GetBytes() const noexcept;
+
+private:
+  std::string m_text;
+  BinaryWriter m_binary;
+  std::optional<BinaryFormat> m_format;
+  BatchFraming m_framing = BatchFraming::JsonArray;
+  BatchLimits m_limits;
+  size_t m_sampleCount = 0;
+  std::chrono::steady_clock::time_point m_firstSampleTime{};
+  bool m_finished = false;
+
+  void BeginSample(std::optional<BinaryFormat> format, std::chrono::steady_clock::time_point now);
+};
+
+}  // namespace json
+
+#endif
\ No newline at end of file
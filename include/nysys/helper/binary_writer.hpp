@@ -0,0 +1,99 @@
+#ifndef BINARY_WRITER_HPP
+#define BINARY_WRITER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace json {
+
+enum class BinaryFormat { Cbor = 0, MessagePack };
+
+namespace detail {
+
+constexpr size_t kMaxBinaryDepth = 32;
+constexpr size_t kInitialBinaryCapacity = 8 * 1024;
+constexpr size_t kContainerHeaderReserve = 5;
+}  // namespace detail
+
+class BinaryWriter {
+public:
+  struct Checkpoint {
+    size_t size = 0;
+    size_t depth = 0;
+    uint32_t count = 0;
+    bool afterKey = false;
+  };
+
+  BinaryWriter();
+
+  void Reset(BinaryFormat format) noexcept;
+
+  void BeginObject();
+  void EndObject();
+  void BeginArray();
+  void EndArray();
+  void Key(std::string_view key);
+
+  void Value(std::string_view value);
+  void Value(const char *value) { Value(std::string_view{value}); }
+  void Value(const std::string &value) { Value(std::string_view{value}); }
+  void Value(bool value);
+  void Value(double value);
+  void Null();
+  void RawValue(const uint8_t *data, size_t size);
+
+  template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+  void Value(T value) {
+    if constexpr (std::is_signed_v<T>) {
+      WriteInteger(static_cast<int64_t>(value));
+    } else {
+      WriteUnsigned(static_cast<uint64_t>(value));
+    }
+  }
+
+  template <typename T>
+  void Field(std::string_view key, const T &value) {
+    Key(key);
+    Value(value);
+  }
+
+  [[nodiscard]] Checkpoint Save() const noexcept;
+  void Restore(const Checkpoint &checkpoint) noexcept;
+
+  [[nodiscard]] const std::vector<uint8_t> &GetBuffer() const noexcept;
+  [[nodiscard]] BinaryFormat GetFormat() const noexcept;
+  [[nodiscard]] bool IsValid() const noexcept;
+
+private:
+  struct Container {
+    size_t headerOffset = 0;
+    uint32_t count = 0;
+    bool isMap = false;
+  };
+
+  std::vector<uint8_t> m_buffer;
+  std::array<Container, detail::kMaxBinaryDepth> m_containers{};
+  size_t m_depth = 0;
+  BinaryFormat m_format = BinaryFormat::Cbor;
+  bool m_afterKey = false;
+  bool m_valid = true;
+
+  void BeforeValue();
+  void PushContainer(bool isMap);
+  void PopContainer(bool isMap);
+  [[nodiscard]] size_t EncodeContainerHeader(uint8_t *out, bool isMap, uint32_t count) const noexcept;
+  void WriteCborHead(uint8_t majorType, uint64_t argument);
+  void WriteBigEndian(uint64_t value, size_t byteCount);
+  void WriteString(std::string_view value);
+  void WriteInteger(int64_t value);
+  void WriteUnsigned(uint64_t value);
+};
+
+}  // namespace json
+
+#endif
\ No newline at end of file
@@ -0,0 +1,87 @@
+#ifndef COUNTER_RATE_HPP
+#define COUNTER_RATE_HPP
+
+#include <cstdint>
+
+namespace counter {
+
+enum class Width { Bits32, Bits64 };
+
+struct Delta {
+  uint64_t value = 0;
+  bool reset = false;
+};
+
+constexpr uint64_t kCounter32Range = 1ULL << 32;
+constexpr uint64_t kCounter32Mask = kCounter32Range - 1;
+constexpr uint64_t kMaxPlausible32Wrap = kCounter32Range / 2;
+
+template <Width W>
+[[nodiscard]] constexpr Delta Difference(uint64_t current, uint64_t previous) noexcept {
+  if constexpr (W == Width::Bits32) {
+    current &= kCounter32Mask;
+    previous &= kCounter32Mask;
+
+    if (current >= previous) {
+      return {current - previous, false};
+    }
+
+    const uint64_t wrapped = (kCounter32Range - previous) + current;
+    if (wrapped > kMaxPlausible32Wrap) {
+      return {current, true};
+    }
+    return {wrapped, false};
+  } else {
+    if (current >= previous) {
+      return {current - previous, false};
+    }
+    return {current, true};
+  }
+}
+
+template <Width W>
+class CounterRate {
+public:
+  double Update(uint64_t raw, double elapsedSeconds) noexcept {
+    if (!m_hasBaseline) {
+      m_previous = raw;
+      m_hasBaseline = true;
+      m_delta = {};
+      m_rate = 0.0;
+      return m_rate;
+    }
+
+    m_delta = Difference<W>(raw, m_previous);
+    m_previous = raw;
+    m_rate = elapsedSeconds > 0.0 ? static_cast<double>(m_delta.value) / elapsedSeconds : 0.0;
+    return m_rate;
+  }
+
+  void Reset() noexcept {
+    m_previous = 0;
+    m_hasBaseline = false;
+    m_delta = {};
+    m_rate = 0.0;
+  }
+
+  [[nodiscard]] uint64_t GetDelta() const noexcept { return m_delta.value; }
+
+  [[nodiscard]] bool WasReset() const noexcept { return m_delta.reset; }
+
+  [[nodiscard]] double GetRate() const noexcept { return m_rate; }
+
+  [[nodiscard]] bool HasBaseline() const noexcept { return m_hasBaseline; }
+
+private:
+  uint64_t m_previous = 0;
+  Delta m_delta;
+  double m_rate = 0.0;
+  bool m_hasBaseline = false;
+};
+
+using CounterRate32 = CounterRate<Width::Bits32>;
+using CounterRate64 = CounterRate<Width::Bits64>;
+
+}  // namespace counter
+
+#endif
\ No newline at end of file
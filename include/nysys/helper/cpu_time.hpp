@@ -0,0 +1,48 @@
+#ifndef CPU_TIME_HPP
+#define CPU_TIME_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cputime {
+
+struct Breakdown {
+  double usage = 0.0;
+  double user = 0.0;
+  double system = 0.0;
+  double irq = 0.0;
+  double dpc = 0.0;
+  double idle = 0.0;
+};
+
+// Cumulative per-core times in the kernel's convention: kernel time includes idle, dpc and interrupt time.
+struct CounterColumns {
+  std::vector<uint64_t> idle;
+  std::vector<uint64_t> kernel;
+  std::vector<uint64_t> user;
+  std::vector<uint64_t> dpc;
+  std::vector<uint64_t> interrupt;
+
+  void Resize(size_t count);
+};
+
+struct ShareColumns {
+  std::vector<float> usage;
+  std::vector<float> user;
+  std::vector<float> system;
+  std::vector<float> irq;
+  std::vector<float> dpc;
+  std::vector<float> idle;
+
+  void Resize(size_t count);
+};
+
+// Differences the first count cores of two samples into per-core percentages and a machine-wide total. Every
+// column has to hold at least count entries; nothing is allocated, so it is safe to call on every tick.
+void ComputeShares(const CounterColumns &current, const CounterColumns &previous, size_t count, ShareColumns &shares,
+                   Breakdown &total) noexcept;
+
+}  // namespace cputime
+
+#endif
\ No newline at end of file
@@ -0,0 +1,14 @@
+#ifndef CRC32_HPP
+#define CRC32_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace codec {
+
+// CRC-32 as used by gzip and zip (reflected polynomial 0xEDB88320); pass a previous result as crc to extend it.
+[[nodiscard]] uint32_t Crc32(const uint8_t *data, size_t size, uint32_t crc = 0) noexcept;
+
+}  // namespace codec
+
+#endif
\ No newline at end of file
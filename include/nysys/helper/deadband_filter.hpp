@@ -0,0 +1,98 @@
+#ifndef DEADBAND_FILTER_HPP
+#define DEADBAND_FILTER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "helper/json_pointer.hpp"
+#include "helper/snapshot_tree.hpp"
+
+namespace filter {
+
+enum class DeadbandMode { Absolute = 0, Percent };
+
+enum class FilterDecision { Emit = 0, Heartbeat, Suppress };
+
+enum class DeadbandError {
+  Success = 0,
+  InvalidPath,
+  InvalidMode,
+  InvalidThreshold,
+  TooManyRules,
+  MemoryAllocationFailed
+};
+
+[[nodiscard]] constexpr std::string_view ToString(DeadbandError error) noexcept {
+  switch (error) {
+    case DeadbandError::Success:
+      return "Success";
+    case DeadbandError::InvalidPath:
+      return "Invalid JSON pointer path";
+    case DeadbandError::InvalidMode:
+      return "Invalid deadband mode";
+    case DeadbandError::InvalidThreshold:
+      return "Invalid deadband threshold";
+    case DeadbandError::TooManyRules:
+      return "Too many deadband rules";
+    case DeadbandError::MemoryAllocationFailed:
+      return "Memory allocation failed";
+    default:
+      return "Unknown error";
+  }
+}
+
+namespace detail {
+
+constexpr size_t kMaxDeadbandRules = 256;
+}  // namespace detail
+
+struct DeadbandRule {
+  json::PointerSegments segments;
+  size_t wildcardCount = 0;
+  DeadbandMode mode = DeadbandMode::Absolute;
+  double threshold = 0.0;
+};
+
+class DeadbandFilter {
+public:
+  DeadbandFilter() = default;
+
+  DeadbandFilter(const DeadbandFilter &) = delete;
+  DeadbandFilter &operator=(const DeadbandFilter &) = delete;
+
+  [[nodiscard]] DeadbandError AddRule(std::string_view path, DeadbandMode mode, double threshold) noexcept;
+  void ClearRules() noexcept;
+  void SetMaxSilence(std::chrono::milliseconds maxSilence) noexcept;
+
+  [[nodiscard]] bool IsEnabled() const noexcept;
+  [[nodiscard]] FilterDecision Evaluate(const json::SnapshotTree &lastEmitted, const json::SnapshotTree &current,
+                                        std::chrono::steady_clock::time_point now) const noexcept;
+  void Record(FilterDecision decision, std::chrono::steady_clock::time_point now) noexcept;
+  void ResetStats() noexcept;
+
+  [[nodiscard]] uint64_t GetEmittedCount() const noexcept;
+  [[nodiscard]] uint64_t GetSuppressedCount() const noexcept;
+  [[nodiscard]] uint64_t GetHeartbeatCount() const noexcept;
+
+private:
+  std::vector<DeadbandRule> m_rules;
+  std::chrono::milliseconds m_maxSilence{0};
+  std::chrono::steady_clock::time_point m_lastEmitTime{};
+  std::atomic<uint64_t> m_emittedCount{0};
+  std::atomic<uint64_t> m_suppressedCount{0};
+  std::atomic<uint64_t> m_heartbeatCount{0};
+
+  [[nodiscard]] bool HasSignificantChange(const json::SnapshotTree &lastEmitted,
+                                          const json::SnapshotTree &current) const noexcept;
+  [[nodiscard]] const DeadbandRule *FindRule(const std::string_view *path, size_t pathLength) const noexcept;
+  [[nodiscard]] bool IsOutsideDeadband(const std::string_view *path, size_t pathLength, double previous,
+                                       double current) const noexcept;
+};
+
+}  // namespace filter
+
+#endif
\ No newline at end of file
@@ -0,0 +1,131 @@
+#ifndef EXPRESSION_HPP
+#define EXPRESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "helper/json_pointer.hpp"
+#include "helper/snapshot_tree.hpp"
+
+namespace expr {
+
+enum class ExpressionError {
+  Success = 0,
+  InvalidName,
+  DuplicateName,
+  SyntaxError,
+  InvalidPath,
+  UnknownFunction,
+  TooComplex,
+  TooManyExpressions,
+  MemoryAllocationFailed
+};
+
+[[nodiscard]] constexpr std::string_view ToString(ExpressionError error) noexcept {
+  switch (error) {
+    case ExpressionError::Success:
+      return "Success";
+    case ExpressionError::InvalidName:
+      return "Invalid derived metric name";
+    case ExpressionError::DuplicateName:
+      return "Duplicate derived metric name";
+    case ExpressionError::SyntaxError:
+      return "Expression syntax error";
+    case ExpressionError::InvalidPath:
+      return "Invalid JSON pointer path";
+    case ExpressionError::UnknownFunction:
+      return "Unknown expression function";
+    case ExpressionError::TooComplex:
+      return "Expression too complex";
+    case ExpressionError::TooManyExpressions:
+      return "Too many derived metrics";
+    case ExpressionError::MemoryAllocationFailed:
+      return "Memory allocation failed";
+    default:
+      return "Unknown error";
+  }
+}
+
+namespace detail {
+
+constexpr size_t kMaxExpressions = 4096;
+constexpr size_t kMaxExpressionNameLength = 128;
+constexpr size_t kMaxExpressionLength = 4096;
+constexpr size_t kMaxStackDepth = 32;
+}  // namespace detail
+
+enum class OpCode : uint8_t {
+  Constant = 0,
+  Load,
+  Sum,
+  Average,
+  Minimum,
+  Maximum,
+  Count,
+  Add,
+  Subtract,
+  Multiply,
+  Divide,
+  Negate,
+  Min,
+  Max,
+  Abs
+};
+
+struct Instruction {
+  OpCode op = OpCode::Constant;
+  uint32_t operand = 0;
+};
+
+struct Aggregate {
+  double sum = 0.0;
+  double min = 0.0;
+  double max = 0.0;
+  uint32_t count = 0;
+  uint32_t matched = 0;
+};
+
+// Expressions compile to postfix bytecode over shared tables: scalar pointers resolve once per tick through one
+// PointerResolver and wildcard patterns aggregate once per tick, however many expressions reference them.
+class ExpressionEngine {
+public:
+  ExpressionEngine() = default;
+
+  ExpressionEngine(const ExpressionEngine &) = delete;
+  ExpressionEngine &operator=(const ExpressionEngine &) = delete;
+
+  [[nodiscard]] ExpressionError AddExpression(std::string_view name, std::string_view source) noexcept;
+  void ClearExpressions() noexcept;
+
+  [[nodiscard]] bool IsEnabled() const noexcept;
+  void Evaluate(const json::SnapshotTree &tree) noexcept;
+  [[nodiscard]] bool WriteSection(json::SnapshotTree &tree) const noexcept;
+
+  [[nodiscard]] size_t GetExpressionCount() const noexcept;
+  [[nodiscard]] double GetResult(size_t index) const noexcept;
+
+private:
+  struct Expression {
+    std::string name;
+    uint32_t begin = 0;
+    uint32_t end = 0;
+  };
+
+  std::vector<Expression> m_expressions;
+  std::vector<size_t> m_order;
+  std::vector<Instruction> m_code;
+  std::vector<double> m_constants;
+  std::vector<json::PointerSegments> m_loadPaths;
+  std::vector<json::PointerSegments> m_patterns;
+  json::PointerResolver m_resolver;
+  std::vector<double> m_loads;
+  std::vector<Aggregate> m_aggregates;
+  std::vector<double> m_results;
+};
+
+}  // namespace expr
+
+#endif
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef GZIP_HPP
+#define GZIP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace codec {
+
+namespace detail {
+
+constexpr size_t kWindowSize = 32 * 1024;
+constexpr size_t kMinMatch = 3;
+constexpr size_t kMaxMatch = 258;
+constexpr unsigned kHashBits = 15;
+constexpr size_t kMaxChainLength = 48;
+constexpr size_t kMaxStoredBlockSize = 65535;
+constexpr size_t kGzipHeaderSize = 10;
+constexpr size_t kGzipTrailerSize = 8;
+}  // namespace detail
+
+// Single-pass gzip (RFC 1952) writer: hash-chained LZ77 over a 32 KB window coded with the fixed deflate Huffman
+// tables, falling back to stored blocks when that would not be smaller. The match tables are kept between calls.
+class GzipEncoder {
+public:
+  GzipEncoder() = default;
+
+  GzipEncoder(const GzipEncoder &) = delete;
+  GzipEncoder &operator=(const GzipEncoder &) = delete;
+
+  [[nodiscard]] bool Compress(const uint8_t *data, size_t size, std::vector<uint8_t> &output) noexcept;
+
+private:
+  std::vector<int32_t> m_head;
+  std::vector<int32_t> m_previous;
+
+  void Deflate(const uint8_t *data, size_t size, std::vector<uint8_t> &output);
+  static void Store(const uint8_t *data, size_t size, std::vector<uint8_t> &output);
+};
+
+}  // namespace codec
+
+#endif
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef HANDLE_WRAPPER_HPP
+#define HANDLE_WRAPPER_HPP
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include <windows.h>
+
+#include <utility>
+
+class HandleWrapper {
+public:
+  explicit HandleWrapper(HANDLE handle = nullptr) noexcept : m_handle(handle) {}
+
+  ~HandleWrapper() noexcept { Close(); }
+
+  HandleWrapper(HandleWrapper &&other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+
+  HandleWrapper &operator=(HandleWrapper &&other) noexcept {
+    if (this != &other) {
+      Close();
+      m_handle = std::exchange(other.m_handle, nullptr);
+    }
+    return *this;
+  }
+
+  HandleWrapper(const HandleWrapper &) = delete;
+  HandleWrapper &operator=(const HandleWrapper &) = delete;
+
+  [[nodiscard]] HANDLE get() const noexcept { return m_handle; }
+
+  [[nodiscard]] HANDLE release() noexcept { return std::exchange(m_handle, nullptr); }
+
+  void reset(HANDLE newHandle = nullptr) noexcept {
+    Close();
+    m_handle = newHandle;
+  }
+
+  [[nodiscard]] explicit operator bool() const noexcept { return IsValid(); }
+
+  [[nodiscard]] bool IsValid() const noexcept { return m_handle && m_handle != INVALID_HANDLE_VALUE; }
+
+private:
+  void Close() noexcept {
+    if (IsValid()) {
+      CloseHandle(m_handle);
+      m_handle = nullptr;
+    }
+  }
+
+  HANDLE m_handle;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,154 @@
+#ifndef HTTP_SERVER_HPP
+#define HTTP_SERVER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace net {
+
+enum class ServerError { Success = 0, InvalidOptions, StartupFailed, SocketFailed, BindFailed, MemoryAllocationFailed };
+
+[[nodiscard]] constexpr std::string_view ToString(ServerError error) noexcept {
+  switch (error) {
+    case ServerError::Success:
+      return "Success";
+    case ServerError::InvalidOptions:
+      return "Invalid HTTP server options";
+    case ServerError::StartupFailed:
+      return "Socket library initialization failed";
+    case ServerError::SocketFailed:
+      return "Failed to create socket";
+    case ServerError::BindFailed:
+      return "Failed to bind loopback port";
+    case ServerError::MemoryAllocationFailed:
+      return "Memory allocation failed";
+    default:
+      return "Unknown error";
+  }
+}
+
+namespace detail {
+
+constexpr uint16_t kDefaultHttpPort = 8086;
+constexpr size_t kDefaultMaxHttpClients = 128;
+constexpr size_t kMaxHttpClients = 1024;
+constexpr size_t kMaxRequestBytes = 8 * 1024;
+constexpr size_t kMaxStreamBacklogBytes = 4 * 1024 * 1024;
+constexpr int64_t kKeepAliveTimeoutMs = 30 * 1000;
+constexpr int kPollTimeoutMs = 1000;
+constexpr size_t kReadChunkSize = 4096;
+constexpr uintptr_t kInvalidSocket = ~uintptr_t{0};
+}  // namespace detail
+
+struct ServerOptions {
+  uint16_t port = detail::kDefaultHttpPort;
+  size_t maxClients = detail::kDefaultMaxHttpClients;
+};
+
+struct ServerStats {
+  size_t clientCount = 0;
+  size_t streamCount = 0;
+  uint64_t requestCount = 0;
+  uint64_t rejectedCount = 0;
+  uint64_t publishedCount = 0;
+  uint64_t droppedCount = 0;
+};
+
+// Single-threaded loopback HTTP/1.1 server. Publish() serializes the HTTP response and the SSE event for a snapshot
+// once; every reader then queues a reference to those shared bytes, so readers add socket writes but no encoding.
+class HttpServer {
+public:
+  HttpServer();
+  ~HttpServer();
+
+  HttpServer(const HttpServer &) = delete;
+  HttpServer &operator=(const HttpServer &) = delete;
+
+  [[nodiscard]] ServerError Open(const ServerOptions &options) noexcept;
+  void Close() noexcept;
+  [[nodiscard]] bool IsOpen() const noexcept;
+  [[nodiscard]] uint16_t GetPort() const noexcept;
+
+  [[nodiscard]] bool Publish(std::string_view payload, std::string_view contentType, bool streamable) noexcept;
+  void Wake() noexcept;
+  void Poll(int timeoutMs) noexcept;
+
+  [[nodiscard]] ServerStats GetStats() const noexcept;
+
+private:
+  using SharedBytes = std::shared_ptr<const std::string>;
+
+  struct Frame {
+    uint64_t version = 0;
+    SharedBytes response;
+    SharedBytes event;
+  };
+
+  enum class ClientMode : uint8_t { Request = 0, Stream };
+
+  struct PollSet;
+
+  struct Client {
+    uintptr_t socket = detail::kInvalidSocket;
+    ClientMode mode = ClientMode::Request;
+    bool closeAfterWrite = false;
+    bool closed = false;
+    int64_t lastActivity = 0;
+    uint64_t version = 0;
+    std::string request;
+    std::deque<SharedBytes> output;
+    size_t outputOffset = 0;
+    size_t backlogBytes = 0;
+  };
+
+  uintptr_t m_listener = detail::kInvalidSocket;
+  uintptr_t m_waker = detail::kInvalidSocket;
+  uint16_t m_port = 0;
+  uint16_t m_wakePort = 0;
+  size_t m_maxClients = 0;
+  bool m_open = false;
+  bool m_startup = false;
+
+  mutable std::mutex m_frameMutex;
+  std::shared_ptr<const Frame> m_latest;
+  std::shared_ptr<const Frame> m_current;
+
+  std::vector<Client> m_clients;
+  std::unique_ptr<PollSet> m_pollSet;
+  SharedBytes m_streamHeader;
+  SharedBytes m_badRequest;
+  SharedBytes m_notFound;
+  SharedBytes m_notAllowed;
+  SharedBytes m_notAcceptable;
+  SharedBytes m_tooLarge;
+  SharedBytes m_noSnapshot;
+  SharedBytes m_busy;
+
+  std::atomic<size_t> m_clientCount{0};
+  std::atomic<size_t> m_streamCount{0};
+  std::atomic<uint64_t> m_requestCount{0};
+  std::atomic<uint64_t> m_rejectedCount{0};
+  std::atomic<uint64_t> m_publishedCount{0};
+  std::atomic<uint64_t> m_droppedCount{0};
+
+  void AcceptClients(int64_t now) noexcept;
+  void DeliverLatest(int64_t now) noexcept;
+  void ReadClient(Client &client, int64_t now) noexcept;
+  void ProcessRequests(Client &client) noexcept;
+  void HandleRequest(Client &client, std::string_view head) noexcept;
+  void StartStream(Client &client) noexcept;
+  void Enqueue(Client &client, const SharedBytes &bytes) noexcept;
+  void FlushClient(Client &client, int64_t now) noexcept;
+  void RemoveClosedClients() noexcept;
+};
+
+}  // namespace net
+
+#endif
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef JSON_POINTER_HPP
+#define JSON_POINTER_HPP
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json {
+
+namespace detail {
+
+constexpr std::string_view kPointerWildcard = "*";
+constexpr size_t kPointerIndexBufferSize = 24;
+}  // namespace detail
+
+using PointerSegments = std::vector<std::string>;
+using PointerIndexBuffer = std::array<char, detail::kPointerIndexBufferSize>;
+
+[[nodiscard]] std::optional<PointerSegments> ParsePointer(std::string_view pointer);
+
+[[nodiscard]] bool MatchesPointerPrefix(const PointerSegments &pattern, const std::string_view *path,
+                                        size_t pathLength) noexcept;
+
+[[nodiscard]] bool IsPointerAncestor(const std::string_view *path, size_t pathLength,
+                                     const PointerSegments &pattern) noexcept;
+
+[[nodiscard]] std::string_view FormatPointerIndex(size_t index, PointerIndexBuffer &buffer) noexcept;
+
+}  // namespace json
+
+#endif
\ No newline at end of file
@@ -1,10 +1,15 @@
 #ifndef JSON_STRUCTURE_HPP
 #define JSON_STRUCTURE_HPP
 
-#include <nlohmann/json.hpp>
+#include <cstdint>
 #include <optional>
 #include <string>
 
+#include "helper/binary_writer.hpp"
+#include "helper/json_writer.hpp"
+#include "helper/snapshot_tree.hpp"
+#include "helper/units.hpp"
+
 namespace nysys {
 
 class GPUList;
@@ -16,6 +21,7 @@ class NetworkList;
 class AudioList;
 class BatteryInfo;
 class MonitorList;
+struct LiveInfo;
 }  // namespace nysys
 
 namespace json {
@@ -23,15 +29,78 @@ namespace json {
 struct JsonConfig {
   bool prettyPrint = true;
   int indentSize = 2;
+  units::UnitsMode unitsMode = units::UnitsMode::Legacy;
 
   [[nodiscard]] static constexpr JsonConfig Default() noexcept { return JsonConfig{}; }
 };
 
+[[nodiscard]] bool WriteSystemInfo(
+    JsonWriter &writer, const nysys::GPUList *gpuList, const nysys::MotherboardInfo *mbInfo,
+    const nysys::CPUList *cpuList, const nysys::MemoryInfo *memInfo, const nysys::StorageList *storageList,
+    const nysys::NetworkList *networkList, const nysys::AudioList *audioList, const nysys::BatteryInfo *batteryInfo,
+    const nysys::MonitorList *monitorList, const nysys::LiveInfo *liveInfo,
+    const JsonConfig &config = JsonConfig::Default()) noexcept;
+
+[[nodiscard]] bool WriteSystemInfo(BinaryWriter &writer, BinaryFormat format, const nysys::GPUList *gpuList,
+                                   const nysys::MotherboardInfo *mbInfo, const nysys::CPUList *cpuList,
+                                   const nysys::MemoryInfo *memInfo, const nysys::StorageList *storageList,
+                                   const nysys::NetworkList *networkList, const nysys::AudioList *audioList,
+                                   const nysys::BatteryInfo *batteryInfo, const nysys::MonitorList *monitorList,
+                                   const nysys::LiveInfo *liveInfo,
+                                   units::UnitsMode unitsMode = units::UnitsMode::Legacy) noexcept;
+
+[[nodiscard]] bool WriteSystemInfo(SnapshotTree &tree, const nysys::GPUList *gpuList,
+                                   const nysys::MotherboardInfo *mbInfo, const nysys::CPUList *cpuList,
+                                   const nysys::MemoryInfo *memInfo, const nysys::StorageList *storageList,
+                                   const nysys::NetworkList *networkList, const nysys::AudioList *audioList,
+                                   const nysys::BatteryInfo *batteryInfo, const nysys::MonitorList *monitorList,
+                                   const nysys::LiveInfo *liveInfo,
+                                   units::UnitsMode unitsMode = units::UnitsMode::Legacy,
+                                   std::optional<uint64_t> inventoryHash = std::nullopt) noexcept;
+
+[[nodiscard]] bool WriteSystemInfo(JsonWriter &writer, const SnapshotTree &tree,
+                                   const JsonConfig &config = JsonConfig::Default()) noexcept;
+
+[[nodiscard]] bool WriteSystemInfo(BinaryWriter &writer, BinaryFormat format, const SnapshotTree &tree) noexcept;
+
+[[nodiscard]] uint64_t ComputeInventoryHash(const nysys::GPUList *gpuList, const nysys::MotherboardInfo *mbInfo,
+                                            const nysys::CPUList *cpuList, const nysys::AudioList *audioList,
+                                            const nysys::MonitorList *monitorList) noexcept;
+
+[[nodiscard]] bool WriteInventory(JsonWriter &writer, const nysys::GPUList *gpuList,
+                                  const nysys::MotherboardInfo *mbInfo, const nysys::CPUList *cpuList,
+                                  const nysys::AudioList *audioList, const nysys::MonitorList *monitorList,
+                                  uint64_t inventoryHash, const JsonConfig &config = JsonConfig::Default()) noexcept;
+
+[[nodiscard]] bool WriteInventory(BinaryWriter &writer, BinaryFormat format, const nysys::GPUList *gpuList,
+                                  const nysys::MotherboardInfo *mbInfo, const nysys::CPUList *cpuList,
+                                  const nysys::AudioList *audioList, const nysys::MonitorList *monitorList,
+                                  uint64_t inventoryHash,
+                                  units::UnitsMode unitsMode = units::UnitsMode::Legacy) noexcept;
+
+[[nodiscard]] bool WriteTelemetry(JsonWriter &writer, const nysys::MemoryInfo *memInfo,
+                                  const nysys::StorageList *storageList, const nysys::NetworkList *networkList,
+                                  const nysys::BatteryInfo *batteryInfo, const nysys::LiveInfo *liveInfo,
+                                  uint64_t inventoryHash, const JsonConfig &config = JsonConfig::Default()) noexcept;
+
+[[nodiscard]] bool WriteTelemetry(BinaryWriter &writer, BinaryFormat format, const nysys::MemoryInfo *memInfo,
+                                  const nysys::StorageList *storageList, const nysys::NetworkList *networkList,
+                                  const nysys::BatteryInfo *batteryInfo, const nysys::LiveInfo *liveInfo,
+                                  uint64_t inventoryHash,
+                                  units::UnitsMode unitsMode = units::UnitsMode::Legacy) noexcept;
+
+[[nodiscard]] bool WriteSystemDelta(JsonWriter &writer, const SnapshotTree &previous, const SnapshotTree &current,
+                                    bool keyframe, uint64_t sequence,
+                                    const JsonConfig &config = JsonConfig::Default()) noexcept;
+
+[[nodiscard]] bool WriteSystemDelta(BinaryWriter &writer, BinaryFormat format, const SnapshotTree &previous,
+                                    const SnapshotTree &current, bool keyframe, uint64_t sequence) noexcept;
+
 [[nodiscard]] std::optional<std::string> GenerateSystemInfo(
     const nysys::GPUList *gpuList, const nysys::MotherboardInfo *mbInfo, const nysys::CPUList *cpuList,
     const nysys::MemoryInfo *memInfo, const nysys::StorageList *storageList, const nysys::NetworkList *networkList,
     const nysys::AudioList *audioList, const nysys::BatteryInfo *batteryInfo, const nysys::MonitorList *monitorList,
-    const JsonConfig &config = JsonConfig::Default()) noexcept;
+    const nysys::LiveInfo *liveInfo, const JsonConfig &config = JsonConfig::Default()) noexcept;
 
 }  // namespace json
 
@@ -0,0 +1,91 @@
+#ifndef JSON_WRITER_HPP
+#define JSON_WRITER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace json {
+
+namespace detail {
+
+constexpr size_t kMaxWriterDepth = 32;
+constexpr size_t kInitialWriterCapacity = 16 * 1024;
+constexpr int kMinDecimalExponent = -4;
+constexpr int kMaxDecimalExponent = 15;
+}  // namespace detail
+
+[[nodiscard]] bool IsValidUtf8(std::string_view value) noexcept;
+
+class JsonWriter {
+public:
+  struct Checkpoint {
+    size_t size = 0;
+    size_t depth = 0;
+    bool hasElements = false;
+    bool afterKey = false;
+  };
+
+  JsonWriter();
+
+  void Reset(bool prettyPrint, int indentSize) noexcept;
+
+  void BeginObject();
+  void EndObject();
+  void BeginArray();
+  void EndArray();
+  void Key(std::string_view key);
+
+  void Value(std::string_view value);
+  void Value(const char *value) { Value(std::string_view{value}); }
+  void Value(const std::string &value) { Value(std::string_view{value}); }
+  void Value(bool value);
+  void Value(double value);
+  void Null();
+
+  template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+  void Value(T value) {
+    if constexpr (std::is_signed_v<T>) {
+      WriteInteger(static_cast<int64_t>(value));
+    } else {
+      WriteUnsigned(static_cast<uint64_t>(value));
+    }
+  }
+
+  template <typename T>
+  void Field(std::string_view key, const T &value) {
+    Key(key);
+    Value(value);
+  }
+
+  [[nodiscard]] Checkpoint Save() const noexcept;
+  void Restore(const Checkpoint &checkpoint) noexcept;
+
+  [[nodiscard]] const std::string &GetBuffer() const noexcept;
+  [[nodiscard]] std::string_view GetOutput() const noexcept;
+  [[nodiscard]] bool IsValid() const noexcept;
+
+private:
+  std::string m_buffer;
+  std::array<bool, detail::kMaxWriterDepth> m_hasElements{};
+  size_t m_depth = 0;
+  int m_indentSize = 0;
+  bool m_prettyPrint = false;
+  bool m_afterKey = false;
+  bool m_valid = true;
+
+  void BeforeValue();
+  void PushContainer(char open);
+  void PopContainer(char close);
+  void WriteIndent(size_t depth);
+  void WriteString(std::string_view value);
+  void WriteInteger(int64_t value);
+  void WriteUnsigned(uint64_t value);
+};
+
+}  // namespace json
+
+#endif
\ No newline at end of file
@@ -0,0 +1,234 @@
+#ifndef MODEL_FIELDS_HPP
+#define MODEL_FIELDS_HPP
+
+#include <string_view>
+#include <tuple>
+
+#include "helper/reflection.hpp"
+#include "helper/units.hpp"
+#include "helper/utils.hpp"
+#include "main/audio_info.hpp"
+#include "main/battery_info.hpp"
+#include "main/cpu_frequency_info.hpp"
+#include "main/cpu_info.hpp"
+#include "main/cpu_usage_info.hpp"
+#include "main/disk_io_info.hpp"
+#include "main/gpu_info.hpp"
+#include "main/memory_info.hpp"
+#include "main/monitor_info.hpp"
+#include "main/motherboard_info.hpp"
+#include "main/network_info.hpp"
+#include "main/network_traffic_info.hpp"
+#include "main/process_info.hpp"
+#include "main/storage_info.hpp"
+
+namespace reflect {
+
+template <>
+struct FieldTable<nysys::GPUInfo> {
+  static constexpr auto kFields = std::make_tuple(
+      MakeField("name", &nysys::GPUInfo::GetName),
+      MakeField("shared_memory",
+                [](const nysys::GPUInfo &gpu) { return units::Gigabytes(gpu.GetSharedMemoryBytes()); }),
+      MakeField("type",
+                [](const nysys::GPUInfo &gpu) { return std::string_view{gpu.IsIntegrated() ? "iGPU" : "dGPU"}; }),
+      MakeField("vram", [](const nysys::GPUInfo &gpu) { return units::Gigabytes(gpu.GetDedicatedMemoryBytes()); }));
+};
+
+template <>
+struct FieldTable<nysys::MotherboardInfo> {
+  static constexpr auto kFields = std::make_tuple(MakeField("bios_serial", &nysys::MotherboardInfo::GetBiosSerial),
+                                                  MakeField("bios_version", &nysys::MotherboardInfo::GetBiosVersion),
+                                                  MakeField("manufacturer", &nysys::MotherboardInfo::GetManufacturer),
+                                                  MakeField("product", &nysys::MotherboardInfo::GetProduct),
+                                                  MakeField("serial_number", &nysys::MotherboardInfo::GetSerial),
+                                                  MakeField("system_sku", &nysys::MotherboardInfo::GetSystemSKU));
+};
+
+template <>
+struct FieldTable<nysys::CPUInfo> {
+  static constexpr auto kFields = std::make_tuple(
+      MakeField("clock_speed", &nysys::CPUInfo::GetClockSpeed), MakeField("cores", &nysys::CPUInfo::GetCores),
+      MakeField("name", [](const nysys::CPUInfo &cpu) { return utils::TrimString(cpu.GetName()); }),
+      MakeField("threads", &nysys::CPUInfo::GetThreads));
+};
+
+template <>
+struct FieldTable<nysys::CPUTimeBreakdown> {
+  static constexpr auto kFields = std::make_tuple(
+      MakeField("dpc", [](const nysys::CPUTimeBreakdown &time) { return units::Rounded(time.dpc); }),
+      MakeField("idle", [](const nysys::CPUTimeBreakdown &time) { return units::Rounded(time.idle); }),
+      MakeField("irq", [](const nysys::CPUTimeBreakdown &time) { return units::Rounded(time.irq); }),
+      MakeField("system",
+                [](const nysys::CPUTimeBreakdown &time) { return units::Rounded(time.system); }),
+      MakeField("usage_percent",
+                [](const nysys::CPUTimeBreakdown &time) { return units::Rounded(time.usage); }),
+      MakeField("user", [](const nysys::CPUTimeBreakdown &time) { return units::Rounded(time.user); }));
+};
+
+template <>
+struct FieldTable<nysys::CPUFrequencyInfo> {
+  static constexpr auto kFields = std::make_tuple(
+      MakeField("avg_mhz",
+                [](const nysys::CPUFrequencyInfo &frequency) {
+                  return units::Rounded(frequency.GetAvgCurrentMhz());
+                }),
+      MakeField("interval_samples", &nysys::CPUFrequencyInfo::GetIntervalSampleCount),
+      MakeField("max_mhz", &nysys::CPUFrequencyInfo::GetMaxCurrentMhz),
+      MakeField("min_mhz", &nysys::CPUFrequencyInfo::GetMinCurrentMhz),
+      MakeField("throttle_events", &nysys::CPUFrequencyInfo::GetThrottleEventCount),
+      MakeField("throttled_cores", &nysys::CPUFrequencyInfo::GetThrottledCoreCount),
+      MakeField("throttling", &nysys::CPUFrequencyInfo::IsThrottling));
+};
+
+template <>
+struct FieldTable<nysys::RAMSlotInfo> {
+  static constexpr auto kFields = std::make_tuple(
+      MakeField("capacity", [](const nysys::RAMSlotInfo &slot) { return units::Gigabytes(slot.GetCapacity()); }),
+      MakeField("configured_speed", &nysys::RAMSlotInfo::GetConfiguredSpeed),
+      MakeField("location", &nysys::RAMSlotInfo::GetSlotLocation),
+      MakeField("manufacturer", &nysys::RAMSlotInfo::GetManufacturer),
+      MakeField("speed", &nysys::RAMSlotInfo::GetSpeed));
+};
+
+template <>
+struct FieldTable<nysys::MemoryInfo> {
+  static constexpr auto kFields = std::make_tuple(
+      MakeField("available",
+                [](const nysys::MemoryInfo &memory) { return units::Gigabytes(memory.GetAvailablePhysical()); }),
+      MakeField("total", [](const nysys::MemoryInfo &memory) { return units::Gigabytes(memory.GetTotalPhysical()); }),
+      MakeField("usage_percent", &nysys::MemoryInfo::GetMemoryLoad),
+      MakeField("used", [](const nysys::MemoryInfo &memory) { return units::Gigabytes(memory.GetUsedPhysical()); }));
+};
+
+template <>
+struct FieldTable<nysys::DiskIOInfo> {
+  static constexpr auto kFields = std::make_tuple(
+      MakeField("avg_queue_depth",
+                [](const nysys::DiskIOInfo &io) { return units::Rounded(io.GetAvgQueueDepth()); }),
+      MakeField("await_ms", [](const nysys::DiskIOInfo &io) { return units::Rounded(io.GetAwaitMs()); }),
+      MakeField("busy_percent",
+                [](const nysys::DiskIOInfo &io) { return units::Rounded(io.GetBusyPercent()); }),
+      MakeField("queue_depth", &nysys::DiskIOInfo::GetQueueDepth),
+      MakeField("read_bytes_per_sec",
+                [](const nysys::DiskIOInfo &io) { return units::Rounded(io.GetReadBytesPerSec()); }),
+      MakeField("read_iops", [](const nysys::DiskIOInfo &io) { return units::Rounded(io.GetReadIops()); }),
+      MakeField("write_bytes_per_sec",
+                [](const nysys::DiskIOInfo &io) { return units::Rounded(io.GetWriteBytesPerSec()); }),
+      MakeField("write_iops",
+                [](const nysys::DiskIOInfo &io) { return units::Rounded(io.GetWriteIops()); }));
+};
+
+template <>
+struct FieldTable<nysys::LogicalDiskInfo> {
+  static constexpr auto kFields = std::make_tuple(
+      MakeField("drive", &nysys::LogicalDiskInfo::GetDriveLetter),
+      MakeField("free_space",
+                [](const nysys::LogicalDiskInfo &disk) { return units::Gigabytes(disk.GetAvailableSpaceBytes()); }),
+      MakeField("interface", &nysys::LogicalDiskInfo::GetInterfaceType),
+      MakeField("model", &nysys::LogicalDiskInfo::GetModel),
+      MakeField("total_size",
+                [](const nysys::LogicalDiskInfo &disk) { return units::Gigabytes(disk.GetTotalSizeBytes()); }),
+      MakeField("type", &nysys::LogicalDiskInfo::GetType),
+      MakeField("used_space", [](const nysys::LogicalDiskInfo &disk) {
+        return units::Derived(disk.GetUsedSpaceBytes(),
+                              utils::RoundToDecimalPlaces(disk.GetTotalSize() - disk.GetAvailableSpace(), 2));
+      }));
+};
+
+template <>
+struct FieldTable<nysys::NetworkTrafficInfo> {
+  static constexpr auto kFields = std::make_tuple(
+      MakeField("rx_bytes_per_sec",
+                [](const nysys::NetworkTrafficInfo &traffic) {
+                  return units::Rounded(traffic.GetRxBytesPerSec());
+                }),
+      MakeField("rx_drops", &nysys::NetworkTrafficInfo::GetRxDropTotal),
+      MakeField("rx_drops_per_sec",
+                [](const nysys::NetworkTrafficInfo &traffic) {
+                  return units::Rounded(traffic.GetRxDropsPerSec());
+                }),
+      MakeField("rx_errors", &nysys::NetworkTrafficInfo::GetRxErrorTotal),
+      MakeField("rx_errors_per_sec",
+                [](const nysys::NetworkTrafficInfo &traffic) {
+                  return units::Rounded(traffic.GetRxErrorsPerSec());
+                }),
+      MakeField("rx_packets_per_sec",
+                [](const nysys::NetworkTrafficInfo &traffic) {
+                  return units::Rounded(traffic.GetRxPacketsPerSec());
+                }),
+      MakeField("tx_bytes_per_sec",
+                [](const nysys::NetworkTrafficInfo &traffic) {
+                  return units::Rounded(traffic.GetTxBytesPerSec());
+                }),
+      MakeField("tx_drops", &nysys::NetworkTrafficInfo::GetTxDropTotal),
+      MakeField("tx_drops_per_sec",
+                [](const nysys::NetworkTrafficInfo &traffic) {
+                  return units::Rounded(traffic.GetTxDropsPerSec());
+                }),
+      MakeField("tx_errors", &nysys::NetworkTrafficInfo::GetTxErrorTotal),
+      MakeField("tx_errors_per_sec",
+                [](const nysys::NetworkTrafficInfo &traffic) {
+                  return units::Rounded(traffic.GetTxErrorsPerSec());
+                }),
+      MakeField("tx_packets_per_sec", [](const nysys::NetworkTrafficInfo &traffic) {
+        return units::Rounded(traffic.GetTxPacketsPerSec());
+      }));
+};
+
+template <>
+struct FieldTable<nysys::NetworkAdapterInfo> {
+  static constexpr auto kFields = std::make_tuple(MakeField("ip_address", &nysys::NetworkAdapterInfo::GetIPAddress),
+                                                  MakeField("mac_address", &nysys::NetworkAdapterInfo::GetMacAddress),
+                                                  MakeField("name", &nysys::NetworkAdapterInfo::GetName),
+                                                  MakeField("status", &nysys::NetworkAdapterInfo::GetStatus));
+};
+
+template <>
+struct FieldTable<nysys::AudioDeviceInfo> {
+  static constexpr auto kFields = std::make_tuple(MakeField("manufacturer", &nysys::AudioDeviceInfo::GetManufacturer),
+                                                  MakeField("name", &nysys::AudioDeviceInfo::GetName));
+};
+
+template <>
+struct FieldTable<nysys::BatteryInfo> {
+  static constexpr auto kFields = std::make_tuple(MakeField("is_desktop", &nysys::BatteryInfo::IsDesktop),
+                                                  MakeField("percent", &nysys::BatteryInfo::GetPercent),
+                                                  MakeField("power_plugged", &nysys::BatteryInfo::IsPluggedIn));
+};
+
+template <>
+struct FieldTable<nysys::MonitorInfo> {
+  static constexpr auto kFields = std::make_tuple(
+      MakeField("aspect_ratio", &nysys::MonitorInfo::GetAspectRatio),
+      MakeField("current_resolution", &nysys::MonitorInfo::GetCurrentResolution),
+      MakeField("device_id", &nysys::MonitorInfo::GetDeviceId), MakeField("height", &nysys::MonitorInfo::GetHeight),
+      MakeField("is_primary", &nysys::MonitorInfo::IsPrimary),
+      MakeField("manufacturer", &nysys::MonitorInfo::GetManufacturer),
+      MakeField("native_resolution", &nysys::MonitorInfo::GetNativeResolution),
+      MakeField("physical_height_mm", &nysys::MonitorInfo::GetPhysicalHeightMm),
+      MakeField("physical_width_mm", &nysys::MonitorInfo::GetPhysicalWidthMm),
+      MakeField("refresh_rate", &nysys::MonitorInfo::GetRefreshRate),
+      MakeField("screen_size", &nysys::MonitorInfo::GetScreenSize), MakeField("width", &nysys::MonitorInfo::GetWidth));
+};
+
+template <>
+struct FieldTable<nysys::ProcessInfo> {
+  static constexpr auto kFields = std::make_tuple(
+      MakeField("cpu_percent",
+                [](const nysys::ProcessInfo &process) { return units::Rounded(process.GetCpuPercent()); }),
+      MakeField("io_read_rate", &nysys::ProcessInfo::GetIoReadRate),
+      MakeField("io_write_rate", &nysys::ProcessInfo::GetIoWriteRate),
+      MakeField("name", &nysys::ProcessInfo::GetName), MakeField("pid", &nysys::ProcessInfo::GetProcessId),
+      MakeField("working_set",
+                [](const nysys::ProcessInfo &process) { return units::Megabytes(process.GetWorkingSet()); }));
+};
+
+template <>
+struct FieldTable<nysys::ProcessList> {
+  static constexpr auto kFields = std::make_tuple(MakeField("count", &nysys::ProcessList::GetProcessCount));
+};
+
+}  // namespace reflect
+
+#endif
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef NT_HELPER_HPP
+#define NT_HELPER_HPP
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include <windows.h>
+
+#include <cstdint>
+
+namespace nt {
+
+using NtStatus = LONG;
+
+constexpr NtStatus kStatusSuccess = 0x00000000L;
+constexpr NtStatus kStatusInfoLengthMismatch = static_cast<NtStatus>(0xC0000004L);
+constexpr NtStatus kStatusBufferTooSmall = static_cast<NtStatus>(0xC0000023L);
+constexpr NtStatus kStatusProcedureNotFound = static_cast<NtStatus>(0xC000007AL);
+
+constexpr ULONG kSystemProcessInformation = 5;
+constexpr ULONG kSystemProcessorPerformanceInformation = 8;
+
+struct ProcessorPerformanceInformation {
+  LARGE_INTEGER IdleTime;
+  LARGE_INTEGER KernelTime;
+  LARGE_INTEGER UserTime;
+  LARGE_INTEGER DpcTime;
+  LARGE_INTEGER InterruptTime;
+  ULONG InterruptCount;
+};
+
+struct UnicodeString {
+  USHORT Length;
+  USHORT MaximumLength;
+  PWSTR Buffer;
+};
+
+struct SystemProcessInformation {
+  ULONG NextEntryOffset;
+  ULONG NumberOfThreads;
+  LARGE_INTEGER WorkingSetPrivateSize;
+  ULONG HardFaultCount;
+  ULONG NumberOfThreadsHighWatermark;
+  ULONGLONG CycleTime;
+  LARGE_INTEGER CreateTime;
+  LARGE_INTEGER UserTime;
+  LARGE_INTEGER KernelTime;
+  UnicodeString ImageName;
+  LONG BasePriority;
+  HANDLE UniqueProcessId;
+  HANDLE InheritedFromUniqueProcessId;
+  ULONG HandleCount;
+  ULONG SessionId;
+  ULONG_PTR UniqueProcessKey;
+  SIZE_T PeakVirtualSize;
+  SIZE_T VirtualSize;
+  ULONG PageFaultCount;
+  SIZE_T PeakWorkingSetSize;
+  SIZE_T WorkingSetSize;
+  SIZE_T QuotaPeakPagedPoolUsage;
+  SIZE_T QuotaPagedPoolUsage;
+  SIZE_T QuotaPeakNonPagedPoolUsage;
+  SIZE_T QuotaNonPagedPoolUsage;
+  SIZE_T PagefileUsage;
+  SIZE_T PeakPagefileUsage;
+  SIZE_T PrivatePageCount;
+  LARGE_INTEGER ReadOperationCount;
+  LARGE_INTEGER WriteOperationCount;
+  LARGE_INTEGER OtherOperationCount;
+  LARGE_INTEGER ReadTransferCount;
+  LARGE_INTEGER WriteTransferCount;
+  LARGE_INTEGER OtherTransferCount;
+};
+
+[[nodiscard]] constexpr bool IsSuccess(NtStatus status) noexcept { return status >= 0; }
+
+[[nodiscard]] inline uint64_t ToCounter(const LARGE_INTEGER &value) noexcept {
+  return value.QuadPart > 0 ? static_cast<uint64_t>(value.QuadPart) : 0;
+}
+
+[[nodiscard]] NtStatus QuerySystemInformation(ULONG infoClass, void *buffer, ULONG bufferSize,
+                                              ULONG *returnLength) noexcept;
+
+[[nodiscard]] NtStatus QuerySystemInformationEx(ULONG infoClass, void *input, ULONG inputSize, void *buffer,
+                                                ULONG bufferSize, ULONG *returnLength) noexcept;
+
+[[nodiscard]] bool HasQuerySystemInformationEx() noexcept;
+
+}  // namespace nt
+
+#endif
\ No newline at end of file
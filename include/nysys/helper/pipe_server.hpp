@@ -0,0 +1,227 @@
+#ifndef PIPE_SERVER_HPP
+#define PIPE_SERVER_HPP
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include <windows.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "helper/binary_writer.hpp"
+#include "helper/json_structure.hpp"
+#include "helper/json_writer.hpp"
+#include "helper/projection.hpp"
+#include "helper/snapshot_tree.hpp"
+
+namespace net {
+
+enum class PipeError { Success = 0, InvalidName, InvalidOptions, CreateFailed, MemoryAllocationFailed };
+
+[[nodiscard]] constexpr std::string_view ToString(PipeError error) noexcept {
+  switch (error) {
+    case PipeError::Success:
+      return "Success";
+    case PipeError::InvalidName:
+      return "Invalid pipe name";
+    case PipeError::InvalidOptions:
+      return "Invalid pipe server options";
+    case PipeError::CreateFailed:
+      return "Failed to create named pipe";
+    case PipeError::MemoryAllocationFailed:
+      return "Memory allocation failed";
+    default:
+      return "Unknown error";
+  }
+}
+
+// Every frame is a 4-byte little-endian body length, a type byte and the body.
+//   Subscribe (client): format byte (0 JSON, 1 CBOR, 2 MessagePack), 4-byte minimum interval in ms, then
+//                       newline-separated JSON pointers; no pointers selects the whole snapshot.
+//   Snapshot  (server): 8-byte version, 8-byte unix ms timestamp, encoded payload.
+//   Error     (server): SubscribeError byte, UTF-8 message.
+enum class FrameType : uint8_t { Subscribe = 1, Snapshot, Error };
+
+enum class SubscribeError : uint8_t {
+  Success = 0,
+  MalformedFrame,
+  UnknownFrame,
+  InvalidFormat,
+  InvalidInterval,
+  InvalidPath
+};
+
+[[nodiscard]] constexpr std::string_view ToString(SubscribeError error) noexcept {
+  switch (error) {
+    case SubscribeError::Success:
+      return "Success";
+    case SubscribeError::MalformedFrame:
+      return "Malformed frame";
+    case SubscribeError::UnknownFrame:
+      return "Unknown frame type";
+    case SubscribeError::InvalidFormat:
+      return "Invalid output format";
+    case SubscribeError::InvalidInterval:
+      return "Invalid minimum interval";
+    case SubscribeError::InvalidPath:
+      return "Invalid projection path";
+    default:
+      return "Unknown error";
+  }
+}
+
+namespace detail {
+
+constexpr std::string_view kDefaultPipeName = "\\\\.\\pipe\\nysys";
+constexpr size_t kDefaultMaxPipeClients = 200;
+constexpr size_t kMaxPipeClients = 250;
+constexpr size_t kListeningPipeInstances = 4;
+constexpr size_t kMaxPipeNameLength = 256;
+constexpr size_t kFrameHeaderSize = 5;
+constexpr size_t kSnapshotHeaderSize = 16;
+constexpr size_t kMaxSubscribeBytes = 64 * 1024;
+constexpr uint32_t kMaxSubscribeIntervalMs = 24 * 60 * 60 * 1000;
+constexpr int64_t kIntervalSlackMs = 25;
+constexpr DWORD kPipeBufferSize = 64 * 1024;
+constexpr size_t kPipeReadChunkSize = 4096;
+constexpr size_t kCompletionBatchSize = 64;
+constexpr DWORD kPipePollTimeoutMs = 1000;
+}  // namespace detail
+
+struct PipeOptions {
+  std::string name{detail::kDefaultPipeName};
+  size_t maxClients = detail::kDefaultMaxPipeClients;
+};
+
+struct PipeStats {
+  size_t clientCount = 0;
+  size_t filterCount = 0;
+  uint64_t publishedCount = 0;
+  uint64_t encodedCount = 0;
+  uint64_t sentCount = 0;
+  uint64_t skippedCount = 0;
+};
+
+// Overlapped named-pipe server driven by one completion port, so a single thread serves every client. Snapshots are
+// encoded lazily once per distinct filter signature (format plus sorted pointers) and the frame is shared by every
+// subscriber of that filter; a client whose pipe is still busy keeps only the newest pending frame.
+class PipeServer {
+public:
+  PipeServer() = default;
+  ~PipeServer();
+
+  PipeServer(const PipeServer &) = delete;
+  PipeServer &operator=(const PipeServer &) = delete;
+
+  [[nodiscard]] PipeError Open(const PipeOptions &options) noexcept;
+  void Close() noexcept;
+  [[nodiscard]] bool IsOpen() const noexcept;
+
+  // Cheap enough to call every tick; lets the producer skip copying a snapshot nobody has subscribed to.
+  [[nodiscard]] bool HasSubscribers() const noexcept;
+  [[nodiscard]] bool Publish(std::shared_ptr<const json::SnapshotTree> tree, int64_t timestampMs) noexcept;
+  void Wake() noexcept;
+  void Poll(DWORD timeoutMs) noexcept;
+
+  [[nodiscard]] PipeStats GetStats() const noexcept;
+
+private:
+  using SharedBytes = std::shared_ptr<const std::string>;
+
+  struct Snapshot {
+    std::shared_ptr<const json::SnapshotTree> tree;
+    uint64_t version = 0;
+    int64_t timestamp = 0;
+  };
+
+  struct Filter {
+    std::string signature;
+    uint8_t format = 0;
+    bool projected = false;
+    filter::Projection projection;
+    uint64_t version = 0;
+    SharedBytes frame;
+    size_t subscribers = 0;
+  };
+
+  enum class OperationKind : uint8_t { Connect = 0, Read, Write };
+
+  struct Client;
+
+  struct Operation {
+    OVERLAPPED overlapped{};
+    Client *client = nullptr;
+    OperationKind kind = OperationKind::Connect;
+  };
+
+  struct Client {
+    HANDLE pipe = INVALID_HANDLE_VALUE;
+    Operation connect;
+    Operation read;
+    Operation write;
+    bool connected = false;
+    bool closing = false;
+    size_t pending = 0;
+    std::array<char, detail::kPipeReadChunkSize> buffer{};
+    std::string incoming;
+    SharedBytes writing;
+    SharedBytes queuedError;
+    SharedBytes queuedSnapshot;
+    Filter *filter = nullptr;
+    uint32_t minIntervalMs = 0;
+    int64_t lastTimestamp = 0;
+    bool hasSent = false;
+  };
+
+  std::string m_name;
+  size_t m_maxClients = 0;
+  HANDLE m_port = nullptr;
+  bool m_firstInstance = true;
+
+  mutable std::mutex m_snapshotMutex;
+  std::shared_ptr<const Snapshot> m_latest;
+  std::shared_ptr<const Snapshot> m_current;
+
+  std::vector<std::unique_ptr<Client>> m_clients;
+  std::vector<std::unique_ptr<Filter>> m_filters;
+  json::SnapshotTree m_projected;
+  json::JsonWriter m_jsonWriter;
+  json::BinaryWriter m_binaryWriter;
+
+  std::atomic<size_t> m_clientCount{0};
+  std::atomic<size_t> m_filterCount{0};
+  std::atomic<uint64_t> m_publishedCount{0};
+  std::atomic<uint64_t> m_encodedCount{0};
+  std::atomic<uint64_t> m_sentCount{0};
+  std::atomic<uint64_t> m_skippedCount{0};
+
+  void ListenForClients() noexcept;
+  void OnCompletion(Operation &operation, bool success, DWORD bytes) noexcept;
+  void StartRead(Client &client) noexcept;
+  void StartWrite(Client &client) noexcept;
+  void ProcessFrames(Client &client) noexcept;
+  void Subscribe(Client &client, std::string_view body) noexcept;
+  void SendError(Client &client, SubscribeError error) noexcept;
+  void DeliverLatest() noexcept;
+  void Deliver(Client &client, const Snapshot &snapshot) noexcept;
+  [[nodiscard]] SharedBytes Encode(Filter &filter, const Snapshot &snapshot) noexcept;
+  void Detach(Client &client) noexcept;
+  void CloseClient(Client &client) noexcept;
+  void ReleaseClients() noexcept;
+};
+
+}  // namespace net
+
+#endif
\ No newline at end of file
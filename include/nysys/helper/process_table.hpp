@@ -0,0 +1,63 @@
+#ifndef PROCESS_TABLE_HPP
+#define PROCESS_TABLE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace proc {
+
+struct ProcessSample {
+  uint32_t processId = 0;
+  int64_t createTime = 0;
+  uint64_t cpuTime = 0;
+  uint64_t ioReadBytes = 0;
+  uint64_t ioWriteBytes = 0;
+  uint64_t workingSet = 0;
+  double cpuPercent = 0.0;
+  uint64_t ioReadRate = 0;
+  uint64_t ioWriteRate = 0;
+  const void *entry = nullptr;
+};
+
+void SortByProcessId(std::vector<ProcessSample> &samples);
+
+// Both tables must be sorted by process id. A sample is matched against the previous tick by id and creation time,
+// so a reused id starts from zero instead of inheriting the rates of the process that exited.
+void ComputeRates(std::vector<ProcessSample> &current, const std::vector<ProcessSample> &previous, double cpuScale,
+                  double ioScale) noexcept;
+
+// Leaves the indices of the count samples with the largest positive metric in heap, largest first. A bounded
+// min-heap keeps this O(n log count); heap should have capacity for count + 1 entries so it never reallocates.
+template <typename Metric>
+void SelectTop(const std::vector<ProcessSample> &samples, size_t count, Metric metric, std::vector<uint32_t> &heap) {
+  heap.clear();
+  if (count == 0) {
+    return;
+  }
+
+  const auto greater = [&samples, &metric](uint32_t a, uint32_t b) { return metric(samples[a]) > metric(samples[b]); };
+
+  for (uint32_t i = 0; i < static_cast<uint32_t>(samples.size()); ++i) {
+    const auto value = metric(samples[i]);
+    if (!(value > 0)) {
+      continue;
+    }
+
+    if (heap.size() < count) {
+      heap.push_back(i);
+      std::push_heap(heap.begin(), heap.end(), greater);
+    } else if (value > metric(samples[heap.front()])) {
+      std::pop_heap(heap.begin(), heap.end(), greater);
+      heap.back() = i;
+      std::push_heap(heap.begin(), heap.end(), greater);
+    }
+  }
+
+  std::sort_heap(heap.begin(), heap.end(), greater);
+}
+
+}  // namespace proc
+
+#endif
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef PROJECTION_HPP
+#define PROJECTION_HPP
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "helper/json_pointer.hpp"
+#include "helper/snapshot_tree.hpp"
+
+namespace filter {
+
+enum class ProjectionError { Success = 0, InvalidPath, TooManyPaths, MemoryAllocationFailed };
+
+[[nodiscard]] constexpr std::string_view ToString(ProjectionError error) noexcept {
+  switch (error) {
+    case ProjectionError::Success:
+      return "Success";
+    case ProjectionError::InvalidPath:
+      return "Invalid JSON pointer path";
+    case ProjectionError::TooManyPaths:
+      return "Too many projection paths";
+    case ProjectionError::MemoryAllocationFailed:
+      return "Memory allocation failed";
+    default:
+      return "Unknown error";
+  }
+}
+
+namespace detail {
+
+constexpr size_t kMaxProjectionPaths = 256;
+}  // namespace detail
+
+class Projection {
+public:
+  Projection() = default;
+
+  Projection(const Projection &) = delete;
+  Projection &operator=(const Projection &) = delete;
+
+  [[nodiscard]] ProjectionError SetPaths(const std::vector<std::string> &paths) noexcept;
+  void Clear() noexcept;
+
+  [[nodiscard]] bool IsEnabled() const noexcept;
+  [[nodiscard]] bool Requires(std::initializer_list<std::string_view> path) const noexcept;
+  [[nodiscard]] bool Apply(const json::SnapshotTree &source, json::SnapshotTree &destination) const noexcept;
+
+private:
+  enum class Coverage { None = 0, Partial, Full };
+
+  struct PathBuffer {
+    std::array<std::string_view, json::detail::kMaxTreeDepth + 1> segments{};
+    std::array<json::PointerIndexBuffer, json::detail::kMaxTreeDepth + 1> indices{};
+  };
+
+  std::vector<json::PointerSegments> m_patterns;
+
+  [[nodiscard]] Coverage Classify(const std::string_view *path, size_t pathLength) const noexcept;
+  void ApplyContainer(const json::SnapshotTree &source, size_t index, json::SnapshotTree &destination,
+                      PathBuffer &path, size_t depth) const;
+};
+
+}  // namespace filter
+
+#endif
\ No newline at end of file
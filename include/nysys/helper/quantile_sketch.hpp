@@ -0,0 +1,169 @@
+#ifndef QUANTILE_SKETCH_HPP
+#define QUANTILE_SKETCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "helper/json_pointer.hpp"
+#include "helper/snapshot_tree.hpp"
+
+namespace history {
+
+enum class SketchWindow { Sliding = 0, Tumbling, Run };
+
+enum class SketchError {
+  Success = 0,
+  InvalidPath,
+  InvalidWindow,
+  TooManyMetrics,
+  UnknownMetric,
+  MemoryAllocationFailed
+};
+
+[[nodiscard]] constexpr std::string_view ToString(SketchError error) noexcept {
+  switch (error) {
+    case SketchError::Success:
+      return "Success";
+    case SketchError::InvalidPath:
+      return "Invalid JSON pointer path";
+    case SketchError::InvalidWindow:
+      return "Invalid percentile window";
+    case SketchError::TooManyMetrics:
+      return "Too many percentile metrics";
+    case SketchError::UnknownMetric:
+      return "Unknown percentile metric";
+    case SketchError::MemoryAllocationFailed:
+      return "Memory allocation failed";
+    default:
+      return "Unknown error";
+  }
+}
+
+namespace detail {
+
+constexpr double kSketchRelativeAccuracy = 0.01;
+constexpr double kMinIndexableValue = 1e-9;
+constexpr size_t kMaxSketchBins = 1024;
+constexpr size_t kMaxSketchMetrics = 64;
+constexpr int64_t kMinSketchWindowMs = 1000;
+constexpr int64_t kMaxSketchWindowMs = 24 * 60 * 60 * 1000;
+constexpr size_t kMaxSketchSlices = 60;
+constexpr int64_t kDefaultSketchWindowMs = 60 * 1000;
+constexpr size_t kDefaultSketchSlices = 12;
+}  // namespace detail
+
+// Dense run of logarithmic bucket counts; once the run exceeds kMaxSketchBins the lowest buckets are collapsed,
+// which keeps the upper quantiles within the relative accuracy bound.
+class BucketStore {
+public:
+  void Add(int32_t index, uint64_t count);
+  void Merge(const BucketStore &other);
+  void Clear() noexcept;
+
+  [[nodiscard]] int32_t GetOffset() const noexcept;
+  [[nodiscard]] const std::vector<uint64_t> &GetCounts() const noexcept;
+  [[nodiscard]] size_t GetMemoryUsage() const noexcept;
+
+private:
+  std::vector<uint64_t> m_counts;
+  int32_t m_offset = 0;
+};
+
+// DDSketch with a fixed relative accuracy, so any two sketches merge exactly by adding bucket counts.
+class QuantileSketch {
+public:
+  void Add(double value);
+  void Merge(const QuantileSketch &other);
+  void Clear() noexcept;
+
+  [[nodiscard]] double Quantile(double quantile) const noexcept;
+  [[nodiscard]] uint64_t GetCount() const noexcept;
+  [[nodiscard]] double GetMin() const noexcept;
+  [[nodiscard]] double GetMax() const noexcept;
+  [[nodiscard]] double GetSum() const noexcept;
+  [[nodiscard]] size_t GetMemoryUsage() const noexcept;
+
+private:
+  BucketStore m_positive;
+  BucketStore m_negative;
+  uint64_t m_zeroCount = 0;
+  uint64_t m_count = 0;
+  double m_min = 0.0;
+  double m_max = 0.0;
+  double m_sum = 0.0;
+};
+
+struct SketchSummary {
+  int64_t windowStart = 0;
+  uint64_t count = 0;
+  double min = 0.0;
+  double max = 0.0;
+  double mean = 0.0;
+  double p50 = 0.0;
+  double p95 = 0.0;
+  double p99 = 0.0;
+};
+
+class MetricSketch {
+public:
+  MetricSketch(std::string pointer, json::PointerSegments path, int64_t windowMs, size_t slices);
+
+  void Add(int64_t timestamp, double value);
+  void Reset() noexcept;
+  void Summarize(SketchWindow window, int64_t now, QuantileSketch &scratch, SketchSummary &summary) const;
+
+  [[nodiscard]] std::string_view GetPointer() const noexcept;
+  [[nodiscard]] const json::PointerSegments &GetPath() const noexcept;
+  [[nodiscard]] size_t GetMemoryUsage() const noexcept;
+
+private:
+  std::string m_pointer;
+  json::PointerSegments m_path;
+  int64_t m_windowMs = 0;
+  int64_t m_sliceMs = 0;
+  std::vector<QuantileSketch> m_slices;
+  std::vector<int64_t> m_sliceStarts;
+  size_t m_head = 0;
+  QuantileSketch m_open;
+  QuantileSketch m_closed;
+  QuantileSketch m_run;
+  int64_t m_openStart = 0;
+  int64_t m_closedStart = 0;
+  int64_t m_runStart = 0;
+  int64_t m_lastTimestamp = 0;
+  bool m_hasSamples = false;
+};
+
+class SketchStore {
+public:
+  SketchStore() = default;
+
+  SketchStore(const SketchStore &) = delete;
+  SketchStore &operator=(const SketchStore &) = delete;
+
+  [[nodiscard]] SketchError AddMetric(std::string_view path) noexcept;
+  void ClearMetrics() noexcept;
+  [[nodiscard]] SketchError SetWindow(int64_t windowMs, size_t slices) noexcept;
+  void Reset() noexcept;
+
+  [[nodiscard]] bool IsEnabled() const noexcept;
+  void Record(const json::SnapshotTree &tree, int64_t timestamp) noexcept;
+  [[nodiscard]] SketchError Query(std::string_view metric, SketchWindow window, int64_t now,
+                                  SketchSummary &summary) const noexcept;
+  [[nodiscard]] bool WriteSection(json::SnapshotTree &tree, int64_t now) const noexcept;
+
+  [[nodiscard]] size_t GetMemoryUsage() const noexcept;
+
+private:
+  std::vector<MetricSketch> m_metrics;
+  int64_t m_windowMs = detail::kDefaultSketchWindowMs;
+  size_t m_slices = detail::kDefaultSketchSlices;
+  mutable QuantileSketch m_scratch;
+};
+
+}  // namespace history
+
+#endif
\ No newline at end of file
@@ -0,0 +1,123 @@
+#ifndef REFLECTION_HPP
+#define REFLECTION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace reflect {
+
+namespace detail {
+
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+constexpr size_t kAllFields = SIZE_MAX;
+}  // namespace detail
+
+template <typename Getter>
+struct FieldDescriptor {
+  std::string_view name;
+  Getter getter;
+};
+
+template <typename Getter>
+[[nodiscard]] constexpr FieldDescriptor<Getter> MakeField(std::string_view name, Getter getter) noexcept {
+  return FieldDescriptor<Getter>{name, getter};
+}
+
+template <typename T>
+struct FieldTable;
+
+template <typename T>
+constexpr size_t kFieldCount = std::tuple_size_v<std::decay_t<decltype(FieldTable<T>::kFields)>>;
+
+namespace detail {
+
+template <typename T, size_t First, typename Visitor, size_t... Indices>
+constexpr void VisitFields(Visitor &visitor, std::index_sequence<Indices...>) {
+  (visitor(std::get<First + Indices>(FieldTable<T>::kFields)), ...);
+}
+
+template <typename T, size_t... Indices>
+[[nodiscard]] constexpr bool NamesIncrease(std::index_sequence<Indices...>) noexcept {
+  return ((std::get<Indices>(FieldTable<T>::kFields).name < std::get<Indices + 1>(FieldTable<T>::kFields).name) &&
+          ...);
+}
+
+// Serializers rely on table order for sorted JSON keys, and field ranges are split by name position.
+template <typename T>
+constexpr bool kFieldNamesSorted =
+    NamesIncrease<T>(std::make_index_sequence<kFieldCount<T> == 0 ? 0 : kFieldCount<T> - 1>{});
+
+template <typename T, size_t Index = 0>
+[[nodiscard]] constexpr size_t FindField(std::string_view name) noexcept {
+  if constexpr (Index == kFieldCount<T>) {
+    return Index;
+  } else {
+    return std::get<Index>(FieldTable<T>::kFields).name == name ? Index : FindField<T, Index + 1>(name);
+  }
+}
+
+[[nodiscard]] inline uint64_t HashBytes(uint64_t hash, const void *data, size_t size) noexcept {
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * kFnvPrime;
+  }
+  return hash;
+}
+
+template <typename V>
+[[nodiscard]] uint64_t HashValue(uint64_t hash, const V &value) noexcept {
+  if constexpr (std::is_convertible_v<const V &, std::string_view>) {
+    const std::string_view text{value};
+    const uint64_t length = text.size();
+    hash = HashBytes(hash, &length, sizeof(length));
+    return HashBytes(hash, text.data(), text.size());
+  } else if constexpr (std::is_arithmetic_v<V>) {
+    const V normalized = value == V{} ? V{} : value;
+    return HashBytes(hash, &normalized, sizeof(normalized));
+  } else {
+    return HashValue(hash, value.value);
+  }
+}
+}  // namespace detail
+
+template <typename T>
+[[nodiscard]] constexpr size_t FieldIndex(std::string_view name) noexcept {
+  static_assert(detail::kFieldNamesSorted<T>, "FieldTable names must be strictly increasing");
+  return detail::FindField<T>(name);
+}
+
+template <typename Descriptor, typename T>
+decltype(auto) GetFieldValue(const Descriptor &field, const T &object) {
+  return std::invoke(field.getter, object);
+}
+
+template <typename T, size_t First = 0, size_t Last = detail::kAllFields, typename Visitor>
+constexpr void ForEachField(Visitor &&visitor) {
+  static_assert(detail::kFieldNamesSorted<T>, "FieldTable names must be strictly increasing");
+  constexpr size_t end = Last < kFieldCount<T> ? Last : kFieldCount<T>;
+  static_assert(First <= end, "Invalid field range");
+  detail::VisitFields<T, First>(visitor, std::make_index_sequence<end - First>{});
+}
+
+template <size_t First = 0, size_t Last = detail::kAllFields, typename Writer, typename T>
+void WriteFields(Writer &writer, const T &object) {
+  ForEachField<T, First, Last>(
+      [&writer, &object](const auto &field) { writer.Field(field.name, GetFieldValue(field, object)); });
+}
+
+template <typename T>
+[[nodiscard]] uint64_t HashFields(const T &object, uint64_t seed = detail::kFnvOffsetBasis) {
+  ForEachField<T>(
+      [&seed, &object](const auto &field) { seed = detail::HashValue(seed, GetFieldValue(field, object)); });
+  return seed;
+}
+
+}  // namespace reflect
+
+#endif
\ No newline at end of file
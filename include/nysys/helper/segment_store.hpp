@@ -0,0 +1,209 @@
+#ifndef SEGMENT_STORE_HPP
+#define SEGMENT_STORE_HPP
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include <windows.h>
+
+#include "helper/handle_wrapper.hpp"
+#endif
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace storage {
+
+enum class StoreError {
+  Success = 0,
+  InvalidPath,
+  InvalidOptions,
+  NotOpen,
+  OpenFailed,
+  MapFailed,
+  DirectoryLocked,
+  CorruptSegment,
+  RecordTooLarge,
+  MemoryAllocationFailed
+};
+
+[[nodiscard]] constexpr std::string_view ToString(StoreError error) noexcept {
+  switch (error) {
+    case StoreError::Success:
+      return "Success";
+    case StoreError::InvalidPath:
+      return "Invalid store directory";
+    case StoreError::InvalidOptions:
+      return "Invalid store options";
+    case StoreError::NotOpen:
+      return "Store is not open";
+    case StoreError::OpenFailed:
+      return "Failed to open segment file";
+    case StoreError::MapFailed:
+      return "Failed to map segment file";
+    case StoreError::DirectoryLocked:
+      return "Store directory is in use by another store";
+    case StoreError::CorruptSegment:
+      return "Segment file is corrupt";
+    case StoreError::RecordTooLarge:
+      return "Record does not fit in a segment";
+    case StoreError::MemoryAllocationFailed:
+      return "Memory allocation failed";
+    default:
+      return "Unknown error";
+  }
+}
+
+namespace detail {
+
+constexpr uint32_t kSegmentMagic = 0x4753594E;
+constexpr uint32_t kRecordMagic = 0x5253594E;
+constexpr uint32_t kSegmentVersion = 1;
+constexpr size_t kSegmentHeaderSize = 64;
+constexpr size_t kRecordHeaderSize = 32;
+constexpr size_t kRecordAlignment = 8;
+constexpr size_t kMinSegmentSize = 64 * 1024;
+constexpr size_t kMaxSegmentSize = 1024 * 1024 * 1024;
+constexpr size_t kDefaultSegmentSize = 16 * 1024 * 1024;
+constexpr uint64_t kDefaultRetentionBytes = 256ull * 1024 * 1024;
+constexpr size_t kDefaultQueueCapacity = 256;
+constexpr int64_t kDefaultFlushIntervalMs = 1000;
+constexpr std::string_view kSegmentExtension = ".nys";
+constexpr std::string_view kQuarantineExtension = ".corrupt";
+constexpr std::string_view kLockFileName = "store.lock";
+}  // namespace detail
+
+struct StoreOptions {
+  size_t segmentSize = detail::kDefaultSegmentSize;
+  uint64_t retentionBytes = detail::kDefaultRetentionBytes;
+};
+
+struct RecordView {
+  uint64_t sequence = 0;
+  int64_t timestamp = 0;
+  const uint8_t *data = nullptr;
+  size_t size = 0;
+};
+
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile() noexcept;
+
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  [[nodiscard]] StoreError Open(const std::filesystem::path &path, size_t createSize) noexcept;
+  void Close() noexcept;
+  void Flush(size_t offset, size_t size) const noexcept;
+
+  [[nodiscard]] uint8_t *GetData() const noexcept;
+  [[nodiscard]] size_t GetSize() const noexcept;
+
+private:
+#ifdef _WIN32
+  HANDLE m_file = INVALID_HANDLE_VALUE;
+  HANDLE m_mapping = nullptr;
+#else
+  int m_file = -1;
+#endif
+  uint8_t *m_view = nullptr;
+  size_t m_size = 0;
+};
+
+struct Segment {
+  MappedFile file;
+  std::filesystem::path path;
+  uint64_t index = 0;
+  uint64_t firstSequence = 0;
+  uint64_t recordCount = 0;
+  size_t end = 0;
+  size_t flushedEnd = 0;
+};
+
+class SegmentStore {
+public:
+  SegmentStore() = default;
+  ~SegmentStore();
+
+  SegmentStore(const SegmentStore &) = delete;
+  SegmentStore &operator=(const SegmentStore &) = delete;
+
+  [[nodiscard]] StoreError Open(const std::filesystem::path &directory, const StoreOptions &options) noexcept;
+  void Close() noexcept;
+
+  [[nodiscard]] StoreError Append(const uint8_t *data, size_t size, int64_t timestamp) noexcept;
+  void Flush() noexcept;
+
+  size_t Read(uint64_t fromSequence, size_t maxRecords, const std::function<bool(const RecordView &)> &visitor) const;
+
+  [[nodiscard]] bool IsOpen() const noexcept;
+  [[nodiscard]] uint64_t GetFirstSequence() const noexcept;
+  [[nodiscard]] uint64_t GetNextSequence() const noexcept;
+  [[nodiscard]] uint64_t GetRecoveredCount() const noexcept;
+
+private:
+  mutable std::mutex m_mutex;
+  std::filesystem::path m_directory;
+#ifdef _WIN32
+  HandleWrapper m_lock;
+#else
+  int m_lock = -1;
+#endif
+  StoreOptions m_options;
+  std::vector<Segment> m_segments;
+  uint64_t m_nextSequence = 0;
+  uint64_t m_recoveredCount = 0;
+
+  [[nodiscard]] StoreError Lock();
+  void Unlock() noexcept;
+  [[nodiscard]] StoreError Recover();
+  [[nodiscard]] StoreError Quarantine(Segment &segment);
+  [[nodiscard]] StoreError CreateSegment(uint64_t index);
+  void EnforceRetention() noexcept;
+};
+
+struct QueuedRecord {
+  std::string data;
+  int64_t timestamp = 0;
+};
+
+class RecordQueue {
+public:
+  explicit RecordQueue(size_t capacity = detail::kDefaultQueueCapacity);
+
+  RecordQueue(const RecordQueue &) = delete;
+  RecordQueue &operator=(const RecordQueue &) = delete;
+
+  [[nodiscard]] bool Push(std::string_view data, int64_t timestamp) noexcept;
+  size_t Drain(std::vector<QueuedRecord> &records) noexcept;
+  void Clear() noexcept;
+
+  [[nodiscard]] uint64_t GetDroppedCount() const noexcept;
+
+private:
+  mutable std::mutex m_mutex;
+  std::vector<QueuedRecord> m_slots;
+  size_t m_head = 0;
+  size_t m_size = 0;
+  uint64_t m_droppedCount = 0;
+};
+
+}  // namespace storage
+
+#endif
\ No newline at end of file
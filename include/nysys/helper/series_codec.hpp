@@ -0,0 +1,165 @@
+#ifndef SERIES_CODEC_HPP
+#define SERIES_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace history {
+
+enum class ValueEncoding : uint8_t { Float = 0, Integer };
+
+namespace detail {
+
+constexpr uint8_t kNoWindow = 0xFF;
+constexpr size_t kMaxSampleBytes = 24;
+constexpr double kMaxExactInteger = 9007199254740992.0;
+}  // namespace detail
+
+class BitReader {
+public:
+  BitReader(const uint8_t *data, size_t bitCount) noexcept : m_data(data), m_bitCount(bitCount) {}
+
+  [[nodiscard]] uint64_t ReadBits(unsigned count) noexcept {
+    uint64_t value = 0;
+    while (count > 0 && m_position < m_bitCount) {
+      const unsigned available = 8 - static_cast<unsigned>(m_position % 8);
+      const unsigned take = count < available ? count : available;
+      const uint8_t bits = static_cast<uint8_t>(m_data[m_position / 8] >> (available - take)) & ((1u << take) - 1);
+      value = (value << take) | bits;
+      m_position += take;
+      count -= take;
+    }
+    return value;
+  }
+
+  [[nodiscard]] bool ReadBit() noexcept { return ReadBits(1) != 0; }
+
+  [[nodiscard]] unsigned ReadUnary(unsigned limit) noexcept {
+    unsigned ones = 0;
+    while (ones < limit && ReadBit()) {
+      ++ones;
+    }
+    return ones;
+  }
+
+private:
+  const uint8_t *m_data;
+  size_t m_bitCount;
+  size_t m_position = 0;
+};
+
+class SeriesBlock {
+public:
+  void Clear() noexcept;
+
+  [[nodiscard]] bool Accepts(double value) const noexcept;
+  void Append(int64_t timestamp, double value);
+
+  template <typename Visitor>
+  void Decode(Visitor &&visitor) const;
+
+  [[nodiscard]] uint32_t GetCount() const noexcept { return m_count; }
+  [[nodiscard]] int64_t GetFirstTimestamp() const noexcept { return m_firstTimestamp; }
+  [[nodiscard]] int64_t GetLastTimestamp() const noexcept { return m_lastTimestamp; }
+  [[nodiscard]] ValueEncoding GetEncoding() const noexcept { return m_encoding; }
+  [[nodiscard]] size_t GetSize() const noexcept { return m_bytes.size(); }
+  [[nodiscard]] size_t GetCapacity() const noexcept { return m_bytes.capacity(); }
+
+private:
+  std::vector<uint8_t> m_bytes;
+  size_t m_bitCount = 0;
+  uint32_t m_count = 0;
+  ValueEncoding m_encoding = ValueEncoding::Float;
+  int64_t m_firstTimestamp = 0;
+  int64_t m_lastTimestamp = 0;
+  int64_t m_lastDelta = 0;
+  uint64_t m_lastBits = 0;
+  int64_t m_lastInteger = 0;
+  uint8_t m_leading = detail::kNoWindow;
+  uint8_t m_trailing = 0;
+
+  void WriteBits(uint64_t value, unsigned count);
+  void WriteTimestamp(int64_t timestamp);
+  void WriteFloat(double value);
+  void WriteInteger(int64_t value);
+};
+
+namespace detail {
+
+[[nodiscard]] inline int64_t ReadDeltaOfDelta(BitReader &reader) noexcept {
+  switch (reader.ReadUnary(4)) {
+    case 0:
+      return 0;
+    case 1:
+      return static_cast<int64_t>(reader.ReadBits(7)) - 63;
+    case 2:
+      return static_cast<int64_t>(reader.ReadBits(9)) - 255;
+    case 3:
+      return static_cast<int64_t>(reader.ReadBits(12)) - 2047;
+    default:
+      return reader.ReadBit() ? static_cast<int64_t>(reader.ReadBits(64))
+                              : static_cast<int64_t>(static_cast<int32_t>(reader.ReadBits(32)));
+  }
+}
+
+[[nodiscard]] inline uint64_t ReadVarint(BitReader &reader) noexcept {
+  uint64_t value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    const uint64_t group = reader.ReadBits(8);
+    value |= (group & 0x7F) << shift;
+    if ((group & 0x80) == 0) {
+      break;
+    }
+  }
+  return value;
+}
+
+[[nodiscard]] inline double BitsToDouble(uint64_t bits) noexcept {
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+}  // namespace detail
+
+template <typename Visitor>
+void SeriesBlock::Decode(Visitor &&visitor) const {
+  if (m_count == 0) {
+    return;
+  }
+
+  BitReader reader(m_bytes.data(), m_bitCount);
+  int64_t timestamp = static_cast<int64_t>(reader.ReadBits(64));
+  uint64_t bits = reader.ReadBits(64);
+  int64_t integer = static_cast<int64_t>(bits);
+  int64_t delta = 0;
+  unsigned leading = 0;
+  unsigned meaningful = 0;
+  visitor(timestamp, m_encoding == ValueEncoding::Integer ? static_cast<double>(integer) : detail::BitsToDouble(bits));
+
+  for (uint32_t i = 1; i < m_count; ++i) {
+    delta += detail::ReadDeltaOfDelta(reader);
+    timestamp += delta;
+
+    if (m_encoding == ValueEncoding::Integer) {
+      const uint64_t zigzag = detail::ReadVarint(reader);
+      integer += static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+      visitor(timestamp, static_cast<double>(integer));
+      continue;
+    }
+
+    if (reader.ReadBit()) {
+      if (reader.ReadBit()) {
+        leading = static_cast<unsigned>(reader.ReadBits(5));
+        meaningful = static_cast<unsigned>(reader.ReadBits(6)) + 1;
+      }
+      bits ^= reader.ReadBits(meaningful) << (64 - leading - meaningful);
+    }
+    visitor(timestamp, detail::BitsToDouble(bits));
+  }
+}
+
+}  // namespace history
+
+#endif
\ No newline at end of file
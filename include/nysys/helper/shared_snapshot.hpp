@@ -0,0 +1,96 @@
+#ifndef SHARED_SNAPSHOT_HPP
+#define SHARED_SNAPSHOT_HPP
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include <windows.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "nysys_shm.h"
+
+namespace shm {
+
+enum class SharedError {
+  Success = 0,
+  InvalidName,
+  InvalidOptions,
+  InUse,
+  CreateFailed,
+  MapFailed,
+  NotOpen,
+  PayloadTooLarge
+};
+
+[[nodiscard]] constexpr std::string_view ToString(SharedError error) noexcept {
+  switch (error) {
+    case SharedError::Success:
+      return "Success";
+    case SharedError::InvalidName:
+      return "Invalid shared memory name";
+    case SharedError::InvalidOptions:
+      return "Invalid shared memory capacity";
+    case SharedError::InUse:
+      return "Shared memory region is owned by another publisher";
+    case SharedError::CreateFailed:
+      return "Failed to create shared memory region";
+    case SharedError::MapFailed:
+      return "Failed to map shared memory region";
+    case SharedError::NotOpen:
+      return "Shared memory region is not open";
+    case SharedError::PayloadTooLarge:
+      return "Snapshot does not fit in the shared memory region";
+    default:
+      return "Unknown error";
+  }
+}
+
+namespace detail {
+
+constexpr size_t kMinSharedCapacity = 4 * 1024;
+constexpr size_t kMaxSharedCapacity = 256 * 1024 * 1024;
+constexpr size_t kDefaultSharedCapacity = 1024 * 1024;
+constexpr size_t kMaxSharedNameLength = 256;
+static_assert(sizeof(NysysShmHeader) == NYSYS_SHM_HEADER_SIZE, "shared snapshot header layout changed");
+}  // namespace detail
+
+// Single-writer seqlock over a named file mapping. The sequence turns odd before the payload is touched and even
+// after, so readers in other processes copy without locking and discard any copy that overlapped a write.
+class SnapshotPublisher {
+public:
+  SnapshotPublisher() = default;
+  ~SnapshotPublisher();
+
+  SnapshotPublisher(const SnapshotPublisher &) = delete;
+  SnapshotPublisher &operator=(const SnapshotPublisher &) = delete;
+
+  [[nodiscard]] SharedError Open(const std::string &name, size_t capacity) noexcept;
+  void Close() noexcept;
+  [[nodiscard]] bool IsOpen() const noexcept;
+
+  [[nodiscard]] SharedError Publish(std::string_view payload, int32_t format, int64_t timestampMs) noexcept;
+
+  [[nodiscard]] uint64_t GetVersion() const noexcept;
+  [[nodiscard]] uint64_t GetDroppedCount() const noexcept;
+  [[nodiscard]] size_t GetCapacity() const noexcept;
+
+private:
+  HANDLE m_mapping = nullptr;
+  NysysShmHeader *m_header = nullptr;
+  uint8_t *m_payload = nullptr;
+  size_t m_capacity = 0;
+  std::atomic<uint64_t> m_droppedCount{0};
+};
+
+}  // namespace shm
+
+#endif
\ No newline at end of file
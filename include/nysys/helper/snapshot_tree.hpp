@@ -0,0 +1,159 @@
+#ifndef SNAPSHOT_TREE_HPP
+#define SNAPSHOT_TREE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "helper/binary_writer.hpp"
+#include "helper/json_pointer.hpp"
+#include "helper/json_writer.hpp"
+
+namespace json {
+
+enum class SnapshotNodeType : uint8_t { Null = 0, Bool, Integer, Unsigned, Double, String, Object, Array };
+
+[[nodiscard]] constexpr bool IsContainer(SnapshotNodeType type) noexcept {
+  return type == SnapshotNodeType::Object || type == SnapshotNodeType::Array;
+}
+
+namespace detail {
+
+constexpr size_t kMaxTreeDepth = 32;
+constexpr size_t kInitialTreeNodes = 1024;
+constexpr size_t kInitialTreeStrings = 16 * 1024;
+constexpr size_t kUnresolvedNode = static_cast<size_t>(-1);
+}  // namespace detail
+
+struct SnapshotNode {
+  SnapshotNodeType type = SnapshotNodeType::Null;
+  bool boolValue = false;
+  uint32_t keyOffset = 0;
+  uint32_t keyLength = 0;
+  uint32_t stringOffset = 0;
+  uint32_t stringLength = 0;
+  uint32_t end = 0;
+  int64_t intValue = 0;
+  uint64_t uintValue = 0;
+  double doubleValue = 0.0;
+};
+
+class SnapshotTree {
+public:
+  struct Checkpoint {
+    size_t size = 0;
+    size_t stringSize = 0;
+    size_t depth = 0;
+    bool afterKey = false;
+    uint32_t keyOffset = 0;
+    uint32_t keyLength = 0;
+  };
+
+  SnapshotTree();
+
+  void Reset() noexcept;
+
+  void BeginObject();
+  void EndObject();
+  void BeginArray();
+  void EndArray();
+  void Key(std::string_view key);
+
+  void Value(std::string_view value);
+  void Value(const char *value) { Value(std::string_view{value}); }
+  void Value(const std::string &value) { Value(std::string_view{value}); }
+  void Value(bool value);
+  void Value(double value);
+  void Null();
+
+  template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+  void Value(T value) {
+    if constexpr (std::is_signed_v<T>) {
+      AddNode(SnapshotNodeType::Integer).intValue = static_cast<int64_t>(value);
+    } else {
+      AddNode(SnapshotNodeType::Unsigned).uintValue = static_cast<uint64_t>(value);
+    }
+  }
+
+  template <typename T>
+  void Field(std::string_view key, const T &value) {
+    Key(key);
+    Value(value);
+  }
+
+  void AppendSubtree(const SnapshotTree &source, size_t index);
+  void InsertField(std::string_view key, const SnapshotTree &value);
+
+  [[nodiscard]] Checkpoint Save() const noexcept;
+  void Restore(const Checkpoint &checkpoint) noexcept;
+
+  [[nodiscard]] const std::vector<SnapshotNode> &GetNodes() const noexcept;
+  [[nodiscard]] std::string_view GetKey(const SnapshotNode &node) const noexcept;
+  [[nodiscard]] std::string_view GetString(const SnapshotNode &node) const noexcept;
+  [[nodiscard]] bool IsEmpty() const noexcept;
+  [[nodiscard]] bool IsValid() const noexcept;
+
+  void Swap(SnapshotTree &other) noexcept;
+
+private:
+  std::vector<SnapshotNode> m_nodes;
+  std::string m_strings;
+  std::array<uint32_t, detail::kMaxTreeDepth> m_stack{};
+  size_t m_depth = 0;
+  uint32_t m_keyOffset = 0;
+  uint32_t m_keyLength = 0;
+  bool m_afterKey = false;
+  bool m_valid = true;
+
+  SnapshotNode &AddNode(SnapshotNodeType type);
+  [[nodiscard]] uint32_t StoreString(std::string_view value);
+  void PushContainer(SnapshotNodeType type);
+  void PopContainer(SnapshotNodeType type);
+};
+
+// Resolves a fixed set of pointers in one walk per tree; shared prefixes such as /storage/0 are matched once.
+class PointerResolver {
+public:
+  void Compile(const std::vector<PointerSegments> &paths);
+  void Clear() noexcept;
+  void Resolve(const SnapshotTree &tree) noexcept;
+
+  [[nodiscard]] std::optional<size_t> GetIndex(size_t path) const noexcept;
+  [[nodiscard]] size_t GetPathCount() const noexcept;
+
+private:
+  struct Step {
+    std::string segment;
+    size_t end = 0;
+  };
+
+  std::vector<Step> m_steps;
+  std::vector<size_t> m_targets;
+  std::vector<size_t> m_found;
+
+  void ResolveStep(const SnapshotTree &tree, size_t step, size_t index) noexcept;
+};
+
+[[nodiscard]] std::optional<size_t> FindChild(const SnapshotTree &tree, size_t index,
+                                              std::string_view segment) noexcept;
+[[nodiscard]] std::optional<size_t> FindNode(const SnapshotTree &tree, const PointerSegments &path) noexcept;
+[[nodiscard]] std::optional<double> GetNumber(const SnapshotNode &node) noexcept;
+
+void WriteSnapshotTree(JsonWriter &writer, const SnapshotTree &tree);
+void WriteSnapshotTree(BinaryWriter &writer, const SnapshotTree &tree);
+
+void WriteMergePatch(JsonWriter &writer, const SnapshotTree &previous, const SnapshotTree &current);
+void WriteMergePatch(BinaryWriter &writer, const SnapshotTree &previous, const SnapshotTree &current);
+
+// RFC 7386 has no way to set a member to null: a patch carrying one deletes the key. False when the patch from
+// previous to current would have to, so the caller sends a keyframe instead.
+[[nodiscard]] bool IsMergePatchLossless(const SnapshotTree &previous, const SnapshotTree &current) noexcept;
+
+}  // namespace json
+
+#endif
\ No newline at end of file
@@ -0,0 +1,189 @@
+#ifndef TIME_SERIES_HPP
+#define TIME_SERIES_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "helper/json_pointer.hpp"
+#include "helper/series_codec.hpp"
+#include "helper/snapshot_tree.hpp"
+
+namespace history {
+
+enum class Resolution { Raw = 0, Second, Minute, Hour };
+
+enum class HistoryError {
+  Success = 0,
+  InvalidPath,
+  InvalidResolution,
+  InvalidCapacity,
+  TooManyMetrics,
+  MemoryLimitExceeded,
+  UnknownMetric,
+  MemoryAllocationFailed
+};
+
+[[nodiscard]] constexpr std::string_view ToString(HistoryError error) noexcept {
+  switch (error) {
+    case HistoryError::Success:
+      return "Success";
+    case HistoryError::InvalidPath:
+      return "Invalid JSON pointer path";
+    case HistoryError::InvalidResolution:
+      return "Invalid history resolution";
+    case HistoryError::InvalidCapacity:
+      return "Invalid history capacity";
+    case HistoryError::TooManyMetrics:
+      return "Too many history metrics";
+    case HistoryError::MemoryLimitExceeded:
+      return "History memory limit exceeded";
+    case HistoryError::UnknownMetric:
+      return "Unknown history metric";
+    case HistoryError::MemoryAllocationFailed:
+      return "Memory allocation failed";
+    default:
+      return "Unknown error";
+  }
+}
+
+namespace detail {
+
+constexpr size_t kResolutionCount = 4;
+constexpr uint32_t kSamplesPerBlock = 128;
+constexpr size_t kMaxHistoryMetrics = 256;
+constexpr size_t kMaxHistoryCapacity = 1000000;
+constexpr size_t kMaxHistoryBytes = 256 * 1024 * 1024;
+constexpr std::array<int64_t, kResolutionCount> kBucketWidthsMs = {0, 1000, 60 * 1000, 60 * 60 * 1000};
+constexpr std::array<size_t, kResolutionCount> kDefaultHistoryCapacities = {3600, 3600, 1440, 720};
+
+// An integer block is only cut short by a non-integer sample, and the float block that follows accepts every value
+// until it is full, so each short block is followed by a full one. Twice the full-block count plus the active and
+// the partially evicted block therefore always holds capacity samples.
+[[nodiscard]] constexpr size_t RawBlockCount(size_t capacity) noexcept {
+  return 2 * ((capacity + kSamplesPerBlock - 1) / kSamplesPerBlock) + 2;
+}
+
+[[nodiscard]] constexpr int64_t BucketStart(int64_t timestamp, int64_t width) noexcept {
+  const int64_t remainder = timestamp % width;
+  return timestamp - (remainder < 0 ? remainder + width : remainder);
+}
+}  // namespace detail
+
+using HistoryCapacities = std::array<size_t, detail::kResolutionCount>;
+
+struct Point {
+  int64_t timestamp = 0;
+  double min = 0.0;
+  double max = 0.0;
+  double avg = 0.0;
+  double last = 0.0;
+  uint32_t count = 0;
+};
+
+// Keeps exactly the newest capacity samples. Eviction is per sample: the oldest block stays in place with a skip
+// count until every sample in it has aged out.
+class SampleRing {
+public:
+  void Allocate(size_t capacity);
+  void Push(int64_t timestamp, double value) noexcept;
+  void Query(int64_t from, int64_t to, std::vector<Point> &points) const;
+
+  [[nodiscard]] size_t GetSampleCount() const noexcept;
+  [[nodiscard]] size_t GetMemoryUsage() const noexcept;
+
+private:
+  std::vector<SeriesBlock> m_blocks;
+  size_t m_head = 0;
+  size_t m_size = 0;
+  size_t m_capacity = 0;
+  size_t m_count = 0;
+  uint32_t m_headSkip = 0;
+
+  void DropHeadBlock() noexcept;
+
+  [[nodiscard]] size_t Slot(size_t position) const noexcept;
+  [[nodiscard]] size_t LowerBound(int64_t timestamp) const noexcept;
+};
+
+struct Bucket {
+  int64_t start = 0;
+  double min = 0.0;
+  double max = 0.0;
+  double sum = 0.0;
+  double last = 0.0;
+  uint32_t count = 0;
+};
+
+class RollupRing {
+public:
+  void Allocate(size_t capacity);
+  void Push(const Bucket &bucket) noexcept;
+  void Query(int64_t from, int64_t to, std::vector<Point> &points) const;
+
+  [[nodiscard]] size_t GetMemoryUsage() const noexcept;
+
+private:
+  std::vector<int64_t> m_starts;
+  std::vector<double> m_mins;
+  std::vector<double> m_maxs;
+  std::vector<double> m_sums;
+  std::vector<double> m_lasts;
+  std::vector<uint32_t> m_counts;
+  size_t m_head = 0;
+  size_t m_size = 0;
+
+  [[nodiscard]] size_t Slot(size_t position) const noexcept;
+  [[nodiscard]] size_t LowerBound(int64_t start) const noexcept;
+};
+
+class MetricSeries {
+public:
+  MetricSeries(json::PointerSegments path, const HistoryCapacities &capacities);
+
+  void Append(int64_t timestamp, double value) noexcept;
+  void Query(int64_t from, int64_t to, Resolution resolution, std::vector<Point> &points) const;
+
+  [[nodiscard]] const json::PointerSegments &GetPath() const noexcept;
+  [[nodiscard]] size_t GetMemoryUsage() const noexcept;
+
+private:
+  json::PointerSegments m_path;
+  SampleRing m_raw;
+  std::array<RollupRing, detail::kResolutionCount - 1> m_rollups;
+  std::array<Bucket, detail::kResolutionCount - 1> m_open{};
+  int64_t m_lastTimestamp = 0;
+  bool m_hasSamples = false;
+};
+
+[[nodiscard]] size_t EstimateSeriesBytes(const HistoryCapacities &capacities) noexcept;
+
+class HistoryStore {
+public:
+  HistoryStore() = default;
+
+  HistoryStore(const HistoryStore &) = delete;
+  HistoryStore &operator=(const HistoryStore &) = delete;
+
+  [[nodiscard]] HistoryError AddMetric(std::string_view path) noexcept;
+  void ClearMetrics() noexcept;
+  [[nodiscard]] HistoryError SetCapacities(const HistoryCapacities &capacities) noexcept;
+
+  [[nodiscard]] bool IsEnabled() const noexcept;
+  void Record(const json::SnapshotTree &tree, int64_t timestamp) noexcept;
+  [[nodiscard]] HistoryError Query(std::string_view metric, int64_t from, int64_t to, Resolution resolution,
+                                   std::vector<Point> &points) const noexcept;
+
+  [[nodiscard]] const HistoryCapacities &GetCapacities() const noexcept;
+  [[nodiscard]] size_t GetMemoryUsage() const noexcept;
+
+private:
+  std::vector<MetricSeries> m_series;
+  HistoryCapacities m_capacities = detail::kDefaultHistoryCapacities;
+};
+
+}  // namespace history
+
+#endif
\ No newline at end of file
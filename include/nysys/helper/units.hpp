@@ -0,0 +1,113 @@
+#ifndef UNITS_HPP
+#define UNITS_HPP
+
+#include <cstdint>
+#include <string_view>
+
+#include "helper/utils.hpp"
+
+namespace units {
+
+enum class UnitsMode : uint8_t { Legacy = 0, Raw };
+
+enum class ByteUnit : uint8_t { Megabytes = 0, Gigabytes };
+
+struct Bytes {
+  uint64_t value = 0;
+  ByteUnit unit = ByteUnit::Gigabytes;
+};
+
+struct Decimal {
+  double value = 0.0;
+};
+
+// A byte count whose legacy rendering is not a plain conversion of the count, such as a difference of two values
+// that were already rounded to gigabytes.
+struct DerivedBytes {
+  uint64_t value = 0;
+  double legacy = 0.0;
+};
+
+[[nodiscard]] constexpr bool operator==(const Bytes &lhs, const Bytes &rhs) noexcept {
+  return lhs.value == rhs.value && lhs.unit == rhs.unit;
+}
+
+[[nodiscard]] constexpr bool operator==(const Decimal &lhs, const Decimal &rhs) noexcept {
+  return lhs.value == rhs.value;
+}
+
+[[nodiscard]] constexpr bool operator==(const DerivedBytes &lhs, const DerivedBytes &rhs) noexcept {
+  return lhs.value == rhs.value && lhs.legacy == rhs.legacy;
+}
+
+[[nodiscard]] constexpr Bytes Gigabytes(uint64_t bytes) noexcept { return Bytes{bytes, ByteUnit::Gigabytes}; }
+
+[[nodiscard]] constexpr Bytes Megabytes(uint64_t bytes) noexcept { return Bytes{bytes, ByteUnit::Megabytes}; }
+
+[[nodiscard]] constexpr Decimal Rounded(double value) noexcept { return Decimal{value}; }
+
+[[nodiscard]] constexpr DerivedBytes Derived(uint64_t bytes, double legacy) noexcept {
+  return DerivedBytes{bytes, legacy};
+}
+
+template <typename Writer>
+class UnitWriter {
+public:
+  using Checkpoint = typename Writer::Checkpoint;
+
+  UnitWriter(Writer &writer, UnitsMode mode) noexcept : m_writer(writer), m_mode(mode) {}
+
+  UnitWriter(const UnitWriter &) = delete;
+  UnitWriter &operator=(const UnitWriter &) = delete;
+
+  void BeginObject() { m_writer.BeginObject(); }
+  void EndObject() { m_writer.EndObject(); }
+  void BeginArray() { m_writer.BeginArray(); }
+  void EndArray() { m_writer.EndArray(); }
+  void Key(std::string_view key) { m_writer.Key(key); }
+  void Null() { m_writer.Null(); }
+
+  template <typename T>
+  void Value(const T &value) {
+    m_writer.Value(value);
+  }
+
+  void Value(const Bytes &bytes) {
+    if (m_mode == UnitsMode::Raw) {
+      m_writer.Value(bytes.value);
+    } else if (bytes.unit == ByteUnit::Megabytes) {
+      m_writer.Value(utils::BytesToMB(bytes.value));
+    } else {
+      m_writer.Value(utils::BytesToGB(bytes.value));
+    }
+  }
+
+  void Value(const DerivedBytes &bytes) {
+    if (m_mode == UnitsMode::Raw) {
+      m_writer.Value(bytes.value);
+    } else {
+      m_writer.Value(bytes.legacy);
+    }
+  }
+
+  void Value(const Decimal &decimal) {
+    m_writer.Value(m_mode == UnitsMode::Raw ? decimal.value : utils::RoundToDecimalPlaces(decimal.value));
+  }
+
+  template <typename T>
+  void Field(std::string_view key, const T &value) {
+    Key(key);
+    Value(value);
+  }
+
+  [[nodiscard]] Checkpoint Save() const noexcept { return m_writer.Save(); }
+  void Restore(const Checkpoint &checkpoint) noexcept { m_writer.Restore(checkpoint); }
+
+private:
+  Writer &m_writer;
+  UnitsMode m_mode;
+};
+
+}  // namespace units
+
+#endif
\ No newline at end of file
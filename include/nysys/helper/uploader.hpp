@@ -0,0 +1,207 @@
+#ifndef UPLOADER_HPP
+#define UPLOADER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "helper/batch_buffer.hpp"
+#include "helper/gzip.hpp"
+#include "helper/segment_store.hpp"
+
+namespace upload {
+
+enum class UploadError {
+  Success = 0,
+  InvalidUrl,
+  InvalidPath,
+  InvalidOptions,
+  SpoolFailed,
+  StartupFailed,
+  MemoryAllocationFailed
+};
+
+[[nodiscard]] constexpr std::string_view ToString(UploadError error) noexcept {
+  switch (error) {
+    case UploadError::Success:
+      return "Success";
+    case UploadError::InvalidUrl:
+      return "Invalid upload URL";
+    case UploadError::InvalidPath:
+      return "Invalid spool directory";
+    case UploadError::InvalidOptions:
+      return "Invalid uploader options";
+    case UploadError::SpoolFailed:
+      return "Failed to open spool";
+    case UploadError::StartupFailed:
+      return "Failed to initialize networking";
+    case UploadError::MemoryAllocationFailed:
+      return "Memory allocation failed";
+    default:
+      return "Unknown error";
+  }
+}
+
+namespace detail {
+
+constexpr uint64_t kDefaultSpoolBytes = 64ull * 1024 * 1024;
+constexpr size_t kMaxSpoolSegmentSize = 4 * 1024 * 1024;
+constexpr size_t kSpoolSegmentsPerSpool = 8;
+constexpr size_t kDefaultBatchRecords = 60;
+constexpr size_t kMaxBatchRecords = 10000;
+constexpr size_t kDefaultBatchBytes = 4 * 1024 * 1024;
+constexpr int64_t kDefaultBatchIntervalMs = 10 * 1000;
+constexpr int64_t kDefaultRequestTimeoutMs = 15 * 1000;
+constexpr int64_t kDefaultMinBackoffMs = 1000;
+constexpr int64_t kDefaultMaxBackoffMs = 5 * 60 * 1000;
+constexpr int64_t kIdleWaitMs = 1000;
+constexpr int64_t kSocketWaitSliceMs = 250;
+constexpr size_t kSendChunkSize = 16 * 1024;
+constexpr size_t kMaxResponseHeaderBytes = 16 * 1024;
+constexpr size_t kMaxHostLength = 253;
+constexpr std::string_view kCursorFileName = "upload.cursor";
+}  // namespace detail
+
+struct Endpoint {
+  std::string host;
+  uint16_t port = 80;
+  std::string target = "/";
+};
+
+// Accepts http://host[:port][/path]; the uploader speaks plain HTTP/1.1.
+[[nodiscard]] bool ParseUrl(std::string_view url, Endpoint &endpoint);
+
+struct UploadOptions {
+  std::string url;
+  uint64_t spoolBytes = detail::kDefaultSpoolBytes;
+  size_t batchRecords = detail::kDefaultBatchRecords;
+  size_t batchBytes = detail::kDefaultBatchBytes;
+  int64_t batchIntervalMs = detail::kDefaultBatchIntervalMs;
+  uint64_t maxBytesPerSecond = 0;
+  bool compress = true;
+  int64_t requestTimeoutMs = detail::kDefaultRequestTimeoutMs;
+  int64_t minBackoffMs = detail::kDefaultMinBackoffMs;
+  int64_t maxBackoffMs = detail::kDefaultMaxBackoffMs;
+};
+
+struct UploadStats {
+  uint64_t spooledCount = 0;
+  uint64_t pendingCount = 0;
+  uint64_t uploadedCount = 0;
+  uint64_t batchCount = 0;
+  uint64_t retryCount = 0;
+  uint64_t rejectedCount = 0;
+  uint64_t droppedCount = 0;
+  uint64_t sentBytes = 0;
+  int32_t lastStatus = 0;
+};
+
+// Token bucket with a one-second burst; a reservation larger than the balance goes into debt and reports how long
+// the caller has to wait before sending it.
+class Throttle {
+public:
+  void Configure(uint64_t bytesPerSecond, int64_t nowMs) noexcept;
+  [[nodiscard]] int64_t Reserve(size_t bytes, int64_t nowMs) noexcept;
+
+private:
+  uint64_t m_rate = 0;
+  double m_tokens = 0.0;
+  int64_t m_lastRefillMs = 0;
+};
+
+// The sampling thread appends each sample straight to the on-disk spool, so the spool's retention, not a queue
+// between the threads, bounds how long an outage can last; flushing, batching, compression and the POST itself run
+// on the thread that calls Poll. A batch keeps its sequence range and Idempotency-Key across retries, and the upload
+// cursor is persisted next to the spool so a restart resumes where the last acknowledged batch ended.
+class Uploader {
+public:
+  Uploader() = default;
+  ~Uploader();
+
+  Uploader(const Uploader &) = delete;
+  Uploader &operator=(const Uploader &) = delete;
+
+  [[nodiscard]] UploadError Open(const std::filesystem::path &directory, const UploadOptions &options) noexcept;
+  void Close() noexcept;
+  [[nodiscard]] bool IsOpen() const noexcept;
+
+  [[nodiscard]] bool Enqueue(std::string_view payload, uint8_t format, int64_t timestamp) noexcept;
+  void Poll() noexcept;
+  void Wake() noexcept;
+
+  [[nodiscard]] UploadStats GetStats() const noexcept;
+
+private:
+  struct Batch {
+    uint64_t firstSequence = 0;
+    uint64_t nextSequence = 0;
+    size_t recordCount = 0;
+    uint8_t format = 0;
+    std::string key;
+    std::vector<uint8_t> compressed;
+  };
+
+  struct Response {
+    int32_t status = 0;
+    int64_t retryAfterMs = -1;
+  };
+
+  Endpoint m_endpoint;
+  UploadOptions m_options;
+  std::filesystem::path m_cursorPath;
+  bool m_open = false;
+  bool m_startup = false;
+
+  storage::SegmentStore m_spool;
+  std::string m_enqueueBuffer;
+
+  std::mutex m_signalMutex;
+  std::condition_variable m_signal;
+  bool m_pendingWork = false;
+  std::atomic<bool> m_woken{false};
+
+  uint64_t m_spoolId = 0;
+  std::atomic<uint64_t> m_cursor{0};
+  Batch m_batch;
+  bool m_hasBatch = false;
+  size_t m_recordLimit = 0;
+  json::BatchBuffer m_batchBuffer;
+  std::vector<uint8_t> m_sample;
+  codec::GzipEncoder m_gzip;
+  std::string m_request;
+  std::string m_response;
+
+  Throttle m_throttle;
+  std::mt19937_64 m_random;
+  uint32_t m_attempts = 0;
+  int64_t m_retryAtMs = 0;
+  int64_t m_lastBatchMs = 0;
+
+  std::atomic<uint64_t> m_spooledCount{0};
+  std::atomic<uint64_t> m_uploadedCount{0};
+  std::atomic<uint64_t> m_batchCount{0};
+  std::atomic<uint64_t> m_retryCount{0};
+  std::atomic<uint64_t> m_rejectedCount{0};
+  std::atomic<uint64_t> m_droppedCount{0};
+  std::atomic<uint64_t> m_sentBytes{0};
+  std::atomic<int32_t> m_lastStatus{0};
+
+  [[nodiscard]] bool BuildBatch(int64_t nowMs) noexcept;
+  [[nodiscard]] Response Send() noexcept;
+  void Acknowledge(uint64_t nextSequence) noexcept;
+  void ScheduleRetry(int64_t retryAfterMs, int64_t nowMs) noexcept;
+  [[nodiscard]] bool WaitFor(int64_t timeoutMs) noexcept;
+  void LoadCursor() noexcept;
+  void SaveCursor() noexcept;
+};
+
+}  // namespace upload
+
+#endif
\ No newline at end of file
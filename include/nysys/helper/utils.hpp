@@ -1,22 +1,40 @@
 #ifndef UTILS_HPP
 #define UTILS_HPP
 
+#include <array>
 #include <cmath>
 #include <cstdint>
+#include <string_view>
 
 namespace utils {
 
 constexpr double kBytesPerGigabyte = 1024.0 * 1024.0 * 1024.0;
+constexpr double kBytesPerMegabyte = 1024.0 * 1024.0;
+constexpr std::array<double, 10> kPowersOfTen = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
 
 inline double RoundToDecimalPlaces(double value, int places = 2) {
-  const double multiplier = std::pow(10.0, places);
+  const double multiplier = places >= 0 && static_cast<size_t>(places) < kPowersOfTen.size()
+                                ? kPowersOfTen[static_cast<size_t>(places)]
+                                : std::pow(10.0, places);
   return std::round(value * multiplier) / multiplier;
 }
 
 inline double BytesToGB(uint64_t bytes) { return RoundToDecimalPlaces(static_cast<double>(bytes) / kBytesPerGigabyte); }
 
+inline double BytesToMB(uint64_t bytes) { return RoundToDecimalPlaces(static_cast<double>(bytes) / kBytesPerMegabyte); }
+
 inline double DoubleToGB(double bytes) { return RoundToDecimalPlaces(bytes / kBytesPerGigabyte); }
 
+inline std::string_view TrimString(std::string_view str) noexcept {
+  const auto first = str.find_first_not_of(" \t\n\r\f\v");
+  if (first == std::string_view::npos) {
+    return {};
+  }
+
+  const auto last = str.find_last_not_of(" \t\n\r\f\v");
+  return str.substr(first, last - first + 1);
+}
+
 }  // namespace utils
 
 #endif
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef INTERNAL_HPP
 #define INTERNAL_HPP
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -9,12 +11,17 @@
 
 #include "main/audio_info.hpp"
 #include "main/battery_info.hpp"
+#include "main/cpu_frequency_info.hpp"
 #include "main/cpu_info.hpp"
+#include "main/cpu_usage_info.hpp"
+#include "main/disk_io_info.hpp"
 #include "main/gpu_info.hpp"
 #include "main/memory_info.hpp"
 #include "main/monitor_info.hpp"
 #include "main/motherboard_info.hpp"
 #include "main/network_info.hpp"
+#include "main/network_traffic_info.hpp"
+#include "main/process_info.hpp"
 #include "main/storage_info.hpp"
 
 namespace nysys {
@@ -71,6 +78,217 @@ enum class MonitoringError {
   }
 }
 
+enum class OutputFormat { Json = 0, Cbor, MessagePack };
+
+[[nodiscard]] constexpr std::string_view ToString(OutputFormat format) noexcept {
+  switch (format) {
+    case OutputFormat::Json:
+      return "JSON";
+    case OutputFormat::Cbor:
+      return "CBOR";
+    case OutputFormat::MessagePack:
+      return "MessagePack";
+    default:
+      return "Unknown";
+  }
+}
+
+enum class DeadbandMode { Absolute = 0, Percent };
+
+enum class UnitsMode { Legacy = 0, Raw };
+
+enum class BatchFraming { JsonArray = 0, Ndjson };
+
+enum class HistoryResolution { Raw = 0, Second, Minute, Hour };
+
+enum class PercentileWindow { Sliding = 0, Tumbling, Run };
+
+enum class AlertCondition { Above = 0, Below, RateAbove, RateBelow };
+
+enum class AlertState { Raised = 0, Cleared };
+
+namespace detail {
+
+constexpr size_t kDefaultBatchMaxSamples = 10;
+constexpr size_t kDefaultBatchMaxBytes = 1024 * 1024;
+constexpr int64_t kDefaultBatchMaxAgeMs = 10000;
+constexpr size_t kMaxBatchSamples = 100000;
+constexpr size_t kDefaultHistoryRawCapacity = 3600;
+constexpr size_t kDefaultHistorySecondCapacity = 3600;
+constexpr size_t kDefaultHistoryMinuteCapacity = 1440;
+constexpr size_t kDefaultHistoryHourCapacity = 720;
+constexpr size_t kDefaultSegmentSize = 16 * 1024 * 1024;
+constexpr uint64_t kDefaultRetentionBytes = 256ull * 1024 * 1024;
+constexpr int64_t kDefaultStoreFlushIntervalMs = 1000;
+constexpr int64_t kDefaultPercentileWindowMs = 60 * 1000;
+constexpr size_t kDefaultPercentileSlices = 12;
+constexpr uint16_t kDefaultHttpPort = 8086;
+constexpr size_t kDefaultHttpMaxClients = 128;
+constexpr std::string_view kDefaultSharedSnapshotName = "Local\\NySysSnapshot";
+constexpr size_t kDefaultSharedSnapshotCapacity = 1024 * 1024;
+constexpr std::string_view kDefaultPipeName = "\\\\.\\pipe\\nysys";
+constexpr size_t kDefaultPipeMaxClients = 200;
+constexpr uint64_t kDefaultUploadSpoolBytes = 64ull * 1024 * 1024;
+constexpr size_t kDefaultUploadBatchRecords = 60;
+constexpr int64_t kDefaultUploadBatchIntervalMs = 10 * 1000;
+}  // namespace detail
+
+struct BatchOptions {
+  BatchFraming framing = BatchFraming::JsonArray;
+  size_t maxSamples = detail::kDefaultBatchMaxSamples;
+  size_t maxBytes = detail::kDefaultBatchMaxBytes;
+  std::chrono::milliseconds maxAge{detail::kDefaultBatchMaxAgeMs};
+};
+
+struct HistoryCapacity {
+  size_t raw = detail::kDefaultHistoryRawCapacity;
+  size_t seconds = detail::kDefaultHistorySecondCapacity;
+  size_t minutes = detail::kDefaultHistoryMinuteCapacity;
+  size_t hours = detail::kDefaultHistoryHourCapacity;
+};
+
+struct HistoryPoint {
+  int64_t timestamp = 0;
+  double min = 0.0;
+  double max = 0.0;
+  double avg = 0.0;
+  double last = 0.0;
+  uint32_t count = 0;
+};
+
+struct Percentiles {
+  int64_t windowStart = 0;
+  uint64_t count = 0;
+  double min = 0.0;
+  double max = 0.0;
+  double mean = 0.0;
+  double p50 = 0.0;
+  double p95 = 0.0;
+  double p99 = 0.0;
+};
+
+struct AlertRule {
+  std::string name;
+  std::string path;
+  AlertCondition condition = AlertCondition::Above;
+  double threshold = 0.0;
+  double hysteresis = 0.0;
+  std::chrono::milliseconds duration{0};
+};
+
+struct AlertEvent {
+  std::string_view name;
+  std::string_view path;
+  AlertState state = AlertState::Raised;
+  double value = 0.0;
+  double threshold = 0.0;
+  int64_t timestamp = 0;
+};
+
+struct AlertStats {
+  size_t ruleCount = 0;
+  size_t activeCount = 0;
+  uint64_t evaluations = 0;
+  uint64_t raisedCount = 0;
+  uint64_t clearedCount = 0;
+  std::chrono::nanoseconds lastEvaluation{0};
+  std::chrono::nanoseconds maxEvaluation{0};
+  std::chrono::nanoseconds averageEvaluation{0};
+};
+
+struct SegmentStoreOptions {
+  size_t segmentSize = detail::kDefaultSegmentSize;
+  uint64_t retentionBytes = detail::kDefaultRetentionBytes;
+  std::chrono::milliseconds flushInterval{detail::kDefaultStoreFlushIntervalMs};
+};
+
+struct SegmentStoreStats {
+  uint64_t firstSequence = 0;
+  uint64_t nextSequence = 0;
+  uint64_t recoveredCount = 0;
+  uint64_t droppedCount = 0;
+};
+
+struct HttpServerOptions {
+  uint16_t port = detail::kDefaultHttpPort;
+  size_t maxClients = detail::kDefaultHttpMaxClients;
+};
+
+struct HttpServerStats {
+  uint16_t port = 0;
+  size_t clientCount = 0;
+  size_t streamCount = 0;
+  uint64_t requestCount = 0;
+  uint64_t rejectedCount = 0;
+  uint64_t publishedCount = 0;
+  uint64_t droppedCount = 0;
+};
+
+struct SharedSnapshotStats {
+  uint64_t version = 0;
+  uint64_t droppedCount = 0;
+  size_t capacity = 0;
+};
+
+struct PipeServerOptions {
+  std::string name{detail::kDefaultPipeName};
+  size_t maxClients = detail::kDefaultPipeMaxClients;
+};
+
+struct PipeServerStats {
+  size_t clientCount = 0;
+  size_t filterCount = 0;
+  uint64_t publishedCount = 0;
+  uint64_t encodedCount = 0;
+  uint64_t sentCount = 0;
+  uint64_t skippedCount = 0;
+};
+
+struct UploaderOptions {
+  uint64_t spoolBytes = detail::kDefaultUploadSpoolBytes;
+  size_t batchRecords = detail::kDefaultUploadBatchRecords;
+  std::chrono::milliseconds batchInterval{detail::kDefaultUploadBatchIntervalMs};
+  uint64_t maxBytesPerSecond = 0;
+  bool compress = true;
+};
+
+struct UploaderStats {
+  uint64_t spooledCount = 0;
+  uint64_t pendingCount = 0;
+  uint64_t uploadedCount = 0;
+  uint64_t batchCount = 0;
+  uint64_t retryCount = 0;
+  uint64_t rejectedCount = 0;
+  uint64_t droppedCount = 0;
+  uint64_t sentBytes = 0;
+  int32_t lastStatus = 0;
+};
+
+struct FilterStats {
+  uint64_t emittedCount = 0;
+  uint64_t suppressedCount = 0;
+  uint64_t heartbeatCount = 0;
+};
+
+struct CollectionPlan {
+  bool gpu = true;
+  bool motherboard = true;
+  bool cpu = true;
+  bool audio = true;
+  bool monitors = true;
+  bool memory = true;
+  bool ramSlots = true;
+  bool storage = true;
+  bool storageDetails = true;
+  bool network = true;
+  bool battery = true;
+  bool cpuUsage = true;
+  bool cpuFrequency = true;
+  bool processes = true;
+  bool diskIO = true;
+  bool networkTraffic = true;
+};
+
 class MonitoringException : public std::runtime_error {
 public:
   explicit MonitoringException(MonitoringError errorCode)
@@ -105,6 +323,11 @@ struct StaticInfo {
 
   [[nodiscard]] bool IsComplete() const noexcept { return gpuList && mbInfo && cpuList && audioList && monitorList; }
 
+  [[nodiscard]] bool IsComplete(const CollectionPlan &plan) const noexcept {
+    return (!plan.gpu || gpuList) && (!plan.motherboard || mbInfo) && (!plan.cpu || cpuList) &&
+           (!plan.audio || audioList) && (!plan.monitors || monitorList);
+  }
+
   [[nodiscard]] bool HasGPUInfo() const noexcept { return static_cast<bool>(gpuList); }
 
   [[nodiscard]] bool HasMotherboardInfo() const noexcept { return static_cast<bool>(mbInfo); }
@@ -168,6 +391,10 @@ struct DynamicInfo {
 
   [[nodiscard]] bool IsEssentialComplete() const noexcept { return memInfo && storageList && networkList; }
 
+  [[nodiscard]] bool IsEssentialComplete(const CollectionPlan &plan) const noexcept {
+    return (!plan.memory || memInfo) && (!plan.storage || storageList) && (!plan.network || networkList);
+  }
+
   [[nodiscard]] bool HasMemoryInfo() const noexcept { return static_cast<bool>(memInfo); }
 
   [[nodiscard]] bool HasStorageInfo() const noexcept { return static_cast<bool>(storageList); }
@@ -206,6 +433,54 @@ struct DynamicInfo {
   void ResetNetworkInfo() noexcept { networkList.reset(); }
 };
 
+struct LiveInfo {
+  std::unique_ptr<CPUUsageInfo> cpuUsage;
+  std::unique_ptr<CPUFrequencyInfo> cpuFrequency;
+  std::unique_ptr<ProcessList> processList;
+  std::unique_ptr<DiskIOList> diskIO;
+  std::unique_ptr<NetworkTrafficList> networkTraffic;
+
+  LiveInfo() = default;
+
+  LiveInfo(LiveInfo &&) = default;
+  LiveInfo &operator=(LiveInfo &&) = default;
+
+  LiveInfo(const LiveInfo &) = delete;
+  LiveInfo &operator=(const LiveInfo &) = delete;
+
+  [[nodiscard]] bool IsComplete() const noexcept {
+    return cpuUsage && cpuFrequency && processList && diskIO && networkTraffic;
+  }
+
+  [[nodiscard]] bool HasCPUUsageInfo() const noexcept { return static_cast<bool>(cpuUsage); }
+
+  [[nodiscard]] bool HasCPUFrequencyInfo() const noexcept { return static_cast<bool>(cpuFrequency); }
+
+  [[nodiscard]] bool HasProcessInfo() const noexcept { return static_cast<bool>(processList); }
+
+  [[nodiscard]] bool HasDiskIOInfo() const noexcept { return static_cast<bool>(diskIO); }
+
+  [[nodiscard]] bool HasNetworkTrafficInfo() const noexcept { return static_cast<bool>(networkTraffic); }
+
+  void Reset() noexcept {
+    cpuUsage.reset();
+    cpuFrequency.reset();
+    processList.reset();
+    diskIO.reset();
+    networkTraffic.reset();
+  }
+
+  void ResetCPUUsageInfo() noexcept { cpuUsage.reset(); }
+
+  void ResetCPUFrequencyInfo() noexcept { cpuFrequency.reset(); }
+
+  void ResetProcessInfo() noexcept { processList.reset(); }
+
+  void ResetDiskIOInfo() noexcept { diskIO.reset(); }
+
+  void ResetNetworkTrafficInfo() noexcept { networkTraffic.reset(); }
+};
+
 }  // namespace nysys
 
 #endif
\ No newline at end of file
@@ -0,0 +1,118 @@
+#ifndef CPU_FREQUENCY_INFO_HPP
+#define CPU_FREQUENCY_INFO_HPP
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include <windows.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace nysys {
+
+enum class CPUFrequencyError {
+  Success = 0,
+  ProcessorCountFailed,
+  MemoryAllocationFailed,
+  PowerInformationFailed,
+  InvalidParameter
+};
+
+[[nodiscard]] constexpr std::string_view ToString(CPUFrequencyError error) noexcept {
+  switch (error) {
+    case CPUFrequencyError::Success:
+      return "Success";
+    case CPUFrequencyError::ProcessorCountFailed:
+      return "Failed to retrieve logical processor count";
+    case CPUFrequencyError::MemoryAllocationFailed:
+      return "Memory allocation failed";
+    case CPUFrequencyError::PowerInformationFailed:
+      return "Processor power information query failed";
+    case CPUFrequencyError::InvalidParameter:
+      return "Invalid parameter";
+    default:
+      return "Unknown error";
+  }
+}
+
+template <typename T>
+using CPUFrequencyResult = std::optional<T>;
+
+class CPUFrequencyInfo {
+public:
+  CPUFrequencyInfo() noexcept;
+
+  ~CPUFrequencyInfo() = default;
+
+  CPUFrequencyInfo(CPUFrequencyInfo &&other) noexcept = default;
+  CPUFrequencyInfo &operator=(CPUFrequencyInfo &&other) noexcept = default;
+
+  CPUFrequencyInfo(const CPUFrequencyInfo &) = delete;
+  CPUFrequencyInfo &operator=(const CPUFrequencyInfo &) = delete;
+
+  // Sample folds one clock reading into the current interval; Update takes a final reading and closes the interval,
+  // so the min/avg/max getters cover every reading since the previous Update, across all cores.
+  bool Sample() noexcept;
+  bool Update() noexcept;
+
+  [[nodiscard]] size_t GetCoreCount() const noexcept;
+  [[nodiscard]] const std::vector<uint32_t> &GetCurrentMhz() const noexcept;
+  [[nodiscard]] const std::vector<uint32_t> &GetMaxMhz() const noexcept;
+  [[nodiscard]] const std::vector<uint32_t> &GetLimitMhz() const noexcept;
+  [[nodiscard]] const std::vector<uint32_t> &GetThrottleCounts() const noexcept;
+  [[nodiscard]] uint32_t GetMinCurrentMhz() const noexcept;
+  [[nodiscard]] double GetAvgCurrentMhz() const noexcept;
+  [[nodiscard]] uint32_t GetMaxCurrentMhz() const noexcept;
+  [[nodiscard]] uint32_t GetIntervalSampleCount() const noexcept;
+  [[nodiscard]] uint32_t GetThrottledCoreCount() const noexcept;
+  [[nodiscard]] uint64_t GetThrottleEventCount() const noexcept;
+  [[nodiscard]] bool IsThrottling() const noexcept;
+  [[nodiscard]] bool IsInitialized() const noexcept;
+  [[nodiscard]] CPUFrequencyError GetLastError() const noexcept;
+
+private:
+  size_t m_coreCount = 0;
+  std::vector<uint16_t> m_groupProcessorCounts;
+  std::unique_ptr<BYTE[]> m_buffer;
+  ULONG m_bufferSize = 0;
+  std::vector<uint32_t> m_currentMhz;
+  std::vector<uint32_t> m_maxMhz;
+  std::vector<uint32_t> m_limitMhz;
+  std::vector<uint32_t> m_throttleCounts;
+  std::vector<uint8_t> m_throttled;
+  uint32_t m_minCurrentMhz = 0;
+  double m_avgCurrentMhz = 0.0;
+  uint32_t m_maxCurrentMhz = 0;
+  uint32_t m_intervalSampleCount = 0;
+  uint32_t m_pendingMinMhz = 0;
+  uint32_t m_pendingMaxMhz = 0;
+  uint64_t m_pendingSumMhz = 0;
+  uint64_t m_pendingReadings = 0;
+  uint32_t m_pendingSampleCount = 0;
+  uint32_t m_throttledCoreCount = 0;
+  uint64_t m_throttleEventCount = 0;
+  bool m_initialized = false;
+  CPUFrequencyError m_lastError = CPUFrequencyError::Success;
+
+  void Initialize() noexcept;
+  [[nodiscard]] bool ReadPowerInformation() noexcept;
+};
+
+[[nodiscard]] std::unique_ptr<CPUFrequencyInfo> GetCPUFrequencyInfo();
+
+namespace detail {
+
+constexpr uint32_t kFrequencySampleIntervalMs = 100;
+}  // namespace detail
+
+}  // namespace nysys
+
+#endif
\ No newline at end of file
@@ -0,0 +1,99 @@
+#ifndef CPU_USAGE_INFO_HPP
+#define CPU_USAGE_INFO_HPP
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include <windows.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "helper/cpu_time.hpp"
+
+namespace nysys {
+
+enum class CPUUsageError {
+  Success = 0,
+  ProcessorCountFailed,
+  MemoryAllocationFailed,
+  CounterQueryFailed,
+  InvalidParameter
+};
+
+[[nodiscard]] constexpr std::string_view ToString(CPUUsageError error) noexcept {
+  switch (error) {
+    case CPUUsageError::Success:
+      return "Success";
+    case CPUUsageError::ProcessorCountFailed:
+      return "Failed to retrieve logical processor count";
+    case CPUUsageError::MemoryAllocationFailed:
+      return "Memory allocation failed";
+    case CPUUsageError::CounterQueryFailed:
+      return "Processor performance counter query failed";
+    case CPUUsageError::InvalidParameter:
+      return "Invalid parameter";
+    default:
+      return "Unknown error";
+  }
+}
+
+template <typename T>
+using CPUUsageResult = std::optional<T>;
+
+using CPUTimeBreakdown = cputime::Breakdown;
+
+class CPUUsageInfo {
+public:
+  CPUUsageInfo() noexcept;
+
+  ~CPUUsageInfo() = default;
+
+  CPUUsageInfo(CPUUsageInfo &&other) noexcept = default;
+  CPUUsageInfo &operator=(CPUUsageInfo &&other) noexcept = default;
+
+  CPUUsageInfo(const CPUUsageInfo &) = delete;
+  CPUUsageInfo &operator=(const CPUUsageInfo &) = delete;
+
+  bool Update() noexcept;
+
+  [[nodiscard]] size_t GetCoreCount() const noexcept;
+  [[nodiscard]] const CPUTimeBreakdown &GetTotal() const noexcept;
+  [[nodiscard]] CPUTimeBreakdown GetCore(size_t index) const noexcept;
+  [[nodiscard]] const std::vector<float> &GetCoreUsage() const noexcept;
+  [[nodiscard]] const std::vector<float> &GetCoreUser() const noexcept;
+  [[nodiscard]] const std::vector<float> &GetCoreSystem() const noexcept;
+  [[nodiscard]] const std::vector<float> &GetCoreIrq() const noexcept;
+  [[nodiscard]] const std::vector<float> &GetCoreDpc() const noexcept;
+  [[nodiscard]] const std::vector<float> &GetCoreIdle() const noexcept;
+  [[nodiscard]] bool IsInitialized() const noexcept;
+  [[nodiscard]] CPUUsageError GetLastError() const noexcept;
+
+private:
+  size_t m_coreCount = 0;
+  std::vector<uint16_t> m_groupProcessorCounts;
+  std::unique_ptr<BYTE[]> m_buffer;
+  ULONG m_bufferSize = 0;
+  cputime::CounterColumns m_current;
+  cputime::CounterColumns m_previous;
+  cputime::ShareColumns m_shares;
+  CPUTimeBreakdown m_total;
+  bool m_initialized = false;
+  CPUUsageError m_lastError = CPUUsageError::Success;
+
+  void Initialize() noexcept;
+  [[nodiscard]] bool ReadCounters() noexcept;
+};
+
+[[nodiscard]] std::unique_ptr<CPUUsageInfo> GetCPUUsageInfo();
+
+}  // namespace nysys
+
+#endif
\ No newline at end of file
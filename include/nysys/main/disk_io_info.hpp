@@ -0,0 +1,126 @@
+#ifndef DISK_IO_INFO_HPP
+#define DISK_IO_INFO_HPP
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include <windows.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "helper/counter_rate.hpp"
+#include "helper/handle_wrapper.hpp"
+
+namespace nysys {
+
+enum class DiskIOError { Success = 0, NoDisksFound, PerformanceQueryFailed, MemoryAllocationFailed, InvalidParameter };
+
+[[nodiscard]] constexpr std::string_view ToString(DiskIOError error) noexcept {
+  switch (error) {
+    case DiskIOError::Success:
+      return "Success";
+    case DiskIOError::NoDisksFound:
+      return "No physical disks could be opened";
+    case DiskIOError::PerformanceQueryFailed:
+      return "Disk performance query failed";
+    case DiskIOError::MemoryAllocationFailed:
+      return "Memory allocation failed";
+    case DiskIOError::InvalidParameter:
+      return "Invalid parameter";
+    default:
+      return "Unknown error";
+  }
+}
+
+template <typename T>
+using DiskIOResult = std::optional<T>;
+
+class DiskIOInfo {
+public:
+  DiskIOInfo() = default;
+
+  DiskIOInfo(uint32_t diskIndex, double readBytesRate, double writeBytesRate, double readOpsRate, double writeOpsRate,
+             double avgQueueDepth, double awaitMs, double busyPercent, uint32_t queueDepth) noexcept;
+
+  [[nodiscard]] uint32_t GetDiskIndex() const noexcept;
+  [[nodiscard]] double GetReadBytesPerSec() const noexcept;
+  [[nodiscard]] double GetWriteBytesPerSec() const noexcept;
+  [[nodiscard]] double GetReadIops() const noexcept;
+  [[nodiscard]] double GetWriteIops() const noexcept;
+  [[nodiscard]] double GetAvgQueueDepth() const noexcept;
+  [[nodiscard]] double GetAwaitMs() const noexcept;
+  [[nodiscard]] double GetBusyPercent() const noexcept;
+  [[nodiscard]] uint32_t GetQueueDepth() const noexcept;
+
+private:
+  uint32_t m_diskIndex = 0;
+  double m_readBytesRate = 0.0;
+  double m_writeBytesRate = 0.0;
+  double m_readOpsRate = 0.0;
+  double m_writeOpsRate = 0.0;
+  double m_avgQueueDepth = 0.0;
+  double m_awaitMs = 0.0;
+  double m_busyPercent = 0.0;
+  uint32_t m_queueDepth = 0;
+};
+
+class DiskIOList {
+public:
+  DiskIOList() noexcept;
+
+  ~DiskIOList();
+
+  DiskIOList(const DiskIOList &) = delete;
+  DiskIOList &operator=(const DiskIOList &) = delete;
+
+  bool Update() noexcept;
+
+  [[nodiscard]] size_t GetCount() const noexcept;
+  [[nodiscard]] const DiskIOInfo *GetDisk(size_t index) const noexcept;
+  [[nodiscard]] const DiskIOInfo *FindByDiskIndex(uint32_t diskIndex) const noexcept;
+  [[nodiscard]] const std::vector<DiskIOInfo> &GetDisks() const noexcept;
+  [[nodiscard]] bool IsInitialized() const noexcept;
+  [[nodiscard]] DiskIOError GetLastError() const noexcept;
+
+private:
+  struct DiskCounters {
+    HandleWrapper handle;
+    uint32_t diskIndex = 0;
+    counter::CounterRate64 bytesRead;
+    counter::CounterRate64 bytesWritten;
+    counter::CounterRate32 readCount;
+    counter::CounterRate32 writeCount;
+    counter::CounterRate64 ioTime;
+    counter::CounterRate64 idleTime;
+    counter::CounterRate64 queryTime;
+  };
+
+  std::vector<DiskCounters> m_counters;
+  std::vector<DiskIOInfo> m_disks;
+  bool m_initialized = false;
+  DiskIOError m_lastError = DiskIOError::Success;
+
+  void Initialize() noexcept;
+  void CloseHandles() noexcept;
+};
+
+[[nodiscard]] std::unique_ptr<DiskIOList> GetDiskIOList();
+
+namespace detail {
+
+constexpr uint32_t kMaxPhysicalDrives = 32;
+constexpr double kHundredNanosecondsPerSecond = 1.0e7;
+constexpr double kHundredNanosecondsPerMillisecond = 1.0e4;
+}  // namespace detail
+
+}  // namespace nysys
+
+#endif
\ No newline at end of file
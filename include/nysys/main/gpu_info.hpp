@@ -54,18 +54,20 @@ class GPUInfo {
 public:
   GPUInfo() = default;
 
-  GPUInfo(std::string gpuName, double dedicatedMem, double sharedMem, bool integrated, uint32_t index) noexcept;
+  GPUInfo(std::string gpuName, uint64_t dedicatedMem, uint64_t sharedMem, bool integrated, uint32_t index) noexcept;
 
   [[nodiscard]] const std::string &GetName() const noexcept;
   [[nodiscard]] double GetDedicatedMemory() const noexcept;
   [[nodiscard]] double GetSharedMemory() const noexcept;
+  [[nodiscard]] uint64_t GetDedicatedMemoryBytes() const noexcept;
+  [[nodiscard]] uint64_t GetSharedMemoryBytes() const noexcept;
   [[nodiscard]] bool IsIntegrated() const noexcept;
   [[nodiscard]] uint32_t GetAdapterIndex() const noexcept;
 
 private:
   std::string m_name;
-  double m_dedicatedMemory = 0.0;
-  double m_sharedMemory = 0.0;
+  uint64_t m_dedicatedMemory = 0;
+  uint64_t m_sharedMemory = 0;
   bool m_isIntegrated = false;
   uint32_t m_adapterIndex = 0;
 };
@@ -71,6 +71,7 @@ private:
 class MemoryInfo {
 public:
   MemoryInfo() noexcept;
+  explicit MemoryInfo(bool includeRamSlots) noexcept;
 
   ~MemoryInfo() = default;
 
@@ -96,13 +97,14 @@ private:
   uint64_t m_usedPhys = 0;
   uint32_t m_memoryLoad = 0;
   std::vector<RAMSlotInfo> m_ramSlots;
+  bool m_includeRamSlots = true;
   bool m_initialized = false;
   MemoryError m_lastError = MemoryError::Success;
 
   void Initialize() noexcept;
 };
 
-[[nodiscard]] std::unique_ptr<MemoryInfo> GetMemoryInfo();
+[[nodiscard]] std::unique_ptr<MemoryInfo> GetMemoryInfo(bool includeRamSlots = true);
 
 namespace detail {
 
@@ -47,7 +47,7 @@ public:
   NetworkAdapterInfo() = default;
 
   NetworkAdapterInfo(std::string adapterName, std::string mac, std::string ip, std::string connStatus,
-                     uint32_t adapterType) noexcept;
+                     uint32_t adapterType, uint32_t adapterIndex) noexcept;
 
   [[nodiscard]] const std::string &GetName() const noexcept;
   [[nodiscard]] const std::string &GetMacAddress() const noexcept;
@@ -55,6 +55,7 @@ public:
   [[nodiscard]] const std::string &GetStatus() const noexcept;
   [[nodiscard]] bool IsEthernet() const noexcept;
   [[nodiscard]] bool IsWiFi() const noexcept;
+  [[nodiscard]] uint32_t GetInterfaceIndex() const noexcept;
 
 private:
   std::string m_name;
@@ -62,6 +63,7 @@ private:
   std::string m_ipAddress;
   std::string m_status;
   uint32_t m_type = 0;
+  uint32_t m_interfaceIndex = 0;
 };
 
 class NetworkList {
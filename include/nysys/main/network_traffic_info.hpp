@@ -0,0 +1,145 @@
+#ifndef NETWORK_TRAFFIC_INFO_HPP
+#define NETWORK_TRAFFIC_INFO_HPP
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include <windows.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "helper/counter_rate.hpp"
+
+namespace nysys {
+
+enum class NetworkTrafficError {
+  Success = 0,
+  InterfaceTableFailed,
+  NoInterfacesFound,
+  EntryQueryFailed,
+  MemoryAllocationFailed,
+  InvalidParameter
+};
+
+[[nodiscard]] constexpr std::string_view ToString(NetworkTrafficError error) noexcept {
+  switch (error) {
+    case NetworkTrafficError::Success:
+      return "Success";
+    case NetworkTrafficError::InterfaceTableFailed:
+      return "Failed to retrieve interface table";
+    case NetworkTrafficError::NoInterfacesFound:
+      return "No hardware interfaces found";
+    case NetworkTrafficError::EntryQueryFailed:
+      return "Interface counter query failed";
+    case NetworkTrafficError::MemoryAllocationFailed:
+      return "Memory allocation failed";
+    case NetworkTrafficError::InvalidParameter:
+      return "Invalid parameter";
+    default:
+      return "Unknown error";
+  }
+}
+
+template <typename T>
+using NetworkTrafficResult = std::optional<T>;
+
+struct NetworkTrafficRates {
+  double rxBytes = 0.0;
+  double txBytes = 0.0;
+  double rxPackets = 0.0;
+  double txPackets = 0.0;
+  double rxErrors = 0.0;
+  double txErrors = 0.0;
+  double rxDrops = 0.0;
+  double txDrops = 0.0;
+};
+
+class NetworkTrafficInfo {
+public:
+  NetworkTrafficInfo() = default;
+
+  NetworkTrafficInfo(uint32_t interfaceIndex, const NetworkTrafficRates &rates, uint64_t rxErrorTotal,
+                     uint64_t txErrorTotal, uint64_t rxDropTotal, uint64_t txDropTotal) noexcept;
+
+  [[nodiscard]] uint32_t GetInterfaceIndex() const noexcept;
+  [[nodiscard]] double GetRxBytesPerSec() const noexcept;
+  [[nodiscard]] double GetTxBytesPerSec() const noexcept;
+  [[nodiscard]] double GetRxPacketsPerSec() const noexcept;
+  [[nodiscard]] double GetTxPacketsPerSec() const noexcept;
+  [[nodiscard]] double GetRxErrorsPerSec() const noexcept;
+  [[nodiscard]] double GetTxErrorsPerSec() const noexcept;
+  [[nodiscard]] double GetRxDropsPerSec() const noexcept;
+  [[nodiscard]] double GetTxDropsPerSec() const noexcept;
+  [[nodiscard]] uint64_t GetRxErrorTotal() const noexcept;
+  [[nodiscard]] uint64_t GetTxErrorTotal() const noexcept;
+  [[nodiscard]] uint64_t GetRxDropTotal() const noexcept;
+  [[nodiscard]] uint64_t GetTxDropTotal() const noexcept;
+
+private:
+  uint32_t m_interfaceIndex = 0;
+  NetworkTrafficRates m_rates;
+  uint64_t m_rxErrorTotal = 0;
+  uint64_t m_txErrorTotal = 0;
+  uint64_t m_rxDropTotal = 0;
+  uint64_t m_txDropTotal = 0;
+};
+
+class NetworkTrafficList {
+public:
+  NetworkTrafficList() noexcept;
+
+  ~NetworkTrafficList();
+
+  NetworkTrafficList(const NetworkTrafficList &) = delete;
+  NetworkTrafficList &operator=(const NetworkTrafficList &) = delete;
+
+  bool Update() noexcept;
+
+  [[nodiscard]] size_t GetCount() const noexcept;
+  [[nodiscard]] const NetworkTrafficInfo *GetInterface(size_t index) const noexcept;
+  [[nodiscard]] const NetworkTrafficInfo *FindByInterfaceIndex(uint32_t interfaceIndex) const noexcept;
+  [[nodiscard]] const std::vector<NetworkTrafficInfo> &GetInterfaces() const noexcept;
+  [[nodiscard]] bool IsInitialized() const noexcept;
+  [[nodiscard]] NetworkTrafficError GetLastError() const noexcept;
+
+private:
+  struct InterfaceCounters {
+    uint32_t interfaceIndex = 0;
+    uint64_t interfaceLuid = 0;
+    counter::CounterRate64 rxBytes;
+    counter::CounterRate64 txBytes;
+    counter::CounterRate64 rxPackets;
+    counter::CounterRate64 txPackets;
+    counter::CounterRate64 rxErrors;
+    counter::CounterRate64 txErrors;
+    counter::CounterRate64 rxDrops;
+    counter::CounterRate64 txDrops;
+  };
+
+  std::vector<InterfaceCounters> m_counters;
+  std::vector<NetworkTrafficInfo> m_interfaces;
+  std::chrono::steady_clock::time_point m_lastSampleTime{};
+  HANDLE m_changeNotification = nullptr;
+  std::atomic<bool> m_tableChanged{false};
+  bool m_initialized = false;
+  NetworkTrafficError m_lastError = NetworkTrafficError::Success;
+
+  void Initialize() noexcept;
+  [[nodiscard]] bool Enumerate();
+};
+
+[[nodiscard]] std::unique_ptr<NetworkTrafficList> GetNetworkTrafficList();
+
+}  // namespace nysys
+
+#endif
\ No newline at end of file
@@ -0,0 +1,127 @@
+#ifndef PROCESS_INFO_HPP
+#define PROCESS_INFO_HPP
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include <windows.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "helper/process_table.hpp"
+
+namespace nysys {
+
+enum class ProcessError { Success = 0, SnapshotQueryFailed, MemoryAllocationFailed, InvalidParameter };
+
+[[nodiscard]] constexpr std::string_view ToString(ProcessError error) noexcept {
+  switch (error) {
+    case ProcessError::Success:
+      return "Success";
+    case ProcessError::SnapshotQueryFailed:
+      return "Process snapshot query failed";
+    case ProcessError::MemoryAllocationFailed:
+      return "Memory allocation failed";
+    case ProcessError::InvalidParameter:
+      return "Invalid parameter";
+    default:
+      return "Unknown error";
+  }
+}
+
+template <typename T>
+using ProcessResult = std::optional<T>;
+
+class ProcessInfo {
+public:
+  ProcessInfo() = default;
+
+  ProcessInfo(uint32_t processId, std::string processName, double cpuPercent, uint64_t workingSet,
+              uint64_t ioReadRate, uint64_t ioWriteRate) noexcept;
+
+  [[nodiscard]] uint32_t GetProcessId() const noexcept;
+  [[nodiscard]] const std::string &GetName() const noexcept;
+  [[nodiscard]] double GetCpuPercent() const noexcept;
+  [[nodiscard]] uint64_t GetWorkingSet() const noexcept;
+  [[nodiscard]] uint64_t GetIoReadRate() const noexcept;
+  [[nodiscard]] uint64_t GetIoWriteRate() const noexcept;
+
+private:
+  uint32_t m_processId = 0;
+  std::string m_name;
+  double m_cpuPercent = 0.0;
+  uint64_t m_workingSet = 0;
+  uint64_t m_ioReadRate = 0;
+  uint64_t m_ioWriteRate = 0;
+};
+
+class ProcessList {
+public:
+  explicit ProcessList(size_t topCount) noexcept;
+
+  ~ProcessList() = default;
+
+  ProcessList(ProcessList &&other) noexcept = default;
+  ProcessList &operator=(ProcessList &&other) noexcept = default;
+
+  ProcessList(const ProcessList &) = delete;
+  ProcessList &operator=(const ProcessList &) = delete;
+
+  bool Update() noexcept;
+
+  [[nodiscard]] size_t GetProcessCount() const noexcept;
+  [[nodiscard]] size_t GetTopCount() const noexcept;
+  [[nodiscard]] const std::vector<ProcessInfo> &GetTopByCpu() const noexcept;
+  [[nodiscard]] const std::vector<ProcessInfo> &GetTopByMemory() const noexcept;
+  [[nodiscard]] const std::vector<ProcessInfo> &GetTopByIo() const noexcept;
+  [[nodiscard]] bool IsInitialized() const noexcept;
+  [[nodiscard]] ProcessError GetLastError() const noexcept;
+
+private:
+  size_t m_topCount = 0;
+  uint32_t m_processorCount = 1;
+  std::unique_ptr<BYTE[]> m_buffer;
+  ULONG m_bufferSize = 0;
+  std::vector<proc::ProcessSample> m_current;
+  std::vector<proc::ProcessSample> m_previous;
+  std::vector<uint32_t> m_heap;
+  std::vector<ProcessInfo> m_topByCpu;
+  std::vector<ProcessInfo> m_topByMemory;
+  std::vector<ProcessInfo> m_topByIo;
+  std::chrono::steady_clock::time_point m_lastSampleTime;
+  bool m_hasBaseline = false;
+  bool m_initialized = false;
+  ProcessError m_lastError = ProcessError::Success;
+
+  void Initialize() noexcept;
+  [[nodiscard]] bool QuerySnapshot() noexcept;
+  void ParseSnapshot();
+
+  template <typename Metric>
+  void SelectTop(Metric metric, std::vector<ProcessInfo> &output);
+};
+
+[[nodiscard]] std::unique_ptr<ProcessList> GetProcessList(size_t topCount);
+
+namespace detail {
+
+constexpr size_t kDefaultTopProcessCount = 5;
+constexpr size_t kMaxTopProcessCount = 64;
+constexpr ULONG kInitialProcessBufferSize = 512 * 1024;
+constexpr ULONG kProcessBufferSlack = 64 * 1024;
+constexpr std::string_view kIdleProcessName = "System Idle Process";
+}  // namespace detail
+
+}  // namespace nysys
+
+#endif
\ No newline at end of file
@@ -68,7 +68,7 @@ public:
   LogicalDiskInfo() = default;
 
   LogicalDiskInfo(std::string driveLetter, std::string driveType, std::string driveModel, std::string diskInterface,
-                  double diskTotalSize, double diskFreeSpace) noexcept;
+                  uint64_t diskTotalSize, uint64_t diskFreeSpace, uint32_t physicalDiskIndex) noexcept;
 
   [[nodiscard]] const std::string &GetDriveLetter() const noexcept;
   [[nodiscard]] const std::string &GetType() const noexcept;
@@ -76,19 +76,26 @@ public:
   [[nodiscard]] const std::string &GetInterfaceType() const noexcept;
   [[nodiscard]] double GetTotalSize() const noexcept;
   [[nodiscard]] double GetAvailableSpace() const noexcept;
+  [[nodiscard]] uint64_t GetTotalSizeBytes() const noexcept;
+  [[nodiscard]] uint64_t GetAvailableSpaceBytes() const noexcept;
+  [[nodiscard]] uint64_t GetUsedSpaceBytes() const noexcept;
+  [[nodiscard]] uint32_t GetDiskIndex() const noexcept;
+  [[nodiscard]] bool HasDiskIndex() const noexcept;
 
 private:
   std::string m_drive;
   std::string m_type;
   std::string m_model;
   std::string m_interfaceType;
-  double m_totalSize = 0.0;
-  double m_freeSpace = 0.0;
+  uint64_t m_totalSize = 0;
+  uint64_t m_freeSpace = 0;
+  uint32_t m_diskIndex = UINT32_MAX;
 };
 
 class StorageList {
 public:
   StorageList() noexcept;
+  explicit StorageList(bool includePhysicalDetails) noexcept;
 
   ~StorageList() = default;
 
@@ -106,19 +113,21 @@ public:
 
 private:
   std::vector<LogicalDiskInfo> m_disks;
+  bool m_includePhysicalDetails = true;
   bool m_initialized = false;
   StorageError m_lastError = StorageError::Success;
 
   void Initialize() noexcept;
 };
 
-[[nodiscard]] std::unique_ptr<StorageList> GetStorageList();
+[[nodiscard]] std::unique_ptr<StorageList> GetStorageList(bool includePhysicalDetails = true);
 
 namespace detail {
 
 constexpr std::string_view kUnknownStorageDevice = "Unknown Storage Device";
 constexpr std::string_view kUnknownInterface = "Unknown";
 constexpr std::string_view kUnknownDriveType = "Unknown";
+constexpr uint32_t kUnknownDiskIndex = UINT32_MAX;
 }  // namespace detail
 
 }  // namespace nysys
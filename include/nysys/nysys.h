@@ -3,6 +3,7 @@
 
 #include <windows.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef NYSYS_EXPORTS
@@ -14,17 +15,163 @@
 #define NYSYS_MIN_UPDATE_INTERVAL_MS 100
 #define NYSYS_DEFAULT_UPDATE_INTERVAL_MS 1000
 #define NYSYS_MAX_THREAD_WAIT_MS 5000
+#define NYSYS_DEFAULT_KEYFRAME_INTERVAL 60
+#define NYSYS_DEFAULT_INVENTORY_REFRESH_INTERVAL 300
+
+#define NYSYS_FORMAT_JSON 0
+#define NYSYS_FORMAT_CBOR 1
+#define NYSYS_FORMAT_MSGPACK 2
+
+#define NYSYS_DEADBAND_ABSOLUTE 0
+#define NYSYS_DEADBAND_PERCENT 1
+
+#define NYSYS_UNITS_LEGACY 0
+#define NYSYS_UNITS_RAW 1
+
+#define NYSYS_BATCH_JSON_ARRAY 0
+#define NYSYS_BATCH_NDJSON 1
+#define NYSYS_DEFAULT_BATCH_MAX_SAMPLES 10
+#define NYSYS_DEFAULT_BATCH_MAX_BYTES 1048576
+#define NYSYS_DEFAULT_BATCH_MAX_AGE_MS 10000
+
+#define NYSYS_RESOLUTION_RAW 0
+#define NYSYS_RESOLUTION_SECOND 1
+#define NYSYS_RESOLUTION_MINUTE 2
+#define NYSYS_RESOLUTION_HOUR 3
+
+#define NYSYS_WINDOW_SLIDING 0
+#define NYSYS_WINDOW_TUMBLING 1
+#define NYSYS_WINDOW_RUN 2
+#define NYSYS_DEFAULT_PERCENTILE_WINDOW_MS 60000
+#define NYSYS_DEFAULT_PERCENTILE_SLICES 12
+
+#define NYSYS_ALERT_ABOVE 0
+#define NYSYS_ALERT_BELOW 1
+#define NYSYS_ALERT_RATE_ABOVE 2
+#define NYSYS_ALERT_RATE_BELOW 3
+#define NYSYS_ALERT_RAISED 0
+#define NYSYS_ALERT_CLEARED 1
+
+#define NYSYS_DEFAULT_SEGMENT_SIZE_KB 16384
+#define NYSYS_DEFAULT_RETENTION_MB 256
+#define NYSYS_DEFAULT_STORE_FLUSH_INTERVAL_MS 1000
+
+#define NYSYS_DEFAULT_HTTP_PORT 8086
+#define NYSYS_DEFAULT_HTTP_MAX_CLIENTS 128
+
+#define NYSYS_DEFAULT_SHARED_SNAPSHOT_NAME "Local\\NySysSnapshot"
+#define NYSYS_DEFAULT_SHARED_SNAPSHOT_KB 1024
+
+#define NYSYS_DEFAULT_PIPE_NAME "\\\\.\\pipe\\nysys"
+#define NYSYS_DEFAULT_PIPE_MAX_CLIENTS 200
+
+#define NYSYS_DEFAULT_UPLOAD_SPOOL_MB 64
+#define NYSYS_DEFAULT_UPLOAD_BATCH_RECORDS 60
+#define NYSYS_DEFAULT_UPLOAD_BATCH_INTERVAL_MS 10000
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 typedef void (*NysysCallback)(const char *jsonData);
+typedef void (*NysysBinaryCallback)(const uint8_t *data, size_t size);
+typedef void (*NysysDataCallback)(const uint8_t *data, size_t size, uint64_t sequence, void *userData);
+typedef BOOL (*NysysRecordCallback)(const uint8_t *data, size_t size, uint64_t sequence, int64_t timestampMs,
+                                    void *userData);
+
+typedef struct NysysHistoryPoint {
+  int64_t timestamp;
+  double min;
+  double max;
+  double avg;
+  double last;
+  uint32_t count;
+} NysysHistoryPoint;
+
+typedef struct NysysPercentiles {
+  int64_t windowStart;
+  uint64_t count;
+  double min;
+  double max;
+  double mean;
+  double p50;
+  double p95;
+  double p99;
+} NysysPercentiles;
+
+typedef struct NysysAlertEvent {
+  const char *name;
+  const char *path;
+  int32_t state;
+  double value;
+  double threshold;
+  int64_t timestampMs;
+} NysysAlertEvent;
+
+typedef void (*NysysAlertCallback)(const NysysAlertEvent *event, void *userData);
 
 NYSYS_API BOOL start_monitoring(int32_t updateIntervalMs);
 NYSYS_API void stop_monitoring(void);
 NYSYS_API void set_update_interval(int32_t updateIntervalMs);
 NYSYS_API void set_callback(NysysCallback callback);
+NYSYS_API void set_data_callback(NysysDataCallback callback, void *userData);
+NYSYS_API void set_top_process_count(int32_t count);
+NYSYS_API void set_output_format(int32_t format);
+NYSYS_API void set_binary_callback(NysysBinaryCallback callback);
+NYSYS_API void set_delta_mode(BOOL enabled, int32_t keyframeInterval);
+NYSYS_API void request_keyframe(void);
+NYSYS_API BOOL add_deadband_rule(const char *path, int32_t mode, double threshold);
+NYSYS_API void clear_deadband_rules(void);
+NYSYS_API void set_max_silence(int32_t maxSilenceMs);
+NYSYS_API void get_filter_stats(uint64_t *emitted, uint64_t *suppressed, uint64_t *heartbeats);
+NYSYS_API BOOL set_projection(const char *const *paths, int32_t count);
+NYSYS_API void set_units_mode(int32_t mode);
+NYSYS_API void set_channel_mode(BOOL enabled, int32_t inventoryRefreshInterval);
+NYSYS_API void set_inventory_callback(NysysDataCallback callback, void *userData);
+NYSYS_API void set_telemetry_callback(NysysDataCallback callback, void *userData);
+NYSYS_API uint64_t get_inventory_hash(void);
+NYSYS_API void set_batching(BOOL enabled, int32_t framing, int32_t maxSamples, int32_t maxBytes, int32_t maxAgeMs);
+NYSYS_API BOOL add_history_metric(const char *path);
+NYSYS_API void clear_history_metrics(void);
+NYSYS_API BOOL set_history_capacity(int32_t raw, int32_t seconds, int32_t minutes, int32_t hours);
+NYSYS_API int32_t query_history(const char *metric, int64_t fromMs, int64_t toMs, int32_t resolution,
+                                NysysHistoryPoint *points, int32_t capacity);
+NYSYS_API size_t get_history_memory_usage(void);
+NYSYS_API BOOL add_percentile_metric(const char *path);
+NYSYS_API void clear_percentile_metrics(void);
+NYSYS_API BOOL set_percentile_window(int32_t windowMs, int32_t slices);
+NYSYS_API BOOL query_percentiles(const char *metric, int32_t window, NysysPercentiles *result);
+NYSYS_API void reset_percentiles(void);
+NYSYS_API BOOL add_alert_rule(const char *name, const char *path, int32_t condition, double threshold,
+                              double hysteresis, int32_t durationMs);
+NYSYS_API void clear_alert_rules(void);
+NYSYS_API void set_alert_callback(NysysAlertCallback callback, void *userData);
+NYSYS_API void get_alert_stats(uint64_t *evaluations, uint64_t *lastEvaluationNs, uint64_t *maxEvaluationNs,
+                               uint64_t *averageEvaluationNs);
+NYSYS_API BOOL add_derived_metric(const char *name, const char *expression);
+NYSYS_API void clear_derived_metrics(void);
+NYSYS_API BOOL open_segment_store(const char *directory, int32_t segmentSizeKb, int32_t retentionMb,
+                                  int32_t flushIntervalMs);
+NYSYS_API void close_segment_store(void);
+NYSYS_API int32_t read_segment_store(uint64_t fromSequence, int32_t maxRecords, NysysRecordCallback callback,
+                                     void *userData);
+NYSYS_API void get_segment_store_stats(uint64_t *firstSequence, uint64_t *nextSequence, uint64_t *recovered,
+                                       uint64_t *dropped);
+NYSYS_API BOOL start_http_server(int32_t port, int32_t maxClients);
+NYSYS_API void stop_http_server(void);
+NYSYS_API void get_http_server_stats(int32_t *port, int32_t *clients, int32_t *streams, uint64_t *requests,
+                                     uint64_t *rejected, uint64_t *dropped);
+NYSYS_API BOOL open_shared_snapshot(const char *name, int32_t capacityKb);
+NYSYS_API void close_shared_snapshot(void);
+NYSYS_API void get_shared_snapshot_stats(uint64_t *version, uint64_t *dropped);
+NYSYS_API BOOL start_pipe_server(const char *name, int32_t maxClients);
+NYSYS_API void stop_pipe_server(void);
+NYSYS_API void get_pipe_server_stats(int32_t *clients, int32_t *filters, uint64_t *sent, uint64_t *skipped);
+NYSYS_API BOOL start_uploader(const char *url, const char *spoolDirectory, int32_t spoolMb, int32_t batchRecords,
+                              int32_t batchIntervalMs, int32_t maxBytesPerSecond);
+NYSYS_API void stop_uploader(void);
+NYSYS_API void get_uploader_stats(uint64_t *pending, uint64_t *uploaded, uint64_t *retries, uint64_t *dropped,
+                                  int32_t *lastStatus);
 NYSYS_API BOOL is_monitoring(void);
 
 #ifdef __cplusplus
@@ -5,8 +5,11 @@
 
 #include <chrono>
 #include <cstdint>
+#include <filesystem>
 #include <functional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "internal.hpp"
 
@@ -20,6 +23,8 @@ namespace nysys {
 constexpr int32_t MIN_UPDATE_INTERVAL_MS = 100;
 constexpr int32_t DEFAULT_UPDATE_INTERVAL_MS = 1000;
 constexpr int32_t MAX_THREAD_WAIT_MS = 5000;
+constexpr int32_t DEFAULT_KEYFRAME_INTERVAL = 60;
+constexpr int32_t DEFAULT_INVENTORY_REFRESH_INTERVAL = 300;
 }  // namespace nysys
 
 #ifdef __cplusplus
@@ -27,11 +32,104 @@ extern "C" {
 #endif
 
 typedef void (*NysysCallback)(const char *jsonData);
+typedef void (*NysysBinaryCallback)(const uint8_t *data, size_t size);
+typedef void (*NysysDataCallback)(const uint8_t *data, size_t size, uint64_t sequence, void *userData);
+typedef BOOL (*NysysRecordCallback)(const uint8_t *data, size_t size, uint64_t sequence, int64_t timestampMs,
+                                    void *userData);
+
+typedef struct NysysHistoryPoint {
+  int64_t timestamp;
+  double min;
+  double max;
+  double avg;
+  double last;
+  uint32_t count;
+} NysysHistoryPoint;
+
+typedef struct NysysPercentiles {
+  int64_t windowStart;
+  uint64_t count;
+  double min;
+  double max;
+  double mean;
+  double p50;
+  double p95;
+  double p99;
+} NysysPercentiles;
+
+typedef struct NysysAlertEvent {
+  const char *name;
+  const char *path;
+  int32_t state;
+  double value;
+  double threshold;
+  int64_t timestampMs;
+} NysysAlertEvent;
+
+typedef void (*NysysAlertCallback)(const NysysAlertEvent *event, void *userData);
 
 NYSYS_API BOOL start_monitoring(int32_t updateIntervalMs);
 NYSYS_API void stop_monitoring(void);
 NYSYS_API void set_update_interval(int32_t updateIntervalMs);
 NYSYS_API void set_callback(NysysCallback callback);
+NYSYS_API void set_data_callback(NysysDataCallback callback, void *userData);
+NYSYS_API void set_top_process_count(int32_t count);
+NYSYS_API void set_output_format(int32_t format);
+NYSYS_API void set_binary_callback(NysysBinaryCallback callback);
+NYSYS_API void set_delta_mode(BOOL enabled, int32_t keyframeInterval);
+NYSYS_API void request_keyframe(void);
+NYSYS_API BOOL add_deadband_rule(const char *path, int32_t mode, double threshold);
+NYSYS_API void clear_deadband_rules(void);
+NYSYS_API void set_max_silence(int32_t maxSilenceMs);
+NYSYS_API void get_filter_stats(uint64_t *emitted, uint64_t *suppressed, uint64_t *heartbeats);
+NYSYS_API BOOL set_projection(const char *const *paths, int32_t count);
+NYSYS_API void set_units_mode(int32_t mode);
+NYSYS_API void set_channel_mode(BOOL enabled, int32_t inventoryRefreshInterval);
+NYSYS_API void set_inventory_callback(NysysDataCallback callback, void *userData);
+NYSYS_API void set_telemetry_callback(NysysDataCallback callback, void *userData);
+NYSYS_API uint64_t get_inventory_hash(void);
+NYSYS_API void set_batching(BOOL enabled, int32_t framing, int32_t maxSamples, int32_t maxBytes, int32_t maxAgeMs);
+NYSYS_API BOOL add_history_metric(const char *path);
+NYSYS_API void clear_history_metrics(void);
+NYSYS_API BOOL set_history_capacity(int32_t raw, int32_t seconds, int32_t minutes, int32_t hours);
+NYSYS_API int32_t query_history(const char *metric, int64_t fromMs, int64_t toMs, int32_t resolution,
+                                NysysHistoryPoint *points, int32_t capacity);
+NYSYS_API size_t get_history_memory_usage(void);
+NYSYS_API BOOL add_percentile_metric(const char *path);
+NYSYS_API void clear_percentile_metrics(void);
+NYSYS_API BOOL set_percentile_window(int32_t windowMs, int32_t slices);
+NYSYS_API BOOL query_percentiles(const char *metric, int32_t window, NysysPercentiles *result);
+NYSYS_API void reset_percentiles(void);
+NYSYS_API BOOL add_alert_rule(const char *name, const char *path, int32_t condition, double threshold,
+                              double hysteresis, int32_t durationMs);
+NYSYS_API void clear_alert_rules(void);
+NYSYS_API void set_alert_callback(NysysAlertCallback callback, void *userData);
+NYSYS_API void get_alert_stats(uint64_t *evaluations, uint64_t *lastEvaluationNs, uint64_t *maxEvaluationNs,
+                               uint64_t *averageEvaluationNs);
+NYSYS_API BOOL add_derived_metric(const char *name, const char *expression);
+NYSYS_API void clear_derived_metrics(void);
+NYSYS_API BOOL open_segment_store(const char *directory, int32_t segmentSizeKb, int32_t retentionMb,
+                                  int32_t flushIntervalMs);
+NYSYS_API void close_segment_store(void);
+NYSYS_API int32_t read_segment_store(uint64_t fromSequence, int32_t maxRecords, NysysRecordCallback callback,
+                                     void *userData);
+NYSYS_API void get_segment_store_stats(uint64_t *firstSequence, uint64_t *nextSequence, uint64_t *recovered,
+                                       uint64_t *dropped);
+NYSYS_API BOOL start_http_server(int32_t port, int32_t maxClients);
+NYSYS_API void stop_http_server(void);
+NYSYS_API void get_http_server_stats(int32_t *port, int32_t *clients, int32_t *streams, uint64_t *requests,
+                                     uint64_t *rejected, uint64_t *dropped);
+NYSYS_API BOOL open_shared_snapshot(const char *name, int32_t capacityKb);
+NYSYS_API void close_shared_snapshot(void);
+NYSYS_API void get_shared_snapshot_stats(uint64_t *version, uint64_t *dropped);
+NYSYS_API BOOL start_pipe_server(const char *name, int32_t maxClients);
+NYSYS_API void stop_pipe_server(void);
+NYSYS_API void get_pipe_server_stats(int32_t *clients, int32_t *filters, uint64_t *sent, uint64_t *skipped);
+NYSYS_API BOOL start_uploader(const char *url, const char *spoolDirectory, int32_t spoolMb, int32_t batchRecords,
+                              int32_t batchIntervalMs, int32_t maxBytesPerSecond);
+NYSYS_API void stop_uploader(void);
+NYSYS_API void get_uploader_stats(uint64_t *pending, uint64_t *uploaded, uint64_t *retries, uint64_t *dropped,
+                                  int32_t *lastStatus);
 NYSYS_API BOOL is_monitoring(void);
 
 #ifdef __cplusplus
@@ -45,6 +143,61 @@ NYSYS_API bool StartMonitoring(int32_t updateIntervalMs = DEFAULT_UPDATE_INTERVA
 NYSYS_API void StopMonitoring() noexcept;
 NYSYS_API void SetUpdateInterval(int32_t updateIntervalMs);
 NYSYS_API void SetCallback(const std::function<void(const std::string &)> &callback);
+NYSYS_API void SetDataCallback(const std::function<void(std::string_view, uint64_t)> &callback);
+NYSYS_API void SetTopProcessCount(size_t count);
+NYSYS_API void SetOutputFormat(OutputFormat format);
+NYSYS_API void SetBinaryCallback(const std::function<void(const uint8_t *, size_t)> &callback);
+NYSYS_API void SetDeltaMode(bool enabled, int32_t keyframeInterval = DEFAULT_KEYFRAME_INTERVAL);
+NYSYS_API void RequestKeyframe() noexcept;
+NYSYS_API void AddDeadbandRule(std::string_view path, DeadbandMode mode, double threshold);
+NYSYS_API void ClearDeadbandRules() noexcept;
+NYSYS_API void SetMaxSilence(std::chrono::milliseconds maxSilence);
+NYSYS_API FilterStats GetFilterStats() noexcept;
+NYSYS_API void SetProjection(const std::vector<std::string> &paths);
+NYSYS_API void ClearProjection() noexcept;
+NYSYS_API void SetUnitsMode(UnitsMode mode);
+NYSYS_API void SetChannelMode(bool enabled, int32_t inventoryRefreshInterval = DEFAULT_INVENTORY_REFRESH_INTERVAL);
+NYSYS_API void SetInventoryCallback(const std::function<void(std::string_view, uint64_t)> &callback);
+NYSYS_API void SetTelemetryCallback(const std::function<void(std::string_view, uint64_t)> &callback);
+NYSYS_API uint64_t GetInventoryHash() noexcept;
+NYSYS_API void SetBatching(bool enabled, const BatchOptions &options = BatchOptions{});
+NYSYS_API void AddHistoryMetric(std::string_view path);
+NYSYS_API void ClearHistoryMetrics() noexcept;
+NYSYS_API void SetHistoryCapacity(const HistoryCapacity &capacity);
+NYSYS_API std::vector<HistoryPoint> QueryHistory(std::string_view metric, int64_t fromMs, int64_t toMs,
+                                                 HistoryResolution resolution);
+NYSYS_API size_t GetHistoryMemoryUsage() noexcept;
+NYSYS_API void AddPercentileMetric(std::string_view path);
+NYSYS_API void ClearPercentileMetrics() noexcept;
+NYSYS_API void SetPercentileWindow(std::chrono::milliseconds window, size_t slices = detail::kDefaultPercentileSlices);
+NYSYS_API Percentiles QueryPercentiles(std::string_view metric, PercentileWindow window);
+NYSYS_API void ResetPercentiles() noexcept;
+NYSYS_API void AddAlertRule(const AlertRule &rule);
+NYSYS_API void ClearAlertRules() noexcept;
+NYSYS_API void SetAlertCallback(const std::function<void(const AlertEvent &)> &callback);
+NYSYS_API AlertStats GetAlertStats() noexcept;
+NYSYS_API void AddDerivedMetric(std::string_view name, std::string_view expression);
+NYSYS_API void ClearDerivedMetrics() noexcept;
+NYSYS_API void OpenSegmentStore(const std::filesystem::path &directory,
+                                const SegmentStoreOptions &options = SegmentStoreOptions{});
+NYSYS_API void CloseSegmentStore() noexcept;
+NYSYS_API size_t ReadSegmentStore(uint64_t fromSequence, size_t maxRecords,
+                                  const std::function<bool(std::string_view, uint64_t, int64_t)> &visitor);
+NYSYS_API SegmentStoreStats GetSegmentStoreStats() noexcept;
+NYSYS_API void StartHttpServer(const HttpServerOptions &options = HttpServerOptions{});
+NYSYS_API void StopHttpServer() noexcept;
+NYSYS_API HttpServerStats GetHttpServerStats() noexcept;
+NYSYS_API void OpenSharedSnapshot(std::string_view name = detail::kDefaultSharedSnapshotName,
+                                  size_t capacity = detail::kDefaultSharedSnapshotCapacity);
+NYSYS_API void CloseSharedSnapshot() noexcept;
+NYSYS_API SharedSnapshotStats GetSharedSnapshotStats() noexcept;
+NYSYS_API void StartPipeServer(const PipeServerOptions &options = PipeServerOptions{});
+NYSYS_API void StopPipeServer() noexcept;
+NYSYS_API PipeServerStats GetPipeServerStats() noexcept;
+NYSYS_API void StartUploader(std::string_view url, const std::filesystem::path &spoolDirectory,
+                             const UploaderOptions &options = UploaderOptions{});
+NYSYS_API void StopUploader() noexcept;
+NYSYS_API UploaderStats GetUploaderStats() noexcept;
 NYSYS_API bool IsMonitoring() noexcept;
 NYSYS_API MonitoringError GetLastError() noexcept;
 NYSYS_API std::chrono::milliseconds GetUptime() noexcept;
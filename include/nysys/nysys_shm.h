@@ -0,0 +1,181 @@
+#ifndef NYSYS_SHM_H
+#define NYSYS_SHM_H
+
+#include <windows.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define NYSYS_SHM_MAGIC 0x4D53594Eu
+#define NYSYS_SHM_LAYOUT_VERSION 1
+#define NYSYS_SHM_HEADER_SIZE 64
+#define NYSYS_SHM_READ_ATTEMPTS 4
+#ifndef NYSYS_DEFAULT_SHARED_SNAPSHOT_NAME
+#define NYSYS_DEFAULT_SHARED_SNAPSHOT_NAME "Local\\NySysSnapshot"
+#endif
+
+#define NYSYS_SHM_OK 0
+#define NYSYS_SHM_UNCHANGED 1
+#define NYSYS_SHM_NO_DATA 2
+#define NYSYS_SHM_TORN 3
+#define NYSYS_SHM_BUFFER_TOO_SMALL 4
+#define NYSYS_SHM_INVALID 5
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Region layout: this header followed by `capacity` payload bytes. `sequence` is a seqlock counter - odd while the
+   publisher is writing - so the published version is sequence / 2.
+
+   The payload is one complete sample in `format` (a NYSYS_FORMAT_* value); JSON is always compact, whatever the
+   callback layout, and delta mode still publishes the merged snapshot. With inventory/telemetry channels enabled the
+   payload is the telemetry document only - fetch the inventory through the inventory callback. */
+typedef struct NysysShmHeader {
+  uint32_t magic;
+  uint32_t layoutVersion;
+  uint32_t headerSize;
+  uint32_t writerProcessId;
+  uint64_t capacity;
+  volatile LONG64 sequence;
+  uint64_t size;
+  int64_t timestampMs;
+  int32_t format;
+  uint32_t reserved1;
+  uint64_t reserved2;
+} NysysShmHeader;
+
+typedef struct NysysShmReader {
+  HANDLE mapping;
+  const NysysShmHeader *header;
+  const uint8_t *payload;
+  uint64_t lastVersion;
+} NysysShmReader;
+
+typedef struct NysysShmSample {
+  uint64_t version;
+  uint64_t missed;
+  int64_t timestampMs;
+  size_t size;
+  int32_t format;
+} NysysShmSample;
+
+static __inline void nysys_shm_close(NysysShmReader *reader) {
+  if (!reader) {
+    return;
+  }
+  if (reader->header) {
+    UnmapViewOfFile((LPCVOID)reader->header);
+  }
+  if (reader->mapping) {
+    CloseHandle(reader->mapping);
+  }
+  memset(reader, 0, sizeof(*reader));
+}
+
+/* Maps the region read-only. Readers never write to it, so any number of processes can attach. */
+static __inline BOOL nysys_shm_open(NysysShmReader *reader, const char *name) {
+  MEMORY_BASIC_INFORMATION region;
+  const NysysShmHeader *header;
+
+  if (!reader) {
+    return FALSE;
+  }
+  memset(reader, 0, sizeof(*reader));
+  reader->mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name ? name : NYSYS_DEFAULT_SHARED_SNAPSHOT_NAME);
+  if (!reader->mapping) {
+    return FALSE;
+  }
+
+  header = (const NysysShmHeader *)MapViewOfFile(reader->mapping, FILE_MAP_READ, 0, 0, 0);
+  reader->header = header;
+  if (!header || VirtualQuery(header, &region, sizeof(region)) == 0 || header->magic != NYSYS_SHM_MAGIC ||
+      header->layoutVersion != NYSYS_SHM_LAYOUT_VERSION || header->headerSize < sizeof(NysysShmHeader) ||
+      header->capacity > (uint64_t)region.RegionSize - header->headerSize) {
+    nysys_shm_close(reader);
+    return FALSE;
+  }
+  reader->payload = (const uint8_t *)header + header->headerSize;
+  return TRUE;
+}
+
+static __inline uint64_t nysys_shm_version(const NysysShmReader *reader) {
+  return reader && reader->header ? (uint64_t)reader->header->sequence / 2 : 0;
+}
+
+/* Copies the latest snapshot into `buffer`. Each attempt is bounded, so the call never waits on the publisher:
+   NYSYS_SHM_TORN means every attempt overlapped a write and the caller may simply try again. `missed` counts the
+   versions published since this reader's previous successful read that it never saw. */
+static __inline int32_t nysys_shm_read(NysysShmReader *reader, uint8_t *buffer, size_t capacity,
+                                       NysysShmSample *sample) {
+  const NysysShmHeader *header;
+  int attempt;
+
+  if (!reader || !reader->header) {
+    return NYSYS_SHM_INVALID;
+  }
+  header = reader->header;
+
+  for (attempt = 0; attempt < NYSYS_SHM_READ_ATTEMPTS; ++attempt) {
+    const LONG64 begin = header->sequence;
+    uint64_t version;
+    uint64_t size;
+    int64_t timestampMs;
+    int32_t format;
+
+    MemoryBarrier();
+    if (begin & 1) {
+      continue;
+    }
+    version = (uint64_t)begin / 2;
+    if (version == 0) {
+      return NYSYS_SHM_NO_DATA;
+    }
+    if (version == reader->lastVersion) {
+      return NYSYS_SHM_UNCHANGED;
+    }
+
+    size = header->size;
+    timestampMs = header->timestampMs;
+    format = header->format;
+    if (size > header->capacity) {
+      continue;
+    }
+    if (size > capacity) {
+      MemoryBarrier();
+      if (header->sequence != begin) {
+        continue;
+      }
+      if (sample) {
+        sample->size = (size_t)size;
+      }
+      return NYSYS_SHM_BUFFER_TOO_SMALL;
+    }
+    memcpy(buffer, reader->payload, (size_t)size);
+
+    MemoryBarrier();
+    if (header->sequence != begin) {
+      continue;
+    }
+
+    if (sample) {
+      sample->version = version;
+      sample->missed = reader->lastVersion != 0 && version > reader->lastVersion + 1
+                           ? version - reader->lastVersion - 1
+                           : 0;
+      sample->timestampMs = timestampMs;
+      sample->size = (size_t)size;
+      sample->format = format;
+    }
+    reader->lastVersion = version;
+    return NYSYS_SHM_OK;
+  }
+  return NYSYS_SHM_TORN;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
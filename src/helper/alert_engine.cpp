@@ -0,0 +1,182 @@
+#include "helper/alert_engine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+#include "helper/json_pointer.hpp"
+
+namespace alert {
+namespace detail {
+
+[[nodiscard]] bool IsRising(AlertCondition condition) noexcept {
+  return condition == AlertCondition::Above || condition == AlertCondition::RateAbove;
+}
+
+[[nodiscard]] bool IsRate(AlertCondition condition) noexcept {
+  return condition == AlertCondition::RateAbove || condition == AlertCondition::RateBelow;
+}
+
+[[nodiscard]] bool IsValidPath(const std::optional<json::PointerSegments> &segments) noexcept {
+  return segments && !segments->empty() &&
+         std::find(segments->begin(), segments->end(), json::detail::kPointerWildcard) == segments->end();
+}
+}  // namespace detail
+
+AlertError AlertEngine::AddRule(const AlertRule &rule) noexcept {
+  if (rule.name.empty() || rule.name.size() > detail::kMaxAlertNameLength) {
+    return AlertError::InvalidName;
+  }
+  if (rule.condition > AlertCondition::RateBelow) {
+    return AlertError::InvalidCondition;
+  }
+  if (!std::isfinite(rule.threshold) || !std::isfinite(rule.hysteresis) || rule.hysteresis < 0.0 ||
+      rule.durationMs < 0 || rule.durationMs > detail::kMaxAlertDurationMs) {
+    return AlertError::InvalidThreshold;
+  }
+
+  try {
+    if (!detail::IsValidPath(json::ParsePointer(rule.path))) {
+      return AlertError::InvalidPath;
+    }
+    if (std::any_of(m_rules.begin(), m_rules.end(),
+                    [&rule](const AlertRule &existing) { return existing.name == rule.name; })) {
+      return AlertError::DuplicateRule;
+    }
+    if (m_rules.size() >= detail::kMaxAlertRules) {
+      return AlertError::TooManyRules;
+    }
+
+    auto rules = m_rules;
+    rules.push_back(rule);
+    Compile(std::move(rules));
+    return AlertError::Success;
+  } catch (...) {
+    return AlertError::MemoryAllocationFailed;
+  }
+}
+
+void AlertEngine::ClearRules() noexcept {
+  m_rules.clear();
+  m_resolver.Clear();
+  m_values.clear();
+  m_program.clear();
+  m_states.clear();
+  m_events.clear();
+  m_stats = AlertStats{};
+}
+
+void AlertEngine::Compile(std::vector<AlertRule> rules) {
+  std::vector<json::PointerSegments> paths;
+  std::vector<Instruction> program;
+  paths.reserve(rules.size());
+  program.reserve(rules.size());
+  for (size_t i = 0; i < rules.size(); ++i) {
+    const auto &rule = rules[i];
+    paths.push_back(*json::ParsePointer(rule.path));
+
+    const double offset = detail::IsRising(rule.condition) ? -rule.hysteresis : rule.hysteresis;
+    program.push_back(Instruction{i, rule.condition, rule.threshold, rule.threshold + offset, rule.durationMs});
+  }
+
+  auto states = m_states;
+  states.resize(rules.size());
+  std::vector<double> values(rules.size());
+  std::vector<AlertEvent> events;
+  events.reserve(rules.size());
+  m_resolver.Compile(paths);
+
+  m_rules.swap(rules);
+  m_program.swap(program);
+  m_states.swap(states);
+  m_values.swap(values);
+  m_events.swap(events);
+}
+
+bool AlertEngine::IsEnabled() const noexcept { return !m_rules.empty(); }
+
+const std::vector<AlertEvent> &AlertEngine::Evaluate(const json::SnapshotTree &tree, int64_t timestamp) noexcept {
+  const auto start = std::chrono::steady_clock::now();
+  m_events.clear();
+
+  const auto &nodes = tree.GetNodes();
+  m_resolver.Resolve(tree);
+  for (size_t i = 0; i < m_values.size(); ++i) {
+    const auto index = m_resolver.GetIndex(i);
+    const auto value = index ? json::GetNumber(nodes[*index]) : std::nullopt;
+    m_values[i] = value ? *value : std::nan("");
+  }
+
+  for (size_t i = 0; i < m_program.size(); ++i) {
+    const auto &instruction = m_program[i];
+    auto &state = m_states[i];
+    double value = m_values[instruction.slot];
+    if (std::isnan(value)) {
+      // Nothing could ever clear an alert whose value is gone (device removed, section failed), so clear it now.
+      if (state.active) {
+        state.active = false;
+        ++m_stats.clearedCount;
+        m_events.push_back(AlertEvent{i, AlertState::Cleared, value, timestamp});
+      }
+      state.hasPrevious = false;
+      state.pendingSince = detail::kNotPending;
+      continue;
+    }
+
+    if (detail::IsRate(instruction.condition)) {
+      const bool hasRate = state.hasPrevious && timestamp > state.previousTimestamp;
+      const double rate = hasRate ? (value - state.previousValue) * 1000.0 /
+                                        static_cast<double>(timestamp - state.previousTimestamp)
+                                  : 0.0;
+      state.previousValue = value;
+      state.previousTimestamp = timestamp;
+      state.hasPrevious = true;
+      if (!hasRate) {
+        continue;
+      }
+      value = rate;
+    }
+
+    const bool rising = detail::IsRising(instruction.condition);
+    if (!state.active) {
+      if (!(rising ? value > instruction.raiseLevel : value < instruction.raiseLevel)) {
+        state.pendingSince = detail::kNotPending;
+        continue;
+      }
+      if (state.pendingSince == detail::kNotPending) {
+        state.pendingSince = timestamp;
+      }
+      if (timestamp - state.pendingSince >= instruction.durationMs) {
+        state.active = true;
+        ++m_stats.raisedCount;
+        m_events.push_back(AlertEvent{i, AlertState::Raised, value, timestamp});
+      }
+    } else if (rising ? value <= instruction.clearLevel : value >= instruction.clearLevel) {
+      state.active = false;
+      state.pendingSince = detail::kNotPending;
+      ++m_stats.clearedCount;
+      m_events.push_back(AlertEvent{i, AlertState::Cleared, value, timestamp});
+    }
+  }
+
+  const auto elapsed =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  ++m_stats.evaluations;
+  m_stats.lastEvaluationNs = elapsed;
+  m_stats.maxEvaluationNs = std::max(m_stats.maxEvaluationNs, elapsed);
+  m_stats.totalEvaluationNs += elapsed;
+  return m_events;
+}
+
+const AlertRule &AlertEngine::GetRule(size_t index) const noexcept { return m_rules[index]; }
+
+AlertStats AlertEngine::GetStats() const noexcept {
+  auto stats = m_stats;
+  stats.ruleCount = m_rules.size();
+  stats.activeCount = static_cast<size_t>(
+      std::count_if(m_states.begin(), m_states.end(), [](const RuleState &state) { return state.active; }));
+  return stats;
+}
+
+}  // namespace alert
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include "helper/batch_buffer.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+namespace json {
+namespace detail {
+
+void AppendUnsigned(std::string &buffer, uint64_t value) {
+  char digits[20];
+  const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  buffer.append(digits, static_cast<size_t>(result.ptr - digits));
+}
+}  // namespace detail
+
+BatchBuffer::BatchBuffer() { m_text.reserve(detail::kInitialBatchCapacity); }
+
+void BatchBuffer::Configure(BatchFraming framing, const BatchLimits &limits) noexcept {
+  m_framing = framing;
+  m_limits = limits;
+}
+
+void BatchBuffer::Clear() noexcept {
+  m_text.clear();
+  m_binary.Reset(m_format.value_or(BinaryFormat::Cbor));
+  m_format.reset();
+  m_sampleCount = 0;
+  m_firstSampleTime = {};
+  m_finished = false;
+}
+
+void BatchBuffer::BeginSample(std::optional<BinaryFormat> format, std::chrono::steady_clock::time_point now) {
+  if (m_sampleCount > 0) {
+    return;
+  }
+
+  m_format = format;
+  m_firstSampleTime = now;
+  m_finished = false;
+  if (format) {
+    m_binary.Reset(*format);
+    if (m_framing == BatchFraming::JsonArray) {
+      m_binary.BeginArray();
+    }
+  } else {
+    m_text.clear();
+    if (m_framing == BatchFraming::JsonArray) {
+      m_text.push_back('[');
+    }
+  }
+}
+
+bool BatchBuffer::Append(std::string_view sample, uint64_t sequence, uint64_t timestamp,
+                         std::chrono::steady_clock::time_point now) noexcept {
+  if (sample.empty() || m_finished || !Matches(std::nullopt)) {
+    return false;
+  }
+
+  // A sample that fails halfway is cut back off, so the batch only ever holds whole samples.
+  size_t checkpoint = 0;
+  try {
+    BeginSample(std::nullopt, now);
+    checkpoint = m_text.size();
+    if (m_framing == BatchFraming::JsonArray && m_sampleCount > 0) {
+      m_text.push_back(',');
+    }
+
+    m_text.append("{\"data\":");
+    m_text.append(sample);
+    m_text.append(",\"sequence\":");
+    detail::AppendUnsigned(m_text, sequence);
+    m_text.append(",\"timestamp\":");
+    detail::AppendUnsigned(m_text, timestamp);
+    m_text.push_back('}');
+    if (m_framing == BatchFraming::Ndjson) {
+      m_text.push_back('\n');
+    }
+
+    ++m_sampleCount;
+    return true;
+  } catch (...) {
+    m_text.resize(std::min(checkpoint, m_text.size()));
+    return false;
+  }
+}
+
+bool BatchBuffer::Append(const std::vector<uint8_t> &sample, BinaryFormat format, uint64_t sequence,
+                         uint64_t timestamp, std::chrono::steady_clock::time_point now) noexcept {
+  if (sample.empty() || m_finished || !Matches(format)) {
+    return false;
+  }
+
+  BinaryWriter::Checkpoint checkpoint;
+  try {
+    BeginSample(format, now);
+    checkpoint = m_binary.Save();
+    m_binary.BeginObject();
+    m_binary.Key("data");
+    m_binary.RawValue(sample.data(), sample.size());
+    m_binary.Field("sequence", sequence);
+    m_binary.Field("timestamp", timestamp);
+    m_binary.EndObject();
+
+    ++m_sampleCount;
+    return true;
+  } catch (...) {
+    m_binary.Restore(checkpoint);
+    return false;
+  }
+}
+
+bool BatchBuffer::Finish() noexcept {
+  if (m_sampleCount == 0) {
+    return false;
+  }
+  if (m_finished) {
+    return true;
+  }
+
+  try {
+    if (m_framing == BatchFraming::JsonArray) {
+      if (m_format) {
+        m_binary.EndArray();
+      } else {
+        m_text.push_back(']');
+      }
+    }
+    m_finished = true;
+    return !m_format || m_binary.IsValid();
+  } catch (...) {
+    return false;
+  }
+}
+
+bool BatchBuffer::Matches(std::optional<BinaryFormat> format) const noexcept {
+  return m_sampleCount == 0 || m_format == format;
+}
+
+bool BatchBuffer::ShouldFlush(std::chrono::steady_clock::time_point now) const noexcept {
+  if (m_sampleCount == 0) {
+    return false;
+  }
+
+  const size_t maxBytes = m_limits.maxBytes > 0 ? m_limits.maxBytes : detail::kMaxBatchBytes;
+  return (m_limits.maxSamples > 0 && m_sampleCount >= m_limits.maxSamples) || GetSize() >= maxBytes ||
+         (m_limits.maxAge.count() > 0 && now - m_firstSampleTime >= m_limits.maxAge);
+}
+
+bool BatchBuffer::IsEmpty() const noexcept { return m_sampleCount == 0; }
+
+bool BatchBuffer::IsBinary() const noexcept { return m_format.has_value(); }
+
+size_t BatchBuffer::GetSampleCount() const noexcept { return m_sampleCount; }
+
+size_t BatchBuffer::GetSize() const noexcept { return m_format ? m_binary.GetBuffer().size() : m_text.size(); }
+
+const std::string &BatchBuffer::GetText() const noexcept { return m_text; }
+
+const std::vector<uint8_t> &BatchBuffer::GetBytes() const noexcept { return m_binary.GetBuffer(); }
+
+}  // namespace json
\ No newline at end of file
@@ -0,0 +1,319 @@
+#include "helper/binary_writer.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "helper/json_writer.hpp"
+
+namespace json {
+namespace detail {
+
+constexpr uint8_t kCborUnsigned = 0;
+constexpr uint8_t kCborNegative = 1;
+constexpr uint8_t kCborText = 3;
+constexpr uint8_t kCborArray = 4;
+constexpr uint8_t kCborMap = 5;
+constexpr uint8_t kCborFalse = 0xF4;
+constexpr uint8_t kCborTrue = 0xF5;
+constexpr uint8_t kCborNull = 0xF6;
+constexpr uint8_t kCborFloat64 = 0xFB;
+
+constexpr uint8_t kMsgPackNil = 0xC0;
+constexpr uint8_t kMsgPackFalse = 0xC2;
+constexpr uint8_t kMsgPackTrue = 0xC3;
+constexpr uint8_t kMsgPackFloat64 = 0xCB;
+constexpr uint8_t kMsgPackUint8 = 0xCC;
+constexpr uint8_t kMsgPackUint16 = 0xCD;
+constexpr uint8_t kMsgPackUint32 = 0xCE;
+constexpr uint8_t kMsgPackUint64 = 0xCF;
+constexpr uint8_t kMsgPackInt8 = 0xD0;
+constexpr uint8_t kMsgPackInt16 = 0xD1;
+constexpr uint8_t kMsgPackInt32 = 0xD2;
+constexpr uint8_t kMsgPackInt64 = 0xD3;
+constexpr uint8_t kMsgPackFixStr = 0xA0;
+constexpr uint8_t kMsgPackStr8 = 0xD9;
+constexpr uint8_t kMsgPackStr16 = 0xDA;
+constexpr uint8_t kMsgPackStr32 = 0xDB;
+constexpr uint8_t kMsgPackFixArray = 0x90;
+constexpr uint8_t kMsgPackArray16 = 0xDC;
+constexpr uint8_t kMsgPackArray32 = 0xDD;
+constexpr uint8_t kMsgPackFixMap = 0x80;
+constexpr uint8_t kMsgPackMap16 = 0xDE;
+constexpr uint8_t kMsgPackMap32 = 0xDF;
+
+size_t StoreBigEndian(uint8_t *out, uint64_t value, size_t byteCount) noexcept {
+  for (size_t i = 0; i < byteCount; ++i) {
+    out[i] = static_cast<uint8_t>(value >> (8 * (byteCount - 1 - i)));
+  }
+  return byteCount;
+}
+}  // namespace detail
+
+BinaryWriter::BinaryWriter() { m_buffer.reserve(detail::kInitialBinaryCapacity); }
+
+void BinaryWriter::Reset(BinaryFormat format) noexcept {
+  m_buffer.clear();
+  m_depth = 0;
+  m_format = format;
+  m_afterKey = false;
+  m_valid = true;
+}
+
+void BinaryWriter::BeforeValue() {
+  if (m_afterKey) {
+    m_afterKey = false;
+    return;
+  }
+
+  if (m_depth > 0) {
+    if (m_containers[m_depth].isMap) {
+      throw std::logic_error("Map value written without key");
+    }
+    ++m_containers[m_depth].count;
+  }
+}
+
+void BinaryWriter::WriteBigEndian(uint64_t value, size_t byteCount) {
+  uint8_t bytes[8];
+  detail::StoreBigEndian(bytes, value, byteCount);
+  m_buffer.insert(m_buffer.end(), bytes, bytes + byteCount);
+}
+
+void BinaryWriter::WriteCborHead(uint8_t majorType, uint64_t argument) {
+  const auto initial = static_cast<uint8_t>(majorType << 5);
+
+  if (argument < 24) {
+    m_buffer.push_back(static_cast<uint8_t>(initial | argument));
+  } else if (argument <= std::numeric_limits<uint8_t>::max()) {
+    m_buffer.push_back(initial | 24);
+    WriteBigEndian(argument, 1);
+  } else if (argument <= std::numeric_limits<uint16_t>::max()) {
+    m_buffer.push_back(initial | 25);
+    WriteBigEndian(argument, 2);
+  } else if (argument <= std::numeric_limits<uint32_t>::max()) {
+    m_buffer.push_back(initial | 26);
+    WriteBigEndian(argument, 4);
+  } else {
+    m_buffer.push_back(initial | 27);
+    WriteBigEndian(argument, 8);
+  }
+}
+
+size_t BinaryWriter::EncodeContainerHeader(uint8_t *out, bool isMap, uint32_t count) const noexcept {
+  if (m_format == BinaryFormat::Cbor) {
+    const auto initial = static_cast<uint8_t>((isMap ? detail::kCborMap : detail::kCborArray) << 5);
+    if (count < 24) {
+      out[0] = static_cast<uint8_t>(initial | count);
+      return 1;
+    }
+    if (count <= std::numeric_limits<uint8_t>::max()) {
+      out[0] = initial | 24;
+      return 1 + detail::StoreBigEndian(out + 1, count, 1);
+    }
+    if (count <= std::numeric_limits<uint16_t>::max()) {
+      out[0] = initial | 25;
+      return 1 + detail::StoreBigEndian(out + 1, count, 2);
+    }
+    out[0] = initial | 26;
+    return 1 + detail::StoreBigEndian(out + 1, count, 4);
+  }
+
+  if (count < 16) {
+    out[0] = static_cast<uint8_t>((isMap ? detail::kMsgPackFixMap : detail::kMsgPackFixArray) | count);
+    return 1;
+  }
+  if (count <= std::numeric_limits<uint16_t>::max()) {
+    out[0] = isMap ? detail::kMsgPackMap16 : detail::kMsgPackArray16;
+    return 1 + detail::StoreBigEndian(out + 1, count, 2);
+  }
+  out[0] = isMap ? detail::kMsgPackMap32 : detail::kMsgPackArray32;
+  return 1 + detail::StoreBigEndian(out + 1, count, 4);
+}
+
+void BinaryWriter::PushContainer(bool isMap) {
+  if (m_depth + 1 >= detail::kMaxBinaryDepth) {
+    throw std::length_error("Binary nesting depth exceeded");
+  }
+
+  BeforeValue();
+  const size_t headerOffset = m_buffer.size();
+  m_buffer.resize(headerOffset + detail::kContainerHeaderReserve);
+
+  ++m_depth;
+  m_containers[m_depth] = Container{headerOffset, 0, isMap};
+}
+
+void BinaryWriter::PopContainer(bool isMap) {
+  if (m_depth == 0 || m_containers[m_depth].isMap != isMap || m_afterKey) {
+    throw std::logic_error("Unbalanced binary container");
+  }
+
+  const auto &container = m_containers[m_depth];
+  uint8_t header[detail::kContainerHeaderReserve];
+  const size_t headerSize = EncodeContainerHeader(header, isMap, container.count);
+
+  uint8_t *base = m_buffer.data() + container.headerOffset;
+  const size_t bodyOffset = container.headerOffset + detail::kContainerHeaderReserve;
+  const size_t bodySize = m_buffer.size() - bodyOffset;
+
+  if (headerSize < detail::kContainerHeaderReserve) {
+    std::memmove(base + headerSize, base + detail::kContainerHeaderReserve, bodySize);
+    m_buffer.resize(m_buffer.size() - (detail::kContainerHeaderReserve - headerSize));
+  }
+  std::memcpy(m_buffer.data() + container.headerOffset, header, headerSize);
+
+  --m_depth;
+}
+
+void BinaryWriter::BeginObject() { PushContainer(true); }
+
+void BinaryWriter::EndObject() { PopContainer(true); }
+
+void BinaryWriter::BeginArray() { PushContainer(false); }
+
+void BinaryWriter::EndArray() { PopContainer(false); }
+
+void BinaryWriter::Key(std::string_view key) {
+  if (m_depth == 0 || !m_containers[m_depth].isMap || m_afterKey) {
+    throw std::logic_error("Key written outside of a map");
+  }
+
+  ++m_containers[m_depth].count;
+  WriteString(key);
+  m_afterKey = true;
+}
+
+void BinaryWriter::WriteString(std::string_view value) {
+  if (!IsValidUtf8(value)) {
+    m_valid = false;
+  }
+
+  const size_t size = value.size();
+  if (m_format == BinaryFormat::Cbor) {
+    WriteCborHead(detail::kCborText, size);
+  } else if (size < 32) {
+    m_buffer.push_back(static_cast<uint8_t>(detail::kMsgPackFixStr | size));
+  } else if (size <= std::numeric_limits<uint8_t>::max()) {
+    m_buffer.push_back(detail::kMsgPackStr8);
+    WriteBigEndian(size, 1);
+  } else if (size <= std::numeric_limits<uint16_t>::max()) {
+    m_buffer.push_back(detail::kMsgPackStr16);
+    WriteBigEndian(size, 2);
+  } else {
+    m_buffer.push_back(detail::kMsgPackStr32);
+    WriteBigEndian(size, 4);
+  }
+
+  const auto *data = reinterpret_cast<const uint8_t *>(value.data());
+  m_buffer.insert(m_buffer.end(), data, data + size);
+}
+
+void BinaryWriter::Value(std::string_view value) {
+  BeforeValue();
+  WriteString(value);
+}
+
+void BinaryWriter::Value(bool value) {
+  BeforeValue();
+  if (m_format == BinaryFormat::Cbor) {
+    m_buffer.push_back(value ? detail::kCborTrue : detail::kCborFalse);
+  } else {
+    m_buffer.push_back(value ? detail::kMsgPackTrue : detail::kMsgPackFalse);
+  }
+}
+
+void BinaryWriter::Null() {
+  BeforeValue();
+  m_buffer.push_back(m_format == BinaryFormat::Cbor ? detail::kCborNull : detail::kMsgPackNil);
+}
+
+void BinaryWriter::RawValue(const uint8_t *data, size_t size) {
+  BeforeValue();
+  m_buffer.insert(m_buffer.end(), data, data + size);
+}
+
+void BinaryWriter::WriteUnsigned(uint64_t value) {
+  BeforeValue();
+
+  if (m_format == BinaryFormat::Cbor) {
+    WriteCborHead(detail::kCborUnsigned, value);
+  } else if (value < 128) {
+    m_buffer.push_back(static_cast<uint8_t>(value));
+  } else if (value <= std::numeric_limits<uint8_t>::max()) {
+    m_buffer.push_back(detail::kMsgPackUint8);
+    WriteBigEndian(value, 1);
+  } else if (value <= std::numeric_limits<uint16_t>::max()) {
+    m_buffer.push_back(detail::kMsgPackUint16);
+    WriteBigEndian(value, 2);
+  } else if (value <= std::numeric_limits<uint32_t>::max()) {
+    m_buffer.push_back(detail::kMsgPackUint32);
+    WriteBigEndian(value, 4);
+  } else {
+    m_buffer.push_back(detail::kMsgPackUint64);
+    WriteBigEndian(value, 8);
+  }
+}
+
+void BinaryWriter::WriteInteger(int64_t value) {
+  if (value >= 0) {
+    WriteUnsigned(static_cast<uint64_t>(value));
+    return;
+  }
+
+  BeforeValue();
+
+  if (m_format == BinaryFormat::Cbor) {
+    WriteCborHead(detail::kCborNegative, static_cast<uint64_t>(-(value + 1)));
+  } else if (value >= -32) {
+    m_buffer.push_back(static_cast<uint8_t>(value));
+  } else if (value >= std::numeric_limits<int8_t>::min()) {
+    m_buffer.push_back(detail::kMsgPackInt8);
+    WriteBigEndian(static_cast<uint64_t>(value), 1);
+  } else if (value >= std::numeric_limits<int16_t>::min()) {
+    m_buffer.push_back(detail::kMsgPackInt16);
+    WriteBigEndian(static_cast<uint64_t>(value), 2);
+  } else if (value >= std::numeric_limits<int32_t>::min()) {
+    m_buffer.push_back(detail::kMsgPackInt32);
+    WriteBigEndian(static_cast<uint64_t>(value), 4);
+  } else {
+    m_buffer.push_back(detail::kMsgPackInt64);
+    WriteBigEndian(static_cast<uint64_t>(value), 8);
+  }
+}
+
+void BinaryWriter::Value(double value) {
+  if (!std::isfinite(value)) {
+    Null();
+    return;
+  }
+
+  BeforeValue();
+
+  uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  m_buffer.push_back(m_format == BinaryFormat::Cbor ? detail::kCborFloat64 : detail::kMsgPackFloat64);
+  WriteBigEndian(bits, sizeof(bits));
+}
+
+BinaryWriter::Checkpoint BinaryWriter::Save() const noexcept {
+  return Checkpoint{m_buffer.size(), m_depth, m_containers[m_depth].count, m_afterKey};
+}
+
+void BinaryWriter::Restore(const Checkpoint &checkpoint) noexcept {
+  if (checkpoint.size <= m_buffer.size()) {
+    m_buffer.resize(checkpoint.size);
+  }
+  m_depth = checkpoint.depth;
+  m_containers[m_depth].count = checkpoint.count;
+  m_afterKey = checkpoint.afterKey;
+}
+
+const std::vector<uint8_t> &BinaryWriter::GetBuffer() const noexcept { return m_buffer; }
+
+BinaryFormat BinaryWriter::GetFormat() const noexcept { return m_format; }
+
+bool BinaryWriter::IsValid() const noexcept { return m_valid && m_depth == 0 && !m_afterKey; }
+
+}  // namespace json
\ No newline at end of file
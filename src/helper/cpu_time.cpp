@@ -0,0 +1,99 @@
+#include "helper/cpu_time.hpp"
+
+namespace cputime {
+namespace detail {
+
+[[nodiscard]] double Percent(uint64_t part, uint64_t total) noexcept {
+  return total > 0 ? static_cast<double>(part) * 100.0 / static_cast<double>(total) : 0.0;
+}
+}  // namespace detail
+
+void CounterColumns::Resize(size_t count) {
+  idle.assign(count, 0);
+  kernel.assign(count, 0);
+  user.assign(count, 0);
+  dpc.assign(count, 0);
+  interrupt.assign(count, 0);
+}
+
+void ShareColumns::Resize(size_t count) {
+  usage.assign(count, 0.0f);
+  user.assign(count, 0.0f);
+  system.assign(count, 0.0f);
+  irq.assign(count, 0.0f);
+  dpc.assign(count, 0.0f);
+  idle.assign(count, 0.0f);
+}
+
+void ComputeShares(const CounterColumns &current, const CounterColumns &previous, size_t count, ShareColumns &shares,
+                   Breakdown &total) noexcept {
+  const uint64_t *__restrict curIdle = current.idle.data();
+  const uint64_t *__restrict curKernel = current.kernel.data();
+  const uint64_t *__restrict curUser = current.user.data();
+  const uint64_t *__restrict curDpc = current.dpc.data();
+  const uint64_t *__restrict curInterrupt = current.interrupt.data();
+  const uint64_t *__restrict prevIdle = previous.idle.data();
+  const uint64_t *__restrict prevKernel = previous.kernel.data();
+  const uint64_t *__restrict prevUser = previous.user.data();
+  const uint64_t *__restrict prevDpc = previous.dpc.data();
+  const uint64_t *__restrict prevInterrupt = previous.interrupt.data();
+
+  float *__restrict usage = shares.usage.data();
+  float *__restrict user = shares.user.data();
+  float *__restrict system = shares.system.data();
+  float *__restrict irq = shares.irq.data();
+  float *__restrict dpc = shares.dpc.data();
+  float *__restrict idle = shares.idle.data();
+
+  uint64_t sumIdle = 0;
+  uint64_t sumKernel = 0;
+  uint64_t sumUser = 0;
+  uint64_t sumDpc = 0;
+  uint64_t sumInterrupt = 0;
+
+  for (size_t i = 0; i < count; ++i) {
+    const uint64_t dIdle = curIdle[i] - prevIdle[i];
+    const uint64_t dKernel = curKernel[i] - prevKernel[i];
+    const uint64_t dUser = curUser[i] - prevUser[i];
+    const uint64_t dDpc = curDpc[i] - prevDpc[i];
+    const uint64_t dInterrupt = curInterrupt[i] - prevInterrupt[i];
+
+    sumIdle += dIdle;
+    sumKernel += dKernel;
+    sumUser += dUser;
+    sumDpc += dDpc;
+    sumInterrupt += dInterrupt;
+
+    const float fIdle = static_cast<float>(dIdle);
+    const float fKernel = static_cast<float>(dKernel);
+    const float fUser = static_cast<float>(dUser);
+    const float fDpc = static_cast<float>(dDpc);
+    const float fInterrupt = static_cast<float>(dInterrupt);
+
+    const float sum = fKernel + fUser;
+    const float scale = sum > 0.0f ? 100.0f / sum : 0.0f;
+    const float busy = sum - fIdle;
+    const float kernelBusy = fKernel - fIdle - fDpc - fInterrupt;
+
+    usage[i] = (busy > 0.0f ? busy : 0.0f) * scale;
+    user[i] = fUser * scale;
+    system[i] = (kernelBusy > 0.0f ? kernelBusy : 0.0f) * scale;
+    irq[i] = fInterrupt * scale;
+    dpc[i] = fDpc * scale;
+    idle[i] = fIdle * scale;
+  }
+
+  const uint64_t sum = sumKernel + sumUser;
+  const uint64_t busy = sum > sumIdle ? sum - sumIdle : 0;
+  const uint64_t kernelOverhead = sumIdle + sumDpc + sumInterrupt;
+  const uint64_t kernelBusy = sumKernel > kernelOverhead ? sumKernel - kernelOverhead : 0;
+
+  total.usage = detail::Percent(busy, sum);
+  total.user = detail::Percent(sumUser, sum);
+  total.system = detail::Percent(kernelBusy, sum);
+  total.irq = detail::Percent(sumInterrupt, sum);
+  total.dpc = detail::Percent(sumDpc, sum);
+  total.idle = detail::Percent(sumIdle, sum);
+}
+
+}  // namespace cputime
\ No newline at end of file
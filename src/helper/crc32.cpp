@@ -0,0 +1,31 @@
+#include "helper/crc32.hpp"
+
+#include <array>
+
+namespace codec {
+namespace detail {
+
+constexpr std::array<uint32_t, 256> MakeCrcTable() noexcept {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < table.size(); ++i) {
+    uint32_t value = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+    }
+    table[i] = value;
+  }
+  return table;
+}
+
+constexpr auto kCrcTable = MakeCrcTable();
+}  // namespace detail
+
+uint32_t Crc32(const uint8_t *data, size_t size, uint32_t crc) noexcept {
+  crc = ~crc;
+  for (size_t i = 0; i < size; ++i) {
+    crc = detail::kCrcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+}  // namespace codec
\ No newline at end of file
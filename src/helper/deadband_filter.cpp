@@ -0,0 +1,212 @@
+#include "helper/deadband_filter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+
+namespace filter {
+namespace detail {
+
+[[nodiscard]] bool IsNumeric(json::SnapshotNodeType type) noexcept {
+  return type == json::SnapshotNodeType::Integer || type == json::SnapshotNodeType::Unsigned ||
+         type == json::SnapshotNodeType::Double;
+}
+
+[[nodiscard]] double ToDouble(const json::SnapshotNode &node) noexcept {
+  switch (node.type) {
+    case json::SnapshotNodeType::Integer:
+      return static_cast<double>(node.intValue);
+    case json::SnapshotNodeType::Unsigned:
+      return static_cast<double>(node.uintValue);
+    default:
+      return node.doubleValue;
+  }
+}
+
+[[nodiscard]] bool ValueEquals(const json::SnapshotTree &previousTree, const json::SnapshotNode &previous,
+                               const json::SnapshotTree &currentTree, const json::SnapshotNode &current) noexcept {
+  switch (current.type) {
+    case json::SnapshotNodeType::Bool:
+      return previous.boolValue == current.boolValue;
+    case json::SnapshotNodeType::Integer:
+      return previous.intValue == current.intValue;
+    case json::SnapshotNodeType::Unsigned:
+      return previous.uintValue == current.uintValue;
+    case json::SnapshotNodeType::Double:
+      return previous.doubleValue == current.doubleValue;
+    case json::SnapshotNodeType::String:
+      return previousTree.GetString(previous) == currentTree.GetString(current);
+    default:
+      return true;
+  }
+}
+[[nodiscard]] bool IsMoreSpecific(const DeadbandRule &candidate, const DeadbandRule &current) noexcept {
+  if (candidate.segments.size() != current.segments.size()) {
+    return candidate.segments.size() > current.segments.size();
+  }
+  return candidate.wildcardCount < current.wildcardCount;
+}
+}  // namespace detail
+
+DeadbandError DeadbandFilter::AddRule(std::string_view path, DeadbandMode mode, double threshold) noexcept {
+  if (!std::isfinite(threshold) || threshold < 0.0) {
+    return DeadbandError::InvalidThreshold;
+  }
+  if (m_rules.size() >= detail::kMaxDeadbandRules) {
+    return DeadbandError::TooManyRules;
+  }
+
+  try {
+    auto segments = json::ParsePointer(path);
+    if (!segments) {
+      return DeadbandError::InvalidPath;
+    }
+
+    for (auto &rule : m_rules) {
+      if (rule.segments == *segments) {
+        rule.mode = mode;
+        rule.threshold = threshold;
+        return DeadbandError::Success;
+      }
+    }
+
+    const auto wildcardCount =
+        static_cast<size_t>(std::count(segments->begin(), segments->end(), json::detail::kPointerWildcard));
+    m_rules.push_back(DeadbandRule{std::move(*segments), wildcardCount, mode, threshold});
+    return DeadbandError::Success;
+  } catch (...) {
+    return DeadbandError::MemoryAllocationFailed;
+  }
+}
+
+void DeadbandFilter::ClearRules() noexcept { m_rules.clear(); }
+
+void DeadbandFilter::SetMaxSilence(std::chrono::milliseconds maxSilence) noexcept {
+  m_maxSilence = maxSilence.count() > 0 ? maxSilence : std::chrono::milliseconds{0};
+}
+
+bool DeadbandFilter::IsEnabled() const noexcept { return !m_rules.empty() || m_maxSilence.count() > 0; }
+
+FilterDecision DeadbandFilter::Evaluate(const json::SnapshotTree &lastEmitted, const json::SnapshotTree &current,
+                                        std::chrono::steady_clock::time_point now) const noexcept {
+  if (!IsEnabled() || lastEmitted.IsEmpty() || HasSignificantChange(lastEmitted, current)) {
+    return FilterDecision::Emit;
+  }
+  if (m_maxSilence.count() > 0 && now - m_lastEmitTime >= m_maxSilence) {
+    return FilterDecision::Heartbeat;
+  }
+  return FilterDecision::Suppress;
+}
+
+void DeadbandFilter::Record(FilterDecision decision, std::chrono::steady_clock::time_point now) noexcept {
+  if (decision == FilterDecision::Suppress) {
+    ++m_suppressedCount;
+    return;
+  }
+
+  if (decision == FilterDecision::Heartbeat) {
+    ++m_heartbeatCount;
+  }
+  ++m_emittedCount;
+  m_lastEmitTime = now;
+}
+
+void DeadbandFilter::ResetStats() noexcept {
+  m_emittedCount = 0;
+  m_suppressedCount = 0;
+  m_heartbeatCount = 0;
+  m_lastEmitTime = {};
+}
+
+uint64_t DeadbandFilter::GetEmittedCount() const noexcept { return m_emittedCount; }
+
+uint64_t DeadbandFilter::GetSuppressedCount() const noexcept { return m_suppressedCount; }
+
+uint64_t DeadbandFilter::GetHeartbeatCount() const noexcept { return m_heartbeatCount; }
+
+const DeadbandRule *DeadbandFilter::FindRule(const std::string_view *path, size_t pathLength) const noexcept {
+  const DeadbandRule *best = nullptr;
+  for (const auto &rule : m_rules) {
+    if ((!best || detail::IsMoreSpecific(rule, *best)) &&
+        json::MatchesPointerPrefix(rule.segments, path, pathLength)) {
+      best = &rule;
+    }
+  }
+  return best;
+}
+
+bool DeadbandFilter::IsOutsideDeadband(const std::string_view *path, size_t pathLength, double previous,
+                                       double current) const noexcept {
+  const auto *rule = FindRule(path, pathLength);
+  if (!rule) {
+    return true;
+  }
+
+  const double difference = std::fabs(current - previous);
+  if (rule->mode == DeadbandMode::Percent) {
+    return difference > std::fabs(previous) * rule->threshold / 100.0;
+  }
+  return difference > rule->threshold;
+}
+
+bool DeadbandFilter::HasSignificantChange(const json::SnapshotTree &lastEmitted,
+                                          const json::SnapshotTree &current) const noexcept {
+  const auto &previousNodes = lastEmitted.GetNodes();
+  const auto &currentNodes = current.GetNodes();
+  if (previousNodes.size() != currentNodes.size()) {
+    return true;
+  }
+
+  std::array<size_t, json::detail::kMaxTreeDepth> ends{};
+  std::array<size_t, json::detail::kMaxTreeDepth> childCounts{};
+  std::array<bool, json::detail::kMaxTreeDepth> isArray{};
+  std::array<std::string_view, json::detail::kMaxTreeDepth + 1> path{};
+  std::array<json::PointerIndexBuffer, json::detail::kMaxTreeDepth + 1> indexBuffers{};
+  size_t depth = 0;
+
+  for (size_t i = 0; i < currentNodes.size(); ++i) {
+    const auto &previousNode = previousNodes[i];
+    const auto &currentNode = currentNodes[i];
+    if (previousNode.type != currentNode.type || previousNode.end != currentNode.end ||
+        lastEmitted.GetKey(previousNode) != current.GetKey(currentNode)) {
+      return true;
+    }
+
+    while (depth > 0 && ends[depth - 1] <= i) {
+      --depth;
+    }
+
+    if (depth > 0) {
+      if (isArray[depth - 1]) {
+        path[depth] = json::FormatPointerIndex(childCounts[depth - 1], indexBuffers[depth]);
+      } else {
+        path[depth] = current.GetKey(currentNode);
+      }
+      ++childCounts[depth - 1];
+    }
+
+    if (json::IsContainer(currentNode.type)) {
+      if (depth >= json::detail::kMaxTreeDepth) {
+        return true;
+      }
+      ends[depth] = currentNode.end;
+      childCounts[depth] = 0;
+      isArray[depth] = currentNode.type == json::SnapshotNodeType::Array;
+      ++depth;
+      continue;
+    }
+
+    if (detail::ValueEquals(lastEmitted, previousNode, current, currentNode)) {
+      continue;
+    }
+
+    if (!detail::IsNumeric(currentNode.type) ||
+        IsOutsideDeadband(path.data() + 1, depth, detail::ToDouble(previousNode), detail::ToDouble(currentNode))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace filter
\ No newline at end of file
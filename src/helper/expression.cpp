@@ -0,0 +1,491 @@
+#include "helper/expression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace expr {
+namespace detail {
+
+constexpr size_t kMaxNesting = 64;
+
+[[nodiscard]] bool IsValidName(std::string_view name) noexcept {
+  return !name.empty() && name.size() <= kMaxExpressionNameLength &&
+         std::all_of(name.begin(), name.end(), [](char c) {
+           return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-' ||
+                  c == '.';
+         });
+}
+
+[[nodiscard]] bool HasWildcard(const json::PointerSegments &segments) noexcept {
+  return std::find(segments.begin(), segments.end(), json::detail::kPointerWildcard) != segments.end();
+}
+
+[[nodiscard]] uint32_t Intern(std::vector<json::PointerSegments> &table, json::PointerSegments segments) {
+  const auto found = std::find(table.begin(), table.end(), segments);
+  if (found != table.end()) {
+    return static_cast<uint32_t>(found - table.begin());
+  }
+  table.push_back(std::move(segments));
+  return static_cast<uint32_t>(table.size() - 1);
+}
+
+template <typename Visitor>
+void VisitMatches(const json::SnapshotTree &tree, size_t index, const json::PointerSegments &pattern, size_t depth,
+                  Visitor &visitor) noexcept {
+  if (depth == pattern.size()) {
+    visitor(tree.GetNodes()[index]);
+    return;
+  }
+
+  const auto &nodes = tree.GetNodes();
+  const auto &node = nodes[index];
+  if (pattern[depth] != json::detail::kPointerWildcard) {
+    if (const auto child = json::FindChild(tree, index, pattern[depth])) {
+      VisitMatches(tree, *child, pattern, depth + 1, visitor);
+    }
+  } else if (node.type == json::SnapshotNodeType::Object || node.type == json::SnapshotNodeType::Array) {
+    for (size_t child = index + 1; child < node.end; child = nodes[child].end) {
+      VisitMatches(tree, child, pattern, depth + 1, visitor);
+    }
+  }
+}
+
+// Recursive-descent parser that emits postfix code while tracking the operand stack depth it will need.
+class Compiler {
+public:
+  Compiler(std::string_view source, std::vector<Instruction> &code, std::vector<double> &constants,
+           std::vector<json::PointerSegments> &loadPaths, std::vector<json::PointerSegments> &patterns)
+      : m_source(source), m_code(code), m_constants(constants), m_loadPaths(loadPaths), m_patterns(patterns) {}
+
+  [[nodiscard]] ExpressionError Compile() {
+    if (!ParseExpression()) {
+      return m_error;
+    }
+    SkipSpace();
+    return m_position == m_source.size() ? ExpressionError::Success : ExpressionError::SyntaxError;
+  }
+
+private:
+  std::string_view m_source;
+  std::vector<Instruction> &m_code;
+  std::vector<double> &m_constants;
+  std::vector<json::PointerSegments> &m_loadPaths;
+  std::vector<json::PointerSegments> &m_patterns;
+  size_t m_position = 0;
+  size_t m_depth = 0;
+  size_t m_nesting = 0;
+  ExpressionError m_error = ExpressionError::SyntaxError;
+
+  void SkipSpace() noexcept {
+    while (m_position < m_source.size() && (m_source[m_position] == ' ' || m_source[m_position] == '\t')) {
+      ++m_position;
+    }
+  }
+
+  [[nodiscard]] bool Peek(char c) noexcept {
+    SkipSpace();
+    return m_position < m_source.size() && m_source[m_position] == c;
+  }
+
+  [[nodiscard]] bool Consume(char c) noexcept {
+    if (!Peek(c)) {
+      return false;
+    }
+    ++m_position;
+    return true;
+  }
+
+  [[nodiscard]] bool Fail(ExpressionError error) noexcept {
+    m_error = error;
+    return false;
+  }
+
+  [[nodiscard]] bool Emit(OpCode op, uint32_t operand = 0) {
+    switch (op) {
+      case OpCode::Constant:
+      case OpCode::Load:
+      case OpCode::Sum:
+      case OpCode::Average:
+      case OpCode::Minimum:
+      case OpCode::Maximum:
+      case OpCode::Count:
+        if (++m_depth > kMaxStackDepth) {
+          return Fail(ExpressionError::TooComplex);
+        }
+        break;
+      case OpCode::Add:
+      case OpCode::Subtract:
+      case OpCode::Multiply:
+      case OpCode::Divide:
+      case OpCode::Min:
+      case OpCode::Max:
+        --m_depth;
+        break;
+      default:
+        break;
+    }
+    m_code.push_back(Instruction{op, operand});
+    return true;
+  }
+
+  [[nodiscard]] bool ParseExpression() {
+    if (++m_nesting > kMaxNesting) {
+      return Fail(ExpressionError::TooComplex);
+    }
+    if (!ParseTerm()) {
+      return false;
+    }
+    while (true) {
+      const OpCode op = Peek('+') ? OpCode::Add : Peek('-') ? OpCode::Subtract : OpCode::Constant;
+      if (op == OpCode::Constant) {
+        break;
+      }
+      ++m_position;
+      if (!ParseTerm() || !Emit(op)) {
+        return false;
+      }
+    }
+    --m_nesting;
+    return true;
+  }
+
+  [[nodiscard]] bool ParseTerm() {
+    if (!ParseUnary()) {
+      return false;
+    }
+    while (true) {
+      const OpCode op = Peek('*') ? OpCode::Multiply : Peek('/') ? OpCode::Divide : OpCode::Constant;
+      if (op == OpCode::Constant) {
+        break;
+      }
+      ++m_position;
+      if (!ParseUnary() || !Emit(op)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  [[nodiscard]] bool ParseUnary() {
+    if (Consume('-')) {
+      if (++m_nesting > kMaxNesting) {
+        return Fail(ExpressionError::TooComplex);
+      }
+      const bool parsed = ParseUnary() && Emit(OpCode::Negate);
+      --m_nesting;
+      return parsed;
+    }
+    return ParsePrimary();
+  }
+
+  [[nodiscard]] bool ParsePrimary() {
+    SkipSpace();
+    if (m_position >= m_source.size()) {
+      return Fail(ExpressionError::SyntaxError);
+    }
+
+    const char c = m_source[m_position];
+    if (c == '(') {
+      ++m_position;
+      return ParseExpression() && (Consume(')') || Fail(ExpressionError::SyntaxError));
+    }
+    if (c == '{') {
+      json::PointerSegments segments;
+      if (!ParseReference(segments)) {
+        return false;
+      }
+      if (HasWildcard(segments)) {
+        return Fail(ExpressionError::InvalidPath);
+      }
+      return Emit(OpCode::Load, Intern(m_loadPaths, std::move(segments)));
+    }
+    if ((c >= '0' && c <= '9') || c == '.') {
+      return ParseNumber();
+    }
+    if ((c >= 'a' && c <= 'z') || c == '_') {
+      return ParseCall();
+    }
+    return Fail(ExpressionError::SyntaxError);
+  }
+
+  [[nodiscard]] bool ParseNumber() {
+    double value = 0.0;
+    const char *first = m_source.data() + m_position;
+    const char *last = m_source.data() + m_source.size();
+    const auto [ptr, ec] = std::from_chars(first, last, value);
+    if (ec != std::errc{} || !std::isfinite(value)) {
+      return Fail(ExpressionError::SyntaxError);
+    }
+    m_position += static_cast<size_t>(ptr - first);
+
+    m_constants.push_back(value);
+    return Emit(OpCode::Constant, static_cast<uint32_t>(m_constants.size() - 1));
+  }
+
+  [[nodiscard]] bool ParseReference(json::PointerSegments &segments) {
+    if (!Consume('{')) {
+      return Fail(ExpressionError::SyntaxError);
+    }
+    const size_t close = m_source.find('}', m_position);
+    if (close == std::string_view::npos) {
+      return Fail(ExpressionError::SyntaxError);
+    }
+
+    auto parsed = json::ParsePointer(m_source.substr(m_position, close - m_position));
+    if (!parsed || parsed->empty()) {
+      return Fail(ExpressionError::InvalidPath);
+    }
+    segments = std::move(*parsed);
+    m_position = close + 1;
+    return true;
+  }
+
+  // A lone braced pointer as the only argument selects the aggregate form of min/max.
+  [[nodiscard]] bool IsBareReferenceArgument() noexcept {
+    if (!Peek('{')) {
+      return false;
+    }
+    const size_t close = m_source.find('}', m_position);
+    if (close == std::string_view::npos) {
+      return false;
+    }
+    size_t next = close + 1;
+    while (next < m_source.size() && (m_source[next] == ' ' || m_source[next] == '\t')) {
+      ++next;
+    }
+    return next < m_source.size() && m_source[next] == ')';
+  }
+
+  [[nodiscard]] bool ParseAggregate(OpCode op) {
+    json::PointerSegments segments;
+    if (!ParseReference(segments)) {
+      return false;
+    }
+    return Emit(op, Intern(m_patterns, std::move(segments))) && (Consume(')') || Fail(ExpressionError::SyntaxError));
+  }
+
+  [[nodiscard]] bool ParseCall() {
+    const size_t start = m_position;
+    while (m_position < m_source.size() &&
+           ((m_source[m_position] >= 'a' && m_source[m_position] <= 'z') || m_source[m_position] == '_')) {
+      ++m_position;
+    }
+    const auto function = m_source.substr(start, m_position - start);
+    if (!Consume('(')) {
+      return Fail(ExpressionError::SyntaxError);
+    }
+
+    if (function == "sum" || function == "avg" || function == "count") {
+      return ParseAggregate(function == "sum" ? OpCode::Sum : function == "avg" ? OpCode::Average : OpCode::Count);
+    }
+    if (function == "min" || function == "max") {
+      if (IsBareReferenceArgument()) {
+        return ParseAggregate(function == "min" ? OpCode::Minimum : OpCode::Maximum);
+      }
+      return ParseExpression() && (Consume(',') || Fail(ExpressionError::SyntaxError)) && ParseExpression() &&
+             (Consume(')') || Fail(ExpressionError::SyntaxError)) &&
+             Emit(function == "min" ? OpCode::Min : OpCode::Max);
+    }
+    if (function == "abs") {
+      return ParseExpression() && (Consume(')') || Fail(ExpressionError::SyntaxError)) && Emit(OpCode::Abs);
+    }
+    return Fail(ExpressionError::UnknownFunction);
+  }
+};
+}  // namespace detail
+
+ExpressionError ExpressionEngine::AddExpression(std::string_view name, std::string_view source) noexcept {
+  if (!detail::IsValidName(name)) {
+    return ExpressionError::InvalidName;
+  }
+  if (source.empty() || source.size() > detail::kMaxExpressionLength) {
+    return ExpressionError::SyntaxError;
+  }
+  if (std::any_of(m_expressions.begin(), m_expressions.end(),
+                  [name](const Expression &expression) { return expression.name == name; })) {
+    return ExpressionError::DuplicateName;
+  }
+  if (m_expressions.size() >= detail::kMaxExpressions) {
+    return ExpressionError::TooManyExpressions;
+  }
+
+  const size_t codeSize = m_code.size();
+  const size_t constantCount = m_constants.size();
+  const size_t loadCount = m_loadPaths.size();
+  const size_t patternCount = m_patterns.size();
+  const auto rollback = [&]() noexcept {
+    m_code.resize(codeSize);
+    m_constants.resize(constantCount);
+    m_loadPaths.resize(loadCount);
+    m_patterns.resize(patternCount);
+  };
+
+  try {
+    detail::Compiler compiler(source, m_code, m_constants, m_loadPaths, m_patterns);
+    const auto result = compiler.Compile();
+    if (result != ExpressionError::Success) {
+      rollback();
+      return result;
+    }
+
+    if (m_loadPaths.size() != loadCount) {
+      m_resolver.Compile(m_loadPaths);
+    }
+    m_loads.resize(m_loadPaths.size());
+    m_aggregates.resize(m_patterns.size());
+    m_results.resize(m_expressions.size() + 1);
+    m_order.reserve(m_expressions.size() + 1);
+    m_expressions.push_back(
+        Expression{std::string{name}, static_cast<uint32_t>(codeSize), static_cast<uint32_t>(m_code.size())});
+  } catch (...) {
+    rollback();
+    return ExpressionError::MemoryAllocationFailed;
+  }
+
+  const size_t index = m_expressions.size() - 1;
+  const auto position = std::lower_bound(m_order.begin(), m_order.end(), name, [this](size_t existing, auto key) {
+    return m_expressions[existing].name < key;
+  });
+  m_order.insert(position, index);
+  m_results[index] = std::nan("");
+  return ExpressionError::Success;
+}
+
+void ExpressionEngine::ClearExpressions() noexcept {
+  m_expressions.clear();
+  m_order.clear();
+  m_code.clear();
+  m_constants.clear();
+  m_loadPaths.clear();
+  m_patterns.clear();
+  m_resolver.Clear();
+  m_loads.clear();
+  m_aggregates.clear();
+  m_results.clear();
+}
+
+bool ExpressionEngine::IsEnabled() const noexcept { return !m_expressions.empty(); }
+
+void ExpressionEngine::Evaluate(const json::SnapshotTree &tree) noexcept {
+  const auto &nodes = tree.GetNodes();
+  m_resolver.Resolve(tree);
+  for (size_t i = 0; i < m_loads.size(); ++i) {
+    const auto index = m_resolver.GetIndex(i);
+    const auto value = index ? json::GetNumber(nodes[*index]) : std::nullopt;
+    m_loads[i] = value ? *value : std::nan("");
+  }
+
+  for (size_t i = 0; i < m_patterns.size(); ++i) {
+    Aggregate aggregate;
+    auto accumulate = [&aggregate](const json::SnapshotNode &node) {
+      ++aggregate.matched;
+      if (const auto value = json::GetNumber(node)) {
+        aggregate.min = aggregate.count == 0 ? *value : std::min(aggregate.min, *value);
+        aggregate.max = aggregate.count == 0 ? *value : std::max(aggregate.max, *value);
+        aggregate.sum += *value;
+        ++aggregate.count;
+      }
+    };
+    if (!nodes.empty()) {
+      detail::VisitMatches(tree, 0, m_patterns[i], 0, accumulate);
+    }
+    m_aggregates[i] = aggregate;
+  }
+
+  constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+  std::array<double, detail::kMaxStackDepth> stack{};
+  for (size_t e = 0; e < m_expressions.size(); ++e) {
+    size_t top = 0;
+    const auto &expression = m_expressions[e];
+    for (uint32_t pc = expression.begin; pc < expression.end; ++pc) {
+      const auto &instruction = m_code[pc];
+      switch (instruction.op) {
+        case OpCode::Constant:
+          stack[top++] = m_constants[instruction.operand];
+          break;
+        case OpCode::Load:
+          stack[top++] = m_loads[instruction.operand];
+          break;
+        case OpCode::Sum:
+          stack[top++] = m_aggregates[instruction.operand].sum;
+          break;
+        case OpCode::Average: {
+          const auto &aggregate = m_aggregates[instruction.operand];
+          stack[top++] = aggregate.count > 0 ? aggregate.sum / aggregate.count : kMissing;
+          break;
+        }
+        case OpCode::Minimum:
+          stack[top++] = m_aggregates[instruction.operand].count > 0 ? m_aggregates[instruction.operand].min : kMissing;
+          break;
+        case OpCode::Maximum:
+          stack[top++] = m_aggregates[instruction.operand].count > 0 ? m_aggregates[instruction.operand].max : kMissing;
+          break;
+        case OpCode::Count:
+          stack[top++] = m_aggregates[instruction.operand].matched;
+          break;
+        case OpCode::Add:
+          --top;
+          stack[top - 1] += stack[top];
+          break;
+        case OpCode::Subtract:
+          --top;
+          stack[top - 1] -= stack[top];
+          break;
+        case OpCode::Multiply:
+          --top;
+          stack[top - 1] *= stack[top];
+          break;
+        case OpCode::Divide:
+          --top;
+          stack[top - 1] /= stack[top];
+          break;
+        case OpCode::Negate:
+          stack[top - 1] = -stack[top - 1];
+          break;
+        case OpCode::Min:
+          --top;
+          stack[top - 1] = std::isnan(stack[top - 1]) || std::isnan(stack[top]) ? kMissing
+                                                                                : std::min(stack[top - 1], stack[top]);
+          break;
+        case OpCode::Max:
+          --top;
+          stack[top - 1] = std::isnan(stack[top - 1]) || std::isnan(stack[top]) ? kMissing
+                                                                                : std::max(stack[top - 1], stack[top]);
+          break;
+        case OpCode::Abs:
+          stack[top - 1] = std::fabs(stack[top - 1]);
+          break;
+      }
+    }
+    m_results[e] = top == 1 ? stack[0] : kMissing;
+  }
+}
+
+bool ExpressionEngine::WriteSection(json::SnapshotTree &tree) const noexcept {
+  try {
+    tree.Reset();
+    tree.BeginObject();
+    for (const size_t index : m_order) {
+      tree.Key(m_expressions[index].name);
+      if (std::isfinite(m_results[index])) {
+        tree.Value(m_results[index]);
+      } else {
+        tree.Null();
+      }
+    }
+    tree.EndObject();
+    return tree.IsValid();
+  } catch (...) {
+    return false;
+  }
+}
+
+size_t ExpressionEngine::GetExpressionCount() const noexcept { return m_expressions.size(); }
+
+double ExpressionEngine::GetResult(size_t index) const noexcept { return m_results[index]; }
+
+}  // namespace expr
\ No newline at end of file
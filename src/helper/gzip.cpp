@@ -0,0 +1,214 @@
+#include "helper/gzip.hpp"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+
+#include "helper/crc32.hpp"
+
+namespace codec {
+namespace detail {
+
+constexpr size_t kWindowMask = kWindowSize - 1;
+constexpr uint32_t kHashMask = (1u << kHashBits) - 1;
+constexpr unsigned kEndOfBlock = 256;
+
+constexpr std::array<uint16_t, 29> kLengthBase = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                                  31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr std::array<uint8_t, 29> kLengthExtra = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                                  2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr std::array<uint16_t, 30> kDistanceBase = {1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+                                                    33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+                                                    1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr std::array<uint8_t, 30> kDistanceExtra = {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                                    6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+class BitWriter {
+public:
+  explicit BitWriter(std::vector<uint8_t> &output) noexcept : m_output(output) {}
+
+  void WriteBits(uint32_t value, unsigned count) {
+    m_buffer |= static_cast<uint64_t>(value) << m_count;
+    m_count += count;
+    while (m_count >= 8) {
+      m_output.push_back(static_cast<uint8_t>(m_buffer));
+      m_buffer >>= 8;
+      m_count -= 8;
+    }
+  }
+
+  // Huffman codes are packed most significant bit first, unlike every other deflate field.
+  void WriteCode(uint32_t code, unsigned length) {
+    uint32_t reversed = 0;
+    for (unsigned i = 0; i < length; ++i) {
+      reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    WriteBits(reversed, length);
+  }
+
+  void Finish() {
+    if (m_count > 0) {
+      m_output.push_back(static_cast<uint8_t>(m_buffer));
+    }
+    m_buffer = 0;
+    m_count = 0;
+  }
+
+private:
+  std::vector<uint8_t> &m_output;
+  uint64_t m_buffer = 0;
+  unsigned m_count = 0;
+};
+
+void WriteSymbol(BitWriter &writer, unsigned symbol) {
+  if (symbol < 144) {
+    writer.WriteCode(0x30 + symbol, 8);
+  } else if (symbol < 256) {
+    writer.WriteCode(0x190 + symbol - 144, 9);
+  } else if (symbol < 280) {
+    writer.WriteCode(symbol - 256, 7);
+  } else {
+    writer.WriteCode(0xC0 + symbol - 280, 8);
+  }
+}
+
+void WriteMatch(BitWriter &writer, size_t length, size_t distance) {
+  const size_t lengthCode =
+      static_cast<size_t>(std::upper_bound(kLengthBase.begin(), kLengthBase.end(), length) - kLengthBase.begin()) - 1;
+  WriteSymbol(writer, static_cast<unsigned>(257 + lengthCode));
+  writer.WriteBits(static_cast<uint32_t>(length - kLengthBase[lengthCode]), kLengthExtra[lengthCode]);
+
+  const size_t distanceCode = static_cast<size_t>(std::upper_bound(kDistanceBase.begin(), kDistanceBase.end(),
+                                                                   distance) -
+                                                  kDistanceBase.begin()) -
+                              1;
+  writer.WriteCode(static_cast<uint32_t>(distanceCode), 5);
+  writer.WriteBits(static_cast<uint32_t>(distance - kDistanceBase[distanceCode]), kDistanceExtra[distanceCode]);
+}
+
+[[nodiscard]] uint32_t Hash(const uint8_t *data) noexcept {
+  return ((static_cast<uint32_t>(data[0]) << 10) ^ (static_cast<uint32_t>(data[1]) << 5) ^ data[2]) & kHashMask;
+}
+
+[[nodiscard]] size_t StoredSize(size_t size) noexcept {
+  return size + 5 * std::max<size_t>(1, (size + kMaxStoredBlockSize - 1) / kMaxStoredBlockSize);
+}
+
+void AppendLittleEndian(std::vector<uint8_t> &output, uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    output.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+}  // namespace detail
+
+bool GzipEncoder::Compress(const uint8_t *data, size_t size, std::vector<uint8_t> &output) noexcept {
+  if ((!data && size > 0) || size > static_cast<size_t>(INT32_MAX)) {
+    return false;
+  }
+
+  try {
+    static constexpr uint8_t kHeader[detail::kGzipHeaderSize] = {0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF};
+    output.clear();
+    output.reserve(detail::kGzipHeaderSize + size / 4 + detail::kGzipTrailerSize + 64);
+    output.insert(output.end(), std::begin(kHeader), std::end(kHeader));
+
+    Deflate(data, size, output);
+    if (output.size() - detail::kGzipHeaderSize > detail::StoredSize(size)) {
+      output.resize(detail::kGzipHeaderSize);
+      Store(data, size, output);
+    }
+
+    detail::AppendLittleEndian(output, Crc32(data, size));
+    detail::AppendLittleEndian(output, static_cast<uint32_t>(size));
+    return true;
+  } catch (...) {
+    output.clear();
+    return false;
+  }
+}
+
+void GzipEncoder::Deflate(const uint8_t *data, size_t size, std::vector<uint8_t> &output) {
+  m_head.assign(size_t{1} << detail::kHashBits, -1);
+  m_previous.resize(detail::kWindowSize);
+
+  const auto insert = [&](size_t position) noexcept {
+    if (position + detail::kMinMatch <= size) {
+      const uint32_t hash = detail::Hash(data + position);
+      m_previous[position & detail::kWindowMask] = m_head[hash];
+      m_head[hash] = static_cast<int32_t>(position);
+    }
+  };
+
+  detail::BitWriter writer(output);
+  writer.WriteBits(1, 1);
+  writer.WriteBits(1, 2);
+
+  size_t position = 0;
+  while (position < size) {
+    size_t bestLength = 0;
+    size_t bestDistance = 0;
+    if (position + detail::kMinMatch <= size) {
+      const size_t maxLength = std::min(detail::kMaxMatch, size - position);
+      int32_t candidate = m_head[detail::Hash(data + position)];
+      for (size_t chain = 0; candidate >= 0 && chain < detail::kMaxChainLength; ++chain) {
+        const size_t distance = position - static_cast<size_t>(candidate);
+        if (distance > detail::kWindowSize) {
+          break;
+        }
+
+        const uint8_t *match = data + candidate;
+        if (match[bestLength] == data[position + bestLength]) {
+          size_t length = 0;
+          while (length < maxLength && match[length] == data[position + length]) {
+            ++length;
+          }
+          if (length > bestLength) {
+            bestLength = length;
+            bestDistance = distance;
+            if (length == maxLength) {
+              break;
+            }
+          }
+        }
+
+        const int32_t next = m_previous[static_cast<size_t>(candidate) & detail::kWindowMask];
+        if (next >= candidate) {
+          break;
+        }
+        candidate = next;
+      }
+    }
+
+    if (bestLength >= detail::kMinMatch) {
+      detail::WriteMatch(writer, bestLength, bestDistance);
+      for (size_t i = 0; i < bestLength; ++i) {
+        insert(position + i);
+      }
+      position += bestLength;
+    } else {
+      detail::WriteSymbol(writer, data[position]);
+      insert(position);
+      ++position;
+    }
+  }
+
+  detail::WriteSymbol(writer, detail::kEndOfBlock);
+  writer.Finish();
+}
+
+void GzipEncoder::Store(const uint8_t *data, size_t size, std::vector<uint8_t> &output) {
+  size_t offset = 0;
+  do {
+    const size_t length = std::min(detail::kMaxStoredBlockSize, size - offset);
+    const bool final = offset + length == size;
+    output.push_back(final ? 1 : 0);
+    output.push_back(static_cast<uint8_t>(length));
+    output.push_back(static_cast<uint8_t>(length >> 8));
+    output.push_back(static_cast<uint8_t>(~length));
+    output.push_back(static_cast<uint8_t>(~length >> 8));
+    output.insert(output.end(), data + offset, data + offset + length);
+    offset += length;
+  } while (offset < size);
+}
+
+}  // namespace codec
\ No newline at end of file
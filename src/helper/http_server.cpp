@@ -0,0 +1,572 @@
+#include "helper/http_server.hpp"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <climits>
+#include <utility>
+
+namespace net {
+namespace detail {
+
+#ifdef _WIN32
+using NativeSocket = SOCKET;
+using PollDescriptor = WSAPOLLFD;
+using AddressLength = int;
+using TransferLength = int;
+constexpr int kSendFlags = 0;
+
+[[nodiscard]] int PollSockets(PollDescriptor *descriptors, size_t count, int timeoutMs) noexcept {
+  return WSAPoll(descriptors, static_cast<ULONG>(count), timeoutMs);
+}
+
+void CloseSocket(NativeSocket socket) noexcept { closesocket(socket); }
+
+[[nodiscard]] bool SetNonBlocking(NativeSocket socket) noexcept {
+  u_long mode = 1;
+  return ioctlsocket(socket, FIONBIO, &mode) == 0;
+}
+
+[[nodiscard]] bool WouldBlock() noexcept { return WSAGetLastError() == WSAEWOULDBLOCK; }
+#else
+using NativeSocket = int;
+using PollDescriptor = pollfd;
+using AddressLength = socklen_t;
+using TransferLength = size_t;
+constexpr int kSendFlags = MSG_NOSIGNAL;
+
+[[nodiscard]] int PollSockets(PollDescriptor *descriptors, size_t count, int timeoutMs) noexcept {
+  return poll(descriptors, static_cast<nfds_t>(count), timeoutMs);
+}
+
+void CloseSocket(NativeSocket socket) noexcept { close(socket); }
+
+[[nodiscard]] bool SetNonBlocking(NativeSocket socket) noexcept {
+  const int flags = fcntl(socket, F_GETFL, 0);
+  return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+[[nodiscard]] bool WouldBlock() noexcept { return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR; }
+#endif
+
+[[nodiscard]] NativeSocket ToNative(uintptr_t socket) noexcept { return static_cast<NativeSocket>(socket); }
+
+[[nodiscard]] uintptr_t FromNative(NativeSocket socket) noexcept { return static_cast<uintptr_t>(socket); }
+
+[[nodiscard]] int64_t NowMs() noexcept {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+[[nodiscard]] sockaddr_in LoopbackAddress(uint16_t port) noexcept {
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(port);
+  return address;
+}
+
+[[nodiscard]] uint16_t BoundPort(NativeSocket socket) noexcept {
+  sockaddr_in address{};
+  AddressLength length = sizeof(address);
+  if (getsockname(socket, reinterpret_cast<sockaddr *>(&address), &length) != 0) {
+    return 0;
+  }
+  return ntohs(address.sin_port);
+}
+
+[[nodiscard]] std::shared_ptr<const std::string> MakeStatus(std::string_view status, std::string_view headers) {
+  std::string response;
+  response.append("HTTP/1.1 ").append(status).append("\r\nContent-Type: text/plain\r\nContent-Length: ");
+  response.append(std::to_string(status.size() + 1)).append("\r\n").append(headers).append("\r\n");
+  response.append(status).append("\n");
+  return std::make_shared<const std::string>(std::move(response));
+}
+
+[[nodiscard]] bool EqualsIgnoreCase(std::string_view left, std::string_view right) noexcept {
+  return left.size() == right.size() && std::equal(left.begin(), left.end(), right.begin(), [](char a, char b) {
+           return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+         });
+}
+
+[[nodiscard]] bool ContainsIgnoreCase(std::string_view value, std::string_view token) noexcept {
+  for (size_t i = 0; i + token.size() <= value.size(); ++i) {
+    if (EqualsIgnoreCase(value.substr(i, token.size()), token)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+[[nodiscard]] std::string_view FindHeader(std::string_view headers, std::string_view name) noexcept {
+  while (!headers.empty()) {
+    const size_t end = std::min(headers.find("\r\n"), headers.size());
+    const auto line = headers.substr(0, end);
+    const size_t colon = line.find(':');
+    if (colon != std::string_view::npos && EqualsIgnoreCase(line.substr(0, colon), name)) {
+      auto value = line.substr(colon + 1);
+      value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+      return value;
+    }
+    headers.remove_prefix(std::min(end + 2, headers.size()));
+  }
+  return {};
+}
+
+void AppendEventData(std::string &event, std::string_view payload) {
+  size_t begin = 0;
+  do {
+    const size_t end = std::min(payload.find('\n', begin), payload.size());
+    auto line = payload.substr(begin, end - begin);
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    event.append("data: ").append(line).push_back('\n');
+    begin = end + 1;
+  } while (begin < payload.size());
+}
+}  // namespace detail
+
+struct HttpServer::PollSet {
+  std::vector<detail::PollDescriptor> descriptors;
+};
+
+HttpServer::HttpServer() = default;
+
+HttpServer::~HttpServer() { Close(); }
+
+ServerError HttpServer::Open(const ServerOptions &options) noexcept {
+  if (options.maxClients == 0 || options.maxClients > detail::kMaxHttpClients) {
+    return ServerError::InvalidOptions;
+  }
+  Close();
+
+  try {
+    m_pollSet = std::make_unique<PollSet>();
+    m_pollSet->descriptors.reserve(options.maxClients + 2);
+    m_clients.reserve(options.maxClients);
+    m_streamHeader = std::make_shared<const std::string>(
+        "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\n\r\n");
+    m_badRequest = detail::MakeStatus("400 Bad Request", "Connection: close\r\n");
+    m_notFound = detail::MakeStatus("404 Not Found", "");
+    m_notAllowed = detail::MakeStatus("405 Method Not Allowed", "Allow: GET\r\n");
+    m_notAcceptable = detail::MakeStatus("406 Not Acceptable", "");
+    m_tooLarge = detail::MakeStatus("431 Request Header Fields Too Large", "Connection: close\r\n");
+    m_noSnapshot = detail::MakeStatus("503 Service Unavailable", "Retry-After: 1\r\n");
+    m_busy = detail::MakeStatus("503 Service Unavailable", "Connection: close\r\n");
+  } catch (...) {
+    Close();
+    return ServerError::MemoryAllocationFailed;
+  }
+
+#ifdef _WIN32
+  WSADATA data;
+  if (WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+    Close();
+    return ServerError::StartupFailed;
+  }
+  m_startup = true;
+#endif
+
+  const auto listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+  m_listener = detail::FromNative(listener);
+  const auto waker = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  m_waker = detail::FromNative(waker);
+  if (m_listener == detail::kInvalidSocket || m_waker == detail::kInvalidSocket || !detail::SetNonBlocking(listener) ||
+      !detail::SetNonBlocking(waker)) {
+    Close();
+    return ServerError::SocketFailed;
+  }
+
+  const int enable = 1;
+#ifdef _WIN32
+  setsockopt(listener, SOL_SOCKET, SO_EXCLUSIVEADDRUSE, reinterpret_cast<const char *>(&enable), sizeof(enable));
+#else
+  setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+#endif
+
+  const auto address = detail::LoopbackAddress(options.port);
+  const auto wakeAddress = detail::LoopbackAddress(0);
+  if (bind(listener, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 ||
+      listen(listener, SOMAXCONN) != 0 ||
+      bind(waker, reinterpret_cast<const sockaddr *>(&wakeAddress), sizeof(wakeAddress)) != 0) {
+    Close();
+    return ServerError::BindFailed;
+  }
+
+  m_port = detail::BoundPort(listener);
+  m_wakePort = detail::BoundPort(waker);
+  m_maxClients = options.maxClients;
+  m_open = true;
+  return ServerError::Success;
+}
+
+void HttpServer::Close() noexcept {
+  for (auto &client : m_clients) {
+    detail::CloseSocket(detail::ToNative(client.socket));
+  }
+  m_clients.clear();
+  if (m_listener != detail::kInvalidSocket) {
+    detail::CloseSocket(detail::ToNative(m_listener));
+    m_listener = detail::kInvalidSocket;
+  }
+  if (m_waker != detail::kInvalidSocket) {
+    detail::CloseSocket(detail::ToNative(m_waker));
+    m_waker = detail::kInvalidSocket;
+  }
+#ifdef _WIN32
+  if (m_startup) {
+    WSACleanup();
+  }
+#endif
+  m_startup = false;
+  m_open = false;
+  m_port = 0;
+  m_wakePort = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(m_frameMutex);
+    m_latest.reset();
+  }
+  m_current.reset();
+  m_clientCount = 0;
+  m_streamCount = 0;
+}
+
+bool HttpServer::IsOpen() const noexcept { return m_open; }
+
+uint16_t HttpServer::GetPort() const noexcept { return m_port; }
+
+bool HttpServer::Publish(std::string_view payload, std::string_view contentType, bool streamable) noexcept {
+  try {
+    auto frame = std::make_shared<Frame>();
+    frame->version = ++m_publishedCount;
+
+    std::string response;
+    response.reserve(payload.size() + 128);
+    response.append("HTTP/1.1 200 OK\r\nContent-Type: ").append(contentType);
+    response.append("\r\nContent-Length: ").append(std::to_string(payload.size()));
+    response.append("\r\nCache-Control: no-store\r\n\r\n").append(payload);
+    frame->response = std::make_shared<const std::string>(std::move(response));
+
+    if (streamable) {
+      std::string event;
+      event.reserve(payload.size() + payload.size() / 8 + 64);
+      event.append("id: ").append(std::to_string(frame->version)).append("\nevent: snapshot\n");
+      detail::AppendEventData(event, payload);
+      event.push_back('\n');
+      frame->event = std::make_shared<const std::string>(std::move(event));
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_frameMutex);
+      if (!m_latest || m_latest->version < frame->version) {
+        m_latest = std::move(frame);
+      }
+    }
+    Wake();
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+
+void HttpServer::Wake() noexcept {
+  if (m_waker == detail::kInvalidSocket) {
+    return;
+  }
+  const auto address = detail::LoopbackAddress(m_wakePort);
+  const char signal = 0;
+  sendto(detail::ToNative(m_waker), &signal, 1, 0, reinterpret_cast<const sockaddr *>(&address), sizeof(address));
+}
+
+void HttpServer::Poll(int timeoutMs) noexcept {
+  if (!m_open) {
+    return;
+  }
+
+  auto &descriptors = m_pollSet->descriptors;
+  descriptors.clear();
+  descriptors.push_back({detail::ToNative(m_listener), POLLIN, 0});
+  descriptors.push_back({detail::ToNative(m_waker), POLLIN, 0});
+  for (const auto &client : m_clients) {
+    const short events = client.output.empty() ? POLLIN : static_cast<short>(POLLIN | POLLOUT);
+    descriptors.push_back({detail::ToNative(client.socket), events, 0});
+  }
+
+  const int ready = detail::PollSockets(descriptors.data(), descriptors.size(), timeoutMs);
+  const int64_t now = detail::NowMs();
+  if (ready > 0) {
+    const size_t clientCount = m_clients.size();
+    for (size_t i = 0; i < clientCount; ++i) {
+      auto &client = m_clients[i];
+      const short events = descriptors[i + 2].revents;
+      if (events & (POLLERR | POLLNVAL)) {
+        client.closed = true;
+        continue;
+      }
+      if (events & (POLLIN | POLLHUP)) {
+        ReadClient(client, now);
+      }
+      if (!client.closed && (events & POLLOUT)) {
+        FlushClient(client, now);
+      }
+    }
+
+    if (descriptors[1].revents & POLLIN) {
+      char drain[64];
+      while (recv(detail::ToNative(m_waker), drain, sizeof(drain), 0) > 0) {
+      }
+    }
+    if (descriptors[0].revents & POLLIN) {
+      AcceptClients(now);
+    }
+  }
+
+  DeliverLatest(now);
+  for (auto &client : m_clients) {
+    if (client.mode == ClientMode::Request && client.output.empty() &&
+        now - client.lastActivity >= detail::kKeepAliveTimeoutMs) {
+      client.closed = true;
+    }
+  }
+  RemoveClosedClients();
+}
+
+ServerStats HttpServer::GetStats() const noexcept {
+  ServerStats stats;
+  stats.clientCount = m_clientCount;
+  stats.streamCount = m_streamCount;
+  stats.requestCount = m_requestCount;
+  stats.rejectedCount = m_rejectedCount;
+  stats.publishedCount = m_publishedCount;
+  stats.droppedCount = m_droppedCount;
+  return stats;
+}
+
+void HttpServer::AcceptClients(int64_t now) noexcept {
+  while (true) {
+    const auto socket = accept(detail::ToNative(m_listener), nullptr, nullptr);
+    if (detail::FromNative(socket) == detail::kInvalidSocket) {
+      return;
+    }
+
+    if (m_clients.size() >= m_maxClients || !detail::SetNonBlocking(socket)) {
+      ++m_rejectedCount;
+      send(socket, m_busy->data(), static_cast<detail::TransferLength>(m_busy->size()), detail::kSendFlags);
+      detail::CloseSocket(socket);
+      continue;
+    }
+
+    const int enable = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char *>(&enable), sizeof(enable));
+
+    Client client;
+    client.socket = detail::FromNative(socket);
+    client.lastActivity = now;
+    m_clients.push_back(std::move(client));
+    m_clientCount = m_clients.size();
+  }
+}
+
+void HttpServer::DeliverLatest(int64_t now) noexcept {
+  std::shared_ptr<const Frame> latest;
+  {
+    std::lock_guard<std::mutex> lock(m_frameMutex);
+    latest = m_latest;
+  }
+  if (!latest || latest == m_current) {
+    return;
+  }
+  m_current = std::move(latest);
+  if (!m_current->event) {
+    return;
+  }
+
+  for (auto &client : m_clients) {
+    if (client.closed || client.mode != ClientMode::Stream || client.version >= m_current->version) {
+      continue;
+    }
+    client.version = m_current->version;
+    Enqueue(client, m_current->event);
+    FlushClient(client, now);
+  }
+}
+
+void HttpServer::ReadClient(Client &client, int64_t now) noexcept {
+  char buffer[detail::kReadChunkSize];
+  while (client.request.size() <= detail::kMaxRequestBytes) {
+    const auto received = recv(detail::ToNative(client.socket), buffer, sizeof(buffer), 0);
+    if (received == 0) {
+      client.closed = true;
+      return;
+    }
+    if (received < 0) {
+      if (!detail::WouldBlock()) {
+        client.closed = true;
+        return;
+      }
+      break;
+    }
+
+    client.lastActivity = now;
+    if (client.mode == ClientMode::Stream) {
+      continue;
+    }
+    try {
+      client.request.append(buffer, static_cast<size_t>(received));
+    } catch (...) {
+      client.closed = true;
+      return;
+    }
+  }
+
+  ProcessRequests(client);
+  FlushClient(client, now);
+}
+
+void HttpServer::ProcessRequests(Client &client) noexcept {
+  while (client.mode == ClientMode::Request && !client.closeAfterWrite && !client.closed) {
+    const size_t end = client.request.find("\r\n\r\n");
+    if (end == std::string::npos || end + 4 > detail::kMaxRequestBytes) {
+      if (client.request.size() > detail::kMaxRequestBytes) {
+        ++m_rejectedCount;
+        client.closeAfterWrite = true;
+        Enqueue(client, m_tooLarge);
+      }
+      return;
+    }
+
+    ++m_requestCount;
+    HandleRequest(client, std::string_view(client.request).substr(0, end));
+    client.request.erase(0, end + 4);
+  }
+  if (client.mode == ClientMode::Stream) {
+    std::string().swap(client.request);
+  }
+}
+
+void HttpServer::HandleRequest(Client &client, std::string_view head) noexcept {
+  const size_t lineEnd = std::min(head.find("\r\n"), head.size());
+  const auto line = head.substr(0, lineEnd);
+  const auto headers = head.substr(std::min(lineEnd + 2, head.size()));
+
+  const size_t methodEnd = line.find(' ');
+  const size_t targetEnd = methodEnd == std::string_view::npos ? methodEnd : line.find(' ', methodEnd + 1);
+  if (targetEnd == std::string_view::npos) {
+    client.closeAfterWrite = true;
+    Enqueue(client, m_badRequest);
+    return;
+  }
+  const auto method = line.substr(0, methodEnd);
+  auto target = line.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+  const auto version = line.substr(targetEnd + 1);
+  if (version != "HTTP/1.1" && version != "HTTP/1.0") {
+    client.closeAfterWrite = true;
+    Enqueue(client, m_badRequest);
+    return;
+  }
+
+  const auto connection = detail::FindHeader(headers, "Connection");
+  client.closeAfterWrite = version == "HTTP/1.0" ? !detail::ContainsIgnoreCase(connection, "keep-alive")
+                                                 : detail::ContainsIgnoreCase(connection, "close");
+  target = target.substr(0, std::min(target.find('?'), target.size()));
+
+  if (method != "GET") {
+    Enqueue(client, m_notAllowed);
+  } else if (target == "/snapshot") {
+    Enqueue(client, m_current ? m_current->response : m_noSnapshot);
+  } else if (target == "/stream") {
+    if (m_current && !m_current->event) {
+      Enqueue(client, m_notAcceptable);
+    } else {
+      StartStream(client);
+    }
+  } else {
+    Enqueue(client, m_notFound);
+  }
+}
+
+void HttpServer::StartStream(Client &client) noexcept {
+  client.mode = ClientMode::Stream;
+  client.closeAfterWrite = false;
+  ++m_streamCount;
+  Enqueue(client, m_streamHeader);
+  if (m_current && m_current->event) {
+    client.version = m_current->version;
+    Enqueue(client, m_current->event);
+  }
+}
+
+void HttpServer::Enqueue(Client &client, const SharedBytes &bytes) noexcept {
+  if (client.backlogBytes + bytes->size() > detail::kMaxStreamBacklogBytes && !client.output.empty()) {
+    ++m_droppedCount;
+    client.closed = true;
+    return;
+  }
+  try {
+    client.output.push_back(bytes);
+    client.backlogBytes += bytes->size();
+  } catch (...) {
+    client.closed = true;
+  }
+}
+
+void HttpServer::FlushClient(Client &client, int64_t now) noexcept {
+  const auto socket = detail::ToNative(client.socket);
+  while (!client.closed && !client.output.empty()) {
+    const auto &bytes = *client.output.front();
+    const size_t remaining = std::min<size_t>(bytes.size() - client.outputOffset, INT_MAX);
+    const auto sent = send(socket, bytes.data() + client.outputOffset, static_cast<detail::TransferLength>(remaining),
+                           detail::kSendFlags);
+    if (sent < 0) {
+      if (!detail::WouldBlock()) {
+        client.closed = true;
+      }
+      return;
+    }
+
+    client.lastActivity = now;
+    client.outputOffset += static_cast<size_t>(sent);
+    client.backlogBytes -= static_cast<size_t>(sent);
+    if (client.outputOffset == bytes.size()) {
+      client.output.pop_front();
+      client.outputOffset = 0;
+    }
+  }
+
+  if (client.output.empty() && client.closeAfterWrite) {
+    client.closed = true;
+  }
+}
+
+void HttpServer::RemoveClosedClients() noexcept {
+  const auto end = std::remove_if(m_clients.begin(), m_clients.end(), [this](const Client &client) {
+    if (!client.closed) {
+      return false;
+    }
+    detail::CloseSocket(detail::ToNative(client.socket));
+    if (client.mode == ClientMode::Stream) {
+      --m_streamCount;
+    }
+    return true;
+  });
+  m_clients.erase(end, m_clients.end());
+  m_clientCount = m_clients.size();
+}
+
+}  // namespace net
\ No newline at end of file
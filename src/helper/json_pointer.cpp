@@ -0,0 +1,76 @@
+#include "helper/json_pointer.hpp"
+
+#include <charconv>
+#include <utility>
+
+namespace json {
+
+std::optional<PointerSegments> ParsePointer(std::string_view pointer) {
+  PointerSegments segments;
+  if (pointer.empty()) {
+    return segments;
+  }
+  if (pointer.front() != '/') {
+    return std::nullopt;
+  }
+
+  size_t position = 1;
+  while (true) {
+    const size_t next = pointer.find('/', position);
+    const auto raw = pointer.substr(position, next == std::string_view::npos ? std::string_view::npos : next - position);
+
+    std::string segment;
+    segment.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); ++i) {
+      if (raw[i] != '~') {
+        segment.push_back(raw[i]);
+        continue;
+      }
+      if (i + 1 >= raw.size() || (raw[i + 1] != '0' && raw[i + 1] != '1')) {
+        return std::nullopt;
+      }
+      segment.push_back(raw[i + 1] == '0' ? '~' : '/');
+      ++i;
+    }
+    segments.push_back(std::move(segment));
+
+    if (next == std::string_view::npos) {
+      break;
+    }
+    position = next + 1;
+  }
+  return segments;
+}
+
+bool MatchesPointerPrefix(const PointerSegments &pattern, const std::string_view *path, size_t pathLength) noexcept {
+  if (pattern.size() > pathLength) {
+    return false;
+  }
+
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    if (pattern[i] != detail::kPointerWildcard && pattern[i] != path[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsPointerAncestor(const std::string_view *path, size_t pathLength, const PointerSegments &pattern) noexcept {
+  if (pathLength >= pattern.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < pathLength; ++i) {
+    if (pattern[i] != detail::kPointerWildcard && pattern[i] != path[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string_view FormatPointerIndex(size_t index, PointerIndexBuffer &buffer) noexcept {
+  const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), index);
+  return std::string_view(buffer.data(), static_cast<size_t>(result.ptr - buffer.data()));
+}
+
+}  // namespace json
\ No newline at end of file
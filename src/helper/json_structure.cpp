@@ -1,259 +1,607 @@
 #include "helper/json_structure.hpp"
 
-#include <algorithm>
-#include <cctype>
-#include <string>
-
-#include "helper/utils.hpp"
-#include "main/audio_info.hpp"
-#include "main/battery_info.hpp"
-#include "main/cpu_info.hpp"
-#include "main/gpu_info.hpp"
-#include "main/memory_info.hpp"
-#include "main/monitor_info.hpp"
-#include "main/motherboard_info.hpp"
-#include "main/network_info.hpp"
-#include "main/storage_info.hpp"
+#include <array>
+#include <string_view>
+#include <vector>
 
-namespace json {
+#include "helper/model_fields.hpp"
+#include "internal.hpp"
 
-static std::string TrimString(const std::string &str) noexcept {
-  if (str.empty()) {
-    return str;
+namespace json {
+namespace detail {
+
+constexpr size_t kMemorySlotsPosition = reflect::FieldIndex<nysys::MemoryInfo>("total");
+constexpr size_t kFrequencyCoresPosition = reflect::FieldIndex<nysys::CPUFrequencyInfo>("interval_samples");
+constexpr size_t kStorageIOPosition = reflect::FieldIndex<nysys::LogicalDiskInfo>("model");
+constexpr size_t kInventoryHashDigits = 16;
+
+template <typename Item>
+[[nodiscard]] uint64_t HashItems(uint64_t hash, const std::vector<Item> &items) {
+  const uint64_t count = items.size();
+  hash = reflect::detail::HashBytes(hash, &count, sizeof(count));
+  for (const auto &item : items) {
+    hash = reflect::HashFields(item, hash);
   }
+  return hash;
+}
+}  // namespace detail
+
+static std::string_view FormatInventoryHash(uint64_t hash,
+                                            std::array<char, detail::kInventoryHashDigits> &buffer) noexcept {
+  constexpr std::string_view digits = "0123456789abcdef";
+  for (size_t i = buffer.size(); i > 0; --i) {
+    buffer[i - 1] = digits[hash & 0xF];
+    hash >>= 4;
+  }
+  return std::string_view(buffer.data(), buffer.size());
+}
 
-  const auto first = str.find_first_not_of(" \t\n\r\f\v");
-  if (first == std::string::npos) {
-    return {};
+template <typename Writer>
+static void AppendInventoryHash(Writer &writer, std::optional<uint64_t> inventoryHash) {
+  if (!inventoryHash) {
+    return;
   }
 
-  const auto last = str.find_last_not_of(" \t\n\r\f\v");
-  return str.substr(first, last - first + 1);
+  std::array<char, detail::kInventoryHashDigits> buffer{};
+  writer.Field("inventory_hash", FormatInventoryHash(*inventoryHash, buffer));
 }
 
-static void AppendGpuInfo(nlohmann::json &root, const nysys::GPUList *gpuList) noexcept {
+template <typename Writer>
+static void AppendGpuInfo(Writer &writer, const nysys::GPUList *gpuList) noexcept {
   if (!gpuList) {
     return;
   }
 
+  const auto checkpoint = writer.Save();
   try {
-    const auto &gpus = gpuList->GetGPUs();
-    nlohmann::json gpuArray = nlohmann::json::array();
-
-    for (const auto &gpu : gpus) {
-      nlohmann::json gpuObj;
-      gpuObj["name"] = gpu.GetName();
-      gpuObj["vram"] = gpu.GetDedicatedMemory();
-      gpuObj["shared_memory"] = gpu.GetSharedMemory();
-      gpuObj["type"] = gpu.IsIntegrated() ? "iGPU" : "dGPU";
-      gpuArray.push_back(gpuObj);
+    writer.Key("gpu");
+    writer.BeginArray();
+
+    for (const auto &gpu : gpuList->GetGPUs()) {
+      writer.BeginObject();
+      reflect::WriteFields(writer, gpu);
+      writer.EndObject();
     }
 
-    root["gpu"] = gpuArray;
+    writer.EndArray();
   } catch (...) {
+    writer.Restore(checkpoint);
   }
 }
 
-static void AppendMotherboardInfo(nlohmann::json &root, const nysys::MotherboardInfo *mbInfo) noexcept {
+template <typename Writer>
+static void AppendMotherboardInfo(Writer &writer, const nysys::MotherboardInfo *mbInfo) noexcept {
   if (!mbInfo) {
     return;
   }
 
+  const auto checkpoint = writer.Save();
   try {
-    nlohmann::json mbObj;
-    mbObj["manufacturer"] = mbInfo->GetManufacturer();
-    mbObj["product"] = mbInfo->GetProduct();
-    mbObj["serial_number"] = mbInfo->GetSerial();
-    mbObj["bios_version"] = mbInfo->GetBiosVersion();
-    mbObj["bios_serial"] = mbInfo->GetBiosSerial();
-    mbObj["system_sku"] = mbInfo->GetSystemSKU();
-
-    root["motherboard"] = mbObj;
+    writer.Key("motherboard");
+    writer.BeginObject();
+    reflect::WriteFields(writer, *mbInfo);
+    writer.EndObject();
   } catch (...) {
+    writer.Restore(checkpoint);
   }
 }
 
-static void AppendCpuInfo(nlohmann::json &root, const nysys::CPUList *cpuList) noexcept {
+template <typename Writer>
+static void AppendCpuInfo(Writer &writer, const nysys::CPUList *cpuList) noexcept {
   if (!cpuList) {
     return;
   }
 
+  const auto checkpoint = writer.Save();
   try {
-    const auto &cpus = cpuList->GetCPUs();
-    nlohmann::json cpuArray = nlohmann::json::array();
-
-    for (const auto &cpu : cpus) {
-      nlohmann::json cpuObj;
-      cpuObj["name"] = TrimString(cpu.GetName());
-      cpuObj["cores"] = cpu.GetCores();
-      cpuObj["threads"] = cpu.GetThreads();
-      cpuObj["clock_speed"] = cpu.GetClockSpeed();
-      cpuArray.push_back(cpuObj);
+    writer.Key("cpu");
+    writer.BeginArray();
+
+    for (const auto &cpu : cpuList->GetCPUs()) {
+      writer.BeginObject();
+      reflect::WriteFields(writer, cpu);
+      writer.EndObject();
     }
 
-    root["cpu"] = cpuArray;
+    writer.EndArray();
   } catch (...) {
+    writer.Restore(checkpoint);
   }
 }
 
-static void AppendMemoryInfo(nlohmann::json &root, const nysys::MemoryInfo *memInfo) noexcept {
-  if (!memInfo) {
+template <typename Writer>
+static void AppendCpuUsageInfo(Writer &writer, const nysys::CPUUsageInfo *cpuUsage) noexcept {
+  if (!cpuUsage || !cpuUsage->IsInitialized()) {
     return;
   }
 
+  const auto checkpoint = writer.Save();
   try {
-    nlohmann::json memObj;
-    memObj["total"] = utils::BytesToGB(memInfo->GetTotalPhysical());
-    memObj["available"] = utils::BytesToGB(memInfo->GetAvailablePhysical());
-    memObj["used"] = utils::BytesToGB(memInfo->GetUsedPhysical());
-    memObj["usage_percent"] = memInfo->GetMemoryLoad();
-
-    const auto &slots = memInfo->GetRAMSlots();
-    nlohmann::json slotsArray = nlohmann::json::array();
-
-    for (const auto &slot : slots) {
-      nlohmann::json slotObj;
-      slotObj["location"] = slot.GetSlotLocation();
-      slotObj["capacity"] = utils::BytesToGB(slot.GetCapacity());
-      slotObj["speed"] = slot.GetSpeed();
-      slotObj["configured_speed"] = slot.GetConfiguredSpeed();
-      slotObj["manufacturer"] = slot.GetManufacturer();
-      slotsArray.push_back(slotObj);
+    writer.Key("cpu_usage");
+    writer.BeginObject();
+
+    writer.Key("cores");
+    writer.BeginArray();
+    const size_t coreCount = cpuUsage->GetCoreCount();
+    for (size_t i = 0; i < coreCount; ++i) {
+      writer.BeginObject();
+      reflect::WriteFields(writer, cpuUsage->GetCore(i));
+      writer.EndObject();
     }
+    writer.EndArray();
 
-    memObj["ram_slots"] = slotsArray;
-    root["memory"] = memObj;
+    reflect::WriteFields(writer, cpuUsage->GetTotal());
+    writer.EndObject();
   } catch (...) {
+    writer.Restore(checkpoint);
   }
 }
 
-static void AppendStorageInfo(nlohmann::json &root, const nysys::StorageList *storageList) noexcept {
-  if (!storageList) {
+template <typename Writer>
+static void AppendCpuFrequencyInfo(Writer &writer, const nysys::CPUFrequencyInfo *cpuFrequency) noexcept {
+  if (!cpuFrequency || !cpuFrequency->IsInitialized()) {
     return;
   }
 
+  const auto checkpoint = writer.Save();
   try {
-    const auto &disks = storageList->GetDisks();
-    nlohmann::json storageArray = nlohmann::json::array();
-
-    for (const auto &disk : disks) {
-      nlohmann::json diskObj;
-      const double totalSize = disk.GetTotalSize();
-      const double freeSpace = disk.GetAvailableSpace();
-      const double usedSpace = utils::RoundToDecimalPlaces(totalSize - freeSpace, 2);
-
-      diskObj["drive"] = disk.GetDriveLetter();
-      diskObj["type"] = disk.GetType();
-      diskObj["model"] = disk.GetModel();
-      diskObj["interface"] = disk.GetInterfaceType();
-      diskObj["total_size"] = totalSize;
-      diskObj["free_space"] = freeSpace;
-      diskObj["used_space"] = usedSpace;
-      storageArray.push_back(diskObj);
+    writer.Key("cpu_frequency");
+    writer.BeginObject();
+    reflect::WriteFields<0, detail::kFrequencyCoresPosition>(writer, *cpuFrequency);
+
+    const auto &currentMhz = cpuFrequency->GetCurrentMhz();
+    const auto &maxMhz = cpuFrequency->GetMaxMhz();
+    const auto &limitMhz = cpuFrequency->GetLimitMhz();
+    const auto &throttleCounts = cpuFrequency->GetThrottleCounts();
+
+    writer.Key("cores");
+    writer.BeginArray();
+    for (size_t i = 0; i < cpuFrequency->GetCoreCount(); ++i) {
+      writer.BeginObject();
+      writer.Field("current_mhz", currentMhz[i]);
+      writer.Field("limit_mhz", limitMhz[i]);
+      writer.Field("max_mhz", maxMhz[i]);
+      writer.Field("throttle_count", throttleCounts[i]);
+      writer.EndObject();
     }
+    writer.EndArray();
 
-    root["storage"] = storageArray;
+    reflect::WriteFields<detail::kFrequencyCoresPosition>(writer, *cpuFrequency);
+    writer.EndObject();
   } catch (...) {
+    writer.Restore(checkpoint);
   }
 }
 
-static void AppendNetworkInfo(nlohmann::json &root, const nysys::NetworkList *networkList) noexcept {
-  if (!networkList) {
+template <typename Writer>
+static void AppendMemoryInfo(Writer &writer, const nysys::MemoryInfo *memInfo) noexcept {
+  if (!memInfo) {
+    return;
+  }
+
+  const auto checkpoint = writer.Save();
+  try {
+    writer.Key("memory");
+    writer.BeginObject();
+    reflect::WriteFields<0, detail::kMemorySlotsPosition>(writer, *memInfo);
+
+    writer.Key("ram_slots");
+    writer.BeginArray();
+    for (const auto &slot : memInfo->GetRAMSlots()) {
+      writer.BeginObject();
+      reflect::WriteFields(writer, slot);
+      writer.EndObject();
+    }
+    writer.EndArray();
+
+    reflect::WriteFields<detail::kMemorySlotsPosition>(writer, *memInfo);
+    writer.EndObject();
+  } catch (...) {
+    writer.Restore(checkpoint);
+  }
+}
+
+template <typename Writer>
+static void AppendDiskIOInfo(Writer &writer, const nysys::DiskIOInfo &diskIO) {
+  writer.Key("io");
+  writer.BeginObject();
+  reflect::WriteFields(writer, diskIO);
+  writer.EndObject();
+}
+
+template <typename Writer>
+static void AppendStorageInfo(Writer &writer, const nysys::StorageList *storageList,
+                              const nysys::DiskIOList *diskIOList) noexcept {
+  if (!storageList) {
     return;
   }
 
+  const auto checkpoint = writer.Save();
   try {
-    const auto &adapters = networkList->GetAdapters();
-    nlohmann::json networkObj;
-    nlohmann::json ethernetArray = nlohmann::json::array();
-    nlohmann::json wifiArray = nlohmann::json::array();
-
-    for (const auto &adapter : adapters) {
-      nlohmann::json adapterObj;
-      adapterObj["name"] = adapter.GetName();
-      adapterObj["mac_address"] = adapter.GetMacAddress();
-      adapterObj["ip_address"] = adapter.GetIPAddress();
-      adapterObj["status"] = adapter.GetStatus();
-
-      if (adapter.IsEthernet()) {
-        ethernetArray.push_back(adapterObj);
-      } else if (adapter.IsWiFi()) {
-        wifiArray.push_back(adapterObj);
+    writer.Key("storage");
+    writer.BeginArray();
+
+    for (const auto &disk : storageList->GetDisks()) {
+      writer.BeginObject();
+      reflect::WriteFields<0, detail::kStorageIOPosition>(writer, disk);
+
+      if (diskIOList && disk.HasDiskIndex()) {
+        if (const auto *diskIO = diskIOList->FindByDiskIndex(disk.GetDiskIndex())) {
+          AppendDiskIOInfo(writer, *diskIO);
+        }
       }
+
+      reflect::WriteFields<detail::kStorageIOPosition>(writer, disk);
+      writer.EndObject();
     }
 
-    networkObj["ethernet"] = ethernetArray;
-    networkObj["wifi"] = wifiArray;
-    root["network"] = networkObj;
+    writer.EndArray();
   } catch (...) {
+    writer.Restore(checkpoint);
   }
 }
 
-static void AppendAudioInfo(nlohmann::json &root, const nysys::AudioList *audioList) noexcept {
+template <typename Writer>
+static void AppendNetworkTrafficInfo(Writer &writer, const nysys::NetworkTrafficInfo &traffic) {
+  writer.Key("traffic");
+  writer.BeginObject();
+  reflect::WriteFields(writer, traffic);
+  writer.EndObject();
+}
+
+template <typename Writer, typename Predicate>
+static void AppendAdapterArray(Writer &writer, std::string_view key, const nysys::NetworkList &networkList,
+                               const nysys::NetworkTrafficList *trafficList, Predicate predicate) {
+  writer.Key(key);
+  writer.BeginArray();
+
+  for (const auto &adapter : networkList.GetAdapters()) {
+    if (!predicate(adapter)) {
+      continue;
+    }
+
+    writer.BeginObject();
+    reflect::WriteFields(writer, adapter);
+
+    if (trafficList) {
+      if (const auto *traffic = trafficList->FindByInterfaceIndex(adapter.GetInterfaceIndex())) {
+        AppendNetworkTrafficInfo(writer, *traffic);
+      }
+    }
+    writer.EndObject();
+  }
+
+  writer.EndArray();
+}
+
+template <typename Writer>
+static void AppendNetworkInfo(Writer &writer, const nysys::NetworkList *networkList,
+                              const nysys::NetworkTrafficList *trafficList) noexcept {
+  if (!networkList) {
+    return;
+  }
+
+  const auto checkpoint = writer.Save();
+  try {
+    writer.Key("network");
+    writer.BeginObject();
+    AppendAdapterArray(writer, "ethernet", *networkList, trafficList,
+                       [](const nysys::NetworkAdapterInfo &adapter) { return adapter.IsEthernet(); });
+    AppendAdapterArray(writer, "wifi", *networkList, trafficList,
+                       [](const nysys::NetworkAdapterInfo &adapter) { return adapter.IsWiFi(); });
+    writer.EndObject();
+  } catch (...) {
+    writer.Restore(checkpoint);
+  }
+}
+
+template <typename Writer>
+static void AppendAudioInfo(Writer &writer, const nysys::AudioList *audioList) noexcept {
   if (!audioList) {
     return;
   }
 
+  const auto checkpoint = writer.Save();
   try {
-    const auto &devices = audioList->GetDevices();
-    nlohmann::json audioArray = nlohmann::json::array();
-
-    for (const auto &device : devices) {
-      nlohmann::json deviceObj;
-      deviceObj["name"] = device.GetName();
-      deviceObj["manufacturer"] = device.GetManufacturer();
-      audioArray.push_back(deviceObj);
+    writer.Key("audio");
+    writer.BeginArray();
+
+    for (const auto &device : audioList->GetDevices()) {
+      writer.BeginObject();
+      reflect::WriteFields(writer, device);
+      writer.EndObject();
     }
 
-    root["audio"] = audioArray;
+    writer.EndArray();
   } catch (...) {
+    writer.Restore(checkpoint);
   }
 }
 
-static void AppendBatteryInfo(nlohmann::json &root, const nysys::BatteryInfo *batteryInfo) noexcept {
+template <typename Writer>
+static void AppendBatteryInfo(Writer &writer, const nysys::BatteryInfo *batteryInfo) noexcept {
   if (!batteryInfo) {
     return;
   }
 
+  const auto checkpoint = writer.Save();
   try {
-    nlohmann::json batteryObj;
-    batteryObj["is_desktop"] = batteryInfo->IsDesktop();
-    batteryObj["percent"] = batteryInfo->GetPercent();
-    batteryObj["power_plugged"] = batteryInfo->IsPluggedIn();
-
-    root["battery"] = batteryObj;
+    writer.Key("battery");
+    writer.BeginObject();
+    reflect::WriteFields(writer, *batteryInfo);
+    writer.EndObject();
   } catch (...) {
+    writer.Restore(checkpoint);
   }
 }
 
-static void AppendMonitorInfo(nlohmann::json &root, const nysys::MonitorList *monitorList) noexcept {
+template <typename Writer>
+static void AppendMonitorInfo(Writer &writer, const nysys::MonitorList *monitorList) noexcept {
   if (!monitorList) {
     return;
   }
 
+  const auto checkpoint = writer.Save();
   try {
-    const auto &monitors = monitorList->GetMonitors();
-    nlohmann::json monitorArray = nlohmann::json::array();
-
-    for (const auto &monitor : monitors) {
-      nlohmann::json monitorObj;
-      monitorObj["is_primary"] = monitor.IsPrimary();
-      monitorObj["width"] = monitor.GetWidth();
-      monitorObj["height"] = monitor.GetHeight();
-      monitorObj["current_resolution"] = monitor.GetCurrentResolution();
-      monitorObj["native_resolution"] = monitor.GetNativeResolution();
-      monitorObj["aspect_ratio"] = monitor.GetAspectRatio();
-      monitorObj["refresh_rate"] = monitor.GetRefreshRate();
-      monitorObj["screen_size"] = monitor.GetScreenSize();
-      monitorObj["physical_width_mm"] = monitor.GetPhysicalWidthMm();
-      monitorObj["physical_height_mm"] = monitor.GetPhysicalHeightMm();
-      monitorObj["manufacturer"] = monitor.GetManufacturer();
-      monitorObj["device_id"] = monitor.GetDeviceId();
-      monitorArray.push_back(monitorObj);
+    writer.Key("monitors");
+    writer.BeginArray();
+
+    for (const auto &monitor : monitorList->GetMonitors()) {
+      writer.BeginObject();
+      reflect::WriteFields(writer, monitor);
+      writer.EndObject();
     }
 
-    root["monitors"] = monitorArray;
+    writer.EndArray();
+  } catch (...) {
+    writer.Restore(checkpoint);
+  }
+}
+
+template <typename Writer>
+static void AppendProcessArray(Writer &writer, std::string_view key,
+                               const std::vector<nysys::ProcessInfo> &processes) {
+  writer.Key(key);
+  writer.BeginArray();
+
+  for (const auto &process : processes) {
+    writer.BeginObject();
+    reflect::WriteFields(writer, process);
+    writer.EndObject();
+  }
+
+  writer.EndArray();
+}
+
+template <typename Writer>
+static void AppendProcessInfo(Writer &writer, const nysys::ProcessList *processList) noexcept {
+  if (!processList || !processList->IsInitialized()) {
+    return;
+  }
+
+  const auto checkpoint = writer.Save();
+  try {
+    writer.Key("processes");
+    writer.BeginObject();
+    reflect::WriteFields(writer, *processList);
+    AppendProcessArray(writer, "top_cpu", processList->GetTopByCpu());
+    AppendProcessArray(writer, "top_io", processList->GetTopByIo());
+    AppendProcessArray(writer, "top_memory", processList->GetTopByMemory());
+    writer.EndObject();
+  } catch (...) {
+    writer.Restore(checkpoint);
+  }
+}
+
+template <typename Writer>
+static void WriteSnapshot(Writer &writer, const nysys::GPUList *gpuList, const nysys::MotherboardInfo *mbInfo,
+                          const nysys::CPUList *cpuList, const nysys::MemoryInfo *memInfo,
+                          const nysys::StorageList *storageList, const nysys::NetworkList *networkList,
+                          const nysys::AudioList *audioList, const nysys::BatteryInfo *batteryInfo,
+                          const nysys::MonitorList *monitorList, const nysys::LiveInfo *liveInfo,
+                          units::UnitsMode unitsMode, std::optional<uint64_t> inventoryHash = std::nullopt) {
+  units::UnitWriter<Writer> presenter{writer, unitsMode};
+  const auto start = presenter.Save();
+  presenter.BeginObject();
+  const size_t bodyStart = presenter.Save().size;
+
+  AppendAudioInfo(presenter, audioList);
+  AppendBatteryInfo(presenter, batteryInfo);
+  AppendCpuInfo(presenter, cpuList);
+  if (liveInfo) {
+    AppendCpuFrequencyInfo(presenter, liveInfo->cpuFrequency.get());
+    AppendCpuUsageInfo(presenter, liveInfo->cpuUsage.get());
+  }
+  AppendGpuInfo(presenter, gpuList);
+  AppendInventoryHash(presenter, inventoryHash);
+  AppendMemoryInfo(presenter, memInfo);
+  AppendMonitorInfo(presenter, monitorList);
+  AppendMotherboardInfo(presenter, mbInfo);
+  AppendNetworkInfo(presenter, networkList, liveInfo ? liveInfo->networkTraffic.get() : nullptr);
+  if (liveInfo) {
+    AppendProcessInfo(presenter, liveInfo->processList.get());
+  }
+  AppendStorageInfo(presenter, storageList, liveInfo ? liveInfo->diskIO.get() : nullptr);
+
+  if (presenter.Save().size == bodyStart) {
+    presenter.Restore(start);
+    presenter.Null();
+  } else {
+    presenter.EndObject();
+  }
+}
+
+bool WriteSystemInfo(JsonWriter &writer, const nysys::GPUList *gpuList, const nysys::MotherboardInfo *mbInfo,
+                     const nysys::CPUList *cpuList, const nysys::MemoryInfo *memInfo,
+                     const nysys::StorageList *storageList, const nysys::NetworkList *networkList,
+                     const nysys::AudioList *audioList, const nysys::BatteryInfo *batteryInfo,
+                     const nysys::MonitorList *monitorList, const nysys::LiveInfo *liveInfo,
+                     const JsonConfig &config) noexcept {
+  try {
+    writer.Reset(config.prettyPrint, config.indentSize);
+    WriteSnapshot(writer, gpuList, mbInfo, cpuList, memInfo, storageList, networkList, audioList, batteryInfo,
+                  monitorList, liveInfo, config.unitsMode);
+    return writer.IsValid();
+  } catch (...) {
+    return false;
+  }
+}
+
+bool WriteSystemInfo(BinaryWriter &writer, BinaryFormat format, const nysys::GPUList *gpuList,
+                     const nysys::MotherboardInfo *mbInfo, const nysys::CPUList *cpuList,
+                     const nysys::MemoryInfo *memInfo, const nysys::StorageList *storageList,
+                     const nysys::NetworkList *networkList, const nysys::AudioList *audioList,
+                     const nysys::BatteryInfo *batteryInfo, const nysys::MonitorList *monitorList,
+                     const nysys::LiveInfo *liveInfo, units::UnitsMode unitsMode) noexcept {
+  try {
+    writer.Reset(format);
+    WriteSnapshot(writer, gpuList, mbInfo, cpuList, memInfo, storageList, networkList, audioList, batteryInfo,
+                  monitorList, liveInfo, unitsMode);
+    return writer.IsValid();
+  } catch (...) {
+    return false;
+  }
+}
+
+bool WriteSystemInfo(SnapshotTree &tree, const nysys::GPUList *gpuList, const nysys::MotherboardInfo *mbInfo,
+                     const nysys::CPUList *cpuList, const nysys::MemoryInfo *memInfo,
+                     const nysys::StorageList *storageList, const nysys::NetworkList *networkList,
+                     const nysys::AudioList *audioList, const nysys::BatteryInfo *batteryInfo,
+                     const nysys::MonitorList *monitorList, const nysys::LiveInfo *liveInfo,
+                     units::UnitsMode unitsMode, std::optional<uint64_t> inventoryHash) noexcept {
+  try {
+    tree.Reset();
+    WriteSnapshot(tree, gpuList, mbInfo, cpuList, memInfo, storageList, networkList, audioList, batteryInfo,
+                  monitorList, liveInfo, unitsMode, inventoryHash);
+    return tree.IsValid();
+  } catch (...) {
+    return false;
+  }
+}
+
+bool WriteSystemInfo(JsonWriter &writer, const SnapshotTree &tree, const JsonConfig &config) noexcept {
+  try {
+    writer.Reset(config.prettyPrint, config.indentSize);
+    WriteSnapshotTree(writer, tree);
+    return writer.IsValid();
+  } catch (...) {
+    return false;
+  }
+}
+
+bool WriteSystemInfo(BinaryWriter &writer, BinaryFormat format, const SnapshotTree &tree) noexcept {
+  try {
+    writer.Reset(format);
+    WriteSnapshotTree(writer, tree);
+    return writer.IsValid();
+  } catch (...) {
+    return false;
+  }
+}
+
+uint64_t ComputeInventoryHash(const nysys::GPUList *gpuList, const nysys::MotherboardInfo *mbInfo,
+                              const nysys::CPUList *cpuList, const nysys::AudioList *audioList,
+                              const nysys::MonitorList *monitorList) noexcept {
+  try {
+    uint64_t hash = reflect::detail::kFnvOffsetBasis;
+    hash = gpuList ? detail::HashItems(hash, gpuList->GetGPUs()) : hash;
+    hash = mbInfo ? reflect::HashFields(*mbInfo, hash) : hash;
+    hash = cpuList ? detail::HashItems(hash, cpuList->GetCPUs()) : hash;
+    hash = audioList ? detail::HashItems(hash, audioList->GetDevices()) : hash;
+    return monitorList ? detail::HashItems(hash, monitorList->GetMonitors()) : hash;
+  } catch (...) {
+    return 0;
+  }
+}
+
+bool WriteInventory(JsonWriter &writer, const nysys::GPUList *gpuList, const nysys::MotherboardInfo *mbInfo,
+                    const nysys::CPUList *cpuList, const nysys::AudioList *audioList,
+                    const nysys::MonitorList *monitorList, uint64_t inventoryHash, const JsonConfig &config) noexcept {
+  try {
+    writer.Reset(config.prettyPrint, config.indentSize);
+    WriteSnapshot(writer, gpuList, mbInfo, cpuList, nullptr, nullptr, nullptr, audioList, nullptr, monitorList,
+                  nullptr, config.unitsMode, inventoryHash);
+    return writer.IsValid();
+  } catch (...) {
+    return false;
+  }
+}
+
+bool WriteInventory(BinaryWriter &writer, BinaryFormat format, const nysys::GPUList *gpuList,
+                    const nysys::MotherboardInfo *mbInfo, const nysys::CPUList *cpuList,
+                    const nysys::AudioList *audioList, const nysys::MonitorList *monitorList, uint64_t inventoryHash,
+                    units::UnitsMode unitsMode) noexcept {
+  try {
+    writer.Reset(format);
+    WriteSnapshot(writer, gpuList, mbInfo, cpuList, nullptr, nullptr, nullptr, audioList, nullptr, monitorList,
+                  nullptr, unitsMode, inventoryHash);
+    return writer.IsValid();
+  } catch (...) {
+    return false;
+  }
+}
+
+bool WriteTelemetry(JsonWriter &writer, const nysys::MemoryInfo *memInfo, const nysys::StorageList *storageList,
+                    const nysys::NetworkList *networkList, const nysys::BatteryInfo *batteryInfo,
+                    const nysys::LiveInfo *liveInfo, uint64_t inventoryHash, const JsonConfig &config) noexcept {
+  try {
+    writer.Reset(config.prettyPrint, config.indentSize);
+    WriteSnapshot(writer, nullptr, nullptr, nullptr, memInfo, storageList, networkList, nullptr, batteryInfo, nullptr,
+                  liveInfo, config.unitsMode, inventoryHash);
+    return writer.IsValid();
+  } catch (...) {
+    return false;
+  }
+}
+
+bool WriteTelemetry(BinaryWriter &writer, BinaryFormat format, const nysys::MemoryInfo *memInfo,
+                    const nysys::StorageList *storageList, const nysys::NetworkList *networkList,
+                    const nysys::BatteryInfo *batteryInfo, const nysys::LiveInfo *liveInfo, uint64_t inventoryHash,
+                    units::UnitsMode unitsMode) noexcept {
+  try {
+    writer.Reset(format);
+    WriteSnapshot(writer, nullptr, nullptr, nullptr, memInfo, storageList, networkList, nullptr, batteryInfo, nullptr,
+                  liveInfo, unitsMode, inventoryHash);
+    return writer.IsValid();
+  } catch (...) {
+    return false;
+  }
+}
+
+template <typename Writer>
+static void WriteDelta(Writer &writer, const SnapshotTree &previous, const SnapshotTree &current, bool keyframe,
+                       uint64_t sequence) {
+  writer.BeginObject();
+  writer.Key("data");
+  if (keyframe) {
+    WriteSnapshotTree(writer, current);
+  } else {
+    WriteMergePatch(writer, previous, current);
+  }
+  writer.Field("keyframe", keyframe);
+  writer.Field("sequence", sequence);
+  writer.EndObject();
+}
+
+bool WriteSystemDelta(JsonWriter &writer, const SnapshotTree &previous, const SnapshotTree &current, bool keyframe,
+                      uint64_t sequence, const JsonConfig &config) noexcept {
+  try {
+    writer.Reset(config.prettyPrint, config.indentSize);
+    WriteDelta(writer, previous, current, keyframe, sequence);
+    return writer.IsValid();
+  } catch (...) {
+    return false;
+  }
+}
+
+bool WriteSystemDelta(BinaryWriter &writer, BinaryFormat format, const SnapshotTree &previous,
+                      const SnapshotTree &current, bool keyframe, uint64_t sequence) noexcept {
+  try {
+    writer.Reset(format);
+    WriteDelta(writer, previous, current, keyframe, sequence);
+    return writer.IsValid();
   } catch (...) {
+    return false;
   }
 }
 
@@ -263,25 +611,15 @@ std::optional<std::string> GenerateSystemInfo(const nysys::GPUList *gpuList, con
                                               const nysys::NetworkList *networkList, const nysys::AudioList *audioList,
                                               const nysys::BatteryInfo *batteryInfo,
                                               const nysys::MonitorList *monitorList,
+                                              const nysys::LiveInfo *liveInfo,
                                               const JsonConfig &config) noexcept {
   try {
-    nlohmann::json root;
-
-    AppendGpuInfo(root, gpuList);
-    AppendMotherboardInfo(root, mbInfo);
-    AppendCpuInfo(root, cpuList);
-    AppendMemoryInfo(root, memInfo);
-    AppendStorageInfo(root, storageList);
-    AppendNetworkInfo(root, networkList);
-    AppendAudioInfo(root, audioList);
-    AppendBatteryInfo(root, batteryInfo);
-    AppendMonitorInfo(root, monitorList);
-
-    if (config.prettyPrint) {
-      return root.dump(config.indentSize);
-    } else {
-      return root.dump();
+    JsonWriter writer;
+    if (!WriteSystemInfo(writer, gpuList, mbInfo, cpuList, memInfo, storageList, networkList, audioList, batteryInfo,
+                         monitorList, liveInfo, config)) {
+      return std::nullopt;
     }
+    return writer.GetBuffer();
   } catch (...) {
     return std::nullopt;
   }
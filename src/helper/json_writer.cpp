@@ -0,0 +1,385 @@
+#include "helper/json_writer.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define JSON_WRITER_SSE2 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace json {
+namespace detail {
+
+constexpr char kHexDigits[] = "0123456789abcdef";
+constexpr size_t kSimdWidth = 16;
+
+[[nodiscard]] inline bool NeedsEscapeCheck(unsigned char c) noexcept {
+  return c < 0x20 || c >= 0x80 || c == '"' || c == '\\';
+}
+
+#ifdef JSON_WRITER_SSE2
+[[nodiscard]] inline size_t CountTrailingZeros(unsigned int mask) noexcept {
+#if defined(_MSC_VER)
+  unsigned long index = 0;
+  _BitScanForward(&index, mask);
+  return index;
+#else
+  return static_cast<size_t>(__builtin_ctz(mask));
+#endif
+}
+#endif
+
+[[nodiscard]] size_t FindEscapeCandidate(const char *data, size_t size) noexcept {
+  size_t i = 0;
+
+#ifdef JSON_WRITER_SSE2
+  const __m128i space = _mm_set1_epi8(0x20);
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+
+  for (; i + kSimdWidth <= size; i += kSimdWidth) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    const __m128i control = _mm_cmplt_epi8(chunk, space);
+    const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+    const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_or_si128(control, special)));
+    if (mask != 0) {
+      return i + CountTrailingZeros(mask);
+    }
+  }
+#endif
+
+  for (; i < size; ++i) {
+    if (NeedsEscapeCheck(static_cast<unsigned char>(data[i]))) {
+      return i;
+    }
+  }
+  return size;
+}
+
+[[nodiscard]] size_t ValidUtf8SequenceLength(const unsigned char *data, size_t remaining) noexcept {
+  const unsigned char lead = data[0];
+  unsigned char low = 0x80;
+  unsigned char high = 0xBF;
+  size_t length = 0;
+
+  if (lead >= 0xC2 && lead <= 0xDF) {
+    length = 2;
+  } else if (lead >= 0xE0 && lead <= 0xEF) {
+    length = 3;
+    if (lead == 0xE0) {
+      low = 0xA0;
+    } else if (lead == 0xED) {
+      high = 0x9F;
+    }
+  } else if (lead >= 0xF0 && lead <= 0xF4) {
+    length = 4;
+    if (lead == 0xF0) {
+      low = 0x90;
+    } else if (lead == 0xF4) {
+      high = 0x8F;
+    }
+  } else {
+    return 0;
+  }
+
+  if (remaining < length || data[1] < low || data[1] > high) {
+    return 0;
+  }
+
+  for (size_t i = 2; i < length; ++i) {
+    if (data[i] < 0x80 || data[i] > 0xBF) {
+      return 0;
+    }
+  }
+  return length;
+}
+}  // namespace detail
+
+bool IsValidUtf8(std::string_view value) noexcept {
+  const auto *data = reinterpret_cast<const unsigned char *>(value.data());
+  const size_t size = value.size();
+  size_t position = 0;
+
+  while (position < size) {
+    if (data[position] < 0x80) {
+      ++position;
+      continue;
+    }
+
+    const size_t length = detail::ValidUtf8SequenceLength(data + position, size - position);
+    if (length == 0) {
+      return false;
+    }
+    position += length;
+  }
+  return true;
+}
+
+JsonWriter::JsonWriter() { m_buffer.reserve(detail::kInitialWriterCapacity); }
+
+void JsonWriter::Reset(bool prettyPrint, int indentSize) noexcept {
+  m_buffer.clear();
+  m_hasElements.fill(false);
+  m_depth = 0;
+  m_indentSize = std::max(indentSize, 0);
+  m_prettyPrint = prettyPrint;
+  m_afterKey = false;
+  m_valid = true;
+}
+
+void JsonWriter::BeforeValue() {
+  if (m_afterKey) {
+    m_afterKey = false;
+    return;
+  }
+
+  if (m_depth == 0) {
+    return;
+  }
+
+  if (m_hasElements[m_depth]) {
+    m_buffer.push_back(',');
+  }
+  if (m_prettyPrint) {
+    m_buffer.push_back('\n');
+    WriteIndent(m_depth);
+  }
+  m_hasElements[m_depth] = true;
+}
+
+void JsonWriter::WriteIndent(size_t depth) { m_buffer.append(depth * static_cast<size_t>(m_indentSize), ' '); }
+
+void JsonWriter::PushContainer(char open) {
+  if (m_depth + 1 >= detail::kMaxWriterDepth) {
+    throw std::length_error("JSON nesting depth exceeded");
+  }
+
+  BeforeValue();
+  m_buffer.push_back(open);
+  ++m_depth;
+  m_hasElements[m_depth] = false;
+}
+
+void JsonWriter::PopContainer(char close) {
+  if (m_depth == 0) {
+    throw std::logic_error("JSON container underflow");
+  }
+
+  if (m_prettyPrint && m_hasElements[m_depth]) {
+    m_buffer.push_back('\n');
+    WriteIndent(m_depth - 1);
+  }
+  m_buffer.push_back(close);
+  --m_depth;
+}
+
+void JsonWriter::BeginObject() { PushContainer('{'); }
+
+void JsonWriter::EndObject() { PopContainer('}'); }
+
+void JsonWriter::BeginArray() { PushContainer('['); }
+
+void JsonWriter::EndArray() { PopContainer(']'); }
+
+void JsonWriter::Key(std::string_view key) {
+  BeforeValue();
+  WriteString(key);
+  m_buffer.push_back(':');
+  if (m_prettyPrint) {
+    m_buffer.push_back(' ');
+  }
+  m_afterKey = true;
+}
+
+void JsonWriter::WriteString(std::string_view value) {
+  m_buffer.push_back('"');
+
+  const char *data = value.data();
+  const size_t size = value.size();
+  size_t position = 0;
+
+  while (position < size) {
+    const size_t run = detail::FindEscapeCandidate(data + position, size - position);
+    m_buffer.append(data + position, run);
+    position += run;
+    if (position >= size) {
+      break;
+    }
+
+    const auto c = static_cast<unsigned char>(data[position]);
+    if (c >= 0x80) {
+      const size_t length =
+          detail::ValidUtf8SequenceLength(reinterpret_cast<const unsigned char *>(data + position), size - position);
+      if (length == 0) {
+        m_valid = false;
+        break;
+      }
+      m_buffer.append(data + position, length);
+      position += length;
+      continue;
+    }
+
+    switch (c) {
+      case '"':
+        m_buffer.append("\\\"", 2);
+        break;
+      case '\\':
+        m_buffer.append("\\\\", 2);
+        break;
+      case '\b':
+        m_buffer.append("\\b", 2);
+        break;
+      case '\f':
+        m_buffer.append("\\f", 2);
+        break;
+      case '\n':
+        m_buffer.append("\\n", 2);
+        break;
+      case '\r':
+        m_buffer.append("\\r", 2);
+        break;
+      case '\t':
+        m_buffer.append("\\t", 2);
+        break;
+      default: {
+        const char escaped[6] = {'\\', 'u', '0', '0', detail::kHexDigits[c >> 4], detail::kHexDigits[c & 0x0F]};
+        m_buffer.append(escaped, sizeof(escaped));
+        break;
+      }
+    }
+    ++position;
+  }
+
+  m_buffer.push_back('"');
+}
+
+void JsonWriter::Value(std::string_view value) {
+  BeforeValue();
+  WriteString(value);
+}
+
+void JsonWriter::Value(bool value) {
+  BeforeValue();
+  if (value) {
+    m_buffer.append("true", 4);
+  } else {
+    m_buffer.append("false", 5);
+  }
+}
+
+void JsonWriter::Null() {
+  BeforeValue();
+  m_buffer.append("null", 4);
+}
+
+void JsonWriter::WriteInteger(int64_t value) {
+  BeforeValue();
+  char digits[24];
+  const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  m_buffer.append(digits, static_cast<size_t>(result.ptr - digits));
+}
+
+void JsonWriter::WriteUnsigned(uint64_t value) {
+  BeforeValue();
+  char digits[24];
+  const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  m_buffer.append(digits, static_cast<size_t>(result.ptr - digits));
+}
+
+void JsonWriter::Value(double value) {
+  BeforeValue();
+
+  if (!std::isfinite(value)) {
+    m_buffer.append("null", 4);
+    return;
+  }
+
+  char scientific[32];
+  const auto result = std::to_chars(scientific, scientific + sizeof(scientific), value, std::chars_format::scientific);
+  const char *cursor = scientific;
+  const char *const end = result.ptr;
+
+  if (*cursor == '-') {
+    m_buffer.push_back('-');
+    ++cursor;
+  }
+
+  char digits[20];
+  int digitCount = 0;
+  for (; cursor < end && *cursor != 'e'; ++cursor) {
+    if (*cursor != '.') {
+      digits[digitCount++] = *cursor;
+    }
+  }
+
+  ++cursor;
+  const bool negativeExponent = *cursor == '-';
+  ++cursor;
+  int exponent = 0;
+  std::from_chars(cursor, end, exponent);
+  if (negativeExponent) {
+    exponent = -exponent;
+  }
+
+  const int k = digitCount;
+  const int n = exponent + 1;
+
+  if (k <= n && n <= detail::kMaxDecimalExponent) {
+    m_buffer.append(digits, static_cast<size_t>(k));
+    m_buffer.append(static_cast<size_t>(n - k), '0');
+    m_buffer.append(".0", 2);
+  } else if (0 < n && n <= detail::kMaxDecimalExponent) {
+    m_buffer.append(digits, static_cast<size_t>(n));
+    m_buffer.push_back('.');
+    m_buffer.append(digits + n, static_cast<size_t>(k - n));
+  } else if (detail::kMinDecimalExponent < n && n <= 0) {
+    m_buffer.append("0.", 2);
+    m_buffer.append(static_cast<size_t>(-n), '0');
+    m_buffer.append(digits, static_cast<size_t>(k));
+  } else {
+    m_buffer.push_back(digits[0]);
+    if (k > 1) {
+      m_buffer.push_back('.');
+      m_buffer.append(digits + 1, static_cast<size_t>(k - 1));
+    }
+
+    int decimalExponent = n - 1;
+    m_buffer.push_back('e');
+    m_buffer.push_back(decimalExponent < 0 ? '-' : '+');
+    decimalExponent = std::abs(decimalExponent);
+    if (decimalExponent < 10) {
+      m_buffer.push_back('0');
+    }
+
+    char exponentDigits[8];
+    const auto exponentResult = std::to_chars(exponentDigits, exponentDigits + sizeof(exponentDigits), decimalExponent);
+    m_buffer.append(exponentDigits, static_cast<size_t>(exponentResult.ptr - exponentDigits));
+  }
+}
+
+JsonWriter::Checkpoint JsonWriter::Save() const noexcept {
+  return Checkpoint{m_buffer.size(), m_depth, m_hasElements[m_depth], m_afterKey};
+}
+
+void JsonWriter::Restore(const Checkpoint &checkpoint) noexcept {
+  if (checkpoint.size <= m_buffer.size()) {
+    m_buffer.resize(checkpoint.size);
+  }
+  m_depth = checkpoint.depth;
+  m_hasElements[m_depth] = checkpoint.hasElements;
+  m_afterKey = checkpoint.afterKey;
+}
+
+const std::string &JsonWriter::GetBuffer() const noexcept { return m_buffer; }
+
+std::string_view JsonWriter::GetOutput() const noexcept { return m_buffer; }
+
+bool JsonWriter::IsValid() const noexcept { return m_valid && m_depth == 0 && !m_afterKey; }
+
+}  // namespace json
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "helper/nt_helper.hpp"
+
+namespace nt {
+namespace {
+
+using NtQuerySystemInformationFn = LONG(NTAPI *)(ULONG, PVOID, ULONG, PULONG);
+using NtQuerySystemInformationExFn = LONG(NTAPI *)(ULONG, PVOID, ULONG, PVOID, ULONG, PULONG);
+
+struct NtFunctions {
+  NtQuerySystemInformationFn querySystemInformation = nullptr;
+  NtQuerySystemInformationExFn querySystemInformationEx = nullptr;
+
+  NtFunctions() noexcept {
+    HMODULE ntdll = GetModuleHandleW(L"ntdll.dll");
+    if (!ntdll) {
+      return;
+    }
+
+    querySystemInformation =
+        reinterpret_cast<NtQuerySystemInformationFn>(GetProcAddress(ntdll, "NtQuerySystemInformation"));
+    querySystemInformationEx =
+        reinterpret_cast<NtQuerySystemInformationExFn>(GetProcAddress(ntdll, "NtQuerySystemInformationEx"));
+  }
+};
+
+const NtFunctions &GetNtFunctions() noexcept {
+  static const NtFunctions functions;
+  return functions;
+}
+}  // namespace
+
+NtStatus QuerySystemInformation(ULONG infoClass, void *buffer, ULONG bufferSize, ULONG *returnLength) noexcept {
+  const auto &functions = GetNtFunctions();
+  if (!functions.querySystemInformation) {
+    return kStatusProcedureNotFound;
+  }
+  return functions.querySystemInformation(infoClass, buffer, bufferSize, returnLength);
+}
+
+NtStatus QuerySystemInformationEx(ULONG infoClass, void *input, ULONG inputSize, void *buffer, ULONG bufferSize,
+                                  ULONG *returnLength) noexcept {
+  const auto &functions = GetNtFunctions();
+  if (!functions.querySystemInformationEx) {
+    return kStatusProcedureNotFound;
+  }
+  return functions.querySystemInformationEx(infoClass, input, inputSize, buffer, bufferSize, returnLength);
+}
+
+bool HasQuerySystemInformationEx() noexcept { return GetNtFunctions().querySystemInformationEx != nullptr; }
+
+}  // namespace nt
\ No newline at end of file
@@ -0,0 +1,550 @@
+#include "helper/pipe_server.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+namespace net {
+namespace detail {
+
+constexpr ULONG_PTR kWakeKey = 1;
+constexpr DWORD kCloseDrainMs = 5000;
+
+void AppendLittleEndian(std::string &output, uint64_t value, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    output.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+[[nodiscard]] uint64_t ReadLittleEndian(std::string_view input, size_t size) noexcept {
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; ++i) {
+    value |= static_cast<uint64_t>(static_cast<uint8_t>(input[i])) << (8 * i);
+  }
+  return value;
+}
+
+void AppendFrameHeader(std::string &output, FrameType type, size_t bodySize) {
+  AppendLittleEndian(output, bodySize, 4);
+  output.push_back(static_cast<char>(type));
+}
+
+[[nodiscard]] std::vector<std::string> SplitPaths(std::string_view text) {
+  std::vector<std::string> paths;
+  while (!text.empty()) {
+    const size_t end = std::min(text.find('\n'), text.size());
+    auto path = text.substr(0, end);
+    if (!path.empty() && path.back() == '\r') {
+      path.remove_suffix(1);
+    }
+    if (!path.empty()) {
+      paths.emplace_back(path);
+    }
+    text.remove_prefix(std::min(end + 1, text.size()));
+  }
+  std::sort(paths.begin(), paths.end());
+  paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+  return paths;
+}
+}  // namespace detail
+
+PipeServer::~PipeServer() { Close(); }
+
+PipeError PipeServer::Open(const PipeOptions &options) noexcept {
+  if (options.name.empty() || options.name.size() > detail::kMaxPipeNameLength) {
+    return PipeError::InvalidName;
+  }
+  if (options.maxClients == 0 || options.maxClients > detail::kMaxPipeClients) {
+    return PipeError::InvalidOptions;
+  }
+  Close();
+
+  try {
+    m_name = options.name;
+    m_clients.reserve(options.maxClients + detail::kListeningPipeInstances);
+  } catch (...) {
+    return PipeError::MemoryAllocationFailed;
+  }
+
+  m_port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+  if (!m_port) {
+    return PipeError::CreateFailed;
+  }
+  m_maxClients = options.maxClients;
+  m_firstInstance = true;
+
+  ListenForClients();
+  if (m_clients.empty()) {
+    Close();
+    return PipeError::CreateFailed;
+  }
+  return PipeError::Success;
+}
+
+void PipeServer::Close() noexcept {
+  m_maxClients = 0;
+  for (auto &client : m_clients) {
+    CloseClient(*client);
+  }
+
+  // Every operation still in flight completes with an abort status; the buffers it references must outlive that.
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{detail::kCloseDrainMs};
+  while (m_port && std::chrono::steady_clock::now() < deadline &&
+         std::any_of(m_clients.begin(), m_clients.end(), [](const auto &client) { return client->pending > 0; })) {
+    Poll(detail::kPipePollTimeoutMs / 10);
+  }
+  if (std::any_of(m_clients.begin(), m_clients.end(), [](const auto &client) { return client->pending > 0; })) {
+    for (auto &client : m_clients) {
+      client.release();
+    }
+  }
+  m_clients.clear();
+  m_filters.clear();
+
+  if (m_port) {
+    CloseHandle(m_port);
+    m_port = nullptr;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    m_latest.reset();
+  }
+  m_current.reset();
+  m_clientCount = 0;
+  m_filterCount = 0;
+}
+
+bool PipeServer::IsOpen() const noexcept { return m_port != nullptr && m_maxClients > 0; }
+
+bool PipeServer::HasSubscribers() const noexcept { return m_filterCount > 0; }
+
+bool PipeServer::Publish(std::shared_ptr<const json::SnapshotTree> tree, int64_t timestampMs) noexcept {
+  try {
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->tree = std::move(tree);
+    snapshot->version = ++m_publishedCount;
+    snapshot->timestamp = timestampMs;
+    {
+      std::lock_guard<std::mutex> lock(m_snapshotMutex);
+      if (!m_latest || m_latest->version < snapshot->version) {
+        m_latest = std::move(snapshot);
+      }
+    }
+    Wake();
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+
+void PipeServer::Wake() noexcept {
+  if (m_port) {
+    PostQueuedCompletionStatus(m_port, 0, detail::kWakeKey, nullptr);
+  }
+}
+
+void PipeServer::Poll(DWORD timeoutMs) noexcept {
+  if (!m_port) {
+    return;
+  }
+
+  std::array<OVERLAPPED_ENTRY, detail::kCompletionBatchSize> entries{};
+  ULONG count = 0;
+  if (GetQueuedCompletionStatusEx(m_port, entries.data(), static_cast<ULONG>(entries.size()), &count, timeoutMs,
+                                  FALSE)) {
+    for (ULONG i = 0; i < count; ++i) {
+      const auto &entry = entries[i];
+      if (!entry.lpOverlapped) {
+        continue;
+      }
+      auto &operation = *reinterpret_cast<Operation *>(entry.lpOverlapped);
+      OnCompletion(operation, entry.lpOverlapped->Internal == 0, entry.dwNumberOfBytesTransferred);
+    }
+  }
+
+  DeliverLatest();
+  ReleaseClients();
+  ListenForClients();
+}
+
+PipeStats PipeServer::GetStats() const noexcept {
+  PipeStats stats;
+  stats.clientCount = m_clientCount;
+  stats.filterCount = m_filterCount;
+  stats.publishedCount = m_publishedCount;
+  stats.encodedCount = m_encodedCount;
+  stats.sentCount = m_sentCount;
+  stats.skippedCount = m_skippedCount;
+  return stats;
+}
+
+void PipeServer::ListenForClients() noexcept {
+  if (!m_port || m_maxClients == 0) {
+    return;
+  }
+
+  size_t listening = 0;
+  size_t connected = 0;
+  for (const auto &client : m_clients) {
+    if (!client->closing) {
+      ++(client->connected ? connected : listening);
+    }
+  }
+
+  while (listening < detail::kListeningPipeInstances && connected + listening < m_maxClients) {
+    std::unique_ptr<Client> client;
+    try {
+      client = std::make_unique<Client>();
+    } catch (...) {
+      return;
+    }
+
+    const DWORD openMode =
+        PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED | (m_firstInstance ? FILE_FLAG_FIRST_PIPE_INSTANCE : 0);
+    const DWORD pipeMode = PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS;
+    client->pipe = CreateNamedPipeA(m_name.c_str(), openMode, pipeMode,
+                                    static_cast<DWORD>(m_maxClients + detail::kListeningPipeInstances),
+                                    detail::kPipeBufferSize, detail::kPipeBufferSize, 0, nullptr);
+    if (client->pipe == INVALID_HANDLE_VALUE) {
+      return;
+    }
+    if (!CreateIoCompletionPort(client->pipe, m_port, 0, 0)) {
+      CloseHandle(client->pipe);
+      return;
+    }
+    m_firstInstance = false;
+
+    client->connect.client = client.get();
+    client->connect.kind = OperationKind::Connect;
+    client->read.client = client.get();
+    client->read.kind = OperationKind::Read;
+    client->write.client = client.get();
+    client->write.kind = OperationKind::Write;
+
+    auto &instance = *client;
+    m_clients.push_back(std::move(client));
+    ++listening;
+
+    if (ConnectNamedPipe(instance.pipe, &instance.connect.overlapped)) {
+      ++instance.pending;
+      continue;
+    }
+    const DWORD error = ::GetLastError();
+    if (error == ERROR_IO_PENDING) {
+      ++instance.pending;
+    } else if (error == ERROR_PIPE_CONNECTED) {
+      --listening;
+      ++connected;
+      instance.connected = true;
+      ++m_clientCount;
+      StartRead(instance);
+    } else {
+      --listening;
+      CloseClient(instance);
+    }
+  }
+}
+
+void PipeServer::OnCompletion(Operation &operation, bool success, DWORD bytes) noexcept {
+  auto &client = *operation.client;
+  --client.pending;
+  if (client.closing) {
+    return;
+  }
+
+  switch (operation.kind) {
+    case OperationKind::Connect:
+      if (!success) {
+        CloseClient(client);
+        return;
+      }
+      client.connected = true;
+      ++m_clientCount;
+      StartRead(client);
+      break;
+    case OperationKind::Read:
+      if (!success || bytes == 0) {
+        CloseClient(client);
+        return;
+      }
+      try {
+        client.incoming.append(client.buffer.data(), bytes);
+      } catch (...) {
+        CloseClient(client);
+        return;
+      }
+      ProcessFrames(client);
+      StartRead(client);
+      break;
+    case OperationKind::Write:
+      client.writing.reset();
+      if (!success) {
+        CloseClient(client);
+        return;
+      }
+      ++m_sentCount;
+      StartWrite(client);
+      break;
+  }
+}
+
+void PipeServer::StartRead(Client &client) noexcept {
+  if (client.closing) {
+    return;
+  }
+  client.read.overlapped = OVERLAPPED{};
+  if (!ReadFile(client.pipe, client.buffer.data(), static_cast<DWORD>(client.buffer.size()), nullptr,
+                &client.read.overlapped) &&
+      ::GetLastError() != ERROR_IO_PENDING) {
+    CloseClient(client);
+    return;
+  }
+  ++client.pending;
+}
+
+void PipeServer::StartWrite(Client &client) noexcept {
+  if (client.closing || client.writing) {
+    return;
+  }
+  auto &next = client.queuedError ? client.queuedError : client.queuedSnapshot;
+  if (!next) {
+    return;
+  }
+  client.writing = std::move(next);
+  next.reset();
+
+  client.write.overlapped = OVERLAPPED{};
+  if (!WriteFile(client.pipe, client.writing->data(), static_cast<DWORD>(client.writing->size()), nullptr,
+                 &client.write.overlapped) &&
+      ::GetLastError() != ERROR_IO_PENDING) {
+    client.writing.reset();
+    CloseClient(client);
+    return;
+  }
+  ++client.pending;
+}
+
+void PipeServer::ProcessFrames(Client &client) noexcept {
+  size_t offset = 0;
+  while (!client.closing && client.incoming.size() - offset >= detail::kFrameHeaderSize) {
+    const std::string_view pending(client.incoming.data() + offset, client.incoming.size() - offset);
+    const size_t length = static_cast<size_t>(detail::ReadLittleEndian(pending, 4));
+    if (length > detail::kMaxSubscribeBytes) {
+      CloseClient(client);
+      return;
+    }
+    if (pending.size() < detail::kFrameHeaderSize + length) {
+      break;
+    }
+
+    const auto type = static_cast<FrameType>(pending[4]);
+    const auto body = pending.substr(detail::kFrameHeaderSize, length);
+    if (type == FrameType::Subscribe) {
+      Subscribe(client, body);
+    } else {
+      SendError(client, SubscribeError::UnknownFrame);
+    }
+    offset += detail::kFrameHeaderSize + length;
+  }
+  client.incoming.erase(0, offset);
+}
+
+void PipeServer::Subscribe(Client &client, std::string_view body) noexcept {
+  if (body.size() < 5) {
+    SendError(client, SubscribeError::MalformedFrame);
+    return;
+  }
+  const auto format = static_cast<uint8_t>(body[0]);
+  const auto interval = static_cast<uint32_t>(detail::ReadLittleEndian(body.substr(1), 4));
+  if (format > 2) {
+    SendError(client, SubscribeError::InvalidFormat);
+    return;
+  }
+  if (interval > detail::kMaxSubscribeIntervalMs) {
+    SendError(client, SubscribeError::InvalidInterval);
+    return;
+  }
+
+  try {
+    const auto paths = detail::SplitPaths(body.substr(5));
+    std::string signature(1, static_cast<char>(format));
+    for (const auto &path : paths) {
+      signature.append(path).push_back('\n');
+    }
+
+    auto found = std::find_if(m_filters.begin(), m_filters.end(),
+                              [&signature](const auto &filter) { return filter->signature == signature; });
+    Filter *selected = found != m_filters.end() ? found->get() : nullptr;
+    if (!selected) {
+      auto created = std::make_unique<Filter>();
+      if (!paths.empty() && created->projection.SetPaths(paths) != filter::ProjectionError::Success) {
+        SendError(client, SubscribeError::InvalidPath);
+        return;
+      }
+      created->signature = std::move(signature);
+      created->format = format;
+      created->projected = !paths.empty();
+      selected = created.get();
+      m_filters.push_back(std::move(created));
+    }
+
+    ++selected->subscribers;
+    Detach(client);
+    client.filter = selected;
+    client.minIntervalMs = interval;
+    client.hasSent = false;
+    m_filterCount = m_filters.size();
+  } catch (...) {
+    CloseClient(client);
+    return;
+  }
+
+  if (m_current) {
+    Deliver(client, *m_current);
+  }
+}
+
+void PipeServer::SendError(Client &client, SubscribeError error) noexcept {
+  try {
+    const auto message = ToString(error);
+    std::string frame;
+    detail::AppendFrameHeader(frame, FrameType::Error, message.size() + 1);
+    frame.push_back(static_cast<char>(error));
+    frame.append(message);
+    client.queuedError = std::make_shared<const std::string>(std::move(frame));
+    StartWrite(client);
+  } catch (...) {
+    CloseClient(client);
+  }
+}
+
+void PipeServer::DeliverLatest() noexcept {
+  std::shared_ptr<const Snapshot> latest;
+  {
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    latest = m_latest;
+  }
+  if (!latest || latest == m_current) {
+    return;
+  }
+  m_current = latest;
+
+  // A failed write closes its client, and closing the last subscriber releases m_current, so iterate a local copy.
+  for (auto &client : m_clients) {
+    if (client->filter && !client->closing) {
+      Deliver(*client, *latest);
+    }
+  }
+}
+
+void PipeServer::Deliver(Client &client, const Snapshot &snapshot) noexcept {
+  if (client.hasSent && snapshot.timestamp - client.lastTimestamp + detail::kIntervalSlackMs < client.minIntervalMs) {
+    return;
+  }
+
+  auto frame = Encode(*client.filter, snapshot);
+  if (!frame) {
+    return;
+  }
+  if (client.queuedSnapshot) {
+    ++m_skippedCount;
+  }
+  client.queuedSnapshot = std::move(frame);
+  client.lastTimestamp = snapshot.timestamp;
+  client.hasSent = true;
+  StartWrite(client);
+}
+
+PipeServer::SharedBytes PipeServer::Encode(Filter &filter, const Snapshot &snapshot) noexcept {
+  if (filter.version == snapshot.version) {
+    return filter.frame;
+  }
+
+  try {
+    const json::SnapshotTree *tree = snapshot.tree.get();
+    if (filter.projected) {
+      if (!filter.projection.Apply(*tree, m_projected)) {
+        return nullptr;
+      }
+      tree = &m_projected;
+    }
+
+    std::string_view payload;
+    if (filter.format == 0) {
+      json::JsonConfig config;
+      config.prettyPrint = false;
+      if (!json::WriteSystemInfo(m_jsonWriter, *tree, config)) {
+        return nullptr;
+      }
+      payload = m_jsonWriter.GetOutput();
+    } else {
+      const auto format = filter.format == 2 ? json::BinaryFormat::MessagePack : json::BinaryFormat::Cbor;
+      if (!json::WriteSystemInfo(m_binaryWriter, format, *tree)) {
+        return nullptr;
+      }
+      const auto &buffer = m_binaryWriter.GetBuffer();
+      payload = std::string_view(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+    }
+
+    std::string frame;
+    frame.reserve(detail::kFrameHeaderSize + detail::kSnapshotHeaderSize + payload.size());
+    detail::AppendFrameHeader(frame, FrameType::Snapshot, detail::kSnapshotHeaderSize + payload.size());
+    detail::AppendLittleEndian(frame, snapshot.version, 8);
+    detail::AppendLittleEndian(frame, static_cast<uint64_t>(snapshot.timestamp), 8);
+    frame.append(payload);
+
+    filter.frame = std::make_shared<const std::string>(std::move(frame));
+    filter.version = snapshot.version;
+    ++m_encodedCount;
+    return filter.frame;
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void PipeServer::Detach(Client &client) noexcept {
+  if (!client.filter) {
+    return;
+  }
+  if (--client.filter->subscribers == 0) {
+    const auto *filter = client.filter;
+    m_filters.erase(std::remove_if(m_filters.begin(), m_filters.end(),
+                                   [filter](const auto &candidate) { return candidate.get() == filter; }),
+                    m_filters.end());
+    m_filterCount = m_filters.size();
+    if (m_filters.empty()) {
+      // Nothing is published while nobody listens, so drop the retained tree rather than hand it to the next
+      // subscriber as if it were current.
+      std::lock_guard<std::mutex> lock(m_snapshotMutex);
+      m_latest.reset();
+      m_current.reset();
+    }
+  }
+  client.filter = nullptr;
+}
+
+void PipeServer::CloseClient(Client &client) noexcept {
+  if (client.closing) {
+    return;
+  }
+  client.closing = true;
+  Detach(client);
+  client.queuedError.reset();
+  client.queuedSnapshot.reset();
+  if (client.connected) {
+    --m_clientCount;
+  }
+  if (client.pipe != INVALID_HANDLE_VALUE) {
+    CloseHandle(client.pipe);
+    client.pipe = INVALID_HANDLE_VALUE;
+  }
+}
+
+void PipeServer::ReleaseClients() noexcept {
+  m_clients.erase(std::remove_if(m_clients.begin(), m_clients.end(),
+                                 [](const auto &client) { return client->closing && client->pending == 0; }),
+                  m_clients.end());
+}
+
+}  // namespace net
\ No newline at end of file
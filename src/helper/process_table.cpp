@@ -0,0 +1,40 @@
+#include "helper/process_table.hpp"
+
+namespace proc {
+namespace detail {
+
+[[nodiscard]] uint64_t CounterDelta(uint64_t current, uint64_t previous) noexcept {
+  return current >= previous ? current - previous : 0;
+}
+}  // namespace detail
+
+void SortByProcessId(std::vector<ProcessSample> &samples) {
+  std::sort(samples.begin(), samples.end(),
+            [](const ProcessSample &a, const ProcessSample &b) { return a.processId < b.processId; });
+}
+
+void ComputeRates(std::vector<ProcessSample> &current, const std::vector<ProcessSample> &previous, double cpuScale,
+                  double ioScale) noexcept {
+  auto match = previous.cbegin();
+  const auto previousEnd = previous.cend();
+
+  for (auto &sample : current) {
+    while (match != previousEnd && match->processId < sample.processId) {
+      ++match;
+    }
+
+    if (match == previousEnd || match->processId != sample.processId || match->createTime != sample.createTime) {
+      continue;
+    }
+
+    sample.cpuPercent = static_cast<double>(detail::CounterDelta(sample.cpuTime, match->cpuTime)) * cpuScale;
+    sample.ioReadRate =
+        static_cast<uint64_t>(static_cast<double>(detail::CounterDelta(sample.ioReadBytes, match->ioReadBytes)) *
+                              ioScale);
+    sample.ioWriteRate =
+        static_cast<uint64_t>(static_cast<double>(detail::CounterDelta(sample.ioWriteBytes, match->ioWriteBytes)) *
+                              ioScale);
+  }
+}
+
+}  // namespace proc
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "helper/projection.hpp"
+
+#include <utility>
+
+namespace filter {
+
+ProjectionError Projection::SetPaths(const std::vector<std::string> &paths) noexcept {
+  if (paths.size() > detail::kMaxProjectionPaths) {
+    return ProjectionError::TooManyPaths;
+  }
+
+  try {
+    std::vector<json::PointerSegments> patterns;
+    patterns.reserve(paths.size());
+    for (const auto &path : paths) {
+      auto segments = json::ParsePointer(path);
+      if (!segments) {
+        return ProjectionError::InvalidPath;
+      }
+      patterns.push_back(std::move(*segments));
+    }
+
+    m_patterns = std::move(patterns);
+    return ProjectionError::Success;
+  } catch (...) {
+    return ProjectionError::MemoryAllocationFailed;
+  }
+}
+
+void Projection::Clear() noexcept { m_patterns.clear(); }
+
+bool Projection::IsEnabled() const noexcept { return !m_patterns.empty(); }
+
+bool Projection::Requires(std::initializer_list<std::string_view> path) const noexcept {
+  if (!IsEnabled()) {
+    return true;
+  }
+
+  for (const auto &pattern : m_patterns) {
+    bool matches = true;
+    auto segment = path.begin();
+    for (size_t i = 0; i < pattern.size() && segment != path.end(); ++i, ++segment) {
+      if (pattern[i] != json::detail::kPointerWildcard && *segment != json::detail::kPointerWildcard &&
+          pattern[i] != *segment) {
+        matches = false;
+        break;
+      }
+    }
+    if (matches) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Projection::Coverage Projection::Classify(const std::string_view *path, size_t pathLength) const noexcept {
+  Coverage coverage = Coverage::None;
+  for (const auto &pattern : m_patterns) {
+    if (json::MatchesPointerPrefix(pattern, path, pathLength)) {
+      return Coverage::Full;
+    }
+    if (json::IsPointerAncestor(path, pathLength, pattern)) {
+      coverage = Coverage::Partial;
+    }
+  }
+  return coverage;
+}
+
+void Projection::ApplyContainer(const json::SnapshotTree &source, size_t index, json::SnapshotTree &destination,
+                                PathBuffer &path, size_t depth) const {
+  const auto &nodes = source.GetNodes();
+  const auto &node = nodes[index];
+  const bool isObject = node.type == json::SnapshotNodeType::Object;
+
+  if (isObject) {
+    destination.BeginObject();
+  } else {
+    destination.BeginArray();
+  }
+
+  size_t position = 0;
+  for (size_t child = index + 1; child < node.end; child = nodes[child].end, ++position) {
+    path.segments[depth] =
+        isObject ? source.GetKey(nodes[child]) : json::FormatPointerIndex(position, path.indices[depth]);
+
+    const auto coverage = Classify(path.segments.data(), depth + 1);
+    if (coverage == Coverage::None || (coverage == Coverage::Partial && !json::IsContainer(nodes[child].type))) {
+      continue;
+    }
+
+    if (isObject) {
+      destination.Key(path.segments[depth]);
+    }
+    if (coverage == Coverage::Full) {
+      destination.AppendSubtree(source, child);
+    } else {
+      ApplyContainer(source, child, destination, path, depth + 1);
+    }
+  }
+
+  if (isObject) {
+    destination.EndObject();
+  } else {
+    destination.EndArray();
+  }
+}
+
+bool Projection::Apply(const json::SnapshotTree &source, json::SnapshotTree &destination) const noexcept {
+  try {
+    destination.Reset();
+    if (source.IsEmpty()) {
+      return source.IsValid();
+    }
+
+    const auto &root = source.GetNodes().front();
+    if (!IsEnabled() || !json::IsContainer(root.type) || Classify(nullptr, 0) == Coverage::Full) {
+      destination.AppendSubtree(source, 0);
+    } else {
+      PathBuffer path;
+      ApplyContainer(source, 0, destination, path, 0);
+    }
+    return source.IsValid() && destination.IsValid();
+  } catch (...) {
+    return false;
+  }
+}
+
+}  // namespace filter
\ No newline at end of file
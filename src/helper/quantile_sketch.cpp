@@ -0,0 +1,428 @@
+#include "helper/quantile_sketch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#include "helper/time_series.hpp"
+
+namespace history {
+namespace detail {
+
+constexpr double kSketchGamma = (1.0 + kSketchRelativeAccuracy) / (1.0 - kSketchRelativeAccuracy);
+const double kSketchLogGamma = std::log(kSketchGamma);
+
+[[nodiscard]] int32_t BucketIndex(double magnitude) noexcept {
+  return static_cast<int32_t>(std::ceil(std::log(magnitude) / kSketchLogGamma));
+}
+
+// Bucket i covers (gamma^(i-1), gamma^i]; this midpoint keeps the relative error of every member within bounds.
+[[nodiscard]] double BucketValue(int32_t index) noexcept {
+  return 2.0 * std::exp(index * kSketchLogGamma) / (kSketchGamma + 1.0);
+}
+
+[[nodiscard]] bool IsValidWindow(int64_t windowMs, size_t slices) noexcept {
+  return windowMs >= kMinSketchWindowMs && windowMs <= kMaxSketchWindowMs && slices > 0 &&
+         slices <= kMaxSketchSlices;
+}
+}  // namespace detail
+
+void BucketStore::Add(int32_t index, uint64_t count) {
+  if (count == 0) {
+    return;
+  }
+
+  if (m_counts.empty()) {
+    m_counts.push_back(0);
+    m_offset = index;
+  } else if (index < m_offset) {
+    const int64_t highest = static_cast<int64_t>(m_offset) + static_cast<int64_t>(m_counts.size()) - 1;
+    index = static_cast<int32_t>(std::max<int64_t>(index, highest - static_cast<int64_t>(detail::kMaxSketchBins) + 1));
+    if (index < m_offset) {
+      m_counts.insert(m_counts.begin(), static_cast<size_t>(m_offset - index), 0);
+      m_offset = index;
+    }
+  } else if (static_cast<size_t>(index - m_offset) >= m_counts.size()) {
+    m_counts.resize(static_cast<size_t>(index - m_offset) + 1, 0);
+    if (m_counts.size() > detail::kMaxSketchBins) {
+      const size_t excess = m_counts.size() - detail::kMaxSketchBins;
+      const uint64_t collapsed = std::accumulate(m_counts.begin(), m_counts.begin() + excess + 1, uint64_t{0});
+      m_counts.erase(m_counts.begin(), m_counts.begin() + excess);
+      m_counts.front() = collapsed;
+      m_offset += static_cast<int32_t>(excess);
+    }
+  }
+
+  m_counts[static_cast<size_t>(index - m_offset)] += count;
+}
+
+void BucketStore::Merge(const BucketStore &other) {
+  const auto &counts = other.m_counts;
+  for (size_t i = 0; i < counts.size(); ++i) {
+    Add(other.m_offset + static_cast<int32_t>(i), counts[i]);
+  }
+}
+
+void BucketStore::Clear() noexcept {
+  m_counts.clear();
+  m_offset = 0;
+}
+
+int32_t BucketStore::GetOffset() const noexcept { return m_offset; }
+
+const std::vector<uint64_t> &BucketStore::GetCounts() const noexcept { return m_counts; }
+
+size_t BucketStore::GetMemoryUsage() const noexcept { return m_counts.capacity() * sizeof(uint64_t); }
+
+void QuantileSketch::Add(double value) {
+  if (!std::isfinite(value)) {
+    return;
+  }
+
+  if (value > detail::kMinIndexableValue) {
+    m_positive.Add(detail::BucketIndex(value), 1);
+  } else if (value < -detail::kMinIndexableValue) {
+    m_negative.Add(detail::BucketIndex(-value), 1);
+  } else {
+    ++m_zeroCount;
+  }
+
+  m_min = m_count == 0 ? value : std::min(m_min, value);
+  m_max = m_count == 0 ? value : std::max(m_max, value);
+  m_sum += value;
+  ++m_count;
+}
+
+void QuantileSketch::Merge(const QuantileSketch &other) {
+  if (other.m_count == 0) {
+    return;
+  }
+
+  m_positive.Merge(other.m_positive);
+  m_negative.Merge(other.m_negative);
+  m_zeroCount += other.m_zeroCount;
+  m_min = m_count == 0 ? other.m_min : std::min(m_min, other.m_min);
+  m_max = m_count == 0 ? other.m_max : std::max(m_max, other.m_max);
+  m_sum += other.m_sum;
+  m_count += other.m_count;
+}
+
+void QuantileSketch::Clear() noexcept {
+  m_positive.Clear();
+  m_negative.Clear();
+  m_zeroCount = 0;
+  m_count = 0;
+  m_min = 0.0;
+  m_max = 0.0;
+  m_sum = 0.0;
+}
+
+double QuantileSketch::Quantile(double quantile) const noexcept {
+  if (m_count == 0) {
+    return 0.0;
+  }
+
+  const double rank = std::clamp(quantile, 0.0, 1.0) * static_cast<double>(m_count - 1);
+  const auto clamp = [this](double value) { return std::clamp(value, m_min, m_max); };
+  uint64_t seen = 0;
+
+  const auto &negative = m_negative.GetCounts();
+  for (size_t i = negative.size(); i-- > 0;) {
+    seen += negative[i];
+    if (static_cast<double>(seen) > rank) {
+      return clamp(-detail::BucketValue(m_negative.GetOffset() + static_cast<int32_t>(i)));
+    }
+  }
+
+  seen += m_zeroCount;
+  if (static_cast<double>(seen) > rank) {
+    return clamp(0.0);
+  }
+
+  const auto &positive = m_positive.GetCounts();
+  for (size_t i = 0; i < positive.size(); ++i) {
+    seen += positive[i];
+    if (static_cast<double>(seen) > rank) {
+      return clamp(detail::BucketValue(m_positive.GetOffset() + static_cast<int32_t>(i)));
+    }
+  }
+  return m_max;
+}
+
+uint64_t QuantileSketch::GetCount() const noexcept { return m_count; }
+
+double QuantileSketch::GetMin() const noexcept { return m_min; }
+
+double QuantileSketch::GetMax() const noexcept { return m_max; }
+
+double QuantileSketch::GetSum() const noexcept { return m_sum; }
+
+size_t QuantileSketch::GetMemoryUsage() const noexcept {
+  return m_positive.GetMemoryUsage() + m_negative.GetMemoryUsage();
+}
+
+MetricSketch::MetricSketch(std::string pointer, json::PointerSegments path, int64_t windowMs, size_t slices)
+    : m_pointer(std::move(pointer)),
+      m_path(std::move(path)),
+      m_windowMs(windowMs),
+      m_sliceMs(std::max<int64_t>(windowMs / static_cast<int64_t>(slices), 1)),
+      m_slices(slices),
+      m_sliceStarts(slices, std::numeric_limits<int64_t>::min()) {}
+
+void MetricSketch::Add(int64_t timestamp, double value) {
+  if (!std::isfinite(value)) {
+    return;
+  }
+  if (m_hasSamples && timestamp < m_lastTimestamp) {
+    timestamp = m_lastTimestamp;
+  }
+
+  const int64_t sliceStart = detail::BucketStart(timestamp, m_sliceMs);
+  if (m_sliceStarts[m_head] != sliceStart) {
+    m_head = (m_head + 1) % m_slices.size();
+    m_slices[m_head].Clear();
+    m_sliceStarts[m_head] = sliceStart;
+  }
+
+  // A completed tumbling window folds into the run sketch once, so the run summary never rescans old samples.
+  const int64_t windowStart = detail::BucketStart(timestamp, m_windowMs);
+  if (m_open.GetCount() > 0 && m_openStart != windowStart) {
+    m_run.Merge(m_open);
+    std::swap(m_open, m_closed);
+    m_closedStart = m_openStart;
+    m_open.Clear();
+  }
+  if (m_open.GetCount() == 0) {
+    m_openStart = windowStart;
+  }
+  if (!m_hasSamples) {
+    m_runStart = timestamp;
+  }
+
+  m_slices[m_head].Add(value);
+  m_open.Add(value);
+  m_lastTimestamp = timestamp;
+  m_hasSamples = true;
+}
+
+void MetricSketch::Reset() noexcept {
+  for (auto &slice : m_slices) {
+    slice.Clear();
+  }
+  std::fill(m_sliceStarts.begin(), m_sliceStarts.end(), std::numeric_limits<int64_t>::min());
+  m_head = 0;
+  m_open.Clear();
+  m_closed.Clear();
+  m_run.Clear();
+  m_openStart = 0;
+  m_closedStart = 0;
+  m_runStart = 0;
+  m_lastTimestamp = 0;
+  m_hasSamples = false;
+}
+
+void MetricSketch::Summarize(SketchWindow window, int64_t now, QuantileSketch &scratch,
+                             SketchSummary &summary) const {
+  const QuantileSketch *sketch = &scratch;
+  scratch.Clear();
+  summary = SketchSummary{};
+
+  switch (window) {
+    case SketchWindow::Sliding:
+      summary.windowStart = now - m_windowMs;
+      for (size_t i = 0; i < m_slices.size(); ++i) {
+        if (m_sliceStarts[i] > summary.windowStart - m_sliceMs) {
+          scratch.Merge(m_slices[i]);
+        }
+      }
+      break;
+    case SketchWindow::Tumbling:
+      // The open window counts as completed once the clock has moved past it without a new sample.
+      if (m_open.GetCount() > 0 && detail::BucketStart(now, m_windowMs) != m_openStart) {
+        sketch = &m_open;
+        summary.windowStart = m_openStart;
+      } else {
+        sketch = &m_closed;
+        summary.windowStart = m_closedStart;
+      }
+      break;
+    case SketchWindow::Run:
+      summary.windowStart = m_runStart;
+      scratch.Merge(m_run);
+      scratch.Merge(m_open);
+      break;
+  }
+
+  summary.count = sketch->GetCount();
+  if (summary.count == 0) {
+    return;
+  }
+  summary.min = sketch->GetMin();
+  summary.max = sketch->GetMax();
+  summary.mean = sketch->GetSum() / static_cast<double>(summary.count);
+  summary.p50 = sketch->Quantile(0.50);
+  summary.p95 = sketch->Quantile(0.95);
+  summary.p99 = sketch->Quantile(0.99);
+}
+
+std::string_view MetricSketch::GetPointer() const noexcept { return m_pointer; }
+
+const json::PointerSegments &MetricSketch::GetPath() const noexcept { return m_path; }
+
+size_t MetricSketch::GetMemoryUsage() const noexcept {
+  size_t bytes = sizeof(MetricSketch) + m_pointer.capacity() + m_slices.capacity() * sizeof(QuantileSketch) +
+                 m_sliceStarts.capacity() * sizeof(int64_t) + m_open.GetMemoryUsage() + m_closed.GetMemoryUsage() +
+                 m_run.GetMemoryUsage();
+  for (const auto &slice : m_slices) {
+    bytes += slice.GetMemoryUsage();
+  }
+  return bytes;
+}
+
+SketchError SketchStore::AddMetric(std::string_view path) noexcept {
+  try {
+    auto segments = json::ParsePointer(path);
+    if (!segments || segments->empty() ||
+        std::find(segments->begin(), segments->end(), json::detail::kPointerWildcard) != segments->end()) {
+      return SketchError::InvalidPath;
+    }
+
+    for (const auto &metric : m_metrics) {
+      if (metric.GetPath() == *segments) {
+        return SketchError::Success;
+      }
+    }
+
+    if (m_metrics.size() >= detail::kMaxSketchMetrics) {
+      return SketchError::TooManyMetrics;
+    }
+
+    m_metrics.emplace_back(std::string{path}, std::move(*segments), m_windowMs, m_slices);
+    return SketchError::Success;
+  } catch (...) {
+    return SketchError::MemoryAllocationFailed;
+  }
+}
+
+void SketchStore::ClearMetrics() noexcept { m_metrics.clear(); }
+
+SketchError SketchStore::SetWindow(int64_t windowMs, size_t slices) noexcept {
+  if (!detail::IsValidWindow(windowMs, slices)) {
+    return SketchError::InvalidWindow;
+  }
+
+  try {
+    std::vector<MetricSketch> metrics;
+    metrics.reserve(m_metrics.size());
+    for (const auto &existing : m_metrics) {
+      metrics.emplace_back(std::string{existing.GetPointer()}, existing.GetPath(), windowMs, slices);
+    }
+    m_metrics.swap(metrics);
+    m_windowMs = windowMs;
+    m_slices = slices;
+    return SketchError::Success;
+  } catch (...) {
+    return SketchError::MemoryAllocationFailed;
+  }
+}
+
+void SketchStore::Reset() noexcept {
+  for (auto &metric : m_metrics) {
+    metric.Reset();
+  }
+}
+
+bool SketchStore::IsEnabled() const noexcept { return !m_metrics.empty(); }
+
+void SketchStore::Record(const json::SnapshotTree &tree, int64_t timestamp) noexcept {
+  const auto &nodes = tree.GetNodes();
+  for (auto &metric : m_metrics) {
+    const auto index = json::FindNode(tree, metric.GetPath());
+    if (!index) {
+      continue;
+    }
+    if (const auto value = json::GetNumber(nodes[*index])) {
+      try {
+        metric.Add(timestamp, *value);
+      } catch (...) {
+      }
+    }
+  }
+}
+
+SketchError SketchStore::Query(std::string_view metric, SketchWindow window, int64_t now,
+                               SketchSummary &summary) const noexcept {
+  if (window != SketchWindow::Sliding && window != SketchWindow::Tumbling && window != SketchWindow::Run) {
+    return SketchError::InvalidWindow;
+  }
+
+  try {
+    const auto segments = json::ParsePointer(metric);
+    if (!segments) {
+      return SketchError::InvalidPath;
+    }
+
+    for (const auto &candidate : m_metrics) {
+      if (candidate.GetPath() == *segments) {
+        candidate.Summarize(window, now, m_scratch, summary);
+        return SketchError::Success;
+      }
+    }
+    return SketchError::UnknownMetric;
+  } catch (...) {
+    return SketchError::MemoryAllocationFailed;
+  }
+}
+
+bool SketchStore::WriteSection(json::SnapshotTree &tree, int64_t now) const noexcept {
+  constexpr std::pair<std::string_view, SketchWindow> kWindows[] = {
+      {"run", SketchWindow::Run}, {"sliding", SketchWindow::Sliding}, {"tumbling", SketchWindow::Tumbling}};
+
+  try {
+    tree.Reset();
+    tree.BeginObject();
+    tree.Key("metrics");
+    tree.BeginArray();
+    for (const auto &metric : m_metrics) {
+      tree.BeginObject();
+      tree.Field("path", metric.GetPointer());
+      for (const auto &[key, window] : kWindows) {
+        SketchSummary summary;
+        metric.Summarize(window, now, m_scratch, summary);
+        tree.Key(key);
+        tree.BeginObject();
+        tree.Field("count", summary.count);
+        if (summary.count > 0) {
+          tree.Field("max", summary.max);
+          tree.Field("mean", summary.mean);
+          tree.Field("min", summary.min);
+          tree.Field("p50", summary.p50);
+          tree.Field("p95", summary.p95);
+          tree.Field("p99", summary.p99);
+        }
+        tree.Field("window_start", summary.windowStart);
+        tree.EndObject();
+      }
+      tree.EndObject();
+    }
+    tree.EndArray();
+    tree.Field("slices", m_slices);
+    tree.Field("window_ms", m_windowMs);
+    tree.EndObject();
+    return tree.IsValid();
+  } catch (...) {
+    return false;
+  }
+}
+
+size_t SketchStore::GetMemoryUsage() const noexcept {
+  size_t bytes = m_metrics.capacity() * sizeof(MetricSketch) + m_scratch.GetMemoryUsage();
+  for (const auto &metric : m_metrics) {
+    bytes += metric.GetMemoryUsage() - sizeof(MetricSketch);
+  }
+  return bytes;
+}
+
+}  // namespace history
\ No newline at end of file
@@ -0,0 +1,654 @@
+#include "helper/segment_store.hpp"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+#include "helper/crc32.hpp"
+
+namespace storage {
+namespace detail {
+
+constexpr std::string_view kSegmentPrefix = "segment_";
+constexpr size_t kSegmentIndexDigits = 20;
+constexpr size_t kRecordCrcOffset = 24;
+constexpr size_t kSegmentCrcOffset = 32;
+
+template <typename T>
+[[nodiscard]] T Load(const uint8_t *data) noexcept {
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+template <typename T>
+void Store(uint8_t *data, T value) noexcept {
+  std::memcpy(data, &value, sizeof(T));
+}
+
+[[nodiscard]] constexpr size_t AlignRecord(size_t size) noexcept {
+  return (size + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+[[nodiscard]] std::string FormatSegmentName(uint64_t index) {
+  std::array<char, kSegmentIndexDigits> digits{};
+  digits.fill('0');
+  std::array<char, kSegmentIndexDigits> buffer{};
+  const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), index);
+  const auto length = static_cast<size_t>(result.ptr - buffer.data());
+  std::memcpy(digits.data() + digits.size() - length, buffer.data(), length);
+
+  std::string name{kSegmentPrefix};
+  name.append(digits.data(), digits.size());
+  name.append(kSegmentExtension);
+  return name;
+}
+
+[[nodiscard]] bool ParseSegmentName(const std::filesystem::path &path, uint64_t &index) {
+  const auto name = path.filename().string();
+  const std::string_view view{name};
+  if (view.size() != kSegmentPrefix.size() + kSegmentIndexDigits + kSegmentExtension.size() ||
+      view.substr(0, kSegmentPrefix.size()) != kSegmentPrefix ||
+      view.substr(view.size() - kSegmentExtension.size()) != kSegmentExtension) {
+    return false;
+  }
+
+  const char *first = view.data() + kSegmentPrefix.size();
+  const char *last = first + kSegmentIndexDigits;
+  const auto [ptr, ec] = std::from_chars(first, last, index);
+  return ec == std::errc{} && ptr == last;
+}
+
+[[nodiscard]] bool IsValidOptions(const StoreOptions &options) noexcept {
+  return options.segmentSize >= kMinSegmentSize && options.segmentSize <= kMaxSegmentSize &&
+         options.segmentSize % kRecordAlignment == 0 && options.retentionBytes >= options.segmentSize;
+}
+
+void WriteSegmentHeader(uint8_t *data, uint64_t index, uint64_t firstSequence, uint64_t size) noexcept {
+  Store<uint32_t>(data, kSegmentMagic);
+  Store<uint32_t>(data + 4, kSegmentVersion);
+  Store<uint64_t>(data + 8, index);
+  Store<uint64_t>(data + 16, firstSequence);
+  Store<uint64_t>(data + 24, size);
+  Store<uint32_t>(data + kSegmentCrcOffset, codec::Crc32(data, kSegmentCrcOffset));
+}
+
+[[nodiscard]] bool ReadSegmentHeader(const uint8_t *data, size_t size, uint64_t index,
+                                     uint64_t &firstSequence) noexcept {
+  if (size < kSegmentHeaderSize || Load<uint32_t>(data) != kSegmentMagic ||
+      Load<uint32_t>(data + 4) != kSegmentVersion || Load<uint64_t>(data + 8) != index ||
+      Load<uint64_t>(data + 24) != size ||
+      Load<uint32_t>(data + kSegmentCrcOffset) != codec::Crc32(data, kSegmentCrcOffset)) {
+    return false;
+  }
+  firstSequence = Load<uint64_t>(data + 16);
+  return true;
+}
+
+[[nodiscard]] size_t ValidRecordSize(const uint8_t *data, size_t offset, size_t size, uint64_t sequence) noexcept {
+  if (offset + kRecordHeaderSize > size) {
+    return 0;
+  }
+
+  const uint8_t *header = data + offset;
+  const uint32_t length = Load<uint32_t>(header + 4);
+  if (Load<uint32_t>(header) != kRecordMagic || Load<uint64_t>(header + 8) != sequence ||
+      length > size - offset - kRecordHeaderSize) {
+    return 0;
+  }
+
+  const uint32_t crc = codec::Crc32(header + kRecordHeaderSize, length, codec::Crc32(header, kRecordCrcOffset));
+  if (Load<uint32_t>(header + kRecordCrcOffset) != crc) {
+    return 0;
+  }
+  return std::min(AlignRecord(kRecordHeaderSize + length), size - offset);
+}
+}  // namespace detail
+
+MappedFile::~MappedFile() noexcept { Close(); }
+
+#ifdef _WIN32
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : m_file(std::exchange(other.m_file, INVALID_HANDLE_VALUE)),
+      m_mapping(std::exchange(other.m_mapping, nullptr)),
+      m_view(std::exchange(other.m_view, nullptr)),
+      m_size(std::exchange(other.m_size, 0)) {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    Close();
+    m_file = std::exchange(other.m_file, INVALID_HANDLE_VALUE);
+    m_mapping = std::exchange(other.m_mapping, nullptr);
+    m_view = std::exchange(other.m_view, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+  }
+  return *this;
+}
+
+StoreError MappedFile::Open(const std::filesystem::path &path, size_t createSize) noexcept {
+  Close();
+
+  try {
+    m_file = CreateFileW(path.wstring().c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                         nullptr, createSize > 0 ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  } catch (...) {
+    return StoreError::MemoryAllocationFailed;
+  }
+  if (m_file == INVALID_HANDLE_VALUE) {
+    return StoreError::OpenFailed;
+  }
+
+  uint64_t size = createSize;
+  if (size == 0) {
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(m_file, &fileSize)) {
+      Close();
+      return StoreError::OpenFailed;
+    }
+    // An empty or oversized file was opened fine but can never hold a valid segment.
+    if (fileSize.QuadPart < static_cast<LONGLONG>(detail::kSegmentHeaderSize) ||
+        static_cast<uint64_t>(fileSize.QuadPart) > detail::kMaxSegmentSize) {
+      Close();
+      return StoreError::CorruptSegment;
+    }
+    size = static_cast<uint64_t>(fileSize.QuadPart);
+  }
+
+  // Sizing the mapping extends a newly created file with zeroes, so unused space never parses as a record.
+  m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32),
+                                 static_cast<DWORD>(size & 0xFFFFFFFFu), nullptr);
+  if (!m_mapping) {
+    Close();
+    return StoreError::MapFailed;
+  }
+
+  m_view = static_cast<uint8_t *>(MapViewOfFile(m_mapping, FILE_MAP_WRITE, 0, 0, static_cast<SIZE_T>(size)));
+  if (!m_view) {
+    Close();
+    return StoreError::MapFailed;
+  }
+  m_size = static_cast<size_t>(size);
+  return StoreError::Success;
+}
+
+void MappedFile::Close() noexcept {
+  if (m_view) {
+    UnmapViewOfFile(m_view);
+    m_view = nullptr;
+  }
+  if (m_mapping) {
+    CloseHandle(m_mapping);
+    m_mapping = nullptr;
+  }
+  if (m_file != INVALID_HANDLE_VALUE) {
+    CloseHandle(m_file);
+    m_file = INVALID_HANDLE_VALUE;
+  }
+  m_size = 0;
+}
+
+void MappedFile::Flush(size_t offset, size_t size) const noexcept {
+  if (m_view && size > 0 && offset < m_size) {
+    FlushViewOfFile(m_view + offset, std::min(size, m_size - offset));
+  }
+}
+#else
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : m_file(std::exchange(other.m_file, -1)),
+      m_view(std::exchange(other.m_view, nullptr)),
+      m_size(std::exchange(other.m_size, 0)) {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    Close();
+    m_file = std::exchange(other.m_file, -1);
+    m_view = std::exchange(other.m_view, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+  }
+  return *this;
+}
+
+StoreError MappedFile::Open(const std::filesystem::path &path, size_t createSize) noexcept {
+  Close();
+
+  m_file = open(path.c_str(), createSize > 0 ? O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC : O_RDWR | O_CLOEXEC, 0644);
+  if (m_file < 0) {
+    return StoreError::OpenFailed;
+  }
+
+  uint64_t size = createSize;
+  if (size == 0) {
+    struct stat status {};
+    if (fstat(m_file, &status) != 0) {
+      Close();
+      return StoreError::OpenFailed;
+    }
+    // An empty or oversized file was opened fine but can never hold a valid segment.
+    if (status.st_size < static_cast<off_t>(detail::kSegmentHeaderSize) ||
+        static_cast<uint64_t>(status.st_size) > detail::kMaxSegmentSize) {
+      Close();
+      return StoreError::CorruptSegment;
+    }
+    size = static_cast<uint64_t>(status.st_size);
+  } else if (ftruncate(m_file, static_cast<off_t>(size)) != 0) {
+    // Extending a newly created file fills it with zeroes, so unused space never parses as a record.
+    Close();
+    return StoreError::MapFailed;
+  }
+
+  void *view = mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE, MAP_SHARED, m_file, 0);
+  if (view == MAP_FAILED) {
+    Close();
+    return StoreError::MapFailed;
+  }
+  m_view = static_cast<uint8_t *>(view);
+  m_size = static_cast<size_t>(size);
+  return StoreError::Success;
+}
+
+void MappedFile::Close() noexcept {
+  if (m_view) {
+    munmap(m_view, m_size);
+    m_view = nullptr;
+  }
+  if (m_file >= 0) {
+    close(m_file);
+    m_file = -1;
+  }
+  m_size = 0;
+}
+
+// msync wants a page-aligned start, so the range is widened down to the page holding offset.
+void MappedFile::Flush(size_t offset, size_t size) const noexcept {
+  if (m_view && size > 0 && offset < m_size) {
+    const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t begin = offset - offset % page;
+    msync(m_view + begin, std::min(size, m_size - offset) + offset - begin, MS_SYNC);
+  }
+}
+#endif
+
+uint8_t *MappedFile::GetData() const noexcept { return m_view; }
+
+size_t MappedFile::GetSize() const noexcept { return m_size; }
+
+SegmentStore::~SegmentStore() { Close(); }
+
+StoreError SegmentStore::Open(const std::filesystem::path &directory, const StoreOptions &options) noexcept {
+  if (directory.empty()) {
+    return StoreError::InvalidPath;
+  }
+  if (!detail::IsValidOptions(options)) {
+    return StoreError::InvalidOptions;
+  }
+
+  Close();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  try {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec || !std::filesystem::is_directory(directory, ec)) {
+      return StoreError::InvalidPath;
+    }
+
+    m_directory = directory;
+    m_options = options;
+    auto result = Lock();
+    if (result != StoreError::Success) {
+      return result;
+    }
+
+    result = Recover();
+    if (result == StoreError::Success && m_segments.empty()) {
+      result = CreateSegment(0);
+    }
+    if (result != StoreError::Success) {
+      m_segments.clear();
+      Unlock();
+      return result;
+    }
+    EnforceRetention();
+    return StoreError::Success;
+  } catch (...) {
+    m_segments.clear();
+    Unlock();
+    return StoreError::MemoryAllocationFailed;
+  }
+}
+
+void SegmentStore::Close() noexcept {
+  Flush();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_segments.clear();
+  Unlock();
+  m_nextSequence = 0;
+  m_recoveredCount = 0;
+}
+
+#ifdef _WIN32
+// The lock file is opened without sharing, so a second store on the same directory, in this process or another,
+// fails here instead of recovering and truncating segments the first one is still writing.
+StoreError SegmentStore::Lock() {
+  const auto path = m_directory / detail::kLockFileName;
+  HANDLE handle = CreateFileW(path.wstring().c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (handle == INVALID_HANDLE_VALUE) {
+    return GetLastError() == ERROR_SHARING_VIOLATION ? StoreError::DirectoryLocked : StoreError::OpenFailed;
+  }
+  m_lock.reset(handle);
+  return StoreError::Success;
+}
+
+void SegmentStore::Unlock() noexcept { m_lock.reset(); }
+#else
+// flock belongs to the open file description, so a second store on the same directory conflicts whether it lives in
+// this process or another, and the lock goes away with the process.
+StoreError SegmentStore::Lock() {
+  const auto path = m_directory / detail::kLockFileName;
+  const int file = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (file < 0) {
+    return StoreError::OpenFailed;
+  }
+  if (flock(file, LOCK_EX | LOCK_NB) != 0) {
+    const bool busy = errno == EWOULDBLOCK;
+    close(file);
+    return busy ? StoreError::DirectoryLocked : StoreError::OpenFailed;
+  }
+  Unlock();
+  m_lock = file;
+  return StoreError::Success;
+}
+
+void SegmentStore::Unlock() noexcept {
+  if (m_lock >= 0) {
+    close(m_lock);
+    m_lock = -1;
+  }
+}
+#endif
+
+// Renames a segment that opened but does not hold a valid header out of the segment namespace; the bytes are kept
+// for inspection and never counted again.
+StoreError SegmentStore::Quarantine(Segment &segment) {
+  segment.file.Close();
+
+  auto target = segment.path;
+  target += detail::kQuarantineExtension;
+  std::error_code ec;
+  std::filesystem::rename(segment.path, target, ec);
+  return ec ? StoreError::OpenFailed : StoreError::Success;
+}
+
+StoreError SegmentStore::Recover() {
+  std::vector<std::pair<uint64_t, std::filesystem::path>> files;
+  for (const auto &entry : std::filesystem::directory_iterator(m_directory)) {
+    uint64_t index = 0;
+    if (entry.is_regular_file() && detail::ParseSegmentName(entry.path(), index)) {
+      files.emplace_back(index, entry.path());
+    }
+  }
+  std::sort(files.begin(), files.end());
+
+  for (auto &[index, path] : files) {
+    Segment segment;
+    segment.path = std::move(path);
+    segment.index = index;
+
+    // Open and map failures, e.g. a sharing violation or low memory, say nothing about the file's contents, so
+    // they fail the whole open and leave the file alone.
+    const auto opened = segment.file.Open(segment.path, 0);
+    if (opened != StoreError::Success && opened != StoreError::CorruptSegment) {
+      return opened;
+    }
+
+    if (opened == StoreError::CorruptSegment ||
+        !detail::ReadSegmentHeader(segment.file.GetData(), segment.file.GetSize(), index, segment.firstSequence) ||
+        (!m_segments.empty() && segment.firstSequence < m_nextSequence)) {
+      const auto result = Quarantine(segment);
+      if (result != StoreError::Success) {
+        return result;
+      }
+      continue;
+    }
+
+    const uint8_t *data = segment.file.GetData();
+    const size_t size = segment.file.GetSize();
+    size_t offset = detail::kSegmentHeaderSize;
+    while (const size_t recordSize =
+               detail::ValidRecordSize(data, offset, size, segment.firstSequence + segment.recordCount)) {
+      offset += recordSize;
+      ++segment.recordCount;
+    }
+    segment.end = offset;
+    segment.flushedEnd = offset;
+
+    m_nextSequence = segment.firstSequence + segment.recordCount;
+    m_recoveredCount += segment.recordCount;
+    m_segments.push_back(std::move(segment));
+  }
+
+  if (!m_segments.empty()) {
+    // A torn record is cut off at the last valid one; clearing the tail keeps stale records written before the
+    // crash from reappearing behind newer ones with a matching sequence.
+    auto &active = m_segments.back();
+    if (active.end < active.file.GetSize() && active.file.GetData()[active.end] != 0) {
+      std::memset(active.file.GetData() + active.end, 0, active.file.GetSize() - active.end);
+      active.file.Flush(active.end, active.file.GetSize() - active.end);
+    }
+  }
+  return StoreError::Success;
+}
+
+StoreError SegmentStore::CreateSegment(uint64_t index) {
+  Segment segment;
+  segment.path = m_directory / detail::FormatSegmentName(index);
+  segment.index = index;
+  segment.firstSequence = m_nextSequence;
+  segment.end = detail::kSegmentHeaderSize;
+
+  const auto result = segment.file.Open(segment.path, m_options.segmentSize);
+  if (result != StoreError::Success) {
+    return result;
+  }
+  detail::WriteSegmentHeader(segment.file.GetData(), index, segment.firstSequence, segment.file.GetSize());
+  m_segments.push_back(std::move(segment));
+  return StoreError::Success;
+}
+
+void SegmentStore::EnforceRetention() noexcept {
+  uint64_t totalBytes = 0;
+  for (const auto &segment : m_segments) {
+    totalBytes += segment.file.GetSize();
+  }
+
+  while (m_segments.size() > 1 && totalBytes > m_options.retentionBytes) {
+    auto &oldest = m_segments.front();
+    totalBytes -= oldest.file.GetSize();
+    oldest.file.Close();
+
+    std::error_code ec;
+    std::filesystem::remove(oldest.path, ec);
+    m_segments.erase(m_segments.begin());
+  }
+}
+
+StoreError SegmentStore::Append(const uint8_t *data, size_t size, int64_t timestamp) noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_segments.empty()) {
+    return StoreError::NotOpen;
+  }
+
+  const size_t recordSize = detail::AlignRecord(detail::kRecordHeaderSize + size);
+  if (size > std::numeric_limits<uint32_t>::max() ||
+      recordSize > m_options.segmentSize - detail::kSegmentHeaderSize) {
+    return StoreError::RecordTooLarge;
+  }
+
+  try {
+    if (m_segments.back().end + recordSize > m_segments.back().file.GetSize()) {
+      auto &sealed = m_segments.back();
+      sealed.file.Flush(sealed.flushedEnd, sealed.end - sealed.flushedEnd);
+      sealed.flushedEnd = sealed.end;
+
+      const auto result = CreateSegment(sealed.index + 1);
+      if (result != StoreError::Success) {
+        return result;
+      }
+      EnforceRetention();
+    }
+  } catch (...) {
+    return StoreError::MemoryAllocationFailed;
+  }
+
+  auto &active = m_segments.back();
+  uint8_t *record = active.file.GetData() + active.end;
+  if (size > 0) {
+    std::memcpy(record + detail::kRecordHeaderSize, data, size);
+  }
+  detail::Store<uint32_t>(record, detail::kRecordMagic);
+  detail::Store<uint32_t>(record + 4, static_cast<uint32_t>(size));
+  detail::Store<uint64_t>(record + 8, m_nextSequence);
+  detail::Store<int64_t>(record + 16, timestamp);
+  const uint32_t crc = codec::Crc32(record, detail::kRecordCrcOffset);
+  detail::Store<uint32_t>(record + detail::kRecordCrcOffset,
+                          codec::Crc32(record + detail::kRecordHeaderSize, size, crc));
+  detail::Store<uint32_t>(record + 28, 0);
+
+  active.end += recordSize;
+  ++active.recordCount;
+  ++m_nextSequence;
+  return StoreError::Success;
+}
+
+void SegmentStore::Flush() noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto &segment : m_segments) {
+    if (segment.flushedEnd < segment.end) {
+      segment.file.Flush(segment.flushedEnd, segment.end - segment.flushedEnd);
+      segment.flushedEnd = segment.end;
+    }
+  }
+}
+
+size_t SegmentStore::Read(uint64_t fromSequence, size_t maxRecords,
+                          const std::function<bool(const RecordView &)> &visitor) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  size_t visited = 0;
+  for (const auto &segment : m_segments) {
+    if (visited >= maxRecords) {
+      break;
+    }
+    if (segment.firstSequence + segment.recordCount <= fromSequence) {
+      continue;
+    }
+
+    const uint8_t *data = segment.file.GetData();
+    size_t offset = detail::kSegmentHeaderSize;
+    for (uint64_t i = 0; i < segment.recordCount && visited < maxRecords; ++i) {
+      const uint8_t *header = data + offset;
+      const uint32_t length = detail::Load<uint32_t>(header + 4);
+      offset += detail::AlignRecord(detail::kRecordHeaderSize + length);
+
+      const uint64_t sequence = segment.firstSequence + i;
+      if (sequence < fromSequence) {
+        continue;
+      }
+
+      ++visited;
+      const RecordView view{sequence, detail::Load<int64_t>(header + 16), header + detail::kRecordHeaderSize, length};
+      if (!visitor(view)) {
+        return visited;
+      }
+    }
+  }
+  return visited;
+}
+
+bool SegmentStore::IsOpen() const noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return !m_segments.empty();
+}
+
+uint64_t SegmentStore::GetFirstSequence() const noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_segments.empty() ? 0 : m_segments.front().firstSequence;
+}
+
+uint64_t SegmentStore::GetNextSequence() const noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_nextSequence;
+}
+
+uint64_t SegmentStore::GetRecoveredCount() const noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_recoveredCount;
+}
+
+RecordQueue::RecordQueue(size_t capacity) : m_slots(std::max<size_t>(capacity, 1)) {}
+
+bool RecordQueue::Push(std::string_view data, int64_t timestamp) noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_size == m_slots.size()) {
+    ++m_droppedCount;
+    return false;
+  }
+
+  auto &slot = m_slots[(m_head + m_size) % m_slots.size()];
+  try {
+    slot.data.assign(data);
+  } catch (...) {
+    ++m_droppedCount;
+    return false;
+  }
+  slot.timestamp = timestamp;
+  ++m_size;
+  return true;
+}
+
+size_t RecordQueue::Drain(std::vector<QueuedRecord> &records) noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  try {
+    if (records.size() < m_size) {
+      records.resize(m_size);
+    }
+  } catch (...) {
+    return 0;
+  }
+
+  // Swapping hands the drained buffers' capacity back to the slots, so steady-state pushes do not allocate.
+  const size_t count = m_size;
+  for (size_t i = 0; i < count; ++i) {
+    auto &slot = m_slots[(m_head + i) % m_slots.size()];
+    records[i].data.swap(slot.data);
+    records[i].timestamp = slot.timestamp;
+  }
+  m_head = (m_head + count) % m_slots.size();
+  m_size = 0;
+  return count;
+}
+
+void RecordQueue::Clear() noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_head = 0;
+  m_size = 0;
+}
+
+uint64_t RecordQueue::GetDroppedCount() const noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_droppedCount;
+}
+
+}  // namespace storage
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "helper/series_codec.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace history {
+namespace detail {
+
+[[nodiscard]] inline unsigned CountLeadingZeros(uint64_t value) noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long index = 0;
+  _BitScanReverse64(&index, value);
+  return 63 - static_cast<unsigned>(index);
+#elif defined(_MSC_VER)
+  unsigned long index = 0;
+  if (_BitScanReverse(&index, static_cast<unsigned long>(value >> 32))) {
+    return 31 - static_cast<unsigned>(index);
+  }
+  _BitScanReverse(&index, static_cast<unsigned long>(value));
+  return 63 - static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_clzll(value));
+#endif
+}
+
+[[nodiscard]] inline unsigned CountTrailingZeros(uint64_t value) noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long index = 0;
+  _BitScanForward64(&index, value);
+  return static_cast<unsigned>(index);
+#elif defined(_MSC_VER)
+  unsigned long index = 0;
+  if (_BitScanForward(&index, static_cast<unsigned long>(value))) {
+    return static_cast<unsigned>(index);
+  }
+  _BitScanForward(&index, static_cast<unsigned long>(value >> 32));
+  return 32 + static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+}
+
+[[nodiscard]] inline uint64_t DoubleToBits(double value) noexcept {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// Negative zero compares equal to 0 but would decode as +0, so it stays on the float path.
+[[nodiscard]] inline bool IsExactInteger(double value) noexcept {
+  return std::fabs(value) <= kMaxExactInteger && std::trunc(value) == value && !(value == 0.0 && std::signbit(value));
+}
+}  // namespace detail
+
+void SeriesBlock::Clear() noexcept {
+  m_bytes.clear();
+  m_bitCount = 0;
+  m_count = 0;
+  m_encoding = ValueEncoding::Float;
+  m_firstTimestamp = 0;
+  m_lastTimestamp = 0;
+  m_lastDelta = 0;
+  m_lastBits = 0;
+  m_lastInteger = 0;
+  m_leading = detail::kNoWindow;
+  m_trailing = 0;
+}
+
+bool SeriesBlock::Accepts(double value) const noexcept {
+  return m_count == 0 || m_encoding == ValueEncoding::Float || detail::IsExactInteger(value);
+}
+
+void SeriesBlock::WriteBits(uint64_t value, unsigned count) {
+  while (count > 0) {
+    const unsigned used = static_cast<unsigned>(m_bitCount % 8);
+    if (used == 0) {
+      m_bytes.push_back(0);
+    }
+    const unsigned available = 8 - used;
+    const unsigned take = count < available ? count : available;
+    const auto chunk = static_cast<uint8_t>((value >> (count - take)) & ((1u << take) - 1));
+    m_bytes.back() |= static_cast<uint8_t>(chunk << (available - take));
+    m_bitCount += take;
+    count -= take;
+  }
+}
+
+void SeriesBlock::WriteTimestamp(int64_t timestamp) {
+  const int64_t delta = timestamp - m_lastTimestamp;
+  const int64_t deltaOfDelta = delta - m_lastDelta;
+
+  if (deltaOfDelta == 0) {
+    WriteBits(0b0, 1);
+  } else if (deltaOfDelta >= -63 && deltaOfDelta <= 64) {
+    WriteBits(0b10, 2);
+    WriteBits(static_cast<uint64_t>(deltaOfDelta + 63), 7);
+  } else if (deltaOfDelta >= -255 && deltaOfDelta <= 256) {
+    WriteBits(0b110, 3);
+    WriteBits(static_cast<uint64_t>(deltaOfDelta + 255), 9);
+  } else if (deltaOfDelta >= -2047 && deltaOfDelta <= 2048) {
+    WriteBits(0b1110, 4);
+    WriteBits(static_cast<uint64_t>(deltaOfDelta + 2047), 12);
+  } else if (deltaOfDelta >= INT32_MIN && deltaOfDelta <= INT32_MAX) {
+    WriteBits(0b11110, 5);
+    WriteBits(static_cast<uint32_t>(static_cast<int32_t>(deltaOfDelta)), 32);
+  } else {
+    WriteBits(0b11111, 5);
+    WriteBits(static_cast<uint64_t>(deltaOfDelta), 64);
+  }
+  m_lastDelta = delta;
+}
+
+void SeriesBlock::WriteFloat(double value) {
+  const uint64_t bits = detail::DoubleToBits(value);
+  const uint64_t xorValue = bits ^ m_lastBits;
+  m_lastBits = bits;
+  if (xorValue == 0) {
+    WriteBits(0b0, 1);
+    return;
+  }
+
+  unsigned leading = detail::CountLeadingZeros(xorValue);
+  const unsigned trailing = detail::CountTrailingZeros(xorValue);
+  if (leading > 31) {
+    leading = 31;
+  }
+
+  if (m_leading != detail::kNoWindow && leading >= m_leading && trailing >= m_trailing) {
+    WriteBits(0b10, 2);
+    WriteBits(xorValue >> m_trailing, 64 - m_leading - m_trailing);
+    return;
+  }
+
+  const unsigned meaningful = 64 - leading - trailing;
+  WriteBits(0b11, 2);
+  WriteBits(leading, 5);
+  WriteBits(meaningful - 1, 6);
+  WriteBits(xorValue >> trailing, meaningful);
+  m_leading = static_cast<uint8_t>(leading);
+  m_trailing = static_cast<uint8_t>(trailing);
+}
+
+void SeriesBlock::WriteInteger(int64_t value) {
+  const int64_t delta = value - m_lastInteger;
+  m_lastInteger = value;
+
+  uint64_t zigzag = (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63);
+  while (zigzag >= 0x80) {
+    WriteBits((zigzag & 0x7F) | 0x80, 8);
+    zigzag >>= 7;
+  }
+  WriteBits(zigzag, 8);
+}
+
+void SeriesBlock::Append(int64_t timestamp, double value) {
+  // Reserving the worst case up front means a failed allocation leaves the block untouched.
+  if (m_bytes.capacity() - m_bytes.size() < detail::kMaxSampleBytes) {
+    m_bytes.reserve(std::max(m_bytes.capacity() * 2, m_bytes.size() + detail::kMaxSampleBytes));
+  }
+
+  if (m_count == 0) {
+    m_encoding = detail::IsExactInteger(value) ? ValueEncoding::Integer : ValueEncoding::Float;
+    m_firstTimestamp = timestamp;
+    m_lastTimestamp = timestamp;
+    WriteBits(static_cast<uint64_t>(timestamp), 64);
+    if (m_encoding == ValueEncoding::Integer) {
+      m_lastInteger = static_cast<int64_t>(value);
+      WriteBits(static_cast<uint64_t>(m_lastInteger), 64);
+    } else {
+      m_lastBits = detail::DoubleToBits(value);
+      WriteBits(m_lastBits, 64);
+    }
+    ++m_count;
+    return;
+  }
+
+  WriteTimestamp(timestamp);
+  if (m_encoding == ValueEncoding::Integer) {
+    WriteInteger(static_cast<int64_t>(value));
+  } else {
+    WriteFloat(value);
+  }
+  m_lastTimestamp = timestamp;
+  ++m_count;
+}
+
+}  // namespace history
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "helper/shared_snapshot.hpp"
+
+#include <cstring>
+
+namespace shm {
+namespace detail {
+
+[[nodiscard]] bool IsProcessAlive(DWORD processId) noexcept {
+  if (processId == 0) {
+    return false;
+  }
+  HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, processId);
+  if (!process) {
+    return ::GetLastError() == ERROR_ACCESS_DENIED;
+  }
+  DWORD exitCode = 0;
+  const bool alive = GetExitCodeProcess(process, &exitCode) && exitCode == STILL_ACTIVE;
+  CloseHandle(process);
+  return alive;
+}
+
+[[nodiscard]] bool IsValidRegion(const NysysShmHeader *header) noexcept {
+  MEMORY_BASIC_INFORMATION region{};
+  return VirtualQuery(header, &region, sizeof(region)) != 0 && header->magic == NYSYS_SHM_MAGIC &&
+         header->layoutVersion == NYSYS_SHM_LAYOUT_VERSION && header->headerSize == NYSYS_SHM_HEADER_SIZE &&
+         header->capacity <= region.RegionSize - NYSYS_SHM_HEADER_SIZE;
+}
+}  // namespace detail
+
+SnapshotPublisher::~SnapshotPublisher() { Close(); }
+
+SharedError SnapshotPublisher::Open(const std::string &name, size_t capacity) noexcept {
+  if (name.empty() || name.size() > detail::kMaxSharedNameLength) {
+    return SharedError::InvalidName;
+  }
+  if (capacity < detail::kMinSharedCapacity || capacity > detail::kMaxSharedCapacity) {
+    return SharedError::InvalidOptions;
+  }
+  Close();
+
+  const uint64_t size = NYSYS_SHM_HEADER_SIZE + static_cast<uint64_t>(capacity);
+  m_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32),
+                                 static_cast<DWORD>(size & 0xFFFFFFFFu), name.c_str());
+  if (!m_mapping) {
+    return SharedError::CreateFailed;
+  }
+  const bool existing = ::GetLastError() == ERROR_ALREADY_EXISTS;
+
+  m_header = static_cast<NysysShmHeader *>(MapViewOfFile(m_mapping, FILE_MAP_WRITE, 0, 0, 0));
+  if (!m_header) {
+    Close();
+    return SharedError::MapFailed;
+  }
+
+  // Readers keep a region alive across publisher restarts; a region left by a dead publisher is taken over and its
+  // sequence continued, so attached readers see the next version instead of having to reopen.
+  if (existing) {
+    if (!detail::IsValidRegion(m_header) ||
+        (m_header->writerProcessId != GetCurrentProcessId() && detail::IsProcessAlive(m_header->writerProcessId))) {
+      UnmapViewOfFile(m_header);
+      m_header = nullptr;
+      Close();
+      return SharedError::InUse;
+    }
+    if (m_header->sequence & 1) {
+      InterlockedIncrement64(&m_header->sequence);
+    }
+  } else {
+    m_header->magic = NYSYS_SHM_MAGIC;
+    m_header->layoutVersion = NYSYS_SHM_LAYOUT_VERSION;
+    m_header->headerSize = NYSYS_SHM_HEADER_SIZE;
+    m_header->capacity = capacity;
+    m_header->sequence = 0;
+  }
+
+  m_header->writerProcessId = GetCurrentProcessId();
+  m_payload = reinterpret_cast<uint8_t *>(m_header) + NYSYS_SHM_HEADER_SIZE;
+  m_capacity = static_cast<size_t>(m_header->capacity);
+  return SharedError::Success;
+}
+
+void SnapshotPublisher::Close() noexcept {
+  if (m_header) {
+    m_header->writerProcessId = 0;
+    UnmapViewOfFile(m_header);
+    m_header = nullptr;
+  }
+  if (m_mapping) {
+    CloseHandle(m_mapping);
+    m_mapping = nullptr;
+  }
+  m_payload = nullptr;
+  m_capacity = 0;
+}
+
+bool SnapshotPublisher::IsOpen() const noexcept { return m_header != nullptr; }
+
+SharedError SnapshotPublisher::Publish(std::string_view payload, int32_t format, int64_t timestampMs) noexcept {
+  if (!m_header) {
+    return SharedError::NotOpen;
+  }
+  if (payload.size() > m_capacity) {
+    ++m_droppedCount;
+    return SharedError::PayloadTooLarge;
+  }
+
+  const LONG64 sequence = m_header->sequence;
+  InterlockedExchange64(&m_header->sequence, sequence + 1);
+  std::memcpy(m_payload, payload.data(), payload.size());
+  m_header->size = payload.size();
+  m_header->timestampMs = timestampMs;
+  m_header->format = format;
+  InterlockedExchange64(&m_header->sequence, sequence + 2);
+  return SharedError::Success;
+}
+
+uint64_t SnapshotPublisher::GetVersion() const noexcept {
+  return m_header ? static_cast<uint64_t>(m_header->sequence) / 2 : 0;
+}
+
+uint64_t SnapshotPublisher::GetDroppedCount() const noexcept { return m_droppedCount; }
+
+size_t SnapshotPublisher::GetCapacity() const noexcept { return m_capacity; }
+
+}  // namespace shm
\ No newline at end of file
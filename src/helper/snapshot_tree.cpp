@@ -0,0 +1,595 @@
+#include "helper/snapshot_tree.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace json {
+namespace detail {
+
+[[nodiscard]] bool LeafEquals(const SnapshotTree &previousTree, const SnapshotNode &previous,
+                              const SnapshotTree &currentTree, const SnapshotNode &current) noexcept {
+  switch (current.type) {
+    case SnapshotNodeType::Bool:
+      return previous.boolValue == current.boolValue;
+    case SnapshotNodeType::Integer:
+      return previous.intValue == current.intValue;
+    case SnapshotNodeType::Unsigned:
+      return previous.uintValue == current.uintValue;
+    case SnapshotNodeType::Double:
+      return previous.doubleValue == current.doubleValue;
+    case SnapshotNodeType::String:
+      return previousTree.GetString(previous) == currentTree.GetString(current);
+    default:
+      return true;
+  }
+}
+
+[[nodiscard]] bool SubtreeEquals(const SnapshotTree &previousTree, size_t previousIndex,
+                                 const SnapshotTree &currentTree, size_t currentIndex) noexcept {
+  const auto &previousNodes = previousTree.GetNodes();
+  const auto &currentNodes = currentTree.GetNodes();
+  const size_t count = previousNodes[previousIndex].end - previousIndex;
+  if (currentNodes[currentIndex].end - currentIndex != count) {
+    return false;
+  }
+
+  for (size_t offset = 0; offset < count; ++offset) {
+    const auto &previous = previousNodes[previousIndex + offset];
+    const auto &current = currentNodes[currentIndex + offset];
+    if (previous.type != current.type ||
+        previous.end - (previousIndex + offset) != current.end - (currentIndex + offset) ||
+        previousTree.GetKey(previous) != currentTree.GetKey(current) ||
+        !LeafEquals(previousTree, previous, currentTree, current)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Writer>
+void WriteNode(Writer &writer, const SnapshotTree &tree, size_t index) {
+  const auto &nodes = tree.GetNodes();
+  const auto &node = nodes[index];
+
+  switch (node.type) {
+    case SnapshotNodeType::Null:
+      writer.Null();
+      break;
+    case SnapshotNodeType::Bool:
+      writer.Value(node.boolValue);
+      break;
+    case SnapshotNodeType::Integer:
+      writer.Value(node.intValue);
+      break;
+    case SnapshotNodeType::Unsigned:
+      writer.Value(node.uintValue);
+      break;
+    case SnapshotNodeType::Double:
+      writer.Value(node.doubleValue);
+      break;
+    case SnapshotNodeType::String:
+      writer.Value(tree.GetString(node));
+      break;
+    case SnapshotNodeType::Object:
+      writer.BeginObject();
+      for (size_t child = index + 1; child < node.end; child = nodes[child].end) {
+        writer.Key(tree.GetKey(nodes[child]));
+        WriteNode(writer, tree, child);
+      }
+      writer.EndObject();
+      break;
+    case SnapshotNodeType::Array:
+      writer.BeginArray();
+      for (size_t child = index + 1; child < node.end; child = nodes[child].end) {
+        WriteNode(writer, tree, child);
+      }
+      writer.EndArray();
+      break;
+  }
+}
+
+// Object members are emitted in sorted key order, so both trees can be walked as a merge.
+template <typename Writer>
+bool WriteObjectPatch(Writer &writer, const SnapshotTree &previousTree, size_t previousIndex,
+                      const SnapshotTree &currentTree, size_t currentIndex) {
+  const auto &previousNodes = previousTree.GetNodes();
+  const auto &currentNodes = currentTree.GetNodes();
+  const size_t previousEnd = previousNodes[previousIndex].end;
+  const size_t currentEnd = currentNodes[currentIndex].end;
+  size_t previousChild = previousIndex + 1;
+  size_t currentChild = currentIndex + 1;
+  bool changed = false;
+
+  writer.BeginObject();
+
+  while (previousChild < previousEnd || currentChild < currentEnd) {
+    const bool hasPrevious = previousChild < previousEnd;
+    const bool hasCurrent = currentChild < currentEnd;
+    const auto previousKey = hasPrevious ? previousTree.GetKey(previousNodes[previousChild]) : std::string_view{};
+    const auto currentKey = hasCurrent ? currentTree.GetKey(currentNodes[currentChild]) : std::string_view{};
+
+    if (!hasCurrent || (hasPrevious && previousKey < currentKey)) {
+      writer.Key(previousKey);
+      writer.Null();
+      previousChild = previousNodes[previousChild].end;
+      changed = true;
+      continue;
+    }
+
+    if (!hasPrevious || currentKey < previousKey) {
+      writer.Key(currentKey);
+      WriteNode(writer, currentTree, currentChild);
+      currentChild = currentNodes[currentChild].end;
+      changed = true;
+      continue;
+    }
+
+    const auto &previous = previousNodes[previousChild];
+    const auto &current = currentNodes[currentChild];
+    if (previous.type == SnapshotNodeType::Object && current.type == SnapshotNodeType::Object) {
+      const auto checkpoint = writer.Save();
+      writer.Key(currentKey);
+      if (WriteObjectPatch(writer, previousTree, previousChild, currentTree, currentChild)) {
+        changed = true;
+      } else {
+        writer.Restore(checkpoint);
+      }
+    } else if (!SubtreeEquals(previousTree, previousChild, currentTree, currentChild)) {
+      writer.Key(currentKey);
+      WriteNode(writer, currentTree, currentChild);
+      changed = true;
+    }
+
+    previousChild = previous.end;
+    currentChild = current.end;
+  }
+
+  writer.EndObject();
+  return changed;
+}
+
+// True when the object at index, or an object nested in it without an array in between, has a null member. A merge
+// patch reads such a member as a removal, so that subtree cannot travel inside a patch.
+[[nodiscard]] bool HasNullMember(const SnapshotTree &tree, size_t index) noexcept {
+  const auto &nodes = tree.GetNodes();
+  if (nodes[index].type != SnapshotNodeType::Object) {
+    return false;
+  }
+  for (size_t child = index + 1; child < nodes[index].end; child = nodes[child].end) {
+    if (nodes[child].type == SnapshotNodeType::Null || HasNullMember(tree, child)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Mirrors the walk in WriteObjectPatch and fails on any member the patch would write as a null value.
+[[nodiscard]] bool IsObjectPatchLossless(const SnapshotTree &previousTree, size_t previousIndex,
+                                         const SnapshotTree &currentTree, size_t currentIndex) noexcept {
+  const auto &previousNodes = previousTree.GetNodes();
+  const auto &currentNodes = currentTree.GetNodes();
+  const size_t previousEnd = previousNodes[previousIndex].end;
+  const size_t currentEnd = currentNodes[currentIndex].end;
+  size_t previousChild = previousIndex + 1;
+  size_t currentChild = currentIndex + 1;
+
+  while (currentChild < currentEnd) {
+    const auto &current = currentNodes[currentChild];
+    const auto currentKey = currentTree.GetKey(current);
+    while (previousChild < previousEnd && previousTree.GetKey(previousNodes[previousChild]) < currentKey) {
+      previousChild = previousNodes[previousChild].end;
+    }
+
+    const bool matched = previousChild < previousEnd && previousTree.GetKey(previousNodes[previousChild]) == currentKey;
+    if (matched && previousNodes[previousChild].type == SnapshotNodeType::Object &&
+        current.type == SnapshotNodeType::Object) {
+      if (!IsObjectPatchLossless(previousTree, previousChild, currentTree, currentChild)) {
+        return false;
+      }
+    } else if (!matched || !SubtreeEquals(previousTree, previousChild, currentTree, currentChild)) {
+      if (current.type == SnapshotNodeType::Null || HasNullMember(currentTree, currentChild)) {
+        return false;
+      }
+    }
+
+    if (matched) {
+      previousChild = previousNodes[previousChild].end;
+    }
+    currentChild = current.end;
+  }
+  return true;
+}
+
+template <typename Writer>
+void WriteTree(Writer &writer, const SnapshotTree &tree) {
+  if (tree.IsEmpty()) {
+    writer.Null();
+    return;
+  }
+  WriteNode(writer, tree, 0);
+}
+
+template <typename Writer>
+void WritePatch(Writer &writer, const SnapshotTree &previous, const SnapshotTree &current) {
+  if (previous.IsEmpty() || current.IsEmpty() || previous.GetNodes().front().type != SnapshotNodeType::Object ||
+      current.GetNodes().front().type != SnapshotNodeType::Object) {
+    WriteTree(writer, current);
+    return;
+  }
+  static_cast<void>(WriteObjectPatch(writer, previous, 0, current, 0));
+}
+}  // namespace detail
+
+SnapshotTree::SnapshotTree() {
+  m_nodes.reserve(detail::kInitialTreeNodes);
+  m_strings.reserve(detail::kInitialTreeStrings);
+}
+
+void SnapshotTree::Reset() noexcept {
+  m_nodes.clear();
+  m_strings.clear();
+  m_depth = 0;
+  m_keyOffset = 0;
+  m_keyLength = 0;
+  m_afterKey = false;
+  m_valid = true;
+}
+
+uint32_t SnapshotTree::StoreString(std::string_view value) {
+  if (m_strings.size() + value.size() > std::numeric_limits<uint32_t>::max()) {
+    throw std::length_error("Snapshot string pool exhausted");
+  }
+  if (!IsValidUtf8(value)) {
+    m_valid = false;
+  }
+
+  const auto offset = static_cast<uint32_t>(m_strings.size());
+  m_strings.append(value.data(), value.size());
+  return offset;
+}
+
+SnapshotNode &SnapshotTree::AddNode(SnapshotNodeType type) {
+  if (m_depth > 0 && m_nodes[m_stack[m_depth]].type == SnapshotNodeType::Object && !m_afterKey) {
+    throw std::logic_error("Object member written without key");
+  }
+
+  SnapshotNode node;
+  node.type = type;
+  node.end = static_cast<uint32_t>(m_nodes.size() + 1);
+  if (m_afterKey) {
+    node.keyOffset = m_keyOffset;
+    node.keyLength = m_keyLength;
+    m_afterKey = false;
+  }
+
+  m_nodes.push_back(node);
+  return m_nodes.back();
+}
+
+void SnapshotTree::PushContainer(SnapshotNodeType type) {
+  if (m_depth + 1 >= detail::kMaxTreeDepth) {
+    throw std::length_error("Snapshot nesting depth exceeded");
+  }
+
+  AddNode(type);
+  ++m_depth;
+  m_stack[m_depth] = static_cast<uint32_t>(m_nodes.size() - 1);
+}
+
+void SnapshotTree::PopContainer(SnapshotNodeType type) {
+  if (m_depth == 0 || m_nodes[m_stack[m_depth]].type != type || m_afterKey) {
+    throw std::logic_error("Unbalanced snapshot container");
+  }
+
+  m_nodes[m_stack[m_depth]].end = static_cast<uint32_t>(m_nodes.size());
+  --m_depth;
+}
+
+void SnapshotTree::BeginObject() { PushContainer(SnapshotNodeType::Object); }
+
+void SnapshotTree::EndObject() { PopContainer(SnapshotNodeType::Object); }
+
+void SnapshotTree::BeginArray() { PushContainer(SnapshotNodeType::Array); }
+
+void SnapshotTree::EndArray() { PopContainer(SnapshotNodeType::Array); }
+
+void SnapshotTree::Key(std::string_view key) {
+  if (m_depth == 0 || m_nodes[m_stack[m_depth]].type != SnapshotNodeType::Object || m_afterKey) {
+    throw std::logic_error("Key written outside of an object");
+  }
+
+  m_keyOffset = StoreString(key);
+  m_keyLength = static_cast<uint32_t>(key.size());
+  m_afterKey = true;
+}
+
+void SnapshotTree::Value(std::string_view value) {
+  const uint32_t offset = StoreString(value);
+  auto &node = AddNode(SnapshotNodeType::String);
+  node.stringOffset = offset;
+  node.stringLength = static_cast<uint32_t>(value.size());
+}
+
+void SnapshotTree::Value(bool value) { AddNode(SnapshotNodeType::Bool).boolValue = value; }
+
+void SnapshotTree::Value(double value) {
+  if (!std::isfinite(value)) {
+    Null();
+    return;
+  }
+  AddNode(SnapshotNodeType::Double).doubleValue = value;
+}
+
+void SnapshotTree::Null() { AddNode(SnapshotNodeType::Null); }
+
+void SnapshotTree::AppendSubtree(const SnapshotTree &source, size_t index) {
+  const auto &sourceNodes = source.m_nodes;
+  if (index >= sourceNodes.size()) {
+    throw std::out_of_range("Snapshot subtree index out of range");
+  }
+
+  const size_t end = sourceNodes[index].end;
+  const size_t base = m_nodes.size();
+
+  for (size_t i = index; i < end; ++i) {
+    const auto &sourceNode = sourceNodes[i];
+    const uint32_t keyOffset = i == index ? 0 : StoreString(source.GetKey(sourceNode));
+    const uint32_t stringOffset =
+        sourceNode.type == SnapshotNodeType::String ? StoreString(source.GetString(sourceNode)) : 0;
+
+    if (i == index) {
+      AddNode(sourceNode.type);
+    } else {
+      m_nodes.push_back(SnapshotNode{});
+      m_nodes.back().keyOffset = keyOffset;
+      m_nodes.back().keyLength = sourceNode.keyLength;
+    }
+
+    auto &node = m_nodes.back();
+    node.type = sourceNode.type;
+    node.boolValue = sourceNode.boolValue;
+    node.stringOffset = stringOffset;
+    node.stringLength = sourceNode.stringLength;
+    node.end = static_cast<uint32_t>(sourceNode.end - index + base);
+    node.intValue = sourceNode.intValue;
+    node.uintValue = sourceNode.uintValue;
+    node.doubleValue = sourceNode.doubleValue;
+  }
+}
+
+// Splices a complete tree into the finished root object at its sorted key position, so merge patches and binary
+// encodings see the same member order as a tree written in one pass.
+void SnapshotTree::InsertField(std::string_view key, const SnapshotTree &value) {
+  if (m_nodes.empty() || m_nodes.front().type != SnapshotNodeType::Object || !IsValid() || value.m_nodes.empty() ||
+      value.m_depth != 0) {
+    throw std::logic_error("Snapshot field inserted outside a complete object");
+  }
+
+  const size_t rootEnd = m_nodes.front().end;
+  size_t position = rootEnd;
+  for (size_t child = 1; child < rootEnd; child = m_nodes[child].end) {
+    const auto childKey = GetKey(m_nodes[child]);
+    if (childKey == key) {
+      throw std::logic_error("Duplicate snapshot key");
+    }
+    if (childKey > key) {
+      position = child;
+      break;
+    }
+  }
+
+  const size_t count = value.m_nodes.front().end;
+  if (m_nodes.size() + count > std::numeric_limits<uint32_t>::max()) {
+    throw std::length_error("Snapshot node count exhausted");
+  }
+
+  const uint32_t keyOffset = StoreString(key);
+  const uint32_t stringBase = StoreString(value.m_strings);
+  m_valid = m_valid && value.m_valid;
+  m_nodes.insert(m_nodes.begin() + static_cast<ptrdiff_t>(position), value.m_nodes.begin(),
+                 value.m_nodes.begin() + static_cast<ptrdiff_t>(count));
+
+  m_nodes.front().end += static_cast<uint32_t>(count);
+  for (size_t i = position + count; i < m_nodes.size(); ++i) {
+    m_nodes[i].end += static_cast<uint32_t>(count);
+  }
+  for (size_t i = position; i < position + count; ++i) {
+    auto &node = m_nodes[i];
+    node.keyOffset = i == position ? keyOffset : node.keyOffset + stringBase;
+    node.keyLength = i == position ? static_cast<uint32_t>(key.size()) : node.keyLength;
+    node.stringOffset += stringBase;
+    node.end += static_cast<uint32_t>(position);
+  }
+}
+
+SnapshotTree::Checkpoint SnapshotTree::Save() const noexcept {
+  return Checkpoint{m_nodes.size(), m_strings.size(), m_depth, m_afterKey, m_keyOffset, m_keyLength};
+}
+
+void SnapshotTree::Restore(const Checkpoint &checkpoint) noexcept {
+  if (checkpoint.size <= m_nodes.size()) {
+    m_nodes.resize(checkpoint.size);
+  }
+  if (checkpoint.stringSize <= m_strings.size()) {
+    m_strings.resize(checkpoint.stringSize);
+  }
+  m_depth = checkpoint.depth;
+  m_afterKey = checkpoint.afterKey;
+  m_keyOffset = checkpoint.keyOffset;
+  m_keyLength = checkpoint.keyLength;
+}
+
+const std::vector<SnapshotNode> &SnapshotTree::GetNodes() const noexcept { return m_nodes; }
+
+std::string_view SnapshotTree::GetKey(const SnapshotNode &node) const noexcept {
+  return std::string_view{m_strings}.substr(node.keyOffset, node.keyLength);
+}
+
+std::string_view SnapshotTree::GetString(const SnapshotNode &node) const noexcept {
+  return std::string_view{m_strings}.substr(node.stringOffset, node.stringLength);
+}
+
+bool SnapshotTree::IsEmpty() const noexcept { return m_nodes.empty(); }
+
+bool SnapshotTree::IsValid() const noexcept { return m_valid && m_depth == 0 && !m_afterKey; }
+
+void SnapshotTree::Swap(SnapshotTree &other) noexcept {
+  std::swap(m_nodes, other.m_nodes);
+  std::swap(m_strings, other.m_strings);
+  std::swap(m_stack, other.m_stack);
+  std::swap(m_depth, other.m_depth);
+  std::swap(m_keyOffset, other.m_keyOffset);
+  std::swap(m_keyLength, other.m_keyLength);
+  std::swap(m_afterKey, other.m_afterKey);
+  std::swap(m_valid, other.m_valid);
+}
+
+std::optional<size_t> FindChild(const SnapshotTree &tree, size_t index, std::string_view segment) noexcept {
+  const auto &nodes = tree.GetNodes();
+  const auto &parent = nodes[index];
+  size_t arrayIndex = 0;
+  if (parent.type == SnapshotNodeType::Array) {
+    const auto *first = segment.data();
+    const auto *last = first + segment.size();
+    const auto [ptr, ec] = std::from_chars(first, last, arrayIndex);
+    if (ec != std::errc{} || ptr != last || segment.empty()) {
+      return std::nullopt;
+    }
+  } else if (parent.type != SnapshotNodeType::Object) {
+    return std::nullopt;
+  }
+
+  size_t position = 0;
+  for (size_t child = index + 1; child < parent.end; child = nodes[child].end, ++position) {
+    if (parent.type == SnapshotNodeType::Array ? position == arrayIndex : tree.GetKey(nodes[child]) == segment) {
+      return child;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<size_t> FindNode(const SnapshotTree &tree, const PointerSegments &path) noexcept {
+  if (tree.GetNodes().empty()) {
+    return std::nullopt;
+  }
+
+  size_t index = 0;
+  for (const auto &segment : path) {
+    const auto found = FindChild(tree, index, segment);
+    if (!found) {
+      return std::nullopt;
+    }
+    index = *found;
+  }
+  return index;
+}
+
+void PointerResolver::Compile(const std::vector<PointerSegments> &paths) {
+  std::vector<size_t> order(paths.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&paths](size_t left, size_t right) { return paths[left] < paths[right]; });
+
+  // Sorted paths visit the prefix trie in preorder, so each step can be closed as soon as the prefix changes.
+  std::vector<Step> steps(1);
+  std::vector<size_t> targets(paths.size());
+  std::vector<size_t> stack{0};
+  const PointerSegments *previous = nullptr;
+  for (const size_t i : order) {
+    const auto &path = paths[i];
+    size_t common = 0;
+    while (previous && common < path.size() && common < previous->size() && path[common] == (*previous)[common]) {
+      ++common;
+    }
+    while (stack.size() > common + 1) {
+      steps[stack.back()].end = steps.size();
+      stack.pop_back();
+    }
+    for (size_t depth = common; depth < path.size(); ++depth) {
+      steps.push_back(Step{path[depth], 0});
+      stack.push_back(steps.size() - 1);
+    }
+    targets[i] = stack.back();
+    previous = &path;
+  }
+  for (const size_t step : stack) {
+    steps[step].end = steps.size();
+  }
+
+  m_found.assign(steps.size(), detail::kUnresolvedNode);
+  m_steps.swap(steps);
+  m_targets.swap(targets);
+}
+
+void PointerResolver::Clear() noexcept {
+  m_steps.clear();
+  m_targets.clear();
+  m_found.clear();
+}
+
+void PointerResolver::Resolve(const SnapshotTree &tree) noexcept {
+  std::fill(m_found.begin(), m_found.end(), detail::kUnresolvedNode);
+  if (m_steps.empty() || tree.GetNodes().empty()) {
+    return;
+  }
+  m_found[0] = 0;
+  ResolveStep(tree, 0, 0);
+}
+
+void PointerResolver::ResolveStep(const SnapshotTree &tree, size_t step, size_t index) noexcept {
+  for (size_t child = step + 1; child < m_steps[step].end; child = m_steps[child].end) {
+    if (const auto found = FindChild(tree, index, m_steps[child].segment)) {
+      m_found[child] = *found;
+      ResolveStep(tree, child, *found);
+    }
+  }
+}
+
+std::optional<size_t> PointerResolver::GetIndex(size_t path) const noexcept {
+  const size_t found = m_found[m_targets[path]];
+  return found == detail::kUnresolvedNode ? std::nullopt : std::optional<size_t>{found};
+}
+
+size_t PointerResolver::GetPathCount() const noexcept { return m_targets.size(); }
+
+std::optional<double> GetNumber(const SnapshotNode &node) noexcept {
+  switch (node.type) {
+    case SnapshotNodeType::Integer:
+      return static_cast<double>(node.intValue);
+    case SnapshotNodeType::Unsigned:
+      return static_cast<double>(node.uintValue);
+    case SnapshotNodeType::Double:
+      return node.doubleValue;
+    case SnapshotNodeType::Bool:
+      return node.boolValue ? 1.0 : 0.0;
+    default:
+      return std::nullopt;
+  }
+}
+
+void WriteSnapshotTree(JsonWriter &writer, const SnapshotTree &tree) { detail::WriteTree(writer, tree); }
+
+void WriteSnapshotTree(BinaryWriter &writer, const SnapshotTree &tree) { detail::WriteTree(writer, tree); }
+
+void WriteMergePatch(JsonWriter &writer, const SnapshotTree &previous, const SnapshotTree &current) {
+  detail::WritePatch(writer, previous, current);
+}
+
+void WriteMergePatch(BinaryWriter &writer, const SnapshotTree &previous, const SnapshotTree &current) {
+  detail::WritePatch(writer, previous, current);
+}
+
+bool IsMergePatchLossless(const SnapshotTree &previous, const SnapshotTree &current) noexcept {
+  if (previous.IsEmpty() || current.IsEmpty() || previous.GetNodes().front().type != SnapshotNodeType::Object ||
+      current.GetNodes().front().type != SnapshotNodeType::Object) {
+    return true;
+  }
+  return detail::IsObjectPatchLossless(previous, 0, current, 0);
+}
+
+}  // namespace json
\ No newline at end of file
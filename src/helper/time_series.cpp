@@ -0,0 +1,366 @@
+#include "helper/time_series.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace history {
+namespace detail {
+
+[[nodiscard]] Point ToPoint(int64_t start, double min, double max, double sum, double last, uint32_t count) noexcept {
+  return Point{start, min, max, count > 0 ? sum / count : 0.0, last, count};
+}
+
+[[nodiscard]] bool IsValidCapacities(const HistoryCapacities &capacities) noexcept {
+  return std::all_of(capacities.begin(), capacities.end(),
+                     [](size_t capacity) { return capacity > 0 && capacity <= kMaxHistoryCapacity; });
+}
+}  // namespace detail
+
+void SampleRing::Allocate(size_t capacity) {
+  m_blocks.clear();
+  m_blocks.resize(detail::RawBlockCount(capacity));
+  m_head = 0;
+  m_size = 0;
+  m_capacity = capacity;
+  m_count = 0;
+  m_headSkip = 0;
+}
+
+size_t SampleRing::Slot(size_t position) const noexcept { return (m_head + position) % m_blocks.size(); }
+
+void SampleRing::DropHeadBlock() noexcept {
+  m_count -= m_blocks[m_head].GetCount() - m_headSkip;
+  m_head = (m_head + 1) % m_blocks.size();
+  m_headSkip = 0;
+  --m_size;
+}
+
+void SampleRing::Push(int64_t timestamp, double value) noexcept {
+  if (m_blocks.empty() || m_capacity == 0) {
+    return;
+  }
+
+  if (m_size == 0) {
+    m_size = 1;
+    m_blocks[Slot(0)].Clear();
+  } else {
+    const auto &active = m_blocks[Slot(m_size - 1)];
+    if (active.GetCount() >= detail::kSamplesPerBlock || !active.Accepts(value)) {
+      // RawBlockCount leaves enough slots for this not to happen; it only keeps the ring consistent if it does.
+      if (m_size == m_blocks.size()) {
+        DropHeadBlock();
+      }
+      ++m_size;
+      m_blocks[Slot(m_size - 1)].Clear();
+    }
+  }
+
+  try {
+    m_blocks[Slot(m_size - 1)].Append(timestamp, value);
+  } catch (...) {
+    return;
+  }
+
+  if (++m_count > m_capacity) {
+    --m_count;
+    if (++m_headSkip == m_blocks[m_head].GetCount()) {
+      m_head = (m_head + 1) % m_blocks.size();
+      m_headSkip = 0;
+      --m_size;
+    }
+  }
+}
+
+size_t SampleRing::LowerBound(int64_t timestamp) const noexcept {
+  size_t low = 0;
+  size_t high = m_size;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (m_blocks[Slot(middle)].GetLastTimestamp() < timestamp) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+void SampleRing::Query(int64_t from, int64_t to, std::vector<Point> &points) const {
+  for (size_t position = LowerBound(from); position < m_size; ++position) {
+    const auto &block = m_blocks[Slot(position)];
+    if (block.GetCount() == 0 || block.GetFirstTimestamp() > to) {
+      break;
+    }
+    uint32_t skip = position == 0 ? m_headSkip : 0;
+    block.Decode([from, to, &points, &skip](int64_t timestamp, double value) {
+      if (skip > 0) {
+        --skip;
+      } else if (timestamp >= from && timestamp <= to) {
+        points.push_back(Point{timestamp, value, value, value, value, 1});
+      }
+    });
+  }
+}
+
+size_t SampleRing::GetSampleCount() const noexcept { return m_count; }
+
+size_t SampleRing::GetMemoryUsage() const noexcept {
+  size_t bytes = m_blocks.capacity() * sizeof(SeriesBlock);
+  for (const auto &block : m_blocks) {
+    bytes += block.GetCapacity();
+  }
+  return bytes;
+}
+
+void RollupRing::Allocate(size_t capacity) {
+  m_starts.assign(capacity, 0);
+  m_mins.assign(capacity, 0.0);
+  m_maxs.assign(capacity, 0.0);
+  m_sums.assign(capacity, 0.0);
+  m_lasts.assign(capacity, 0.0);
+  m_counts.assign(capacity, 0);
+  m_head = 0;
+  m_size = 0;
+}
+
+size_t RollupRing::Slot(size_t position) const noexcept { return (m_head + position) % m_starts.size(); }
+
+void RollupRing::Push(const Bucket &bucket) noexcept {
+  const size_t capacity = m_starts.size();
+  if (capacity == 0) {
+    return;
+  }
+
+  size_t slot = 0;
+  if (m_size < capacity) {
+    slot = Slot(m_size++);
+  } else {
+    slot = m_head;
+    m_head = (m_head + 1) % capacity;
+  }
+  m_starts[slot] = bucket.start;
+  m_mins[slot] = bucket.min;
+  m_maxs[slot] = bucket.max;
+  m_sums[slot] = bucket.sum;
+  m_lasts[slot] = bucket.last;
+  m_counts[slot] = bucket.count;
+}
+
+size_t RollupRing::LowerBound(int64_t start) const noexcept {
+  size_t low = 0;
+  size_t high = m_size;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (m_starts[Slot(middle)] < start) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+void RollupRing::Query(int64_t from, int64_t to, std::vector<Point> &points) const {
+  for (size_t position = LowerBound(from); position < m_size; ++position) {
+    const size_t slot = Slot(position);
+    if (m_starts[slot] > to) {
+      break;
+    }
+    points.push_back(
+        detail::ToPoint(m_starts[slot], m_mins[slot], m_maxs[slot], m_sums[slot], m_lasts[slot], m_counts[slot]));
+  }
+}
+
+size_t RollupRing::GetMemoryUsage() const noexcept {
+  return m_starts.capacity() * sizeof(int64_t) +
+         (m_mins.capacity() + m_maxs.capacity() + m_sums.capacity() + m_lasts.capacity()) * sizeof(double) +
+         m_counts.capacity() * sizeof(uint32_t);
+}
+
+MetricSeries::MetricSeries(json::PointerSegments path, const HistoryCapacities &capacities) : m_path(std::move(path)) {
+  m_raw.Allocate(capacities[static_cast<size_t>(Resolution::Raw)]);
+  for (size_t tier = 0; tier < m_rollups.size(); ++tier) {
+    m_rollups[tier].Allocate(capacities[tier + 1]);
+  }
+}
+
+void MetricSeries::Append(int64_t timestamp, double value) noexcept {
+  if (!std::isfinite(value)) {
+    return;
+  }
+  if (m_hasSamples && timestamp < m_lastTimestamp) {
+    timestamp = m_lastTimestamp;
+  }
+  m_lastTimestamp = timestamp;
+  m_hasSamples = true;
+
+  m_raw.Push(timestamp, value);
+
+  // Each tier folds raw samples directly; min/max/sum/last/count merge associatively, so the closed buckets match
+  // a cascade from the finer tier while the open buckets stay exact for queries.
+  for (size_t tier = 0; tier < m_rollups.size(); ++tier) {
+    auto &open = m_open[tier];
+    const int64_t start = detail::BucketStart(timestamp, detail::kBucketWidthsMs[tier + 1]);
+    if (open.count > 0 && open.start != start) {
+      m_rollups[tier].Push(open);
+      open.count = 0;
+    }
+
+    if (open.count == 0) {
+      open = Bucket{start, value, value, value, value, 1};
+      continue;
+    }
+    open.min = std::min(open.min, value);
+    open.max = std::max(open.max, value);
+    open.sum += value;
+    open.last = value;
+    ++open.count;
+  }
+}
+
+void MetricSeries::Query(int64_t from, int64_t to, Resolution resolution, std::vector<Point> &points) const {
+  if (resolution == Resolution::Raw) {
+    m_raw.Query(from, to, points);
+    return;
+  }
+
+  const size_t tier = static_cast<size_t>(resolution) - 1;
+  const int64_t first = detail::BucketStart(from, detail::kBucketWidthsMs[tier + 1]);
+  m_rollups[tier].Query(first, to, points);
+
+  const auto &open = m_open[tier];
+  if (open.count > 0 && open.start >= first && open.start <= to) {
+    points.push_back(detail::ToPoint(open.start, open.min, open.max, open.sum, open.last, open.count));
+  }
+}
+
+const json::PointerSegments &MetricSeries::GetPath() const noexcept { return m_path; }
+
+size_t MetricSeries::GetMemoryUsage() const noexcept {
+  size_t bytes = sizeof(MetricSeries) + m_raw.GetMemoryUsage();
+  for (const auto &rollup : m_rollups) {
+    bytes += rollup.GetMemoryUsage();
+  }
+  return bytes;
+}
+
+size_t EstimateSeriesBytes(const HistoryCapacities &capacities) noexcept {
+  constexpr size_t kBlockBytes = 2 * detail::kSamplesPerBlock * detail::kMaxSampleBytes;
+  constexpr size_t kRollupBytes = sizeof(int64_t) + 4 * sizeof(double) + sizeof(uint32_t);
+
+  // Block buffers grow with the samples they hold, so only the full-block share of the slots needs a full buffer.
+  const size_t rawCapacity = capacities[static_cast<size_t>(Resolution::Raw)];
+  size_t bytes = sizeof(MetricSeries) + detail::RawBlockCount(rawCapacity) * sizeof(SeriesBlock) +
+                 (rawCapacity / detail::kSamplesPerBlock + 2) * kBlockBytes;
+  for (size_t tier = 1; tier < capacities.size(); ++tier) {
+    bytes += capacities[tier] * kRollupBytes;
+  }
+  return bytes;
+}
+
+HistoryError HistoryStore::AddMetric(std::string_view path) noexcept {
+  try {
+    auto segments = json::ParsePointer(path);
+    if (!segments || segments->empty() ||
+        std::find(segments->begin(), segments->end(), json::detail::kPointerWildcard) != segments->end()) {
+      return HistoryError::InvalidPath;
+    }
+
+    for (const auto &series : m_series) {
+      if (series.GetPath() == *segments) {
+        return HistoryError::Success;
+      }
+    }
+
+    if (m_series.size() >= detail::kMaxHistoryMetrics) {
+      return HistoryError::TooManyMetrics;
+    }
+    if ((m_series.size() + 1) * EstimateSeriesBytes(m_capacities) > detail::kMaxHistoryBytes) {
+      return HistoryError::MemoryLimitExceeded;
+    }
+
+    m_series.emplace_back(std::move(*segments), m_capacities);
+    return HistoryError::Success;
+  } catch (...) {
+    return HistoryError::MemoryAllocationFailed;
+  }
+}
+
+void HistoryStore::ClearMetrics() noexcept { m_series.clear(); }
+
+HistoryError HistoryStore::SetCapacities(const HistoryCapacities &capacities) noexcept {
+  if (!detail::IsValidCapacities(capacities)) {
+    return HistoryError::InvalidCapacity;
+  }
+  if (std::max<size_t>(m_series.size(), 1) * EstimateSeriesBytes(capacities) > detail::kMaxHistoryBytes) {
+    return HistoryError::MemoryLimitExceeded;
+  }
+
+  try {
+    std::vector<MetricSeries> series;
+    series.reserve(m_series.size());
+    for (const auto &existing : m_series) {
+      series.emplace_back(existing.GetPath(), capacities);
+    }
+    m_series.swap(series);
+    m_capacities = capacities;
+    return HistoryError::Success;
+  } catch (...) {
+    return HistoryError::MemoryAllocationFailed;
+  }
+}
+
+bool HistoryStore::IsEnabled() const noexcept { return !m_series.empty(); }
+
+void HistoryStore::Record(const json::SnapshotTree &tree, int64_t timestamp) noexcept {
+  const auto &nodes = tree.GetNodes();
+  for (auto &series : m_series) {
+    const auto index = json::FindNode(tree, series.GetPath());
+    if (!index) {
+      continue;
+    }
+    if (const auto value = json::GetNumber(nodes[*index])) {
+      series.Append(timestamp, *value);
+    }
+  }
+}
+
+HistoryError HistoryStore::Query(std::string_view metric, int64_t from, int64_t to, Resolution resolution,
+                                 std::vector<Point> &points) const noexcept {
+  if (static_cast<size_t>(resolution) >= detail::kResolutionCount) {
+    return HistoryError::InvalidResolution;
+  }
+
+  try {
+    const auto segments = json::ParsePointer(metric);
+    if (!segments) {
+      return HistoryError::InvalidPath;
+    }
+
+    for (const auto &series : m_series) {
+      if (series.GetPath() == *segments) {
+        points.clear();
+        if (from <= to) {
+          series.Query(from, to, resolution, points);
+        }
+        return HistoryError::Success;
+      }
+    }
+    return HistoryError::UnknownMetric;
+  } catch (...) {
+    return HistoryError::MemoryAllocationFailed;
+  }
+}
+
+const HistoryCapacities &HistoryStore::GetCapacities() const noexcept { return m_capacities; }
+
+size_t HistoryStore::GetMemoryUsage() const noexcept {
+  size_t bytes = m_series.capacity() * sizeof(MetricSeries);
+  for (const auto &series : m_series) {
+    bytes += series.GetMemoryUsage() - sizeof(MetricSeries);
+  }
+  return bytes;
+}
+
+}  // namespace history
\ No newline at end of file
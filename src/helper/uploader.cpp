@@ -0,0 +1,736 @@
+#include "helper/uploader.hpp"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <optional>
+#include <system_error>
+
+namespace upload {
+namespace detail {
+
+#ifdef _WIN32
+using NativeSocket = SOCKET;
+using PollDescriptor = WSAPOLLFD;
+using TransferLength = int;
+using OptionLength = int;
+constexpr NativeSocket kInvalidSocket = INVALID_SOCKET;
+constexpr int kSendFlags = 0;
+
+[[nodiscard]] int PollSockets(PollDescriptor *descriptors, size_t count, int timeoutMs) noexcept {
+  return WSAPoll(descriptors, static_cast<ULONG>(count), timeoutMs);
+}
+
+void CloseSocket(NativeSocket socket) noexcept { closesocket(socket); }
+
+[[nodiscard]] bool SetNonBlocking(NativeSocket socket) noexcept {
+  u_long mode = 1;
+  return ioctlsocket(socket, FIONBIO, &mode) == 0;
+}
+
+[[nodiscard]] bool WouldBlock() noexcept {
+  const int error = WSAGetLastError();
+  return error == WSAEWOULDBLOCK || error == WSAEINPROGRESS;
+}
+#else
+using NativeSocket = int;
+using PollDescriptor = pollfd;
+using TransferLength = size_t;
+using OptionLength = socklen_t;
+constexpr NativeSocket kInvalidSocket = -1;
+constexpr int kSendFlags = MSG_NOSIGNAL;
+
+[[nodiscard]] int PollSockets(PollDescriptor *descriptors, size_t count, int timeoutMs) noexcept {
+  return poll(descriptors, static_cast<nfds_t>(count), timeoutMs);
+}
+
+void CloseSocket(NativeSocket socket) noexcept { close(socket); }
+
+[[nodiscard]] bool SetNonBlocking(NativeSocket socket) noexcept {
+  const int flags = fcntl(socket, F_GETFL, 0);
+  return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+[[nodiscard]] bool WouldBlock() noexcept {
+  return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR || errno == EINPROGRESS;
+}
+#endif
+
+class Connection {
+public:
+  Connection() = default;
+  ~Connection() noexcept { Reset(kInvalidSocket); }
+
+  Connection(const Connection &) = delete;
+  Connection &operator=(const Connection &) = delete;
+
+  void Reset(NativeSocket socket) noexcept {
+    if (m_socket != kInvalidSocket) {
+      CloseSocket(m_socket);
+    }
+    m_socket = socket;
+  }
+
+  [[nodiscard]] NativeSocket Get() const noexcept { return m_socket; }
+
+private:
+  NativeSocket m_socket = kInvalidSocket;
+};
+
+[[nodiscard]] int64_t NowMs() noexcept {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Waits in short slices so a Wake during a stalled connect, send or receive is noticed promptly.
+[[nodiscard]] bool WaitSocket(NativeSocket socket, short events, int64_t timeoutMs,
+                              const std::atomic<bool> &interrupted) noexcept {
+  const int64_t deadline = NowMs() + timeoutMs;
+  while (!interrupted) {
+    const int64_t remaining = deadline - NowMs();
+    if (remaining <= 0) {
+      return false;
+    }
+
+    PollDescriptor descriptor{};
+    descriptor.fd = socket;
+    descriptor.events = events;
+    const int ready = PollSockets(&descriptor, 1, static_cast<int>(std::min(remaining, kSocketWaitSliceMs)));
+    if (ready > 0) {
+      return true;
+    }
+    if (ready < 0 && !WouldBlock()) {
+      return false;
+    }
+  }
+  return false;
+}
+
+[[nodiscard]] bool ConnectSucceeded(NativeSocket socket) noexcept {
+  int error = 0;
+  OptionLength length = sizeof(error);
+  return getsockopt(socket, SOL_SOCKET, SO_ERROR, reinterpret_cast<char *>(&error), &length) == 0 && error == 0;
+}
+
+[[nodiscard]] bool EqualsIgnoreCase(std::string_view left, std::string_view right) noexcept {
+  return left.size() == right.size() && std::equal(left.begin(), left.end(), right.begin(), [](char a, char b) {
+           return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+         });
+}
+
+[[nodiscard]] std::string_view FindHeader(std::string_view headers, std::string_view name) noexcept {
+  while (!headers.empty()) {
+    const size_t end = std::min(headers.find("\r\n"), headers.size());
+    const auto line = headers.substr(0, end);
+    const size_t colon = line.find(':');
+    if (colon != std::string_view::npos && EqualsIgnoreCase(line.substr(0, colon), name)) {
+      auto value = line.substr(colon + 1);
+      value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+      return value;
+    }
+    headers.remove_prefix(std::min(end + 2, headers.size()));
+  }
+  return {};
+}
+
+[[nodiscard]] bool IsPrintable(std::string_view value) noexcept {
+  return std::all_of(value.begin(), value.end(), [](char c) {
+    const auto byte = static_cast<unsigned char>(c);
+    return byte > 0x20 && byte < 0x7F;
+  });
+}
+
+template <typename T>
+[[nodiscard]] bool ParseNumber(std::string_view text, T &value) noexcept {
+  const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+  return result.ec == std::errc{} && result.ptr == text.data() + text.size();
+}
+
+template <typename T>
+void AppendNumber(std::string &output, T value) {
+  char digits[20];
+  const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  output.append(digits, static_cast<size_t>(result.ptr - digits));
+}
+
+[[nodiscard]] std::string_view ToContentType(uint8_t format) noexcept {
+  switch (format) {
+    case 1:
+      return "application/cbor";
+    case 2:
+      return "application/msgpack";
+    default:
+      return "application/json";
+  }
+}
+
+// Redirects are not followed, and client errors other than timeouts and rate limiting will not go away by resending
+// the same batch; either way retrying would only repeat the same answer.
+[[nodiscard]] bool IsRejection(int32_t status) noexcept {
+  return (status >= 300 && status < 400) ||
+         (status >= 400 && status < 500 && status != 408 && status != 425 && status != 429);
+}
+}  // namespace detail
+
+bool ParseUrl(std::string_view url, Endpoint &endpoint) {
+  constexpr std::string_view kScheme = "http://";
+  if (url.size() <= kScheme.size() || !detail::EqualsIgnoreCase(url.substr(0, kScheme.size()), kScheme)) {
+    return false;
+  }
+  url.remove_prefix(kScheme.size());
+  url = url.substr(0, url.find('#'));
+
+  const size_t slash = std::min(url.find('/'), url.size());
+  const auto authority = url.substr(0, slash);
+  const auto target = slash < url.size() ? url.substr(slash) : std::string_view("/");
+  if (authority.find('@') != std::string_view::npos || !detail::IsPrintable(target)) {
+    return false;
+  }
+
+  auto host = authority;
+  std::string_view portText;
+  if (!authority.empty() && authority.front() == '[') {
+    const size_t close = authority.find(']');
+    if (close == std::string_view::npos) {
+      return false;
+    }
+    host = authority.substr(1, close - 1);
+    const auto rest = authority.substr(close + 1);
+    if (!rest.empty() && rest.front() != ':') {
+      return false;
+    }
+    portText = rest.empty() ? rest : rest.substr(1);
+  } else if (const size_t colon = authority.rfind(':'); colon != std::string_view::npos) {
+    host = authority.substr(0, colon);
+    portText = authority.substr(colon + 1);
+  }
+
+  uint32_t port = 80;
+  if (host.empty() || host.size() > detail::kMaxHostLength || !detail::IsPrintable(host) ||
+      (!portText.empty() && (!detail::ParseNumber(portText, port) || port == 0 || port > 65535))) {
+    return false;
+  }
+
+  endpoint.host.assign(host);
+  endpoint.port = static_cast<uint16_t>(port);
+  endpoint.target.assign(target);
+  return true;
+}
+
+void Throttle::Configure(uint64_t bytesPerSecond, int64_t nowMs) noexcept {
+  m_rate = bytesPerSecond;
+  m_tokens = static_cast<double>(bytesPerSecond);
+  m_lastRefillMs = nowMs;
+}
+
+int64_t Throttle::Reserve(size_t bytes, int64_t nowMs) noexcept {
+  if (m_rate == 0) {
+    return 0;
+  }
+
+  const double rate = static_cast<double>(m_rate);
+  m_tokens = std::min(rate, m_tokens + static_cast<double>(nowMs - m_lastRefillMs) * rate / 1000.0);
+  m_lastRefillMs = nowMs;
+  m_tokens -= static_cast<double>(bytes);
+  return m_tokens >= 0.0 ? 0 : static_cast<int64_t>(std::ceil(-m_tokens * 1000.0 / rate));
+}
+
+Uploader::~Uploader() { Close(); }
+
+UploadError Uploader::Open(const std::filesystem::path &directory, const UploadOptions &options) noexcept {
+  if (directory.empty()) {
+    return UploadError::InvalidPath;
+  }
+  if (options.batchRecords == 0 || options.batchRecords > detail::kMaxBatchRecords || options.batchBytes == 0 ||
+      options.batchBytes > json::detail::kMaxBatchBytes || options.batchIntervalMs < 0 ||
+      options.requestTimeoutMs <= 0 || options.minBackoffMs <= 0 || options.maxBackoffMs < options.minBackoffMs ||
+      options.spoolBytes < 2 * storage::detail::kMinSegmentSize) {
+    return UploadError::InvalidOptions;
+  }
+  Close();
+
+  try {
+    if (!ParseUrl(options.url, m_endpoint)) {
+      return UploadError::InvalidUrl;
+    }
+    m_options = options;
+    m_cursorPath = directory / detail::kCursorFileName;
+    m_random.seed(std::random_device{}());
+  } catch (...) {
+    return UploadError::MemoryAllocationFailed;
+  }
+
+  const size_t segmentSize = static_cast<size_t>(std::clamp<uint64_t>(
+      options.spoolBytes / detail::kSpoolSegmentsPerSpool, storage::detail::kMinSegmentSize,
+      detail::kMaxSpoolSegmentSize));
+  const auto spoolResult = m_spool.Open(directory, storage::StoreOptions{segmentSize, options.spoolBytes});
+  if (spoolResult != storage::StoreError::Success) {
+    return spoolResult == storage::StoreError::InvalidPath ? UploadError::InvalidPath : UploadError::SpoolFailed;
+  }
+
+#ifdef _WIN32
+  WSADATA data;
+  if (WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+    m_spool.Close();
+    return UploadError::StartupFailed;
+  }
+  m_startup = true;
+#endif
+
+  const int64_t now = detail::NowMs();
+  LoadCursor();
+  m_batchBuffer.Configure(json::BatchFraming::JsonArray, json::BatchLimits{});
+  m_throttle.Configure(options.maxBytesPerSecond, now);
+  m_hasBatch = false;
+  m_recordLimit = options.batchRecords;
+  m_attempts = 0;
+  m_retryAtMs = 0;
+  m_lastBatchMs = now;
+  m_woken = false;
+  m_open = true;
+  return UploadError::Success;
+}
+
+void Uploader::Close() noexcept {
+  if (m_open) {
+    SaveCursor();
+  }
+  m_open = false;
+  m_spool.Close();
+  m_hasBatch = false;
+#ifdef _WIN32
+  if (m_startup) {
+    WSACleanup();
+  }
+#endif
+  m_startup = false;
+}
+
+bool Uploader::IsOpen() const noexcept { return m_open; }
+
+bool Uploader::Enqueue(std::string_view payload, uint8_t format, int64_t timestamp) noexcept {
+  if (!m_open || payload.empty()) {
+    return false;
+  }
+
+  // The spooled record is the payload behind one format byte, so a batch never mixes encodings.
+  try {
+    m_enqueueBuffer.assign(1, static_cast<char>(format));
+    m_enqueueBuffer.append(payload);
+  } catch (...) {
+    ++m_droppedCount;
+    return false;
+  }
+  // The append is a copy into the mapped spool under the store's lock, which the upload thread holds only while it
+  // reads a batch, never across a network call, so a stalled POST cannot make the sampler drop samples.
+  if (m_spool.Append(reinterpret_cast<const uint8_t *>(m_enqueueBuffer.data()), m_enqueueBuffer.size(), timestamp) !=
+      storage::StoreError::Success) {
+    ++m_droppedCount;
+    return false;
+  }
+  ++m_spooledCount;
+
+  {
+    std::lock_guard<std::mutex> lock(m_signalMutex);
+    m_pendingWork = true;
+  }
+  m_signal.notify_one();
+  return true;
+}
+
+void Uploader::Poll() noexcept {
+  if (!m_open) {
+    return;
+  }
+
+  {
+    const int64_t now = detail::NowMs();
+    const int64_t timeoutMs =
+        m_retryAtMs > now ? std::min(detail::kIdleWaitMs, m_retryAtMs - now) : detail::kIdleWaitMs;
+    std::unique_lock<std::mutex> lock(m_signalMutex);
+    m_signal.wait_for(lock, std::chrono::milliseconds{timeoutMs}, [this] { return m_pendingWork || m_woken; });
+    m_pendingWork = false;
+  }
+  m_spool.Flush();
+
+  // After an outage the backlog drains batch after batch, but new samples are spooled between every request.
+  while (!m_woken) {
+    const int64_t now = detail::NowMs();
+    if (now < m_retryAtMs || (!m_hasBatch && !BuildBatch(now))) {
+      break;
+    }
+
+    const auto response = Send();
+    if (response.status != 0) {
+      m_lastStatus = response.status;
+    }
+    if (response.status >= 200 && response.status < 300) {
+      ++m_batchCount;
+      m_uploadedCount += m_batch.recordCount;
+      // Grow back after a 413 so one oversized batch does not shrink every later request for good.
+      m_recordLimit = std::min(m_options.batchRecords, m_recordLimit * 2);
+      Acknowledge(m_batch.nextSequence);
+    } else if (response.status == 413 && m_batch.recordCount > 1) {
+      m_recordLimit = std::max<size_t>(1, m_batch.recordCount / 2);
+      m_hasBatch = false;
+    } else if (detail::IsRejection(response.status)) {
+      m_rejectedCount += m_batch.recordCount;
+      Acknowledge(m_batch.nextSequence);
+    } else {
+      if (!m_woken) {
+        ScheduleRetry(response.retryAfterMs, detail::NowMs());
+      }
+      break;
+    }
+    m_spool.Flush();
+  }
+  m_woken = false;
+}
+
+void Uploader::Wake() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(m_signalMutex);
+    m_woken = true;
+  }
+  m_signal.notify_all();
+}
+
+UploadStats Uploader::GetStats() const noexcept {
+  UploadStats stats;
+  const uint64_t next = m_spool.GetNextSequence();
+  const uint64_t cursor = std::max(m_cursor.load(), m_spool.GetFirstSequence());
+  stats.spooledCount = m_spooledCount;
+  stats.pendingCount = next > cursor ? next - cursor : 0;
+  stats.uploadedCount = m_uploadedCount;
+  stats.batchCount = m_batchCount;
+  stats.retryCount = m_retryCount;
+  stats.rejectedCount = m_rejectedCount;
+  stats.droppedCount = m_droppedCount;
+  stats.sentBytes = m_sentBytes;
+  stats.lastStatus = m_lastStatus;
+  return stats;
+}
+
+bool Uploader::BuildBatch(int64_t nowMs) noexcept {
+  const uint64_t first = m_spool.GetFirstSequence();
+  const uint64_t next = m_spool.GetNextSequence();
+  uint64_t cursor = m_cursor;
+  if (cursor < first) {
+    // Retention already recycled samples that were never acknowledged.
+    m_droppedCount += first - cursor;
+    cursor = first;
+    m_cursor = cursor;
+  }
+
+  const uint64_t pending = next > cursor ? next - cursor : 0;
+  if (pending == 0 || (pending < m_recordLimit && nowMs - m_lastBatchMs < m_options.batchIntervalMs)) {
+    return false;
+  }
+
+  m_batchBuffer.Clear();
+  uint64_t nextSequence = cursor;
+  std::optional<uint8_t> format;
+  const auto steadyNow = std::chrono::steady_clock::now();
+  try {
+    m_spool.Read(cursor, m_recordLimit, [&](const storage::RecordView &record) {
+      if (record.size < 2 || record.data[0] > 2) {
+        ++m_droppedCount;
+        nextSequence = record.sequence + 1;
+        return true;
+      }
+
+      const uint8_t recordFormat = record.data[0];
+      const size_t size = record.size - 1;
+      if (!m_batchBuffer.IsEmpty() &&
+          (recordFormat != format || m_batchBuffer.GetSize() + size > m_options.batchBytes)) {
+        return false;
+      }
+
+      bool appended = false;
+      const auto timestamp = static_cast<uint64_t>(record.timestamp);
+      if (recordFormat == 0) {
+        appended = m_batchBuffer.Append(std::string_view(reinterpret_cast<const char *>(record.data + 1), size),
+                                        record.sequence, timestamp, steadyNow);
+      } else {
+        m_sample.assign(record.data + 1, record.data + record.size);
+        appended = m_batchBuffer.Append(m_sample,
+                                        recordFormat == 2 ? json::BinaryFormat::MessagePack : json::BinaryFormat::Cbor,
+                                        record.sequence, timestamp, steadyNow);
+      }
+      if (!appended) {
+        return false;
+      }
+      format = recordFormat;
+      nextSequence = record.sequence + 1;
+      return true;
+    });
+  } catch (...) {
+    return false;
+  }
+
+  if (m_batchBuffer.IsEmpty()) {
+    if (nextSequence > cursor) {
+      Acknowledge(nextSequence);
+    }
+    return false;
+  }
+  if (!m_batchBuffer.Finish()) {
+    return false;
+  }
+
+  try {
+    m_batch.firstSequence = cursor;
+    m_batch.nextSequence = nextSequence;
+    m_batch.recordCount = m_batchBuffer.GetSampleCount();
+    m_batch.format = *format;
+
+    char spoolId[17];
+    const auto result = std::to_chars(spoolId, spoolId + sizeof(spoolId), m_spoolId, 16);
+    m_batch.key.assign(spoolId, result.ptr);
+    m_batch.key.push_back('-');
+    detail::AppendNumber(m_batch.key, cursor);
+    m_batch.key.push_back('-');
+    detail::AppendNumber(m_batch.key, nextSequence - 1);
+  } catch (...) {
+    return false;
+  }
+
+  // An empty buffer means the body goes out uncompressed; a gzip stream is never empty.
+  m_batch.compressed.clear();
+  if (m_options.compress) {
+    const auto &bytes = m_batchBuffer.GetBytes();
+    const auto &text = m_batchBuffer.GetText();
+    const bool compressed =
+        m_batchBuffer.IsBinary()
+            ? m_gzip.Compress(bytes.data(), bytes.size(), m_batch.compressed)
+            : m_gzip.Compress(reinterpret_cast<const uint8_t *>(text.data()), text.size(), m_batch.compressed);
+    if (!compressed) {
+      m_batch.compressed.clear();
+    }
+  }
+
+  m_hasBatch = true;
+  m_lastBatchMs = nowMs;
+  return true;
+}
+
+Uploader::Response Uploader::Send() noexcept {
+  Response response;
+
+  const auto &bytes = m_batchBuffer.GetBytes();
+  const auto &text = m_batchBuffer.GetText();
+  const bool compressed = !m_batch.compressed.empty();
+  const char *body = compressed ? reinterpret_cast<const char *>(m_batch.compressed.data())
+                     : m_batchBuffer.IsBinary() ? reinterpret_cast<const char *>(bytes.data())
+                                                : text.data();
+  const size_t bodySize = compressed ? m_batch.compressed.size() : m_batchBuffer.GetSize();
+
+  char port[6];
+  try {
+    m_request.clear();
+    m_request.append("POST ").append(m_endpoint.target).append(" HTTP/1.1\r\nHost: ");
+    const bool literal = m_endpoint.host.find(':') != std::string::npos;
+    m_request.append(literal ? "[" : "").append(m_endpoint.host).append(literal ? "]" : "");
+    if (m_endpoint.port != 80) {
+      m_request.push_back(':');
+      detail::AppendNumber(m_request, m_endpoint.port);
+    }
+    m_request.append("\r\nUser-Agent: nysys\r\nContent-Type: ").append(detail::ToContentType(m_batch.format));
+    m_request.append(compressed ? "\r\nContent-Encoding: gzip" : "").append("\r\nContent-Length: ");
+    detail::AppendNumber(m_request, bodySize);
+    m_request.append("\r\nIdempotency-Key: ").append(m_batch.key).append("\r\nConnection: close\r\n\r\n");
+    *std::to_chars(port, port + sizeof(port) - 1, m_endpoint.port).ptr = '\0';
+  } catch (...) {
+    return response;
+  }
+
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_protocol = IPPROTO_TCP;
+  addrinfo *addresses = nullptr;
+  if (getaddrinfo(m_endpoint.host.c_str(), port, &hints, &addresses) != 0) {
+    return response;
+  }
+
+  detail::Connection connection;
+  bool connected = false;
+  for (const addrinfo *address = addresses; address && !connected && !m_woken; address = address->ai_next) {
+    connection.Reset(socket(address->ai_family, address->ai_socktype, address->ai_protocol));
+    if (connection.Get() == detail::kInvalidSocket || !detail::SetNonBlocking(connection.Get())) {
+      continue;
+    }
+    connected = connect(connection.Get(), address->ai_addr, static_cast<int>(address->ai_addrlen)) == 0 ||
+                (detail::WouldBlock() &&
+                 detail::WaitSocket(connection.Get(), POLLOUT, m_options.requestTimeoutMs, m_woken) &&
+                 detail::ConnectSucceeded(connection.Get()));
+  }
+  freeaddrinfo(addresses);
+  if (!connected) {
+    return response;
+  }
+
+  const auto transmit = [&](const char *data, size_t size) noexcept {
+    const size_t chunkSize =
+        m_options.maxBytesPerSecond > 0
+            ? static_cast<size_t>(std::clamp<uint64_t>(m_options.maxBytesPerSecond / 8, 512, detail::kSendChunkSize))
+            : size;
+    size_t offset = 0;
+    while (offset < size) {
+      const size_t chunk = std::min(chunkSize, size - offset);
+      const int64_t delayMs = m_throttle.Reserve(chunk, detail::NowMs());
+      if (delayMs > 0 && !WaitFor(delayMs)) {
+        return false;
+      }
+
+      size_t written = 0;
+      while (written < chunk) {
+        const auto sent = send(connection.Get(), data + offset + written,
+                               static_cast<detail::TransferLength>(chunk - written), detail::kSendFlags);
+        if (sent > 0) {
+          written += static_cast<size_t>(sent);
+        } else if (sent < 0 && detail::WouldBlock()) {
+          if (!detail::WaitSocket(connection.Get(), POLLOUT, m_options.requestTimeoutMs, m_woken)) {
+            return false;
+          }
+        } else {
+          return false;
+        }
+      }
+      offset += chunk;
+      m_sentBytes += chunk;
+    }
+    return true;
+  };
+  if (!transmit(m_request.data(), m_request.size()) || !transmit(body, bodySize)) {
+    return response;
+  }
+
+  // Only the status line and Retry-After matter; the connection is closed as soon as the headers are in.
+  m_response.clear();
+  char buffer[4096];
+  size_t headerEnd = std::string::npos;
+  while ((headerEnd = m_response.find("\r\n\r\n")) == std::string::npos &&
+         m_response.size() < detail::kMaxResponseHeaderBytes) {
+    if (!detail::WaitSocket(connection.Get(), POLLIN, m_options.requestTimeoutMs, m_woken)) {
+      return response;
+    }
+    const auto received = recv(connection.Get(), buffer, static_cast<detail::TransferLength>(sizeof(buffer)), 0);
+    if (received > 0) {
+      try {
+        m_response.append(buffer, static_cast<size_t>(received));
+      } catch (...) {
+        return response;
+      }
+    } else if (received == 0 || !detail::WouldBlock()) {
+      break;
+    }
+  }
+
+  const std::string_view headers(m_response.data(), std::min(headerEnd, m_response.size()));
+  const size_t space = headers.find(' ');
+  int32_t status = 0;
+  if (headers.substr(0, 5) != "HTTP/" || space == std::string_view::npos ||
+      !detail::ParseNumber(headers.substr(space + 1, 3), status)) {
+    return response;
+  }
+  response.status = status;
+
+  int64_t retryAfter = 0;
+  if (detail::ParseNumber(detail::FindHeader(headers.substr(std::min(headers.find("\r\n"), headers.size())),
+                                             "Retry-After"),
+                          retryAfter) &&
+      retryAfter >= 0) {
+    response.retryAfterMs = std::min(retryAfter, m_options.maxBackoffMs / 1000 + 1) * 1000;
+  }
+  return response;
+}
+
+void Uploader::Acknowledge(uint64_t nextSequence) noexcept {
+  m_cursor = nextSequence;
+  m_hasBatch = false;
+  m_attempts = 0;
+  m_retryAtMs = 0;
+  SaveCursor();
+}
+
+void Uploader::ScheduleRetry(int64_t retryAfterMs, int64_t nowMs) noexcept {
+  ++m_retryCount;
+  ++m_attempts;
+
+  int64_t backoff = m_options.minBackoffMs;
+  for (uint32_t i = 1; i < m_attempts && backoff < m_options.maxBackoffMs; ++i) {
+    backoff *= 2;
+  }
+  backoff = std::min(backoff, m_options.maxBackoffMs);
+
+  // Half fixed, half random, so a fleet that lost the same server does not come back in lockstep.
+  const int64_t half = backoff / 2;
+  int64_t delay = half + static_cast<int64_t>(m_random() % static_cast<uint64_t>(backoff - half + 1));
+  delay = std::min(std::max(delay, retryAfterMs), m_options.maxBackoffMs);
+  m_retryAtMs = nowMs + delay;
+}
+
+bool Uploader::WaitFor(int64_t timeoutMs) noexcept {
+  std::unique_lock<std::mutex> lock(m_signalMutex);
+  return !m_signal.wait_for(lock, std::chrono::milliseconds{timeoutMs}, [this] { return m_woken.load(); });
+}
+
+void Uploader::LoadCursor() noexcept {
+  uint64_t spoolId = 0;
+  uint64_t cursor = 0;
+  bool loaded = false;
+  try {
+    std::ifstream input(m_cursorPath);
+    loaded = static_cast<bool>(input >> std::hex >> spoolId >> std::dec >> cursor) && spoolId != 0;
+  } catch (...) {
+    loaded = false;
+  }
+
+  // A cursor past the end means the spool was emptied and its sequences restarted; a fresh spool id keeps the new
+  // samples from reusing idempotency keys the server has already seen.
+  const bool fresh = !loaded || cursor > m_spool.GetNextSequence();
+  if (fresh) {
+    spoolId = m_random() | 1;
+    cursor = m_spool.GetFirstSequence();
+  }
+  m_spoolId = spoolId;
+  m_cursor = cursor;
+  if (fresh) {
+    SaveCursor();
+  }
+}
+
+void Uploader::SaveCursor() noexcept {
+  try {
+    auto temporary = m_cursorPath;
+    temporary += ".tmp";
+    {
+      std::ofstream output(temporary, std::ios::trunc);
+      output << std::hex << m_spoolId << ' ' << std::dec << m_cursor.load() << '\n';
+      if (!output.flush()) {
+        return;
+      }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temporary, m_cursorPath, ec);
+  } catch (...) {
+  }
+}
+
+}  // namespace upload
\ No newline at end of file
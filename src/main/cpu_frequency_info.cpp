@@ -0,0 +1,203 @@
+#include "main/cpu_frequency_info.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <powrprof.h>
+
+#pragma comment(lib, "powrprof.lib")
+
+namespace nysys {
+namespace detail {
+
+struct ProcessorPowerInformation {
+  ULONG Number;
+  ULONG MaxMhz;
+  ULONG CurrentMhz;
+  ULONG MhzLimit;
+  ULONG MaxIdleState;
+  ULONG CurrentIdleState;
+};
+
+constexpr LONG kPowerStatusSuccess = 0;
+}  // namespace detail
+
+CPUFrequencyInfo::CPUFrequencyInfo() noexcept { Initialize(); }
+
+void CPUFrequencyInfo::Initialize() noexcept {
+  try {
+    const WORD groupCount = GetActiveProcessorGroupCount();
+    for (WORD group = 0; group < groupCount; ++group) {
+      const DWORD count = GetActiveProcessorCount(group);
+      m_groupProcessorCounts.push_back(static_cast<uint16_t>(count));
+      m_coreCount += count;
+    }
+
+    if (m_coreCount == 0) {
+      SYSTEM_INFO systemInfo;
+      GetSystemInfo(&systemInfo);
+      m_coreCount = systemInfo.dwNumberOfProcessors;
+      m_groupProcessorCounts.assign(1, static_cast<uint16_t>(m_coreCount));
+    }
+
+    if (m_coreCount == 0) {
+      m_lastError = CPUFrequencyError::ProcessorCountFailed;
+      return;
+    }
+
+    m_bufferSize = static_cast<ULONG>(m_coreCount * sizeof(detail::ProcessorPowerInformation));
+    m_buffer = std::make_unique<BYTE[]>(m_bufferSize);
+
+    m_currentMhz.assign(m_coreCount, 0);
+    m_maxMhz.assign(m_coreCount, 0);
+    m_limitMhz.assign(m_coreCount, 0);
+    m_throttleCounts.assign(m_coreCount, 0);
+    m_throttled.assign(m_coreCount, 0);
+
+    m_initialized = true;
+
+    Update();
+  } catch (...) {
+    m_lastError = CPUFrequencyError::MemoryAllocationFailed;
+    m_initialized = false;
+  }
+}
+
+bool CPUFrequencyInfo::ReadPowerInformation() noexcept {
+  if (m_groupProcessorCounts.size() <= 1) {
+    return CallNtPowerInformation(ProcessorInformation, nullptr, 0, m_buffer.get(), m_bufferSize) ==
+           detail::kPowerStatusSuccess;
+  }
+
+  // ProcessorInformation only reports the processor group of the calling thread, so the thread visits each group.
+  const HANDLE thread = GetCurrentThread();
+  GROUP_AFFINITY original{};
+  if (!GetThreadGroupAffinity(thread, &original)) {
+    return false;
+  }
+
+  bool success = true;
+  size_t offset = 0;
+  for (size_t group = 0; group < m_groupProcessorCounts.size() && success; ++group) {
+    const size_t count = m_groupProcessorCounts[group];
+    GROUP_AFFINITY affinity{};
+    affinity.Group = static_cast<WORD>(group);
+    affinity.Mask = count >= sizeof(KAFFINITY) * 8 ? ~KAFFINITY{0} : (KAFFINITY{1} << count) - 1;
+
+    const ULONG size = static_cast<ULONG>(count * sizeof(detail::ProcessorPowerInformation));
+    success = SetThreadGroupAffinity(thread, &affinity, nullptr) &&
+              CallNtPowerInformation(ProcessorInformation, nullptr, 0,
+                                     m_buffer.get() + offset * sizeof(detail::ProcessorPowerInformation),
+                                     size) == detail::kPowerStatusSuccess;
+    offset += count;
+  }
+
+  SetThreadGroupAffinity(thread, &original, nullptr);
+  return success;
+}
+
+bool CPUFrequencyInfo::Sample() noexcept {
+  if (!m_initialized) {
+    return false;
+  }
+
+  if (!ReadPowerInformation()) {
+    m_lastError = CPUFrequencyError::PowerInformationFailed;
+    return false;
+  }
+
+  const auto *entries = reinterpret_cast<const detail::ProcessorPowerInformation *>(m_buffer.get());
+
+  uint32_t minMhz = m_pendingReadings > 0 ? m_pendingMinMhz : std::numeric_limits<uint32_t>::max();
+  uint32_t maxMhz = m_pendingMaxMhz;
+  uint64_t sumMhz = 0;
+  uint32_t throttledCores = 0;
+
+  for (size_t i = 0; i < m_coreCount; ++i) {
+    const uint32_t current = entries[i].CurrentMhz;
+    const uint32_t maximum = entries[i].MaxMhz;
+    const uint32_t limit = entries[i].MhzLimit;
+
+    m_currentMhz[i] = current;
+    m_maxMhz[i] = maximum;
+    m_limitMhz[i] = limit;
+
+    const uint8_t throttled = (limit > 0 && limit < maximum) ? 1 : 0;
+    if (throttled && !m_throttled[i]) {
+      ++m_throttleCounts[i];
+      ++m_throttleEventCount;
+    }
+    m_throttled[i] = throttled;
+    throttledCores += throttled;
+
+    minMhz = std::min(minMhz, current);
+    maxMhz = std::max(maxMhz, current);
+    sumMhz += current;
+  }
+
+  m_pendingMinMhz = minMhz;
+  m_pendingMaxMhz = maxMhz;
+  m_pendingSumMhz += sumMhz;
+  m_pendingReadings += m_coreCount;
+  ++m_pendingSampleCount;
+  m_throttledCoreCount = throttledCores;
+  return true;
+}
+
+bool CPUFrequencyInfo::Update() noexcept {
+  if (!m_initialized) {
+    return false;
+  }
+
+  const bool sampled = Sample();
+  if (m_pendingReadings == 0) {
+    return false;
+  }
+
+  m_minCurrentMhz = m_pendingMinMhz;
+  m_maxCurrentMhz = m_pendingMaxMhz;
+  m_avgCurrentMhz = static_cast<double>(m_pendingSumMhz) / static_cast<double>(m_pendingReadings);
+  m_intervalSampleCount = m_pendingSampleCount;
+
+  m_pendingMinMhz = 0;
+  m_pendingMaxMhz = 0;
+  m_pendingSumMhz = 0;
+  m_pendingReadings = 0;
+  m_pendingSampleCount = 0;
+
+  if (sampled) {
+    m_lastError = CPUFrequencyError::Success;
+  }
+  return sampled;
+}
+
+size_t CPUFrequencyInfo::GetCoreCount() const noexcept { return m_coreCount; }
+
+const std::vector<uint32_t> &CPUFrequencyInfo::GetCurrentMhz() const noexcept { return m_currentMhz; }
+
+const std::vector<uint32_t> &CPUFrequencyInfo::GetMaxMhz() const noexcept { return m_maxMhz; }
+
+const std::vector<uint32_t> &CPUFrequencyInfo::GetLimitMhz() const noexcept { return m_limitMhz; }
+
+const std::vector<uint32_t> &CPUFrequencyInfo::GetThrottleCounts() const noexcept { return m_throttleCounts; }
+
+uint32_t CPUFrequencyInfo::GetMinCurrentMhz() const noexcept { return m_minCurrentMhz; }
+
+double CPUFrequencyInfo::GetAvgCurrentMhz() const noexcept { return m_avgCurrentMhz; }
+
+uint32_t CPUFrequencyInfo::GetMaxCurrentMhz() const noexcept { return m_maxCurrentMhz; }
+
+uint32_t CPUFrequencyInfo::GetIntervalSampleCount() const noexcept { return m_intervalSampleCount; }
+
+uint32_t CPUFrequencyInfo::GetThrottledCoreCount() const noexcept { return m_throttledCoreCount; }
+
+uint64_t CPUFrequencyInfo::GetThrottleEventCount() const noexcept { return m_throttleEventCount; }
+
+bool CPUFrequencyInfo::IsThrottling() const noexcept { return m_throttledCoreCount > 0; }
+
+bool CPUFrequencyInfo::IsInitialized() const noexcept { return m_initialized; }
+
+CPUFrequencyError CPUFrequencyInfo::GetLastError() const noexcept { return m_lastError; }
+
+std::unique_ptr<CPUFrequencyInfo> GetCPUFrequencyInfo() { return std::make_unique<CPUFrequencyInfo>(); }
+
+}  // namespace nysys
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "main/cpu_usage_info.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "helper/nt_helper.hpp"
+
+namespace nysys {
+
+CPUUsageInfo::CPUUsageInfo() noexcept { Initialize(); }
+
+void CPUUsageInfo::Initialize() noexcept {
+  try {
+    const WORD groupCount = GetActiveProcessorGroupCount();
+    for (WORD group = 0; group < groupCount; ++group) {
+      const DWORD count = GetActiveProcessorCount(group);
+      m_groupProcessorCounts.push_back(static_cast<uint16_t>(count));
+      m_coreCount += count;
+    }
+
+    if (m_coreCount == 0) {
+      SYSTEM_INFO systemInfo;
+      GetSystemInfo(&systemInfo);
+      m_coreCount = systemInfo.dwNumberOfProcessors;
+      m_groupProcessorCounts.assign(1, static_cast<uint16_t>(m_coreCount));
+    }
+
+    if (m_coreCount == 0) {
+      m_lastError = CPUUsageError::ProcessorCountFailed;
+      return;
+    }
+
+    m_bufferSize = static_cast<ULONG>(m_coreCount * sizeof(nt::ProcessorPerformanceInformation));
+    m_buffer = std::make_unique<BYTE[]>(m_bufferSize);
+
+    m_current.Resize(m_coreCount);
+    m_previous.Resize(m_coreCount);
+    m_shares.Resize(m_coreCount);
+
+    m_initialized = true;
+
+    Update();
+  } catch (...) {
+    m_lastError = CPUUsageError::MemoryAllocationFailed;
+    m_initialized = false;
+  }
+}
+
+bool CPUUsageInfo::ReadCounters() noexcept {
+  auto *entries = reinterpret_cast<nt::ProcessorPerformanceInformation *>(m_buffer.get());
+  size_t entryCount = 0;
+
+  if (m_groupProcessorCounts.size() > 1 && nt::HasQuerySystemInformationEx()) {
+    for (size_t group = 0; group < m_groupProcessorCounts.size(); ++group) {
+      USHORT groupNumber = static_cast<USHORT>(group);
+      const ULONG remaining =
+          static_cast<ULONG>((m_coreCount - entryCount) * sizeof(nt::ProcessorPerformanceInformation));
+      ULONG returnLength = 0;
+
+      const auto status =
+          nt::QuerySystemInformationEx(nt::kSystemProcessorPerformanceInformation, &groupNumber, sizeof(groupNumber),
+                                       entries + entryCount, remaining, &returnLength);
+      if (!nt::IsSuccess(status)) {
+        return false;
+      }
+
+      entryCount += returnLength / sizeof(nt::ProcessorPerformanceInformation);
+      if (entryCount >= m_coreCount) {
+        break;
+      }
+    }
+  } else {
+    ULONG returnLength = 0;
+    const auto status =
+        nt::QuerySystemInformation(nt::kSystemProcessorPerformanceInformation, entries, m_bufferSize, &returnLength);
+    if (!nt::IsSuccess(status)) {
+      return false;
+    }
+    entryCount = returnLength / sizeof(nt::ProcessorPerformanceInformation);
+  }
+
+  entryCount = std::min(entryCount, m_coreCount);
+
+  for (size_t i = 0; i < entryCount; ++i) {
+    m_current.idle[i] = nt::ToCounter(entries[i].IdleTime);
+    m_current.kernel[i] = nt::ToCounter(entries[i].KernelTime);
+    m_current.user[i] = nt::ToCounter(entries[i].UserTime);
+    m_current.dpc[i] = nt::ToCounter(entries[i].DpcTime);
+    m_current.interrupt[i] = nt::ToCounter(entries[i].InterruptTime);
+  }
+
+  for (size_t i = entryCount; i < m_coreCount; ++i) {
+    m_current.idle[i] = m_previous.idle[i];
+    m_current.kernel[i] = m_previous.kernel[i];
+    m_current.user[i] = m_previous.user[i];
+    m_current.dpc[i] = m_previous.dpc[i];
+    m_current.interrupt[i] = m_previous.interrupt[i];
+  }
+
+  return true;
+}
+
+bool CPUUsageInfo::Update() noexcept {
+  if (!m_initialized) {
+    return false;
+  }
+
+  if (!ReadCounters()) {
+    m_lastError = CPUUsageError::CounterQueryFailed;
+    return false;
+  }
+
+  cputime::ComputeShares(m_current, m_previous, m_coreCount, m_shares, m_total);
+  std::swap(m_current, m_previous);
+
+  m_lastError = CPUUsageError::Success;
+  return true;
+}
+
+size_t CPUUsageInfo::GetCoreCount() const noexcept { return m_coreCount; }
+
+const CPUTimeBreakdown &CPUUsageInfo::GetTotal() const noexcept { return m_total; }
+
+CPUTimeBreakdown CPUUsageInfo::GetCore(size_t index) const noexcept {
+  CPUTimeBreakdown core;
+  if (index < m_coreCount) {
+    core.usage = m_shares.usage[index];
+    core.user = m_shares.user[index];
+    core.system = m_shares.system[index];
+    core.irq = m_shares.irq[index];
+    core.dpc = m_shares.dpc[index];
+    core.idle = m_shares.idle[index];
+  }
+  return core;
+}
+
+const std::vector<float> &CPUUsageInfo::GetCoreUsage() const noexcept { return m_shares.usage; }
+
+const std::vector<float> &CPUUsageInfo::GetCoreUser() const noexcept { return m_shares.user; }
+
+const std::vector<float> &CPUUsageInfo::GetCoreSystem() const noexcept { return m_shares.system; }
+
+const std::vector<float> &CPUUsageInfo::GetCoreIrq() const noexcept { return m_shares.irq; }
+
+const std::vector<float> &CPUUsageInfo::GetCoreDpc() const noexcept { return m_shares.dpc; }
+
+const std::vector<float> &CPUUsageInfo::GetCoreIdle() const noexcept { return m_shares.idle; }
+
+bool CPUUsageInfo::IsInitialized() const noexcept { return m_initialized; }
+
+CPUUsageError CPUUsageInfo::GetLastError() const noexcept { return m_lastError; }
+
+std::unique_ptr<CPUUsageInfo> GetCPUUsageInfo() { return std::make_unique<CPUUsageInfo>(); }
+
+}  // namespace nysys
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "main/disk_io_info.hpp"
+
+#include <algorithm>
+#include <cwchar>
+#include <utility>
+#include <winioctl.h>
+
+#include "helper/nt_helper.hpp"
+
+namespace nysys {
+namespace detail {
+
+[[nodiscard]] HANDLE OpenPhysicalDrive(uint32_t diskIndex) noexcept {
+  wchar_t path[32];
+  swprintf(path, sizeof(path) / sizeof(path[0]), L"\\\\.\\PhysicalDrive%u", diskIndex);
+  return CreateFileW(path, 0, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
+}
+
+[[nodiscard]] bool QueryDiskPerformance(HANDLE handle, DISK_PERFORMANCE &performance) noexcept {
+  DWORD bytesReturned = 0;
+  return DeviceIoControl(handle, IOCTL_DISK_PERFORMANCE, nullptr, 0, &performance, sizeof(performance),
+                         &bytesReturned, nullptr) != FALSE;
+}
+}  // namespace detail
+
+DiskIOInfo::DiskIOInfo(uint32_t diskIndex, double readBytesRate, double writeBytesRate, double readOpsRate,
+                       double writeOpsRate, double avgQueueDepth, double awaitMs, double busyPercent,
+                       uint32_t queueDepth) noexcept
+    : m_diskIndex(diskIndex),
+      m_readBytesRate(readBytesRate),
+      m_writeBytesRate(writeBytesRate),
+      m_readOpsRate(readOpsRate),
+      m_writeOpsRate(writeOpsRate),
+      m_avgQueueDepth(avgQueueDepth),
+      m_awaitMs(awaitMs),
+      m_busyPercent(busyPercent),
+      m_queueDepth(queueDepth) {}
+
+uint32_t DiskIOInfo::GetDiskIndex() const noexcept { return m_diskIndex; }
+
+double DiskIOInfo::GetReadBytesPerSec() const noexcept { return m_readBytesRate; }
+
+double DiskIOInfo::GetWriteBytesPerSec() const noexcept { return m_writeBytesRate; }
+
+double DiskIOInfo::GetReadIops() const noexcept { return m_readOpsRate; }
+
+double DiskIOInfo::GetWriteIops() const noexcept { return m_writeOpsRate; }
+
+double DiskIOInfo::GetAvgQueueDepth() const noexcept { return m_avgQueueDepth; }
+
+double DiskIOInfo::GetAwaitMs() const noexcept { return m_awaitMs; }
+
+double DiskIOInfo::GetBusyPercent() const noexcept { return m_busyPercent; }
+
+uint32_t DiskIOInfo::GetQueueDepth() const noexcept { return m_queueDepth; }
+
+DiskIOList::DiskIOList() noexcept { Initialize(); }
+
+DiskIOList::~DiskIOList() { CloseHandles(); }
+
+void DiskIOList::Initialize() noexcept {
+  try {
+    for (uint32_t diskIndex = 0; diskIndex < detail::kMaxPhysicalDrives; ++diskIndex) {
+      HandleWrapper handle(detail::OpenPhysicalDrive(diskIndex));
+      if (!handle) {
+        continue;
+      }
+
+      DISK_PERFORMANCE performance{};
+      if (!detail::QueryDiskPerformance(handle.get(), performance)) {
+        continue;
+      }
+
+      DiskCounters counters;
+      counters.handle = std::move(handle);
+      counters.diskIndex = diskIndex;
+      m_counters.push_back(std::move(counters));
+    }
+
+    m_disks.resize(m_counters.size());
+    m_initialized = true;
+    m_lastError = m_counters.empty() ? DiskIOError::NoDisksFound : DiskIOError::Success;
+
+    Update();
+  } catch (...) {
+    CloseHandles();
+    m_lastError = DiskIOError::MemoryAllocationFailed;
+    m_initialized = false;
+  }
+}
+
+void DiskIOList::CloseHandles() noexcept {
+  m_counters.clear();
+  m_disks.clear();
+}
+
+bool DiskIOList::Update() noexcept {
+  if (!m_initialized) {
+    return false;
+  }
+
+  bool success = true;
+
+  for (size_t i = 0; i < m_counters.size(); ++i) {
+    auto &counters = m_counters[i];
+
+    DISK_PERFORMANCE performance{};
+    if (!detail::QueryDiskPerformance(counters.handle.get(), performance)) {
+      success = false;
+      continue;
+    }
+
+    counters.queryTime.Update(nt::ToCounter(performance.QueryTime), 1.0);
+    const uint64_t elapsedTicks = counters.queryTime.GetDelta();
+    const double elapsedSeconds = static_cast<double>(elapsedTicks) / detail::kHundredNanosecondsPerSecond;
+
+    const double readBytesRate = counters.bytesRead.Update(nt::ToCounter(performance.BytesRead), elapsedSeconds);
+    const double writeBytesRate =
+        counters.bytesWritten.Update(nt::ToCounter(performance.BytesWritten), elapsedSeconds);
+    const double readOpsRate = counters.readCount.Update(performance.ReadCount, elapsedSeconds);
+    const double writeOpsRate = counters.writeCount.Update(performance.WriteCount, elapsedSeconds);
+    counters.ioTime.Update(
+        nt::ToCounter(performance.ReadTime) + nt::ToCounter(performance.WriteTime), elapsedSeconds);
+    counters.idleTime.Update(nt::ToCounter(performance.IdleTime), elapsedSeconds);
+
+    const uint64_t operations = counters.readCount.GetDelta() + counters.writeCount.GetDelta();
+    const double ioTicks = static_cast<double>(counters.ioTime.GetDelta());
+    const double idleTicks = static_cast<double>(counters.idleTime.GetDelta());
+
+    double avgQueueDepth = 0.0;
+    double busyPercent = 0.0;
+    if (elapsedTicks > 0) {
+      avgQueueDepth = ioTicks / static_cast<double>(elapsedTicks);
+      busyPercent = std::clamp(100.0 - idleTicks * 100.0 / static_cast<double>(elapsedTicks), 0.0, 100.0);
+    }
+
+    const double awaitMs =
+        operations > 0 ? ioTicks / detail::kHundredNanosecondsPerMillisecond / static_cast<double>(operations) : 0.0;
+
+    m_disks[i] = DiskIOInfo(counters.diskIndex, readBytesRate, writeBytesRate, readOpsRate, writeOpsRate,
+                            avgQueueDepth, awaitMs, busyPercent, performance.QueueDepth);
+  }
+
+  m_lastError = success ? DiskIOError::Success : DiskIOError::PerformanceQueryFailed;
+  return success;
+}
+
+size_t DiskIOList::GetCount() const noexcept { return m_disks.size(); }
+
+const DiskIOInfo *DiskIOList::GetDisk(size_t index) const noexcept {
+  if (index < m_disks.size()) {
+    return &m_disks[index];
+  }
+  return nullptr;
+}
+
+const DiskIOInfo *DiskIOList::FindByDiskIndex(uint32_t diskIndex) const noexcept {
+  for (const auto &disk : m_disks) {
+    if (disk.GetDiskIndex() == diskIndex) {
+      return &disk;
+    }
+  }
+  return nullptr;
+}
+
+const std::vector<DiskIOInfo> &DiskIOList::GetDisks() const noexcept { return m_disks; }
+
+bool DiskIOList::IsInitialized() const noexcept { return m_initialized; }
+
+DiskIOError DiskIOList::GetLastError() const noexcept { return m_lastError; }
+
+std::unique_ptr<DiskIOList> GetDiskIOList() { return std::make_unique<DiskIOList>(); }
+
+}  // namespace nysys
\ No newline at end of file
@@ -27,7 +27,8 @@ std::string WideStringToUtf8(const wchar_t *wstr) noexcept {
 }
 }  // namespace detail
 
-GPUInfo::GPUInfo(std::string gpuName, double dedicatedMem, double sharedMem, bool integrated, uint32_t index) noexcept
+GPUInfo::GPUInfo(std::string gpuName, uint64_t dedicatedMem, uint64_t sharedMem, bool integrated,
+                 uint32_t index) noexcept
     : m_name(std::move(gpuName)),
       m_dedicatedMemory(dedicatedMem),
       m_sharedMemory(sharedMem),
@@ -36,9 +37,13 @@ GPUInfo::GPUInfo(std::string gpuName, double dedicatedMem, double sharedMem, boo
 
 const std::string &GPUInfo::GetName() const noexcept { return m_name; }
 
-double GPUInfo::GetDedicatedMemory() const noexcept { return m_dedicatedMemory; }
+double GPUInfo::GetDedicatedMemory() const noexcept { return utils::BytesToGB(m_dedicatedMemory); }
 
-double GPUInfo::GetSharedMemory() const noexcept { return m_sharedMemory; }
+double GPUInfo::GetSharedMemory() const noexcept { return utils::BytesToGB(m_sharedMemory); }
+
+uint64_t GPUInfo::GetDedicatedMemoryBytes() const noexcept { return m_dedicatedMemory; }
+
+uint64_t GPUInfo::GetSharedMemoryBytes() const noexcept { return m_sharedMemory; }
 
 bool GPUInfo::IsIntegrated() const noexcept { return m_isIntegrated; }
 
@@ -65,8 +70,8 @@ void GPUList::Initialize() noexcept {
     }
 
     const std::string gpuName = detail::WideStringToUtf8(adapterDesc.Description);
-    const double dedicatedMemory = utils::BytesToGB(adapterDesc.DedicatedVideoMemory);
-    const double sharedMemory = utils::BytesToGB(adapterDesc.SharedSystemMemory);
+    const uint64_t dedicatedMemory = adapterDesc.DedicatedVideoMemory;
+    const uint64_t sharedMemory = adapterDesc.SharedSystemMemory;
     const bool isIntegrated = (adapterDesc.DedicatedVideoMemory < detail::kIntegratedGpuMemoryThreshold);
 
     m_gpus.emplace_back(gpuName, dedicatedMemory, sharedMemory, isIntegrated, i);
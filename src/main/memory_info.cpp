@@ -86,6 +86,8 @@ uint32_t RAMSlotInfo::GetConfiguredSpeed() const noexcept { return m_configuredS
 
 MemoryInfo::MemoryInfo() noexcept { Initialize(); }
 
+MemoryInfo::MemoryInfo(bool includeRamSlots) noexcept : m_includeRamSlots(includeRamSlots) { Initialize(); }
+
 void MemoryInfo::Initialize() noexcept {
   try {
     MEMORYSTATUSEX memStatus;
@@ -101,6 +103,12 @@ void MemoryInfo::Initialize() noexcept {
       return;
     }
 
+    if (!m_includeRamSlots) {
+      m_initialized = true;
+      m_lastError = MemoryError::Success;
+      return;
+    }
+
     wmi::WMISession wmiSession;
     if (!wmiSession.IsInitialized()) {
       m_lastError = MemoryError::WMISessionFailed;
@@ -172,6 +180,8 @@ bool MemoryInfo::IsInitialized() const noexcept { return m_initialized; }
 
 MemoryError MemoryInfo::GetLastError() const noexcept { return m_lastError; }
 
-std::unique_ptr<MemoryInfo> GetMemoryInfo() { return std::make_unique<MemoryInfo>(); }
+std::unique_ptr<MemoryInfo> GetMemoryInfo(bool includeRamSlots) {
+  return std::make_unique<MemoryInfo>(includeRamSlots);
+}
 
 }  // namespace nysys
\ No newline at end of file
@@ -32,12 +32,13 @@ namespace detail {
 }  // namespace detail
 
 NetworkAdapterInfo::NetworkAdapterInfo(std::string adapterName, std::string mac, std::string ip, std::string connStatus,
-                                       uint32_t adapterType) noexcept
+                                       uint32_t adapterType, uint32_t adapterIndex) noexcept
     : m_name(std::move(adapterName)),
       m_macAddress(std::move(mac)),
       m_ipAddress(std::move(ip)),
       m_status(std::move(connStatus)),
-      m_type(adapterType) {}
+      m_type(adapterType),
+      m_interfaceIndex(adapterIndex) {}
 
 const std::string &NetworkAdapterInfo::GetName() const noexcept { return m_name; }
 
@@ -51,6 +52,8 @@ bool NetworkAdapterInfo::IsEthernet() const noexcept { return m_type == MIB_IF_T
 
 bool NetworkAdapterInfo::IsWiFi() const noexcept { return m_type == IF_TYPE_IEEE80211; }
 
+uint32_t NetworkAdapterInfo::GetInterfaceIndex() const noexcept { return m_interfaceIndex; }
+
 NetworkList::NetworkList() noexcept { Initialize(); }
 
 void NetworkList::Initialize() noexcept {
@@ -88,7 +91,8 @@ void NetworkList::Initialize() noexcept {
           }
 
           m_adapters.emplace_back(pAdapter->Description ? pAdapter->Description : std::string{detail::kUnknownAdapter},
-                                  std::move(macAddress), std::move(ipAddress), std::move(status), pAdapter->Type);
+                                  std::move(macAddress), std::move(ipAddress), std::move(status), pAdapter->Type,
+                                  pAdapter->Index);
         }
       } catch (...) {
       }
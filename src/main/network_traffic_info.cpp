@@ -0,0 +1,214 @@
+#include "main/network_traffic_info.hpp"
+
+// The interface change notification in netioapi.h is only declared once winsock2.h has been seen.
+#include <winsock2.h>
+// clang-format off
+#include <iphlpapi.h>
+// clang-format on
+
+#include <algorithm>
+#include <utility>
+
+#pragma comment(lib, "iphlpapi.lib")
+
+namespace nysys {
+namespace detail {
+
+[[nodiscard]] bool IsTrackedInterface(const MIB_IF_ROW2 &row) noexcept {
+  return row.InterfaceAndOperStatusFlags.HardwareInterface && !row.InterfaceAndOperStatusFlags.FilterInterface;
+}
+
+VOID NETIOAPI_API_ OnInterfaceChange(PVOID context, PMIB_IPINTERFACE_ROW, MIB_NOTIFICATION_TYPE) {
+  static_cast<std::atomic<bool> *>(context)->store(true, std::memory_order_relaxed);
+}
+}  // namespace detail
+
+NetworkTrafficInfo::NetworkTrafficInfo(uint32_t interfaceIndex, const NetworkTrafficRates &rates, uint64_t rxErrorTotal,
+                                       uint64_t txErrorTotal, uint64_t rxDropTotal, uint64_t txDropTotal) noexcept
+    : m_interfaceIndex(interfaceIndex),
+      m_rates(rates),
+      m_rxErrorTotal(rxErrorTotal),
+      m_txErrorTotal(txErrorTotal),
+      m_rxDropTotal(rxDropTotal),
+      m_txDropTotal(txDropTotal) {}
+
+uint32_t NetworkTrafficInfo::GetInterfaceIndex() const noexcept { return m_interfaceIndex; }
+
+double NetworkTrafficInfo::GetRxBytesPerSec() const noexcept { return m_rates.rxBytes; }
+
+double NetworkTrafficInfo::GetTxBytesPerSec() const noexcept { return m_rates.txBytes; }
+
+double NetworkTrafficInfo::GetRxPacketsPerSec() const noexcept { return m_rates.rxPackets; }
+
+double NetworkTrafficInfo::GetTxPacketsPerSec() const noexcept { return m_rates.txPackets; }
+
+double NetworkTrafficInfo::GetRxErrorsPerSec() const noexcept { return m_rates.rxErrors; }
+
+double NetworkTrafficInfo::GetTxErrorsPerSec() const noexcept { return m_rates.txErrors; }
+
+double NetworkTrafficInfo::GetRxDropsPerSec() const noexcept { return m_rates.rxDrops; }
+
+double NetworkTrafficInfo::GetTxDropsPerSec() const noexcept { return m_rates.txDrops; }
+
+uint64_t NetworkTrafficInfo::GetRxErrorTotal() const noexcept { return m_rxErrorTotal; }
+
+uint64_t NetworkTrafficInfo::GetTxErrorTotal() const noexcept { return m_txErrorTotal; }
+
+uint64_t NetworkTrafficInfo::GetRxDropTotal() const noexcept { return m_rxDropTotal; }
+
+uint64_t NetworkTrafficInfo::GetTxDropTotal() const noexcept { return m_txDropTotal; }
+
+NetworkTrafficList::NetworkTrafficList() noexcept { Initialize(); }
+
+NetworkTrafficList::~NetworkTrafficList() {
+  if (m_changeNotification) {
+    CancelMibChangeNotify2(m_changeNotification);
+  }
+}
+
+void NetworkTrafficList::Initialize() noexcept {
+  try {
+    if (!Enumerate()) {
+      m_lastError = NetworkTrafficError::InterfaceTableFailed;
+      return;
+    }
+
+    // Without the notification, adapters that appear later are only picked up after a lookup fails.
+    if (NotifyIpInterfaceChange(AF_UNSPEC, detail::OnInterfaceChange, &m_tableChanged, FALSE,
+                                &m_changeNotification) != NO_ERROR) {
+      m_changeNotification = nullptr;
+    }
+
+    m_initialized = true;
+    m_lastError = m_counters.empty() ? NetworkTrafficError::NoInterfacesFound : NetworkTrafficError::Success;
+
+    Update();
+  } catch (...) {
+    m_counters.clear();
+    m_interfaces.clear();
+    m_lastError = NetworkTrafficError::MemoryAllocationFailed;
+    m_initialized = false;
+  }
+}
+
+// Rebuilds the tracked set from the interface table. Interfaces that are still present keep their counters, and so
+// their rate baselines; new ones start a fresh baseline and report zero rates on their first tick.
+bool NetworkTrafficList::Enumerate() {
+  MIB_IF_TABLE2 *table = nullptr;
+  if (GetIfTable2(&table) != NO_ERROR || !table) {
+    return false;
+  }
+
+  std::vector<InterfaceCounters> counters;
+  try {
+    for (ULONG i = 0; i < table->NumEntries; ++i) {
+      const auto &row = table->Table[i];
+      if (!detail::IsTrackedInterface(row)) {
+        continue;
+      }
+
+      const auto existing = std::find_if(m_counters.begin(), m_counters.end(), [&row](const auto &tracked) {
+        return tracked.interfaceIndex == row.InterfaceIndex && tracked.interfaceLuid == row.InterfaceLuid.Value;
+      });
+      if (existing != m_counters.end()) {
+        counters.push_back(std::move(*existing));
+        continue;
+      }
+
+      InterfaceCounters added;
+      added.interfaceIndex = row.InterfaceIndex;
+      added.interfaceLuid = row.InterfaceLuid.Value;
+      counters.push_back(added);
+    }
+    m_interfaces.reserve(counters.size());
+  } catch (...) {
+    FreeMibTable(table);
+    throw;
+  }
+  FreeMibTable(table);
+
+  m_counters = std::move(counters);
+  return true;
+}
+
+bool NetworkTrafficList::Update() noexcept {
+  if (!m_initialized) {
+    return false;
+  }
+
+  try {
+    if (m_tableChanged.exchange(false, std::memory_order_relaxed) && !Enumerate()) {
+      m_tableChanged = true;
+      m_lastError = NetworkTrafficError::InterfaceTableFailed;
+      return false;
+    }
+  } catch (...) {
+    m_lastError = NetworkTrafficError::MemoryAllocationFailed;
+    return false;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  const double elapsedSeconds = std::chrono::duration<double>(now - m_lastSampleTime).count();
+  bool missing = false;
+
+  // Capacity for every tracked interface was reserved by Enumerate, so emplacing here never allocates.
+  m_interfaces.clear();
+  for (auto &counters : m_counters) {
+    MIB_IF_ROW2 row{};
+    row.InterfaceIndex = counters.interfaceIndex;
+    if (GetIfEntry2(&row) != NO_ERROR || row.InterfaceLuid.Value != counters.interfaceLuid) {
+      missing = true;
+      continue;
+    }
+
+    NetworkTrafficRates rates;
+    rates.rxBytes = counters.rxBytes.Update(row.InOctets, elapsedSeconds);
+    rates.txBytes = counters.txBytes.Update(row.OutOctets, elapsedSeconds);
+    rates.rxPackets = counters.rxPackets.Update(row.InUcastPkts + row.InNUcastPkts, elapsedSeconds);
+    rates.txPackets = counters.txPackets.Update(row.OutUcastPkts + row.OutNUcastPkts, elapsedSeconds);
+    rates.rxErrors = counters.rxErrors.Update(row.InErrors, elapsedSeconds);
+    rates.txErrors = counters.txErrors.Update(row.OutErrors, elapsedSeconds);
+    rates.rxDrops = counters.rxDrops.Update(row.InDiscards, elapsedSeconds);
+    rates.txDrops = counters.txDrops.Update(row.OutDiscards, elapsedSeconds);
+
+    m_interfaces.emplace_back(counters.interfaceIndex, rates, row.InErrors, row.OutErrors, row.InDiscards,
+                              row.OutDiscards);
+  }
+
+  // A vanished adapter is left out of this tick and dropped from the tracked set on the next one.
+  if (missing) {
+    m_tableChanged = true;
+  }
+
+  m_lastSampleTime = now;
+  m_lastError = m_counters.empty() ? NetworkTrafficError::NoInterfacesFound : NetworkTrafficError::Success;
+  return true;
+}
+
+size_t NetworkTrafficList::GetCount() const noexcept { return m_interfaces.size(); }
+
+const NetworkTrafficInfo *NetworkTrafficList::GetInterface(size_t index) const noexcept {
+  if (index < m_interfaces.size()) {
+    return &m_interfaces[index];
+  }
+  return nullptr;
+}
+
+const NetworkTrafficInfo *NetworkTrafficList::FindByInterfaceIndex(uint32_t interfaceIndex) const noexcept {
+  for (const auto &networkInterface : m_interfaces) {
+    if (networkInterface.GetInterfaceIndex() == interfaceIndex) {
+      return &networkInterface;
+    }
+  }
+  return nullptr;
+}
+
+const std::vector<NetworkTrafficInfo> &NetworkTrafficList::GetInterfaces() const noexcept { return m_interfaces; }
+
+bool NetworkTrafficList::IsInitialized() const noexcept { return m_initialized; }
+
+NetworkTrafficError NetworkTrafficList::GetLastError() const noexcept { return m_lastError; }
+
+std::unique_ptr<NetworkTrafficList> GetNetworkTrafficList() { return std::make_unique<NetworkTrafficList>(); }
+
+}  // namespace nysys
\ No newline at end of file
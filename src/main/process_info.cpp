@@ -0,0 +1,199 @@
+#include "main/process_info.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "helper/nt_helper.hpp"
+
+namespace nysys {
+namespace detail {
+
+[[nodiscard]] std::string ImageNameToUtf8(const nt::UnicodeString &imageName) {
+  if (!imageName.Buffer || imageName.Length == 0) {
+    return std::string{kIdleProcessName};
+  }
+
+  const int wideLength = static_cast<int>(imageName.Length / sizeof(WCHAR));
+  const int sizeNeeded = WideCharToMultiByte(CP_UTF8, 0, imageName.Buffer, wideLength, nullptr, 0, nullptr, nullptr);
+  if (sizeNeeded <= 0) {
+    return {};
+  }
+
+  std::string result(static_cast<size_t>(sizeNeeded), '\0');
+  WideCharToMultiByte(CP_UTF8, 0, imageName.Buffer, wideLength, result.data(), sizeNeeded, nullptr, nullptr);
+  return result;
+}
+}  // namespace detail
+
+ProcessInfo::ProcessInfo(uint32_t processId, std::string processName, double cpuPercent, uint64_t workingSet,
+                         uint64_t ioReadRate, uint64_t ioWriteRate) noexcept
+    : m_processId(processId),
+      m_name(std::move(processName)),
+      m_cpuPercent(cpuPercent),
+      m_workingSet(workingSet),
+      m_ioReadRate(ioReadRate),
+      m_ioWriteRate(ioWriteRate) {}
+
+uint32_t ProcessInfo::GetProcessId() const noexcept { return m_processId; }
+
+const std::string &ProcessInfo::GetName() const noexcept { return m_name; }
+
+double ProcessInfo::GetCpuPercent() const noexcept { return m_cpuPercent; }
+
+uint64_t ProcessInfo::GetWorkingSet() const noexcept { return m_workingSet; }
+
+uint64_t ProcessInfo::GetIoReadRate() const noexcept { return m_ioReadRate; }
+
+uint64_t ProcessInfo::GetIoWriteRate() const noexcept { return m_ioWriteRate; }
+
+ProcessList::ProcessList(size_t topCount) noexcept
+    : m_topCount(std::min(topCount == 0 ? detail::kDefaultTopProcessCount : topCount, detail::kMaxTopProcessCount)) {
+  Initialize();
+}
+
+void ProcessList::Initialize() noexcept {
+  try {
+    const DWORD processorCount = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    m_processorCount = processorCount > 0 ? processorCount : 1;
+
+    m_bufferSize = detail::kInitialProcessBufferSize;
+    m_buffer = std::make_unique<BYTE[]>(m_bufferSize);
+    m_heap.reserve(m_topCount + 1);
+    m_topByCpu.reserve(m_topCount);
+    m_topByMemory.reserve(m_topCount);
+    m_topByIo.reserve(m_topCount);
+
+    m_initialized = true;
+
+    Update();
+  } catch (...) {
+    m_lastError = ProcessError::MemoryAllocationFailed;
+    m_initialized = false;
+  }
+}
+
+bool ProcessList::QuerySnapshot() noexcept {
+  for (int attempt = 0; attempt < 4; ++attempt) {
+    ULONG returnLength = 0;
+    const auto status =
+        nt::QuerySystemInformation(nt::kSystemProcessInformation, m_buffer.get(), m_bufferSize, &returnLength);
+
+    if (nt::IsSuccess(status)) {
+      return true;
+    }
+
+    if (status != nt::kStatusInfoLengthMismatch && status != nt::kStatusBufferTooSmall) {
+      return false;
+    }
+
+    try {
+      m_bufferSize = std::max(returnLength, m_bufferSize * 2) + detail::kProcessBufferSlack;
+      m_buffer = std::make_unique<BYTE[]>(m_bufferSize);
+    } catch (...) {
+      m_bufferSize = 0;
+      m_buffer.reset();
+      return false;
+    }
+  }
+
+  return false;
+}
+
+void ProcessList::ParseSnapshot() {
+  m_current.clear();
+
+  const BYTE *cursor = m_buffer.get();
+  const BYTE *const end = cursor + m_bufferSize;
+
+  while (cursor + sizeof(nt::SystemProcessInformation) <= end) {
+    const auto *entry = reinterpret_cast<const nt::SystemProcessInformation *>(cursor);
+    const auto processId = static_cast<uint32_t>(reinterpret_cast<ULONG_PTR>(entry->UniqueProcessId));
+
+    if (processId != 0) {
+      proc::ProcessSample sample;
+      sample.processId = processId;
+      sample.createTime = entry->CreateTime.QuadPart;
+      sample.cpuTime = nt::ToCounter(entry->UserTime) + nt::ToCounter(entry->KernelTime);
+      sample.ioReadBytes = nt::ToCounter(entry->ReadTransferCount);
+      sample.ioWriteBytes = nt::ToCounter(entry->WriteTransferCount);
+      sample.workingSet = entry->WorkingSetSize;
+      sample.entry = entry;
+      m_current.push_back(sample);
+    }
+
+    if (entry->NextEntryOffset == 0) {
+      break;
+    }
+    cursor += entry->NextEntryOffset;
+  }
+
+  proc::SortByProcessId(m_current);
+}
+
+template <typename Metric>
+void ProcessList::SelectTop(Metric metric, std::vector<ProcessInfo> &output) {
+  proc::SelectTop(m_current, m_topCount, metric, m_heap);
+
+  output.clear();
+  for (const uint32_t index : m_heap) {
+    const auto &sample = m_current[index];
+    const auto *entry = static_cast<const nt::SystemProcessInformation *>(sample.entry);
+    output.emplace_back(sample.processId, detail::ImageNameToUtf8(entry->ImageName), sample.cpuPercent,
+                        sample.workingSet, sample.ioReadRate, sample.ioWriteRate);
+  }
+}
+
+bool ProcessList::Update() noexcept {
+  if (!m_initialized) {
+    return false;
+  }
+
+  try {
+    if (!QuerySnapshot()) {
+      m_lastError = ProcessError::SnapshotQueryFailed;
+      return false;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsedSeconds = std::chrono::duration<double>(now - m_lastSampleTime).count();
+
+    const double cpuCapacity = elapsedSeconds * 1.0e7 * static_cast<double>(m_processorCount);
+    const double cpuScale = (m_hasBaseline && cpuCapacity > 0.0) ? 100.0 / cpuCapacity : 0.0;
+    const double ioScale = (m_hasBaseline && elapsedSeconds > 0.0) ? 1.0 / elapsedSeconds : 0.0;
+
+    ParseSnapshot();
+    proc::ComputeRates(m_current, m_previous, cpuScale, ioScale);
+
+    SelectTop([](const proc::ProcessSample &s) { return s.cpuPercent; }, m_topByCpu);
+    SelectTop([](const proc::ProcessSample &s) { return s.workingSet; }, m_topByMemory);
+    SelectTop([](const proc::ProcessSample &s) { return s.ioReadRate + s.ioWriteRate; }, m_topByIo);
+
+    std::swap(m_current, m_previous);
+    m_lastSampleTime = now;
+    m_hasBaseline = true;
+
+    m_lastError = ProcessError::Success;
+    return true;
+  } catch (...) {
+    m_lastError = ProcessError::MemoryAllocationFailed;
+    return false;
+  }
+}
+
+size_t ProcessList::GetProcessCount() const noexcept { return m_previous.size(); }
+
+size_t ProcessList::GetTopCount() const noexcept { return m_topCount; }
+
+const std::vector<ProcessInfo> &ProcessList::GetTopByCpu() const noexcept { return m_topByCpu; }
+
+const std::vector<ProcessInfo> &ProcessList::GetTopByMemory() const noexcept { return m_topByMemory; }
+
+const std::vector<ProcessInfo> &ProcessList::GetTopByIo() const noexcept { return m_topByIo; }
+
+bool ProcessList::IsInitialized() const noexcept { return m_initialized; }
+
+ProcessError ProcessList::GetLastError() const noexcept { return m_lastError; }
+
+std::unique_ptr<ProcessList> GetProcessList(size_t topCount) { return std::make_unique<ProcessList>(topCount); }
+
+}  // namespace nysys
\ No newline at end of file
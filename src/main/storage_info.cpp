@@ -19,8 +19,8 @@ namespace {
   return result.empty() ? std::string{fallback} : result;
 }
 
-[[nodiscard]] double GetSafeDoubleProperty(IWbemClassObject *pclsObj, std::wstring_view property,
-                                           double fallback = 0.0) noexcept {
+[[nodiscard]] uint64_t GetSafeUint64Property(IWbemClassObject *pclsObj, std::wstring_view property,
+                                             uint64_t fallback = 0) noexcept {
   if (!pclsObj) {
     return fallback;
   }
@@ -29,9 +29,9 @@ namespace {
   VariantInit(&vtProp);
 
   if (SUCCEEDED(pclsObj->Get(property.data(), 0, &vtProp, 0, 0)) && vtProp.vt != VT_NULL) {
-    double result = fallback;
-    if (vtProp.vt == VT_BSTR) {
-      result = utils::DoubleToGB(_wtof(vtProp.bstrVal));
+    uint64_t result = fallback;
+    if (vtProp.vt == VT_BSTR && vtProp.bstrVal != nullptr) {
+      result = _wcstoui64(vtProp.bstrVal, nullptr, 10);
     }
     VariantClear(&vtProp);
     return result;
@@ -69,13 +69,15 @@ const std::string &PhysicalDiskInfo::GetInterfaceType() const noexcept { return
 const std::string &PhysicalDiskInfo::GetDeviceID() const noexcept { return m_deviceID; }
 
 LogicalDiskInfo::LogicalDiskInfo(std::string driveLetter, std::string driveType, std::string driveModel,
-                                 std::string diskInterface, double diskTotalSize, double diskFreeSpace) noexcept
+                                 std::string diskInterface, uint64_t diskTotalSize, uint64_t diskFreeSpace,
+                                 uint32_t physicalDiskIndex) noexcept
     : m_drive(std::move(driveLetter)),
       m_type(std::move(driveType)),
       m_model(std::move(driveModel)),
       m_interfaceType(std::move(diskInterface)),
       m_totalSize(diskTotalSize),
-      m_freeSpace(diskFreeSpace) {}
+      m_freeSpace(diskFreeSpace),
+      m_diskIndex(physicalDiskIndex) {}
 
 const std::string &LogicalDiskInfo::GetDriveLetter() const noexcept { return m_drive; }
 
@@ -85,12 +87,25 @@ const std::string &LogicalDiskInfo::GetModel() const noexcept { return m_model;
 
 const std::string &LogicalDiskInfo::GetInterfaceType() const noexcept { return m_interfaceType; }
 
-double LogicalDiskInfo::GetTotalSize() const noexcept { return m_totalSize; }
+double LogicalDiskInfo::GetTotalSize() const noexcept { return utils::BytesToGB(m_totalSize); }
 
-double LogicalDiskInfo::GetAvailableSpace() const noexcept { return m_freeSpace; }
+double LogicalDiskInfo::GetAvailableSpace() const noexcept { return utils::BytesToGB(m_freeSpace); }
+
+uint64_t LogicalDiskInfo::GetTotalSizeBytes() const noexcept { return m_totalSize; }
+
+uint64_t LogicalDiskInfo::GetAvailableSpaceBytes() const noexcept { return m_freeSpace; }
+
+uint64_t LogicalDiskInfo::GetUsedSpaceBytes() const noexcept {
+  return m_totalSize > m_freeSpace ? m_totalSize - m_freeSpace : 0;
+}
+
+uint32_t LogicalDiskInfo::GetDiskIndex() const noexcept { return m_diskIndex; }
+
+bool LogicalDiskInfo::HasDiskIndex() const noexcept { return m_diskIndex != detail::kUnknownDiskIndex; }
 
 static void ProcessLogicalDisk(IWbemClassObject *pLogicalObj, const std::string &physicalModel,
-                               const std::string &physicalInterface, std::vector<LogicalDiskInfo> &disks) noexcept {
+                               const std::string &physicalInterface, uint32_t physicalDiskIndex,
+                               std::vector<LogicalDiskInfo> &disks) noexcept {
   try {
     std::string driveLetter = GetSafeStringProperty(pLogicalObj, L"DeviceID", "N/A");
 
@@ -114,17 +129,44 @@ static void ProcessLogicalDisk(IWbemClassObject *pLogicalObj, const std::string
       model = std::string{detail::kUnknownStorageDevice};
     }
 
-    double totalSize = GetSafeDoubleProperty(pLogicalObj, L"Size");
-    double freeSpace = GetSafeDoubleProperty(pLogicalObj, L"FreeSpace");
+    uint64_t totalSize = GetSafeUint64Property(pLogicalObj, L"Size");
+    uint64_t freeSpace = GetSafeUint64Property(pLogicalObj, L"FreeSpace");
 
     disks.emplace_back(std::move(driveLetter), std::move(driveType), std::move(model), std::string{physicalInterface},
-                       totalSize, freeSpace);
+                       totalSize, freeSpace, physicalDiskIndex);
   } catch (...) {
   }
 }
 
+static bool ProcessLogicalDisksOnly(wmi::WMISession &wmiSession, std::vector<LogicalDiskInfo> &disks) noexcept {
+  auto pEnumerator = wmiSession.ExecuteQuery(
+      L"SELECT DeviceID, DriveType, VolumeName, Size, FreeSpace FROM Win32_LogicalDisk "
+      L"WHERE DriveType = 2 OR DriveType = 3");
+  if (!pEnumerator) {
+    return false;
+  }
+
+  IWbemClassObject *pLogicalObj = nullptr;
+  ULONG uReturn = 0;
+
+  while (SUCCEEDED(pEnumerator->Next(WBEM_INFINITE, 1, &pLogicalObj, &uReturn)) && uReturn != 0) {
+    ProcessLogicalDisk(pLogicalObj, std::string{}, std::string{detail::kUnknownInterface}, detail::kUnknownDiskIndex,
+                       disks);
+
+    if (pLogicalObj) {
+      pLogicalObj->Release();
+      pLogicalObj = nullptr;
+    }
+  }
+  return true;
+}
+
 StorageList::StorageList() noexcept { Initialize(); }
 
+StorageList::StorageList(bool includePhysicalDetails) noexcept : m_includePhysicalDetails(includePhysicalDetails) {
+  Initialize();
+}
+
 void StorageList::Initialize() noexcept {
   try {
     wmi::WMISession wmiSession;
@@ -133,6 +175,17 @@ void StorageList::Initialize() noexcept {
       return;
     }
 
+    if (!m_includePhysicalDetails) {
+      if (!ProcessLogicalDisksOnly(wmiSession, m_disks)) {
+        m_lastError = StorageError::QueryExecutionFailed;
+        return;
+      }
+
+      m_initialized = true;
+      m_lastError = StorageError::Success;
+      return;
+    }
+
     auto pEnumerator = wmiSession.ExecuteQuery(L"SELECT * FROM Win32_DiskDrive");
     if (!pEnumerator) {
       m_lastError = StorageError::QueryExecutionFailed;
@@ -148,6 +201,14 @@ void StorageList::Initialize() noexcept {
 
         std::string interfaceType = GetSafeStringProperty(pDiskObj, L"InterfaceType", detail::kUnknownInterface);
 
+        uint32_t diskIndex = detail::kUnknownDiskIndex;
+        VARIANT vtIndex;
+        VariantInit(&vtIndex);
+        if (SUCCEEDED(pDiskObj->Get(L"Index", 0, &vtIndex, 0, 0)) && vtIndex.vt != VT_NULL) {
+          diskIndex = static_cast<uint32_t>(vtIndex.uintVal);
+        }
+        VariantClear(&vtIndex);
+
         VARIANT vtDeviceID;
         VariantInit(&vtDeviceID);
 
@@ -177,7 +238,7 @@ void StorageList::Initialize() noexcept {
 
                   while (SUCCEEDED(logicalEnum->Next(WBEM_INFINITE, 1, &pLogicalObj, &uLogicalReturn)) &&
                          uLogicalReturn != 0) {
-                    ProcessLogicalDisk(pLogicalObj, model, interfaceType, m_disks);
+                    ProcessLogicalDisk(pLogicalObj, model, interfaceType, diskIndex, m_disks);
 
                     if (pLogicalObj) {
                       pLogicalObj->Release();
@@ -229,6 +290,8 @@ bool StorageList::IsInitialized() const noexcept { return m_initialized; }
 
 StorageError StorageList::GetLastError() const noexcept { return m_lastError; }
 
-std::unique_ptr<StorageList> GetStorageList() { return std::make_unique<StorageList>(); }
+std::unique_ptr<StorageList> GetStorageList(bool includePhysicalDetails) {
+  return std::make_unique<StorageList>(includePhysicalDetails);
+}
 
 }  // namespace nysys
\ No newline at end of file
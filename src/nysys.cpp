@@ -1,8 +1,10 @@
 #include "nysys.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <chrono>
+#include <filesystem>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -10,58 +12,56 @@
 #include <process.h>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
-
+#include <vector>
+
+#include "helper/alert_engine.hpp"
+#include "helper/batch_buffer.hpp"
+#include "helper/deadband_filter.hpp"
+#include "helper/expression.hpp"
+#include "helper/handle_wrapper.hpp"
+#include "helper/http_server.hpp"
 #include "helper/json_structure.hpp"
+#include "helper/pipe_server.hpp"
+#include "helper/projection.hpp"
+#include "helper/quantile_sketch.hpp"
+#include "helper/segment_store.hpp"
+#include "helper/shared_snapshot.hpp"
+#include "helper/time_series.hpp"
+#include "helper/uploader.hpp"
 #include "internal.hpp"
 
-class HandleWrapper {
-public:
-  explicit HandleWrapper(HANDLE handle = nullptr) noexcept : m_handle(handle) {}
-
-  ~HandleWrapper() noexcept { Close(); }
-
-  HandleWrapper(HandleWrapper &&other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
-
-  HandleWrapper &operator=(HandleWrapper &&other) noexcept {
-    if (this != &other) {
-      Close();
-      m_handle = std::exchange(other.m_handle, nullptr);
-    }
-    return *this;
-  }
-
-  HandleWrapper(const HandleWrapper &) = delete;
-  HandleWrapper &operator=(const HandleWrapper &) = delete;
-
-  [[nodiscard]] HANDLE get() const noexcept { return m_handle; }
-
-  [[nodiscard]] HANDLE release() noexcept { return std::exchange(m_handle, nullptr); }
-
-  void reset(HANDLE newHandle = nullptr) noexcept {
-    Close();
-    m_handle = newHandle;
-  }
-
-  [[nodiscard]] explicit operator bool() const noexcept { return IsValid(); }
-
-  [[nodiscard]] bool IsValid() const noexcept { return m_handle && m_handle != INVALID_HANDLE_VALUE; }
-
-private:
-  void Close() noexcept {
-    if (IsValid()) {
-      CloseHandle(m_handle);
-      m_handle = nullptr;
-    }
-  }
-
-  HANDLE m_handle;
-};
-
 class MonitorContext {
 public:
   std::atomic<bool> isRunning{false};
   std::atomic<int32_t> updateInterval{nysys::DEFAULT_UPDATE_INTERVAL_MS};
+  std::atomic<size_t> topProcessCount{nysys::detail::kDefaultTopProcessCount};
+  std::atomic<nysys::OutputFormat> outputFormat{nysys::OutputFormat::Json};
+  std::atomic<nysys::UnitsMode> unitsMode{nysys::UnitsMode::Legacy};
+  std::atomic<bool> deltaMode{false};
+  std::atomic<int32_t> keyframeInterval{nysys::DEFAULT_KEYFRAME_INTERVAL};
+  std::atomic<bool> keyframeRequested{true};
+  std::atomic<bool> channelMode{false};
+  std::atomic<int32_t> inventoryRefreshInterval{nysys::DEFAULT_INVENTORY_REFRESH_INTERVAL};
+  std::atomic<bool> inventoryRequested{true};
+  std::atomic<uint64_t> inventoryHash{0};
+  std::atomic<bool> batching{false};
+  std::atomic<bool> historyEnabled{false};
+  std::atomic<bool> percentilesEnabled{false};
+  std::atomic<bool> alertsEnabled{false};
+  std::atomic<bool> derivedEnabled{false};
+  std::atomic<bool> storageEnabled{false};
+  std::atomic<bool> storageStopping{false};
+  std::atomic<int32_t> storageFlushInterval{static_cast<int32_t>(storage::detail::kDefaultFlushIntervalMs)};
+  std::atomic<bool> httpEnabled{false};
+  std::atomic<bool> httpStopping{false};
+  std::atomic<bool> sharedEnabled{false};
+  std::atomic<bool> pipeEnabled{false};
+  std::atomic<bool> pipeStopping{false};
+  std::atomic<bool> uploadEnabled{false};
+  std::atomic<bool> uploadStopping{false};
   std::atomic<bool> isFirstRun{true};
   std::atomic<bool> shouldStop{false};
   std::atomic<size_t> cycleCount{0};
@@ -69,15 +69,77 @@ public:
 
   HandleWrapper monitorThread;
   HandleWrapper stopEvent;
+  HandleWrapper storageThread;
+  HandleWrapper storageEvent;
+  HandleWrapper httpThread;
+  HandleWrapper pipeThread;
+  HandleWrapper uploadThread;
   mutable std::mutex dataMutex;
   mutable std::mutex callbackMutex;
   mutable std::mutex errorMutex;
-
+  mutable std::mutex historyMutex;
+  mutable std::mutex sketchMutex;
+  mutable std::mutex alertMutex;
+  mutable std::mutex derivedMutex;
+  mutable std::mutex storageMutex;
+  mutable std::mutex httpMutex;
+  mutable std::mutex sharedMutex;
+  mutable std::mutex pipeMutex;
+  mutable std::mutex uploadMutex;
+
+  NysysDataCallback cDataCallback{nullptr};
+  void *cDataUserData{nullptr};
+  std::function<void(std::string_view, uint64_t)> cppDataCallback;
   NysysCallback cCallback{nullptr};
   std::function<void(const std::string &)> cppCallback;
+  NysysBinaryCallback cBinaryCallback{nullptr};
+  std::function<void(std::string_view, uint64_t)> cppBinaryCallback;
+  std::atomic<uint64_t> deliverySequence{0};
+  NysysDataCallback cInventoryCallback{nullptr};
+  void *cInventoryUserData{nullptr};
+  std::function<void(std::string_view, uint64_t)> cppInventoryCallback;
+  std::atomic<uint64_t> inventorySequence{0};
+  NysysDataCallback cTelemetryCallback{nullptr};
+  void *cTelemetryUserData{nullptr};
+  std::function<void(std::string_view, uint64_t)> cppTelemetryCallback;
+  std::atomic<uint64_t> telemetrySequence{0};
+  NysysAlertCallback cAlertCallback{nullptr};
+  void *cAlertUserData{nullptr};
+  std::function<void(const nysys::AlertEvent &)> cppAlertCallback;
 
   nysys::StaticInfo staticInfo;
   nysys::DynamicInfo dynamicInfo;
+  nysys::LiveInfo liveInfo;
+  json::JsonWriter jsonWriter;
+  json::BinaryWriter binaryWriter;
+  json::JsonWriter inventoryJsonWriter;
+  json::BinaryWriter inventoryBinaryWriter;
+  json::BatchBuffer batchBuffer;
+  std::optional<nysys::BatchOptions> pendingBatchOptions;
+  uint64_t sampleSequence = 0;
+  json::SnapshotTree collectedTree;
+  json::SnapshotTree snapshotTree;
+  json::SnapshotTree previousSnapshotTree;
+  uint64_t deltaSequence = 0;
+  int32_t cyclesSinceKeyframe = 0;
+  int32_t cyclesSinceInventory = 0;
+  bool inventoryDirty = true;
+  filter::DeadbandFilter deadbandFilter;
+  filter::Projection projection;
+  history::HistoryStore historyStore;
+  history::SketchStore sketchStore;
+  json::SnapshotTree percentileTree;
+  alert::AlertEngine alertEngine;
+  expr::ExpressionEngine expressionEngine;
+  json::SnapshotTree derivedTree;
+  storage::SegmentStore segmentStore;
+  storage::RecordQueue recordQueue;
+  net::HttpServer httpServer;
+  json::JsonWriter httpJsonWriter;
+  json::BinaryWriter httpBinaryWriter;
+  shm::SnapshotPublisher sharedPublisher;
+  net::PipeServer pipeServer;
+  upload::Uploader uploader;
 
   std::chrono::steady_clock::time_point startTime;
   std::chrono::steady_clock::time_point lastUpdateTime;
@@ -91,6 +153,20 @@ public:
     std::lock_guard<std::mutex> lock(dataMutex);
     staticInfo.Reset();
     dynamicInfo.Reset();
+    liveInfo.Reset();
+    previousSnapshotTree.Reset();
+    deltaSequence = 0;
+    cyclesSinceKeyframe = 0;
+    keyframeRequested = true;
+    cyclesSinceInventory = 0;
+    inventoryDirty = true;
+    inventoryRequested = true;
+    inventoryHash = 0;
+    deliverySequence = 0;
+    inventorySequence = 0;
+    telemetrySequence = 0;
+    batchBuffer.Clear();
+    sampleSequence = 0;
     isFirstRun = true;
     shouldStop = false;
     cycleCount = 0;
@@ -103,308 +179,2248 @@ public:
     return intervalMs >= nysys::MIN_UPDATE_INTERVAL_MS && intervalMs <= 3600000;
   }
 
-  [[nodiscard]] nysys::MonitoringError SetUpdateInterval(int32_t intervalMs) noexcept {
-    if (!IsValidInterval(intervalMs)) {
+  [[nodiscard]] static bool IsValidTopProcessCount(int64_t count) noexcept {
+    return count > 0 && count <= static_cast<int64_t>(nysys::detail::kMaxTopProcessCount);
+  }
+
+  [[nodiscard]] nysys::MonitoringError SetTopProcessCount(int64_t count) noexcept {
+    if (!IsValidTopProcessCount(count)) {
       SetLastError(nysys::MonitoringError::InvalidParameter);
       return nysys::MonitoringError::InvalidParameter;
     }
-    updateInterval = intervalMs;
+    topProcessCount = static_cast<size_t>(count);
     return nysys::MonitoringError::Success;
   }
 
-  void SetLastError(nysys::MonitoringError error) noexcept {
-    std::lock_guard<std::mutex> lock(errorMutex);
-    lastError = error;
+  [[nodiscard]] static bool IsValidOutputFormat(int32_t format) noexcept {
+    return format >= static_cast<int32_t>(nysys::OutputFormat::Json) &&
+           format <= static_cast<int32_t>(nysys::OutputFormat::MessagePack);
   }
 
-  [[nodiscard]] nysys::MonitoringError GetLastError() const noexcept {
-    std::lock_guard<std::mutex> lock(errorMutex);
-    return lastError;
+  [[nodiscard]] nysys::MonitoringError SetOutputFormat(int32_t format) noexcept {
+    if (!IsValidOutputFormat(format)) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
+      return nysys::MonitoringError::InvalidParameter;
+    }
+    outputFormat = static_cast<nysys::OutputFormat>(format);
+    keyframeRequested = true;
+    inventoryRequested = true;
+    return nysys::MonitoringError::Success;
+  }
+
+  [[nodiscard]] static bool IsValidUnitsMode(int32_t mode) noexcept {
+    return mode >= static_cast<int32_t>(nysys::UnitsMode::Legacy) &&
+           mode <= static_cast<int32_t>(nysys::UnitsMode::Raw);
   }
 
-  [[nodiscard]] nysys::MonitoringError InvokeCallbacks(const std::string &jsonData) const noexcept {
-    if (jsonData.empty()) {
+  [[nodiscard]] nysys::MonitoringError SetUnitsMode(int32_t mode) noexcept {
+    if (!IsValidUnitsMode(mode)) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
       return nysys::MonitoringError::InvalidParameter;
     }
+    unitsMode = static_cast<nysys::UnitsMode>(mode);
+    keyframeRequested = true;
+    inventoryRequested = true;
+    return nysys::MonitoringError::Success;
+  }
 
-    std::lock_guard<std::mutex> lock(callbackMutex);
+  [[nodiscard]] static bool IsValidKeyframeInterval(int32_t interval) noexcept {
+    return interval > 0 && interval <= 86400;
+  }
+
+  [[nodiscard]] nysys::MonitoringError SetDeltaMode(bool enabled, int32_t interval) noexcept {
+    if (!IsValidKeyframeInterval(interval)) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
+      return nysys::MonitoringError::InvalidParameter;
+    }
+    keyframeInterval = interval;
+    keyframeRequested = true;
+    deltaMode = enabled;
+    return nysys::MonitoringError::Success;
+  }
 
-    bool callbackFailed = false;
+  [[nodiscard]] static bool IsValidInventoryRefreshInterval(int32_t interval) noexcept {
+    return interval > 0 && interval <= 86400;
+  }
 
-    if (cCallback) {
-      try {
-        cCallback(jsonData.c_str());
-      } catch (...) {
-        callbackFailed = true;
-      }
+  [[nodiscard]] nysys::MonitoringError SetChannelMode(bool enabled, int32_t interval) noexcept {
+    if (!IsValidInventoryRefreshInterval(interval)) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
+      return nysys::MonitoringError::InvalidParameter;
     }
+    inventoryRefreshInterval = interval;
+    keyframeRequested = true;
+    inventoryRequested = true;
+    channelMode = enabled;
+    return nysys::MonitoringError::Success;
+  }
 
-    if (cppCallback) {
-      try {
-        cppCallback(jsonData);
-      } catch (...) {
-        callbackFailed = true;
-      }
+  [[nodiscard]] bool ShouldRefreshInventory() noexcept {
+    if (++cyclesSinceInventory < inventoryRefreshInterval) {
+      return false;
     }
+    cyclesSinceInventory = 0;
+    return true;
+  }
 
-    return callbackFailed ? nysys::MonitoringError::CallbackExecutionFailed : nysys::MonitoringError::Success;
+  [[nodiscard]] static bool IsValidBatchOptions(const nysys::BatchOptions &options) noexcept {
+    const auto framing = static_cast<int32_t>(options.framing);
+    return framing >= static_cast<int32_t>(nysys::BatchFraming::JsonArray) &&
+           framing <= static_cast<int32_t>(nysys::BatchFraming::Ndjson) &&
+           options.maxSamples <= nysys::detail::kMaxBatchSamples && options.maxBytes <= json::detail::kMaxBatchBytes &&
+           options.maxAge.count() >= 0 && options.maxAge.count() <= 3600000 &&
+           (options.maxSamples > 0 || options.maxBytes > 0 || options.maxAge.count() > 0);
   }
 
-  void InitializeSession() noexcept {
-    startTime = std::chrono::steady_clock::now();
-    lastUpdateTime = startTime;
-    cycleCount = 0;
-    SetLastError(nysys::MonitoringError::Success);
+  [[nodiscard]] nysys::MonitoringError SetBatching(bool enabled, const nysys::BatchOptions &options) noexcept {
+    if (!IsValidBatchOptions(options)) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
+      return nysys::MonitoringError::InvalidParameter;
+    }
+    std::lock_guard<std::mutex> lock(dataMutex);
+    pendingBatchOptions = options;
+    batching = enabled;
+    return nysys::MonitoringError::Success;
   }
 
-  void IncrementCycle() noexcept {
-    ++cycleCount;
-    lastUpdateTime = std::chrono::steady_clock::now();
+  [[nodiscard]] static bool IsValidDeadbandMode(int32_t mode) noexcept {
+    return mode >= static_cast<int32_t>(nysys::DeadbandMode::Absolute) &&
+           mode <= static_cast<int32_t>(nysys::DeadbandMode::Percent);
   }
 
-  [[nodiscard]] std::chrono::milliseconds GetUptime() const noexcept {
-    if (startTime.time_since_epoch().count() == 0) {
-      return std::chrono::milliseconds{0};
+  [[nodiscard]] filter::DeadbandError AddDeadbandRule(std::string_view path, int32_t mode, double threshold) noexcept {
+    filter::DeadbandError result = filter::DeadbandError::InvalidMode;
+    if (IsValidDeadbandMode(mode)) {
+      std::lock_guard<std::mutex> lock(dataMutex);
+      result = deadbandFilter.AddRule(path, static_cast<filter::DeadbandMode>(mode), threshold);
     }
-    const auto now = std::chrono::steady_clock::now();
-    return std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime);
+    if (result != filter::DeadbandError::Success) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
+    }
+    return result;
   }
 
-  [[nodiscard]] bool ShouldStop() const noexcept { return shouldStop || !isRunning; }
-
-  void RequestStop() noexcept { shouldStop = true; }
-};
+  void ClearDeadbandRules() noexcept {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    deadbandFilter.ClearRules();
+  }
 
-static MonitorContext g_MonitorContext;
+  [[nodiscard]] static bool IsValidMaxSilence(int64_t maxSilenceMs) noexcept {
+    return maxSilenceMs >= 0 && maxSilenceMs <= 86400000;
+  }
 
-static nysys::MonitoringError CollectStaticInfo(nysys::StaticInfo &staticInfo) noexcept {
-  try {
-    staticInfo.cpuList = nysys::GetCPUList();
-    if (!staticInfo.cpuList) {
-      return nysys::MonitoringError::DataCollectionFailed;
+  [[nodiscard]] nysys::MonitoringError SetMaxSilence(int64_t maxSilenceMs) noexcept {
+    if (!IsValidMaxSilence(maxSilenceMs)) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
+      return nysys::MonitoringError::InvalidParameter;
     }
+    std::lock_guard<std::mutex> lock(dataMutex);
+    deadbandFilter.SetMaxSilence(std::chrono::milliseconds{maxSilenceMs});
+    return nysys::MonitoringError::Success;
+  }
 
-    staticInfo.gpuList = nysys::GetGPUList();
-    if (!staticInfo.gpuList) {
-      return nysys::MonitoringError::DataCollectionFailed;
+  [[nodiscard]] nysys::FilterStats GetFilterStats() const noexcept {
+    nysys::FilterStats stats;
+    stats.emittedCount = deadbandFilter.GetEmittedCount();
+    stats.suppressedCount = deadbandFilter.GetSuppressedCount();
+    stats.heartbeatCount = deadbandFilter.GetHeartbeatCount();
+    return stats;
+  }
+
+  [[nodiscard]] filter::ProjectionError SetProjection(const std::vector<std::string> &paths) noexcept {
+    filter::ProjectionError result = filter::ProjectionError::Success;
+    {
+      std::lock_guard<std::mutex> lock(dataMutex);
+      result = projection.SetPaths(paths);
+    }
+    if (result != filter::ProjectionError::Success) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
+      return result;
     }
+    keyframeRequested = true;
+    inventoryRequested = true;
+    return result;
+  }
 
-    staticInfo.mbInfo = nysys::GetMotherboardInfo();
-    if (!staticInfo.mbInfo) {
-      return nysys::MonitoringError::DataCollectionFailed;
+  void ClearProjection() noexcept {
+    {
+      std::lock_guard<std::mutex> lock(dataMutex);
+      projection.Clear();
     }
+    keyframeRequested = true;
+    inventoryRequested = true;
+  }
 
-    staticInfo.audioList = nysys::GetAudioDeviceList();
-    if (!staticInfo.audioList) {
-      return nysys::MonitoringError::DataCollectionFailed;
+  [[nodiscard]] history::HistoryError AddHistoryMetric(std::string_view path) noexcept {
+    history::HistoryError result = history::HistoryError::Success;
+    {
+      std::lock_guard<std::mutex> lock(historyMutex);
+      result = historyStore.AddMetric(path);
+      historyEnabled = historyStore.IsEnabled();
+    }
+    if (result != history::HistoryError::Success) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
     }
+    return result;
+  }
 
-    staticInfo.monitorList = nysys::GetMonitorList();
-    if (!staticInfo.monitorList) {
-      return nysys::MonitoringError::DataCollectionFailed;
+  void ClearHistoryMetrics() noexcept {
+    std::lock_guard<std::mutex> lock(historyMutex);
+    historyStore.ClearMetrics();
+    historyEnabled = false;
+  }
+
+  [[nodiscard]] history::HistoryError SetHistoryCapacity(const nysys::HistoryCapacity &capacity) noexcept {
+    history::HistoryError result = history::HistoryError::Success;
+    {
+      std::lock_guard<std::mutex> lock(historyMutex);
+      result = historyStore.SetCapacities({capacity.raw, capacity.seconds, capacity.minutes, capacity.hours});
     }
+    if (result != history::HistoryError::Success) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
+    }
+    return result;
+  }
 
-    return nysys::MonitoringError::Success;
-  } catch (...) {
-    staticInfo.Reset();
-    return nysys::MonitoringError::DataCollectionFailed;
+  [[nodiscard]] static bool IsValidHistoryResolution(int32_t resolution) noexcept {
+    return resolution >= static_cast<int32_t>(nysys::HistoryResolution::Raw) &&
+           resolution <= static_cast<int32_t>(nysys::HistoryResolution::Hour);
   }
-}
 
-static nysys::MonitoringError CollectDynamicInfo(nysys::DynamicInfo &dynamicInfo) noexcept {
-  try {
-    dynamicInfo.memInfo = nysys::GetMemoryInfo();
-    if (!dynamicInfo.memInfo) {
-      return nysys::MonitoringError::DataCollectionFailed;
+  [[nodiscard]] history::HistoryError QueryHistory(std::string_view metric, int64_t fromMs, int64_t toMs,
+                                                   int32_t resolution, std::vector<history::Point> &points) noexcept {
+    history::HistoryError result = history::HistoryError::InvalidResolution;
+    if (IsValidHistoryResolution(resolution)) {
+      std::lock_guard<std::mutex> lock(historyMutex);
+      result = historyStore.Query(metric, fromMs, toMs, static_cast<history::Resolution>(resolution), points);
+    }
+    if (result != history::HistoryError::Success) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
     }
+    return result;
+  }
 
-    dynamicInfo.storageList = nysys::GetStorageList();
-    if (!dynamicInfo.storageList) {
-      return nysys::MonitoringError::DataCollectionFailed;
+  [[nodiscard]] size_t GetHistoryMemoryUsage() const noexcept {
+    std::lock_guard<std::mutex> lock(historyMutex);
+    return historyStore.GetMemoryUsage();
+  }
+
+  void RecordHistory(const json::SnapshotTree &tree) noexcept {
+    if (!historyEnabled) {
+      return;
     }
+    std::lock_guard<std::mutex> lock(historyMutex);
+    historyStore.Record(tree, CurrentTimeMs());
+  }
 
-    dynamicInfo.networkList = nysys::GetNetworkAdapterList();
-    if (!dynamicInfo.networkList) {
-      return nysys::MonitoringError::DataCollectionFailed;
+  [[nodiscard]] history::SketchError AddPercentileMetric(std::string_view path) noexcept {
+    history::SketchError result = history::SketchError::Success;
+    {
+      std::lock_guard<std::mutex> lock(sketchMutex);
+      result = sketchStore.AddMetric(path);
+      percentilesEnabled = sketchStore.IsEnabled();
+    }
+    if (result != history::SketchError::Success) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
     }
+    return result;
+  }
 
-    dynamicInfo.batteryInfo = nysys::GetBatteryInfo();
+  void ClearPercentileMetrics() noexcept {
+    std::lock_guard<std::mutex> lock(sketchMutex);
+    sketchStore.ClearMetrics();
+    percentilesEnabled = false;
+  }
 
-    return nysys::MonitoringError::Success;
-  } catch (...) {
-    dynamicInfo.Reset();
-    return nysys::MonitoringError::DataCollectionFailed;
+  [[nodiscard]] history::SketchError SetPercentileWindow(int64_t windowMs, size_t slices) noexcept {
+    history::SketchError result = history::SketchError::Success;
+    {
+      std::lock_guard<std::mutex> lock(sketchMutex);
+      result = sketchStore.SetWindow(windowMs, slices);
+    }
+    if (result != history::SketchError::Success) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
+    }
+    return result;
   }
-}
 
-static std::optional<std::string> GenerateJsonSafely(const nysys::StaticInfo &staticInfo,
-                                                     const nysys::DynamicInfo &dynamicInfo) noexcept {
-  try {
-    if (!staticInfo.IsComplete() || !dynamicInfo.IsEssentialComplete()) {
-      return std::nullopt;
+  void ResetPercentiles() noexcept {
+    std::lock_guard<std::mutex> lock(sketchMutex);
+    sketchStore.Reset();
+  }
+
+  [[nodiscard]] history::SketchError QueryPercentiles(std::string_view metric, int32_t window,
+                                                      history::SketchSummary &summary) noexcept {
+    history::SketchError result = history::SketchError::InvalidWindow;
+    if (window >= static_cast<int32_t>(nysys::PercentileWindow::Sliding) &&
+        window <= static_cast<int32_t>(nysys::PercentileWindow::Run)) {
+      std::lock_guard<std::mutex> lock(sketchMutex);
+      result = sketchStore.Query(metric, static_cast<history::SketchWindow>(window), CurrentTimeMs(), summary);
+    }
+    if (result != history::SketchError::Success) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
     }
+    return result;
+  }
 
-    json::JsonConfig config{};
-    auto jsonResult = json::GenerateSystemInfo(
-        staticInfo.gpuList.get(), staticInfo.mbInfo.get(), staticInfo.cpuList.get(), dynamicInfo.memInfo.get(),
-        dynamicInfo.storageList.get(), dynamicInfo.networkList.get(), staticInfo.audioList.get(),
-        dynamicInfo.batteryInfo.get(), staticInfo.monitorList.get(), config);
+  // Sketches read the collected values; the summary section is spliced into the outgoing snapshot afterwards.
+  void RecordPercentiles(const json::SnapshotTree &tree, json::SnapshotTree &snapshot) noexcept {
+    if (!percentilesEnabled) {
+      return;
+    }
+    const auto timestamp = CurrentTimeMs();
+    std::lock_guard<std::mutex> lock(sketchMutex);
+    sketchStore.Record(tree, timestamp);
+    if (!sketchStore.WriteSection(percentileTree, timestamp)) {
+      return;
+    }
+    try {
+      snapshot.InsertField("percentiles", percentileTree);
+    } catch (...) {
+    }
+  }
 
-    return jsonResult.has_value() ? std::make_optional(std::move(jsonResult.value())) : std::nullopt;
-  } catch (...) {
-    return std::nullopt;
+  [[nodiscard]] alert::AlertError AddAlertRule(const nysys::AlertRule &rule) noexcept {
+    alert::AlertError result = alert::AlertError::Success;
+    try {
+      alert::AlertRule compiled;
+      compiled.name = rule.name;
+      compiled.path = rule.path;
+      compiled.condition = static_cast<alert::AlertCondition>(rule.condition);
+      compiled.threshold = rule.threshold;
+      compiled.hysteresis = rule.hysteresis;
+      compiled.durationMs = rule.duration.count();
+      std::lock_guard<std::mutex> lock(alertMutex);
+      result = alertEngine.AddRule(compiled);
+      alertsEnabled = alertEngine.IsEnabled();
+    } catch (...) {
+      result = alert::AlertError::MemoryAllocationFailed;
+    }
+    if (result != alert::AlertError::Success) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
+    }
+    return result;
   }
-}
 
-static unsigned __stdcall monitoring_thread(void *) {
-  g_MonitorContext.InitializeSession();
+  void ClearAlertRules() noexcept {
+    std::lock_guard<std::mutex> lock(alertMutex);
+    alertEngine.ClearRules();
+    alertsEnabled = false;
+  }
 
-  while (g_MonitorContext.isRunning) {
-    if (WaitForSingleObject(g_MonitorContext.stopEvent.get(), 0) == WAIT_OBJECT_0)
-      break;
+  [[nodiscard]] nysys::AlertStats GetAlertStats() const noexcept {
+    alert::AlertStats stats;
+    {
+      std::lock_guard<std::mutex> lock(alertMutex);
+      stats = alertEngine.GetStats();
+    }
+    const auto average = stats.evaluations > 0 ? stats.totalEvaluationNs / static_cast<int64_t>(stats.evaluations) : 0;
+    return nysys::AlertStats{stats.ruleCount,
+                             stats.activeCount,
+                             stats.evaluations,
+                             stats.raisedCount,
+                             stats.clearedCount,
+                             std::chrono::nanoseconds{stats.lastEvaluationNs},
+                             std::chrono::nanoseconds{stats.maxEvaluationNs},
+                             std::chrono::nanoseconds{average}};
+  }
 
-    if (g_MonitorContext.isFirstRun) {
-      std::lock_guard<std::mutex> lock(g_MonitorContext.dataMutex);
-      auto staticResult = CollectStaticInfo(g_MonitorContext.staticInfo);
-      if (staticResult == nysys::MonitoringError::Success) {
-        g_MonitorContext.isFirstRun = false;
-      } else {
-        g_MonitorContext.SetLastError(staticResult);
-      }
+  // Alert callbacks run on the monitoring thread with the rule set locked, so they must not add or clear rules.
+  void EvaluateAlerts(const json::SnapshotTree &tree) noexcept {
+    if (!alertsEnabled) {
+      return;
     }
 
-    nysys::MonitoringError dynamicResult = nysys::MonitoringError::DataCollectionFailed;
-    {
-      std::lock_guard<std::mutex> lock(g_MonitorContext.dataMutex);
-      dynamicResult = CollectDynamicInfo(g_MonitorContext.dynamicInfo);
+    std::lock_guard<std::mutex> lock(alertMutex);
+    const auto &events = alertEngine.Evaluate(tree, CurrentTimeMs());
+    if (events.empty()) {
+      return;
     }
 
-    if (dynamicResult == nysys::MonitoringError::Success && !g_MonitorContext.isFirstRun) {
-      std::optional<std::string> jsonOutput;
-      {
-        std::lock_guard<std::mutex> lock(g_MonitorContext.dataMutex);
-        jsonOutput = GenerateJsonSafely(g_MonitorContext.staticInfo, g_MonitorContext.dynamicInfo);
+    std::lock_guard<std::mutex> callbackLock(callbackMutex);
+    for (const auto &event : events) {
+      const auto &rule = alertEngine.GetRule(event.rule);
+      if (cAlertCallback) {
+        const NysysAlertEvent alertEvent{rule.name.c_str(), rule.path.c_str(), static_cast<int32_t>(event.state),
+                                         event.value,       rule.threshold,    event.timestamp};
+        try {
+          cAlertCallback(&alertEvent, cAlertUserData);
+        } catch (...) {
+        }
       }
-
-      if (jsonOutput.has_value()) {
-        auto callbackResult = g_MonitorContext.InvokeCallbacks(jsonOutput.value());
-        if (callbackResult != nysys::MonitoringError::Success) {
-          g_MonitorContext.SetLastError(callbackResult);
+      if (cppAlertCallback) {
+        const nysys::AlertEvent alertEvent{rule.name,   rule.path,      static_cast<nysys::AlertState>(event.state),
+                                           event.value, rule.threshold, event.timestamp};
+        try {
+          cppAlertCallback(alertEvent);
+        } catch (...) {
         }
-      } else {
-        g_MonitorContext.SetLastError(nysys::MonitoringError::JsonGenerationFailed);
       }
-    } else if (dynamicResult != nysys::MonitoringError::Success) {
-      g_MonitorContext.SetLastError(dynamicResult);
     }
+  }
 
+  [[nodiscard]] expr::ExpressionError AddDerivedMetric(std::string_view name, std::string_view expression) noexcept {
+    expr::ExpressionError result = expr::ExpressionError::Success;
     {
-      std::lock_guard<std::mutex> lock(g_MonitorContext.dataMutex);
-      g_MonitorContext.dynamicInfo.Reset();
+      std::lock_guard<std::mutex> lock(derivedMutex);
+      result = expressionEngine.AddExpression(name, expression);
+      derivedEnabled = expressionEngine.IsEnabled();
     }
+    if (result != expr::ExpressionError::Success) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
+      return result;
+    }
+    keyframeRequested = true;
+    return result;
+  }
 
-    g_MonitorContext.IncrementCycle();
-
-    const auto currentInterval = g_MonitorContext.updateInterval.load();
-    Sleep(static_cast<DWORD>(currentInterval));
+  void ClearDerivedMetrics() noexcept {
+    {
+      std::lock_guard<std::mutex> lock(derivedMutex);
+      expressionEngine.ClearExpressions();
+      derivedEnabled = false;
+    }
+    keyframeRequested = true;
   }
 
-  return 0;
-}
+  // Derived values land in the collected tree before history, alerts and sketches read it, so those can refer to
+  // /derived/<name> like any collected field.
+  void ApplyDerivedMetrics(json::SnapshotTree &tree, json::SnapshotTree *projected) noexcept {
+    if (!derivedEnabled) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(derivedMutex);
+    expressionEngine.Evaluate(tree);
+    if (!expressionEngine.WriteSection(derivedTree)) {
+      return;
+    }
+    try {
+      tree.InsertField("derived", derivedTree);
+      if (projected) {
+        projected->InsertField("derived", derivedTree);
+      }
+    } catch (...) {
+    }
+  }
 
-BOOL start_monitoring(int32_t updateIntervalMs) {
-  if (g_MonitorContext.isRunning) {
-    g_MonitorContext.SetLastError(nysys::MonitoringError::AlreadyRunning);
-    return FALSE;
+  [[nodiscard]] static int64_t CurrentTimeMs() noexcept {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
   }
 
-  auto intervalResult = g_MonitorContext.SetUpdateInterval(updateIntervalMs);
-  if (intervalResult != nysys::MonitoringError::Success) {
-    g_MonitorContext.SetLastError(intervalResult);
-    return FALSE;
+  [[nodiscard]] bool UsesSnapshotTree() const noexcept {
+    return deltaMode || deadbandFilter.IsEnabled() || projection.IsEnabled() || historyEnabled || percentilesEnabled ||
+           alertsEnabled || derivedEnabled || pipeEnabled;
   }
 
-  try {
-    g_MonitorContext.isFirstRun = true;
+  [[nodiscard]] bool ShouldEmitKeyframe() const noexcept {
+    return keyframeRequested || previousSnapshotTree.IsEmpty() || cyclesSinceKeyframe >= keyframeInterval;
+  }
 
-    HANDLE stopEventHandle = CreateEvent(nullptr, TRUE, FALSE, nullptr);
-    if (!stopEventHandle) {
-      g_MonitorContext.SetLastError(nysys::MonitoringError::SystemResourceError);
-      return FALSE;
+  void CommitSnapshot(bool keyframe) noexcept {
+    previousSnapshotTree.Swap(snapshotTree);
+    ++deltaSequence;
+    if (keyframe) {
+      keyframeRequested = false;
+      cyclesSinceKeyframe = 1;
+    } else {
+      ++cyclesSinceKeyframe;
     }
-    g_MonitorContext.stopEvent.reset(stopEventHandle);
-
-    g_MonitorContext.Reset();
+  }
 
-    HANDLE threadHandle = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, monitoring_thread, nullptr, 0, nullptr));
-    if (!threadHandle) {
-      g_MonitorContext.stopEvent.reset();
-      g_MonitorContext.SetLastError(nysys::MonitoringError::ThreadCreationFailed);
-      return FALSE;
+  [[nodiscard]] nysys::MonitoringError SetUpdateInterval(int32_t intervalMs) noexcept {
+    if (!IsValidInterval(intervalMs)) {
+      SetLastError(nysys::MonitoringError::InvalidParameter);
+      return nysys::MonitoringError::InvalidParameter;
     }
-    g_MonitorContext.monitorThread.reset(threadHandle);
+    updateInterval = intervalMs;
+    return nysys::MonitoringError::Success;
+  }
 
-    g_MonitorContext.isRunning = true;
-    return TRUE;
-  } catch (...) {
-    g_MonitorContext.stopEvent.reset();
-    g_MonitorContext.monitorThread.reset();
-    g_MonitorContext.isRunning = false;
-    g_MonitorContext.SetLastError(nysys::MonitoringError::UnknownError);
-    return FALSE;
+  void SetLastError(nysys::MonitoringError error) noexcept {
+    std::lock_guard<std::mutex> lock(errorMutex);
+    lastError = error;
   }
-}
 
-void stop_monitoring(void) {
-  if (!g_MonitorContext.isRunning)
-    return;
+  [[nodiscard]] nysys::MonitoringError GetLastError() const noexcept {
+    std::lock_guard<std::mutex> lock(errorMutex);
+    return lastError;
+  }
+
+  template <typename Buffer>
+  [[nodiscard]] nysys::MonitoringError InvokeCallbacks(const Buffer &buffer) noexcept {
+    if (buffer.empty()) {
+      return nysys::MonitoringError::InvalidParameter;
+    }
+
+    const auto *data = reinterpret_cast<const uint8_t *>(buffer.data());
+    const size_t size = buffer.size();
+
+    std::lock_guard<std::mutex> lock(callbackMutex);
+
+    const uint64_t sequence = ++deliverySequence;
+    bool success = InvokeDataCallback(cDataCallback, data, size, sequence, cDataUserData);
+
+    if constexpr (std::is_same_v<Buffer, std::string>) {
+      if (cCallback) {
+        success = InvokeDataCallback(InvokeLegacyCallback, data, size, sequence, &cCallback) && success;
+      }
+
+      if (cppCallback) {
+        try {
+          cppCallback(buffer);
+        } catch (...) {
+          success = false;
+        }
+      }
+    }
+
+    if (cBinaryCallback) {
+      success = InvokeDataCallback(InvokeLegacyBinaryCallback, data, size, sequence, &cBinaryCallback) && success;
+    }
+
+    const std::string_view view(reinterpret_cast<const char *>(data), size);
+    for (const auto *callback : {&cppDataCallback, &cppBinaryCallback}) {
+      if (*callback) {
+        try {
+          (*callback)(view, sequence);
+        } catch (...) {
+          success = false;
+        }
+      }
+    }
+
+    return success ? nysys::MonitoringError::Success : nysys::MonitoringError::CallbackExecutionFailed;
+  }
+
+  template <typename Buffer>
+  [[nodiscard]] nysys::MonitoringError InvokeInventoryCallbacks(const Buffer &buffer) noexcept {
+    return InvokeChannelCallbacks(cInventoryCallback, cInventoryUserData, cppInventoryCallback, inventorySequence,
+                                  buffer);
+  }
+
+  template <typename Buffer>
+  [[nodiscard]] nysys::MonitoringError InvokeTelemetryCallbacks(const Buffer &buffer) noexcept {
+    return InvokeChannelCallbacks(cTelemetryCallback, cTelemetryUserData, cppTelemetryCallback, telemetrySequence,
+                                  buffer);
+  }
+
+  void InitializeSession() noexcept {
+    deadbandFilter.ResetStats();
+    startTime = std::chrono::steady_clock::now();
+    lastUpdateTime = startTime;
+    cycleCount = 0;
+    SetLastError(nysys::MonitoringError::Success);
+  }
+
+  void IncrementCycle() noexcept {
+    ++cycleCount;
+    lastUpdateTime = std::chrono::steady_clock::now();
+  }
+
+  [[nodiscard]] std::chrono::milliseconds GetUptime() const noexcept {
+    if (startTime.time_since_epoch().count() == 0) {
+      return std::chrono::milliseconds{0};
+    }
+    const auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime);
+  }
+
+  [[nodiscard]] bool ShouldStop() const noexcept { return shouldStop || !isRunning; }
+
+  void RequestStop() noexcept { shouldStop = true; }
+
+private:
+  template <typename Buffer>
+  [[nodiscard]] nysys::MonitoringError InvokeChannelCallbacks(
+      NysysDataCallback cChannelCallback, void *cChannelUserData,
+      const std::function<void(std::string_view, uint64_t)> &cppChannelCallback,
+      std::atomic<uint64_t> &channelSequence, const Buffer &buffer) noexcept {
+    if (buffer.empty()) {
+      return nysys::MonitoringError::InvalidParameter;
+    }
+
+    const auto *data = reinterpret_cast<const uint8_t *>(buffer.data());
+    const size_t size = buffer.size();
+
+    std::lock_guard<std::mutex> lock(callbackMutex);
+
+    const uint64_t sequence = ++channelSequence;
+    bool success = InvokeDataCallback(cChannelCallback, data, size, sequence, cChannelUserData);
+
+    if (cppChannelCallback) {
+      try {
+        cppChannelCallback(std::string_view(reinterpret_cast<const char *>(data), size), sequence);
+      } catch (...) {
+        success = false;
+      }
+    }
+
+    return success ? nysys::MonitoringError::Success : nysys::MonitoringError::CallbackExecutionFailed;
+  }
+
+  static void InvokeLegacyCallback(const uint8_t *data, size_t, uint64_t, void *userData) {
+    (*static_cast<NysysCallback *>(userData))(reinterpret_cast<const char *>(data));
+  }
+
+  static void InvokeLegacyBinaryCallback(const uint8_t *data, size_t size, uint64_t, void *userData) {
+    (*static_cast<NysysBinaryCallback *>(userData))(data, size);
+  }
+
+  [[nodiscard]] static bool InvokeDataCallback(NysysDataCallback callback, const uint8_t *data, size_t size,
+                                               uint64_t sequence, void *userData) noexcept {
+    if (!callback) {
+      return true;
+    }
+
+    try {
+      callback(data, size, sequence, userData);
+      return true;
+    } catch (...) {
+      return false;
+    }
+  }
+};
+
+static MonitorContext g_MonitorContext;
+
+[[nodiscard]] static nysys::CollectionPlan BuildCollectionPlan(const filter::Projection &projection) noexcept {
+  nysys::CollectionPlan plan;
+  if (!projection.IsEnabled()) {
+    return plan;
+  }
+
+  plan.gpu = projection.Requires({"gpu"});
+  plan.motherboard = projection.Requires({"motherboard"});
+  plan.cpu = projection.Requires({"cpu"});
+  plan.audio = projection.Requires({"audio"});
+  plan.monitors = projection.Requires({"monitors"});
+  plan.memory = projection.Requires({"memory"});
+  plan.ramSlots = projection.Requires({"memory", "ram_slots"});
+  plan.storage = projection.Requires({"storage"});
+  plan.diskIO = projection.Requires({"storage", "*", "io"});
+  plan.storageDetails = plan.diskIO || projection.Requires({"storage", "*", "model"}) ||
+                        projection.Requires({"storage", "*", "interface"});
+  plan.network = projection.Requires({"network"});
+  plan.networkTraffic = projection.Requires({"network", "*", "*", "traffic"});
+  plan.battery = projection.Requires({"battery"});
+  plan.cpuUsage = projection.Requires({"cpu_usage"});
+  plan.cpuFrequency = projection.Requires({"cpu_frequency"});
+  plan.processes = projection.Requires({"processes"});
+  return plan;
+}
+
+template <typename T, typename Factory>
+static bool CollectIfMissing(bool needed, std::unique_ptr<T> &info, Factory factory) {
+  if (needed && !info) {
+    info = factory();
+  }
+  return !needed || info;
+}
+
+static nysys::MonitoringError CollectStaticInfo(nysys::StaticInfo &staticInfo,
+                                                const nysys::CollectionPlan &plan) noexcept {
+  try {
+    if (!CollectIfMissing(plan.cpu, staticInfo.cpuList, nysys::GetCPUList) ||
+        !CollectIfMissing(plan.gpu, staticInfo.gpuList, nysys::GetGPUList) ||
+        !CollectIfMissing(plan.motherboard, staticInfo.mbInfo, nysys::GetMotherboardInfo) ||
+        !CollectIfMissing(plan.audio, staticInfo.audioList, nysys::GetAudioDeviceList) ||
+        !CollectIfMissing(plan.monitors, staticInfo.monitorList, nysys::GetMonitorList)) {
+      return nysys::MonitoringError::DataCollectionFailed;
+    }
+
+    return nysys::MonitoringError::Success;
+  } catch (...) {
+    staticInfo.Reset();
+    return nysys::MonitoringError::DataCollectionFailed;
+  }
+}
+
+static nysys::MonitoringError CollectDynamicInfo(nysys::DynamicInfo &dynamicInfo,
+                                                 const nysys::CollectionPlan &plan) noexcept {
+  try {
+    if (plan.memory) {
+      dynamicInfo.memInfo = nysys::GetMemoryInfo(plan.ramSlots);
+      if (!dynamicInfo.memInfo) {
+        return nysys::MonitoringError::DataCollectionFailed;
+      }
+    }
+
+    if (plan.storage) {
+      dynamicInfo.storageList = nysys::GetStorageList(plan.storageDetails);
+      if (!dynamicInfo.storageList) {
+        return nysys::MonitoringError::DataCollectionFailed;
+      }
+    }
+
+    if (plan.network) {
+      dynamicInfo.networkList = nysys::GetNetworkAdapterList();
+      if (!dynamicInfo.networkList) {
+        return nysys::MonitoringError::DataCollectionFailed;
+      }
+    }
+
+    if (plan.battery) {
+      dynamicInfo.batteryInfo = nysys::GetBatteryInfo();
+    }
+
+    return nysys::MonitoringError::Success;
+  } catch (...) {
+    dynamicInfo.Reset();
+    return nysys::MonitoringError::DataCollectionFailed;
+  }
+}
+
+template <typename T, typename Factory>
+static bool UpdateSampler(std::unique_ptr<T> &sampler, Factory factory) {
+  if (!sampler) {
+    sampler = factory();
+    if (!sampler || !sampler->IsInitialized()) {
+      sampler.reset();
+      return false;
+    }
+    return true;
+  }
+  return sampler->Update();
+}
+
+template <typename T, typename Factory>
+static bool UpdateSampler(bool needed, std::unique_ptr<T> &sampler, Factory factory) {
+  if (!needed) {
+    sampler.reset();
+    return true;
+  }
+  return UpdateSampler(sampler, factory);
+}
+
+static nysys::MonitoringError CollectLiveInfo(nysys::LiveInfo &liveInfo, size_t topProcessCount,
+                                              const nysys::CollectionPlan &plan) noexcept {
+  try {
+    bool success = UpdateSampler(plan.cpuUsage, liveInfo.cpuUsage, nysys::GetCPUUsageInfo);
+    success = UpdateSampler(plan.cpuFrequency, liveInfo.cpuFrequency, nysys::GetCPUFrequencyInfo) && success;
+
+    if (liveInfo.processList && liveInfo.processList->GetTopCount() != topProcessCount) {
+      liveInfo.ResetProcessInfo();
+    }
+    const auto processFactory = [topProcessCount] { return nysys::GetProcessList(topProcessCount); };
+    success = UpdateSampler(plan.processes, liveInfo.processList, processFactory) && success;
+    success = UpdateSampler(plan.diskIO, liveInfo.diskIO, nysys::GetDiskIOList) && success;
+    success = UpdateSampler(plan.networkTraffic, liveInfo.networkTraffic, nysys::GetNetworkTrafficList) && success;
+
+    return success ? nysys::MonitoringError::Success : nysys::MonitoringError::DataCollectionFailed;
+  } catch (...) {
+    liveInfo.Reset();
+    return nysys::MonitoringError::DataCollectionFailed;
+  }
+}
+
+[[nodiscard]] static units::UnitsMode ToUnitsMode(nysys::UnitsMode mode) noexcept {
+  return mode == nysys::UnitsMode::Raw ? units::UnitsMode::Raw : units::UnitsMode::Legacy;
+}
+
+[[nodiscard]] static json::JsonConfig MakeJsonConfig(const MonitorContext &context) noexcept {
+  json::JsonConfig config{};
+  config.prettyPrint = !context.batching;
+  config.unitsMode = ToUnitsMode(context.unitsMode);
+  return config;
+}
+
+static bool GenerateJsonSafely(json::JsonWriter &writer, const json::JsonConfig &config,
+                               const nysys::StaticInfo &staticInfo, const nysys::DynamicInfo &dynamicInfo,
+                               const nysys::LiveInfo &liveInfo) noexcept {
+  if (!staticInfo.IsComplete() || !dynamicInfo.IsEssentialComplete()) {
+    return false;
+  }
+
+  return json::WriteSystemInfo(writer, staticInfo.gpuList.get(), staticInfo.mbInfo.get(), staticInfo.cpuList.get(),
+                               dynamicInfo.memInfo.get(), dynamicInfo.storageList.get(),
+                               dynamicInfo.networkList.get(), staticInfo.audioList.get(),
+                               dynamicInfo.batteryInfo.get(), staticInfo.monitorList.get(), &liveInfo, config);
+}
+
+static bool GenerateBinarySafely(json::BinaryWriter &writer, json::BinaryFormat format, nysys::UnitsMode unitsMode,
+                                 const nysys::StaticInfo &staticInfo, const nysys::DynamicInfo &dynamicInfo,
+                                 const nysys::LiveInfo &liveInfo) noexcept {
+  if (!staticInfo.IsComplete() || !dynamicInfo.IsEssentialComplete()) {
+    return false;
+  }
+
+  return json::WriteSystemInfo(writer, format, staticInfo.gpuList.get(), staticInfo.mbInfo.get(),
+                               staticInfo.cpuList.get(), dynamicInfo.memInfo.get(), dynamicInfo.storageList.get(),
+                               dynamicInfo.networkList.get(), staticInfo.audioList.get(),
+                               dynamicInfo.batteryInfo.get(), staticInfo.monitorList.get(), &liveInfo,
+                               ToUnitsMode(unitsMode));
+}
+
+static bool BuildSnapshotTreeSafely(json::SnapshotTree &tree, const nysys::CollectionPlan &plan,
+                                    nysys::UnitsMode unitsMode, std::optional<uint64_t> inventoryHash,
+                                    const nysys::StaticInfo &staticInfo, const nysys::DynamicInfo &dynamicInfo,
+                                    const nysys::LiveInfo &liveInfo) noexcept {
+  if (!staticInfo.IsComplete(plan) || !dynamicInfo.IsEssentialComplete(plan)) {
+    return false;
+  }
+
+  return json::WriteSystemInfo(
+      tree, plan.gpu ? staticInfo.gpuList.get() : nullptr, plan.motherboard ? staticInfo.mbInfo.get() : nullptr,
+      plan.cpu ? staticInfo.cpuList.get() : nullptr, dynamicInfo.memInfo.get(), dynamicInfo.storageList.get(),
+      dynamicInfo.networkList.get(), plan.audio ? staticInfo.audioList.get() : nullptr, dynamicInfo.batteryInfo.get(),
+      plan.monitors ? staticInfo.monitorList.get() : nullptr, &liveInfo, ToUnitsMode(unitsMode), inventoryHash);
+}
+
+[[nodiscard]] static json::BinaryFormat ToBinaryFormat(nysys::OutputFormat format) noexcept {
+  return format == nysys::OutputFormat::MessagePack ? json::BinaryFormat::MessagePack : json::BinaryFormat::Cbor;
+}
+
+static bool GenerateFromTreeSafely(MonitorContext &context, const nysys::CollectionPlan &plan,
+                                   nysys::OutputFormat format, std::optional<uint64_t> inventoryHash,
+                                   bool &suppressed) noexcept {
+  suppressed = false;
+  const auto unitsMode = context.unitsMode.load();
+  if (context.projection.IsEnabled()) {
+    if (!BuildSnapshotTreeSafely(context.collectedTree, plan, unitsMode, inventoryHash, context.staticInfo,
+                                 context.dynamicInfo, context.liveInfo) ||
+        !context.projection.Apply(context.collectedTree, context.snapshotTree)) {
+      return false;
+    }
+  } else if (!BuildSnapshotTreeSafely(context.snapshotTree, plan, unitsMode, inventoryHash, context.staticInfo,
+                                      context.dynamicInfo, context.liveInfo)) {
+    return false;
+  }
+  const bool projected = context.projection.IsEnabled();
+  auto &recordedTree = projected ? context.collectedTree : context.snapshotTree;
+  context.ApplyDerivedMetrics(recordedTree, projected ? &context.snapshotTree : nullptr);
+  context.RecordHistory(recordedTree);
+  context.EvaluateAlerts(recordedTree);
+  context.RecordPercentiles(recordedTree, context.snapshotTree);
+
+  const auto now = std::chrono::steady_clock::now();
+  const auto decision = context.deadbandFilter.Evaluate(context.previousSnapshotTree, context.snapshotTree, now);
+  if (decision == filter::FilterDecision::Suppress) {
+    context.deadbandFilter.Record(decision, now);
+    suppressed = true;
+    return true;
+  }
+
+  const bool deltaMode = context.deltaMode;
+  const bool keyframe =
+      deltaMode && (context.ShouldEmitKeyframe() ||
+                    !json::IsMergePatchLossless(context.previousSnapshotTree, context.snapshotTree));
+  const auto config = MakeJsonConfig(context);
+  bool encoded = false;
+  if (deltaMode && format == nysys::OutputFormat::Json) {
+    encoded = json::WriteSystemDelta(context.jsonWriter, context.previousSnapshotTree, context.snapshotTree, keyframe,
+                                     context.deltaSequence, config);
+  } else if (deltaMode) {
+    encoded = json::WriteSystemDelta(context.binaryWriter, ToBinaryFormat(format), context.previousSnapshotTree,
+                                     context.snapshotTree, keyframe, context.deltaSequence);
+  } else if (format == nysys::OutputFormat::Json) {
+    encoded = json::WriteSystemInfo(context.jsonWriter, context.snapshotTree, config);
+  } else {
+    encoded = json::WriteSystemInfo(context.binaryWriter, ToBinaryFormat(format), context.snapshotTree);
+  }
+
+  if (encoded) {
+    context.deadbandFilter.Record(decision, now);
+    context.CommitSnapshot(keyframe);
+  }
+  return encoded;
+}
+
+[[nodiscard]] static nysys::CollectionPlan ToTelemetryPlan(nysys::CollectionPlan plan) noexcept {
+  plan.gpu = false;
+  plan.motherboard = false;
+  plan.cpu = false;
+  plan.audio = false;
+  plan.monitors = false;
+  return plan;
+}
+
+static void RefreshInventorySafely(MonitorContext &context, const nysys::CollectionPlan &plan) noexcept {
+  if (!context.ShouldRefreshInventory()) {
+    return;
+  }
+
+  nysys::StaticInfo refreshed;
+  if (CollectStaticInfo(refreshed, plan) == nysys::MonitoringError::Success) {
+    context.staticInfo = std::move(refreshed);
+    context.inventoryDirty = true;
+  }
+}
+
+static bool GenerateInventorySafely(MonitorContext &context, const nysys::CollectionPlan &plan,
+                                    nysys::OutputFormat format, bool &generated) noexcept {
+  generated = false;
+  const auto &staticInfo = context.staticInfo;
+  if (!staticInfo.IsComplete(plan)) {
+    return false;
+  }
+
+  const auto *gpuList = plan.gpu ? staticInfo.gpuList.get() : nullptr;
+  const auto *mbInfo = plan.motherboard ? staticInfo.mbInfo.get() : nullptr;
+  const auto *cpuList = plan.cpu ? staticInfo.cpuList.get() : nullptr;
+  const auto *audioList = plan.audio ? staticInfo.audioList.get() : nullptr;
+  const auto *monitorList = plan.monitors ? staticInfo.monitorList.get() : nullptr;
+
+  if (context.inventoryDirty || context.inventoryRequested) {
+    const auto hash = json::ComputeInventoryHash(gpuList, mbInfo, cpuList, audioList, monitorList);
+    context.inventoryDirty = false;
+    if (hash != context.inventoryHash) {
+      context.inventoryHash = hash;
+      context.inventoryRequested = true;
+    }
+  }
+
+  if (!context.inventoryRequested) {
+    return true;
+  }
+
+  bool encoded = false;
+  if (format == nysys::OutputFormat::Json) {
+    encoded = json::WriteInventory(context.inventoryJsonWriter, gpuList, mbInfo, cpuList, audioList, monitorList,
+                                   context.inventoryHash, MakeJsonConfig(context));
+  } else {
+    encoded = json::WriteInventory(context.inventoryBinaryWriter, ToBinaryFormat(format), gpuList, mbInfo, cpuList,
+                                   audioList, monitorList, context.inventoryHash, ToUnitsMode(context.unitsMode));
+  }
+
+  if (encoded) {
+    context.inventoryRequested = false;
+    generated = true;
+  }
+  return encoded;
+}
+
+static bool GenerateTelemetrySafely(MonitorContext &context, const nysys::CollectionPlan &plan,
+                                    nysys::OutputFormat format, bool &suppressed) noexcept {
+  suppressed = false;
+  const auto telemetryPlan = ToTelemetryPlan(plan);
+  if (context.UsesSnapshotTree()) {
+    return GenerateFromTreeSafely(context, telemetryPlan, format, context.inventoryHash.load(), suppressed);
+  }
+
+  const auto &dynamicInfo = context.dynamicInfo;
+  if (!dynamicInfo.IsEssentialComplete(telemetryPlan)) {
+    return false;
+  }
+
+  if (format == nysys::OutputFormat::Json) {
+    return json::WriteTelemetry(context.jsonWriter, dynamicInfo.memInfo.get(), dynamicInfo.storageList.get(),
+                                dynamicInfo.networkList.get(), dynamicInfo.batteryInfo.get(), &context.liveInfo,
+                                context.inventoryHash, MakeJsonConfig(context));
+  }
+  return json::WriteTelemetry(context.binaryWriter, ToBinaryFormat(format), dynamicInfo.memInfo.get(),
+                              dynamicInfo.storageList.get(), dynamicInfo.networkList.get(),
+                              dynamicInfo.batteryInfo.get(), &context.liveInfo, context.inventoryHash,
+                              ToUnitsMode(context.unitsMode));
+}
+
+template <typename Buffer>
+[[nodiscard]] static nysys::MonitoringError DeliverPayload(MonitorContext &context, bool channelMode,
+                                                           const Buffer &buffer) noexcept {
+  return channelMode ? context.InvokeTelemetryCallbacks(buffer) : context.InvokeCallbacks(buffer);
+}
+
+[[nodiscard]] static nysys::MonitoringError DeliverBatch(MonitorContext &context, bool channelMode) noexcept {
+  auto &batch = context.batchBuffer;
+  if (batch.IsEmpty()) {
+    return nysys::MonitoringError::Success;
+  }
+
+  auto result = nysys::MonitoringError::JsonGenerationFailed;
+  if (batch.Finish()) {
+    result = batch.IsBinary() ? DeliverPayload(context, channelMode, batch.GetBytes())
+                              : DeliverPayload(context, channelMode, batch.GetText());
+  }
+  batch.Clear();
+  return result;
+}
+
+[[nodiscard]] static nysys::MonitoringError ApplyBatchOptions(MonitorContext &context, bool channelMode) noexcept {
+  std::optional<nysys::BatchOptions> options;
+  {
+    std::lock_guard<std::mutex> lock(context.dataMutex);
+    options = std::exchange(context.pendingBatchOptions, std::nullopt);
+  }
+  if (!options) {
+    return nysys::MonitoringError::Success;
+  }
+
+  const auto result = DeliverBatch(context, channelMode);
+  context.batchBuffer.Configure(static_cast<json::BatchFraming>(options->framing),
+                                json::BatchLimits{options->maxSamples, options->maxBytes, options->maxAge});
+  return result;
+}
+
+[[nodiscard]] static nysys::MonitoringError BatchSample(MonitorContext &context, nysys::OutputFormat format,
+                                                        bool channelMode) noexcept {
+  const bool binary = format != nysys::OutputFormat::Json;
+  const auto binaryFormat = binary ? std::optional<json::BinaryFormat>{ToBinaryFormat(format)} : std::nullopt;
+
+  auto result = nysys::MonitoringError::Success;
+  if (!context.batchBuffer.Matches(binaryFormat)) {
+    result = DeliverBatch(context, channelMode);
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  const auto timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                   std::chrono::system_clock::now().time_since_epoch())
+                                                   .count());
+  const uint64_t sequence = ++context.sampleSequence;
+  const bool appended =
+      binary ? context.batchBuffer.Append(context.binaryWriter.GetBuffer(), *binaryFormat, sequence, timestamp, now)
+             : context.batchBuffer.Append(context.jsonWriter.GetBuffer(), sequence, timestamp, now);
+  if (!appended) {
+    return nysys::MonitoringError::JsonGenerationFailed;
+  }
+
+  if (context.batchBuffer.ShouldFlush(now)) {
+    const auto flushResult = DeliverBatch(context, channelMode);
+    if (flushResult != nysys::MonitoringError::Success) {
+      result = flushResult;
+    }
+  }
+  return result;
+}
+
+[[nodiscard]] static nysys::MonitoringError FlushBatchIfDue(MonitorContext &context, bool channelMode) noexcept {
+  if (context.batching && !context.batchBuffer.ShouldFlush(std::chrono::steady_clock::now())) {
+    return nysys::MonitoringError::Success;
+  }
+  return DeliverBatch(context, channelMode);
+}
+
+template <typename Buffer>
+static void StoreSample(MonitorContext &context, const Buffer &buffer) noexcept {
+  if (!context.storageEnabled || buffer.empty()) {
+    return;
+  }
+
+  const auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+  std::lock_guard<std::mutex> lock(context.storageMutex);
+  if (context.storageEnabled &&
+      context.recordQueue.Push(std::string_view(reinterpret_cast<const char *>(buffer.data()), buffer.size()),
+                               timestamp)) {
+    SetEvent(context.storageEvent.get());
+  }
+}
+
+static unsigned __stdcall storage_thread(void *) {
+  std::vector<storage::QueuedRecord> records;
+  auto lastFlush = std::chrono::steady_clock::now();
+  const auto flushInterval = std::chrono::milliseconds{g_MonitorContext.storageFlushInterval.load()};
+  // A zero interval flushes after every drained batch, so there is nothing to wake up for between samples.
+  const bool flushOnAppend = flushInterval.count() == 0;
+  const DWORD waitMs = flushOnAppend ? INFINITE : static_cast<DWORD>(flushInterval.count());
+
+  while (true) {
+    WaitForSingleObject(g_MonitorContext.storageEvent.get(), waitMs);
+    const bool stopping = g_MonitorContext.storageStopping;
+
+    const size_t count = g_MonitorContext.recordQueue.Drain(records);
+    for (size_t i = 0; i < count; ++i) {
+      const auto &record = records[i];
+      const auto result = g_MonitorContext.segmentStore.Append(
+          reinterpret_cast<const uint8_t *>(record.data.data()), record.data.size(), record.timestamp);
+      if (result != storage::StoreError::Success) {
+        g_MonitorContext.SetLastError(nysys::MonitoringError::SystemResourceError);
+      }
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (stopping || (flushOnAppend ? count > 0 : now - lastFlush >= flushInterval)) {
+      g_MonitorContext.segmentStore.Flush();
+      lastFlush = now;
+    }
+    if (stopping) {
+      break;
+    }
+  }
+  return 0;
+}
+
+static void StopStorageThread(MonitorContext &context) noexcept {
+  context.storageEnabled = false;
+  if (!context.storageThread) {
+    return;
+  }
+
+  context.storageStopping = true;
+  SetEvent(context.storageEvent.get());
+  const DWORD waitResult = WaitForSingleObject(context.storageThread.get(), nysys::MAX_THREAD_WAIT_MS);
+  if (waitResult == WAIT_TIMEOUT) {
+    TerminateThread(context.storageThread.get(), 1);
+    context.SetLastError(nysys::MonitoringError::ThreadTerminationFailed);
+  }
+  context.storageThread.reset();
+  context.storageEvent.reset();
+  context.storageStopping = false;
+}
+
+[[nodiscard]] static bool IsValidStoreOptions(const nysys::SegmentStoreOptions &options) noexcept {
+  return options.flushInterval.count() >= 0 && options.flushInterval.count() <= nysys::MAX_THREAD_WAIT_MS &&
+         options.segmentSize >= storage::detail::kMinSegmentSize &&
+         options.segmentSize <= storage::detail::kMaxSegmentSize && options.retentionBytes >= options.segmentSize;
+}
+
+[[nodiscard]] static storage::StoreError OpenSegmentStore(MonitorContext &context,
+                                                          const std::filesystem::path &directory,
+                                                          const nysys::SegmentStoreOptions &options) noexcept {
+  if (!IsValidStoreOptions(options)) {
+    return storage::StoreError::InvalidOptions;
+  }
+
+  std::lock_guard<std::mutex> lock(context.storageMutex);
+  StopStorageThread(context);
+  context.segmentStore.Close();
+
+  const storage::StoreOptions storeOptions{options.segmentSize, options.retentionBytes};
+  auto result = context.segmentStore.Open(directory, storeOptions);
+  if (result != storage::StoreError::Success) {
+    return result;
+  }
+
+  HANDLE eventHandle = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+  if (!eventHandle) {
+    context.segmentStore.Close();
+    return storage::StoreError::OpenFailed;
+  }
+  context.storageEvent.reset(eventHandle);
+  context.recordQueue.Clear();
+  context.storageFlushInterval = static_cast<int32_t>(options.flushInterval.count());
+
+  HANDLE threadHandle = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, storage_thread, nullptr, 0, nullptr));
+  if (!threadHandle) {
+    context.storageEvent.reset();
+    context.segmentStore.Close();
+    return storage::StoreError::OpenFailed;
+  }
+  context.storageThread.reset(threadHandle);
+  context.storageEnabled = true;
+  return storage::StoreError::Success;
+}
+
+static void CloseSegmentStore(MonitorContext &context) noexcept {
+  std::lock_guard<std::mutex> lock(context.storageMutex);
+  StopStorageThread(context);
+  context.segmentStore.Close();
+}
+
+[[nodiscard]] static nysys::SegmentStoreStats GetSegmentStoreStats(const MonitorContext &context) noexcept {
+  nysys::SegmentStoreStats stats;
+  stats.firstSequence = context.segmentStore.GetFirstSequence();
+  stats.nextSequence = context.segmentStore.GetNextSequence();
+  stats.recoveredCount = context.segmentStore.GetRecoveredCount();
+  stats.droppedCount = context.recordQueue.GetDroppedCount();
+  return stats;
+}
+
+[[nodiscard]] static std::string_view ToContentType(nysys::OutputFormat format) noexcept {
+  switch (format) {
+    case nysys::OutputFormat::Cbor:
+      return "application/cbor";
+    case nysys::OutputFormat::MessagePack:
+      return "application/msgpack";
+    default:
+      return "application/json";
+  }
+}
+
+static void PublishSample(MonitorContext &context, nysys::OutputFormat format) noexcept {
+  if (context.pipeEnabled && context.pipeServer.HasSubscribers()) {
+    std::shared_ptr<json::SnapshotTree> tree;
+    try {
+      std::lock_guard<std::mutex> lock(context.dataMutex);
+      tree = std::make_shared<json::SnapshotTree>(context.previousSnapshotTree);
+    } catch (...) {
+    }
+    if (!tree || !context.pipeServer.Publish(std::move(tree), MonitorContext::CurrentTimeMs())) {
+      context.SetLastError(nysys::MonitoringError::SystemResourceError);
+    }
+  }
+
+  if (!context.httpEnabled && !context.sharedEnabled && !context.uploadEnabled) {
+    return;
+  }
+
+  // Published JSON is always compact; the callback buffer is only reused when batching already made it so.
+  const bool isJson = format == nysys::OutputFormat::Json;
+  auto config = MakeJsonConfig(context);
+  std::string_view payload;
+  if (context.deltaMode || (isJson && config.prettyPrint)) {
+    config.prettyPrint = false;
+    std::lock_guard<std::mutex> lock(context.dataMutex);
+    bool encoded = false;
+    if (context.UsesSnapshotTree()) {
+      encoded = isJson ? json::WriteSystemInfo(context.httpJsonWriter, context.previousSnapshotTree, config)
+                       : json::WriteSystemInfo(context.httpBinaryWriter, ToBinaryFormat(format),
+                                               context.previousSnapshotTree);
+    } else if (context.channelMode) {
+      const auto &dynamicInfo = context.dynamicInfo;
+      encoded = json::WriteTelemetry(context.httpJsonWriter, dynamicInfo.memInfo.get(), dynamicInfo.storageList.get(),
+                                     dynamicInfo.networkList.get(), dynamicInfo.batteryInfo.get(), &context.liveInfo,
+                                     context.inventoryHash, config);
+    } else {
+      encoded = GenerateJsonSafely(context.httpJsonWriter, config, context.staticInfo, context.dynamicInfo,
+                                   context.liveInfo);
+    }
+    if (!encoded) {
+      return;
+    }
+    const auto &binary = context.httpBinaryWriter.GetBuffer();
+    payload = isJson ? std::string_view(context.httpJsonWriter.GetBuffer())
+                     : std::string_view(reinterpret_cast<const char *>(binary.data()), binary.size());
+  } else {
+    const auto &binary = context.binaryWriter.GetBuffer();
+    payload = isJson ? std::string_view(context.jsonWriter.GetBuffer())
+                     : std::string_view(reinterpret_cast<const char *>(binary.data()), binary.size());
+  }
+
+  if (context.sharedEnabled) {
+    std::lock_guard<std::mutex> lock(context.sharedMutex);
+    if (context.sharedEnabled && context.sharedPublisher.Publish(payload, static_cast<int32_t>(format),
+                                                                 MonitorContext::CurrentTimeMs()) !=
+                                     shm::SharedError::Success) {
+      context.SetLastError(nysys::MonitoringError::SystemResourceError);
+    }
+  }
+
+  if (context.httpEnabled) {
+    std::lock_guard<std::mutex> lock(context.httpMutex);
+    if (context.httpEnabled && !context.httpServer.Publish(payload, ToContentType(format), isJson)) {
+      context.SetLastError(nysys::MonitoringError::SystemResourceError);
+    }
+  }
+
+  if (context.uploadEnabled) {
+    std::lock_guard<std::mutex> lock(context.uploadMutex);
+    if (context.uploadEnabled &&
+        !context.uploader.Enqueue(payload, static_cast<uint8_t>(format), MonitorContext::CurrentTimeMs())) {
+      context.SetLastError(nysys::MonitoringError::SystemResourceError);
+    }
+  }
+}
+
+[[nodiscard]] static shm::SharedError OpenSharedSnapshot(MonitorContext &context, const std::string &name,
+                                                        size_t capacity) noexcept {
+  std::lock_guard<std::mutex> lock(context.sharedMutex);
+  context.sharedEnabled = false;
+  const auto result = context.sharedPublisher.Open(name, capacity);
+  context.sharedEnabled = result == shm::SharedError::Success;
+  return result;
+}
+
+static void CloseSharedSnapshot(MonitorContext &context) noexcept {
+  std::lock_guard<std::mutex> lock(context.sharedMutex);
+  context.sharedEnabled = false;
+  context.sharedPublisher.Close();
+}
+
+[[nodiscard]] static nysys::SharedSnapshotStats GetSharedSnapshotStats(const MonitorContext &context) noexcept {
+  std::lock_guard<std::mutex> lock(context.sharedMutex);
+  nysys::SharedSnapshotStats stats;
+  stats.version = context.sharedPublisher.GetVersion();
+  stats.droppedCount = context.sharedPublisher.GetDroppedCount();
+  stats.capacity = context.sharedPublisher.GetCapacity();
+  return stats;
+}
+
+static unsigned __stdcall http_thread(void *) {
+  while (!g_MonitorContext.httpStopping) {
+    g_MonitorContext.httpServer.Poll(net::detail::kPollTimeoutMs);
+  }
+  return 0;
+}
+
+static void StopHttpThread(MonitorContext &context) noexcept {
+  context.httpEnabled = false;
+  if (!context.httpThread) {
+    return;
+  }
+
+  context.httpStopping = true;
+  context.httpServer.Wake();
+  const DWORD waitResult = WaitForSingleObject(context.httpThread.get(), nysys::MAX_THREAD_WAIT_MS);
+  if (waitResult == WAIT_TIMEOUT) {
+    TerminateThread(context.httpThread.get(), 1);
+    context.SetLastError(nysys::MonitoringError::ThreadTerminationFailed);
+  }
+  context.httpThread.reset();
+  context.httpStopping = false;
+}
+
+[[nodiscard]] static net::ServerError StartHttpServer(MonitorContext &context,
+                                                      const nysys::HttpServerOptions &options) noexcept {
+  std::lock_guard<std::mutex> lock(context.httpMutex);
+  StopHttpThread(context);
+  context.httpServer.Close();
+
+  const net::ServerOptions serverOptions{options.port, options.maxClients};
+  auto result = context.httpServer.Open(serverOptions);
+  if (result != net::ServerError::Success) {
+    return result;
+  }
+
+  HANDLE threadHandle = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, http_thread, nullptr, 0, nullptr));
+  if (!threadHandle) {
+    context.httpServer.Close();
+    return net::ServerError::StartupFailed;
+  }
+  context.httpThread.reset(threadHandle);
+  context.httpEnabled = true;
+  return net::ServerError::Success;
+}
+
+static void StopHttpServer(MonitorContext &context) noexcept {
+  std::lock_guard<std::mutex> lock(context.httpMutex);
+  StopHttpThread(context);
+  context.httpServer.Close();
+}
+
+[[nodiscard]] static nysys::HttpServerStats GetHttpServerStats(const MonitorContext &context) noexcept {
+  const auto serverStats = context.httpServer.GetStats();
+  nysys::HttpServerStats stats;
+  stats.port = context.httpServer.GetPort();
+  stats.clientCount = serverStats.clientCount;
+  stats.streamCount = serverStats.streamCount;
+  stats.requestCount = serverStats.requestCount;
+  stats.rejectedCount = serverStats.rejectedCount;
+  stats.publishedCount = serverStats.publishedCount;
+  stats.droppedCount = serverStats.droppedCount;
+  return stats;
+}
+
+static unsigned __stdcall pipe_thread(void *) {
+  while (!g_MonitorContext.pipeStopping) {
+    g_MonitorContext.pipeServer.Poll(net::detail::kPipePollTimeoutMs);
+  }
+  return 0;
+}
+
+static void StopPipeThread(MonitorContext &context) noexcept {
+  context.pipeEnabled = false;
+  if (!context.pipeThread) {
+    return;
+  }
+
+  context.pipeStopping = true;
+  context.pipeServer.Wake();
+  const DWORD waitResult = WaitForSingleObject(context.pipeThread.get(), nysys::MAX_THREAD_WAIT_MS);
+  if (waitResult == WAIT_TIMEOUT) {
+    TerminateThread(context.pipeThread.get(), 1);
+    context.SetLastError(nysys::MonitoringError::ThreadTerminationFailed);
+  }
+  context.pipeThread.reset();
+  context.pipeStopping = false;
+}
+
+[[nodiscard]] static net::PipeError StartPipeServer(MonitorContext &context,
+                                                    const nysys::PipeServerOptions &options) noexcept {
+  std::lock_guard<std::mutex> lock(context.pipeMutex);
+  StopPipeThread(context);
+  context.pipeServer.Close();
+
+  net::PipeError result = net::PipeError::Success;
+  try {
+    const net::PipeOptions pipeOptions{options.name, options.maxClients};
+    result = context.pipeServer.Open(pipeOptions);
+  } catch (...) {
+    result = net::PipeError::MemoryAllocationFailed;
+  }
+  if (result != net::PipeError::Success) {
+    return result;
+  }
+
+  HANDLE threadHandle = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, pipe_thread, nullptr, 0, nullptr));
+  if (!threadHandle) {
+    context.pipeServer.Close();
+    return net::PipeError::CreateFailed;
+  }
+  context.pipeThread.reset(threadHandle);
+  context.pipeEnabled = true;
+  return net::PipeError::Success;
+}
+
+static void StopPipeServer(MonitorContext &context) noexcept {
+  std::lock_guard<std::mutex> lock(context.pipeMutex);
+  StopPipeThread(context);
+  context.pipeServer.Close();
+}
+
+[[nodiscard]] static nysys::PipeServerStats GetPipeServerStats(const MonitorContext &context) noexcept {
+  const auto serverStats = context.pipeServer.GetStats();
+  nysys::PipeServerStats stats;
+  stats.clientCount = serverStats.clientCount;
+  stats.filterCount = serverStats.filterCount;
+  stats.publishedCount = serverStats.publishedCount;
+  stats.encodedCount = serverStats.encodedCount;
+  stats.sentCount = serverStats.sentCount;
+  stats.skippedCount = serverStats.skippedCount;
+  return stats;
+}
+
+static unsigned __stdcall upload_thread(void *) {
+  while (!g_MonitorContext.uploadStopping) {
+    g_MonitorContext.uploader.Poll();
+  }
+  return 0;
+}
+
+static void StopUploadThread(MonitorContext &context) noexcept {
+  context.uploadEnabled = false;
+  if (!context.uploadThread) {
+    return;
+  }
+
+  context.uploadStopping = true;
+  context.uploader.Wake();
+  const DWORD waitResult = WaitForSingleObject(context.uploadThread.get(), nysys::MAX_THREAD_WAIT_MS);
+  if (waitResult == WAIT_TIMEOUT) {
+    TerminateThread(context.uploadThread.get(), 1);
+    context.SetLastError(nysys::MonitoringError::ThreadTerminationFailed);
+  }
+  context.uploadThread.reset();
+  context.uploadStopping = false;
+}
+
+[[nodiscard]] static upload::UploadError StartUploader(MonitorContext &context, std::string_view url,
+                                                      const std::filesystem::path &spoolDirectory,
+                                                      const nysys::UploaderOptions &options) noexcept {
+  std::lock_guard<std::mutex> lock(context.uploadMutex);
+  StopUploadThread(context);
+  context.uploader.Close();
+
+  upload::UploadError result = upload::UploadError::Success;
+  try {
+    upload::UploadOptions uploadOptions;
+    uploadOptions.url = url;
+    uploadOptions.spoolBytes = options.spoolBytes;
+    uploadOptions.batchRecords = options.batchRecords;
+    uploadOptions.batchIntervalMs = options.batchInterval.count();
+    uploadOptions.maxBytesPerSecond = options.maxBytesPerSecond;
+    uploadOptions.compress = options.compress;
+    result = context.uploader.Open(spoolDirectory, uploadOptions);
+  } catch (...) {
+    result = upload::UploadError::MemoryAllocationFailed;
+  }
+  if (result != upload::UploadError::Success) {
+    return result;
+  }
+
+  HANDLE threadHandle = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, upload_thread, nullptr, 0, nullptr));
+  if (!threadHandle) {
+    context.uploader.Close();
+    return upload::UploadError::StartupFailed;
+  }
+  context.uploadThread.reset(threadHandle);
+  context.uploadEnabled = true;
+  return upload::UploadError::Success;
+}
+
+static void StopUploader(MonitorContext &context) noexcept {
+  std::lock_guard<std::mutex> lock(context.uploadMutex);
+  StopUploadThread(context);
+  context.uploader.Close();
+}
+
+[[nodiscard]] static nysys::UploaderStats GetUploaderStats(const MonitorContext &context) noexcept {
+  const auto uploadStats = context.uploader.GetStats();
+  nysys::UploaderStats stats;
+  stats.spooledCount = uploadStats.spooledCount;
+  stats.pendingCount = uploadStats.pendingCount;
+  stats.uploadedCount = uploadStats.uploadedCount;
+  stats.batchCount = uploadStats.batchCount;
+  stats.retryCount = uploadStats.retryCount;
+  stats.rejectedCount = uploadStats.rejectedCount;
+  stats.droppedCount = uploadStats.droppedCount;
+  stats.sentBytes = uploadStats.sentBytes;
+  stats.lastStatus = uploadStats.lastStatus;
+  return stats;
+}
+
+// Waits out the update interval in short slices and folds a CPU clock reading in after each one, so the frequency
+// min/avg/max reported on the next tick cover the whole interval rather than the instant of the tick.
+static void WaitForNextCycle(MonitorContext &context, int32_t intervalMs) noexcept {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{intervalMs};
+  while (true) {
+    const auto remaining =
+        std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+    if (remaining <= 0) {
+      return;
+    }
+
+    const auto slice = std::min<int64_t>(remaining, nysys::detail::kFrequencySampleIntervalMs);
+    if (WaitForSingleObject(context.stopEvent.get(), static_cast<DWORD>(slice)) == WAIT_OBJECT_0 ||
+        std::chrono::steady_clock::now() >= deadline) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(context.dataMutex);
+    if (context.liveInfo.cpuFrequency) {
+      context.liveInfo.cpuFrequency->Sample();
+    }
+  }
+}
+
+static unsigned __stdcall monitoring_thread(void *) {
+  g_MonitorContext.InitializeSession();
+
+  while (g_MonitorContext.isRunning) {
+    if (WaitForSingleObject(g_MonitorContext.stopEvent.get(), 0) == WAIT_OBJECT_0)
+      break;
+
+    auto batchOptionsResult = ApplyBatchOptions(g_MonitorContext, g_MonitorContext.channelMode);
+    if (batchOptionsResult != nysys::MonitoringError::Success) {
+      g_MonitorContext.SetLastError(batchOptionsResult);
+    }
+
+    nysys::CollectionPlan plan;
+    {
+      std::lock_guard<std::mutex> lock(g_MonitorContext.dataMutex);
+      plan = BuildCollectionPlan(g_MonitorContext.projection);
+    }
+
+    if (g_MonitorContext.isFirstRun || !g_MonitorContext.staticInfo.IsComplete(plan)) {
+      std::lock_guard<std::mutex> lock(g_MonitorContext.dataMutex);
+      auto staticResult = CollectStaticInfo(g_MonitorContext.staticInfo, plan);
+      if (staticResult == nysys::MonitoringError::Success) {
+        g_MonitorContext.isFirstRun = false;
+        g_MonitorContext.inventoryDirty = true;
+      } else {
+        g_MonitorContext.SetLastError(staticResult);
+      }
+    } else if (g_MonitorContext.channelMode) {
+      std::lock_guard<std::mutex> lock(g_MonitorContext.dataMutex);
+      RefreshInventorySafely(g_MonitorContext, plan);
+    }
+
+    nysys::MonitoringError dynamicResult = nysys::MonitoringError::DataCollectionFailed;
+    {
+      std::lock_guard<std::mutex> lock(g_MonitorContext.dataMutex);
+      dynamicResult = CollectDynamicInfo(g_MonitorContext.dynamicInfo, plan);
+    }
+
+    nysys::MonitoringError liveResult = nysys::MonitoringError::DataCollectionFailed;
+    {
+      std::lock_guard<std::mutex> lock(g_MonitorContext.dataMutex);
+      liveResult = CollectLiveInfo(g_MonitorContext.liveInfo, g_MonitorContext.topProcessCount.load(), plan);
+    }
+    if (liveResult != nysys::MonitoringError::Success) {
+      g_MonitorContext.SetLastError(liveResult);
+    }
+
+    if (dynamicResult == nysys::MonitoringError::Success && !g_MonitorContext.isFirstRun) {
+      const auto format = g_MonitorContext.outputFormat.load();
+      const bool channelMode = g_MonitorContext.channelMode;
+      bool jsonGenerated = false;
+      bool inventoryGenerated = false;
+      bool suppressed = false;
+      {
+        std::lock_guard<std::mutex> lock(g_MonitorContext.dataMutex);
+        if (channelMode) {
+          jsonGenerated = GenerateInventorySafely(g_MonitorContext, plan, format, inventoryGenerated) &&
+                          GenerateTelemetrySafely(g_MonitorContext, plan, format, suppressed);
+        } else if (g_MonitorContext.UsesSnapshotTree()) {
+          jsonGenerated = GenerateFromTreeSafely(g_MonitorContext, plan, format, std::nullopt, suppressed);
+        } else if (format == nysys::OutputFormat::Json) {
+          jsonGenerated = GenerateJsonSafely(g_MonitorContext.jsonWriter, MakeJsonConfig(g_MonitorContext),
+                                             g_MonitorContext.staticInfo, g_MonitorContext.dynamicInfo,
+                                             g_MonitorContext.liveInfo);
+        } else {
+          jsonGenerated = GenerateBinarySafely(g_MonitorContext.binaryWriter, ToBinaryFormat(format),
+                                               g_MonitorContext.unitsMode, g_MonitorContext.staticInfo,
+                                               g_MonitorContext.dynamicInfo, g_MonitorContext.liveInfo);
+        }
+      }
+
+      if (inventoryGenerated) {
+        auto callbackResult =
+            format == nysys::OutputFormat::Json
+                ? g_MonitorContext.InvokeInventoryCallbacks(g_MonitorContext.inventoryJsonWriter.GetBuffer())
+                : g_MonitorContext.InvokeInventoryCallbacks(g_MonitorContext.inventoryBinaryWriter.GetBuffer());
+        if (callbackResult != nysys::MonitoringError::Success) {
+          g_MonitorContext.SetLastError(callbackResult);
+        }
+      }
+
+      if (jsonGenerated && !suppressed) {
+        if (format == nysys::OutputFormat::Json) {
+          StoreSample(g_MonitorContext, g_MonitorContext.jsonWriter.GetBuffer());
+        } else {
+          StoreSample(g_MonitorContext, g_MonitorContext.binaryWriter.GetBuffer());
+        }
+        PublishSample(g_MonitorContext, format);
+
+        nysys::MonitoringError callbackResult = nysys::MonitoringError::Success;
+        if (g_MonitorContext.batching) {
+          callbackResult = BatchSample(g_MonitorContext, format, channelMode);
+        } else {
+          callbackResult =
+              format == nysys::OutputFormat::Json
+                  ? DeliverPayload(g_MonitorContext, channelMode, g_MonitorContext.jsonWriter.GetBuffer())
+                  : DeliverPayload(g_MonitorContext, channelMode, g_MonitorContext.binaryWriter.GetBuffer());
+        }
+        if (callbackResult != nysys::MonitoringError::Success) {
+          g_MonitorContext.SetLastError(callbackResult);
+        }
+      } else if (!jsonGenerated) {
+        g_MonitorContext.SetLastError(nysys::MonitoringError::JsonGenerationFailed);
+      }
+    } else if (dynamicResult != nysys::MonitoringError::Success) {
+      g_MonitorContext.SetLastError(dynamicResult);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(g_MonitorContext.dataMutex);
+      g_MonitorContext.dynamicInfo.Reset();
+    }
+
+    auto batchResult = FlushBatchIfDue(g_MonitorContext, g_MonitorContext.channelMode);
+    if (batchResult != nysys::MonitoringError::Success) {
+      g_MonitorContext.SetLastError(batchResult);
+    }
+
+    g_MonitorContext.IncrementCycle();
+
+    WaitForNextCycle(g_MonitorContext, g_MonitorContext.updateInterval.load());
+  }
+
+  auto batchResult = DeliverBatch(g_MonitorContext, g_MonitorContext.channelMode);
+  if (batchResult != nysys::MonitoringError::Success) {
+    g_MonitorContext.SetLastError(batchResult);
+  }
+
+  return 0;
+}
+
+BOOL start_monitoring(int32_t updateIntervalMs) {
+  if (g_MonitorContext.isRunning) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::AlreadyRunning);
+    return FALSE;
+  }
+
+  auto intervalResult = g_MonitorContext.SetUpdateInterval(updateIntervalMs);
+  if (intervalResult != nysys::MonitoringError::Success) {
+    g_MonitorContext.SetLastError(intervalResult);
+    return FALSE;
+  }
+
+  try {
+    g_MonitorContext.isFirstRun = true;
+
+    HANDLE stopEventHandle = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+    if (!stopEventHandle) {
+      g_MonitorContext.SetLastError(nysys::MonitoringError::SystemResourceError);
+      return FALSE;
+    }
+    g_MonitorContext.stopEvent.reset(stopEventHandle);
+
+    g_MonitorContext.Reset();
+
+    HANDLE threadHandle = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, monitoring_thread, nullptr, 0, nullptr));
+    if (!threadHandle) {
+      g_MonitorContext.stopEvent.reset();
+      g_MonitorContext.SetLastError(nysys::MonitoringError::ThreadCreationFailed);
+      return FALSE;
+    }
+    g_MonitorContext.monitorThread.reset(threadHandle);
+
+    g_MonitorContext.isRunning = true;
+    return TRUE;
+  } catch (...) {
+    g_MonitorContext.stopEvent.reset();
+    g_MonitorContext.monitorThread.reset();
+    g_MonitorContext.isRunning = false;
+    g_MonitorContext.SetLastError(nysys::MonitoringError::UnknownError);
+    return FALSE;
+  }
+}
+
+void stop_monitoring(void) {
+  if (!g_MonitorContext.isRunning)
+    return;
+
+  g_MonitorContext.RequestStop();
+
+  if (g_MonitorContext.stopEvent) {
+    SetEvent(g_MonitorContext.stopEvent.get());
+  }
+
+  if (g_MonitorContext.monitorThread) {
+    const DWORD waitResult = WaitForSingleObject(g_MonitorContext.monitorThread.get(), nysys::MAX_THREAD_WAIT_MS);
+
+    if (waitResult == WAIT_TIMEOUT) {
+      TerminateThread(g_MonitorContext.monitorThread.get(), 1);
+      g_MonitorContext.SetLastError(nysys::MonitoringError::ThreadTerminationFailed);
+    } else if (waitResult == WAIT_FAILED) {
+      g_MonitorContext.SetLastError(nysys::MonitoringError::SystemResourceError);
+    }
+  }
+
+  g_MonitorContext.isRunning = false;
+
+  g_MonitorContext.Reset();
+  g_MonitorContext.monitorThread.reset();
+  g_MonitorContext.stopEvent.reset();
+
+  {
+    std::lock_guard<std::mutex> lock(g_MonitorContext.callbackMutex);
+    g_MonitorContext.cDataCallback = nullptr;
+    g_MonitorContext.cDataUserData = nullptr;
+    g_MonitorContext.cppDataCallback = nullptr;
+    g_MonitorContext.cCallback = nullptr;
+    g_MonitorContext.cppCallback = nullptr;
+    g_MonitorContext.cBinaryCallback = nullptr;
+    g_MonitorContext.cppBinaryCallback = nullptr;
+    g_MonitorContext.cInventoryCallback = nullptr;
+    g_MonitorContext.cInventoryUserData = nullptr;
+    g_MonitorContext.cppInventoryCallback = nullptr;
+    g_MonitorContext.cTelemetryCallback = nullptr;
+    g_MonitorContext.cTelemetryUserData = nullptr;
+    g_MonitorContext.cppTelemetryCallback = nullptr;
+    g_MonitorContext.cAlertCallback = nullptr;
+    g_MonitorContext.cAlertUserData = nullptr;
+    g_MonitorContext.cppAlertCallback = nullptr;
+  }
+}
+
+void set_update_interval(int32_t updateIntervalMs) {
+  auto result = g_MonitorContext.SetUpdateInterval(updateIntervalMs);
+  if (result != nysys::MonitoringError::Success) {
+    g_MonitorContext.SetLastError(result);
+  }
+}
+
+void set_callback(NysysCallback callback) {
+  std::lock_guard<std::mutex> lock(g_MonitorContext.callbackMutex);
+  g_MonitorContext.cCallback = callback;
+
+  if (callback != nullptr) {
+    auto lastError = g_MonitorContext.GetLastError();
+    if (lastError == nysys::MonitoringError::CallbackFailed) {
+      g_MonitorContext.SetLastError(nysys::MonitoringError::Success);
+    }
+  }
+}
+
+void set_data_callback(NysysDataCallback callback, void *userData) {
+  std::lock_guard<std::mutex> lock(g_MonitorContext.callbackMutex);
+  g_MonitorContext.cDataCallback = callback;
+  g_MonitorContext.cDataUserData = callback ? userData : nullptr;
+
+  if (callback != nullptr) {
+    auto lastError = g_MonitorContext.GetLastError();
+    if (lastError == nysys::MonitoringError::CallbackFailed) {
+      g_MonitorContext.SetLastError(nysys::MonitoringError::Success);
+    }
+  }
+}
+
+void set_top_process_count(int32_t count) {
+  auto result = g_MonitorContext.SetTopProcessCount(count);
+  if (result != nysys::MonitoringError::Success) {
+    g_MonitorContext.SetLastError(result);
+  }
+}
+
+void set_output_format(int32_t format) {
+  auto result = g_MonitorContext.SetOutputFormat(format);
+  if (result != nysys::MonitoringError::Success) {
+    g_MonitorContext.SetLastError(result);
+  }
+}
+
+void set_binary_callback(NysysBinaryCallback callback) {
+  std::lock_guard<std::mutex> lock(g_MonitorContext.callbackMutex);
+  g_MonitorContext.cBinaryCallback = callback;
+
+  if (callback != nullptr) {
+    auto lastError = g_MonitorContext.GetLastError();
+    if (lastError == nysys::MonitoringError::CallbackFailed) {
+      g_MonitorContext.SetLastError(nysys::MonitoringError::Success);
+    }
+  }
+}
+
+void set_delta_mode(BOOL enabled, int32_t keyframeInterval) {
+  auto result = g_MonitorContext.SetDeltaMode(enabled != FALSE, keyframeInterval);
+  if (result != nysys::MonitoringError::Success) {
+    g_MonitorContext.SetLastError(result);
+  }
+}
+
+void request_keyframe(void) { g_MonitorContext.keyframeRequested = true; }
+
+BOOL add_deadband_rule(const char *path, int32_t mode, double threshold) {
+  if (!path) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return FALSE;
+  }
+  return g_MonitorContext.AddDeadbandRule(path, mode, threshold) == filter::DeadbandError::Success ? TRUE : FALSE;
+}
+
+void clear_deadband_rules(void) { g_MonitorContext.ClearDeadbandRules(); }
+
+void set_max_silence(int32_t maxSilenceMs) {
+  auto result = g_MonitorContext.SetMaxSilence(maxSilenceMs);
+  if (result != nysys::MonitoringError::Success) {
+    g_MonitorContext.SetLastError(result);
+  }
+}
+
+void get_filter_stats(uint64_t *emitted, uint64_t *suppressed, uint64_t *heartbeats) {
+  const auto stats = g_MonitorContext.GetFilterStats();
+  if (emitted) {
+    *emitted = stats.emittedCount;
+  }
+  if (suppressed) {
+    *suppressed = stats.suppressedCount;
+  }
+  if (heartbeats) {
+    *heartbeats = stats.heartbeatCount;
+  }
+}
+
+BOOL set_projection(const char *const *paths, int32_t count) {
+  if (!paths || count <= 0) {
+    g_MonitorContext.ClearProjection();
+    return TRUE;
+  }
+
+  try {
+    std::vector<std::string> projectionPaths;
+    projectionPaths.reserve(static_cast<size_t>(count));
+    for (int32_t i = 0; i < count; ++i) {
+      if (!paths[i]) {
+        g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+        return FALSE;
+      }
+      projectionPaths.emplace_back(paths[i]);
+    }
+    return g_MonitorContext.SetProjection(projectionPaths) == filter::ProjectionError::Success ? TRUE : FALSE;
+  } catch (...) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::UnknownError);
+    return FALSE;
+  }
+}
+
+void set_units_mode(int32_t mode) {
+  auto result = g_MonitorContext.SetUnitsMode(mode);
+  if (result != nysys::MonitoringError::Success) {
+    g_MonitorContext.SetLastError(result);
+  }
+}
+
+void set_channel_mode(BOOL enabled, int32_t inventoryRefreshInterval) {
+  auto result = g_MonitorContext.SetChannelMode(enabled != FALSE, inventoryRefreshInterval);
+  if (result != nysys::MonitoringError::Success) {
+    g_MonitorContext.SetLastError(result);
+  }
+}
+
+void set_inventory_callback(NysysDataCallback callback, void *userData) {
+  std::lock_guard<std::mutex> lock(g_MonitorContext.callbackMutex);
+  g_MonitorContext.cInventoryCallback = callback;
+  g_MonitorContext.cInventoryUserData = callback ? userData : nullptr;
+}
+
+void set_telemetry_callback(NysysDataCallback callback, void *userData) {
+  std::lock_guard<std::mutex> lock(g_MonitorContext.callbackMutex);
+  g_MonitorContext.cTelemetryCallback = callback;
+  g_MonitorContext.cTelemetryUserData = callback ? userData : nullptr;
+}
+
+uint64_t get_inventory_hash(void) { return g_MonitorContext.inventoryHash; }
+
+void set_batching(BOOL enabled, int32_t framing, int32_t maxSamples, int32_t maxBytes, int32_t maxAgeMs) {
+  if (maxSamples < 0 || maxBytes < 0 || maxAgeMs < 0) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return;
+  }
+
+  nysys::BatchOptions options;
+  options.framing = static_cast<nysys::BatchFraming>(framing);
+  options.maxSamples = static_cast<size_t>(maxSamples);
+  options.maxBytes = static_cast<size_t>(maxBytes);
+  options.maxAge = std::chrono::milliseconds{maxAgeMs};
+  auto result = g_MonitorContext.SetBatching(enabled != FALSE, options);
+  if (result != nysys::MonitoringError::Success) {
+    g_MonitorContext.SetLastError(result);
+  }
+}
+
+BOOL add_history_metric(const char *path) {
+  if (!path) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return FALSE;
+  }
+  return g_MonitorContext.AddHistoryMetric(path) == history::HistoryError::Success ? TRUE : FALSE;
+}
+
+void clear_history_metrics(void) { g_MonitorContext.ClearHistoryMetrics(); }
+
+BOOL set_history_capacity(int32_t raw, int32_t seconds, int32_t minutes, int32_t hours) {
+  if (raw <= 0 || seconds <= 0 || minutes <= 0 || hours <= 0) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return FALSE;
+  }
+  const nysys::HistoryCapacity capacity{static_cast<size_t>(raw), static_cast<size_t>(seconds),
+                                        static_cast<size_t>(minutes), static_cast<size_t>(hours)};
+  return g_MonitorContext.SetHistoryCapacity(capacity) == history::HistoryError::Success ? TRUE : FALSE;
+}
+
+int32_t query_history(const char *metric, int64_t fromMs, int64_t toMs, int32_t resolution,
+                      NysysHistoryPoint *points, int32_t capacity) {
+  if (!metric || capacity < 0 || (capacity > 0 && !points)) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return -1;
+  }
+
+  try {
+    std::vector<history::Point> result;
+    if (g_MonitorContext.QueryHistory(metric, fromMs, toMs, resolution, result) != history::HistoryError::Success) {
+      return -1;
+    }
+
+    const size_t count = std::min(result.size(), static_cast<size_t>(capacity));
+    for (size_t i = 0; i < count; ++i) {
+      const auto &point = result[i];
+      points[i] = NysysHistoryPoint{point.timestamp, point.min, point.max, point.avg, point.last, point.count};
+    }
+    return static_cast<int32_t>(std::min<size_t>(result.size(), INT32_MAX));
+  } catch (...) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::UnknownError);
+    return -1;
+  }
+}
+
+size_t get_history_memory_usage(void) { return g_MonitorContext.GetHistoryMemoryUsage(); }
+
+BOOL add_percentile_metric(const char *path) {
+  if (!path) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return FALSE;
+  }
+  return g_MonitorContext.AddPercentileMetric(path) == history::SketchError::Success ? TRUE : FALSE;
+}
+
+void clear_percentile_metrics(void) { g_MonitorContext.ClearPercentileMetrics(); }
+
+BOOL set_percentile_window(int32_t windowMs, int32_t slices) {
+  if (slices <= 0) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return FALSE;
+  }
+  return g_MonitorContext.SetPercentileWindow(windowMs, static_cast<size_t>(slices)) == history::SketchError::Success
+             ? TRUE
+             : FALSE;
+}
+
+BOOL query_percentiles(const char *metric, int32_t window, NysysPercentiles *result) {
+  if (!metric || !result) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return FALSE;
+  }
+
+  history::SketchSummary summary;
+  if (g_MonitorContext.QueryPercentiles(metric, window, summary) != history::SketchError::Success) {
+    return FALSE;
+  }
+  *result = NysysPercentiles{summary.windowStart, summary.count, summary.min, summary.max,
+                             summary.mean,        summary.p50,   summary.p95, summary.p99};
+  return TRUE;
+}
+
+void reset_percentiles(void) { g_MonitorContext.ResetPercentiles(); }
+
+BOOL add_alert_rule(const char *name, const char *path, int32_t condition, double threshold, double hysteresis,
+                    int32_t durationMs) {
+  if (!name || !path || condition < static_cast<int32_t>(nysys::AlertCondition::Above) ||
+      condition > static_cast<int32_t>(nysys::AlertCondition::RateBelow) || durationMs < 0) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return FALSE;
+  }
+
+  try {
+    nysys::AlertRule rule;
+    rule.name = name;
+    rule.path = path;
+    rule.condition = static_cast<nysys::AlertCondition>(condition);
+    rule.threshold = threshold;
+    rule.hysteresis = hysteresis;
+    rule.duration = std::chrono::milliseconds{durationMs};
+    return g_MonitorContext.AddAlertRule(rule) == alert::AlertError::Success ? TRUE : FALSE;
+  } catch (...) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::UnknownError);
+    return FALSE;
+  }
+}
+
+void clear_alert_rules(void) { g_MonitorContext.ClearAlertRules(); }
+
+BOOL add_derived_metric(const char *name, const char *expression) {
+  if (!name || !expression) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return FALSE;
+  }
+  return g_MonitorContext.AddDerivedMetric(name, expression) == expr::ExpressionError::Success ? TRUE : FALSE;
+}
 
-  g_MonitorContext.RequestStop();
+void clear_derived_metrics(void) { g_MonitorContext.ClearDerivedMetrics(); }
 
-  if (g_MonitorContext.stopEvent) {
-    SetEvent(g_MonitorContext.stopEvent.get());
+void set_alert_callback(NysysAlertCallback callback, void *userData) {
+  std::lock_guard<std::mutex> lock(g_MonitorContext.callbackMutex);
+  g_MonitorContext.cAlertCallback = callback;
+  g_MonitorContext.cAlertUserData = callback ? userData : nullptr;
+}
+
+void get_alert_stats(uint64_t *evaluations, uint64_t *lastEvaluationNs, uint64_t *maxEvaluationNs,
+                     uint64_t *averageEvaluationNs) {
+  const auto stats = g_MonitorContext.GetAlertStats();
+  if (evaluations) {
+    *evaluations = stats.evaluations;
+  }
+  if (lastEvaluationNs) {
+    *lastEvaluationNs = static_cast<uint64_t>(stats.lastEvaluation.count());
   }
+  if (maxEvaluationNs) {
+    *maxEvaluationNs = static_cast<uint64_t>(stats.maxEvaluation.count());
+  }
+  if (averageEvaluationNs) {
+    *averageEvaluationNs = static_cast<uint64_t>(stats.averageEvaluation.count());
+  }
+}
 
-  if (g_MonitorContext.monitorThread) {
-    const DWORD waitResult = WaitForSingleObject(g_MonitorContext.monitorThread.get(), nysys::MAX_THREAD_WAIT_MS);
+BOOL open_segment_store(const char *directory, int32_t segmentSizeKb, int32_t retentionMb, int32_t flushIntervalMs) {
+  if (!directory || segmentSizeKb <= 0 || retentionMb <= 0 || flushIntervalMs < 0) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return FALSE;
+  }
 
-    if (waitResult == WAIT_TIMEOUT) {
-      TerminateThread(g_MonitorContext.monitorThread.get(), 1);
-      g_MonitorContext.SetLastError(nysys::MonitoringError::ThreadTerminationFailed);
-    } else if (waitResult == WAIT_FAILED) {
-      g_MonitorContext.SetLastError(nysys::MonitoringError::SystemResourceError);
+  try {
+    nysys::SegmentStoreOptions options;
+    options.segmentSize = static_cast<size_t>(segmentSizeKb) * 1024;
+    options.retentionBytes = static_cast<uint64_t>(retentionMb) * 1024 * 1024;
+    options.flushInterval = std::chrono::milliseconds{flushIntervalMs};
+    const auto result = OpenSegmentStore(g_MonitorContext, std::filesystem::u8path(directory), options);
+    if (result != storage::StoreError::Success) {
+      g_MonitorContext.SetLastError(result == storage::StoreError::InvalidOptions
+                                        ? nysys::MonitoringError::InvalidParameter
+                                        : nysys::MonitoringError::SystemResourceError);
+      return FALSE;
     }
+    return TRUE;
+  } catch (...) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::UnknownError);
+    return FALSE;
   }
+}
 
-  g_MonitorContext.isRunning = false;
+void close_segment_store(void) { CloseSegmentStore(g_MonitorContext); }
 
-  g_MonitorContext.Reset();
-  g_MonitorContext.monitorThread.reset();
-  g_MonitorContext.stopEvent.reset();
+int32_t read_segment_store(uint64_t fromSequence, int32_t maxRecords, NysysRecordCallback callback, void *userData) {
+  if (!callback || maxRecords < 0) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return -1;
+  }
 
-  {
-    std::lock_guard<std::mutex> lock(g_MonitorContext.callbackMutex);
-    g_MonitorContext.cCallback = nullptr;
-    g_MonitorContext.cppCallback = nullptr;
+  try {
+    const size_t visited = g_MonitorContext.segmentStore.Read(
+        fromSequence, static_cast<size_t>(maxRecords), [callback, userData](const storage::RecordView &record) {
+          return callback(record.data, record.size, record.sequence, record.timestamp, userData) != FALSE;
+        });
+    return static_cast<int32_t>(visited);
+  } catch (...) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::CallbackExecutionFailed);
+    return -1;
   }
 }
 
-void set_update_interval(int32_t updateIntervalMs) {
-  auto result = g_MonitorContext.SetUpdateInterval(updateIntervalMs);
-  if (result != nysys::MonitoringError::Success) {
-    g_MonitorContext.SetLastError(result);
+void get_segment_store_stats(uint64_t *firstSequence, uint64_t *nextSequence, uint64_t *recovered, uint64_t *dropped) {
+  const auto stats = GetSegmentStoreStats(g_MonitorContext);
+  if (firstSequence) {
+    *firstSequence = stats.firstSequence;
+  }
+  if (nextSequence) {
+    *nextSequence = stats.nextSequence;
+  }
+  if (recovered) {
+    *recovered = stats.recoveredCount;
+  }
+  if (dropped) {
+    *dropped = stats.droppedCount;
   }
 }
 
-void set_callback(NysysCallback callback) {
-  std::lock_guard<std::mutex> lock(g_MonitorContext.callbackMutex);
-  g_MonitorContext.cCallback = callback;
+BOOL start_http_server(int32_t port, int32_t maxClients) {
+  if (port < 0 || port > 65535 || maxClients <= 0) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return FALSE;
+  }
 
-  if (callback != nullptr) {
-    auto lastError = g_MonitorContext.GetLastError();
-    if (lastError == nysys::MonitoringError::CallbackFailed) {
-      g_MonitorContext.SetLastError(nysys::MonitoringError::Success);
+  nysys::HttpServerOptions options;
+  options.port = static_cast<uint16_t>(port);
+  options.maxClients = static_cast<size_t>(maxClients);
+  const auto result = StartHttpServer(g_MonitorContext, options);
+  if (result != net::ServerError::Success) {
+    g_MonitorContext.SetLastError(result == net::ServerError::InvalidOptions
+                                      ? nysys::MonitoringError::InvalidParameter
+                                      : nysys::MonitoringError::SystemResourceError);
+    return FALSE;
+  }
+  return TRUE;
+}
+
+void stop_http_server(void) { StopHttpServer(g_MonitorContext); }
+
+void get_http_server_stats(int32_t *port, int32_t *clients, int32_t *streams, uint64_t *requests, uint64_t *rejected,
+                           uint64_t *dropped) {
+  const auto stats = GetHttpServerStats(g_MonitorContext);
+  if (port) {
+    *port = stats.port;
+  }
+  if (clients) {
+    *clients = static_cast<int32_t>(stats.clientCount);
+  }
+  if (streams) {
+    *streams = static_cast<int32_t>(stats.streamCount);
+  }
+  if (requests) {
+    *requests = stats.requestCount;
+  }
+  if (rejected) {
+    *rejected = stats.rejectedCount;
+  }
+  if (dropped) {
+    *dropped = stats.droppedCount;
+  }
+}
+
+BOOL open_shared_snapshot(const char *name, int32_t capacityKb) {
+  if (capacityKb <= 0) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return FALSE;
+  }
+
+  try {
+    const std::string regionName = name ? name : std::string(nysys::detail::kDefaultSharedSnapshotName);
+    const auto result = OpenSharedSnapshot(g_MonitorContext, regionName, static_cast<size_t>(capacityKb) * 1024);
+    if (result != shm::SharedError::Success) {
+      g_MonitorContext.SetLastError(result == shm::SharedError::InvalidName || result == shm::SharedError::InvalidOptions
+                                        ? nysys::MonitoringError::InvalidParameter
+                                        : nysys::MonitoringError::SystemResourceError);
+      return FALSE;
+    }
+    return TRUE;
+  } catch (...) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::UnknownError);
+    return FALSE;
+  }
+}
+
+void close_shared_snapshot(void) { CloseSharedSnapshot(g_MonitorContext); }
+
+void get_shared_snapshot_stats(uint64_t *version, uint64_t *dropped) {
+  const auto stats = GetSharedSnapshotStats(g_MonitorContext);
+  if (version) {
+    *version = stats.version;
+  }
+  if (dropped) {
+    *dropped = stats.droppedCount;
+  }
+}
+
+BOOL start_pipe_server(const char *name, int32_t maxClients) {
+  if (maxClients <= 0) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return FALSE;
+  }
+
+  try {
+    nysys::PipeServerOptions options;
+    options.name = name ? name : std::string(nysys::detail::kDefaultPipeName);
+    options.maxClients = static_cast<size_t>(maxClients);
+    const auto result = StartPipeServer(g_MonitorContext, options);
+    if (result != net::PipeError::Success) {
+      g_MonitorContext.SetLastError(result == net::PipeError::InvalidName || result == net::PipeError::InvalidOptions
+                                        ? nysys::MonitoringError::InvalidParameter
+                                        : nysys::MonitoringError::SystemResourceError);
+      return FALSE;
+    }
+    return TRUE;
+  } catch (...) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::UnknownError);
+    return FALSE;
+  }
+}
+
+void stop_pipe_server(void) { StopPipeServer(g_MonitorContext); }
+
+void get_pipe_server_stats(int32_t *clients, int32_t *filters, uint64_t *sent, uint64_t *skipped) {
+  const auto stats = GetPipeServerStats(g_MonitorContext);
+  if (clients) {
+    *clients = static_cast<int32_t>(stats.clientCount);
+  }
+  if (filters) {
+    *filters = static_cast<int32_t>(stats.filterCount);
+  }
+  if (sent) {
+    *sent = stats.sentCount;
+  }
+  if (skipped) {
+    *skipped = stats.skippedCount;
+  }
+}
+
+BOOL start_uploader(const char *url, const char *spoolDirectory, int32_t spoolMb, int32_t batchRecords,
+                    int32_t batchIntervalMs, int32_t maxBytesPerSecond) {
+  if (!url || !spoolDirectory || spoolMb <= 0 || batchRecords <= 0 || batchIntervalMs < 0 || maxBytesPerSecond < 0) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::InvalidParameter);
+    return FALSE;
+  }
+
+  try {
+    nysys::UploaderOptions options;
+    options.spoolBytes = static_cast<uint64_t>(spoolMb) * 1024 * 1024;
+    options.batchRecords = static_cast<size_t>(batchRecords);
+    options.batchInterval = std::chrono::milliseconds{batchIntervalMs};
+    options.maxBytesPerSecond = static_cast<uint64_t>(maxBytesPerSecond);
+    const auto result = StartUploader(g_MonitorContext, url, std::filesystem::u8path(spoolDirectory), options);
+    if (result != upload::UploadError::Success) {
+      g_MonitorContext.SetLastError(result == upload::UploadError::InvalidUrl ||
+                                            result == upload::UploadError::InvalidPath ||
+                                            result == upload::UploadError::InvalidOptions
+                                        ? nysys::MonitoringError::InvalidParameter
+                                        : nysys::MonitoringError::SystemResourceError);
+      return FALSE;
     }
+    return TRUE;
+  } catch (...) {
+    g_MonitorContext.SetLastError(nysys::MonitoringError::UnknownError);
+    return FALSE;
+  }
+}
+
+void stop_uploader(void) { StopUploader(g_MonitorContext); }
+
+void get_uploader_stats(uint64_t *pending, uint64_t *uploaded, uint64_t *retries, uint64_t *dropped,
+                        int32_t *lastStatus) {
+  const auto stats = GetUploaderStats(g_MonitorContext);
+  if (pending) {
+    *pending = stats.pendingCount;
+  }
+  if (uploaded) {
+    *uploaded = stats.uploadedCount;
+  }
+  if (retries) {
+    *retries = stats.retryCount;
+  }
+  if (dropped) {
+    *dropped = stats.droppedCount;
+  }
+  if (lastStatus) {
+    *lastStatus = stats.lastStatus;
   }
 }
 
@@ -450,6 +2466,299 @@ void SetCallback(const std::function<void(const std::string &)> &callback) {
   }
 }
 
+void SetTopProcessCount(size_t count) {
+  const auto clamped = static_cast<int64_t>(std::min<size_t>(count, INT64_MAX));
+  auto result = g_MonitorContext.SetTopProcessCount(clamped);
+  if (result != MonitoringError::Success) {
+    throw MonitoringException(result, "Invalid top process count: " + std::to_string(count));
+  }
+}
+
+void SetOutputFormat(OutputFormat format) {
+  auto result = g_MonitorContext.SetOutputFormat(static_cast<int32_t>(format));
+  if (result != MonitoringError::Success) {
+    throw MonitoringException(result, "Invalid output format: " + std::to_string(static_cast<int32_t>(format)));
+  }
+}
+
+void SetDataCallback(const std::function<void(std::string_view, uint64_t)> &callback) {
+  std::lock_guard<std::mutex> lock(g_MonitorContext.callbackMutex);
+  g_MonitorContext.cppDataCallback = callback;
+
+  if (callback) {
+    auto lastError = g_MonitorContext.GetLastError();
+    if (lastError == MonitoringError::CallbackFailed) {
+      g_MonitorContext.SetLastError(MonitoringError::Success);
+    }
+  }
+}
+
+void SetBinaryCallback(const std::function<void(const uint8_t *, size_t)> &callback) {
+  std::lock_guard<std::mutex> lock(g_MonitorContext.callbackMutex);
+  g_MonitorContext.cppBinaryCallback = nullptr;
+  if (callback) {
+    g_MonitorContext.cppBinaryCallback = [callback](std::string_view data, uint64_t) {
+      callback(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+    };
+  }
+
+  if (callback) {
+    auto lastError = g_MonitorContext.GetLastError();
+    if (lastError == MonitoringError::CallbackFailed) {
+      g_MonitorContext.SetLastError(MonitoringError::Success);
+    }
+  }
+}
+
+void SetDeltaMode(bool enabled, int32_t keyframeInterval) {
+  auto result = g_MonitorContext.SetDeltaMode(enabled, keyframeInterval);
+  if (result != MonitoringError::Success) {
+    throw MonitoringException(result, "Invalid keyframe interval: " + std::to_string(keyframeInterval));
+  }
+}
+
+void RequestKeyframe() noexcept { request_keyframe(); }
+
+void AddDeadbandRule(std::string_view path, DeadbandMode mode, double threshold) {
+  auto result = g_MonitorContext.AddDeadbandRule(path, static_cast<int32_t>(mode), threshold);
+  if (result != filter::DeadbandError::Success) {
+    throw MonitoringException(MonitoringError::InvalidParameter,
+                              std::string(filter::ToString(result)) + ": " + std::string(path));
+  }
+}
+
+void ClearDeadbandRules() noexcept { g_MonitorContext.ClearDeadbandRules(); }
+
+void SetMaxSilence(std::chrono::milliseconds maxSilence) {
+  auto result = g_MonitorContext.SetMaxSilence(maxSilence.count());
+  if (result != MonitoringError::Success) {
+    throw MonitoringException(result, "Invalid max silence: " + std::to_string(maxSilence.count()) + "ms");
+  }
+}
+
+FilterStats GetFilterStats() noexcept { return g_MonitorContext.GetFilterStats(); }
+
+void SetProjection(const std::vector<std::string> &paths) {
+  if (paths.empty()) {
+    g_MonitorContext.ClearProjection();
+    return;
+  }
+
+  auto result = g_MonitorContext.SetProjection(paths);
+  if (result != filter::ProjectionError::Success) {
+    throw MonitoringException(MonitoringError::InvalidParameter, filter::ToString(result));
+  }
+}
+
+void ClearProjection() noexcept { g_MonitorContext.ClearProjection(); }
+
+void SetUnitsMode(UnitsMode mode) {
+  auto result = g_MonitorContext.SetUnitsMode(static_cast<int32_t>(mode));
+  if (result != MonitoringError::Success) {
+    throw MonitoringException(result, "Invalid units mode: " + std::to_string(static_cast<int32_t>(mode)));
+  }
+}
+
+void SetChannelMode(bool enabled, int32_t inventoryRefreshInterval) {
+  auto result = g_MonitorContext.SetChannelMode(enabled, inventoryRefreshInterval);
+  if (result != MonitoringError::Success) {
+    throw MonitoringException(result,
+                              "Invalid inventory refresh interval: " + std::to_string(inventoryRefreshInterval));
+  }
+}
+
+void SetInventoryCallback(const std::function<void(std::string_view, uint64_t)> &callback) {
+  std::lock_guard<std::mutex> lock(g_MonitorContext.callbackMutex);
+  g_MonitorContext.cppInventoryCallback = callback;
+}
+
+void SetTelemetryCallback(const std::function<void(std::string_view, uint64_t)> &callback) {
+  std::lock_guard<std::mutex> lock(g_MonitorContext.callbackMutex);
+  g_MonitorContext.cppTelemetryCallback = callback;
+}
+
+uint64_t GetInventoryHash() noexcept { return g_MonitorContext.inventoryHash; }
+
+void SetBatching(bool enabled, const BatchOptions &options) {
+  auto result = g_MonitorContext.SetBatching(enabled, options);
+  if (result != MonitoringError::Success) {
+    throw MonitoringException(result, "Invalid batch options");
+  }
+}
+
+void AddHistoryMetric(std::string_view path) {
+  auto result = g_MonitorContext.AddHistoryMetric(path);
+  if (result != history::HistoryError::Success) {
+    throw MonitoringException(MonitoringError::InvalidParameter,
+                              std::string(history::ToString(result)) + ": " + std::string(path));
+  }
+}
+
+void ClearHistoryMetrics() noexcept { g_MonitorContext.ClearHistoryMetrics(); }
+
+void SetHistoryCapacity(const HistoryCapacity &capacity) {
+  auto result = g_MonitorContext.SetHistoryCapacity(capacity);
+  if (result != history::HistoryError::Success) {
+    throw MonitoringException(MonitoringError::InvalidParameter, history::ToString(result));
+  }
+}
+
+std::vector<HistoryPoint> QueryHistory(std::string_view metric, int64_t fromMs, int64_t toMs,
+                                       HistoryResolution resolution) {
+  std::vector<history::Point> points;
+  auto result = g_MonitorContext.QueryHistory(metric, fromMs, toMs, static_cast<int32_t>(resolution), points);
+  if (result != history::HistoryError::Success) {
+    throw MonitoringException(MonitoringError::InvalidParameter,
+                              std::string(history::ToString(result)) + ": " + std::string(metric));
+  }
+
+  std::vector<HistoryPoint> series;
+  series.reserve(points.size());
+  for (const auto &point : points) {
+    series.push_back(HistoryPoint{point.timestamp, point.min, point.max, point.avg, point.last, point.count});
+  }
+  return series;
+}
+
+size_t GetHistoryMemoryUsage() noexcept { return g_MonitorContext.GetHistoryMemoryUsage(); }
+
+void AddPercentileMetric(std::string_view path) {
+  auto result = g_MonitorContext.AddPercentileMetric(path);
+  if (result != history::SketchError::Success) {
+    throw MonitoringException(MonitoringError::InvalidParameter,
+                              std::string(history::ToString(result)) + ": " + std::string(path));
+  }
+}
+
+void ClearPercentileMetrics() noexcept { g_MonitorContext.ClearPercentileMetrics(); }
+
+void SetPercentileWindow(std::chrono::milliseconds window, size_t slices) {
+  auto result = g_MonitorContext.SetPercentileWindow(window.count(), slices);
+  if (result != history::SketchError::Success) {
+    throw MonitoringException(MonitoringError::InvalidParameter, history::ToString(result));
+  }
+}
+
+Percentiles QueryPercentiles(std::string_view metric, PercentileWindow window) {
+  history::SketchSummary summary;
+  auto result = g_MonitorContext.QueryPercentiles(metric, static_cast<int32_t>(window), summary);
+  if (result != history::SketchError::Success) {
+    throw MonitoringException(MonitoringError::InvalidParameter,
+                              std::string(history::ToString(result)) + ": " + std::string(metric));
+  }
+  return Percentiles{summary.windowStart, summary.count, summary.min, summary.max,
+                     summary.mean,        summary.p50,   summary.p95, summary.p99};
+}
+
+void ResetPercentiles() noexcept { g_MonitorContext.ResetPercentiles(); }
+
+void AddAlertRule(const AlertRule &rule) {
+  auto result = g_MonitorContext.AddAlertRule(rule);
+  if (result != alert::AlertError::Success) {
+    throw MonitoringException(MonitoringError::InvalidParameter,
+                              std::string(alert::ToString(result)) + ": " + rule.name);
+  }
+}
+
+void ClearAlertRules() noexcept { g_MonitorContext.ClearAlertRules(); }
+
+void SetAlertCallback(const std::function<void(const AlertEvent &)> &callback) {
+  std::lock_guard<std::mutex> lock(g_MonitorContext.callbackMutex);
+  g_MonitorContext.cppAlertCallback = callback;
+}
+
+AlertStats GetAlertStats() noexcept { return g_MonitorContext.GetAlertStats(); }
+
+void AddDerivedMetric(std::string_view name, std::string_view expression) {
+  auto result = g_MonitorContext.AddDerivedMetric(name, expression);
+  if (result != expr::ExpressionError::Success) {
+    throw MonitoringException(MonitoringError::InvalidParameter,
+                              std::string(expr::ToString(result)) + ": " + std::string(expression));
+  }
+}
+
+void ClearDerivedMetrics() noexcept { g_MonitorContext.ClearDerivedMetrics(); }
+
+void OpenSegmentStore(const std::filesystem::path &directory, const SegmentStoreOptions &options) {
+  auto result = ::OpenSegmentStore(g_MonitorContext, directory, options);
+  if (result != storage::StoreError::Success) {
+    throw MonitoringException(result == storage::StoreError::InvalidOptions ? MonitoringError::InvalidParameter
+                                                                            : MonitoringError::SystemResourceError,
+                              std::string(storage::ToString(result)) + ": " + directory.string());
+  }
+}
+
+void CloseSegmentStore() noexcept { ::CloseSegmentStore(g_MonitorContext); }
+
+size_t ReadSegmentStore(uint64_t fromSequence, size_t maxRecords,
+                        const std::function<bool(std::string_view, uint64_t, int64_t)> &visitor) {
+  if (!visitor) {
+    return 0;
+  }
+  return g_MonitorContext.segmentStore.Read(fromSequence, maxRecords, [&visitor](const storage::RecordView &record) {
+    return visitor(std::string_view(reinterpret_cast<const char *>(record.data), record.size), record.sequence,
+                   record.timestamp);
+  });
+}
+
+SegmentStoreStats GetSegmentStoreStats() noexcept { return ::GetSegmentStoreStats(g_MonitorContext); }
+
+void StartHttpServer(const HttpServerOptions &options) {
+  auto result = ::StartHttpServer(g_MonitorContext, options);
+  if (result != net::ServerError::Success) {
+    throw MonitoringException(result == net::ServerError::InvalidOptions ? MonitoringError::InvalidParameter
+                                                                         : MonitoringError::SystemResourceError,
+                              std::string(net::ToString(result)) + ": port " + std::to_string(options.port));
+  }
+}
+
+void StopHttpServer() noexcept { ::StopHttpServer(g_MonitorContext); }
+
+HttpServerStats GetHttpServerStats() noexcept { return ::GetHttpServerStats(g_MonitorContext); }
+
+void OpenSharedSnapshot(std::string_view name, size_t capacity) {
+  auto result = ::OpenSharedSnapshot(g_MonitorContext, std::string(name), capacity);
+  if (result != shm::SharedError::Success) {
+    throw MonitoringException(result == shm::SharedError::InvalidName || result == shm::SharedError::InvalidOptions
+                                  ? MonitoringError::InvalidParameter
+                                  : MonitoringError::SystemResourceError,
+                              std::string(shm::ToString(result)) + ": " + std::string(name));
+  }
+}
+
+void CloseSharedSnapshot() noexcept { ::CloseSharedSnapshot(g_MonitorContext); }
+
+SharedSnapshotStats GetSharedSnapshotStats() noexcept { return ::GetSharedSnapshotStats(g_MonitorContext); }
+
+void StartPipeServer(const PipeServerOptions &options) {
+  auto result = ::StartPipeServer(g_MonitorContext, options);
+  if (result != net::PipeError::Success) {
+    throw MonitoringException(result == net::PipeError::InvalidName || result == net::PipeError::InvalidOptions
+                                  ? MonitoringError::InvalidParameter
+                                  : MonitoringError::SystemResourceError,
+                              std::string(net::ToString(result)) + ": " + options.name);
+  }
+}
+
+void StopPipeServer() noexcept { ::StopPipeServer(g_MonitorContext); }
+
+PipeServerStats GetPipeServerStats() noexcept { return ::GetPipeServerStats(g_MonitorContext); }
+
+void StartUploader(std::string_view url, const std::filesystem::path &spoolDirectory, const UploaderOptions &options) {
+  auto result = ::StartUploader(g_MonitorContext, url, spoolDirectory, options);
+  if (result != upload::UploadError::Success) {
+    throw MonitoringException(result == upload::UploadError::InvalidUrl || result == upload::UploadError::InvalidPath ||
+                                      result == upload::UploadError::InvalidOptions
+                                  ? MonitoringError::InvalidParameter
+                                  : MonitoringError::SystemResourceError,
+                              std::string(upload::ToString(result)) + ": " + std::string(url));
+  }
+}
+
+void StopUploader() noexcept { ::StopUploader(g_MonitorContext); }
+
+UploaderStats GetUploaderStats() noexcept { return ::GetUploaderStats(g_MonitorContext); }
+
 bool IsMonitoring() noexcept { return g_MonitorContext.isRunning; }
 
 MonitoringError GetLastError() noexcept { return g_MonitorContext.GetLastError(); }
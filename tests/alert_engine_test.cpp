@@ -0,0 +1,152 @@
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "helper/alert_engine.hpp"
+#include "helper/snapshot_tree.hpp"
+#include "test.hpp"
+
+namespace {
+
+// A snapshot holding /memory/usage_percent, or an empty memory section when value is not set.
+void BuildSnapshot(json::SnapshotTree &tree, std::optional<double> value) {
+  tree.Reset();
+  tree.BeginObject();
+  tree.Key("memory");
+  tree.BeginObject();
+  if (value) {
+    tree.Field("usage_percent", *value);
+  }
+  tree.EndObject();
+  tree.EndObject();
+}
+
+alert::AlertRule MakeRule(alert::AlertCondition condition, double threshold, double hysteresis = 0.0,
+                          int64_t durationMs = 0) {
+  return alert::AlertRule{"memory_high", "/memory/usage_percent", condition, threshold, hysteresis, durationMs};
+}
+
+// Feeds one value and returns the events it produced, as +1 for raised and -1 for cleared.
+std::vector<int> Feed(alert::AlertEngine &engine, std::optional<double> value, int64_t timestamp) {
+  json::SnapshotTree tree;
+  BuildSnapshot(tree, value);
+  std::vector<int> states;
+  for (const auto &event : engine.Evaluate(tree, timestamp)) {
+    states.push_back(event.state == alert::AlertState::Raised ? 1 : -1);
+  }
+  return states;
+}
+
+using Events = std::vector<int>;
+
+}  // namespace
+
+TEST_CASE(AlertRejectsInvalidRules) {
+  alert::AlertEngine engine;
+  auto rule = MakeRule(alert::AlertCondition::Above, 90.0);
+  rule.path = "/cpu_usage/cores/*/usage_percent";
+  CHECK(engine.AddRule(rule) == alert::AlertError::InvalidPath);
+  rule.path = "memory";
+  CHECK(engine.AddRule(rule) == alert::AlertError::InvalidPath);
+  CHECK(engine.AddRule(MakeRule(alert::AlertCondition::Above, NAN)) == alert::AlertError::InvalidThreshold);
+  CHECK(engine.AddRule(MakeRule(alert::AlertCondition::Above, 90.0, -1.0)) == alert::AlertError::InvalidThreshold);
+  CHECK(!engine.IsEnabled());
+
+  CHECK(engine.AddRule(MakeRule(alert::AlertCondition::Above, 90.0)) == alert::AlertError::Success);
+  CHECK(engine.AddRule(MakeRule(alert::AlertCondition::Below, 10.0)) == alert::AlertError::DuplicateRule);
+  CHECK(engine.IsEnabled());
+}
+
+TEST_CASE(AlertHysteresisSeparatesRaiseAndClearLevels) {
+  alert::AlertEngine engine;
+  REQUIRE(engine.AddRule(MakeRule(alert::AlertCondition::Above, 90.0, 5.0)) == alert::AlertError::Success);
+
+  CHECK(Feed(engine, 90.0, 0).empty());
+  CHECK(Feed(engine, 91.0, 1000) == Events({1}));
+  CHECK(Feed(engine, 95.0, 2000).empty());
+  CHECK(Feed(engine, 86.0, 3000).empty());
+  CHECK(Feed(engine, 85.0, 4000) == Events({-1}));
+  CHECK(Feed(engine, 89.0, 5000).empty());
+  CHECK(Feed(engine, 90.5, 6000) == Events({1}));
+
+  const auto stats = engine.GetStats();
+  CHECK(stats.ruleCount == 1 && stats.activeCount == 1);
+  CHECK(stats.evaluations == 7 && stats.raisedCount == 2 && stats.clearedCount == 1);
+}
+
+TEST_CASE(AlertBelowConditionMirrorsHysteresis) {
+  alert::AlertEngine engine;
+  REQUIRE(engine.AddRule(MakeRule(alert::AlertCondition::Below, 10.0, 2.0)) == alert::AlertError::Success);
+
+  CHECK(Feed(engine, 10.0, 0).empty());
+  CHECK(Feed(engine, 9.0, 1000) == Events({1}));
+  CHECK(Feed(engine, 11.5, 2000).empty());
+  CHECK(Feed(engine, 12.0, 3000) == Events({-1}));
+}
+
+TEST_CASE(AlertWaitsForTheDurationBeforeRaising) {
+  alert::AlertEngine engine;
+  REQUIRE(engine.AddRule(MakeRule(alert::AlertCondition::Above, 90.0, 0.0, 3000)) == alert::AlertError::Success);
+
+  CHECK(Feed(engine, 95.0, 0).empty());
+  CHECK(Feed(engine, 95.0, 2000).empty());
+
+  // Dipping below the threshold restarts the wait.
+  CHECK(Feed(engine, 80.0, 2500).empty());
+  CHECK(Feed(engine, 95.0, 3000).empty());
+  CHECK(Feed(engine, 95.0, 5999).empty());
+  CHECK(Feed(engine, 95.0, 6000) == Events({1}));
+  CHECK(Feed(engine, 90.0, 7000) == Events({-1}));
+}
+
+TEST_CASE(AlertRateRulesUsePerSecondChange) {
+  alert::AlertEngine engine;
+  REQUIRE(engine.AddRule(MakeRule(alert::AlertCondition::RateAbove, 10.0, 2.0)) == alert::AlertError::Success);
+
+  // The first sample only sets the baseline.
+  CHECK(Feed(engine, 100.0, 0).empty());
+  CHECK(Feed(engine, 105.0, 1000).empty());
+  CHECK(Feed(engine, 115.0, 1500) == Events({1}));
+
+  json::SnapshotTree tree;
+  BuildSnapshot(tree, 127.0);
+  const auto &events = engine.Evaluate(tree, 3000);
+  REQUIRE(events.size() == 1);
+  CHECK(events[0].state == alert::AlertState::Cleared);
+  CHECK(test::Near(events[0].value, 8.0));
+
+  // A timestamp that does not advance gives no rate and leaves the state alone.
+  CHECK(Feed(engine, 1000.0, 3000).empty());
+  CHECK(engine.GetStats().activeCount == 0);
+}
+
+TEST_CASE(AlertClearsWhenTheValueDisappears) {
+  alert::AlertEngine engine;
+  REQUIRE(engine.AddRule(MakeRule(alert::AlertCondition::Above, 90.0, 5.0)) == alert::AlertError::Success);
+  CHECK(Feed(engine, 95.0, 0) == Events({1}));
+
+  json::SnapshotTree tree;
+  BuildSnapshot(tree, std::nullopt);
+  const auto &events = engine.Evaluate(tree, 1000);
+  REQUIRE(events.size() == 1);
+  CHECK(events[0].state == alert::AlertState::Cleared);
+  CHECK(std::isnan(events[0].value));
+  CHECK(engine.GetStats().activeCount == 0);
+
+  CHECK(Feed(engine, std::nullopt, 2000).empty());
+  CHECK(Feed(engine, 95.0, 3000) == Events({1}));
+}
+
+TEST_CASE(AlertRateBaselineRestartsAfterAGap) {
+  alert::AlertEngine engine;
+  REQUIRE(engine.AddRule(MakeRule(alert::AlertCondition::RateAbove, 10.0)) == alert::AlertError::Success);
+
+  CHECK(Feed(engine, 0.0, 0).empty());
+  CHECK(Feed(engine, std::nullopt, 1000).empty());
+
+  // Without the reset, 0 -> 1000 over 2 s would read as a 500/s rate.
+  CHECK(Feed(engine, 1000.0, 2000).empty());
+  CHECK(Feed(engine, 1001.0, 3000).empty());
+}
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fixtures/binary_value.hpp"
+#include "fixtures/json_value.hpp"
+#include "helper/batch_buffer.hpp"
+#include "helper/binary_writer.hpp"
+#include "test.hpp"
+
+namespace {
+
+using std::chrono::milliseconds;
+
+const std::chrono::steady_clock::time_point kStart{milliseconds{1000000}};
+
+std::vector<uint8_t> EncodeSample(json::BinaryFormat format, uint64_t load, size_t padding = 0) {
+  json::BinaryWriter writer;
+  writer.Reset(format);
+  writer.BeginObject();
+  writer.Field("load", load);
+  if (padding > 0) {
+    writer.Field("pad", std::string(padding, 'x'));
+  }
+  writer.EndObject();
+  return writer.GetBuffer();
+}
+
+// One framed record as the batch writes it, parsed into the JSON fixture model.
+fixture::JsonValue Record(uint64_t load, uint64_t sequence, uint64_t timestamp) {
+  fixture::JsonValue value;
+  CHECK(fixture::ParseJson(R"({"data":{"load":)" + std::to_string(load) + R"(},"sequence":)" +
+                               std::to_string(sequence) + R"(,"timestamp":)" + std::to_string(timestamp) + "}",
+                           value));
+  return value;
+}
+
+}  // namespace
+
+TEST_CASE(BatchFramesTextAsJsonArray) {
+  json::BatchBuffer batch;
+  batch.Configure(json::BatchFraming::JsonArray, {});
+  CHECK(!batch.Finish());
+  CHECK(batch.Append(R"({"load":1})", 1, 100, kStart));
+  CHECK(batch.Append(R"({"load":2})", 2, 200, kStart));
+  CHECK(!batch.Append("", 3, 300, kStart));
+  REQUIRE(batch.Finish());
+  CHECK(batch.Finish());
+  CHECK(!batch.Append(R"({"load":3})", 3, 300, kStart));
+
+  CHECK(batch.GetSampleCount() == 2 && !batch.IsBinary());
+  CHECK(batch.GetText() ==
+        R"([{"data":{"load":1},"sequence":1,"timestamp":100},{"data":{"load":2},"sequence":2,"timestamp":200}])");
+  CHECK(batch.GetSize() == batch.GetText().size());
+
+  batch.Clear();
+  CHECK(batch.IsEmpty() && batch.GetSize() == 0);
+  CHECK(batch.Append(R"({"load":3})", 3, 300, kStart));
+  REQUIRE(batch.Finish());
+  CHECK(batch.GetText() == R"([{"data":{"load":3},"sequence":3,"timestamp":300}])");
+}
+
+TEST_CASE(BatchFramesTextAsNdjson) {
+  json::BatchBuffer batch;
+  batch.Configure(json::BatchFraming::Ndjson, {});
+  CHECK(batch.Append(R"({"load":1})", 1, 100, kStart));
+  CHECK(batch.Append(R"({"load":2})", 2, 200, kStart));
+  REQUIRE(batch.Finish());
+  CHECK(batch.GetText() == "{\"data\":{\"load\":1},\"sequence\":1,\"timestamp\":100}\n"
+                           "{\"data\":{\"load\":2},\"sequence\":2,\"timestamp\":200}\n");
+}
+
+TEST_CASE(BatchFramesBinarySamples) {
+  for (const auto format : {json::BinaryFormat::Cbor, json::BinaryFormat::MessagePack}) {
+    json::BatchBuffer batch;
+    batch.Configure(json::BatchFraming::JsonArray, {});
+    CHECK(batch.Append(EncodeSample(format, 1), format, 1, 100, kStart));
+    CHECK(batch.Append(EncodeSample(format, 2), format, 2, 200, kStart));
+    REQUIRE(batch.Finish());
+    CHECK(batch.IsBinary() && batch.GetSize() == batch.GetBytes().size());
+
+    fixture::JsonValue expected;
+    expected.type = fixture::JsonValue::Type::Array;
+    expected.items = {Record(1, 1, 100), Record(2, 2, 200)};
+    fixture::JsonValue decoded;
+    REQUIRE(fixture::DecodeBinary(batch.GetBytes(), format, decoded));
+    CHECK(decoded == expected);
+
+    // Without an enclosing array, each record is a complete top-level value.
+    json::BatchBuffer single;
+    single.Configure(json::BatchFraming::Ndjson, {});
+    CHECK(single.Append(EncodeSample(format, 1), format, 1, 100, kStart));
+    REQUIRE(single.Finish());
+    REQUIRE(fixture::DecodeBinary(single.GetBytes(), format, decoded));
+    CHECK(decoded == Record(1, 1, 100));
+  }
+}
+
+TEST_CASE(BatchRejectsMixedFormats) {
+  json::BatchBuffer batch;
+  batch.Configure(json::BatchFraming::JsonArray, {});
+  const auto cbor = EncodeSample(json::BinaryFormat::Cbor, 1);
+  CHECK(batch.Matches(std::nullopt) && batch.Matches(json::BinaryFormat::Cbor));
+
+  CHECK(batch.Append(R"({"load":1})", 1, 100, kStart));
+  CHECK(!batch.Matches(json::BinaryFormat::Cbor));
+  CHECK(!batch.Append(cbor, json::BinaryFormat::Cbor, 2, 200, kStart));
+  CHECK(batch.GetSampleCount() == 1);
+
+  batch.Clear();
+  CHECK(batch.Append(cbor, json::BinaryFormat::Cbor, 2, 200, kStart));
+  CHECK(!batch.Matches(std::nullopt) && !batch.Matches(json::BinaryFormat::MessagePack));
+  CHECK(!batch.Append(R"({"load":1})", 1, 100, kStart));
+  CHECK(!batch.Append(EncodeSample(json::BinaryFormat::MessagePack, 1), json::BinaryFormat::MessagePack, 3, 300,
+                      kStart));
+  CHECK(batch.GetSampleCount() == 1);
+}
+
+TEST_CASE(BatchFlushesAtEachLimit) {
+  json::BatchBuffer batch;
+  batch.Configure(json::BatchFraming::JsonArray, {3, 0, milliseconds{0}});
+  CHECK(!batch.ShouldFlush(kStart));
+  CHECK(batch.Append(R"({"load":1})", 1, 100, kStart));
+  CHECK(batch.Append(R"({"load":2})", 2, 200, kStart));
+  CHECK(!batch.ShouldFlush(kStart + milliseconds{100000}));
+  CHECK(batch.Append(R"({"load":3})", 3, 300, kStart));
+  CHECK(batch.ShouldFlush(kStart));
+
+  batch.Clear();
+  batch.Configure(json::BatchFraming::JsonArray, {0, 90, milliseconds{0}});
+  CHECK(batch.Append(R"({"load":1})", 1, 100, kStart));
+  CHECK(!batch.ShouldFlush(kStart));
+  CHECK(batch.Append(R"({"load":2})", 2, 200, kStart));
+  CHECK(batch.GetSize() >= 90 && batch.ShouldFlush(kStart));
+
+  // The age counts from the first sample of the batch, not the latest one.
+  batch.Clear();
+  batch.Configure(json::BatchFraming::JsonArray, {0, 0, milliseconds{5000}});
+  CHECK(batch.Append(R"({"load":1})", 1, 100, kStart));
+  CHECK(batch.Append(R"({"load":2})", 2, 200, kStart + milliseconds{4000}));
+  CHECK(!batch.ShouldFlush(kStart + milliseconds{4999}));
+  CHECK(batch.ShouldFlush(kStart + milliseconds{5000}));
+
+  // With no limits set, only the hard byte cap applies.
+  batch.Clear();
+  batch.Configure(json::BatchFraming::Ndjson, {});
+  CHECK(batch.Append(std::string(json::detail::kMaxBatchBytes, '1'), 1, 100, kStart));
+  CHECK(batch.ShouldFlush(kStart));
+}
+
+TEST_CASE(BatchDropsAFailedTextSampleWhole) {
+  json::BatchBuffer batch;
+  batch.Configure(json::BatchFraming::JsonArray, {});
+  REQUIRE(batch.Append(R"({"load":1})", 1, 100, kStart));
+  const std::string before = batch.GetText();
+
+  // Larger than the reserved capacity, so appending it has to allocate, and that allocation fails.
+  const std::string large = R"({"pad":")" + std::string(json::detail::kInitialBatchCapacity, 'x') + R"("})";
+  test::FailAllocation(1);
+  CHECK(!batch.Append(large, 2, 200, kStart));
+  test::FailAllocation(0);
+  CHECK(batch.GetText() == before);
+  CHECK(batch.GetSampleCount() == 1);
+
+  REQUIRE(batch.Append(R"({"load":3})", 3, 300, kStart));
+  REQUIRE(batch.Finish());
+  fixture::JsonValue decoded;
+  REQUIRE(fixture::ParseJson(batch.GetText(), decoded));
+  CHECK(decoded.items.size() == 2 && decoded.items[1] == Record(3, 3, 300));
+}
+
+TEST_CASE(BatchDropsAFailedBinarySampleWhole) {
+  for (const auto format : {json::BinaryFormat::Cbor, json::BinaryFormat::MessagePack}) {
+    json::BatchBuffer batch;
+    batch.Configure(json::BatchFraming::JsonArray, {});
+    REQUIRE(batch.Append(EncodeSample(format, 1), format, 1, 100, kStart));
+    const auto before = batch.GetBytes();
+
+    // The record header and key are written before the oversized payload fails to fit.
+    const auto large = EncodeSample(format, 2, json::detail::kInitialBinaryCapacity);
+    test::FailAllocation(1);
+    CHECK(!batch.Append(large, format, 2, 200, kStart));
+    test::FailAllocation(0);
+    CHECK(batch.GetBytes() == before);
+    CHECK(batch.GetSampleCount() == 1);
+
+    REQUIRE(batch.Append(EncodeSample(format, 3), format, 3, 300, kStart));
+    REQUIRE(batch.Finish());
+    fixture::JsonValue decoded;
+    REQUIRE(fixture::DecodeBinary(batch.GetBytes(), format, decoded));
+    REQUIRE(decoded.items.size() == 2);
+    CHECK(decoded.items[0] == Record(1, 1, 100) && decoded.items[1] == Record(3, 3, 300));
+  }
+}
\ No newline at end of file
@@ -0,0 +1,272 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "fixtures/binary_value.hpp"
+#include "fixtures/json_value.hpp"
+#include "helper/binary_writer.hpp"
+#include "helper/json_writer.hpp"
+#include "helper/snapshot_tree.hpp"
+#include "test.hpp"
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+template <typename T>
+Bytes Encode(json::BinaryFormat format, T value) {
+  json::BinaryWriter writer;
+  writer.Reset(format);
+  writer.Value(value);
+  CHECK(writer.IsValid());
+  return writer.GetBuffer();
+}
+
+// Header bytes only: the first `size` bytes of a string or container encoding.
+Bytes Head(const Bytes &encoded, size_t size) {
+  return Bytes(encoded.begin(), encoded.begin() + static_cast<std::ptrdiff_t>(std::min(size, encoded.size())));
+}
+
+Bytes EncodeString(json::BinaryFormat format, size_t size) { return Encode(format, std::string(size, 'x')); }
+
+Bytes EncodeArray(json::BinaryFormat format, uint32_t count) {
+  json::BinaryWriter writer;
+  writer.Reset(format);
+  writer.BeginArray();
+  for (uint32_t i = 0; i < count; ++i) {
+    writer.Value(uint64_t{1});
+  }
+  writer.EndArray();
+  CHECK(writer.IsValid());
+  return writer.GetBuffer();
+}
+
+Bytes EncodeMap(json::BinaryFormat format, uint32_t count) {
+  json::BinaryWriter writer;
+  writer.Reset(format);
+  writer.BeginObject();
+  for (uint32_t i = 0; i < count; ++i) {
+    writer.Field(std::to_string(i), true);
+  }
+  writer.EndObject();
+  CHECK(writer.IsValid());
+  return writer.GetBuffer();
+}
+
+fixture::JsonValue Decode(const json::BinaryWriter &writer) {
+  fixture::JsonValue value;
+  CHECK(fixture::DecodeBinary(writer.GetBuffer(), writer.GetFormat(), value));
+  return value;
+}
+
+void BuildSnapshot(json::SnapshotTree &tree) {
+  tree.Reset();
+  tree.BeginObject();
+  tree.Key("cpu");
+  tree.BeginObject();
+  tree.Field("load", 0.375);
+  tree.Field("name", "Ryzen \xC3\xA9");
+  tree.Field("offset", int64_t{-300});
+  tree.EndObject();
+  tree.Key("disks");
+  tree.BeginArray();
+  for (uint64_t i = 0; i < 20; ++i) {
+    tree.BeginObject();
+    tree.Field("free", i * 1000000007ULL);
+    tree.Field("mounted", i % 2 == 0);
+    tree.Key("temperature");
+    tree.Null();
+    tree.EndObject();
+  }
+  tree.EndArray();
+  tree.Field("uptime", std::numeric_limits<uint64_t>::max());
+  tree.EndObject();
+}
+
+constexpr json::BinaryFormat kFormats[] = {json::BinaryFormat::Cbor, json::BinaryFormat::MessagePack};
+
+}  // namespace
+
+TEST_CASE(BinaryWriterUsesMinimalCborIntegerHeads) {
+  constexpr auto kCbor = json::BinaryFormat::Cbor;
+  CHECK(Encode(kCbor, uint64_t{0}) == Bytes({0x00}));
+  CHECK(Encode(kCbor, uint64_t{23}) == Bytes({0x17}));
+  CHECK(Encode(kCbor, uint64_t{24}) == Bytes({0x18, 0x18}));
+  CHECK(Encode(kCbor, uint64_t{255}) == Bytes({0x18, 0xFF}));
+  CHECK(Encode(kCbor, uint64_t{256}) == Bytes({0x19, 0x01, 0x00}));
+  CHECK(Encode(kCbor, uint64_t{65536}) == Bytes({0x1A, 0x00, 0x01, 0x00, 0x00}));
+  CHECK(Encode(kCbor, uint64_t{1} << 32) == Bytes({0x1B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00}));
+  CHECK(Encode(kCbor, int64_t{-1}) == Bytes({0x20}));
+  CHECK(Encode(kCbor, int64_t{-24}) == Bytes({0x37}));
+  CHECK(Encode(kCbor, int64_t{-25}) == Bytes({0x38, 0x18}));
+  CHECK(Encode(kCbor, int64_t{-257}) == Bytes({0x39, 0x01, 0x00}));
+  CHECK(Encode(kCbor, std::numeric_limits<int64_t>::min()) ==
+        Bytes({0x3B, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}));
+}
+
+TEST_CASE(BinaryWriterUsesMinimalMessagePackIntegerHeads) {
+  constexpr auto kMsgPack = json::BinaryFormat::MessagePack;
+  CHECK(Encode(kMsgPack, uint64_t{0}) == Bytes({0x00}));
+  CHECK(Encode(kMsgPack, uint64_t{127}) == Bytes({0x7F}));
+  CHECK(Encode(kMsgPack, uint64_t{128}) == Bytes({0xCC, 0x80}));
+  CHECK(Encode(kMsgPack, uint64_t{256}) == Bytes({0xCD, 0x01, 0x00}));
+  CHECK(Encode(kMsgPack, uint64_t{65536}) == Bytes({0xCE, 0x00, 0x01, 0x00, 0x00}));
+  CHECK(Encode(kMsgPack, uint64_t{1} << 32) == Bytes({0xCF, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00}));
+  CHECK(Encode(kMsgPack, int64_t{5}) == Bytes({0x05}));
+  CHECK(Encode(kMsgPack, int64_t{-1}) == Bytes({0xFF}));
+  CHECK(Encode(kMsgPack, int64_t{-32}) == Bytes({0xE0}));
+  CHECK(Encode(kMsgPack, int64_t{-33}) == Bytes({0xD0, 0xDF}));
+  CHECK(Encode(kMsgPack, int64_t{-129}) == Bytes({0xD1, 0xFF, 0x7F}));
+  CHECK(Encode(kMsgPack, int64_t{-32769}) == Bytes({0xD2, 0xFF, 0xFF, 0x7F, 0xFF}));
+  CHECK(Encode(kMsgPack, int64_t{-2147483649}) == Bytes({0xD3, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0xFF, 0xFF, 0xFF}));
+}
+
+TEST_CASE(BinaryWriterUsesMinimalStringHeaders) {
+  constexpr auto kCbor = json::BinaryFormat::Cbor;
+  constexpr auto kMsgPack = json::BinaryFormat::MessagePack;
+  CHECK(Head(EncodeString(kCbor, 23), 1) == Bytes({0x77}));
+  CHECK(Head(EncodeString(kCbor, 24), 2) == Bytes({0x78, 0x18}));
+  CHECK(Head(EncodeString(kCbor, 256), 3) == Bytes({0x79, 0x01, 0x00}));
+  CHECK(Head(EncodeString(kMsgPack, 31), 1) == Bytes({0xBF}));
+  CHECK(Head(EncodeString(kMsgPack, 32), 2) == Bytes({0xD9, 0x20}));
+  CHECK(Head(EncodeString(kMsgPack, 256), 3) == Bytes({0xDA, 0x01, 0x00}));
+  CHECK(Head(EncodeString(kMsgPack, 65536), 5) == Bytes({0xDB, 0x00, 0x01, 0x00, 0x00}));
+  CHECK(EncodeString(kMsgPack, 65536).size() == 5 + 65536);
+}
+
+TEST_CASE(BinaryWriterBackPatchesMinimalContainerHeaders) {
+  constexpr auto kCbor = json::BinaryFormat::Cbor;
+  constexpr auto kMsgPack = json::BinaryFormat::MessagePack;
+
+  // The header reserve is dropped once the count is known: no gap may be left between header and body.
+  CHECK(EncodeArray(kCbor, 0) == Bytes({0x80}));
+  CHECK(EncodeArray(kCbor, 2) == Bytes({0x82, 0x01, 0x01}));
+  CHECK(Head(EncodeArray(kCbor, 23), 1) == Bytes({0x97}));
+  CHECK(Head(EncodeArray(kCbor, 24), 2) == Bytes({0x98, 0x18}));
+  CHECK(EncodeArray(kCbor, 24).size() == 2 + 24);
+  CHECK(Head(EncodeArray(kCbor, 256), 3) == Bytes({0x99, 0x01, 0x00}));
+  CHECK(Head(EncodeMap(kCbor, 23), 1) == Bytes({0xB7}));
+  CHECK(Head(EncodeMap(kCbor, 24), 2) == Bytes({0xB8, 0x18}));
+
+  CHECK(EncodeArray(kMsgPack, 0) == Bytes({0x90}));
+  CHECK(Head(EncodeArray(kMsgPack, 15), 1) == Bytes({0x9F}));
+  CHECK(Head(EncodeArray(kMsgPack, 16), 3) == Bytes({0xDC, 0x00, 0x10}));
+  CHECK(EncodeArray(kMsgPack, 16).size() == 3 + 16);
+  CHECK(Head(EncodeArray(kMsgPack, 65536), 5) == Bytes({0xDD, 0x00, 0x01, 0x00, 0x00}));
+  CHECK(Head(EncodeMap(kMsgPack, 15), 1) == Bytes({0x8F}));
+  CHECK(Head(EncodeMap(kMsgPack, 16), 3) == Bytes({0xDE, 0x00, 0x10}));
+
+  for (const auto format : kFormats) {
+    json::BinaryWriter writer;
+    writer.Reset(format);
+    writer.BeginArray();
+    for (uint32_t i = 0; i < 300; ++i) {
+      writer.BeginObject();
+      writer.Field("i", uint64_t{i});
+      writer.EndObject();
+    }
+    writer.EndArray();
+    REQUIRE(writer.IsValid());
+    const auto value = Decode(writer);
+    REQUIRE(value.items.size() == 300);
+    CHECK(value.items[299].members.size() == 1 && value.items[299].members[0].value.number == 299);
+  }
+}
+
+TEST_CASE(BinaryWriterRestoreDropsAnAbandonedMember) {
+  for (const auto format : kFormats) {
+    json::BinaryWriter writer;
+    writer.Reset(format);
+    writer.BeginObject();
+    writer.Field("kept", uint64_t{1});
+
+    // Abandon a member holding a nested container large enough to need a wide header of its own.
+    const auto checkpoint = writer.Save();
+    writer.Key("dropped");
+    writer.BeginArray();
+    for (uint32_t i = 0; i < 40; ++i) {
+      writer.Value(uint64_t{1000});
+    }
+    writer.Restore(checkpoint);
+
+    writer.Field("last", "x");
+    writer.EndObject();
+    REQUIRE(writer.IsValid());
+
+    const Bytes &buffer = writer.GetBuffer();
+    CHECK(buffer.front() == (format == json::BinaryFormat::Cbor ? 0xA2 : 0x82));
+
+    fixture::JsonValue expected;
+    CHECK(fixture::ParseJson(R"({"kept":1,"last":"x"})", expected));
+    CHECK(Decode(writer) == expected);
+  }
+}
+
+TEST_CASE(BinaryWriterSplicesRawValues) {
+  for (const auto format : kFormats) {
+    json::BinaryWriter inner;
+    inner.Reset(format);
+    inner.BeginObject();
+    inner.Field("model", "RTX");
+    inner.Field("vram", uint64_t{8192});
+    inner.EndObject();
+    REQUIRE(inner.IsValid());
+
+    // A spliced value counts as one member of the enclosing container.
+    json::BinaryWriter writer;
+    writer.Reset(format);
+    writer.BeginObject();
+    writer.Key("gpu");
+    writer.RawValue(inner.GetBuffer().data(), inner.GetBuffer().size());
+    writer.Key("list");
+    writer.BeginArray();
+    writer.RawValue(inner.GetBuffer().data(), inner.GetBuffer().size());
+    writer.Value(true);
+    writer.EndArray();
+    writer.EndObject();
+    REQUIRE(writer.IsValid());
+
+    fixture::JsonValue expected;
+    CHECK(fixture::ParseJson(R"({"gpu":{"model":"RTX","vram":8192},"list":[{"model":"RTX","vram":8192},true]})",
+                             expected));
+    CHECK(Decode(writer) == expected);
+  }
+}
+
+TEST_CASE(BinaryWriterMatchesJsonForTheSameSnapshot) {
+  json::SnapshotTree tree;
+  BuildSnapshot(tree);
+
+  json::JsonWriter jsonWriter;
+  jsonWriter.Reset(false, 0);
+  json::WriteSnapshotTree(jsonWriter, tree);
+  fixture::JsonValue expected;
+  REQUIRE(fixture::ParseJson(jsonWriter.GetOutput(), expected));
+
+  for (const auto format : kFormats) {
+    json::BinaryWriter writer;
+    writer.Reset(format);
+    json::WriteSnapshotTree(writer, tree);
+    REQUIRE(writer.IsValid());
+    CHECK(Decode(writer) == expected);
+    CHECK(writer.GetBuffer().size() < jsonWriter.GetOutput().size());
+  }
+}
+
+TEST_CASE(BinaryWriterWritesNonFiniteAsNullAndRejectsBadUtf8) {
+  constexpr auto kCbor = json::BinaryFormat::Cbor;
+  constexpr auto kMsgPack = json::BinaryFormat::MessagePack;
+  CHECK(Encode(kCbor, std::numeric_limits<double>::quiet_NaN()) == Bytes({0xF6}));
+  CHECK(Encode(kMsgPack, std::numeric_limits<double>::infinity()) == Bytes({0xC0}));
+  CHECK(Encode(kCbor, 1.5) == Bytes({0xFB, 0x3F, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}));
+  CHECK(Encode(kMsgPack, 1.5) == Bytes({0xCB, 0x3F, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}));
+
+  for (const auto format : kFormats) {
+    json::BinaryWriter writer;
+    writer.Reset(format);
+    writer.Value("bad \xC3");
+    CHECK(!writer.IsValid());
+  }
+}
\ No newline at end of file
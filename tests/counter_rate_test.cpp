@@ -0,0 +1,88 @@
+#include <cstdint>
+#include <limits>
+
+#include "helper/counter_rate.hpp"
+#include "test.hpp"
+
+TEST_CASE(CounterRateFirstSampleOnlySetsBaseline) {
+  counter::CounterRate64 rate;
+  CHECK(!rate.HasBaseline());
+
+  CHECK(rate.Update(5000, 1.0) == 0.0);
+  CHECK(rate.HasBaseline());
+  CHECK(rate.GetDelta() == 0);
+  CHECK(!rate.WasReset());
+
+  CHECK(test::Near(rate.Update(7000, 2.0), 1000.0));
+  CHECK(rate.GetDelta() == 2000);
+  CHECK(test::Near(rate.GetRate(), 1000.0));
+}
+
+TEST_CASE(CounterRate32HandlesWrap) {
+  counter::CounterRate32 rate;
+  rate.Update(0xFFFFFF00u, 1.0);
+
+  CHECK(test::Near(rate.Update(0x100u, 2.0), 256.0));
+  CHECK(rate.GetDelta() == 0x200);
+  CHECK(!rate.WasReset());
+}
+
+TEST_CASE(CounterRate32IgnoresUpperBits) {
+  counter::CounterRate32 rate;
+  rate.Update(0x1'0000'0010ULL, 1.0);
+
+  rate.Update(0x7'0000'0030ULL, 1.0);
+  CHECK(rate.GetDelta() == 0x20);
+  CHECK(!rate.WasReset());
+}
+
+TEST_CASE(CounterRate32TreatsLargeDropAsReset) {
+  counter::CounterRate32 rate;
+  rate.Update(1'000'000, 1.0);
+
+  CHECK(test::Near(rate.Update(10, 1.0), 10.0));
+  CHECK(rate.GetDelta() == 10);
+  CHECK(rate.WasReset());
+
+  rate.Update(30, 1.0);
+  CHECK(rate.GetDelta() == 20);
+  CHECK(!rate.WasReset());
+}
+
+TEST_CASE(CounterRate64TreatsWrapAsReset) {
+  counter::CounterRate64 rate;
+  rate.Update(std::numeric_limits<uint64_t>::max() - 10, 1.0);
+
+  CHECK(test::Near(rate.Update(5, 1.0), 5.0));
+  CHECK(rate.GetDelta() == 5);
+  CHECK(rate.WasReset());
+
+  rate.Update(0x1'0000'0005ULL, 1.0);
+  CHECK(rate.GetDelta() == 0x1'0000'0000ULL);
+  CHECK(!rate.WasReset());
+}
+
+TEST_CASE(CounterRateZeroElapsedKeepsDelta) {
+  counter::CounterRate64 rate;
+  rate.Update(100, 1.0);
+
+  CHECK(rate.Update(400, 0.0) == 0.0);
+  CHECK(rate.GetDelta() == 300);
+
+  CHECK(rate.Update(500, -1.0) == 0.0);
+  CHECK(rate.GetDelta() == 100);
+}
+
+TEST_CASE(CounterRateResetDropsBaseline) {
+  counter::CounterRate32 rate;
+  rate.Update(100, 1.0);
+  rate.Update(300, 1.0);
+
+  rate.Reset();
+  CHECK(!rate.HasBaseline());
+  CHECK(rate.GetDelta() == 0);
+  CHECK(rate.GetRate() == 0.0);
+
+  CHECK(rate.Update(50, 1.0) == 0.0);
+  CHECK(rate.HasBaseline());
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include <cstdint>
+
+#include "helper/cpu_time.hpp"
+#include "test.hpp"
+
+namespace {
+
+void SetCore(cputime::CounterColumns &columns, size_t core, uint64_t idle, uint64_t kernel, uint64_t user,
+             uint64_t dpc, uint64_t interrupt) {
+  columns.idle[core] = idle;
+  columns.kernel[core] = kernel;
+  columns.user[core] = user;
+  columns.dpc[core] = dpc;
+  columns.interrupt[core] = interrupt;
+}
+
+}  // namespace
+
+TEST_CASE(CpuTimeSplitsKernelTime) {
+  cputime::CounterColumns previous;
+  cputime::CounterColumns current;
+  cputime::ShareColumns shares;
+  previous.Resize(1);
+  current.Resize(1);
+  shares.Resize(1);
+
+  SetCore(previous, 0, 1000, 2000, 3000, 100, 100);
+  SetCore(current, 0, 1300, 2600, 3400, 150, 150);
+
+  cputime::Breakdown total;
+  cputime::ComputeShares(current, previous, 1, shares, total);
+
+  CHECK(test::Near(shares.usage[0], 70.0, 1e-4));
+  CHECK(test::Near(shares.user[0], 40.0, 1e-4));
+  CHECK(test::Near(shares.system[0], 20.0, 1e-4));
+  CHECK(test::Near(shares.irq[0], 5.0, 1e-4));
+  CHECK(test::Near(shares.dpc[0], 5.0, 1e-4));
+  CHECK(test::Near(shares.idle[0], 30.0, 1e-4));
+  CHECK(test::Near(total.usage, 70.0));
+  CHECK(test::Near(total.system, 20.0));
+  CHECK(test::Near(total.idle, 30.0));
+}
+
+TEST_CASE(CpuTimeIdleCoreAndEmptyDelta) {
+  cputime::CounterColumns previous;
+  cputime::CounterColumns current;
+  cputime::ShareColumns shares;
+  previous.Resize(2);
+  current.Resize(2);
+  shares.Resize(2);
+
+  SetCore(previous, 0, 500, 500, 0, 0, 0);
+  SetCore(current, 0, 1500, 1500, 0, 0, 0);
+  SetCore(previous, 1, 42, 84, 7, 1, 1);
+  SetCore(current, 1, 42, 84, 7, 1, 1);
+
+  cputime::Breakdown total;
+  cputime::ComputeShares(current, previous, 2, shares, total);
+
+  CHECK(shares.usage[0] == 0.0f);
+  CHECK(test::Near(shares.idle[0], 100.0, 1e-4));
+  CHECK(shares.usage[1] == 0.0f);
+  CHECK(shares.idle[1] == 0.0f);
+  CHECK(test::Near(total.idle, 100.0));
+  CHECK(test::Near(total.usage, 0.0));
+}
+
+// Counters sampled a few microseconds apart can report more idle than kernel time; shares clamp at zero.
+TEST_CASE(CpuTimeClampsInconsistentCounters) {
+  cputime::CounterColumns previous;
+  cputime::CounterColumns current;
+  cputime::ShareColumns shares;
+  previous.Resize(1);
+  current.Resize(1);
+  shares.Resize(1);
+
+  SetCore(current, 0, 120, 100, 0, 10, 10);
+
+  cputime::Breakdown total;
+  cputime::ComputeShares(current, previous, 1, shares, total);
+
+  CHECK(shares.usage[0] == 0.0f);
+  CHECK(shares.system[0] == 0.0f);
+  CHECK(total.usage == 0.0);
+  CHECK(total.system == 0.0);
+}
+
+TEST_CASE(CpuTimeTotalsAreWeightedAcrossCores) {
+  constexpr size_t kCores = 512;
+  cputime::CounterColumns previous;
+  cputime::CounterColumns current;
+  cputime::ShareColumns shares;
+  previous.Resize(kCores);
+  current.Resize(kCores);
+  shares.Resize(kCores);
+
+  // Even cores are fully busy in user mode, odd cores fully idle.
+  for (size_t core = 0; core < kCores; ++core) {
+    const bool busy = core % 2 == 0;
+    SetCore(current, core, busy ? 0 : 1000, busy ? 0 : 1000, busy ? 1000 : 0, 0, 0);
+  }
+
+  const size_t allocations = test::AllocationCount();
+  cputime::Breakdown total;
+  cputime::ComputeShares(current, previous, kCores, shares, total);
+  CHECK(test::AllocationCount() == allocations);
+
+  CHECK(test::Near(total.usage, 50.0));
+  CHECK(test::Near(total.user, 50.0));
+  CHECK(test::Near(total.idle, 50.0));
+  CHECK(test::Near(shares.usage[0], 100.0, 1e-4));
+  CHECK(shares.usage[1] == 0.0f);
+  CHECK(test::Near(shares.usage[kCores - 2], 100.0, 1e-4));
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string_view>
+
+#include "helper/deadband_filter.hpp"
+#include "helper/snapshot_tree.hpp"
+#include "test.hpp"
+
+namespace {
+
+using filter::FilterDecision;
+using std::chrono::milliseconds;
+
+struct Sample {
+  double core0 = 10.0;
+  double core1 = 10.0;
+  double total = 10.0;
+  uint64_t memoryUsed = 1000;
+  std::string_view name = "cpu";
+  uint64_t uptime = 1;
+};
+
+// Members are written in sorted key order, the same order the model serializers use.
+void Build(json::SnapshotTree &tree, const Sample &sample) {
+  tree.Reset();
+  tree.BeginObject();
+  tree.Key("cpu_usage");
+  tree.BeginObject();
+  tree.Key("cores");
+  tree.BeginArray();
+  for (const double usage : {sample.core0, sample.core1}) {
+    tree.BeginObject();
+    tree.Field("usage_percent", usage);
+    tree.EndObject();
+  }
+  tree.EndArray();
+  tree.Field("name", sample.name);
+  tree.Field("total", sample.total);
+  tree.EndObject();
+  tree.Key("memory");
+  tree.BeginObject();
+  tree.Field("used", sample.memoryUsed);
+  tree.EndObject();
+  tree.Field("uptime", sample.uptime);
+  tree.EndObject();
+}
+
+FilterDecision Decide(const filter::DeadbandFilter &filter, const Sample &previous, const Sample &current,
+                      std::chrono::steady_clock::time_point now = {}) {
+  json::SnapshotTree previousTree;
+  json::SnapshotTree currentTree;
+  Build(previousTree, previous);
+  Build(currentTree, current);
+  return filter.Evaluate(previousTree, currentTree, now);
+}
+
+}  // namespace
+
+TEST_CASE(DeadbandRejectsInvalidRules) {
+  filter::DeadbandFilter filter;
+  CHECK(filter.AddRule("/cpu_usage/total", filter::DeadbandMode::Absolute, -1.0) ==
+        filter::DeadbandError::InvalidThreshold);
+  CHECK(filter.AddRule("/cpu_usage/total", filter::DeadbandMode::Absolute, NAN) ==
+        filter::DeadbandError::InvalidThreshold);
+  CHECK(filter.AddRule("cpu_usage", filter::DeadbandMode::Absolute, 1.0) == filter::DeadbandError::InvalidPath);
+  CHECK(!filter.IsEnabled());
+}
+
+TEST_CASE(DeadbandAbsoluteThreshold) {
+  filter::DeadbandFilter filter;
+  REQUIRE(filter.AddRule("/cpu_usage/total", filter::DeadbandMode::Absolute, 2.0) == filter::DeadbandError::Success);
+
+  Sample previous;
+  Sample current;
+  CHECK(Decide(filter, previous, current) == FilterDecision::Suppress);
+  current.total = 11.5;
+  CHECK(Decide(filter, previous, current) == FilterDecision::Suppress);
+  current.total = 8.0;
+  CHECK(Decide(filter, previous, current) == FilterDecision::Suppress);
+  current.total = 12.5;
+  CHECK(Decide(filter, previous, current) == FilterDecision::Emit);
+
+  // Re-adding a path replaces its rule.
+  REQUIRE(filter.AddRule("/cpu_usage/total", filter::DeadbandMode::Absolute, 5.0) == filter::DeadbandError::Success);
+  CHECK(Decide(filter, previous, current) == FilterDecision::Suppress);
+}
+
+TEST_CASE(DeadbandPercentThreshold) {
+  filter::DeadbandFilter filter;
+  REQUIRE(filter.AddRule("/memory/used", filter::DeadbandMode::Percent, 10.0) == filter::DeadbandError::Success);
+
+  Sample previous;
+  Sample current;
+  current.memoryUsed = 1090;
+  CHECK(Decide(filter, previous, current) == FilterDecision::Suppress);
+  current.memoryUsed = 910;
+  CHECK(Decide(filter, previous, current) == FilterDecision::Suppress);
+  current.memoryUsed = 1110;
+  CHECK(Decide(filter, previous, current) == FilterDecision::Emit);
+
+  // A percentage of zero is zero, so any change away from zero is significant.
+  previous.memoryUsed = 0;
+  current.memoryUsed = 1;
+  CHECK(Decide(filter, previous, current) == FilterDecision::Emit);
+}
+
+TEST_CASE(DeadbandMostSpecificRuleWins) {
+  filter::DeadbandFilter filter;
+  REQUIRE(filter.AddRule("/cpu_usage", filter::DeadbandMode::Absolute, 100.0) == filter::DeadbandError::Success);
+  REQUIRE(filter.AddRule("/cpu_usage/cores/*/usage_percent", filter::DeadbandMode::Absolute, 50.0) ==
+          filter::DeadbandError::Success);
+  REQUIRE(filter.AddRule("/cpu_usage/cores/0/usage_percent", filter::DeadbandMode::Absolute, 1.0) ==
+          filter::DeadbandError::Success);
+
+  // The literal index beats the wildcard of the same length.
+  Sample previous;
+  Sample current;
+  current.core0 = 15.0;
+  CHECK(Decide(filter, previous, current) == FilterDecision::Emit);
+
+  // The wildcard beats the shorter prefix rule.
+  current = previous;
+  current.core1 = 45.0;
+  CHECK(Decide(filter, previous, current) == FilterDecision::Suppress);
+  current.core1 = 70.0;
+  CHECK(Decide(filter, previous, current) == FilterDecision::Emit);
+
+  // A prefix rule covers every number beneath it.
+  current = previous;
+  current.total = 90.0;
+  CHECK(Decide(filter, previous, current) == FilterDecision::Suppress);
+}
+
+TEST_CASE(DeadbandTreatsUncoveredChangesAsSignificant) {
+  filter::DeadbandFilter filter;
+  REQUIRE(filter.AddRule("/cpu_usage", filter::DeadbandMode::Absolute, 100.0) == filter::DeadbandError::Success);
+
+  Sample previous;
+  Sample current;
+  current.uptime = 2;
+  CHECK(Decide(filter, previous, current) == FilterDecision::Emit);
+
+  // Strings under a rule are never absorbed by its threshold.
+  current = previous;
+  current.name = "cpu0";
+  CHECK(Decide(filter, previous, current) == FilterDecision::Emit);
+
+  // Nor are structural changes.
+  json::SnapshotTree previousTree;
+  json::SnapshotTree currentTree;
+  Build(previousTree, previous);
+  currentTree.Reset();
+  currentTree.BeginObject();
+  currentTree.EndObject();
+  CHECK(filter.Evaluate(previousTree, currentTree, {}) == FilterDecision::Emit);
+
+  // Nothing has been emitted yet.
+  CHECK(filter.Evaluate(json::SnapshotTree{}, previousTree, {}) == FilterDecision::Emit);
+}
+
+TEST_CASE(DeadbandComparesAgainstTheLastEmittedTree) {
+  filter::DeadbandFilter filter;
+  REQUIRE(filter.AddRule("/cpu_usage/total", filter::DeadbandMode::Absolute, 1.0) == filter::DeadbandError::Success);
+
+  // A slow drift of 0.4 per tick never crosses the threshold against the previous sample, but must still be sent.
+  json::SnapshotTree lastEmitted;
+  json::SnapshotTree current;
+  Sample sample;
+  Build(lastEmitted, sample);
+  int emitted = 0;
+  for (int tick = 1; tick <= 10; ++tick) {
+    sample.total = 10.0 + tick * 0.4;
+    Build(current, sample);
+    if (filter.Evaluate(lastEmitted, current, {}) == FilterDecision::Emit) {
+      ++emitted;
+      Build(lastEmitted, sample);
+    }
+  }
+  CHECK(emitted == 3);
+}
+
+TEST_CASE(DeadbandSendsHeartbeatsAfterMaxSilence) {
+  filter::DeadbandFilter filter;
+  filter.SetMaxSilence(milliseconds{5000});
+  CHECK(filter.IsEnabled());
+
+  const std::chrono::steady_clock::time_point start{milliseconds{1000000}};
+  const Sample sample;
+  filter.Record(FilterDecision::Emit, start);
+  CHECK(Decide(filter, sample, sample, start + milliseconds{4999}) == FilterDecision::Suppress);
+  filter.Record(FilterDecision::Suppress, start + milliseconds{4999});
+  CHECK(Decide(filter, sample, sample, start + milliseconds{5000}) == FilterDecision::Heartbeat);
+  filter.Record(FilterDecision::Heartbeat, start + milliseconds{5000});
+  CHECK(Decide(filter, sample, sample, start + milliseconds{6000}) == FilterDecision::Suppress);
+
+  CHECK(filter.GetEmittedCount() == 2);
+  CHECK(filter.GetHeartbeatCount() == 1);
+  CHECK(filter.GetSuppressedCount() == 1);
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+#include "helper/expression.hpp"
+#include "helper/json_writer.hpp"
+#include "helper/snapshot_tree.hpp"
+#include "test.hpp"
+
+namespace {
+
+void BuildSnapshot(json::SnapshotTree &tree) {
+  tree.Reset();
+  tree.BeginObject();
+  tree.Key("cpu_usage");
+  tree.BeginObject();
+  tree.Key("cores");
+  tree.BeginArray();
+  for (const double usage : {10.0, 30.0, 20.0, 60.0}) {
+    tree.BeginObject();
+    tree.Field("usage_percent", usage);
+    tree.EndObject();
+  }
+  tree.EndArray();
+  tree.EndObject();
+  tree.Key("memory");
+  tree.BeginObject();
+  tree.Field("name", "ram");
+  tree.Field("total", uint64_t{16});
+  tree.Field("used", uint64_t{4});
+  tree.EndObject();
+  tree.EndObject();
+}
+
+// Compiles one expression against the sample snapshot and returns its value, or NaN if it did not compile.
+double Evaluate(std::string_view source) {
+  expr::ExpressionEngine engine;
+  if (engine.AddExpression("value", source) != expr::ExpressionError::Success) {
+    return std::nan("");
+  }
+  json::SnapshotTree tree;
+  BuildSnapshot(tree);
+  engine.Evaluate(tree);
+  return engine.GetResult(0);
+}
+
+expr::ExpressionError Compile(std::string_view source) {
+  expr::ExpressionEngine engine;
+  return engine.AddExpression("value", source);
+}
+
+}  // namespace
+
+TEST_CASE(ExpressionArithmeticFollowsPrecedence) {
+  CHECK(test::Near(Evaluate("1 + 2 * 3"), 7.0));
+  CHECK(test::Near(Evaluate("(1 + 2) * 3"), 9.0));
+  CHECK(test::Near(Evaluate("10 - 4 - 3"), 3.0));
+  CHECK(test::Near(Evaluate("-2 * -3"), 6.0));
+  CHECK(test::Near(Evaluate("abs(1.5 - 4)"), 2.5));
+  CHECK(test::Near(Evaluate("min(3, 2) + max(3, 2)"), 5.0));
+}
+
+TEST_CASE(ExpressionLoadsPointersAndAggregates) {
+  CHECK(test::Near(Evaluate("{/memory/used} / {/memory/total}"), 0.25));
+  CHECK(test::Near(Evaluate("avg({/cpu_usage/cores/*/usage_percent})"), 30.0));
+  CHECK(test::Near(Evaluate("sum({/cpu_usage/cores/*/usage_percent})"), 120.0));
+  CHECK(test::Near(Evaluate("max({/cpu_usage/cores/*/usage_percent}) - min({/cpu_usage/cores/*/usage_percent})"),
+                   50.0));
+  CHECK(test::Near(Evaluate("count({/cpu_usage/cores/*/usage_percent})"), 4.0));
+  CHECK(test::Near(Evaluate("{/cpu_usage/cores/3/usage_percent}"), 60.0));
+}
+
+TEST_CASE(ExpressionMissingValuesPropagate) {
+  CHECK(std::isnan(Evaluate("{/memory/missing} + 1")));
+  CHECK(std::isnan(Evaluate("{/memory/name} * 2")));
+  CHECK(std::isnan(Evaluate("avg({/disk/*/busy})")));
+  CHECK(std::isnan(Evaluate("max({/memory/missing}, 1)")));
+  CHECK(test::Near(Evaluate("count({/disk/*/busy})"), 0.0));
+}
+
+TEST_CASE(ExpressionRejectsInvalidSource) {
+  CHECK(Compile("1 +") == expr::ExpressionError::SyntaxError);
+  CHECK(Compile("(1 + 2") == expr::ExpressionError::SyntaxError);
+  CHECK(Compile("median({/a/*})") == expr::ExpressionError::UnknownFunction);
+  CHECK(Compile("{/cpu_usage/cores/*/usage_percent} + 1") == expr::ExpressionError::InvalidPath);
+  CHECK(Compile("{}") == expr::ExpressionError::InvalidPath);
+
+  std::string deep;
+  for (int i = 0; i < 64; ++i) {
+    deep += "(1 + ";
+  }
+  deep += "1";
+  deep.append(64, ')');
+  CHECK(Compile(deep) == expr::ExpressionError::TooComplex);
+
+  expr::ExpressionEngine engine;
+  CHECK(engine.AddExpression("bad name", "1") == expr::ExpressionError::InvalidName);
+  CHECK(engine.AddExpression("ok", "1") == expr::ExpressionError::Success);
+  CHECK(engine.AddExpression("ok", "2") == expr::ExpressionError::DuplicateName);
+}
+
+TEST_CASE(ExpressionSectionIsSortedAndNullsMissing) {
+  expr::ExpressionEngine engine;
+  REQUIRE(engine.AddExpression("ratio", "{/memory/used} / {/memory/total}") == expr::ExpressionError::Success);
+  REQUIRE(engine.AddExpression("absent", "{/memory/missing}") == expr::ExpressionError::Success);
+
+  json::SnapshotTree tree;
+  BuildSnapshot(tree);
+  engine.Evaluate(tree);
+
+  json::SnapshotTree section;
+  REQUIRE(engine.WriteSection(section));
+  json::JsonWriter writer;
+  writer.Reset(false, 0);
+  json::WriteSnapshotTree(writer, section);
+  CHECK(writer.GetOutput() == R"({"absent":null,"ratio":0.25})");
+}
+
+TEST_CASE(ExpressionEvaluationDoesNotAllocate) {
+  expr::ExpressionEngine engine;
+  REQUIRE(engine.AddExpression("a", "avg({/cpu_usage/cores/*/usage_percent}) * 2") == expr::ExpressionError::Success);
+  REQUIRE(engine.AddExpression("b", "{/memory/used} / {/memory/total}") == expr::ExpressionError::Success);
+
+  json::SnapshotTree tree;
+  BuildSnapshot(tree);
+  engine.Evaluate(tree);
+
+  const size_t before = test::AllocationCount();
+  for (int i = 0; i < 100; ++i) {
+    engine.Evaluate(tree);
+  }
+  CHECK(test::AllocationCount() == before);
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+#ifndef NYSYS_BINARY_VALUE_HPP
+#define NYSYS_BINARY_VALUE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "fixtures/json_value.hpp"
+#include "helper/binary_writer.hpp"
+
+namespace fixture {
+namespace detail {
+
+// Reference decoder for the CBOR (RFC 8949) and MessagePack subsets BinaryWriter emits: definite-length containers,
+// text strings, integers, float64, booleans and null. Anything else is rejected rather than skipped.
+class BinaryParser {
+public:
+  BinaryParser(const std::vector<uint8_t> &input, json::BinaryFormat format) noexcept
+      : m_input(input), m_format(format) {}
+
+  [[nodiscard]] bool Parse(JsonValue &value) { return ParseValue(value, 0) && m_position == m_input.size(); }
+
+private:
+  static constexpr size_t kMaxDepth = 64;
+
+  const std::vector<uint8_t> &m_input;
+  json::BinaryFormat m_format;
+  size_t m_position = 0;
+
+  [[nodiscard]] bool ReadBigEndian(size_t size, uint64_t &value) noexcept {
+    if (m_position + size > m_input.size()) {
+      return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < size; ++i) {
+      value = (value << 8) | m_input[m_position++];
+    }
+    return true;
+  }
+
+  [[nodiscard]] bool ReadText(uint64_t size, std::string &text) {
+    if (size > m_input.size() - m_position) {
+      return false;
+    }
+    text.assign(reinterpret_cast<const char *>(m_input.data() + m_position), static_cast<size_t>(size));
+    m_position += static_cast<size_t>(size);
+    return true;
+  }
+
+  [[nodiscard]] bool ReadDouble(JsonValue &value) noexcept {
+    uint64_t bits = 0;
+    if (!ReadBigEndian(8, bits)) {
+      return false;
+    }
+    value.type = JsonValue::Type::Number;
+    std::memcpy(&value.number, &bits, sizeof(bits));
+    return true;
+  }
+
+  [[nodiscard]] bool ReadContainer(JsonValue &value, bool isMap, uint64_t count, size_t depth) {
+    value.type = isMap ? JsonValue::Type::Object : JsonValue::Type::Array;
+    for (uint64_t i = 0; i < count; ++i) {
+      JsonValue item;
+      if (!isMap) {
+        if (!ParseValue(item, depth + 1)) {
+          return false;
+        }
+        value.items.push_back(std::move(item));
+        continue;
+      }
+      JsonValue key;
+      if (!ParseValue(key, depth + 1) || key.type != JsonValue::Type::String || value.Find(key.text) ||
+          !ParseValue(item, depth + 1)) {
+        return false;
+      }
+      value.Set(std::move(key.text), std::move(item));
+    }
+    return true;
+  }
+
+  [[nodiscard]] bool ParseValue(JsonValue &value, size_t depth) {
+    if (depth > kMaxDepth || m_position >= m_input.size()) {
+      return false;
+    }
+    return m_format == json::BinaryFormat::Cbor ? ParseCbor(value, depth) : ParseMessagePack(value, depth);
+  }
+
+  [[nodiscard]] bool ParseCbor(JsonValue &value, size_t depth) {
+    const uint8_t initial = m_input[m_position++];
+    switch (initial) {
+      case 0xF4:
+      case 0xF5:
+        value.type = JsonValue::Type::Bool;
+        value.boolean = initial == 0xF5;
+        return true;
+      case 0xF6:
+        value.type = JsonValue::Type::Null;
+        return true;
+      case 0xFB:
+        return ReadDouble(value);
+      default:
+        break;
+    }
+
+    const uint8_t major = initial >> 5;
+    const uint8_t info = initial & 0x1F;
+    uint64_t argument = info;
+    if (info >= 24 && (info > 27 || !ReadBigEndian(size_t{1} << (info - 24), argument))) {
+      return false;
+    }
+
+    switch (major) {
+      case 0:
+        value.type = JsonValue::Type::Number;
+        value.number = static_cast<double>(argument);
+        return true;
+      case 1:
+        value.type = JsonValue::Type::Number;
+        value.number = -1.0 - static_cast<double>(argument);
+        return true;
+      case 3:
+        value.type = JsonValue::Type::String;
+        return ReadText(argument, value.text);
+      case 4:
+      case 5:
+        return ReadContainer(value, major == 5, argument, depth);
+      default:
+        return false;
+    }
+  }
+
+  [[nodiscard]] bool ParseMessagePack(JsonValue &value, size_t depth) {
+    const uint8_t initial = m_input[m_position++];
+    uint64_t argument = 0;
+    if (initial < 0x80 || initial >= 0xE0) {
+      value.type = JsonValue::Type::Number;
+      value.number = static_cast<double>(static_cast<int8_t>(initial));
+      return true;
+    }
+    if (initial < 0x90) {
+      return ReadContainer(value, true, initial & 0x0F, depth);
+    }
+    if (initial < 0xA0) {
+      return ReadContainer(value, false, initial & 0x0F, depth);
+    }
+    if (initial < 0xC0) {
+      value.type = JsonValue::Type::String;
+      return ReadText(initial & 0x1F, value.text);
+    }
+
+    switch (initial) {
+      case 0xC0:
+        value.type = JsonValue::Type::Null;
+        return true;
+      case 0xC2:
+      case 0xC3:
+        value.type = JsonValue::Type::Bool;
+        value.boolean = initial == 0xC3;
+        return true;
+      case 0xCB:
+        return ReadDouble(value);
+      case 0xCC:
+      case 0xCD:
+      case 0xCE:
+      case 0xCF:
+        value.type = JsonValue::Type::Number;
+        if (!ReadBigEndian(size_t{1} << (initial - 0xCC), argument)) {
+          return false;
+        }
+        value.number = static_cast<double>(argument);
+        return true;
+      case 0xD0:
+      case 0xD1:
+      case 0xD2:
+      case 0xD3: {
+        const size_t size = size_t{1} << (initial - 0xD0);
+        if (!ReadBigEndian(size, argument)) {
+          return false;
+        }
+        // Sign-extend from the encoded width.
+        const unsigned shift = static_cast<unsigned>(64 - 8 * size);
+        value.type = JsonValue::Type::Number;
+        value.number = static_cast<double>(static_cast<int64_t>(argument << shift) >> shift);
+        return true;
+      }
+      case 0xD9:
+      case 0xDA:
+      case 0xDB:
+        value.type = JsonValue::Type::String;
+        return ReadBigEndian(size_t{1} << (initial - 0xD9), argument) && ReadText(argument, value.text);
+      case 0xDC:
+      case 0xDD:
+        return ReadBigEndian(initial == 0xDC ? 2 : 4, argument) && ReadContainer(value, false, argument, depth);
+      case 0xDE:
+      case 0xDF:
+        return ReadBigEndian(initial == 0xDE ? 2 : 4, argument) && ReadContainer(value, true, argument, depth);
+      default:
+        return false;
+    }
+  }
+};
+}  // namespace detail
+
+// Decodes a whole buffer into the same model ParseJson builds, so binary and JSON output can be compared directly.
+[[nodiscard]] inline bool DecodeBinary(const std::vector<uint8_t> &input, json::BinaryFormat format, JsonValue &value) {
+  value = JsonValue{};
+  return detail::BinaryParser(input, format).Parse(value);
+}
+
+}  // namespace fixture
+
+#endif
\ No newline at end of file
@@ -0,0 +1,170 @@
+#ifndef NYSYS_GUNZIP_HPP
+#define NYSYS_GUNZIP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "helper/crc32.hpp"
+
+namespace fixture {
+namespace detail {
+
+constexpr uint16_t kLengthBase[] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                    31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr uint8_t kLengthExtra[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                    2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr uint16_t kDistanceBase[] = {1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+                                      33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+                                      1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr uint8_t kDistanceExtra[] = {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                      6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+class BitReader {
+public:
+  BitReader(const uint8_t *data, size_t size) noexcept : m_data(data), m_size(size) {}
+
+  [[nodiscard]] bool Read(unsigned count, uint32_t &value) noexcept {
+    value = 0;
+    for (unsigned i = 0; i < count; ++i, ++m_bit) {
+      if (m_bit / 8 >= m_size) {
+        return false;
+      }
+      value |= static_cast<uint32_t>((m_data[m_bit / 8] >> (m_bit % 8)) & 1) << i;
+    }
+    return true;
+  }
+
+  // Huffman codes arrive most significant bit first.
+  [[nodiscard]] bool ReadCode(unsigned count, uint32_t &value) noexcept {
+    value = 0;
+    uint32_t bit = 0;
+    for (unsigned i = 0; i < count; ++i) {
+      if (!Read(1, bit)) {
+        return false;
+      }
+      value = (value << 1) | bit;
+    }
+    return true;
+  }
+
+  void AlignToByte() noexcept { m_bit = (m_bit + 7) / 8 * 8; }
+  [[nodiscard]] size_t GetBytePosition() const noexcept { return m_bit / 8; }
+  void SkipBytes(size_t count) noexcept { m_bit += count * 8; }
+
+private:
+  const uint8_t *m_data;
+  size_t m_size;
+  size_t m_bit = 0;
+};
+
+// Decodes one literal/length symbol of the fixed deflate code.
+[[nodiscard]] inline bool ReadFixedSymbol(BitReader &reader, uint32_t &symbol) noexcept {
+  uint32_t code = 0;
+  uint32_t bit = 0;
+  if (!reader.ReadCode(7, code)) {
+    return false;
+  }
+  if (code <= 0x17) {
+    symbol = 256 + code;
+    return true;
+  }
+  if (!reader.Read(1, bit)) {
+    return false;
+  }
+  code = (code << 1) | bit;
+  if (code >= 0x30 && code <= 0xBF) {
+    symbol = code - 0x30;
+    return true;
+  }
+  if (code >= 0xC0 && code <= 0xC7) {
+    symbol = 280 + code - 0xC0;
+    return true;
+  }
+  if (!reader.Read(1, bit)) {
+    return false;
+  }
+  code = (code << 1) | bit;
+  symbol = 144 + code - 0x190;
+  return code >= 0x190 && code <= 0x1FF;
+}
+}  // namespace detail
+
+// Reference decoder for the subset of RFC 1951/1952 the encoder emits - stored and fixed-Huffman blocks - that checks
+// the trailer's CRC-32 and length, so a test can round-trip compressed output without zlib.
+[[nodiscard]] inline bool Gunzip(const std::vector<uint8_t> &input, std::string &output) {
+  output.clear();
+  if (input.size() < 18 || input[0] != 0x1F || input[1] != 0x8B || input[2] != 8 || input[3] != 0) {
+    return false;
+  }
+
+  detail::BitReader reader(input.data() + 10, input.size() - 18);
+  uint32_t final = 0;
+  do {
+    uint32_t type = 0;
+    if (!reader.Read(1, final) || !reader.Read(2, type)) {
+      return false;
+    }
+    if (type == 0) {
+      reader.AlignToByte();
+      const size_t position = 10 + reader.GetBytePosition();
+      if (position + 4 > input.size() - 8) {
+        return false;
+      }
+      const size_t length = input[position] | (input[position + 1] << 8);
+      const size_t complement = input[position + 2] | (input[position + 3] << 8);
+      if ((length ^ 0xFFFF) != complement || position + 4 + length > input.size() - 8) {
+        return false;
+      }
+      output.append(reinterpret_cast<const char *>(input.data() + position + 4), length);
+      reader.SkipBytes(4 + length);
+      continue;
+    }
+    if (type != 1) {
+      return false;
+    }
+
+    for (;;) {
+      uint32_t symbol = 0;
+      if (!detail::ReadFixedSymbol(reader, symbol) || symbol > 285) {
+        return false;
+      }
+      if (symbol < 256) {
+        output.push_back(static_cast<char>(symbol));
+        continue;
+      }
+      if (symbol == 256) {
+        break;
+      }
+
+      uint32_t extra = 0;
+      uint32_t distanceCode = 0;
+      if (!reader.Read(detail::kLengthExtra[symbol - 257], extra)) {
+        return false;
+      }
+      const size_t length = detail::kLengthBase[symbol - 257] + extra;
+      if (!reader.ReadCode(5, distanceCode) || distanceCode > 29 ||
+          !reader.Read(detail::kDistanceExtra[distanceCode], extra)) {
+        return false;
+      }
+      const size_t distance = detail::kDistanceBase[distanceCode] + extra;
+      if (distance > output.size()) {
+        return false;
+      }
+      for (size_t i = 0; i < length; ++i) {
+        output.push_back(output[output.size() - distance]);
+      }
+    }
+  } while (!final);
+
+  const uint8_t *trailer = input.data() + input.size() - 8;
+  const uint32_t crc = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | (static_cast<uint32_t>(trailer[3]) << 24);
+  const uint32_t size = trailer[4] | (trailer[5] << 8) | (trailer[6] << 16) | (static_cast<uint32_t>(trailer[7]) << 24);
+  return crc == codec::Crc32(reinterpret_cast<const uint8_t *>(output.data()), output.size()) &&
+         size == static_cast<uint32_t>(output.size());
+}
+
+}  // namespace fixture
+
+#endif
\ No newline at end of file
@@ -0,0 +1,310 @@
+#ifndef NYSYS_JSON_VALUE_HPP
+#define NYSYS_JSON_VALUE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fixture {
+
+// Minimal JSON document model for checking writer output by meaning rather than by bytes. Object members are kept
+// sorted by key, so two documents compare equal whatever order their members were written in.
+struct JsonValue {
+  enum class Type { Null, Bool, Number, String, Array, Object };
+  struct Member;
+
+  Type type = Type::Null;
+  bool boolean = false;
+  double number = 0.0;
+  std::string text;
+  std::vector<JsonValue> items;
+  std::vector<Member> members;
+
+  [[nodiscard]] JsonValue *Find(std::string_view key);
+  void Set(std::string key, JsonValue value);
+  void Erase(std::string_view key);
+  [[nodiscard]] bool operator==(const JsonValue &other) const;
+  [[nodiscard]] bool operator!=(const JsonValue &other) const { return !(*this == other); }
+};
+
+struct JsonValue::Member {
+  std::string key;
+  JsonValue value;
+};
+
+inline JsonValue *JsonValue::Find(std::string_view key) {
+  const auto found = std::lower_bound(members.begin(), members.end(), key,
+                                      [](const Member &member, std::string_view value) { return member.key < value; });
+  return found != members.end() && found->key == key ? &found->value : nullptr;
+}
+
+inline void JsonValue::Set(std::string key, JsonValue value) {
+  if (auto *existing = Find(key)) {
+    *existing = std::move(value);
+    return;
+  }
+  const auto at = std::lower_bound(members.begin(), members.end(), key,
+                                   [](const Member &member, const std::string &value) { return member.key < value; });
+  members.insert(at, Member{std::move(key), std::move(value)});
+}
+
+inline void JsonValue::Erase(std::string_view key) {
+  members.erase(std::remove_if(members.begin(), members.end(),
+                               [key](const Member &member) { return member.key == key; }),
+                members.end());
+}
+
+inline bool JsonValue::operator==(const JsonValue &other) const {
+  if (type != other.type || boolean != other.boolean || number != other.number || text != other.text ||
+      items != other.items || members.size() != other.members.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < members.size(); ++i) {
+    if (members[i].key != other.members[i].key || members[i].value != other.members[i].value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+namespace detail {
+
+class JsonParser {
+public:
+  explicit JsonParser(std::string_view input) noexcept : m_input(input) {}
+
+  [[nodiscard]] bool Parse(JsonValue &value) {
+    if (!ParseValue(value, 0)) {
+      return false;
+    }
+    SkipSpace();
+    return m_position == m_input.size();
+  }
+
+private:
+  static constexpr size_t kMaxDepth = 64;
+
+  std::string_view m_input;
+  size_t m_position = 0;
+
+  void SkipSpace() noexcept {
+    while (m_position < m_input.size() &&
+           std::string_view(" \t\r\n").find(m_input[m_position]) != std::string_view::npos) {
+      ++m_position;
+    }
+  }
+
+  [[nodiscard]] bool Consume(std::string_view token) noexcept {
+    if (m_input.substr(m_position, token.size()) != token) {
+      return false;
+    }
+    m_position += token.size();
+    return true;
+  }
+
+  [[nodiscard]] bool ParseValue(JsonValue &value, size_t depth) {
+    SkipSpace();
+    if (depth > kMaxDepth || m_position >= m_input.size()) {
+      return false;
+    }
+
+    const char next = m_input[m_position];
+    if (next == '{') {
+      return ParseObject(value, depth);
+    }
+    if (next == '[') {
+      return ParseArray(value, depth);
+    }
+    if (next == '"') {
+      value.type = JsonValue::Type::String;
+      return ParseString(value.text);
+    }
+    if (Consume("null")) {
+      value.type = JsonValue::Type::Null;
+      return true;
+    }
+    if (Consume("true") || Consume("false")) {
+      value.type = JsonValue::Type::Bool;
+      value.boolean = next == 't';
+      return true;
+    }
+    return ParseNumber(value);
+  }
+
+  [[nodiscard]] bool ParseObject(JsonValue &value, size_t depth) {
+    value.type = JsonValue::Type::Object;
+    ++m_position;
+    SkipSpace();
+    if (Consume("}")) {
+      return true;
+    }
+    for (;;) {
+      SkipSpace();
+      std::string key;
+      JsonValue member;
+      if (m_position >= m_input.size() || m_input[m_position] != '"' || !ParseString(key)) {
+        return false;
+      }
+      SkipSpace();
+      if (!Consume(":") || !ParseValue(member, depth + 1) || value.Find(key)) {
+        return false;
+      }
+      value.Set(std::move(key), std::move(member));
+      SkipSpace();
+      if (Consume("}")) {
+        return true;
+      }
+      if (!Consume(",")) {
+        return false;
+      }
+    }
+  }
+
+  [[nodiscard]] bool ParseArray(JsonValue &value, size_t depth) {
+    value.type = JsonValue::Type::Array;
+    ++m_position;
+    SkipSpace();
+    if (Consume("]")) {
+      return true;
+    }
+    for (;;) {
+      value.items.emplace_back();
+      if (!ParseValue(value.items.back(), depth + 1)) {
+        return false;
+      }
+      SkipSpace();
+      if (Consume("]")) {
+        return true;
+      }
+      if (!Consume(",")) {
+        return false;
+      }
+    }
+  }
+
+  [[nodiscard]] bool ParseNumber(JsonValue &value) {
+    const size_t start = m_position;
+    while (m_position < m_input.size() &&
+           std::string_view("+-0123456789.eE").find(m_input[m_position]) != std::string_view::npos) {
+      ++m_position;
+    }
+    if (m_position == start) {
+      return false;
+    }
+    const std::string digits(m_input.substr(start, m_position - start));
+    char *end = nullptr;
+    value.type = JsonValue::Type::Number;
+    value.number = std::strtod(digits.c_str(), &end);
+    return end == digits.c_str() + digits.size();
+  }
+
+  [[nodiscard]] bool ParseHex(uint32_t &code) noexcept {
+    if (m_position + 4 > m_input.size()) {
+      return false;
+    }
+    code = 0;
+    for (size_t i = 0; i < 4; ++i) {
+      const char digit = m_input[m_position++];
+      const auto at = std::string_view("0123456789abcdef").find(static_cast<char>(digit | 0x20));
+      if (at == std::string_view::npos) {
+        return false;
+      }
+      code = code * 16 + static_cast<uint32_t>(at);
+    }
+    return true;
+  }
+
+  static void AppendUtf8(std::string &output, uint32_t code) {
+    if (code < 0x80) {
+      output.push_back(static_cast<char>(code));
+    } else if (code < 0x800) {
+      output.push_back(static_cast<char>(0xC0 | (code >> 6)));
+      output.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+      output.push_back(static_cast<char>(0xE0 | (code >> 12)));
+      output.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+      output.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else {
+      output.push_back(static_cast<char>(0xF0 | (code >> 18)));
+      output.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+      output.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+      output.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+  }
+
+  [[nodiscard]] bool ParseString(std::string &output) {
+    ++m_position;
+    while (m_position < m_input.size()) {
+      const char c = m_input[m_position++];
+      if (c == '"') {
+        return true;
+      }
+      if (static_cast<unsigned char>(c) < 0x20) {
+        return false;
+      }
+      if (c != '\\') {
+        output.push_back(c);
+        continue;
+      }
+      if (m_position >= m_input.size()) {
+        return false;
+      }
+      const char escape = m_input[m_position++];
+      const auto simple = std::string_view("\"\\/bfnrt").find(escape);
+      if (simple != std::string_view::npos) {
+        output.push_back("\"\\/\b\f\n\r\t"[simple]);
+        continue;
+      }
+      uint32_t code = 0;
+      if (escape != 'u' || !ParseHex(code)) {
+        return false;
+      }
+      if (code >= 0xD800 && code < 0xDC00) {
+        uint32_t low = 0;
+        if (!Consume("\\u") || !ParseHex(low) || low < 0xDC00 || low >= 0xE000) {
+          return false;
+        }
+        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+      }
+      AppendUtf8(output, code);
+    }
+    return false;
+  }
+};
+}  // namespace detail
+
+[[nodiscard]] inline bool ParseJson(std::string_view input, JsonValue &value) {
+  value = JsonValue{};
+  return detail::JsonParser(input).Parse(value);
+}
+
+// RFC 7386: objects merge member by member, a null member deletes the key, anything else replaces the target.
+inline void ApplyMergePatch(JsonValue &target, const JsonValue &patch) {
+  if (patch.type != JsonValue::Type::Object) {
+    target = patch;
+    return;
+  }
+  if (target.type != JsonValue::Type::Object) {
+    target = JsonValue{};
+    target.type = JsonValue::Type::Object;
+  }
+  for (const auto &member : patch.members) {
+    if (member.value.type == JsonValue::Type::Null) {
+      target.Erase(member.key);
+      continue;
+    }
+    JsonValue *existing = target.Find(member.key);
+    if (!existing) {
+      target.Set(member.key, JsonValue{});
+      existing = target.Find(member.key);
+    }
+    ApplyMergePatch(*existing, member.value);
+  }
+}
+
+}  // namespace fixture
+
+#endif
\ No newline at end of file
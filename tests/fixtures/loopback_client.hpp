@@ -0,0 +1,157 @@
+#ifndef NYSYS_LOOPBACK_CLIENT_HPP
+#define NYSYS_LOOPBACK_CLIENT_HPP
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace fixture {
+
+// Blocking loopback TCP client for driving the servers under test. Every read gives up after kReceiveTimeoutMs, so a
+// missing response fails a check instead of hanging the run.
+class LoopbackClient {
+public:
+  static constexpr int kReceiveTimeoutMs = 2000;
+
+  LoopbackClient() {
+#ifdef _WIN32
+    WSADATA data;
+    m_startup = WSAStartup(MAKEWORD(2, 2), &data) == 0;
+#endif
+  }
+
+  ~LoopbackClient() {
+    Close();
+#ifdef _WIN32
+    if (m_startup) {
+      WSACleanup();
+    }
+#endif
+  }
+
+  LoopbackClient(const LoopbackClient &) = delete;
+  LoopbackClient &operator=(const LoopbackClient &) = delete;
+
+  [[nodiscard]] bool Connect(uint16_t port) {
+    Close();
+    m_socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (!IsConnected()) {
+      return false;
+    }
+
+#ifdef _WIN32
+    const DWORD timeout = kReceiveTimeoutMs;
+    setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char *>(&timeout), sizeof(timeout));
+#else
+    const timeval timeout{kReceiveTimeoutMs / 1000, (kReceiveTimeoutMs % 1000) * 1000};
+    setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+#endif
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (connect(m_socket, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0) {
+      Close();
+      return false;
+    }
+    return true;
+  }
+
+  [[nodiscard]] bool Send(std::string_view data) {
+    while (!data.empty()) {
+      const auto sent = send(m_socket, data.data(), static_cast<int>(data.size()), 0);
+      if (sent <= 0) {
+        return false;
+      }
+      data.remove_prefix(static_cast<size_t>(sent));
+    }
+    return true;
+  }
+
+  // Reads until the received bytes contain token, the peer closes, or a read times out; returns everything up to and
+  // including the token, or all that arrived if it never did.
+  std::string ReceiveUntil(std::string_view token) {
+    while (m_received.find(token) == std::string::npos && ReadMore()) {
+    }
+    const size_t found = m_received.find(token);
+    return Take(found == std::string::npos ? m_received.size() : found + token.size());
+  }
+
+  // Reads one HTTP response, including a Content-Length body.
+  std::string ReceiveResponse() {
+    std::string response = ReceiveUntil("\r\n\r\n");
+    const size_t header = response.find("Content-Length: ");
+    if (header == std::string::npos) {
+      return response;
+    }
+    const size_t length = std::stoul(response.substr(header + 16));
+    while (m_received.size() < length && ReadMore()) {
+    }
+    return response + Take(length);
+  }
+
+  [[nodiscard]] bool IsConnected() const noexcept { return m_socket != kInvalid; }
+
+  void Close() noexcept {
+    if (IsConnected()) {
+#ifdef _WIN32
+      closesocket(m_socket);
+#else
+      close(m_socket);
+#endif
+      m_socket = kInvalid;
+    }
+    m_received.clear();
+  }
+
+private:
+  [[nodiscard]] bool ReadMore() {
+    char buffer[4096];
+    const auto received = recv(m_socket, buffer, sizeof(buffer), 0);
+    if (received <= 0) {
+      return false;
+    }
+    m_received.append(buffer, static_cast<size_t>(received));
+    return true;
+  }
+
+  std::string Take(size_t count) {
+    std::string result = m_received.substr(0, count);
+    m_received.erase(0, result.size());
+    return result;
+  }
+
+#ifdef _WIN32
+  using Socket = SOCKET;
+  static constexpr Socket kInvalid = INVALID_SOCKET;
+  bool m_startup = false;
+#else
+  using Socket = int;
+  static constexpr Socket kInvalid = -1;
+#endif
+
+  Socket m_socket = kInvalid;
+  std::string m_received;
+};
+
+}  // namespace fixture
+
+#endif
\ No newline at end of file
@@ -0,0 +1,90 @@
+#ifndef NYSYS_PROCESS_FIXTURE_HPP
+#define NYSYS_PROCESS_FIXTURE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "helper/process_table.hpp"
+
+namespace fixture {
+
+// Synthetic stand-in for a SystemProcessInformation snapshot. Every tick a few processes exit and are replaced,
+// some reusing an exited id with a new creation time, and samples come out unsorted like a live snapshot.
+class ProcessFixture {
+public:
+  ProcessFixture(size_t count, uint64_t seed) : m_state(seed) {
+    m_processes.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      m_processes.push_back(Spawn(NextId()));
+    }
+  }
+
+  void Advance(std::vector<proc::ProcessSample> &samples) {
+    ++m_tick;
+    for (auto &process : m_processes) {
+      if (Next() % kChurnModulus == 0) {
+        process = Spawn(Next() % 10 == 0 ? process.processId : NextId());
+      }
+      process.cpuTime += process.cpuRate;
+      process.ioReadBytes += process.ioRate;
+      process.ioWriteBytes += process.ioRate / 2;
+    }
+
+    samples.clear();
+    for (const auto &process : m_processes) {
+      proc::ProcessSample sample;
+      sample.processId = process.processId;
+      sample.createTime = process.createTime;
+      sample.cpuTime = process.cpuTime;
+      sample.ioReadBytes = process.ioReadBytes;
+      sample.ioWriteBytes = process.ioWriteBytes;
+      sample.workingSet = process.workingSet;
+      samples.push_back(sample);
+    }
+  }
+
+private:
+  static constexpr uint64_t kChurnModulus = 200;
+
+  struct Process {
+    uint32_t processId = 0;
+    int64_t createTime = 0;
+    uint64_t cpuTime = 0;
+    uint64_t ioReadBytes = 0;
+    uint64_t ioWriteBytes = 0;
+    uint64_t workingSet = 0;
+    uint64_t cpuRate = 0;
+    uint64_t ioRate = 0;
+  };
+
+  uint64_t m_state;
+  uint32_t m_nextId = 4;
+  int64_t m_tick = 0;
+  std::vector<Process> m_processes;
+
+  [[nodiscard]] uint64_t Next() noexcept {
+    m_state = m_state * 6364136223846793005ull + 1442695040888963407ull;
+    return m_state >> 33;
+  }
+
+  [[nodiscard]] uint32_t NextId() noexcept {
+    m_nextId += 4 * static_cast<uint32_t>(1 + Next() % 8);
+    return m_nextId;
+  }
+
+  // Most processes idle; roughly one in fifty is busy, which is what makes a top-N worth computing.
+  [[nodiscard]] Process Spawn(uint32_t processId) noexcept {
+    Process process;
+    process.processId = processId;
+    process.createTime = m_tick * 1000 + static_cast<int64_t>(Next() % 1000);
+    process.workingSet = (1 + Next() % 4096) * 4096;
+    process.cpuRate = Next() % 50 == 0 ? Next() % 10000000 : Next() % 1000;
+    process.ioRate = Next() % 20 == 0 ? Next() % (64 * 1024 * 1024) : 0;
+    return process;
+  }
+};
+
+}  // namespace fixture
+
+#endif
\ No newline at end of file
@@ -0,0 +1,189 @@
+#ifndef NYSYS_STAND_IN_SERVER_HPP
+#define NYSYS_STAND_IN_SERVER_HPP
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "fixtures/loopback_client.hpp"
+
+namespace fixture {
+
+// Loopback HTTP endpoint for the uploader: it accepts one request per connection, records its headers and body, and
+// answers with the next scripted status (200 once the script runs out) before closing the connection.
+class StandInServer {
+public:
+  struct Reply {
+    int status = 200;
+    int retryAfterSeconds = -1;
+  };
+
+  struct Request {
+    std::string headers;
+    std::string body;
+  };
+
+  StandInServer() {
+#ifdef _WIN32
+    WSADATA data;
+    m_startup = WSAStartup(MAKEWORD(2, 2), &data) == 0;
+#endif
+    m_listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (m_listener == kInvalid) {
+      return;
+    }
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    SocketLength length = sizeof(address);
+    if (bind(m_listener, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 ||
+        listen(m_listener, 8) != 0 || getsockname(m_listener, reinterpret_cast<sockaddr *>(&address), &length) != 0) {
+      CloseSocket(m_listener);
+      m_listener = kInvalid;
+      return;
+    }
+    m_port = ntohs(address.sin_port);
+    m_thread = std::thread([this] { Serve(); });
+  }
+
+  ~StandInServer() {
+    m_stopping = true;
+    if (m_thread.joinable()) {
+      LoopbackClient waker;
+      (void)waker.Connect(m_port);
+      m_thread.join();
+    }
+    if (m_listener != kInvalid) {
+      CloseSocket(m_listener);
+    }
+#ifdef _WIN32
+    if (m_startup) {
+      WSACleanup();
+    }
+#endif
+  }
+
+  StandInServer(const StandInServer &) = delete;
+  StandInServer &operator=(const StandInServer &) = delete;
+
+  [[nodiscard]] bool IsOpen() const noexcept { return m_listener != kInvalid; }
+  [[nodiscard]] uint16_t GetPort() const noexcept { return m_port; }
+  [[nodiscard]] std::string GetUrl() const { return "http://127.0.0.1:" + std::to_string(m_port) + "/ingest"; }
+
+  void Script(std::vector<Reply> replies) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_replies.assign(replies.begin(), replies.end());
+  }
+
+  [[nodiscard]] std::vector<Request> GetRequests() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_requests;
+  }
+
+private:
+#ifdef _WIN32
+  using Socket = SOCKET;
+  using SocketLength = int;
+  static constexpr Socket kInvalid = INVALID_SOCKET;
+  static void CloseSocket(Socket socket) noexcept { closesocket(socket); }
+  bool m_startup = false;
+#else
+  using Socket = int;
+  using SocketLength = socklen_t;
+  static constexpr Socket kInvalid = -1;
+  static void CloseSocket(Socket socket) noexcept { close(socket); }
+#endif
+
+  void Serve() {
+    while (!m_stopping) {
+      const Socket client = accept(m_listener, nullptr, nullptr);
+      if (client == kInvalid) {
+        continue;
+      }
+      if (!m_stopping) {
+        Answer(client);
+      }
+      CloseSocket(client);
+    }
+  }
+
+  void Answer(Socket client) {
+#ifdef _WIN32
+    const DWORD timeout = LoopbackClient::kReceiveTimeoutMs;
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char *>(&timeout), sizeof(timeout));
+#else
+    const timeval timeout{LoopbackClient::kReceiveTimeoutMs / 1000, (LoopbackClient::kReceiveTimeoutMs % 1000) * 1000};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+#endif
+
+    std::string received;
+    char buffer[4096];
+    size_t headerEnd = std::string::npos;
+    size_t bodySize = 0;
+    while (headerEnd == std::string::npos || received.size() < headerEnd + 4 + bodySize) {
+      const auto count = recv(client, buffer, sizeof(buffer), 0);
+      if (count <= 0) {
+        return;
+      }
+      received.append(buffer, static_cast<size_t>(count));
+      if (headerEnd == std::string::npos && (headerEnd = received.find("\r\n\r\n")) != std::string::npos) {
+        const size_t field = received.find("Content-Length: ");
+        bodySize = field < headerEnd ? std::stoul(received.substr(field + 16)) : 0;
+      }
+    }
+
+    Reply reply;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_requests.push_back({received.substr(0, headerEnd), received.substr(headerEnd + 4, bodySize)});
+      if (!m_replies.empty()) {
+        reply = m_replies.front();
+        m_replies.pop_front();
+      }
+    }
+
+    std::string response = "HTTP/1.1 " + std::to_string(reply.status) + " Scripted\r\nContent-Length: 0\r\n";
+    if (reply.retryAfterSeconds >= 0) {
+      response += "Retry-After: " + std::to_string(reply.retryAfterSeconds) + "\r\n";
+    }
+    response += "Connection: close\r\n\r\n";
+    send(client, response.data(), static_cast<int>(response.size()), 0);
+  }
+
+  Socket m_listener = kInvalid;
+  uint16_t m_port = 0;
+  std::atomic<bool> m_stopping{false};
+  std::thread m_thread;
+
+  mutable std::mutex m_mutex;
+  std::deque<Reply> m_replies;
+  std::vector<Request> m_requests;
+};
+
+}  // namespace fixture
+
+#endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef NYSYS_TEMP_DIRECTORY_HPP
+#define NYSYS_TEMP_DIRECTORY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+namespace fixture {
+
+// A fresh directory under the system temp path, removed with everything in it when the fixture goes away.
+class TempDirectory {
+public:
+  TempDirectory() {
+    static std::atomic<unsigned> counter{0};
+    const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    m_path = std::filesystem::temp_directory_path() /
+             ("nysys_test_" + std::to_string(stamp) + "_" + std::to_string(counter++));
+    std::filesystem::create_directories(m_path);
+  }
+
+  ~TempDirectory() {
+    std::error_code ec;
+    std::filesystem::remove_all(m_path, ec);
+  }
+
+  TempDirectory(const TempDirectory &) = delete;
+  TempDirectory &operator=(const TempDirectory &) = delete;
+
+  [[nodiscard]] const std::filesystem::path &Get() const noexcept { return m_path; }
+
+private:
+  std::filesystem::path m_path;
+};
+
+}  // namespace fixture
+
+#endif
\ No newline at end of file
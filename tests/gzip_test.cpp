@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fixtures/gunzip.hpp"
+#include "helper/crc32.hpp"
+#include "helper/gzip.hpp"
+#include "test.hpp"
+
+namespace {
+
+const uint8_t *Bytes(std::string_view text) noexcept { return reinterpret_cast<const uint8_t *>(text.data()); }
+
+// A batch the uploader would send: many samples that differ only in a few digits.
+std::string MakeBatch(size_t samples) {
+  std::string text = "[";
+  for (size_t i = 0; i < samples; ++i) {
+    text += i > 0 ? "," : "";
+    text += "{\"data\":{\"cpu\":{\"load\":" + std::to_string(40 + i % 7) + ",\"name\":\"core\"}},\"sequence\":" +
+            std::to_string(i) + ",\"timestamp\":" + std::to_string(1700000000000 + i * 1000) + "}";
+  }
+  return text + "]";
+}
+
+}  // namespace
+
+TEST_CASE(Crc32MatchesTheCheckValue) {
+  constexpr std::string_view kInput = "123456789";
+  CHECK(codec::Crc32(Bytes(kInput), kInput.size()) == 0xCBF43926u);
+  CHECK(codec::Crc32(nullptr, 0) == 0);
+
+  const uint32_t head = codec::Crc32(Bytes(kInput), 4);
+  CHECK(codec::Crc32(Bytes(kInput) + 4, kInput.size() - 4, head) == 0xCBF43926u);
+}
+
+TEST_CASE(GzipRoundTripsRepetitiveText) {
+  const auto input = MakeBatch(200);
+  codec::GzipEncoder encoder;
+  std::vector<uint8_t> compressed;
+  REQUIRE(encoder.Compress(Bytes(input), input.size(), compressed));
+  CHECK(compressed.size() * 4 < input.size());
+
+  std::string output;
+  CHECK(fixture::Gunzip(compressed, output));
+  CHECK(output == input);
+
+  // The match tables are reused, so a second, different input must not see matches from the first.
+  const auto second = MakeBatch(3);
+  REQUIRE(encoder.Compress(Bytes(second), second.size(), compressed));
+  CHECK(fixture::Gunzip(compressed, output));
+  CHECK(output == second);
+}
+
+TEST_CASE(GzipStoresIncompressibleInput) {
+  std::mt19937 random(7);
+  std::string input(100000, '\0');
+  for (auto &byte : input) {
+    byte = static_cast<char>(random() & 0xFF);
+  }
+
+  codec::GzipEncoder encoder;
+  std::vector<uint8_t> compressed;
+  REQUIRE(encoder.Compress(Bytes(input), input.size(), compressed));
+  // Two stored blocks of at most 65535 bytes, each behind a 5-byte header, plus the gzip header and trailer.
+  CHECK(compressed.size() == input.size() + 2 * 5 + codec::detail::kGzipHeaderSize + codec::detail::kGzipTrailerSize);
+
+  std::string output;
+  CHECK(fixture::Gunzip(compressed, output));
+  CHECK(output == input);
+}
+
+TEST_CASE(GzipHandlesEmptyInput) {
+  codec::GzipEncoder encoder;
+  std::vector<uint8_t> compressed;
+  REQUIRE(encoder.Compress(nullptr, 0, compressed));
+
+  std::string output = "stale";
+  CHECK(fixture::Gunzip(compressed, output));
+  CHECK(output.empty());
+  CHECK(!encoder.Compress(nullptr, 1, compressed));
+}
\ No newline at end of file
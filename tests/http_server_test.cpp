@@ -0,0 +1,174 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "fixtures/loopback_client.hpp"
+#include "helper/http_server.hpp"
+#include "test.hpp"
+
+namespace {
+
+// Runs the server's poll loop on its own thread, the way the library's HTTP thread does.
+class RunningServer {
+public:
+  explicit RunningServer(size_t maxClients = 4) {
+    net::ServerOptions options;
+    options.port = 0;
+    options.maxClients = maxClients;
+    m_opened = m_server.Open(options) == net::ServerError::Success;
+    if (m_opened) {
+      m_thread = std::thread([this] {
+        while (!m_stopping) {
+          m_server.Poll(20);
+        }
+      });
+    }
+  }
+
+  ~RunningServer() {
+    m_stopping = true;
+    if (m_thread.joinable()) {
+      m_server.Wake();
+      m_thread.join();
+    }
+    m_server.Close();
+  }
+
+  RunningServer(const RunningServer &) = delete;
+  RunningServer &operator=(const RunningServer &) = delete;
+
+  [[nodiscard]] bool IsOpen() const noexcept { return m_opened; }
+  [[nodiscard]] net::HttpServer &Get() noexcept { return m_server; }
+
+  // Publishing hands the frame to the poll thread; this returns once a probe request is served the new payload.
+  [[nodiscard]] bool Publish(std::string_view payload, bool streamable = true) {
+    if (!m_server.Publish(payload, "application/json", streamable)) {
+      return false;
+    }
+    fixture::LoopbackClient probe;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{2};
+    while (std::chrono::steady_clock::now() < deadline) {
+      if (probe.Connect(m_server.GetPort()) && probe.Send("GET /snapshot HTTP/1.1\r\nConnection: close\r\n\r\n")) {
+        const auto response = probe.ReceiveResponse();
+        if (response.size() >= payload.size() && response.substr(response.size() - payload.size()) == payload) {
+          return true;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+    return false;
+  }
+
+private:
+  net::HttpServer m_server;
+  std::thread m_thread;
+  std::atomic<bool> m_stopping{false};
+  bool m_opened = false;
+};
+
+[[nodiscard]] bool StartsWith(std::string_view value, std::string_view prefix) noexcept {
+  return value.substr(0, prefix.size()) == prefix;
+}
+
+}  // namespace
+
+TEST_CASE(HttpSnapshotBeforeAndAfterPublish) {
+  RunningServer server;
+  REQUIRE(server.IsOpen());
+  REQUIRE(server.Get().GetPort() != 0);
+
+  fixture::LoopbackClient client;
+  REQUIRE(client.Connect(server.Get().GetPort()));
+  REQUIRE(client.Send("GET /snapshot HTTP/1.1\r\nHost: localhost\r\n\r\n"));
+  const auto empty = client.ReceiveResponse();
+  CHECK(StartsWith(empty, "HTTP/1.1 503 Service Unavailable\r\n"));
+  CHECK(empty.find("Retry-After: 1") != std::string::npos);
+
+  REQUIRE(server.Publish(R"({"cpu":1})"));
+  REQUIRE(client.Send("GET /snapshot?pretty HTTP/1.1\r\nHost: localhost\r\n\r\n"));
+  const auto response = client.ReceiveResponse();
+  CHECK(StartsWith(response, "HTTP/1.1 200 OK\r\n"));
+  CHECK(response.find("Content-Type: application/json\r\n") != std::string::npos);
+  CHECK(response.find("Content-Length: 9\r\n") != std::string::npos);
+  CHECK(response.substr(response.size() - 9) == R"({"cpu":1})");
+}
+
+TEST_CASE(HttpKeepAliveServesPipelinedRequests) {
+  RunningServer server;
+  REQUIRE(server.IsOpen());
+  REQUIRE(server.Publish("{}"));
+
+  const uint64_t before = server.Get().GetStats().requestCount;
+  fixture::LoopbackClient client;
+  REQUIRE(client.Connect(server.Get().GetPort()));
+  REQUIRE(client.Send("GET /snapshot HTTP/1.1\r\n\r\nGET /missing HTTP/1.1\r\n\r\nPOST /snapshot HTTP/1.1\r\n\r\n"));
+  CHECK(StartsWith(client.ReceiveResponse(), "HTTP/1.1 200 OK\r\n"));
+  CHECK(StartsWith(client.ReceiveResponse(), "HTTP/1.1 404 Not Found\r\n"));
+  const auto notAllowed = client.ReceiveResponse();
+  CHECK(StartsWith(notAllowed, "HTTP/1.1 405 Method Not Allowed\r\n"));
+  CHECK(notAllowed.find("Allow: GET\r\n") != std::string::npos);
+  CHECK(server.Get().GetStats().requestCount == before + 3);
+}
+
+TEST_CASE(HttpRejectsMalformedAndOversizedRequests) {
+  RunningServer server;
+  REQUIRE(server.IsOpen());
+
+  fixture::LoopbackClient client;
+  REQUIRE(client.Connect(server.Get().GetPort()));
+  REQUIRE(client.Send("GET /snapshot HTTP/2.0\r\n\r\n"));
+  CHECK(StartsWith(client.ReceiveResponse(), "HTTP/1.1 400 Bad Request\r\n"));
+
+  REQUIRE(client.Connect(server.Get().GetPort()));
+  REQUIRE(client.Send("GET /snapshot HTTP/1.1\r\nX-Padding: " + std::string(net::detail::kMaxRequestBytes, 'a')));
+  CHECK(StartsWith(client.ReceiveResponse(), "HTTP/1.1 431 Request Header Fields Too Large\r\n"));
+  CHECK(server.Get().GetStats().rejectedCount == 1);
+}
+
+TEST_CASE(HttpStreamSendsEveryPublishedSnapshot) {
+  RunningServer server;
+  REQUIRE(server.IsOpen());
+  REQUIRE(server.Publish(R"({"tick":1})"));
+
+  fixture::LoopbackClient client;
+  REQUIRE(client.Connect(server.Get().GetPort()));
+  REQUIRE(client.Send("GET /stream HTTP/1.1\r\n\r\n"));
+  const auto header = client.ReceiveUntil("\r\n\r\n");
+  CHECK(StartsWith(header, "HTTP/1.1 200 OK\r\n"));
+  CHECK(header.find("Content-Type: text/event-stream\r\n") != std::string::npos);
+  CHECK(client.ReceiveUntil("\n\n") == "id: 1\nevent: snapshot\ndata: {\"tick\":1}\n\n");
+
+  REQUIRE(server.Publish("{\n  \"tick\": 2\n}"));
+  CHECK(client.ReceiveUntil("\n\n") == "id: 2\nevent: snapshot\ndata: {\ndata:   \"tick\": 2\ndata: }\n\n");
+  CHECK(server.Get().GetStats().streamCount == 1);
+}
+
+TEST_CASE(HttpStreamRefusesBinaryOutput) {
+  RunningServer server;
+  REQUIRE(server.IsOpen());
+  REQUIRE(server.Publish("binary", false));
+
+  fixture::LoopbackClient client;
+  REQUIRE(client.Connect(server.Get().GetPort()));
+  REQUIRE(client.Send("GET /stream HTTP/1.1\r\n\r\n"));
+  CHECK(StartsWith(client.ReceiveResponse(), "HTTP/1.1 406 Not Acceptable\r\n"));
+}
+
+TEST_CASE(HttpRefusesClientsPastTheLimit) {
+  RunningServer server{1};
+  REQUIRE(server.IsOpen());
+
+  fixture::LoopbackClient first;
+  REQUIRE(first.Connect(server.Get().GetPort()));
+  REQUIRE(first.Send("GET /missing HTTP/1.1\r\n\r\n"));
+  CHECK(StartsWith(first.ReceiveResponse(), "HTTP/1.1 404 Not Found\r\n"));
+
+  fixture::LoopbackClient second;
+  REQUIRE(second.Connect(server.Get().GetPort()));
+  const auto busy = second.ReceiveResponse();
+  CHECK(StartsWith(busy, "HTTP/1.1 503 Service Unavailable\r\n"));
+  CHECK(busy.find("Connection: close\r\n") != std::string::npos);
+  CHECK(server.Get().GetStats().rejectedCount == 1);
+}
\ No newline at end of file
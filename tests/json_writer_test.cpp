@@ -0,0 +1,197 @@
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "helper/json_writer.hpp"
+#include "test.hpp"
+
+namespace {
+
+template <typename T>
+std::string Write(const T &value) {
+  json::JsonWriter writer;
+  writer.Reset(false, 0);
+  writer.Value(value);
+  CHECK(writer.IsValid());
+  return std::string{writer.GetOutput()};
+}
+
+bool IsValidString(std::string_view value) {
+  json::JsonWriter writer;
+  writer.Reset(false, 0);
+  writer.Value(value);
+  return writer.IsValid();
+}
+
+// The fixed document every layout test writes: nested containers, an empty object and an empty array.
+std::string WriteDocument(bool prettyPrint, int indentSize) {
+  json::JsonWriter writer;
+  writer.Reset(prettyPrint, indentSize);
+  writer.BeginObject();
+  writer.Key("cpu");
+  writer.BeginObject();
+  writer.Key("cores");
+  writer.BeginArray();
+  writer.Value(1.5);
+  writer.Value(uint64_t{2});
+  writer.EndArray();
+  writer.Field("name", "x");
+  writer.EndObject();
+  writer.Key("empty");
+  writer.BeginObject();
+  writer.EndObject();
+  writer.Key("list");
+  writer.BeginArray();
+  writer.EndArray();
+  writer.Key("ok");
+  writer.Value(true);
+  writer.Key("temperature");
+  writer.Null();
+  writer.EndObject();
+  CHECK(writer.IsValid());
+  return std::string{writer.GetOutput()};
+}
+
+}  // namespace
+
+TEST_CASE(JsonWriterEscapesControlCharactersQuotesAndBackslashes) {
+  CHECK(Write("a\"b\\c/d") == R"("a\"b\\c/d")");
+  CHECK(Write("\b\f\n\r\t") == R"("\b\f\n\r\t")");
+  CHECK(Write(std::string_view{"\0\x01\x1f", 3}) == R"("\u0000\u0001\u001f")");
+  CHECK(Write("\x7f") == "\"\x7f\"");
+
+  // Longer than one 16-byte scan block, with escapes on both sides of the block boundary.
+  CHECK(Write("0123456789abcde\"0123456789abcdef\n") == R"("0123456789abcde\"0123456789abcdef\n")");
+  CHECK(Write("0123456789abcdef0123456789abcdef\t") == R"("0123456789abcdef0123456789abcdef\t")");
+  CHECK(Write(std::string(40, 'x')) == "\"" + std::string(40, 'x') + "\"");
+}
+
+TEST_CASE(JsonWriterPassesValidUtf8Through) {
+  // 2-, 3- and 4-byte sequences are copied verbatim, never \u-escaped.
+  CHECK(Write("caf\xC3\xA9") == "\"caf\xC3\xA9\"");
+  CHECK(Write("\xE2\x82\xAC 12") == "\"\xE2\x82\xAC 12\"");
+  CHECK(Write("\xF0\x9F\x94\xA5") == "\"\xF0\x9F\x94\xA5\"");
+  CHECK(Write("0123456789abcdef\xC3\xA9 0123456789") == "\"0123456789abcdef\xC3\xA9 0123456789\"");
+
+  CHECK(!IsValidString("\x80"));
+  CHECK(!IsValidString("\xC0\xAF"));
+  CHECK(!IsValidString("\xED\xA0\x80"));
+  CHECK(!IsValidString("\xF4\x90\x80\x80"));
+  CHECK(!IsValidString("0123456789abcdef\xE2\x82"));
+  CHECK(json::IsValidUtf8("\xF0\x9F\x94\xA5"));
+  CHECK(!json::IsValidUtf8("\xF0\x9F\x94"));
+}
+
+TEST_CASE(JsonWriterFormatsIntegers) {
+  CHECK(Write(int64_t{0}) == "0");
+  CHECK(Write(int64_t{-1}) == "-1");
+  CHECK(Write(std::numeric_limits<int64_t>::min()) == "-9223372036854775808");
+  CHECK(Write(std::numeric_limits<int64_t>::max()) == "9223372036854775807");
+  CHECK(Write(std::numeric_limits<uint64_t>::max()) == "18446744073709551615");
+  CHECK(Write(uint32_t{4000000000}) == "4000000000");
+}
+
+TEST_CASE(JsonWriterFormatsDoublesAsShortestRoundTrip) {
+  CHECK(Write(0.0) == "0.0");
+  CHECK(Write(-0.0) == "-0.0");
+  CHECK(Write(1.0) == "1.0");
+  CHECK(Write(-1.5) == "-1.5");
+  CHECK(Write(100.0) == "100.0");
+  CHECK(Write(12.34) == "12.34");
+  CHECK(Write(0.1) == "0.1");
+  CHECK(Write(0.1 + 0.2) == "0.30000000000000004");
+  CHECK(Write(1.0 / 3.0) == "0.3333333333333333");
+
+  // Plain decimals up to 15 digits and down to 0.000d, scientific with a two-digit exponent outside that.
+  CHECK(Write(1e14) == "100000000000000.0");
+  CHECK(Write(1e15) == "1e+15");
+  CHECK(Write(1.2345678901234568e17) == "1.2345678901234568e+17");
+  CHECK(Write(0.0001) == "0.0001");
+  CHECK(Write(0.00001) == "1e-05");
+  CHECK(Write(-2.5e-7) == "-2.5e-07");
+  CHECK(Write(std::numeric_limits<double>::max()) == "1.7976931348623157e+308");
+  CHECK(Write(std::numeric_limits<double>::denorm_min()) == "5e-324");
+
+  CHECK(Write(std::numeric_limits<double>::quiet_NaN()) == "null");
+  CHECK(Write(std::numeric_limits<double>::infinity()) == "null");
+  CHECK(Write(-std::numeric_limits<double>::infinity()) == "null");
+}
+
+TEST_CASE(JsonWriterCompactAndPrettyLayouts) {
+  CHECK(WriteDocument(false, 0) ==
+        R"({"cpu":{"cores":[1.5,2],"name":"x"},"empty":{},"list":[],"ok":true,"temperature":null})");
+
+  // The indent size is ignored in compact mode.
+  CHECK(WriteDocument(false, 4) == WriteDocument(false, 0));
+
+  CHECK(WriteDocument(true, 4) == "{\n"
+                                  "    \"cpu\": {\n"
+                                  "        \"cores\": [\n"
+                                  "            1.5,\n"
+                                  "            2\n"
+                                  "        ],\n"
+                                  "        \"name\": \"x\"\n"
+                                  "    },\n"
+                                  "    \"empty\": {},\n"
+                                  "    \"list\": [],\n"
+                                  "    \"ok\": true,\n"
+                                  "    \"temperature\": null\n"
+                                  "}");
+
+  CHECK(WriteDocument(true, 2) == "{\n"
+                                  "  \"cpu\": {\n"
+                                  "    \"cores\": [\n"
+                                  "      1.5,\n"
+                                  "      2\n"
+                                  "    ],\n"
+                                  "    \"name\": \"x\"\n"
+                                  "  },\n"
+                                  "  \"empty\": {},\n"
+                                  "  \"list\": [],\n"
+                                  "  \"ok\": true,\n"
+                                  "  \"temperature\": null\n"
+                                  "}");
+}
+
+TEST_CASE(JsonWriterRestoreRollsBackAPartialMember) {
+  for (const bool prettyPrint : {false, true}) {
+    json::JsonWriter writer;
+    writer.Reset(prettyPrint, 2);
+    writer.BeginObject();
+
+    // Abandoned as the first member: the next member must not be preceded by a comma.
+    auto checkpoint = writer.Save();
+    writer.Key("broken");
+    writer.BeginArray();
+    writer.Value(uint64_t{1});
+    writer.Restore(checkpoint);
+    writer.Field("a", uint64_t{1});
+
+    // Abandoned after a member, midway through a nested object.
+    checkpoint = writer.Save();
+    writer.Key("gpu");
+    writer.BeginObject();
+    writer.Field("name", "x");
+    writer.Key("load");
+    writer.Restore(checkpoint);
+    writer.Field("b", uint64_t{2});
+    writer.EndObject();
+
+    REQUIRE(writer.IsValid());
+    CHECK(writer.GetOutput() == (prettyPrint ? "{\n  \"a\": 1,\n  \"b\": 2\n}" : R"({"a":1,"b":2})"));
+  }
+}
+
+TEST_CASE(JsonWriterReportsUnbalancedOutputAsInvalid) {
+  json::JsonWriter writer;
+  writer.Reset(false, 0);
+  writer.BeginObject();
+  CHECK(!writer.IsValid());
+  writer.Key("a");
+  CHECK(!writer.IsValid());
+  writer.Value(uint64_t{1});
+  writer.EndObject();
+  CHECK(writer.IsValid());
+  CHECK(writer.GetBuffer() == R"({"a":1})");
+}
\ No newline at end of file
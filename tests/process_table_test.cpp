@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "fixtures/process_fixture.hpp"
+#include "helper/process_table.hpp"
+#include "test.hpp"
+
+namespace {
+
+proc::ProcessSample MakeSample(uint32_t processId, int64_t createTime, uint64_t cpuTime, uint64_t readBytes) {
+  proc::ProcessSample sample;
+  sample.processId = processId;
+  sample.createTime = createTime;
+  sample.cpuTime = cpuTime;
+  sample.ioReadBytes = readBytes;
+  return sample;
+}
+
+}  // namespace
+
+TEST_CASE(ProcessRatesMatchByIdAndCreateTime) {
+  std::vector<proc::ProcessSample> previous = {MakeSample(4, 1, 1000, 0), MakeSample(8, 1, 5000, 100),
+                                               MakeSample(12, 1, 0, 0)};
+  std::vector<proc::ProcessSample> current = {MakeSample(8, 1, 7000, 300), MakeSample(12, 2, 9000, 9000),
+                                              MakeSample(16, 1, 100, 100)};
+
+  proc::ComputeRates(current, previous, 0.01, 0.5);
+
+  CHECK(test::Near(current[0].cpuPercent, 20.0));
+  CHECK(current[0].ioReadRate == 100);
+  CHECK(current[1].cpuPercent == 0.0);
+  CHECK(current[1].ioReadRate == 0);
+  CHECK(current[2].cpuPercent == 0.0);
+}
+
+TEST_CASE(ProcessRatesIgnoreCounterRegression) {
+  std::vector<proc::ProcessSample> previous = {MakeSample(4, 1, 1000, 500)};
+  std::vector<proc::ProcessSample> current = {MakeSample(4, 1, 900, 400)};
+
+  proc::ComputeRates(current, previous, 1.0, 1.0);
+
+  CHECK(current[0].cpuPercent == 0.0);
+  CHECK(current[0].ioReadRate == 0);
+}
+
+TEST_CASE(ProcessTopSkipsIdleProcesses) {
+  std::vector<proc::ProcessSample> samples = {MakeSample(4, 1, 0, 0), MakeSample(8, 1, 0, 0),
+                                              MakeSample(12, 1, 0, 0)};
+  samples[1].cpuPercent = 3.0;
+
+  std::vector<uint32_t> heap;
+  proc::SelectTop(samples, 5, [](const proc::ProcessSample &s) { return s.cpuPercent; }, heap);
+
+  REQUIRE(heap.size() == 1);
+  CHECK(heap[0] == 1);
+}
+
+TEST_CASE(ProcessTopMatchesFullSortOnFixture) {
+  constexpr size_t kProcesses = 5000;
+  constexpr size_t kTop = 16;
+  fixture::ProcessFixture fixture(kProcesses, 7);
+  std::vector<proc::ProcessSample> previous;
+  std::vector<proc::ProcessSample> current;
+  std::vector<uint32_t> heap;
+  heap.reserve(kTop + 1);
+
+  fixture.Advance(previous);
+  proc::SortByProcessId(previous);
+
+  for (int tick = 0; tick < 20; ++tick) {
+    fixture.Advance(current);
+    proc::SortByProcessId(current);
+    proc::ComputeRates(current, previous, 1.0e-5, 1.0);
+
+    const auto metric = [](const proc::ProcessSample &s) { return s.cpuPercent; };
+    const size_t allocations = test::AllocationCount();
+    proc::SelectTop(current, kTop, metric, heap);
+    CHECK(test::AllocationCount() == allocations);
+
+    std::vector<double> expected;
+    for (const auto &sample : current) {
+      if (sample.cpuPercent > 0) {
+        expected.push_back(sample.cpuPercent);
+      }
+    }
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+    expected.resize(std::min(expected.size(), kTop));
+
+    REQUIRE(heap.size() == expected.size());
+    for (size_t i = 0; i < heap.size(); ++i) {
+      CHECK(current[heap[i]].cpuPercent == expected[i]);
+    }
+
+    std::swap(current, previous);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "helper/json_writer.hpp"
+#include "helper/projection.hpp"
+#include "helper/snapshot_tree.hpp"
+#include "test.hpp"
+
+namespace {
+
+// Members are written in sorted key order, the same order the model serializers use.
+void BuildSnapshot(json::SnapshotTree &tree) {
+  tree.Reset();
+  tree.BeginObject();
+  tree.Key("cpu");
+  tree.BeginObject();
+  tree.Field("load", uint64_t{40});
+  tree.Field("name", "x");
+  tree.EndObject();
+  tree.Key("disks");
+  tree.BeginArray();
+  for (uint64_t i = 0; i < 3; ++i) {
+    tree.BeginObject();
+    tree.Field("free", i * 10);
+    tree.Field("name", std::string{static_cast<char>('a' + i)});
+    tree.EndObject();
+  }
+  tree.EndArray();
+  tree.Field("uptime", uint64_t{7});
+  tree.EndObject();
+}
+
+std::string Project(const std::vector<std::string> &paths) {
+  filter::Projection projection;
+  CHECK(projection.SetPaths(paths) == filter::ProjectionError::Success);
+
+  json::SnapshotTree source;
+  json::SnapshotTree destination;
+  BuildSnapshot(source);
+  CHECK(projection.Apply(source, destination));
+
+  json::JsonWriter writer;
+  writer.Reset(false, 0);
+  json::WriteSnapshotTree(writer, destination);
+  return std::string{writer.GetOutput()};
+}
+
+constexpr const char *kFullSnapshot =
+    R"({"cpu":{"load":40,"name":"x"},"disks":[{"free":0,"name":"a"},{"free":10,"name":"b"},)"
+    R"({"free":20,"name":"c"}],"uptime":7})";
+
+}  // namespace
+
+TEST_CASE(ProjectionRejectsInvalidPointers) {
+  filter::Projection projection;
+  REQUIRE(projection.SetPaths({"/cpu"}) == filter::ProjectionError::Success);
+
+  // A rejected set leaves the previous paths in place.
+  CHECK(projection.SetPaths({"/uptime", "cpu"}) == filter::ProjectionError::InvalidPath);
+  CHECK(projection.SetPaths({"/cpu~2load"}) == filter::ProjectionError::InvalidPath);
+  CHECK(projection.SetPaths(std::vector<std::string>(filter::detail::kMaxProjectionPaths + 1, "/cpu")) ==
+        filter::ProjectionError::TooManyPaths);
+  CHECK(projection.IsEnabled());
+  CHECK(projection.Requires({"cpu"}));
+  CHECK(!projection.Requires({"uptime"}));
+}
+
+TEST_CASE(ProjectionKeepsSelectedSubtrees) {
+  CHECK(Project({}) == kFullSnapshot);
+  CHECK(Project({""}) == kFullSnapshot);
+  CHECK(Project({"/cpu/load"}) == R"({"cpu":{"load":40}})");
+  CHECK(Project({"/cpu"}) == R"({"cpu":{"load":40,"name":"x"}})");
+
+  // A path below a missing member keeps the empty parent; a path through a number selects nothing.
+  CHECK(Project({"/cpu/missing"}) == R"({"cpu":{}})");
+  CHECK(Project({"/uptime/value"}) == "{}");
+}
+
+TEST_CASE(ProjectionMergesOverlappingAndPrefixPaths) {
+  CHECK(Project({"/cpu", "/cpu/load"}) == R"({"cpu":{"load":40,"name":"x"}})");
+  CHECK(Project({"/cpu/load", "/cpu"}) == R"({"cpu":{"load":40,"name":"x"}})");
+  CHECK(Project({"/cpu/load", "/cpu/load"}) == R"({"cpu":{"load":40}})");
+  CHECK(Project({"/cpu/load", "/cpu/name"}) == R"({"cpu":{"load":40,"name":"x"}})");
+  CHECK(Project({"/disks/*/free", "/disks/1"}) == R"({"disks":[{"free":0},{"free":10,"name":"b"},{"free":20}]})");
+}
+
+TEST_CASE(ProjectionSelectsArrayElements) {
+  CHECK(Project({"/disks/*/name"}) == R"({"disks":[{"name":"a"},{"name":"b"},{"name":"c"}]})");
+  CHECK(Project({"/*/load"}) == R"({"cpu":{"load":40},"disks":[]})");
+
+  // Unselected elements are dropped, so the kept ones are renumbered from zero.
+  CHECK(Project({"/disks/2/free"}) == R"({"disks":[{"free":20}]})");
+  CHECK(Project({"/disks/0", "/disks/2"}) == R"({"disks":[{"free":0,"name":"a"},{"free":20,"name":"c"}]})");
+  CHECK(Project({"/disks/9"}) == R"({"disks":[]})");
+
+  filter::Projection projection;
+  REQUIRE(projection.SetPaths({"/disks/*/free"}) == filter::ProjectionError::Success);
+  CHECK(projection.Requires({"disks"}));
+  CHECK(projection.Requires({"disks", "*", "free"}));
+  CHECK(!projection.Requires({"disks", "*", "name"}));
+}
+
+TEST_CASE(ProjectionOutputStaysInSortedKeyOrder) {
+  // Paths are listed out of order; the output follows the source, which is sorted.
+  CHECK(Project({"/uptime", "/disks/0/name", "/cpu/name", "/cpu/load"}) ==
+        R"({"cpu":{"load":40,"name":"x"},"disks":[{"name":"a"}],"uptime":7})");
+}
\ No newline at end of file
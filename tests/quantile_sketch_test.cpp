@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "helper/json_pointer.hpp"
+#include "helper/quantile_sketch.hpp"
+#include "helper/snapshot_tree.hpp"
+#include "test.hpp"
+
+namespace {
+
+constexpr double kQuantiles[] = {0.0, 0.01, 0.25, 0.5, 0.75, 0.9, 0.95, 0.99, 0.999, 1.0};
+
+// Deterministic heavy-tailed values spanning several decades, like latencies or transfer rates.
+std::vector<double> MakeValues(size_t count, double scale) {
+  std::vector<double> values;
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i < count; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    const double uniform = static_cast<double>(state >> 11) / static_cast<double>(1ULL << 53);
+    values.push_back(scale * std::exp(uniform * 12.0 - 4.0));
+  }
+  return values;
+}
+
+// The element the sketch ranks as quantile q: index floor(q * (n - 1)) of the sorted values.
+double ExactQuantile(std::vector<double> values, double quantile) {
+  std::sort(values.begin(), values.end());
+  return values[static_cast<size_t>(quantile * static_cast<double>(values.size() - 1))];
+}
+
+bool WithinRelativeError(double estimate, double exact) {
+  return std::abs(estimate - exact) <= history::detail::kSketchRelativeAccuracy * std::abs(exact) + 1e-12;
+}
+
+history::MetricSketch MakeMetric(int64_t windowMs, size_t slices) {
+  return history::MetricSketch{"/cpu/load", *json::ParsePointer("/cpu/load"), windowMs, slices};
+}
+
+history::SketchSummary Summarize(const history::MetricSketch &metric, history::SketchWindow window, int64_t now) {
+  history::QuantileSketch scratch;
+  history::SketchSummary summary;
+  metric.Summarize(window, now, scratch, summary);
+  return summary;
+}
+
+}  // namespace
+
+TEST_CASE(SketchQuantilesStayWithinRelativeError) {
+  const auto values = MakeValues(20000, 1.0);
+  history::QuantileSketch sketch;
+  for (const double value : values) {
+    sketch.Add(value);
+  }
+  REQUIRE(sketch.GetCount() == values.size());
+  CHECK(sketch.GetMin() == *std::min_element(values.begin(), values.end()));
+  CHECK(sketch.GetMax() == *std::max_element(values.begin(), values.end()));
+
+  for (const double quantile : kQuantiles) {
+    CHECK(WithinRelativeError(sketch.Quantile(quantile), ExactQuantile(values, quantile)));
+  }
+}
+
+TEST_CASE(SketchHandlesNegativeZeroAndNonFiniteValues) {
+  std::vector<double> values = MakeValues(5000, -1.0);
+  const auto positive = MakeValues(5000, 3.0);
+  values.insert(values.end(), positive.begin(), positive.end());
+  values.insert(values.end(), 1000, 0.0);
+
+  history::QuantileSketch sketch;
+  for (const double value : values) {
+    sketch.Add(value);
+  }
+  sketch.Add(NAN);
+  sketch.Add(INFINITY);
+  REQUIRE(sketch.GetCount() == values.size());
+
+  for (const double quantile : kQuantiles) {
+    CHECK(WithinRelativeError(sketch.Quantile(quantile), ExactQuantile(values, quantile)));
+  }
+  CHECK(history::QuantileSketch{}.Quantile(0.5) == 0.0);
+}
+
+TEST_CASE(SketchKeepsUpperQuantilesWhenLowBucketsCollapse) {
+  // Twelve decades need more than kMaxSketchBins buckets, so the smallest ones are merged.
+  std::vector<double> values;
+  for (int i = 0; i < 12000; ++i) {
+    values.push_back(std::pow(10.0, -6.0 + i / 1000.0));
+  }
+  history::QuantileSketch sketch;
+  for (const double value : values) {
+    sketch.Add(value);
+  }
+  CHECK(sketch.GetMemoryUsage() <= history::detail::kMaxSketchBins * sizeof(uint64_t) * 2);
+
+  for (const double quantile : {0.5, 0.9, 0.95, 0.99, 1.0}) {
+    CHECK(WithinRelativeError(sketch.Quantile(quantile), ExactQuantile(values, quantile)));
+  }
+}
+
+TEST_CASE(SketchMergeMatchesASingleSketch) {
+  const auto left = MakeValues(7000, 1.0);
+  const auto right = MakeValues(3000, 50.0);
+
+  history::QuantileSketch merged;
+  history::QuantileSketch other;
+  history::QuantileSketch combined;
+  for (const double value : left) {
+    merged.Add(value);
+    combined.Add(value);
+  }
+  for (const double value : right) {
+    other.Add(value);
+    combined.Add(value);
+  }
+  merged.Merge(other);
+  merged.Merge(history::QuantileSketch{});
+
+  CHECK(merged.GetCount() == combined.GetCount());
+  CHECK(merged.GetMin() == combined.GetMin());
+  CHECK(merged.GetMax() == combined.GetMax());
+  CHECK(test::Near(merged.GetSum(), combined.GetSum(), 1e-6 * combined.GetSum()));
+  for (const double quantile : kQuantiles) {
+    CHECK(merged.Quantile(quantile) == combined.Quantile(quantile));
+  }
+
+  history::QuantileSketch empty;
+  empty.Merge(other);
+  CHECK(empty.GetMin() == other.GetMin() && empty.Quantile(0.5) == other.Quantile(0.5));
+}
+
+TEST_CASE(SketchWindowsRollOver) {
+  // 10 s windows in five 2 s slices, one sample per second valued 1..10 in the first window.
+  auto metric = MakeMetric(10000, 5);
+  for (int64_t i = 0; i < 10; ++i) {
+    metric.Add(i * 1000, static_cast<double>(i + 1));
+  }
+
+  auto sliding = Summarize(metric, history::SketchWindow::Sliding, 9999);
+  CHECK(sliding.count == 10 && sliding.min == 1.0 && sliding.max == 10.0);
+  CHECK(test::Near(sliding.mean, 5.5));
+
+  // The first window is still open, so there is no completed tumbling window yet.
+  auto tumbling = Summarize(metric, history::SketchWindow::Tumbling, 9999);
+  CHECK(tumbling.count == 0);
+
+  // Once the clock leaves the window it counts as completed, even before the next sample arrives.
+  tumbling = Summarize(metric, history::SketchWindow::Tumbling, 10000);
+  CHECK(tumbling.count == 10 && tumbling.windowStart == 0 && tumbling.max == 10.0);
+  CHECK(WithinRelativeError(tumbling.p50, 5.0));
+
+  metric.Add(10000, 100.0);
+  tumbling = Summarize(metric, history::SketchWindow::Tumbling, 10000);
+  CHECK(tumbling.count == 10 && tumbling.windowStart == 0 && tumbling.max == 10.0);
+
+  const auto run = Summarize(metric, history::SketchWindow::Run, 10000);
+  CHECK(run.count == 11 && run.windowStart == 0 && run.min == 1.0 && run.max == 100.0);
+
+  // The ring holds five slices, so the slice that started at 0 has been reused for the one at 10 s.
+  sliding = Summarize(metric, history::SketchWindow::Sliding, 10000);
+  CHECK(sliding.count == 9 && sliding.min == 3.0 && sliding.max == 100.0);
+
+  // Well past the second window: it is the completed tumbling window, and the sliding window ages out.
+  tumbling = Summarize(metric, history::SketchWindow::Tumbling, 25000);
+  CHECK(tumbling.count == 1 && tumbling.windowStart == 10000 && tumbling.p99 == 100.0);
+  sliding = Summarize(metric, history::SketchWindow::Sliding, 21999);
+  CHECK(sliding.count == 1);
+  sliding = Summarize(metric, history::SketchWindow::Sliding, 22000);
+  CHECK(sliding.count == 0);
+
+  metric.Reset();
+  CHECK(Summarize(metric, history::SketchWindow::Run, 25000).count == 0);
+}
+
+TEST_CASE(SketchStoreRecordsAndQueriesMetrics) {
+  history::SketchStore store;
+  CHECK(store.AddMetric("/cpu/cores/*/load") == history::SketchError::InvalidPath);
+  CHECK(store.AddMetric("/cpu/load") == history::SketchError::Success);
+  CHECK(store.AddMetric("/cpu/load") == history::SketchError::Success);
+  CHECK(store.SetWindow(999, 4) == history::SketchError::InvalidWindow);
+  CHECK(store.SetWindow(60000, 6) == history::SketchError::Success);
+
+  json::SnapshotTree tree;
+  for (int64_t i = 0; i < 100; ++i) {
+    tree.Reset();
+    tree.BeginObject();
+    tree.Key("cpu");
+    tree.BeginObject();
+    tree.Field("load", static_cast<double>(i));
+    tree.EndObject();
+    tree.EndObject();
+    store.Record(tree, i * 100);
+  }
+
+  history::SketchSummary summary;
+  CHECK(store.Query("/memory/load", history::SketchWindow::Run, 10000, summary) ==
+        history::SketchError::UnknownMetric);
+  REQUIRE(store.Query("/cpu/load", history::SketchWindow::Run, 10000, summary) == history::SketchError::Success);
+  CHECK(summary.count == 100 && summary.min == 0.0 && summary.max == 99.0);
+  CHECK(WithinRelativeError(summary.p95, 94.0));
+  CHECK(WithinRelativeError(summary.p99, 98.0));
+
+  json::SnapshotTree section;
+  REQUIRE(store.WriteSection(section, 10000));
+  const auto count = json::FindNode(section, *json::ParsePointer("/metrics/0/run/count"));
+  REQUIRE(count.has_value());
+  CHECK(json::GetNumber(section.GetNodes()[*count]) == 100.0);
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+#include "helper/json_writer.hpp"
+#include "helper/reflection.hpp"
+#include "helper/units.hpp"
+#include "test.hpp"
+
+namespace {
+
+struct Disk {
+  std::string model;
+  uint64_t freeBytes = 0;
+  double load = 0.0;
+
+  [[nodiscard]] const std::string &GetModel() const noexcept { return model; }
+};
+
+struct Unsorted {
+  int a = 0;
+  int b = 0;
+};
+
+}  // namespace
+
+namespace reflect {
+
+template <>
+struct FieldTable<Disk> {
+  static constexpr auto kFields =
+      std::make_tuple(MakeField("free", [](const Disk &disk) { return disk.freeBytes; }),
+                      MakeField("load", [](const Disk &disk) { return units::Rounded(disk.load); }),
+                      MakeField("model", &Disk::GetModel));
+};
+
+template <>
+struct FieldTable<Unsorted> {
+  static constexpr auto kFields = std::make_tuple(MakeField("b", &Unsorted::b), MakeField("a", &Unsorted::a));
+};
+
+}  // namespace reflect
+
+static_assert(reflect::kFieldCount<Disk> == 3);
+static_assert(reflect::FieldIndex<Disk>("load") == 1);
+static_assert(reflect::FieldIndex<Disk>("missing") == reflect::kFieldCount<Disk>);
+static_assert(reflect::detail::kFieldNamesSorted<Disk>);
+static_assert(!reflect::detail::kFieldNamesSorted<Unsorted>);
+
+namespace {
+
+template <size_t First = 0, size_t Last = reflect::detail::kAllFields>
+std::string Write(const Disk &disk) {
+  json::JsonWriter writer;
+  writer.Reset(false, 0);
+  units::UnitWriter<json::JsonWriter> unitWriter{writer, units::UnitsMode::Legacy};
+  writer.BeginObject();
+  reflect::WriteFields<First, Last>(unitWriter, disk);
+  writer.EndObject();
+  CHECK(writer.IsValid());
+  return std::string{writer.GetOutput()};
+}
+
+}  // namespace
+
+TEST_CASE(ReflectionWritesFieldsInTableOrder) {
+  const Disk disk{"Samsung \"990\"", 512, 12.346};
+  CHECK(Write(disk) == R"({"free":512,"load":12.35,"model":"Samsung \"990\""})");
+  CHECK((Write<0, 1>(disk)) == R"({"free":512})");
+  CHECK(Write<1>(disk) == R"({"load":12.35,"model":"Samsung \"990\""})");
+  CHECK(Write<3>(disk) == "{}");
+}
+
+TEST_CASE(ReflectionHashesFieldValues) {
+  const Disk disk{"ssd", 512, 1.0};
+  CHECK(reflect::HashFields(disk) == reflect::HashFields(Disk{"ssd", 512, 1.0}));
+  CHECK(reflect::HashFields(disk) != reflect::HashFields(Disk{"ssd", 513, 1.0}));
+  CHECK(reflect::HashFields(disk) != reflect::HashFields(Disk{"hdd", 512, 1.0}));
+  CHECK(reflect::HashFields(disk) != reflect::HashFields(Disk{"ssd", 512, 2.0}));
+  CHECK(reflect::HashFields(disk) != reflect::HashFields(disk, 1));
+
+  // Equal values hash equally even when their bit patterns differ.
+  CHECK(reflect::HashFields(Disk{"ssd", 512, 0.0}) == reflect::HashFields(Disk{"ssd", 512, -0.0}));
+
+  // Strings are length-prefixed, so moving bytes between adjacent strings changes the hash.
+  uint64_t left = reflect::detail::HashValue(reflect::detail::kFnvOffsetBasis, std::string_view{"ab"});
+  left = reflect::detail::HashValue(left, std::string_view{"c"});
+  uint64_t right = reflect::detail::HashValue(reflect::detail::kFnvOffsetBasis, std::string_view{"a"});
+  right = reflect::detail::HashValue(right, std::string_view{"bc"});
+  CHECK(left != right);
+}
\ No newline at end of file
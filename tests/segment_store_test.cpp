@@ -0,0 +1,151 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fixtures/temp_directory.hpp"
+#include "helper/segment_store.hpp"
+#include "test.hpp"
+
+namespace {
+
+constexpr storage::StoreOptions kSmallStore{storage::detail::kMinSegmentSize, 2 * storage::detail::kMinSegmentSize};
+
+storage::StoreError Append(storage::SegmentStore &store, std::string_view text, int64_t timestamp = 0) {
+  return store.Append(reinterpret_cast<const uint8_t *>(text.data()), text.size(), timestamp);
+}
+
+std::vector<std::string> ReadAll(const storage::SegmentStore &store, uint64_t from = 0) {
+  std::vector<std::string> records;
+  store.Read(from, SIZE_MAX, [&records](const storage::RecordView &record) {
+    records.emplace_back(reinterpret_cast<const char *>(record.data), record.size);
+    return true;
+  });
+  return records;
+}
+
+size_t CountFiles(const std::filesystem::path &directory, std::string_view extension) {
+  size_t count = 0;
+  for (const auto &entry : std::filesystem::directory_iterator(directory)) {
+    count += entry.path().extension() == extension ? 1 : 0;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST_CASE(SegmentStoreReadsRecordsBackInOrder) {
+  fixture::TempDirectory directory;
+  storage::SegmentStore store;
+  REQUIRE(store.Open(directory.Get(), kSmallStore) == storage::StoreError::Success);
+
+  CHECK(Append(store, "first", 10) == storage::StoreError::Success);
+  CHECK(Append(store, "", 20) == storage::StoreError::Success);
+  CHECK(Append(store, "third", 30) == storage::StoreError::Success);
+  CHECK(store.GetNextSequence() == 3);
+  CHECK((ReadAll(store) == std::vector<std::string>{"first", "", "third"}));
+  CHECK((ReadAll(store, 2) == std::vector<std::string>{"third"}));
+
+  int64_t lastTimestamp = 0;
+  store.Read(1, 1, [&lastTimestamp](const storage::RecordView &record) {
+    lastTimestamp = record.timestamp;
+    return true;
+  });
+  CHECK(lastTimestamp == 20);
+
+  const std::string oversized(storage::detail::kMinSegmentSize, 'x');
+  CHECK(Append(store, oversized) == storage::StoreError::RecordTooLarge);
+}
+
+TEST_CASE(SegmentStoreRecoversAfterReopen) {
+  fixture::TempDirectory directory;
+  {
+    storage::SegmentStore store;
+    REQUIRE(store.Open(directory.Get(), kSmallStore) == storage::StoreError::Success);
+    CHECK(Append(store, "a") == storage::StoreError::Success);
+    CHECK(Append(store, "b") == storage::StoreError::Success);
+  }
+
+  storage::SegmentStore store;
+  REQUIRE(store.Open(directory.Get(), kSmallStore) == storage::StoreError::Success);
+  CHECK(store.GetRecoveredCount() == 2);
+  CHECK(Append(store, "c") == storage::StoreError::Success);
+  CHECK((ReadAll(store) == std::vector<std::string>{"a", "b", "c"}));
+}
+
+TEST_CASE(SegmentStoreLocksItsDirectory) {
+  fixture::TempDirectory directory;
+  storage::SegmentStore first;
+  REQUIRE(first.Open(directory.Get(), kSmallStore) == storage::StoreError::Success);
+
+  storage::SegmentStore second;
+  CHECK(second.Open(directory.Get(), kSmallStore) == storage::StoreError::DirectoryLocked);
+  CHECK(!second.IsOpen());
+
+  first.Close();
+  CHECK(second.Open(directory.Get(), kSmallStore) == storage::StoreError::Success);
+}
+
+TEST_CASE(SegmentStoreCutsATornTail) {
+  fixture::TempDirectory directory;
+  {
+    storage::SegmentStore store;
+    REQUIRE(store.Open(directory.Get(), kSmallStore) == storage::StoreError::Success);
+    CHECK(Append(store, "kept") == storage::StoreError::Success);
+    CHECK(Append(store, "torn") == storage::StoreError::Success);
+  }
+
+  // Flip a payload byte of the second record: header 64, first record 32 + 8, second header 32.
+  const auto segment = directory.Get() / "segment_00000000000000000000.nys";
+  {
+    std::fstream file(segment, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(storage::detail::kSegmentHeaderSize + 40 + storage::detail::kRecordHeaderSize);
+    file.put('X');
+  }
+
+  storage::SegmentStore store;
+  REQUIRE(store.Open(directory.Get(), kSmallStore) == storage::StoreError::Success);
+  CHECK(store.GetRecoveredCount() == 1);
+  CHECK(Append(store, "next") == storage::StoreError::Success);
+  CHECK((ReadAll(store) == std::vector<std::string>{"kept", "next"}));
+}
+
+TEST_CASE(SegmentStoreQuarantinesUnreadableSegments) {
+  fixture::TempDirectory directory;
+  {
+    storage::SegmentStore store;
+    REQUIRE(store.Open(directory.Get(), kSmallStore) == storage::StoreError::Success);
+    CHECK(Append(store, "kept") == storage::StoreError::Success);
+  }
+  {
+    std::ofstream empty(directory.Get() / "segment_00000000000000000001.nys", std::ios::binary);
+    std::ofstream garbage(directory.Get() / "segment_00000000000000000002.nys", std::ios::binary);
+    garbage << std::string(storage::detail::kMinSegmentSize, 'g');
+  }
+
+  storage::SegmentStore store;
+  REQUIRE(store.Open(directory.Get(), kSmallStore) == storage::StoreError::Success);
+  CHECK(store.GetRecoveredCount() == 1);
+  CHECK((ReadAll(store) == std::vector<std::string>{"kept"}));
+  CHECK(CountFiles(directory.Get(), ".corrupt") == 2);
+  CHECK(CountFiles(directory.Get(), ".nys") == 1);
+}
+
+TEST_CASE(SegmentStoreRecyclesTheOldestSegment) {
+  fixture::TempDirectory directory;
+  storage::SegmentStore store;
+  REQUIRE(store.Open(directory.Get(), kSmallStore) == storage::StoreError::Success);
+
+  const std::string record(4000, 'r');
+  for (int i = 0; i < 100; ++i) {
+    REQUIRE(Append(store, record) == storage::StoreError::Success);
+  }
+  store.Flush();
+
+  CHECK(store.GetNextSequence() == 100);
+  CHECK(store.GetFirstSequence() > 0);
+  CHECK(CountFiles(directory.Get(), ".nys") == 2);
+  CHECK(ReadAll(store).size() == store.GetNextSequence() - store.GetFirstSequence());
+}
\ No newline at end of file
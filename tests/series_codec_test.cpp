@@ -0,0 +1,86 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "helper/series_codec.hpp"
+#include "test.hpp"
+
+namespace {
+
+struct Sample {
+  int64_t timestamp = 0;
+  double value = 0.0;
+};
+
+[[nodiscard]] uint64_t Bits(double value) noexcept {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// Appends every sample to one block and checks that decoding returns the same timestamps and bit-identical values.
+[[nodiscard]] bool RoundTrips(const std::vector<Sample> &samples) {
+  history::SeriesBlock block;
+  for (const auto &sample : samples) {
+    if (!block.Accepts(sample.value)) {
+      return false;
+    }
+    block.Append(sample.timestamp, sample.value);
+  }
+
+  size_t index = 0;
+  bool equal = block.GetCount() == samples.size();
+  block.Decode([&](int64_t timestamp, double value) {
+    equal = equal && index < samples.size() && samples[index].timestamp == timestamp &&
+            Bits(samples[index].value) == Bits(value);
+    ++index;
+  });
+  return equal && index == samples.size();
+}
+
+}  // namespace
+
+TEST_CASE(CodecRoundTripsFloats) {
+  std::vector<Sample> samples;
+  for (int64_t i = 0; i < 128; ++i) {
+    samples.push_back({1700000000000 + i * 1000 + (i % 3), 40.1 + std::sin(static_cast<double>(i)) * 12.5});
+  }
+  CHECK(RoundTrips(samples));
+  CHECK(RoundTrips({{0, 1.5}, {1, -0.0}, {2, 0.0}, {3, std::numeric_limits<double>::denorm_min()},
+                    {4, std::numeric_limits<double>::max()}, {5, -std::numeric_limits<double>::infinity()}}));
+}
+
+TEST_CASE(CodecRoundTripsIntegers) {
+  std::vector<Sample> samples;
+  for (int64_t i = 0; i < 128; ++i) {
+    samples.push_back({i * 1000, static_cast<double>((i * 7919) % 2000 - 1000)});
+  }
+  CHECK(RoundTrips(samples));
+  CHECK(RoundTrips({{0, 9007199254740992.0}, {1, -9007199254740992.0}, {2, 0.0}, {3, 1.0}}));
+}
+
+TEST_CASE(CodecKeepsNegativeZero) {
+  history::SeriesBlock block;
+  block.Append(0, -0.0);
+  CHECK(block.GetEncoding() == history::ValueEncoding::Float);
+
+  history::SeriesBlock integers;
+  integers.Append(0, 5.0);
+  CHECK(integers.GetEncoding() == history::ValueEncoding::Integer);
+  CHECK(!integers.Accepts(-0.0));
+  CHECK(integers.Accepts(0.0));
+
+  CHECK(RoundTrips({{0, -0.0}, {1, 3.0}, {2, -0.0}}));
+}
+
+TEST_CASE(CodecRoundTripsIrregularTimestamps) {
+  CHECK(RoundTrips({{0, 1.0},
+                    {1000, 2.0},
+                    {1000, 3.0},
+                    {950, 4.0},
+                    {INT64_C(1) << 40, 5.0},
+                    {(INT64_C(1) << 40) + 1, 6.0},
+                    {-(INT64_C(1) << 50), 7.0}}));
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "fixtures/json_value.hpp"
+#include "helper/json_writer.hpp"
+#include "helper/snapshot_tree.hpp"
+#include "test.hpp"
+
+namespace {
+
+// Members are written in sorted key order, the same order the model serializers use.
+void BuildSnapshot(json::SnapshotTree &tree, int64_t load, bool withDisk, std::string_view name) {
+  tree.Reset();
+  tree.BeginObject();
+  tree.Key("cpu");
+  tree.BeginObject();
+  tree.Field("load", load);
+  tree.Field("name", name);
+  tree.EndObject();
+  if (withDisk) {
+    tree.Key("disk");
+    tree.BeginArray();
+    tree.Value(uint64_t{1});
+    tree.Value(uint64_t{2});
+    tree.EndArray();
+  }
+  tree.Field("uptime", uint64_t{42});
+  tree.EndObject();
+}
+
+std::string Patch(const json::SnapshotTree &previous, const json::SnapshotTree &current) {
+  json::JsonWriter writer;
+  writer.Reset(false, 0);
+  json::WriteMergePatch(writer, previous, current);
+  return std::string{writer.GetOutput()};
+}
+
+fixture::JsonValue Parse(const json::SnapshotTree &tree) {
+  json::JsonWriter writer;
+  writer.Reset(false, 0);
+  json::WriteSnapshotTree(writer, tree);
+  fixture::JsonValue value;
+  CHECK(fixture::ParseJson(writer.GetOutput(), value));
+  return value;
+}
+
+fixture::JsonValue ApplyPatch(const json::SnapshotTree &previous, const json::SnapshotTree &current) {
+  auto document = Parse(previous);
+  fixture::JsonValue patch;
+  CHECK(fixture::ParseJson(Patch(previous, current), patch));
+  fixture::ApplyMergePatch(document, patch);
+  return document;
+}
+
+// What a consumer ends up with: the patched baseline, or the full tree when the encoder has to send a keyframe.
+fixture::JsonValue Deliver(const json::SnapshotTree &previous, const json::SnapshotTree &current) {
+  return json::IsMergePatchLossless(previous, current) ? ApplyPatch(previous, current) : Parse(current);
+}
+
+// The BuildSnapshot layout plus a gpu object and a fans array whose leaves may be null.
+void BuildWithGpu(json::SnapshotTree &tree, double load, bool withGpu, double temperature) {
+  tree.Reset();
+  tree.BeginObject();
+  tree.Key("cpu");
+  tree.BeginObject();
+  tree.Field("load", load);
+  tree.Field("name", "x86");
+  tree.EndObject();
+  tree.Key("fans");
+  tree.BeginArray();
+  tree.Value(temperature);
+  tree.Value(uint64_t{900});
+  tree.EndArray();
+  if (withGpu) {
+    tree.Key("gpu");
+    tree.BeginObject();
+    tree.Key("sensors");
+    tree.BeginObject();
+    tree.Field("temperature", temperature);
+    tree.EndObject();
+    tree.Field("vendor", "acme");
+    tree.EndObject();
+  }
+  tree.EndObject();
+}
+
+constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+}  // namespace
+
+TEST_CASE(MergePatchOfEqualTreesIsEmpty) {
+  json::SnapshotTree previous;
+  json::SnapshotTree current;
+  BuildSnapshot(previous, 10, true, "x86");
+  BuildSnapshot(current, 10, true, "x86");
+
+  CHECK(Patch(previous, current) == "{}");
+}
+
+TEST_CASE(MergePatchCarriesOnlyChangedLeaves) {
+  json::SnapshotTree previous;
+  json::SnapshotTree current;
+  BuildSnapshot(previous, 10, true, "x86");
+  BuildSnapshot(current, 25, true, "x86");
+
+  CHECK(Patch(previous, current) == R"({"cpu":{"load":25}})");
+}
+
+TEST_CASE(MergePatchNullsRemovedMembersAndAddsNewOnes) {
+  json::SnapshotTree previous;
+  json::SnapshotTree current;
+  BuildSnapshot(previous, 10, true, "x86");
+  BuildSnapshot(current, 10, false, "x86");
+  CHECK(Patch(previous, current) == R"({"disk":null})");
+  CHECK(Patch(current, previous) == R"({"disk":[1,2]})");
+}
+
+TEST_CASE(MergePatchReplacesChangedArraysWhole) {
+  json::SnapshotTree previous;
+  json::SnapshotTree current;
+  BuildSnapshot(previous, 10, true, "x86");
+  current.BeginObject();
+  current.Key("cpu");
+  current.BeginObject();
+  current.Field("load", int64_t{10});
+  current.Field("name", "x86");
+  current.EndObject();
+  current.Key("disk");
+  current.BeginArray();
+  current.Value(uint64_t{1});
+  current.Value(uint64_t{3});
+  current.EndArray();
+  current.Field("uptime", uint64_t{42});
+  current.EndObject();
+
+  CHECK(Patch(previous, current) == R"({"disk":[1,3]})");
+}
+
+TEST_CASE(MergePatchWithoutBaselineIsTheFullDocument) {
+  json::SnapshotTree previous;
+  json::SnapshotTree current;
+  BuildSnapshot(current, 10, false, "arm");
+
+  CHECK(Patch(previous, current) == R"({"cpu":{"load":10,"name":"arm"},"uptime":42})");
+}
+
+TEST_CASE(InsertFieldKeepsMembersSorted) {
+  json::SnapshotTree tree;
+  json::SnapshotTree field;
+  BuildSnapshot(tree, 10, false, "x86");
+  field.BeginArray();
+  field.Value(uint64_t{7});
+  field.EndArray();
+  tree.InsertField("disk", field);
+
+  json::SnapshotTree previous;
+  BuildSnapshot(previous, 10, true, "x86");
+  CHECK(Patch(previous, tree) == R"({"disk":[7]})");
+  CHECK(tree.IsValid());
+}
+
+TEST_CASE(MergePatchAppliesToTheCurrentTree) {
+  json::SnapshotTree previous;
+  json::SnapshotTree current;
+  BuildSnapshot(previous, 10, true, "x86");
+  BuildSnapshot(current, 25, false, "arm");
+
+  CHECK(json::IsMergePatchLossless(previous, current));
+  CHECK(ApplyPatch(previous, current) == Parse(current));
+  CHECK(ApplyPatch(current, previous) == Parse(previous));
+}
+
+TEST_CASE(MergePatchFallsBackWhenAValueBecomesNull) {
+  json::SnapshotTree previous;
+  json::SnapshotTree current;
+  BuildWithGpu(previous, 12.5, false, 40.0);
+  BuildWithGpu(current, kMissing, false, 40.0);
+
+  // Sent as a patch, the null would delete cpu/load although the key still exists.
+  CHECK(Patch(previous, current) == R"({"cpu":{"load":null}})");
+  CHECK(ApplyPatch(previous, current) != Parse(current));
+  CHECK(!json::IsMergePatchLossless(previous, current));
+  CHECK(Deliver(previous, current) == Parse(current));
+
+  // Coming back from null is an ordinary change.
+  CHECK(json::IsMergePatchLossless(current, previous));
+  CHECK(Deliver(current, previous) == Parse(previous));
+}
+
+TEST_CASE(MergePatchFallsBackWhenANewObjectHoldsNulls) {
+  json::SnapshotTree previous;
+  json::SnapshotTree current;
+  BuildWithGpu(previous, 12.5, false, kMissing);
+  BuildWithGpu(current, 12.5, true, kMissing);
+
+  CHECK(!json::IsMergePatchLossless(previous, current));
+  CHECK(ApplyPatch(previous, current) != Parse(current));
+  CHECK(Deliver(previous, current) == Parse(current));
+}
+
+TEST_CASE(MergePatchKeepsNullsInsideArrays) {
+  json::SnapshotTree previous;
+  json::SnapshotTree current;
+  BuildWithGpu(previous, 12.5, false, 40.0);
+  BuildWithGpu(current, 12.5, false, kMissing);
+
+  // Arrays are replaced whole, so a null element survives the patch.
+  CHECK(Patch(previous, current) == R"({"fans":[null,900]})");
+  CHECK(json::IsMergePatchLossless(previous, current));
+  CHECK(ApplyPatch(previous, current) == Parse(current));
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef NYSYS_TEST_HPP
+#define NYSYS_TEST_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace test {
+
+struct TestCase {
+  std::string_view name;
+  void (*run)();
+};
+
+[[nodiscard]] std::vector<TestCase> &Registry();
+void ReportFailure(const char *file, int line, const char *expression);
+
+// Number of global operator new calls so far; lets a case assert that a hot path does not allocate.
+[[nodiscard]] size_t AllocationCount() noexcept;
+
+// Makes the count-th global operator new call from now on throw std::bad_alloc, once; exercises rollback paths.
+void FailAllocation(size_t count) noexcept;
+
+struct Registrar {
+  Registrar(std::string_view name, void (*run)()) { Registry().push_back({name, run}); }
+};
+
+[[nodiscard]] inline bool Near(double left, double right, double tolerance = 1e-6) noexcept {
+  return std::fabs(left - right) <= tolerance;
+}
+
+}  // namespace test
+
+#define TEST_CASE(name)                                       \
+  static void name();                                         \
+  static const test::Registrar name##Registrar{#name, &name}; \
+  static void name()
+
+#define CHECK(expression)                                   \
+  do {                                                      \
+    if (!(expression)) {                                    \
+      test::ReportFailure(__FILE__, __LINE__, #expression); \
+    }                                                       \
+  } while (false)
+
+#define REQUIRE(expression)                                 \
+  do {                                                      \
+    if (!(expression)) {                                    \
+      test::ReportFailure(__FILE__, __LINE__, #expression); \
+      return;                                               \
+    }                                                       \
+  } while (false)
+
+#endif
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string_view>
+
+#include "test.hpp"
+
+namespace test {
+namespace detail {
+
+size_t failureCount = 0;
+std::atomic<size_t> allocationCount{0};
+std::atomic<size_t> failureCountdown{0};
+}  // namespace detail
+
+std::vector<TestCase> &Registry() {
+  static std::vector<TestCase> registry;
+  return registry;
+}
+
+void ReportFailure(const char *file, int line, const char *expression) {
+  ++detail::failureCount;
+  std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expression);
+}
+
+size_t AllocationCount() noexcept { return detail::allocationCount.load(std::memory_order_relaxed); }
+
+void FailAllocation(size_t count) noexcept { detail::failureCountdown.store(count, std::memory_order_relaxed); }
+
+}  // namespace test
+
+void *operator new(size_t size) {
+  test::detail::allocationCount.fetch_add(1, std::memory_order_relaxed);
+  auto &countdown = test::detail::failureCountdown;
+  if (countdown.load(std::memory_order_relaxed) > 0 && countdown.fetch_sub(1, std::memory_order_relaxed) == 1) {
+    throw std::bad_alloc();
+  }
+  if (void *memory = std::malloc(size > 0 ? size : 1)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+
+void operator delete(void *memory, size_t) noexcept { std::free(memory); }
+
+// Runs every registered case, or only those whose name contains the first argument.
+int main(int argc, char **argv) {
+  const std::string_view filter = argc > 1 ? argv[1] : "";
+  size_t failedCases = 0;
+  size_t ranCases = 0;
+
+  for (const auto &testCase : test::Registry()) {
+    if (testCase.name.find(filter) == std::string_view::npos) {
+      continue;
+    }
+
+    const size_t failuresBefore = test::detail::failureCount;
+    testCase.run();
+    ++ranCases;
+
+    const bool passed = test::detail::failureCount == failuresBefore;
+    failedCases += passed ? 0 : 1;
+    std::printf("[%s] %.*s\n", passed ? "PASS" : "FAIL", static_cast<int>(testCase.name.size()),
+                testCase.name.data());
+  }
+
+  std::printf("%zu of %zu test cases passed\n", ranCases - failedCases, ranCases);
+  return failedCases == 0 && ranCases > 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include <cstdint>
+#include <vector>
+
+#include "helper/time_series.hpp"
+#include "test.hpp"
+
+namespace {
+
+// Alternates integer and fractional values so every other block is cut short by a change of encoding.
+double FragmentingValue(size_t i) noexcept { return i % 64 == 0 ? static_cast<double>(i) : i + 0.25; }
+
+}  // namespace
+
+TEST_CASE(RawRingKeepsExactlyCapacitySamples) {
+  history::SampleRing ring;
+  ring.Allocate(1000);
+  for (int64_t i = 0; i < 5000; ++i) {
+    ring.Push(i * 1000, static_cast<double>(i));
+  }
+  CHECK(ring.GetSampleCount() == 1000);
+
+  std::vector<history::Point> points;
+  ring.Query(0, INT64_MAX, points);
+  REQUIRE(points.size() == 1000);
+  CHECK(points.front().timestamp == 4000 * 1000);
+  CHECK(points.back().timestamp == 4999 * 1000);
+  CHECK(points.front().last == 4000.0);
+}
+
+TEST_CASE(RawRingCapacityHoldsWhenBlocksAreFragmented) {
+  history::SampleRing ring;
+  ring.Allocate(300);
+  for (size_t i = 0; i < 10000; ++i) {
+    ring.Push(static_cast<int64_t>(i), FragmentingValue(i));
+    REQUIRE(ring.GetSampleCount() == (i + 1 < 300 ? i + 1 : 300));
+  }
+
+  std::vector<history::Point> points;
+  ring.Query(0, INT64_MAX, points);
+  REQUIRE(points.size() == 300);
+  for (size_t i = 0; i < points.size(); ++i) {
+    CHECK(points[i].timestamp == static_cast<int64_t>(9700 + i));
+    CHECK(points[i].last == FragmentingValue(9700 + i));
+  }
+}
+
+TEST_CASE(RawRingQueryRespectsRangeInsideEvictedBlock) {
+  history::SampleRing ring;
+  ring.Allocate(200);
+  for (int64_t i = 0; i < 250; ++i) {
+    ring.Push(i, static_cast<double>(i));
+  }
+
+  std::vector<history::Point> points;
+  ring.Query(0, 60, points);
+  REQUIRE(points.size() == 11);
+  CHECK(points.front().timestamp == 50);
+  CHECK(points.back().timestamp == 60);
+}
+
+TEST_CASE(HistoryMemoryStaysFlatOverMillionsOfSamples) {
+  history::MetricSeries series{{"cpu", "usage"}, history::detail::kDefaultHistoryCapacities};
+  constexpr int64_t kTicks = 3000000;
+  size_t settledUsage = 0;
+  for (int64_t i = 0; i < kTicks; ++i) {
+    series.Append(i * 1000, static_cast<double>(i % 100) + (i % 7 == 0 ? 0.5 : 0.0));
+    if (i == kTicks / 2) {
+      settledUsage = series.GetMemoryUsage();
+    }
+  }
+  CHECK(series.GetMemoryUsage() == settledUsage);
+  CHECK(settledUsage <= history::EstimateSeriesBytes(history::detail::kDefaultHistoryCapacities));
+
+  std::vector<history::Point> points;
+  series.Query(0, INT64_MAX, history::Resolution::Raw, points);
+  CHECK(points.size() == history::detail::kDefaultHistoryCapacities[0]);
+  // Closed hour buckets plus the open one.
+  points.clear();
+  series.Query(0, INT64_MAX, history::Resolution::Hour, points);
+  CHECK(points.size() == history::detail::kDefaultHistoryCapacities[3] + 1);
+}
\ No newline at end of file
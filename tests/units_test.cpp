@@ -0,0 +1,53 @@
+#include <cstdint>
+#include <string>
+
+#include "helper/json_writer.hpp"
+#include "helper/units.hpp"
+#include "helper/utils.hpp"
+#include "test.hpp"
+
+namespace {
+
+template <typename T>
+std::string Render(units::UnitsMode mode, const T &value) {
+  json::JsonWriter writer;
+  writer.Reset(false, 0);
+  units::UnitWriter<json::JsonWriter> unitWriter{writer, mode};
+  unitWriter.Value(value);
+  return std::string{writer.GetOutput()};
+}
+
+template <typename T>
+std::string RenderPlain(const T &value) {
+  json::JsonWriter writer;
+  writer.Reset(false, 0);
+  writer.Value(value);
+  return std::string{writer.GetOutput()};
+}
+
+}  // namespace
+
+TEST_CASE(LegacyUnitsMatchPreRoundedValues) {
+  constexpr uint64_t kTotal = 512110190592;
+  constexpr uint64_t kFree = 73014444032;
+
+  CHECK(Render(units::UnitsMode::Legacy, units::Gigabytes(kTotal)) ==
+        RenderPlain(utils::DoubleToGB(static_cast<double>(kTotal))));
+  CHECK(Render(units::UnitsMode::Legacy, units::Megabytes(kFree)) == RenderPlain(utils::BytesToMB(kFree)));
+  CHECK(Render(units::UnitsMode::Legacy, units::Rounded(12.3456)) == RenderPlain(12.35));
+
+  // The legacy used size is the difference of the two rounded sizes, not the rounded exact difference.
+  const double legacyUsed = utils::RoundToDecimalPlaces(utils::BytesToGB(kTotal) - utils::BytesToGB(kFree), 2);
+  CHECK(Render(units::UnitsMode::Legacy, units::Derived(kTotal - kFree, legacyUsed)) == RenderPlain(legacyUsed));
+}
+
+TEST_CASE(RawUnitsKeepExactValues) {
+  CHECK(Render(units::UnitsMode::Raw, units::Gigabytes(512110190592)) == "512110190592");
+  CHECK(Render(units::UnitsMode::Raw, units::Derived(439095746560, 408.93)) == "439095746560");
+  CHECK(Render(units::UnitsMode::Raw, units::Rounded(0.5)) == RenderPlain(0.5));
+}
+
+TEST_CASE(RoundingMatchesPowBeyondTheTable) {
+  CHECK(utils::RoundToDecimalPlaces(1234.5678, 2) == 1234.57);
+  CHECK(utils::RoundToDecimalPlaces(1234.5678, -2) == std::round(1234.5678 * std::pow(10.0, -2)) / std::pow(10.0, -2));
+}
\ No newline at end of file
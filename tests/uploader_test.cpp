@@ -0,0 +1,179 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fixtures/gunzip.hpp"
+#include "fixtures/stand_in_server.hpp"
+#include "fixtures/temp_directory.hpp"
+#include "helper/uploader.hpp"
+#include "test.hpp"
+
+namespace {
+
+// Sends every pending sample on the next Poll and retries within a few milliseconds.
+upload::UploadOptions MakeOptions(const std::string &url, size_t batchRecords, bool compress = false) {
+  upload::UploadOptions options;
+  options.url = url;
+  options.spoolBytes = 1024 * 1024;
+  options.batchRecords = batchRecords;
+  options.batchIntervalMs = 0;
+  options.compress = compress;
+  options.requestTimeoutMs = 2000;
+  options.minBackoffMs = 1;
+  options.maxBackoffMs = 10;
+  return options;
+}
+
+std::string Sample(size_t index) { return "{\"load\":" + std::to_string(index) + "}"; }
+
+void EnqueueSamples(upload::Uploader &uploader, size_t first, size_t count) {
+  for (size_t i = first; i < first + count; ++i) {
+    CHECK(uploader.Enqueue(Sample(i), 0, static_cast<int64_t>(1700000000000 + i)));
+  }
+}
+
+size_t CountSamples(std::string_view body) {
+  size_t count = 0;
+  for (size_t at = body.find("\"sequence\":"); at != std::string_view::npos; at = body.find("\"sequence\":", at + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+std::string_view HeaderValue(std::string_view headers, std::string_view name) {
+  const size_t at = headers.find(name);
+  if (at == std::string_view::npos) {
+    return {};
+  }
+  const auto value = headers.substr(at + name.size());
+  return value.substr(0, value.find("\r\n"));
+}
+
+}  // namespace
+
+TEST_CASE(UploaderPostsACompressedBatch) {
+  fixture::StandInServer server;
+  fixture::TempDirectory directory;
+  REQUIRE(server.IsOpen());
+  upload::Uploader uploader;
+  REQUIRE(uploader.Open(directory.Get(), MakeOptions(server.GetUrl(), 3, true)) == upload::UploadError::Success);
+
+  EnqueueSamples(uploader, 0, 3);
+  uploader.Poll();
+
+  const auto requests = server.GetRequests();
+  REQUIRE(requests.size() == 1);
+  CHECK(requests[0].headers.find("POST /ingest HTTP/1.1") == 0);
+  CHECK(HeaderValue(requests[0].headers, "Content-Encoding: ") == "gzip");
+  CHECK(!HeaderValue(requests[0].headers, "Idempotency-Key: ").empty());
+
+  std::string body;
+  REQUIRE(fixture::Gunzip(std::vector<uint8_t>(requests[0].body.begin(), requests[0].body.end()), body));
+  CHECK(CountSamples(body) == 3);
+  CHECK(body.find("{\"data\":" + Sample(2) + ",\"sequence\":2,") != std::string::npos);
+
+  const auto stats = uploader.GetStats();
+  CHECK(stats.uploadedCount == 3);
+  CHECK(stats.pendingCount == 0);
+  CHECK(stats.lastStatus == 200);
+}
+
+TEST_CASE(UploaderRetriesWithTheSameIdempotencyKey) {
+  fixture::StandInServer server;
+  fixture::TempDirectory directory;
+  REQUIRE(server.IsOpen());
+  server.Script({{503, 0}});
+  upload::Uploader uploader;
+  REQUIRE(uploader.Open(directory.Get(), MakeOptions(server.GetUrl(), 2)) == upload::UploadError::Success);
+
+  EnqueueSamples(uploader, 0, 2);
+  uploader.Poll();
+  CHECK(uploader.GetStats().retryCount == 1);
+  CHECK(uploader.GetStats().pendingCount == 2);
+  uploader.Poll();
+
+  const auto requests = server.GetRequests();
+  REQUIRE(requests.size() == 2);
+  CHECK(HeaderValue(requests[0].headers, "Idempotency-Key: ") == HeaderValue(requests[1].headers, "Idempotency-Key: "));
+  CHECK(requests[0].body == requests[1].body);
+  CHECK(uploader.GetStats().uploadedCount == 2);
+}
+
+TEST_CASE(UploaderDropsARedirectedBatch) {
+  fixture::StandInServer server;
+  fixture::TempDirectory directory;
+  REQUIRE(server.IsOpen());
+  server.Script({{301}});
+  upload::Uploader uploader;
+  REQUIRE(uploader.Open(directory.Get(), MakeOptions(server.GetUrl(), 2)) == upload::UploadError::Success);
+
+  EnqueueSamples(uploader, 0, 2);
+  uploader.Poll();
+
+  const auto stats = uploader.GetStats();
+  CHECK(server.GetRequests().size() == 1);
+  CHECK(stats.rejectedCount == 2);
+  CHECK(stats.retryCount == 0);
+  CHECK(stats.pendingCount == 0);
+  CHECK(stats.lastStatus == 301);
+}
+
+TEST_CASE(UploaderRestoresTheBatchSizeAfter413) {
+  fixture::StandInServer server;
+  fixture::TempDirectory directory;
+  REQUIRE(server.IsOpen());
+  server.Script({{413}});
+  upload::Uploader uploader;
+  REQUIRE(uploader.Open(directory.Get(), MakeOptions(server.GetUrl(), 4)) == upload::UploadError::Success);
+
+  EnqueueSamples(uploader, 0, 4);
+  uploader.Poll();
+  EnqueueSamples(uploader, 4, 4);
+  uploader.Poll();
+
+  std::vector<size_t> sizes;
+  for (const auto &request : server.GetRequests()) {
+    sizes.push_back(CountSamples(request.body));
+  }
+  CHECK((sizes == std::vector<size_t>{4, 2, 2, 4}));
+  CHECK(uploader.GetStats().uploadedCount == 8);
+}
+
+TEST_CASE(UploaderResumesFromTheSavedCursor) {
+  fixture::StandInServer server;
+  fixture::TempDirectory directory;
+  REQUIRE(server.IsOpen());
+  {
+    upload::Uploader uploader;
+    REQUIRE(uploader.Open(directory.Get(), MakeOptions(server.GetUrl(), 2)) == upload::UploadError::Success);
+    EnqueueSamples(uploader, 0, 2);
+    uploader.Poll();
+  }
+
+  upload::Uploader uploader;
+  REQUIRE(uploader.Open(directory.Get(), MakeOptions(server.GetUrl(), 1)) == upload::UploadError::Success);
+  CHECK(uploader.GetStats().pendingCount == 0);
+  EnqueueSamples(uploader, 2, 1);
+  uploader.Poll();
+
+  const auto requests = server.GetRequests();
+  REQUIRE(requests.size() == 2);
+  CHECK(CountSamples(requests[1].body) == 1);
+  CHECK(requests[1].body.find("\"sequence\":2,") != std::string::npos);
+}
+
+// Nothing polls while the endpoint is away, the way a blocked upload thread behaves; every sample still has to land in
+// the spool rather than overflow a queue in front of it.
+TEST_CASE(UploaderSpoolsWhileTheUploadThreadIsBusy) {
+  fixture::TempDirectory directory;
+  upload::Uploader uploader;
+  REQUIRE(uploader.Open(directory.Get(), MakeOptions("http://127.0.0.1:9/ingest", 60)) ==
+          upload::UploadError::Success);
+
+  EnqueueSamples(uploader, 0, 1000);
+  const auto stats = uploader.GetStats();
+  CHECK(stats.spooledCount == 1000);
+  CHECK(stats.pendingCount == 1000);
+  CHECK(stats.droppedCount == 0);
+}
\ No newline at end of file